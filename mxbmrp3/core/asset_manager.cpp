@@ -468,6 +468,14 @@ int AssetManager::getIconSpriteIndex(const std::string& name) const {
     return 0;
 }
 
+int AssetManager::getIconSpriteIndex(const char* name) const {
+    auto it = m_iconNameToIndex.find(name);
+    if (it != m_iconNameToIndex.end()) {
+        return m_icons[it->second].spriteIndex;
+    }
+    return 0;
+}
+
 std::string AssetManager::getIconFilename(int spriteIndex) const {
     int arrayIndex = spriteIndex - m_firstIconSpriteIndex;
     if (arrayIndex >= 0 && arrayIndex < static_cast<int>(m_icons.size())) {
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
 #include <array>
 
 // Forward declarations
@@ -107,8 +108,11 @@ public:
     // Get icon path for registration
     std::string getIconPath(size_t index) const;
 
-    // Get icon sprite index by name (returns 0 if not found)
+    // Get icon sprite index by name (returns 0 if not found). The const char*
+    // overload looks a literal up without building a std::string (BaseHud calls it
+    // with getIconName() on every title rebuild).
     int getIconSpriteIndex(const std::string& name) const;
+    int getIconSpriteIndex(const char* name) const;
 
     // Get icon filename by sprite index (returns empty string if not found)
     std::string getIconFilename(int spriteIndex) const;
@@ -180,7 +184,7 @@ private:
     // Quick lookup maps
     std::map<std::string, size_t> m_fontNameToIndex;
     std::map<std::string, size_t> m_textureNameToIndex;
-    std::map<std::string, size_t> m_iconNameToIndex;
+    std::map<std::string, size_t, std::less<>> m_iconNameToIndex;   // transparent: find(const char*)
 
     // Sprite index tracking
     size_t m_totalTextureSprites = 0;
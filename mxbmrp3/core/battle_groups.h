@@ -0,0 +1,35 @@
+// ============================================================================
+// core/battle_groups.h
+// The result of PluginData::getBattleGroups(): close-running groups of riders
+// as one flat, caller-owned buffer — every group's race numbers back to back
+// (front rider first) plus each group's end offset.
+//
+// getBattleGroups() refills it in place, so a caller that keeps one across
+// calls (the auto-director's evaluation, the web overlay snapshot) stops
+// allocating once the field is known. Header-only and Win32-free so the
+// director can hold one without pulling in plugin_data.h.
+// ============================================================================
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct BattleGroups {
+    std::vector<int> riders;   // race numbers, group after group, front rider first
+    std::vector<size_t> ends;  // group g is riders[ends[g - 1] (0 for g = 0), ends[g])
+
+    size_t count() const { return ends.size(); }
+    bool empty() const { return ends.empty(); }
+    const int* group(size_t g) const { return riders.data() + begin(g); }
+    size_t groupSize(size_t g) const { return ends[g] - begin(g); }
+
+    void clear() {
+        riders.clear();
+        ends.clear();
+    }
+    // Close the group of riders added since the previous one.
+    void endGroup() { ends.push_back(riders.size()); }
+
+private:
+    size_t begin(size_t g) const { return g ? ends[g - 1] : 0; }
+};
@@ -0,0 +1,142 @@
+// ============================================================================
+// core/compact_strings.h
+// Compact in-pipeline text: what a HUD's addString() records instead of a full
+// SPluginString_t. The game's struct carries a fixed 100-byte m_szString, but most
+// HUD strings are under 16 characters, and every string used to be copied whole
+// at least three times per frame (HUD build -> collectSurface -> output / triple
+// buffer). Here a string is a 24-byte record (position, size, color, packed
+// font/justify/flags, and an offset+length into the owner's text arena); the
+// characters live once, NUL-terminated, in one contiguous byte buffer.
+//
+// Records keep the game's m_afPos name on purpose: the index-coordinated layout
+// fast paths (rebuildLayout / positionString) move strings by writing
+// m_strings[i].m_afPos, and that code is unchanged.
+//
+// A frame's strings are expanded into the game's SPluginString_t layout exactly
+// once, by expandInto() on the final output buffer (HudManager's game frame; the
+// companion window's render scratch). Drop-shadow copies made in collectSurface
+// are just extra records pointing at the same text.
+// ============================================================================
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../game/game_config.h"   // SPluginString_t
+
+struct CompactString {
+    float m_afPos[2];
+    float m_fSize;
+    uint32_t m_ulColor;          // ABGR, as SPluginString_t::m_ulColor
+    uint32_t textOffset;         // into the owning arena's text buffer
+    int16_t m_iFont;
+    uint8_t textLen;             // excluding the NUL; <= CompactStringArena::MAX_TEXT
+    uint8_t attrs;               // JUSTIFY_MASK bits | SKIP_SHADOW
+
+    static constexpr uint8_t JUSTIFY_MASK = 0x03;
+    static constexpr uint8_t SKIP_SHADOW = 0x80;   // exclude from the drop-shadow pass
+
+    int justify() const { return attrs & JUSTIFY_MASK; }
+    bool skipShadow() const { return (attrs & SKIP_SHADOW) != 0; }
+};
+static_assert(sizeof(CompactString) == 24, "CompactString should stay a 24-byte record");
+
+class CompactStringArena {
+public:
+    // Longest text a string carries — what fits SPluginString_t::m_szString.
+    static constexpr size_t MAX_TEXT = sizeof(SPluginString_t::m_szString) - 1;
+    // Text reserved per string by reserve(n): covers the typical HUD string.
+    static constexpr size_t TYPICAL_TEXT = 16;
+
+    void reserve(size_t strings) { reserve(strings, strings * TYPICAL_TEXT); }
+    void reserve(size_t strings, size_t textBytes) {
+        m_records.reserve(strings);
+        m_text.reserve(textBytes);
+    }
+    void clear() { m_records.clear(); m_text.clear(); }
+    // Drop every record from `count` on, and their text (records are laid out
+    // in add order, so the kept ones' text is a prefix of the buffer).
+    void truncate(size_t count) {
+        if (count >= m_records.size()) return;
+        m_text.resize(m_records[count].textOffset);
+        m_records.resize(count);
+    }
+    size_t size() const { return m_records.size(); }
+    bool empty() const { return m_records.empty(); }
+    size_t capacity() const { return m_records.capacity(); }
+
+    CompactString& operator[](size_t i) { return m_records[i]; }
+    const CompactString& operator[](size_t i) const { return m_records[i]; }
+    const CompactString* begin() const { return m_records.data(); }
+    const CompactString* end() const { return m_records.data() + m_records.size(); }
+
+    // Text of a record in THIS arena. Valid until the next add/appendText (the
+    // buffer may reallocate).
+    const char* text(const CompactString& s) const { return m_text.data() + s.textOffset; }
+    const char* text(size_t i) const { return text(m_records[i]); }
+    size_t length(size_t i) const { return m_records[i].textLen; }
+
+    // Record a string (text truncated to MAX_TEXT, like the strncpy into the
+    // game struct it replaces).
+    void add(const char* text, float x, float y, int justify, int font,
+             unsigned long color, float size, bool skipShadow = false) {
+        const size_t len = text ? strnlen(text, MAX_TEXT) : 0;
+        CompactString s;
+        s.m_afPos[0] = x;
+        s.m_afPos[1] = y;
+        s.m_fSize = size;
+        s.m_ulColor = static_cast<uint32_t>(color);
+        s.textOffset = static_cast<uint32_t>(m_text.size());
+        s.m_iFont = static_cast<int16_t>(font);
+        s.textLen = static_cast<uint8_t>(len);
+        s.attrs = static_cast<uint8_t>((justify & CompactString::JUSTIFY_MASK) |
+                                       (skipShadow ? CompactString::SKIP_SHADOW : 0));
+        m_text.insert(m_text.end(), text, text + len);
+        m_text.push_back('\0');
+        m_records.push_back(s);
+    }
+
+    // Frame assembly (collectSurface): bulk-copy another arena's text and return the
+    // base to add to its records' textOffset when they are push()ed here.
+    uint32_t appendText(const CompactStringArena& src) {
+        const uint32_t base = static_cast<uint32_t>(m_text.size());
+        m_text.insert(m_text.end(), src.m_text.begin(), src.m_text.end());
+        return base;
+    }
+    void push(const CompactString& s) { m_records.push_back(s); }
+    // Append all of src's records (their text must already be appendText()ed at base).
+    void pushAll(const CompactStringArena& src, uint32_t base) {
+        const size_t first = m_records.size();
+        m_records.insert(m_records.end(), src.m_records.begin(), src.m_records.end());
+        if (base) {
+            for (size_t k = first; k < m_records.size(); ++k) m_records[k].textOffset += base;
+        }
+    }
+
+    // The single expansion into the game's layout. Reuses out's capacity; only the
+    // text bytes + NUL are written into m_szString (the game reads to the NUL).
+    void expandInto(std::vector<SPluginString_t>& out) const {
+        out.resize(m_records.size());
+        for (size_t i = 0; i < m_records.size(); ++i) {
+            const CompactString& s = m_records[i];
+            SPluginString_t& d = out[i];
+            std::memcpy(d.m_szString, m_text.data() + s.textOffset, s.textLen);
+            d.m_szString[s.textLen] = '\0';
+            d.m_afPos[0] = s.m_afPos[0];
+            d.m_afPos[1] = s.m_afPos[1];
+            d.m_iFont = s.m_iFont;
+            d.m_fSize = s.m_fSize;
+            d.m_iJustify = s.justify();
+            d.m_ulColor = s.m_ulColor;
+        }
+    }
+
+    // Bytes this arena occupies in the pipeline (records + text), for the
+    // BenchmarkWidget's bytes-moved figure.
+    size_t byteSize() const { return m_records.size() * sizeof(CompactString) + m_text.size(); }
+    size_t textBytes() const { return m_text.size(); }
+
+private:
+    std::vector<CompactString> m_records;
+    std::vector<char> m_text;
+};
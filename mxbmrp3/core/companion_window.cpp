@@ -5,6 +5,7 @@
 
 #include "hud_sw_renderer.h"
 #include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
 
 #include <algorithm>
 #include <chrono>
@@ -86,6 +87,7 @@ CompanionWindow::~CompanionWindow() {
 void CompanionWindow::setAssetRoot(const std::string& root) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_assetRoot = root;
+    m_resourceGen.fetch_add(1, std::memory_order_release);
 }
 
 void CompanionWindow::setSavedGeometry(int x, int y, int w, int h) {
@@ -162,30 +164,29 @@ void CompanionWindow::stop() {
 }
 
 void CompanionWindow::submit(const std::vector<SPluginQuad_t>& quads,
-                             const std::vector<SPluginString_t>& strings,
-                             const std::vector<std::string>& fontPaths,
-                             const std::vector<std::string>& spritePaths,
-                             int firstIcon) {
+                             const CompactStringArena& strings) {
     if (!m_enabled.load(std::memory_order_relaxed)) return;
+    // Fill our own slot (the window thread never reads it), then swap it in. The
+    // only shared critical section is the buffer's index swap, so a present stuck in
+    // DwmFlush/StretchDIBits on the window thread can't hold the producer up.
+    m_frames.writeSlot().assign(quads, strings);
+    m_frames.publish();
+}
+
+void CompanionWindow::setResources(const std::vector<std::string>& fontPaths,
+                                   const std::vector<std::string>& spritePaths,
+                                   int firstIcon) {
+    std::vector<std::string> fonts, sprites;
+    fonts.reserve(fontPaths.size());
+    sprites.reserve(spritePaths.size());
+    for (const auto& p : fontPaths) fonts.push_back(baseName(p));
+    for (const auto& p : spritePaths) sprites.push_back(baseName(p));
+
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_quads = quads;
-    m_strings = strings;
+    m_fontBases = std::move(fonts);
+    m_spriteBases = std::move(sprites);
     m_firstIcon = firstIcon;
-    // The registration tables are stable after init — rebuild basenames only when
-    // their size changes (i.e. once), not every frame. ASSUMPTION: font/sprite
-    // registration is one-time and append-only, so a table can only GROW, never be
-    // repopulated with the same count but different entries. If that ever changes
-    // (dynamic re-registration), key this on content instead or the companion renders
-    // stale basenames. (AssetManager registers once at startup, so it holds today.)
-    if (m_fontBases.size() != fontPaths.size()) {
-        m_fontBases.clear();
-        for (const auto& p : fontPaths) m_fontBases.push_back(baseName(p));
-    }
-    if (m_spriteBases.size() != spritePaths.size()) {
-        m_spriteBases.clear();
-        for (const auto& p : spritePaths) m_spriteBases.push_back(baseName(p));
-    }
-    m_haveFrame = true;
+    m_resourceGen.fetch_add(1, std::memory_order_release);
 }
 
 #if defined(_WIN32)
@@ -266,6 +267,7 @@ LRESULT CALLBACK companionWndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
 }  // namespace
 
 void CompanionWindow::threadMain() {
+    TRACE_THREAD_NAME("companion window");
     HINSTANCE hInst = GetModuleHandleW(nullptr);
     WNDCLASSW wc{};
     wc.lpfnWndProc = companionWndProc;
@@ -311,6 +313,7 @@ void CompanionWindow::threadMain() {
 
     hudsw::Renderer renderer;
     hudsw::Image img;
+    std::vector<SPluginString_t> expanded;   // the frame's strings in the game layout (reused)
     std::vector<uint8_t> bgra;  // BGRA scratch for the DIB (Win32 wants blue-first)
 
     // Back buffer: we compose each frame off-screen and blit it to the window in a
@@ -320,15 +323,14 @@ void CompanionWindow::threadMain() {
     HBITMAP memBmp = nullptr, oldBmp = nullptr;
     int bbW = 0, bbH = 0;
 
-    // Snapshot scratch, hoisted out of the loop: vector/string ASSIGNMENT reuses
-    // existing capacity, so the per-frame copy under m_mutex is a memcpy-grade fill
-    // instead of fresh allocations — the game thread's submit() blocks on this same
-    // mutex, so keeping the critical section short bounds game-thread stalls at
-    // high companionRefreshHz.
-    std::vector<SPluginQuad_t> quads;
-    std::vector<SPluginString_t> strings;
+    // Local copies of the registration tables, refreshed only when setResources()/
+    // setAssetRoot() bump the generation (i.e. at init), never per frame. The frame
+    // primitives themselves aren't copied at all: acquire() hands us the display slot,
+    // which the producer can't touch until our next acquire().
     std::vector<std::string> fontBases, spriteBases;
     std::string root;
+    int firstIcon = 1 << 30;
+    unsigned seenGen = 0;
 
     while (m_run.load()) {
         MSG msg;
@@ -338,14 +340,17 @@ void CompanionWindow::threadMain() {
         }
         if (!m_run.load()) break;
 
-        // Snapshot the latest frame under the lock, then render outside it.
-        int firstIcon; bool have;
-        {
+        unsigned gen = m_resourceGen.load(std::memory_order_acquire);
+        if (gen != seenGen) {
             std::lock_guard<std::mutex> lock(m_mutex);
-            quads = m_quads; strings = m_strings;
             fontBases = m_fontBases; spriteBases = m_spriteBases;
-            firstIcon = m_firstIcon; root = m_assetRoot; have = m_haveFrame;
+            firstIcon = m_firstIcon; root = m_assetRoot;
+            seenGen = gen;
         }
+        // Adopt the newest published frame (or keep the one we hold). Rendered in
+        // place — valid until the next acquire(), however long this present takes.
+        bool have = m_frames.everProduced();
+        const Frame& frame = m_frames.acquire();
 
         RECT rc; GetClientRect(hwnd, &rc);
         int cw = std::max(1, (int)(rc.right - rc.left)), ch = std::max(1, (int)(rc.bottom - rc.top));
@@ -363,11 +368,13 @@ void CompanionWindow::threadMain() {
 
         if (have) {
             hudsw::Frame f;
-            f.quads = quads.data(); f.quadCount = (int)quads.size();
-            f.strings = strings.data(); f.stringCount = (int)strings.size();
+            f.quads = frame.quads.data(); f.quadCount = (int)frame.quads.size();
+            frame.strings.expandInto(expanded);
+            f.strings = expanded.data(); f.stringCount = (int)expanded.size();
             f.fontNames = &fontBases; f.spriteNames = &spriteBases;
             f.firstIcon = firstIcon; f.assetRoot = root;
             try {
+                TRACE_SCOPE("CompanionWindow::render");
                 renderer.render(img, f, 12, 15, 20);  // dark backdrop for legibility (fills the whole client)
             } catch (...) {
                 // A throwing render (e.g. bad_alloc from a corrupt user-supplied
@@ -433,5 +440,6 @@ void CompanionWindow::threadMain() {
 }
 
 #else  // non-Windows: the plugin is Windows-only, so this is just a link stub.
+bool CompanionWindow::isCompanionHwnd(void*) { return false; }
 void CompanionWindow::threadMain() { m_run.store(false); }
 #endif
@@ -6,11 +6,14 @@
 // draws them with the software renderer (core/hud_sw_renderer), presenting via a
 // plain Win32 window (works natively on Windows and under Proton/Wine).
 //
-// Threading: the game thread calls submit() once per Draw with a snapshot of the
-// current quads/strings (POD, cheap to copy) under a mutex; a dedicated window
-// thread owns the Win32 window + message loop and renders the latest snapshot on
-// its own cadence — so the window stays live and interactive even in menus, when
-// the game issues no Draw calls. Enable via the [CompanionWindow] INI setting.
+// Threading: the game thread calls submit() once per Draw, copying the current
+// quads/strings (POD) into its own slot of a RenderFrameBuffer triple buffer; a
+// dedicated window thread owns the Win32 window + message loop and renders the
+// latest published slot in place on its own cadence — so the window stays live and
+// interactive even in menus, when the game issues no Draw calls. The two sides only
+// ever share a slot-index swap, so a slow present can never stall the producer.
+// The font/sprite tables are pushed separately (setResources) when the game
+// registers them, not per frame. Enable via the [CompanionWindow] INI setting.
 // ============================================================================
 #pragma once
 #include <atomic>
@@ -20,11 +23,25 @@
 #include <vector>
 
 #include "../game/game_config.h"   // SPluginQuad_t / SPluginString_t
+#include "compact_strings.h"
+#include "render_frame_buffer.h"
 
 class CompanionWindow {
 public:
     static CompanionWindow& getInstance();
 
+    // One frame's primitives — the triple-buffer payload. assign() reuses the slot's
+    // capacity, so a steady-state submit is a memcpy-grade fill with no allocation.
+    // Strings travel compact; the window thread expands them just before rendering.
+    struct Frame {
+        std::vector<SPluginQuad_t> quads;
+        CompactStringArena strings;
+        void assign(const std::vector<SPluginQuad_t>& q, const CompactStringArena& s) {
+            quads.assign(q.begin(), q.end());
+            strings = s;
+        }
+    };
+
     // True if `hwnd` (a HWND, passed opaque to keep this header windows.h-free) is
     // the companion window — identified by its window class, so input handling can
     // tell the companion surface apart from the game window. Always false off-Win32.
@@ -34,14 +51,19 @@ public:
     void setEnabled(bool enabled);
     bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
 
-    // Game-thread: publish this frame's primitives + the registration tables
-    // (font/sprite paths, 1-based indices; firstIcon splits textures from icons).
-    // Cheap POD copy under the mutex; a no-op when the window is closed.
+    // Game-thread: publish this frame's primitives. Copies into the producer's own
+    // triple-buffer slot and swaps it in — never waits on the window thread, however
+    // long its present takes. A no-op when the window is closed.
     void submit(const std::vector<SPluginQuad_t>& quads,
-                const std::vector<SPluginString_t>& strings,
-                const std::vector<std::string>& fontPaths,
-                const std::vector<std::string>& spritePaths,
-                int firstIcon);
+                const CompactStringArena& strings);
+
+    // Publish the registration tables (font/sprite paths, 1-based indices; firstIcon
+    // splits textures from icons). Called from HudManager::initializeResources — the
+    // only place they change — so the window thread re-derives its basenames once per
+    // registration instead of the producer re-sending them every frame.
+    void setResources(const std::vector<std::string>& fontPaths,
+                      const std::vector<std::string>& spritePaths,
+                      int firstIcon);
 
     // Where the .tga assets live (default: the game-relative plugin data dir).
     void setAssetRoot(const std::string& root);
@@ -106,12 +128,17 @@ private:
     // (loader-lock-safe teardown — see ~CompanionWindow). Starts true: no thread yet.
     std::atomic<bool> m_threadFinished{ true };
 
+    // Frame handoff: producer (game/worker thread) fills writeSlot(), the window
+    // thread renders straight out of acquire(). See core/render_frame_buffer.h.
+    RenderFrameBuffer<Frame> m_frames;
+
+    // Rarely-changing inputs (registration tables, asset root), guarded by m_mutex.
+    // m_resourceGen bumps on every change so the window thread copies them only when
+    // they actually moved, not every frame.
     std::mutex m_mutex;
-    std::vector<SPluginQuad_t> m_quads;
-    std::vector<SPluginString_t> m_strings;
-    std::vector<std::string> m_fontBases;    // basenames derived from paths (rebuilt on size change)
+    std::vector<std::string> m_fontBases;    // basenames derived from paths
     std::vector<std::string> m_spriteBases;
     int m_firstIcon = 1 << 30;
     std::string m_assetRoot = "plugins/mxbmrp3_data";
-    bool m_haveFrame = false;
+    std::atomic<unsigned> m_resourceGen{ 1 };
 };
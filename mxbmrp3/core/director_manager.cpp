@@ -168,7 +168,7 @@ void DirectorManager::toggleLock() {
     }
 }
 
-int DirectorManager::pickShot(bool isBattle, const std::vector<int>& group, int* outTarget) {
+int DirectorManager::pickShot(bool isBattle, const int* group, size_t groupSize, int* outTarget) {
     using CR = SpectateHandler::CameraRole;
 
     // Forward-facing onboards (look AHEAD at the rider in front) - the chaser's-eye view
@@ -194,7 +194,7 @@ int DirectorManager::pickShot(bool isBattle, const std::vector<int>& group, int*
         // Build only the options the enabled cams support, then rotate; with none usable
         // we stay Trackside rather than ever pointing an onboard the wrong way.
         struct Opt { int rider; int role; } opts[8]; int nOpt = 0;
-        const int groupN = static_cast<int>(group.size());
+        const int groupN = static_cast<int>(groupSize);
         if (m_camRear && groupN >= 1) opts[nOpt++] = { group[0], static_cast<int>(CR::REAR) };
         for (int i = 1; i < groupN && nFwd > 0 && nOpt < 8; ++i)
             opts[nOpt++] = { group[i], static_cast<int>(fwd[(i - 1) % nFwd]) };
@@ -278,14 +278,13 @@ bool DirectorManager::isActivelyDirecting() const {
 
 void DirectorManager::cutTo(int raceNum, bool isBattle, long long now, int forceRole,
                             int shotType, int partner,
-                            const std::vector<int>* group, const char* reason) {
+                            const int* group, size_t groupSize, const char* reason) {
     int target = raceNum;
     int role;
     if (forceRole >= 0) {
         role = forceRole;   // incident/fastest/pace/finish force Trackside; no variety dip
     } else {
-        static const std::vector<int> kEmpty;
-        role = pickShot(isBattle, group ? *group : kEmpty, &target);
+        role = pickShot(isBattle, group, group ? groupSize : 0, &target);
     }
     // A battle dip can redirect the shot to a chasing rider; then the front rider (the
     // original subject) becomes the framed partner, so the badge still reads the contested
@@ -14,9 +14,46 @@
 // ============================================================================
 #pragma once
 
-#include <unordered_map>
+#include "battle_groups.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+namespace director_detail {
+    // One racing rider in evaluate()'s per-decision snapshot.
+    struct Rider {
+        int position;
+        int raceNum;
+        int gapToLeaderMs;
+        int gapLaps;
+        int numLaps;      // completed laps (for final-lap detection)
+        int bestLapMs;    // best lap so far in ms (-1 = none; for fastest-lap detection)
+        bool finished;    // crossed the line for good (don't follow incidents/battles on them)
+    };
+
+    // Race number -> int for the per-rider baselines evaluate() refreshes every
+    // decision. A flat vector sorted by race number rather than a hash map: a
+    // refill (clear, add, seal) reuses the capacity, so once the field is known the
+    // ~3x/s rebuild stops allocating, and a 50-rider binary search beats hashing.
+    struct RiderValues {
+        std::vector<std::pair<int, int>> entries;  // (raceNum, value), sorted by seal()
+
+        void clear() { entries.clear(); }
+        bool empty() const { return entries.empty(); }
+        void add(int raceNum, int value) { entries.emplace_back(raceNum, value); }
+        void seal() { std::sort(entries.begin(), entries.end()); }
+        void swap(RiderValues& other) { entries.swap(other.entries); }
+        // nullptr when absent. Race numbers are unique within one refill.
+        const int* find(int raceNum) const {
+            auto it = std::lower_bound(entries.begin(), entries.end(), std::make_pair(raceNum, INT_MIN));
+            return (it != entries.end() && it->first == raceNum) ? &it->second : nullptr;
+        }
+    };
+}  // namespace director_detail
+
 class DirectorManager {
 public:
     static DirectorManager& getInstance();
@@ -217,8 +254,9 @@ private:
     // of running the per-context pickShot - used by incident/fastest/finish
     // cuts that always want Trackside. shotType < 0 derives solo/battle from isBattle;
     // partner is the other rider in a battle/overtake shot (-1 = none).
-    // `group` (front-first race numbers) lets a battle variety dip redirect the shot to a
-    // chasing rider with a forward onboard; pass nullptr for solo / forced cuts.
+    // `group` / `groupSize` (front-first race numbers) lets a battle variety dip redirect
+    // the shot to a chasing rider with a forward onboard; pass nullptr, 0 for solo /
+    // forced cuts.
     // `reason` is the PACING trigger for this cut (why the camera left the previous shot
     // NOW), logged as reason=<...> alongside the shot type so a log/replay can tell a
     // min-shot-honoring cut from a legitimate bypass. The distinction matters because the
@@ -232,7 +270,7 @@ private:
     // min-shot floor by design; everything else honors it.
     void cutTo(int raceNum, bool isBattle, long long now, int forceRole = -1,
                int shotType = -1, int partner = -1,
-               const std::vector<int>* group = nullptr,
+               const int* group = nullptr, size_t groupSize = 0,
                const char* reason = "?");
     // Event-log transparency (broadcast). Entries are emitted UNCONDITIONALLY, like every
     // other event producer — the in-game "Director" event toggle and the web overlay filter
@@ -250,7 +288,7 @@ private:
     // Per-context camera + variety. For a battle variety dip it may redirect the shot to a
     // group rider (front -> Rear Fender; a chaser -> a forward onboard), writing the chosen
     // rider to *outTarget (left = the subject otherwise). Returns the CameraRole as int.
-    int pickShot(bool isBattle, const std::vector<int>& group, int* outTarget);
+    int pickShot(bool isBattle, const int* group, size_t groupSize, int* outTarget);
 
     // Story-hold helpers (incident / fastest-lap / non-race pace). One shared latch
     // holds whichever story shot is currently pinned; only one can hold at a time
@@ -332,12 +370,12 @@ private:
     long long m_holdUntilMs = 0;        // hold the current story shot until this time (0 = no hold)
 
     // Story-toggle runtime state.
-    std::unordered_map<int,int> m_prevCrashCount;  // per-rider crash count, for rising-edge detection
+    director_detail::RiderValues m_prevCrashCount;  // per-rider crash count, for rising-edge detection
     int m_prevBestOverallMs = -1;       // previous overall fastest lap (ms), for new-PB detection
     int m_hazardLatchSubject = -1;      // subject we already fired a hazard-incident for (edge latch)
 
     // Overtake detection runtime state.
-    std::unordered_map<int,int> m_prevPosition;  // per-rider official position last eval (for swap detection)
+    director_detail::RiderValues m_prevPosition;  // per-rider official position last eval (for swap detection)
     int m_overtakeSubject = -1;         // rider rewarded for a just-completed pass
     int m_overtakePartner = -1;         // the rider just passed (framed behind the overtaker)
     int m_overtakeGained = 1;           // how many riders the overtaker passed in the move
@@ -345,7 +383,7 @@ private:
     // Drop detection runtime state (rider tumbling down the order). A rolling window
     // baseline captures each rider's position; a rider whose position has worsened by
     // >= the threshold since the baseline is "dropping". m_dropLost is the positions lost.
-    std::unordered_map<int,int> m_dropBasePos;  // per-rider position at the window baseline
+    director_detail::RiderValues m_dropBasePos;  // per-rider position at the window baseline
     long long m_dropWindowStartMs = 0;  // when the current drop window baseline was taken
     int m_dropSubject = -1;             // rider rewarded for a fresh tumble
     int m_dropLost = 0;                 // positions lost in the move (for the caption)
@@ -368,4 +406,12 @@ private:
     // max-shot dip, or a battle variety dip that swaps subject<->partner) isn't logged twice
     // in a row. Cleared on a state change and on session reset so the next cut logs fresh.
     char m_lastCutKey[32] = "";
+
+    // evaluate()'s working buffers, refilled every decision rather than rebuilt, so
+    // a steady-state evaluation allocates nothing once the field is known.
+    std::vector<director_detail::Rider> m_evalRiders;   // racing riders, by position
+    director_detail::RiderValues m_evalCrashCounts;     // next m_prevCrashCount (swapped in)
+    director_detail::RiderValues m_evalGaps;            // raceNum -> official gap to leader
+    BattleGroups m_evalBattles;                         // PluginData::getBattleGroups output
+    std::vector<int> m_evalRaceNums;                    // lull round-robin candidates
 };
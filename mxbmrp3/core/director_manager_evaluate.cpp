@@ -17,6 +17,7 @@
 #include "color_config.h"
 #include "../handlers/spectate_handler.h"
 #include "../diagnostics/logger.h"
+#include "../diagnostics/alloc_counter.h"
 
 #include <vector>
 #include <algorithm>
@@ -29,6 +30,7 @@
 using namespace director_detail;
 
 void DirectorManager::evaluate() {
+    ALLOC_PHASE(AllocCounter::Phase::DIRECTOR);
     PluginData& pd = PluginData::getInstance();
 
     // Only direct while spectating/replaying.
@@ -119,8 +121,8 @@ void DirectorManager::evaluate() {
 
     // Snapshot racing riders.
     const SessionData& sd = pd.getSessionData();
-    std::vector<Rider> riders;
-    riders.reserve(32);
+    std::vector<Rider>& riders = m_evalRiders;
+    riders.clear();
     for (const auto& kv : pd.getStandings()) {
         const StandingsData& s = kv.second;
         if (s.state != 0) continue;  // 0 = Racing (skip DNS/Retired/DSQ)
@@ -158,8 +160,8 @@ void DirectorManager::evaluate() {
         // it's unit-tested in isolation). Only the last-resort variety pick calls this,
         // and only on a lull dip (every several seconds at most), so gathering the race
         // numbers here is off the hot path. See director_airtime_test.cpp.
-        std::vector<int> raceNums;
-        raceNums.reserve(riders.size());
+        std::vector<int>& raceNums = m_evalRaceNums;
+        raceNums.clear();
         for (const Rider& r : riders) raceNums.push_back(r.raceNum);
         return DirectorManager::pickNextAirtimeNum(raceNums, currentSubject, baselineNum, m_lastAirtimeNum);
     };
@@ -206,13 +208,13 @@ void DirectorManager::evaluate() {
     // entry would otherwise linger, so a rejoiner reusing the race number inherits
     // the old baseline (one suppressed/phantom crash edge) and the map grows
     // unboundedly across a long spectate session.
-    std::unordered_map<int, int> newCrashCount;
-    newCrashCount.reserve(riders.size());
+    RiderValues& newCrashCount = m_evalCrashCounts;
+    newCrashCount.clear();
     for (const Rider& r : riders) {
         int cc = pd.getRiderSessionCrashCount(r.raceNum);
-        auto it = m_prevCrashCount.find(r.raceNum);
-        bool freshCrash = (it != m_prevCrashCount.end()) && cc > it->second;
-        newCrashCount[r.raceNum] = cc;
+        const int* prev = m_prevCrashCount.find(r.raceNum);
+        bool freshCrash = prev && cc > *prev;
+        newCrashCount.add(r.raceNum, cc);
         bool withinCut = (m_battleMaxPos <= 0 || r.position <= m_battleMaxPos);
         // Don't let a lower-order crash steal a better story we're already framing.
         bool outrankedByStory = (protectPos > 0 && r.position > protectPos);
@@ -226,7 +228,8 @@ void DirectorManager::evaluate() {
             && !alreadyHeld && !incidentYoung && !outrankedByStory && crashSubject < 0)
             crashSubject = r.raceNum;
     }
-    m_prevCrashCount = std::move(newCrashCount);
+    newCrashCount.seal();
+    m_prevCrashCount.swap(newCrashCount);
 
     // Tracked rider left the track / stopped: if the rider we are following becomes a
     // confirmed hazard (stationary or wrong-way) - an off into the dirt, a stall, a
@@ -279,13 +282,13 @@ void DirectorManager::evaluate() {
             // A finished rider's slow-down lap shuffles positions without an
             // on-track pass, so exclude pairs touching one (mirrors getBattleGroups).
             if (a.finished || b.finished) continue;
-            auto pa = m_prevPosition.find(a.raceNum);
-            auto pb = m_prevPosition.find(b.raceNum);
-            if (pa == m_prevPosition.end() || pb == m_prevPosition.end()) continue;
-            if (pa->second > pb->second) {   // a was behind b, now ahead -> a passed b
+            const int* pa = m_prevPosition.find(a.raceNum);
+            const int* pb = m_prevPosition.find(b.raceNum);
+            if (!pa || !pb) continue;
+            if (*pa > *pb) {   // a was behind b, now ahead -> a passed b
                 bool within = (m_battleMaxPos <= 0 || a.position <= m_battleMaxPos);
                 if (within && a.position < overtakerPos) {
-                    overtaker = a.raceNum; overtaken = b.raceNum; overtakerPos = a.position; overtakerPrev = pa->second;
+                    overtaker = a.raceNum; overtaken = b.raceNum; overtakerPos = a.position; overtakerPrev = *pa;
                 }
             }
         }
@@ -297,8 +300,8 @@ void DirectorManager::evaluate() {
             int passed = 0;
             for (const Rider& r : riders) {
                 if (r.raceNum == overtaker || r.finished) continue;  // skip finished riders (slow-down-lap drift)
-                auto pr = m_prevPosition.find(r.raceNum);
-                if (pr != m_prevPosition.end() && pr->second < overtakerPrev && r.position > overtakerPos) passed++;
+                const int* pr = m_prevPosition.find(r.raceNum);
+                if (pr && *pr < overtakerPrev && r.position > overtakerPos) passed++;
             }
             if (passed < 1) passed = 1;   // at least the immediate rider
             m_overtakeSubject = overtaker;
@@ -313,7 +316,8 @@ void DirectorManager::evaluate() {
         // them - the start-line scramble (everyone passing everyone) never fires an
         // overtake cut, matching the opening-lap battle deferral. Detection resumes
         // cleanly once both riders have two consecutive post-lap-1 snapshots.
-        for (const Rider& r : riders) if (r.numLaps >= 1) m_prevPosition[r.raceNum] = r.position;
+        for (const Rider& r : riders) if (r.numLaps >= 1) m_prevPosition.add(r.raceNum, r.position);
+        m_prevPosition.seal();
     } else {
         m_prevPosition.clear();  // keep the snapshot from going stale while disabled
     }
@@ -330,18 +334,19 @@ void DirectorManager::evaluate() {
             // position - never from a lap-1 holeshot spot, which would read as a big drop
             // as the start order shakes out. A rider gets no baseline (and can't fire a
             // drop) until a window re-seed catches them post-lap-1.
-            for (const Rider& r : riders) if (r.numLaps >= 1) m_dropBasePos[r.raceNum] = r.position;
+            for (const Rider& r : riders) if (r.numLaps >= 1) m_dropBasePos.add(r.raceNum, r.position);
+            m_dropBasePos.seal();
             m_dropWindowStartMs = now;
         } else {  // seedOnly already reseeded above via the first branch
             int worstNum = -1, worstLost = 0;
             for (const Rider& r : riders) {
                 if (r.finished || r.numLaps < 1) continue;
-                auto it = m_dropBasePos.find(r.raceNum);
-                if (it == m_dropBasePos.end()) continue;
-                int lost = r.position - it->second;  // positive = fell back this many places
+                const int* basePos = m_dropBasePos.find(r.raceNum);
+                if (!basePos) continue;
+                int lost = r.position - *basePos;  // positive = fell back this many places
                 // Gate on where the drama STARTED (the baseline position): a top-runner
                 // sliding back is the story, even though they end up deep in the field.
-                bool within = (m_battleMaxPos <= 0 || it->second <= m_battleMaxPos);
+                bool within = (m_battleMaxPos <= 0 || *basePos <= m_battleMaxPos);
                 if (within && lost >= kDropThreshold && lost > worstLost) {
                     worstNum = r.raceNum; worstLost = lost;
                 }
@@ -362,7 +367,7 @@ void DirectorManager::evaluate() {
     // as long as the rider stays a confirmed hazard (down / wrong-way on track), up
     // to a hard cap so a rider stuck in the gravel can't trap the camera forever.
     if (crashSubject >= 0) {
-        cutTo(crashSubject, false, now, kTrackside, SHOT_INCIDENT, -1, nullptr, "incident");
+        cutTo(crashSubject, false, now, kTrackside, SHOT_INCIDENT, -1, nullptr, 0, "incident");
         armHold(SHOT_INCIDENT, now, holdMs());
         return;
     }
@@ -383,7 +388,7 @@ void DirectorManager::evaluate() {
     // only an incident cuts instantly. A skipped flash is fine: the rider keeps the lap.
     if (m_followFastestLap && freshFastest && fastestHolder != m_currentSubject
         && (now - m_shotStartMs) >= minShotMs()) {
-        cutTo(fastestHolder, false, now, kTrackside, SHOT_FASTEST, -1, nullptr, "fastest");
+        cutTo(fastestHolder, false, now, kTrackside, SHOT_FASTEST, -1, nullptr, 0, "fastest");
         armHold(SHOT_FASTEST, now, holdMs());
         return;
     }
@@ -439,7 +444,7 @@ void DirectorManager::evaluate() {
         // cut, so it always passes - we keep riding their lap as they string splits.
         const bool wouldCut = (paceSubject != m_currentSubject || m_currentShotType != SHOT_PACE);
         if (!wouldCut || (now - m_shotStartMs) >= minShotMs()) {
-            if (wouldCut) cutTo(paceSubject, false, now, kTrackside, SHOT_PACE, -1, nullptr, "pace");
+            if (wouldCut) cutTo(paceSubject, false, now, kTrackside, SHOT_PACE, -1, nullptr, 0, "pace");
             armHold(SHOT_PACE, now, holdMs());
             m_currentPaceSplit = paceSplit;  // remember which sector for the overlay caption
             return;
@@ -460,7 +465,7 @@ void DirectorManager::evaluate() {
         const int paceSetter = leader.raceNum;
         const long long shotElapsed = now - m_shotStartMs;
         if (m_currentSubject < 0 || !currentPresent) {
-            cutTo(paceSetter, false, now, -1, -1, -1, nullptr,
+            cutTo(paceSetter, false, now, -1, -1, -1, nullptr, 0,
                   m_currentSubject < 0 ? "acquire" : "subject-gone");
             return;
         }
@@ -476,13 +481,13 @@ void DirectorManager::evaluate() {
             const long long dwellCap = onboard ? minShotMs() : maxShotMs();
             if (shotElapsed >= dwellCap) {
                 int v = nextAirtimeSubject(m_currentSubject, paceSetter);
-                if (v >= 0) cutTo(v, false, now, -1, -1, -1, nullptr, "maxshot");
+                if (v >= 0) cutTo(v, false, now, -1, -1, -1, nullptr, 0, "maxshot");
             }
             return;
         }
         // Currently on someone other than the pace-setter (a variety dip or a finished
         // hot lap): return to the pace-setter once the minimum shot has elapsed.
-        if (shotElapsed >= minShotMs()) cutTo(paceSetter, false, now, -1, -1, -1, nullptr, "return");
+        if (shotElapsed >= minShotMs()) cutTo(paceSetter, false, now, -1, -1, -1, nullptr, 0, "return");
         return;
     }
 
@@ -515,29 +520,35 @@ void DirectorManager::evaluate() {
     // (battle gap + max position both live in the Director settings). Follow the front
     // rider of each group (chaser framed behind); closeness from the front pair's gap.
     // A bigger group (3+ riders nose-to-tail) scores higher than a lone pair.
-    std::unordered_map<int, int> gapByNum;
-    gapByNum.reserve(riders.size());
-    for (const Rider& r : riders) gapByNum[r.raceNum] = r.gapToLeaderMs;
+    RiderValues& gapByNum = m_evalGaps;
+    gapByNum.clear();
+    for (const Rider& r : riders) gapByNum.add(r.raceNum, r.gapToLeaderMs);
+    gapByNum.seal();
     // The "Follow battles" toggle gates only the director's subject scoring; the
     // battle-gap value still defines a battle for the overlay panel independently, so
-    // when off we simply don't score any battle groups (empty -> findGroup() nullptr).
-    const auto battleGroups = m_followBattles ? pd.getBattleGroups(m_battleGapMs, m_battleMaxPos)
-                                              : std::vector<std::vector<int>>{};
+    // when off we simply don't score any battle groups (empty -> findGroup() -1).
+    BattleGroups& battleGroups = m_evalBattles;
+    if (m_followBattles) pd.getBattleGroups(m_battleGapMs, m_battleMaxPos, battleGroups);
+    else battleGroups.clear();
     // Look up the group a battle front leads (so a cut can hand pickShot the riders to
-    // rotate the onboard through). Returns nullptr for non-battle-front subjects.
-    auto findGroup = [&](int frontNum) -> const std::vector<int>* {
-        for (const auto& g : battleGroups) if (!g.empty() && g[0] == frontNum) return &g;
-        return nullptr;
+    // rotate the onboard through). Returns its index, or -1 for non-battle-front subjects.
+    auto findGroup = [&](int frontNum) -> int {
+        for (size_t g = 0; g < battleGroups.count(); ++g) {
+            if (battleGroups.groupSize(g) > 0 && battleGroups.group(g)[0] == frontNum) return static_cast<int>(g);
+        }
+        return -1;
     };
-    for (const auto& grp : battleGroups) {
-        if (grp.size() < 2) continue;
+    for (size_t g = 0; g < battleGroups.count(); ++g) {
+        if (battleGroups.groupSize(g) < 2) continue;
+        const int* grp = battleGroups.group(g);
         int frontNum = grp[0], chaserNum = grp[1];
         int frontPos = pd.getPositionForRaceNum(frontNum);
-        auto fg = gapByNum.find(frontNum), cg = gapByNum.find(chaserNum);
-        if (frontPos <= 0 || fg == gapByNum.end() || cg == gapByNum.end()) continue;
-        int interval = cg->second - fg->second;
+        const int* fg = gapByNum.find(frontNum);
+        const int* cg = gapByNum.find(chaserNum);
+        if (frontPos <= 0 || !fg || !cg) continue;
+        int interval = *cg - *fg;
         if (interval <= 0) continue;  // defensive; getBattleGroups already guarantees > 0
-        int groupSize = static_cast<int>(grp.size());
+        int groupSize = static_cast<int>(battleGroups.groupSize(g));
         double closeness = 1.0 - static_cast<double>(interval) / m_battleGapMs;
         double sizeBoost = std::min(2.0, 1.0 + (groupSize - 2) * 0.25);  // 2->1.0, 3->1.25 ... cap 2.0
         double score = closeness * posWeight(frontPos) * 2.0 * sizeBoost;
@@ -671,7 +682,7 @@ void DirectorManager::evaluate() {
             && s == m_dropSubject) return SHOT_DROP;
         // Tag a lapping shot - but only if this rider isn't also a battle front (a real
         // position battle wins the label and the chaser-dip behaviour via groupFor).
-        if (m_followLappers && s >= 0 && s == m_lapperSubject && !findGroup(s)) return SHOT_LAPPER;
+        if (m_followLappers && s >= 0 && s == m_lapperSubject && findGroup(s) < 0) return SHOT_LAPPER;
         return -1;
     };
 
@@ -679,14 +690,17 @@ void DirectorManager::evaluate() {
 
     // Hand the battle's group to the cut only for a plain battle (shotFor < 0) - not for an
     // overtake or the finish lock, which stay front-anchored on Trackside.
-    auto groupFor = [&](int subject, bool isBattle) -> const std::vector<int>* {
-        return (isBattle && shotFor(subject) < 0) ? findGroup(subject) : nullptr;
+    auto groupFor = [&](int subject, bool isBattle) -> int {
+        return (isBattle && shotFor(subject) < 0) ? findGroup(subject) : -1;
     };
+    auto groupRiders = [&](int g) -> const int* { return g >= 0 ? battleGroups.group(g) : nullptr; };
+    auto groupSizeOf = [&](int g) -> size_t { return g >= 0 ? battleGroups.groupSize(g) : 0; };
 
     // First shot, or the rider we were following has left the race: cut now.
     if (m_currentSubject < 0 || !currentPresent) {
+        const int g = groupFor(bestSubject, bestIsBattle);
         cutTo(bestSubject, bestIsBattle, now, finishRole, shotFor(bestSubject), bestPartner,
-              groupFor(bestSubject, bestIsBattle),
+              groupRiders(g), groupSizeOf(g),
               m_currentSubject < 0 ? "acquire" : "subject-gone");
         return;
     }
@@ -728,7 +742,8 @@ void DirectorManager::evaluate() {
     // The finish lock bypasses the minimum so it snaps to the front immediately.
     long long gate = finishWindow ? 0 : minShotMs();
     if (shotElapsed >= gate) {
+        const int g = groupFor(targetSubject, targetIsBattle);
         cutTo(targetSubject, targetIsBattle, now, finishRole, shotFor(targetSubject), targetPartner,
-              groupFor(targetSubject, targetIsBattle), reason);
+              groupRiders(g), groupSizeOf(g), reason);
     }
 }
@@ -73,14 +73,4 @@ namespace director_detail {
         if (boost < 0) boost = 0;
         return 1.0 + boost * 0.08;
     }
-
-    struct Rider {
-        int position;
-        int raceNum;
-        int gapToLeaderMs;
-        int gapLaps;
-        int numLaps;      // completed laps (for final-lap detection)
-        int bestLapMs;    // best lap so far in ms (-1 = none; for fastest-lap detection)
-        bool finished;    // crossed the line for good (don't follow incidents/battles on them)
-    };
 }  // namespace director_detail
@@ -7,12 +7,13 @@
 #if GAME_HAS_RECORDER
 
 #include "performance_timer.h"
+#include "plugin_data.h"
 #include "../diagnostics/logger.h"
 
 #include <windows.h>
+#include <chrono>
 #include <cstring>
 #include <ctime>
-#include <vector>
 
 EventRecorder::EventRecorder()
     : m_file(nullptr), m_recording(false), m_configEnabled(false),
@@ -27,13 +28,16 @@ EventRecorder::EventRecorder()
 
 EventRecorder::~EventRecorder() {
     // Self-contained teardown: touches only our own FILE* (finalize the tape). The
-    // one cross-singleton reach is stopRecording()'s DEBUG_INFO_F -> Logger, which is
+    // one cross-singleton reach is finishRecording()'s DEBUG_INFO_F -> Logger, which is
     // safe during static teardown because Logger is constructed first (destroyed
     // last), so it outlives us — see the fuller note in hud_manager.cpp's ~HudManager.
     // Never reaches SettingsManager/CompanionWindow etc. (constructed later, torn
     // down first), so it's safe even on the DLL-detach static-destruction path.
+    // That path may hold the loader lock, so the writer thread is not joined here
+    // (same reasoning as ~CompanionWindow) - finishRecording(false) waits for it.
     if (m_recording) {
-        stopRecording();
+        m_recording = false;
+        finishRecording(/*canJoin=*/false);
     }
 }
 
@@ -96,15 +100,45 @@ bool EventRecorder::startRecording(const char* filePath) {
     m_recording = true;
     m_startTimeUs = getCurrentTimeUs();
     m_eventCount = 0;
+    m_lastKeyframeUs = 0;
 
     // Write initial header (a failure closes the file and clears m_recording —
     // report the start as failed rather than recording into a headerless file).
+    // Synchronous: the writer thread doesn't exist yet.
     writeHeader();
     if (!m_recording) {
         DEBUG_WARN_F("EventRecorder: Failed to write header: %s", filePath);
         return false;
     }
 
+    // Buffers are allocated once per recording, here - never on the game thread's
+    // append path (unless a full buffer finds the writer busy; see writeEvent).
+    // Filled once so their pages are committed now rather than faulted in, a page
+    // at a time, by the game thread's first pass through them.
+    for (auto& b : m_buffers) {
+        b.assign(BUFFER_BYTES, 0);
+        b.clear();
+    }
+    m_active = 0;
+    m_activeSinceUs = 0;
+    m_handoff.store(HANDOFF_FREE);
+    m_writeFailed.store(false);
+    m_statEvents = 0;
+    m_statTicks = 0;
+    m_statMaxTicks = 0;
+    m_statHandoffs = 0;
+    m_statGrows = 0;
+    m_bytesWritten.store(0);
+    m_keyframe.reserve(64 * 1024);
+    m_blocks.begin(sizeof(Recording::FileHeader));
+    m_fileBytes.store(m_blocks.fileBytes());
+
+    m_writerRun.store(true);
+    m_writer = std::thread([this] {
+        try { writerThreadMain(); }
+        catch (...) { m_writeFailed.store(true); }
+    });
+
     DEBUG_INFO_F("EventRecorder: Started recording to %s", filePath);
     return true;
 }
@@ -115,6 +149,45 @@ void EventRecorder::stopRecording() {
     }
 
     m_recording = false;
+    finishRecording(/*canJoin=*/true);
+}
+
+void EventRecorder::finishRecording(bool canJoin) {
+    // Let the writer finish what it was handed, so the remaining active buffer
+    // lands after it in the file.
+    bool drained = true;
+    if (canJoin) {
+        stopWriter();
+    } else {
+        // No join (static teardown, possibly under the loader lock). A live writer
+        // drains its handoff and exits on its own; after ExitProcess it is already
+        // dead, possibly mid-write. Wait briefly, then take over an unclaimed buffer
+        // or give up on one the dead writer left half-written.
+        m_writerRun.store(false);
+        if (m_writer.joinable()) m_writer.detach();
+        for (int i = 0; i < 200 && m_handoff.load() != HANDOFF_FREE; ++i) Sleep(5);
+        int pending = m_handoff.load();
+        if (pending == 0 || pending == 1) {
+            if (m_handoff.compare_exchange_strong(pending, pending + WRITING)) {
+                drained = writeBuffer(pending);
+                m_handoff.store(HANDOFF_FREE);
+            }
+        }
+        drained = drained && m_handoff.load() == HANDOFF_FREE;
+    }
+
+    if (drained && !m_writeFailed.load() && m_file && !m_buffers[m_active].empty()) {
+        if (!writeBuffer(m_active)) m_writeFailed.store(true);
+    }
+    // Close the last block and append the block index. Skipped if the tape is
+    // already short: readers walk the blocks without it.
+    if (drained && !m_writeFailed.load() && m_file) {
+        if (m_blocks.finish(m_file)) m_fileBytes.store(m_blocks.fileBytes());
+        else m_writeFailed.store(true);
+    }
+    if (m_writeFailed.load() || !drained) {
+        DEBUG_WARN("EventRecorder: final flush failed - tape truncated");
+    }
 
     // Update header with final event count and end time
     updateHeader();
@@ -124,7 +197,28 @@ void EventRecorder::stopRecording() {
         m_file = nullptr;
     }
 
-    DEBUG_INFO_F("EventRecorder: Stopped recording (%u events)", m_eventCount);
+    const Stats st = getStats();
+    DEBUG_INFO_F("EventRecorder: Stopped recording (%u events, %.2f MB -> %.2f MB on disk; game thread %.0f ns/event avg, %.1f us max; %llu handoffs, %llu buffer grows)",
+                 m_eventCount, static_cast<double>(st.bytesWritten) / (1024.0 * 1024.0),
+                 static_cast<double>(st.fileBytes) / (1024.0 * 1024.0),
+                 st.avgEventNs, st.maxEventUs,
+                 static_cast<unsigned long long>(st.buffersWritten),
+                 static_cast<unsigned long long>(st.bufferGrows));
+}
+
+EventRecorder::Stats EventRecorder::getStats() const {
+    Stats st;
+    st.events = m_statEvents;
+    if (m_performanceFrequency > 0) {
+        const double nsPerTick = 1e9 / static_cast<double>(m_performanceFrequency);
+        st.avgEventNs = m_statEvents ? static_cast<double>(m_statTicks) * nsPerTick / static_cast<double>(m_statEvents) : 0.0;
+        st.maxEventUs = static_cast<double>(m_statMaxTicks) * nsPerTick / 1000.0;
+    }
+    st.buffersWritten = m_statHandoffs;
+    st.bytesWritten = m_bytesWritten.load();
+    st.fileBytes = m_fileBytes.load();
+    st.bufferGrows = m_statGrows;
+    return st;
 }
 
 void EventRecorder::writeHeader() {
@@ -157,7 +251,7 @@ void EventRecorder::updateHeader() {
     header.numEvents = m_eventCount;
     header.endTimeUs = getCurrentTimeUs();
 
-    if (fseek(m_file, 0, SEEK_SET) != 0 ||
+    if (tape_io::seek64(m_file, 0, SEEK_SET) != 0 ||
         fwrite(&header, sizeof(header), 1, m_file) != 1) {
         // Close-time rewrite failed: the count/end-time stay at their initial
         // values. Informational only (the replayer reads to EOF), so just log.
@@ -165,7 +259,7 @@ void EventRecorder::updateHeader() {
         return;
     }
     fflush(m_file);
-    fseek(m_file, 0, SEEK_END);   // restore append position (defensive)
+    tape_io::seek64(m_file, 0, SEEK_END);   // restore append position (defensive)
 }
 
 void EventRecorder::handleWriteFailure() {
@@ -175,42 +269,112 @@ void EventRecorder::handleWriteFailure() {
     // log line is the right amount of ceremony.
     DEBUG_WARN("EventRecorder: write failed (disk full?) - recording stopped, tape truncated");
     m_recording = false;
+    stopWriter();
     if (m_file) {
         fclose(m_file);
         m_file = nullptr;
     }
 }
 
-void EventRecorder::writeEvent(Recording::EventType type, const void* data, size_t size) {
+void EventRecorder::writeEvent(Recording::EventType type, const void* data, size_t size,
+                               const void* extra, size_t extraSize) {
     if (!m_recording || !m_file) return;
 
-    // Calculate timestamp relative to recording start
-    uint64_t timestamp = getCurrentTimeUs() - m_startTimeUs;
-
-    // Write event header. A failed write (disk full, I/O error) previously went
-    // unnoticed: the tape silently truncated/corrupted while m_eventCount kept
-    // climbing. Stop on first failure instead — a partial trailing record is fine
-    // (the replayer reads to EOF and drops an incomplete tail), more writes aren't.
-    Recording::EventHeader eventHeader(type, static_cast<uint32_t>(size), timestamp);
-    if (fwrite(&eventHeader, sizeof(eventHeader), 1, m_file) != 1) {
+    // The writer thread reports I/O failures; act on them here, on the owning thread.
+    if (m_writeFailed.load(std::memory_order_relaxed)) {
         handleWriteFailure();
         return;
     }
 
-    // Write event data
-    if (data && size > 0) {
-        if (fwrite(data, size, 1, m_file) != 1) {
-            handleWriteFailure();
-            return;
+    // One counter read serves both the event timestamp and the cost measurement.
+    const long long t0 = PerformanceTimer::getCounter();
+    const uint64_t nowUs = PerformanceTimer::counterToMicroseconds(m_performanceFrequency, t0);
+
+    if (!data) size = 0;
+    if (!extra) extraSize = 0;
+    const size_t payload = size + extraSize;
+    Recording::EventHeader eventHeader(type, static_cast<uint32_t>(payload), nowUs - m_startTimeUs);
+
+    // Hand the active buffer over when this event wouldn't fit or it has held
+    // events for FLUSH_INTERVAL_US. If the writer still has the other one (a disk
+    // stall), keep appending: the buffer grows rather than blocking the game or
+    // dropping events, and hands over at the next chance.
+    std::vector<uint8_t>* buf = &m_buffers[m_active];
+    const bool full = buf->size() + sizeof(eventHeader) + payload > buf->capacity();
+    const bool due = !buf->empty() && nowUs - m_activeSinceUs >= FLUSH_INTERVAL_US;
+    if (full || due) {
+        if (m_handoff.load(std::memory_order_acquire) == HANDOFF_FREE) {
+            handOff();
+            buf = &m_buffers[m_active];
+        } else if (full) {
+            ++m_statGrows;
         }
     }
+    if (buf->empty()) m_activeSinceUs = nowUs;
 
+    const uint8_t* h = reinterpret_cast<const uint8_t*>(&eventHeader);
+    buf->insert(buf->end(), h, h + sizeof(eventHeader));
+    if (size) {
+        const uint8_t* d = static_cast<const uint8_t*>(data);
+        buf->insert(buf->end(), d, d + size);
+    }
+    if (extraSize) {
+        const uint8_t* e = static_cast<const uint8_t*>(extra);
+        buf->insert(buf->end(), e, e + extraSize);
+    }
     m_eventCount++;
 
-    // Flush periodically (every 100 events) so an abnormal process exit
-    // (e.g. ExitProcess without a clean Shutdown) loses at most ~100 events.
-    if (m_eventCount % 100 == 0) {
-        fflush(m_file);
+    const long long dt = PerformanceTimer::getCounter() - t0;
+    ++m_statEvents;
+    m_statTicks += dt;
+    if (dt > m_statMaxTicks) m_statMaxTicks = dt;
+}
+
+void EventRecorder::handOff() {
+    // The other buffer is free (checked by the caller), so it was emptied by the
+    // writer - swap to it and publish this one.
+    const int full = m_active;
+    m_active = 1 - m_active;
+    ++m_statHandoffs;
+    m_handoff.store(full, std::memory_order_release);
+}
+
+bool EventRecorder::writeBuffer(int index) {
+    std::vector<uint8_t>& b = m_buffers[index];
+    if (!b.empty()) {
+        // Block-encode, then checkpoint the open block so everything handed over
+        // is on disk (see the WRITE PATH note in the header).
+        if (!m_blocks.write(m_file, b.data(), b.size()) || !m_blocks.checkpoint(m_file)) return false;
+        m_bytesWritten.fetch_add(b.size(), std::memory_order_relaxed);
+        m_fileBytes.store(m_blocks.fileBytes(), std::memory_order_relaxed);
+    }
+    b.clear();   // keeps its capacity for the next round
+    return true;
+}
+
+void EventRecorder::writerThreadMain() {
+    // Poll with a short sleep, not a condition variable: the game thread must never
+    // pay for a notify, and a few ms is nothing against FLUSH_INTERVAL_US.
+    for (;;) {
+        int index = m_handoff.load(std::memory_order_acquire);
+        if (index == 0 || index == 1) {
+            if (!m_handoff.compare_exchange_strong(index, index + WRITING)) continue;
+            if (!writeBuffer(index)) {
+                m_writeFailed.store(true);
+                m_buffers[index].clear();
+            }
+            m_handoff.store(HANDOFF_FREE, std::memory_order_release);
+            continue;
+        }
+        if (!m_writerRun.load(std::memory_order_acquire)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+void EventRecorder::stopWriter() {
+    m_writerRun.store(false, std::memory_order_release);
+    if (m_writer.joinable() && m_writer.get_id() != std::this_thread::get_id()) {
+        m_writer.join();
     }
 }
 
@@ -293,7 +457,7 @@ void EventRecorder::recordRaceHoleshot(const SPluginsRaceHoleshot_t* data) {
 void EventRecorder::recordRaceClassification(const SPluginsRaceClassification_t* data,
                                             const SPluginsRaceClassificationEntry_t* entries,
                                             int numEntries) {
-    if (!m_recording || !data || !entries || numEntries <= 0) return;   // fast-path (allocates below)
+    if (!m_recording || !data || !entries || numEntries <= 0) return;   // fast-path (packs below)
 
     // Pack classification data (header + entries)
     struct ClassificationData {
@@ -305,26 +469,26 @@ void EventRecorder::recordRaceClassification(const SPluginsRaceClassification_t*
     memcpy(&classificationData.header, data, sizeof(SPluginsRaceClassification_t));
     classificationData.numEntries = numEntries;
 
-    // Calculate total size
-    size_t totalSize = sizeof(classificationData) +
-                       (numEntries * sizeof(SPluginsRaceClassificationEntry_t));
-
-    // Use vector for exception-safe memory management
-    std::vector<uint8_t> buffer(totalSize);
+    // Classification ticks steadily through a whole session, and this tap runs
+    // before the plugin applies it: a clean point to snapshot the state.
+    recordStateKeyframe();
 
-    // Copy classification header
-    memcpy(buffer.data(), &classificationData, sizeof(classificationData));
-
-    // Copy entries
-    memcpy(buffer.data() + sizeof(classificationData), entries,
-           numEntries * sizeof(SPluginsRaceClassificationEntry_t));
+    // Prefix + entries, appended straight into the tape buffer
+    writeEvent(Recording::EventType::RaceClassification, &classificationData, sizeof(classificationData),
+               entries, numEntries * sizeof(SPluginsRaceClassificationEntry_t));
+}
 
-    // Write event
-    writeEvent(Recording::EventType::RaceClassification, buffer.data(), totalSize);
+void EventRecorder::recordStateKeyframe() {
+    if (m_keyframeSeconds <= 0) return;
+    const uint64_t nowUs = getCurrentTimeUs();
+    if (m_lastKeyframeUs != 0 && nowUs - m_lastKeyframeUs < static_cast<uint64_t>(m_keyframeSeconds) * 1000000ULL) return;
+    m_lastKeyframeUs = nowUs;
+    PluginData::getInstance().writeKeyframe(m_keyframe);
+    writeEvent(Recording::EventType::StateKeyframe, m_keyframe.data(), m_keyframe.size());
 }
 
 void EventRecorder::recordRaceTrackPosition(const SPluginsRaceTrackPosition_t* positions, int numVehicles) {
-    if (!m_recording || !positions || numVehicles <= 0) return;   // fast-path (allocates below; fires many/sec)
+    if (!m_recording || !positions || numVehicles <= 0) return;   // fast-path (fires many/sec)
 
     // Pack track position data (count + positions)
     struct TrackPositionData {
@@ -334,22 +498,9 @@ void EventRecorder::recordRaceTrackPosition(const SPluginsRaceTrackPosition_t* p
 
     trackPositionData.numVehicles = numVehicles;
 
-    // Calculate total size
-    size_t totalSize = sizeof(trackPositionData) +
-                       (numVehicles * sizeof(SPluginsRaceTrackPosition_t));
-
-    // Use vector for exception-safe memory management
-    std::vector<uint8_t> buffer(totalSize);
-
-    // Copy header
-    memcpy(buffer.data(), &trackPositionData, sizeof(trackPositionData));
-
-    // Copy positions
-    memcpy(buffer.data() + sizeof(trackPositionData), positions,
-           numVehicles * sizeof(SPluginsRaceTrackPosition_t));
-
-    // Write event
-    writeEvent(Recording::EventType::RaceTrackPosition, buffer.data(), totalSize);
+    // Count + positions, appended straight into the tape buffer
+    writeEvent(Recording::EventType::RaceTrackPosition, &trackPositionData, sizeof(trackPositionData),
+               positions, numVehicles * sizeof(SPluginsRaceTrackPosition_t));
 }
 
 void EventRecorder::recordRaceCommunication(const SPluginsRaceCommunication_t* data, int dataSize) {
@@ -450,7 +601,7 @@ void EventRecorder::recordDraw() {
 }
 
 void EventRecorder::recordTrackCenterline(int numSegments, void* segments, void* raceData) {
-    if (!m_recording) return;   // fast-path (allocates below)
+    if (!m_recording) return;   // fast-path
     (void)raceData;
     // Record full track centerline data for 1:1 reproduction.
     // Note: raceData size is unknown (API doesn't specify), so we skip it.
@@ -465,21 +616,9 @@ void EventRecorder::recordTrackCenterline(int numSegments, void* segments, void*
         return;
     }
 
-    // Calculate total size: numSegments + segment array
-    const size_t segmentArraySize = numSegments * sizeof(SPluginsTrackSegment_t);
-    const size_t totalSize = sizeof(int) + segmentArraySize;
-
-    // Use vector for exception-safe memory management
-    std::vector<uint8_t> buffer(totalSize);
-
-    // Write numSegments first
-    *reinterpret_cast<int*>(buffer.data()) = numSegments;
-
-    // Copy segment array
-    memcpy(buffer.data() + sizeof(int), segments, segmentArraySize);
-
-    // Write event
-    writeEvent(Recording::EventType::TrackCenterline, buffer.data(), totalSize);
+    // numSegments, then the segment array
+    writeEvent(Recording::EventType::TrackCenterline, &numSegments, sizeof(int),
+               segments, numSegments * sizeof(SPluginsTrackSegment_t));
 }
 
 void EventRecorder::recordRaceDeinit() {
@@ -1,7 +1,8 @@
 // ============================================================================
 // core/event_recorder.h
 // In-plugin callback-tape recorder. Writes the raw PiBoSo callback stream the
-// game sends us to a .tape file, for headless replay in the integration harness
+// game sends us to a .tape file (MXBHREC v2: deflated event blocks + an index,
+// see core/tape_io.h), for headless replay in the integration harness
 // (see tests/integration/harness/tape.h and PluginHost::replayTape()).
 //
 // This replaces the old standalone mxbmrp3_record.dlo plugin: the main plugin
@@ -20,6 +21,30 @@
 // on-disk layout must still stay self-consistent across record/parse. The committed
 // golden-master tapes are coupled to the SPlugins* layout at record time and need
 // re-recording after an API-struct change.
+// The v2 container around the events (blocks, index) is not mirrored: writer and
+// readers share core/tape_io.h.
+//
+// WRITE PATH: the game thread never touches stdio. A record* call appends the
+// framed event into the active one of two large in-memory buffers (a memcpy, no
+// lock, no syscall) and, when that buffer is full or has been collecting for
+// FLUSH_INTERVAL_US, hands it to a background writer thread that fwrites and
+// flushes it while the game thread fills the other one. The writer packs events
+// into tape_io blocks, deflating them off the game thread; each handoff is a
+// checkpoint that rewrites the still-open block in place, so blocks stay large
+// (ratio). A process exit between checkpoints loses ~FLUSH_INTERVAL_US of events
+// (and the index, which readers don't need). A crash or power loss DURING a
+// checkpoint can tear the open block itself, losing all of it - up to
+// tape_io::BLOCK_BYTES raw, many seconds of events; closed blocks are never
+// rewritten. The writer flushes but doesn't fsync, so the OS decides what
+// survives a power cut.
+// The per-event game-thread cost is measured (getStats) and logged on stop.
+//
+// STATE KEYFRAMES: every keyframeSeconds the recorder also writes a
+// StateKeyframe event - PluginData's race state (PluginData::writeKeyframe) as it
+// stands just before a RaceClassification callback is applied - so a replay can
+// start mid-session from the nearest keyframe instead of from Startup (see
+// tape_io.h and PluginHost::replayTapeFrom). Not a game callback: replaying from
+// the start skips them.
 // ============================================================================
 #pragma once
 
@@ -27,9 +52,14 @@
 
 #if GAME_HAS_RECORDER
 
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <thread>
+#include <vector>
+
+#include "tape_io.h"
 
 // Binary file format for recordings
 namespace Recording {
@@ -39,7 +69,7 @@ namespace Recording {
     // contract; keep it identical to tape.h's FileHeader.
     struct FileHeader {
         char magic[8];           // "MXBHREC\0"
-        uint32_t version;        // Format version (1)
+        uint32_t version;        // Format version (2: tape_io blocks; readers also take 1)
         uint32_t numEvents;      // Total number of events (updated on close)
         uint64_t startTimeUs;    // Recording start time (microseconds)
         uint64_t endTimeUs;      // Recording end time (updated on close)
@@ -54,9 +84,10 @@ namespace Recording {
             // nondeterministic. Legal: trivially-copyable, no members initialized yet.
             memset(this, 0, sizeof(*this));
             memcpy(magic, "MXBHREC\0", 8);
-            version = 1;
+            version = tape_io::VERSION_BLOCKS;
         }
     };
+    static_assert(sizeof(FileHeader) == tape_io::FILE_HEADER_BYTES, "FileHeader layout changed");
 
     // Event types that can be recorded
     enum class EventType : uint32_t {
@@ -88,6 +119,7 @@ namespace Recording {
         RaceTrackPosition = 25,
         RaceCommunication = 26,
         RaceVehicleData = 27,
+        StateKeyframe = 28,      // not a callback: PluginData::writeKeyframe (tape_io::KEYFRAME_EVENT)
     };
 
     // Event entry header (16 bytes)
@@ -106,9 +138,34 @@ class EventRecorder {
 public:
     static EventRecorder& getInstance();
 
+    // Size of each of the two in-memory tape buffers. A full race records well
+    // under 1 MB/s, so a buffer normally hands over on the time bound, not on size.
+    static constexpr size_t BUFFER_BYTES = 4 * 1024 * 1024;
+    // Longest an event may sit in memory before its buffer is handed to the writer.
+    static constexpr uint64_t FLUSH_INTERVAL_US = 500000;
+
+    // Game-thread cost of recording, since the last startRecording (readable after
+    // stop). Covers the whole append: timestamp, framing, payload copy and handoff.
+    struct Stats {
+        uint64_t events = 0;
+        double avgEventNs = 0.0;       // mean game-thread time per recorded event
+        double maxEventUs = 0.0;       // worst single event
+        uint64_t buffersWritten = 0;   // handoffs to the writer thread
+        uint64_t bytesWritten = 0;     // event bytes handed to the writer (uncompressed)
+        uint64_t fileBytes = 0;        // tape file size so far (header + deflated blocks)
+        uint64_t bufferGrows = 0;      // a full buffer found the writer still busy
+    };
+    Stats getStats() const;
+
     // Config (set from the [Recorder] INI section at load). Defaults off.
     void setRecordingEnabled(bool enabled) { m_configEnabled = enabled; }
     bool isRecordingEnabled() const { return m_configEnabled; }
+    // Seconds between state keyframes; 0 records none. A keyframe carries the
+    // session's lap logs and leader timing points (~28 KB for a 24-rider race) and
+    // is serialized on the game thread, so this stays coarse.
+    static constexpr int DEFAULT_KEYFRAME_SECONDS = 60;
+    void setKeyframeSeconds(int seconds) { m_keyframeSeconds = seconds > 0 ? seconds : 0; }
+    int getKeyframeSeconds() const { return m_keyframeSeconds; }
 
     // Open a fresh session tape under <savePath>/mxbmrp3/tapes/session_*.tape and
     // record the Startup event. No-op if recording is not enabled or already
@@ -159,16 +216,53 @@ private:
 
     void writeHeader();
     void updateHeader();
-    void writeEvent(Recording::EventType type, const void* data, size_t size);
+    // Append one framed event: [EventHeader][data][extra]. extra lets compound
+    // payloads (prefix + array) go straight into the buffer without packing them
+    // into a temporary first.
+    void writeEvent(Recording::EventType type, const void* data, size_t size,
+                    const void* extra = nullptr, size_t extraSize = 0);
+    void recordStateKeyframe();          // game thread: a StateKeyframe when one is due
+    void handOff();                      // game thread: pass the active buffer to the writer
+    bool writeBuffer(int index);         // block-encode + checkpoint + clear; false on I/O failure
+    void writerThreadMain();
+    void stopWriter();                   // join the writer after it drains its handoff
+    void finishRecording(bool canJoin);  // flush, finalize the header, close
     void handleWriteFailure();
     uint64_t getCurrentTimeUs() const;
 
     FILE* m_file;
     bool m_recording;
     bool m_configEnabled;      // [Recorder] enabled; opt-in, default off
+    int m_keyframeSeconds = DEFAULT_KEYFRAME_SECONDS;   // [Recorder] keyframeSeconds
+    uint64_t m_lastKeyframeUs = 0;       // time of the last keyframe (0: none yet)
+    std::vector<uint8_t> m_keyframe;     // serialization scratch, reused
     uint64_t m_startTimeUs;
     uint32_t m_eventCount;
     long long m_performanceFrequency;
+
+    // Double buffer. m_active and m_activeSinceUs belong to the game thread; the
+    // other buffer belongs to whoever m_handoff says: HANDOFF_FREE (game thread),
+    // its index (handed over, not yet claimed) or its index + WRITING (the writer
+    // thread is fwriting it).
+    static constexpr int HANDOFF_FREE = -1;
+    static constexpr int WRITING = 2;
+    std::vector<uint8_t> m_buffers[2];
+    int m_active = 0;
+    uint64_t m_activeSinceUs = 0;
+    std::atomic<int> m_handoff{ HANDOFF_FREE };
+    std::atomic<bool> m_writerRun{ false };
+    std::atomic<bool> m_writeFailed{ false };
+    std::thread m_writer;
+    tape_io::BlockWriter m_blocks;       // whoever holds a buffer in WRITING state
+
+    // Stats (game thread, except m_bytesWritten / m_fileBytes which the writer updates).
+    uint64_t m_statEvents = 0;
+    long long m_statTicks = 0;
+    long long m_statMaxTicks = 0;
+    uint64_t m_statHandoffs = 0;
+    uint64_t m_statGrows = 0;
+    std::atomic<uint64_t> m_bytesWritten{ 0 };
+    std::atomic<uint64_t> m_fileBytes{ 0 };
 };
 
 #endif  // GAME_HAS_RECORDER
@@ -0,0 +1,78 @@
+// ============================================================================
+// core/file_mapping.h
+// Read-only memory mapping of a whole file: MapViewOfFile on Windows, mmap
+// elsewhere. The mapped tape reader (core/tape_map.h) and the track geometry
+// cache (core/track_geometry_cache.cpp) read their files through it.
+// Header-only and needs nothing beyond the OS mapping call, so the native tools
+// and tests share it.
+// ============================================================================
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only mapping of a whole file. Shares the file for reading and writing, so
+// a tape the recorder still has open can be inspected.
+class FileMapping {
+public:
+    FileMapping() = default;
+    ~FileMapping() { close(); }
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    bool open(const char* path) {
+        close();
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) { CloseHandle(file); return false; }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);                      // the mapping keeps the file open
+        if (!mapping) return false;
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);                   // the view keeps the mapping alive
+        if (!view) return false;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);                            // the mapping keeps the file open
+        if (view == MAP_FAILED) return false;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    void close() {
+        if (!m_data) return;
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
@@ -21,6 +21,10 @@ int FontConfig::getFont(FontCategory category) const {
         return 1;  // Fallback to first font
     }
 
+    if (m_resolvedFonts[index] != 0) {
+        return m_resolvedFonts[index];
+    }
+
     const std::string& fontName = m_fontNames[index];
     int fontIndex = AssetManager::getInstance().getFontIndexByName(fontName);
 
@@ -36,6 +40,7 @@ int FontConfig::getFont(FontCategory category) const {
         }
     }
 
+    m_resolvedFonts[index] = fontIndex;
     return fontIndex;
 }
 
@@ -70,6 +75,7 @@ void FontConfig::setFont(FontCategory category, const std::string& fontName) {
     }
 
     m_fontNames[index] = fontName;
+    m_resolvedFonts[index] = 0;
     DEBUG_INFO_F("FontConfig: %s set to %s", getCategoryName(category), fontName.c_str());
 }
 
@@ -112,6 +118,7 @@ void FontConfig::cycleFont(FontCategory category, bool forward) {
     }
 
     m_fontNames[categoryIndex] = fonts[newIndex].filename;
+    m_resolvedFonts[categoryIndex] = 0;
 
     DEBUG_INFO_F("FontConfig: %s cycled to %s (%s)",
         getCategoryName(category),
@@ -126,6 +133,7 @@ void FontConfig::resetToDefaults() {
     m_fontNames[static_cast<size_t>(FontCategory::DIGITS)] = getDefaultFontName(FontCategory::DIGITS);
     m_fontNames[static_cast<size_t>(FontCategory::MARKER)] = getDefaultFontName(FontCategory::MARKER);
     m_fontNames[static_cast<size_t>(FontCategory::SMALL)] = getDefaultFontName(FontCategory::SMALL);
+    m_resolvedFonts.fill(0);
 
     DEBUG_INFO("FontConfig: Reset to defaults");
 }
@@ -156,4 +164,5 @@ const char* FontConfig::getDefaultFontName(FontCategory category) {
 
 void FontConfig::setFontNames(const std::array<std::string, static_cast<size_t>(FontCategory::COUNT)>& names) {
     m_fontNames = names;
+    m_resolvedFonts.fill(0);
 }
@@ -59,4 +59,9 @@ private:
 
     // Stores the font filename (without extension) for each category
     std::array<std::string, static_cast<size_t>(FontCategory::COUNT)> m_fontNames;
+
+    // Resolved engine font index per category (0 = not resolved yet). getFont() runs
+    // for every string every HUD builds, so the name lookup (and the missing-font
+    // fallback with its warning) happens once per name change, not per call.
+    mutable std::array<int, static_cast<size_t>(FontCategory::COUNT)> m_resolvedFonts{};
 };
@@ -0,0 +1,242 @@
+// ============================================================================
+// core/frame_export.cpp  — see frame_export.h
+// ============================================================================
+#include "frame_export.h"
+
+#include "hud_sw_renderer.h"
+#include "../diagnostics/logger.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace {
+// Same reduction as CompanionWindow: ".../fonts/RobotoMono-Regular.fnt" -> "RobotoMono-Regular".
+std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string n = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = n.find_last_of('.');
+    if (dot != std::string::npos) n.resize(dot);
+    return n;
+}
+
+int64_t steadyNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+#if defined(_WIN32)
+// The ABI publishes the game's Win64 structs verbatim — pin them to its sizes.
+static_assert(sizeof(SPluginQuad_t) == frame_export::QUAD_BYTES, "SPluginQuad_t layout drifted from the frame export ABI");
+static_assert(sizeof(SPluginString_t) == frame_export::STRING_BYTES, "SPluginString_t layout drifted from the frame export ABI");
+#endif
+
+FrameExport& FrameExport::getInstance() {
+    static FrameExport instance;
+    return instance;
+}
+
+FrameExport::~FrameExport() {
+    // Static-teardown backstop (Shutdown() skipped): same loader-lock reasoning as
+    // ~CompanionWindow — don't join; signal and detach. The mapping handle is
+    // reclaimed by the OS with the process.
+    m_run.store(false);
+    if (m_thread.joinable()) m_thread.detach();
+}
+
+void FrameExport::reconcile(Mode mode, int imageWidth) {
+    imageWidth = std::max(MIN_IMAGE_WIDTH, std::min(MAX_IMAGE_WIDTH, imageWidth));
+    if (mode == m_mode && (mode != Mode::IMAGE || imageWidth == m_imageWidth)) return;
+
+    stop();
+    if (mode == Mode::PRIMITIVES) {
+        if (openMapping(frame_export::FORMAT_PRIMITIVES,
+                        frame_export::primitiveSlotBytes(QUAD_CAPACITY, STRING_CAPACITY),
+                        0, 0, QUAD_CAPACITY, STRING_CAPACITY)) {
+            m_mode = mode;
+        }
+    } else if (mode == Mode::IMAGE) {
+        const uint32_t w = static_cast<uint32_t>(imageWidth);
+        const uint32_t h = w * 9 / 16;
+        if (openMapping(frame_export::FORMAT_RGBA, frame_export::rgbaSlotBytes(w, h), w, h, 0, 0)) {
+            m_mode = mode;
+            m_imageWidth = imageWidth;
+            m_run.store(true);
+            m_thread = std::thread([this] {
+                try { imageThreadMain(); }
+                catch (...) { DEBUG_WARN("FrameExport: image thread terminated by exception"); }
+            });
+        }
+    }
+    // A failed open leaves m_mode OFF; the next reconcile retries only when the
+    // requested mode changes again, so a denied mapping doesn't retry every frame.
+    if (m_mode != mode) m_mode = Mode::OFF;
+}
+
+void FrameExport::stop() {
+    m_run.store(false);
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+        m_thread.join();
+    closeMapping();
+    m_mode = Mode::OFF;
+    m_imageWidth = 0;
+}
+
+void FrameExport::publish(const std::vector<SPluginQuad_t>& quads,
+                          const std::vector<SPluginString_t>& strings) {
+    if (!m_header) return;
+    if (m_mode == Mode::PRIMITIVES) {
+        writePrimitives(quads, strings);
+    } else if (m_mode == Mode::IMAGE) {
+        // Hand over and return: the image thread rasterizes on its own time.
+        m_frames.writeSlot().assign(quads, strings);
+        m_frames.publish();
+        m_submitted.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void FrameExport::writePrimitives(const std::vector<SPluginQuad_t>& quads,
+                                  const std::vector<SPluginString_t>& strings) {
+    const uint32_t nq = static_cast<uint32_t>(std::min<size_t>(quads.size(), QUAD_CAPACITY));
+    const uint32_t ns = static_cast<uint32_t>(std::min<size_t>(strings.size(), STRING_CAPACITY));
+    uint64_t n = 0;
+    frame_export::SlotHeader* slot = frame_export::beginFrame(m_header, n);
+    uint8_t* dst = frame_export::payloadOf(slot);
+    if (nq) std::memcpy(dst, quads.data(), nq * sizeof(SPluginQuad_t));
+    if (ns) std::memcpy(dst + nq * sizeof(SPluginQuad_t), strings.data(), ns * sizeof(SPluginString_t));
+    slot->timestampUs = steadyNowUs();
+    slot->quadCount = nq;
+    slot->stringCount = ns;
+    slot->payloadBytes = static_cast<uint32_t>(nq * sizeof(SPluginQuad_t) + ns * sizeof(SPluginString_t));
+    slot->flags = (nq < quads.size() || ns < strings.size()) ? frame_export::SLOT_TRUNCATED : 0u;
+    frame_export::commitFrame(m_header, slot, n);
+    m_published.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameExport::setResources(const std::vector<std::string>& fontPaths,
+                               const std::vector<std::string>& spritePaths,
+                               int firstIcon) {
+    std::vector<std::string> fonts, sprites;
+    fonts.reserve(fontPaths.size());
+    sprites.reserve(spritePaths.size());
+    for (const auto& p : fontPaths) fonts.push_back(baseName(p));
+    for (const auto& p : spritePaths) sprites.push_back(baseName(p));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fontBases = std::move(fonts);
+    m_spriteBases = std::move(sprites);
+    m_firstIcon = firstIcon;
+    m_resourceGen.fetch_add(1, std::memory_order_release);
+}
+
+void FrameExport::imageThreadMain() {
+    DEBUG_INFO_F("FrameExport: image thread started (%ux%u)", m_header->width, m_header->height);
+    hudsw::Renderer renderer;
+    hudsw::Image img;
+    img.resize(static_cast<int>(m_header->width), static_cast<int>(m_header->height));
+
+    std::vector<std::string> fontBases, spriteBases;
+    int firstIcon = 1 << 30;
+    unsigned seenGen = 0;
+    uint64_t rendered = 0;
+
+    while (m_run.load(std::memory_order_relaxed)) {
+        const uint64_t submitted = m_submitted.load(std::memory_order_acquire);
+        if (submitted == rendered) {
+            // Nothing new. A short sleep, not a condition variable: the producer must
+            // never pay for a notify, and 1 ms is far below any frame interval.
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        rendered = submitted;
+
+        unsigned gen = m_resourceGen.load(std::memory_order_acquire);
+        if (gen != seenGen) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            fontBases = m_fontBases; spriteBases = m_spriteBases; firstIcon = m_firstIcon;
+            seenGen = gen;
+        }
+
+        const Frame& frame = m_frames.acquire();
+        hudsw::Frame f;
+        f.quads = frame.quads.data(); f.quadCount = static_cast<int>(frame.quads.size());
+        f.strings = frame.strings.data(); f.stringCount = static_cast<int>(frame.strings.size());
+        f.fontNames = &fontBases; f.spriteNames = &spriteBases;
+        f.firstIcon = firstIcon; f.assetRoot = "plugins/mxbmrp3_data";
+        // Same opaque backdrop as the companion window. A consumer that composites the
+        // HUD over its own scene keys it out, or reads PRIMITIVES and draws them itself.
+        renderer.render(img, f, 12, 15, 20);
+
+        uint64_t n = 0;
+        frame_export::SlotHeader* slot = frame_export::beginFrame(m_header, n);
+        std::memcpy(frame_export::payloadOf(slot), img.px.data(), img.px.size());
+        slot->timestampUs = steadyNowUs();
+        slot->quadCount = static_cast<uint32_t>(frame.quads.size());
+        slot->stringCount = static_cast<uint32_t>(frame.strings.size());
+        slot->payloadBytes = static_cast<uint32_t>(img.px.size());
+        slot->flags = 0;
+        frame_export::commitFrame(m_header, slot, n);
+        m_published.fetch_add(1, std::memory_order_relaxed);
+    }
+    DEBUG_INFO("FrameExport: image thread stopped");
+}
+
+#if defined(_WIN32)
+bool FrameExport::openMapping(frame_export::Format format, uint32_t slotBytes,
+                              uint32_t width, uint32_t height, uint32_t quadCap, uint32_t stringCap) {
+    const size_t bytes = frame_export::mappingBytes(SLOT_COUNT, slotBytes);
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32),
+                                  static_cast<DWORD>(bytes & 0xFFFFFFFFu), frame_export::MAPPING_NAME);
+    if (!h) {
+        DEBUG_WARN_F("FrameExport: CreateFileMapping failed (%lu)", GetLastError());
+        return false;
+    }
+    // A mapping that already exists (a second game instance, or a reader that opened
+    // a stale one) keeps its original size; refuse rather than overrun it.
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        MEMORY_BASIC_INFORMATION mbi{};
+        void* probe = MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0);
+        bool fits = probe && VirtualQuery(probe, &mbi, sizeof(mbi)) && mbi.RegionSize >= bytes;
+        if (probe) UnmapViewOfFile(probe);
+        if (!fits) {
+            DEBUG_WARN("FrameExport: existing mapping is too small - export disabled");
+            CloseHandle(h);
+            return false;
+        }
+    }
+    void* view = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!view) {
+        DEBUG_WARN_F("FrameExport: MapViewOfFile failed (%lu)", GetLastError());
+        CloseHandle(h);
+        return false;
+    }
+    frame_export::initHeader(view, format, SLOT_COUNT, slotBytes, width, height, quadCap, stringCap,
+                             static_cast<uint32_t>(GetCurrentProcessId()));
+    m_mapping = h;
+    m_header = static_cast<frame_export::ShmHeader*>(view);
+    m_published.store(0, std::memory_order_relaxed);
+    m_submitted.store(0, std::memory_order_relaxed);
+    DEBUG_INFO_F("FrameExport: publishing %s to %s (%u slots x %u bytes)",
+                 format == frame_export::FORMAT_RGBA ? "RGBA" : "primitives",
+                 frame_export::MAPPING_NAME, SLOT_COUNT, slotBytes);
+    return true;
+}
+
+void FrameExport::closeMapping() {
+    if (m_header) UnmapViewOfFile(m_header);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    m_header = nullptr;
+    m_mapping = nullptr;
+}
+
+#else  // non-Windows: the plugin is Windows-only, so this is just a link stub.
+bool FrameExport::openMapping(frame_export::Format, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t) {
+    return false;
+}
+void FrameExport::closeMapping() {}
+#endif
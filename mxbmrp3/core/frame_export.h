@@ -0,0 +1,106 @@
+// ============================================================================
+// core/frame_export.h
+// Opt-in shared-memory export of the HUD frame for EXTERNAL processes (an OBS
+// source, a timing-wall app) — the out-of-process sibling of the companion window,
+// without going through the web overlay. Publishes into a named file mapping
+// laid out by core/frame_export_abi.h (the reader contract), in one of two forms:
+//   PRIMITIVES — the frame's SPluginQuad_t / SPluginString_t arrays, copied
+//                straight into the next slot on the producing thread (a memcpy);
+//   IMAGE      — the HUD rasterized by core/hud_sw_renderer into an RGBA8 image,
+//                on the export's OWN thread, so the producer only hands the frame
+//                over through a RenderFrameBuffer (same pattern as the companion).
+// Readers never block the writer: every slot is a seqlock (see the ABI header).
+//
+// INI-only, off by default: [Advanced] frameExport=0|1|2 (off / primitives /
+// image) and frameExportWidth (image width; height is 16:9). HudManager calls
+// reconcile() each frame, so a RELOAD_CONFIG switches modes live.
+// ============================================================================
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../game/game_config.h"   // SPluginQuad_t / SPluginString_t
+#include "frame_export_abi.h"
+#include "render_frame_buffer.h"
+
+class FrameExport {
+public:
+    static FrameExport& getInstance();
+
+    enum class Mode : int { OFF = 0, PRIMITIVES = 1, IMAGE = 2 };
+
+    // Per-slot primitive capacity (PRIMITIVES). A frame past it is published
+    // truncated with SLOT_TRUNCATED set rather than dropped.
+    static constexpr uint32_t QUAD_CAPACITY = 16384;
+    static constexpr uint32_t STRING_CAPACITY = 4096;
+    static constexpr uint32_t SLOT_COUNT = 4;
+    static constexpr int MIN_IMAGE_WIDTH = 320;
+    static constexpr int MAX_IMAGE_WIDTH = 3840;
+
+    // Producer thread (the one running HudManager::produceFrame): bring the mapping
+    // in line with the requested mode/width — create, resize or close it. Cheap when
+    // nothing changed (two compares).
+    void reconcile(Mode mode, int imageWidth);
+
+    // Producer thread: publish this frame. No-op when OFF.
+    void publish(const std::vector<SPluginQuad_t>& quads,
+                 const std::vector<SPluginString_t>& strings);
+
+    // Registration tables for IMAGE mode (see CompanionWindow::setResources).
+    void setResources(const std::vector<std::string>& fontPaths,
+                      const std::vector<std::string>& spritePaths,
+                      int firstIcon);
+
+    // Close the mapping and join the image thread. Safe from any thread but the
+    // image thread itself; called at shutdown.
+    void stop();
+
+    Mode getMode() const { return m_mode; }
+    // Frames written into the mapping since it was (re)created.
+    uint64_t getPublishedFrames() const { return m_published.load(std::memory_order_relaxed); }
+
+    struct Frame {
+        std::vector<SPluginQuad_t> quads;
+        std::vector<SPluginString_t> strings;
+        void assign(const std::vector<SPluginQuad_t>& q, const std::vector<SPluginString_t>& s) {
+            quads.assign(q.begin(), q.end());
+            strings.assign(s.begin(), s.end());
+        }
+    };
+
+private:
+    FrameExport() = default;
+    ~FrameExport();
+    FrameExport(const FrameExport&) = delete;
+    FrameExport& operator=(const FrameExport&) = delete;
+
+    bool openMapping(frame_export::Format format, uint32_t slotBytes,
+                     uint32_t width, uint32_t height, uint32_t quadCap, uint32_t stringCap);
+    void closeMapping();
+    void writePrimitives(const std::vector<SPluginQuad_t>& quads,
+                         const std::vector<SPluginString_t>& strings);
+    void imageThreadMain();
+
+    // Producer-thread state (reconcile/publish/stop run on the producer).
+    Mode m_mode = Mode::OFF;
+    int m_imageWidth = 0;
+    void* m_mapping = nullptr;    // HANDLE (opaque: keeps this header windows.h-free)
+    frame_export::ShmHeader* m_header = nullptr;
+    std::atomic<uint64_t> m_published{ 0 };
+
+    // IMAGE mode: producer -> image thread handoff, as in CompanionWindow.
+    RenderFrameBuffer<Frame> m_frames;
+    std::atomic<uint64_t> m_submitted{ 0 };
+    std::atomic<bool> m_run{ false };
+    std::thread m_thread;
+
+    std::mutex m_mutex;           // guards the registration tables below
+    std::vector<std::string> m_fontBases;
+    std::vector<std::string> m_spriteBases;
+    int m_firstIcon = 1 << 30;
+    std::atomic<unsigned> m_resourceGen{ 1 };
+};
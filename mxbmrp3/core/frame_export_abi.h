@@ -0,0 +1,170 @@
+// ============================================================================
+// core/frame_export_abi.h
+// The shared-memory layout + seqlock protocol of the opt-in frame export (see
+// core/frame_export.{h,cpp}). This header IS the contract with external readers
+// (an OBS source, a timing-wall app, tools/mxbmrp3_frame_reader): it depends on
+// nothing but the standard library, so a reader can include it as-is.
+//
+// The plugin publishes each HUD frame into a named file mapping
+// ("Local\mxbmrp3_frames"): one ShmHeader followed by `slotCount` fixed-size slots,
+// written round-robin. Each slot is a SlotHeader + payload:
+//   FORMAT_PRIMITIVES: quadCount x SPluginQuad_t (40 B) then stringCount x
+//                      SPluginString_t (124 B), the game's Win64 layouts verbatim.
+//   FORMAT_RGBA:       width x height x 4 bytes, RGBA8, row-major, top-down —
+//                      the HUD rendered by core/hud_sw_renderer.
+//
+// Consistency is a per-slot seqlock, so a reader can NEVER block the writer:
+//   writer, frame n (1-based) into slot (n-1) % slotCount:
+//       seq = 2n-1 (odd: in progress) ... write payload ... seq = 2n; latest = n
+//   reader: n = latest; s1 = seq (acquire); s1 != 2n -> lapped, retry with the new
+//       latest; copy the payload; acquire fence; s2 = seq; s2 != s1 -> torn, retry.
+// A slow reader just misses frames (it is lapped); it never sees a mixed frame.
+// The helpers below implement both sides over a raw mapped block, portably, so
+// the protocol is unit-tested natively (tests/unit/test_frame_export_abi.cpp).
+// ============================================================================
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace frame_export {
+
+constexpr uint32_t VERSION = 1;
+constexpr const char MAPPING_NAME[] = "Local\\mxbmrp3_frames";
+
+enum Format : uint32_t {
+    FORMAT_PRIMITIVES = 1,
+    FORMAT_RGBA = 2
+};
+
+// Win64 sizes of the PiBoSo primitives (unsigned long is 32-bit there). The plugin
+// static_asserts its own structs against these.
+constexpr uint32_t QUAD_BYTES = 40;
+constexpr uint32_t STRING_BYTES = 124;
+
+// SlotHeader::flags
+constexpr uint32_t SLOT_TRUNCATED = 1u << 0;   // more primitives than the slot holds; tail dropped
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the seqlock lives in shared memory: it must be a plain lock-free word");
+
+struct alignas(64) ShmHeader {
+    char     magic[8];            // "MXBHSHM\0"
+    uint32_t version;             // VERSION
+    uint32_t headerBytes;         // sizeof(ShmHeader): slot 0 starts here
+    uint32_t slotCount;
+    uint32_t slotBytes;           // slot stride, SlotHeader included
+    uint32_t format;              // Format
+    uint32_t width, height;       // FORMAT_RGBA image size (0 for primitives)
+    uint32_t quadCapacity;        // FORMAT_PRIMITIVES per-slot limits (0 for RGBA)
+    uint32_t stringCapacity;
+    uint32_t writerPid;
+    std::atomic<uint64_t> latest; // newest COMPLETE frame number; 0 = none yet
+};
+
+struct alignas(64) SlotHeader {
+    std::atomic<uint64_t> seq;    // 2n-1 while frame n is written, 2n once complete
+    uint64_t frame;               // n
+    int64_t  timestampUs;         // writer's steady clock at publish
+    uint32_t quadCount;           // FORMAT_PRIMITIVES
+    uint32_t stringCount;
+    uint32_t payloadBytes;
+    uint32_t flags;               // SLOT_*
+};
+
+inline size_t mappingBytes(uint32_t slotCount, uint32_t slotBytes) {
+    return sizeof(ShmHeader) + static_cast<size_t>(slotCount) * slotBytes;
+}
+inline uint32_t primitiveSlotBytes(uint32_t quadCap, uint32_t stringCap) {
+    return static_cast<uint32_t>(sizeof(SlotHeader)) + quadCap * QUAD_BYTES + stringCap * STRING_BYTES;
+}
+inline uint32_t rgbaSlotBytes(uint32_t w, uint32_t h) {
+    return static_cast<uint32_t>(sizeof(SlotHeader)) + w * h * 4u;
+}
+
+inline SlotHeader* slotAt(ShmHeader* h, uint64_t frame) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(h) + h->headerBytes;
+    return reinterpret_cast<SlotHeader*>(base + static_cast<size_t>((frame - 1) % h->slotCount) * h->slotBytes);
+}
+inline const SlotHeader* slotAt(const ShmHeader* h, uint64_t frame) {
+    return slotAt(const_cast<ShmHeader*>(h), frame);
+}
+inline uint8_t* payloadOf(SlotHeader* s) { return reinterpret_cast<uint8_t*>(s + 1); }
+inline const uint8_t* payloadOf(const SlotHeader* s) { return reinterpret_cast<const uint8_t*>(s + 1); }
+
+// Writer side. Lay out a fresh header over `mem` (at least mappingBytes()).
+inline void initHeader(void* mem, Format format, uint32_t slotCount, uint32_t slotBytes,
+                       uint32_t width, uint32_t height, uint32_t quadCap, uint32_t stringCap,
+                       uint32_t writerPid) {
+    std::memset(mem, 0, mappingBytes(slotCount, slotBytes));
+    ShmHeader* h = new (mem) ShmHeader();
+    std::memcpy(h->magic, "MXBHSHM", 8);
+    h->version = VERSION;
+    h->headerBytes = static_cast<uint32_t>(sizeof(ShmHeader));
+    h->slotCount = slotCount;
+    h->slotBytes = slotBytes;
+    h->format = format;
+    h->width = width; h->height = height;
+    h->quadCapacity = quadCap; h->stringCapacity = stringCap;
+    h->writerPid = writerPid;
+    h->latest.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < slotCount; ++i) new (slotAt(h, i + 1)) SlotHeader();
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+// Writer side: open frame n (= latest + 1) for writing. Fill payloadOf() and the
+// counts, then commitFrame(). Single writer only.
+inline SlotHeader* beginFrame(ShmHeader* h, uint64_t& frameOut) {
+    const uint64_t n = h->latest.load(std::memory_order_relaxed) + 1;
+    SlotHeader* s = slotAt(h, n);
+    s->seq.store(2 * n - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);   // odd seq visible before any payload byte
+    s->frame = n;
+    frameOut = n;
+    return s;
+}
+inline void commitFrame(ShmHeader* h, SlotHeader* s, uint64_t n) {
+    s->seq.store(2 * n, std::memory_order_release);
+    h->latest.store(n, std::memory_order_release);
+}
+
+enum class ReadResult { Ok, NoNewFrame, Lapped };
+
+// Reader side: copy the newest complete frame newer than `after` into meta +
+// `dst` (capacity dstCap; must hold slotBytes - sizeof(SlotHeader)). Retries a
+// lapped/torn slot a bounded number of times, then reports Lapped so a reader on a
+// starved core can't spin forever. Never writes to shared memory.
+inline ReadResult readLatest(const ShmHeader* h, uint64_t after, SlotHeader& meta,
+                             uint8_t* dst, size_t dstCap, int maxRetries = 8) {
+    for (int attempt = 0; attempt <= maxRetries; ++attempt) {
+        const uint64_t n = h->latest.load(std::memory_order_acquire);
+        if (n == 0 || n <= after) return ReadResult::NoNewFrame;
+        const SlotHeader* s = slotAt(h, n);
+        const uint64_t s1 = s->seq.load(std::memory_order_acquire);
+        if (s1 != 2 * n) continue;                       // already being overwritten
+        meta.frame = s->frame;
+        meta.timestampUs = s->timestampUs;
+        meta.quadCount = s->quadCount;
+        meta.stringCount = s->stringCount;
+        meta.payloadBytes = s->payloadBytes;
+        meta.flags = s->flags;
+        if (meta.payloadBytes > dstCap) continue;         // only possible mid-overwrite
+        std::memcpy(dst, payloadOf(s), meta.payloadBytes);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s->seq.load(std::memory_order_relaxed) != s1) continue;   // torn: lapped during the copy
+        meta.seq.store(s1, std::memory_order_relaxed);
+        return ReadResult::Ok;
+    }
+    return ReadResult::Lapped;
+}
+
+// Reader side: sanity-check a mapped header before trusting its geometry.
+inline bool headerValid(const ShmHeader* h, size_t mappedBytes) {
+    return mappedBytes >= sizeof(ShmHeader) && std::memcmp(h->magic, "MXBHSHM", 8) == 0 &&
+           h->version == VERSION && h->headerBytes == sizeof(ShmHeader) && h->slotCount > 0 &&
+           h->slotBytes > sizeof(SlotHeader) && mappingBytes(h->slotCount, h->slotBytes) <= mappedBytes;
+}
+
+}  // namespace frame_export
@@ -0,0 +1,198 @@
+// ============================================================================
+// core/history_ring.h
+// Fixed-memory history for the scrolling strip charts (Telemetry and Rumble
+// HUDs, stick trails).
+//
+// HistoryRing<T, Capacity> is a power-of-two ring over a std::array: push() is a
+// store and a masked increment, never an allocation, and the oldest sample is
+// overwritten once `window` samples are held (window <= Capacity, so a 200-sample
+// graph lives in a 256 ring). view() exposes the window oldest-first as at most
+// two contiguous spans — the tail of the array, then its head — so a graph walks
+// the samples in place without copying them out.
+//
+// SampleHistory adds min/max mip levels to a float channel: level k holds the
+// min and max of every aligned block of 2^k samples, updated on push (one
+// compare per level). A graph narrower than its sample count reads the level
+// whose blocks fit its pixel columns (levelFor()) and gets one min/max column
+// per pixel; minMax() is the exact running min/max of the window in O(log N).
+//
+// Header-only and Win32-free so tests/unit can pin the ring and mip math.
+// ============================================================================
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// A ring's window, oldest sample first: `first` then `second` (empty unless the
+// window wraps the end of the array).
+template <typename T>
+struct HistoryView {
+    const T* first = nullptr;
+    size_t firstSize = 0;
+    const T* second = nullptr;
+    size_t secondSize = 0;
+
+    size_t size() const { return firstSize + secondSize; }
+    bool empty() const { return size() == 0; }
+    const T& operator[](size_t i) const { return i < firstSize ? first[i] : second[i - firstSize]; }
+    const T& back() const { return secondSize ? second[secondSize - 1] : first[firstSize - 1]; }
+};
+
+template <typename T, size_t Capacity>
+class HistoryRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "HistoryRing capacity must be a power of two");
+
+public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    explicit HistoryRing(size_t window = Capacity) : m_window(std::min(std::max<size_t>(window, 1), Capacity)) {}
+
+    void push(const T& value) {
+        m_data[static_cast<size_t>(m_pushed) & MASK] = value;
+        ++m_pushed;
+        if (m_size < m_window) ++m_size;
+    }
+
+    void clear() {
+        m_pushed = 0;
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t window() const { return m_window; }
+    // Samples pushed since the last clear(); the absolute index of the next one.
+    uint64_t pushed() const { return m_pushed; }
+
+    const T& back() const { return m_data[static_cast<size_t>(m_pushed - 1) & MASK]; }
+    // i = 0 is the oldest sample in the window.
+    const T& operator[](size_t i) const { return m_data[static_cast<size_t>(m_pushed - m_size + i) & MASK]; }
+
+    HistoryView<T> view() const {
+        HistoryView<T> v;
+        const size_t start = static_cast<size_t>(m_pushed - m_size) & MASK;
+        v.first = m_data.data() + start;
+        v.firstSize = std::min(m_size, Capacity - start);
+        v.second = m_data.data();
+        v.secondSize = m_size - v.firstSize;
+        return v;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    std::array<T, Capacity> m_data{};
+    uint64_t m_pushed = 0;
+    size_t m_size = 0;
+    size_t m_window;
+};
+
+class SampleHistory {
+public:
+    static constexpr size_t CAPACITY = 256;
+    static constexpr int LEVELS = 8;   // log2(CAPACITY): the top level is one block per ring
+    static_assert((size_t(1) << LEVELS) == CAPACITY, "LEVELS must match CAPACITY");
+
+    // One pixel column of a graph: the min and max of the samples it covers and
+    // the window index of the newest of them (where the column sits on the x axis).
+    // At level 0 a column is one sample (lo == hi). A level-k column is an aligned
+    // block, so the oldest one may also cover a few samples just before the window.
+    struct Column {
+        float lo;
+        float hi;
+        size_t last;
+    };
+
+    explicit SampleHistory(size_t window = CAPACITY) : m_ring(window) {}
+
+    void push(float value) {
+        const uint64_t t = m_ring.pushed();
+        m_ring.push(value);
+        for (int k = 1; k <= LEVELS; ++k) {
+            const size_t slot = levelOffset(k) + (static_cast<size_t>(t >> k) & (levelSize(k) - 1));
+            if ((t & ((uint64_t(1) << k) - 1)) == 0) {
+                m_lo[slot] = value;   // first sample of a new block
+                m_hi[slot] = value;
+            } else {
+                m_lo[slot] = std::min(m_lo[slot], value);
+                m_hi[slot] = std::max(m_hi[slot], value);
+            }
+        }
+    }
+
+    void clear() { m_ring.clear(); }
+
+    size_t size() const { return m_ring.size(); }
+    bool empty() const { return m_ring.empty(); }
+    size_t window() const { return m_ring.window(); }
+    float back() const { return m_ring.back(); }
+    float operator[](size_t i) const { return m_ring[i]; }
+    HistoryView<float> view() const { return m_ring.view(); }
+
+    // Exact min/max over the window; {0, 0} when empty.
+    void minMax(float& lo, float& hi) const {
+        lo = hi = 0.0f;
+        if (empty()) return;
+        const uint64_t end = m_ring.pushed();
+        uint64_t i = end - size();
+        lo = hi = m_ring[0];
+        while (i < end) {
+            // Widest stored block that starts at i and ends inside the window.
+            int k = 0;
+            while (k < LEVELS && (i & ((uint64_t(2) << k) - 1)) == 0 && i + (uint64_t(2) << k) <= end) ++k;
+            if (k == 0) {
+                const float v = m_ring[static_cast<size_t>(i - (end - size()))];
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+            } else {
+                const size_t slot = levelOffset(k) + (static_cast<size_t>(i >> k) & (levelSize(k) - 1));
+                lo = std::min(lo, m_lo[slot]);
+                hi = std::max(hi, m_hi[slot]);
+            }
+            i += uint64_t(1) << k;
+        }
+    }
+
+    // Columns the window spans at `level` (level 0: one per sample).
+    size_t columnCount(int level) const {
+        if (empty()) return 0;
+        const uint64_t end = m_ring.pushed();
+        return static_cast<size_t>(((end - 1) >> level) - ((end - size()) >> level) + 1);
+    }
+
+    // The coarsest detail that still fits: the lowest level with at most
+    // `columns` columns (0 = no limit).
+    int levelFor(size_t columns) const {
+        if (columns == 0) return 0;
+        int level = 0;
+        while (level < LEVELS && columnCount(level) > columns) ++level;
+        return level;
+    }
+
+    // Column j (oldest first) at `level`; j < columnCount(level).
+    Column column(int level, size_t j) const {
+        if (level == 0) {
+            const float v = m_ring[j];
+            return { v, v, j };
+        }
+        const uint64_t end = m_ring.pushed();
+        const uint64_t start = end - size();
+        const uint64_t block = (start >> level) + j;
+        const size_t slot = levelOffset(level) + (static_cast<size_t>(block) & (levelSize(level) - 1));
+        const uint64_t blockEnd = std::min((block + 1) << level, end);
+        return { m_lo[slot], m_hi[slot], static_cast<size_t>(blockEnd - 1 - start) };
+    }
+
+private:
+    // Level k keeps CAPACITY >> (k - 1) blocks — twice what the window spans, so
+    // the partial blocks at both ends of it are never overwritten.
+    static constexpr size_t levelSize(int k) { return CAPACITY >> (k - 1); }
+    static constexpr size_t levelOffset(int k) { return 2 * CAPACITY - 2 * (CAPACITY >> (k - 1)); }
+    static constexpr size_t LEVEL_STORAGE = 2 * CAPACITY - 2;
+
+    HistoryRing<float, CAPACITY> m_ring;
+    std::array<float, LEVEL_STORAGE> m_lo{};
+    std::array<float, LEVEL_STORAGE> m_hi{};
+};
@@ -56,6 +56,7 @@ enum class HotkeyAction : uint8_t {
     SEGMENT_REMOVE,              // Segment timer: remove the last boundary point
     DIRECTOR_TOGGLE,             // Auto-director: enable/disable
     DIRECTOR_LOCK,               // Auto-director: lock onto the current rider (pin subject)
+    TOGGLE_TRACE,                // Dev: start/stop a timeline trace capture (no settings row)
 
     COUNT  // Must be last
 };
@@ -97,6 +98,7 @@ inline const char* getActionDisplayName(HotkeyAction action) {
         case HotkeyAction::SEGMENT_REMOVE:            return "Segment Remove";
         case HotkeyAction::DIRECTOR_TOGGLE:           return "Director";
         case HotkeyAction::DIRECTOR_LOCK:             return "Director Lock";
+        case HotkeyAction::TOGGLE_TRACE:              return "Trace Capture";
         default: return "Unknown";
     }
 }
@@ -141,6 +143,7 @@ inline const char* getActionConfigName(HotkeyAction action) {
         case HotkeyAction::SEGMENT_REMOVE:            return "segment_remove";
         case HotkeyAction::DIRECTOR_TOGGLE:           return "director_toggle";
         case HotkeyAction::DIRECTOR_LOCK:             return "director_lock";
+        case HotkeyAction::TOGGLE_TRACE:              return "trace";
         default: return "unknown";
     }
 }
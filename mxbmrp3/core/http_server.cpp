@@ -41,7 +41,8 @@ HttpServer::HttpServer()
     , m_throttleMs(DEFAULT_THROTTLE_MS)
     , m_bindAddress(DEFAULT_BIND_ADDRESS)
     , m_sseSequence(0)
-    , m_webRoot("plugins\\mxbmrp3_data\\web") {
+    , m_webRoot("plugins\\mxbmrp3_data\\web")
+    , m_snapshotScratch(std::make_unique<SnapshotScratch>()) {
 }
 
 HttpServer::~HttpServer() {
@@ -83,7 +84,7 @@ void HttpServer::start() {
     {
         std::lock_guard<std::mutex> lock(m_dataMutex);
         m_sseSequence = 0;
-        m_cachedJson = buildJsonSnapshot();
+        buildJsonSnapshot(m_cachedJson);
     }
     m_snapshotStale = false;
 
@@ -224,11 +225,14 @@ void HttpServer::onDataChanged(DataChangeType changeType) {
 
     // Build JSON snapshot on the game thread where PluginData access is safe.
     // Server threads only read the cached string under the mutex.
-    std::string snapshot = buildJsonSnapshot();
+    publishSnapshot();
+}
 
+void HttpServer::publishSnapshot() {
+    buildJsonSnapshot(m_snapshotBuffer);
     {
         std::lock_guard<std::mutex> lock(m_dataMutex);
-        m_cachedJson = std::move(snapshot);
+        m_cachedJson.swap(m_snapshotBuffer);
         ++m_sseSequence;
     }
     m_dataCondition.notify_all();
@@ -258,13 +262,7 @@ void HttpServer::forceOverlayPanel(OverlayPanel panel) {
     m_forcedSeq.fetch_add(1);
 
     // Built on the game thread (the caller), where PluginData access is safe.
-    std::string snapshot = buildJsonSnapshot();
-    {
-        std::lock_guard<std::mutex> lock(m_dataMutex);
-        m_cachedJson = std::move(snapshot);
-        ++m_sseSequence;
-    }
-    m_dataCondition.notify_all();
+    publishSnapshot();
 }
 
 // ============================================================================
@@ -17,6 +17,7 @@
 // Forward declarations
 enum class DataChangeType;
 namespace httplib { class Server; }
+namespace http_server_detail { struct SnapshotScratch; }
 
 class HttpServer {
 public:
@@ -27,7 +28,11 @@ public:
     // bypassing the server socket AND the change-gating/caching, so plugin-logic
     // tests can observe computed state without starting a server or fighting the
     // rebuild gate. Absent from shipping builds; see core/test_hooks.cpp.
-    std::string testSnapshot() const { return buildJsonSnapshot(); }
+    std::string testSnapshot() const {
+        std::string out;
+        buildJsonSnapshot(out);
+        return out;
+    }
 #endif
 
     // Lifecycle (called by PluginManager)
@@ -74,9 +79,15 @@ private:
     HttpServer(const HttpServer&) = delete;
     HttpServer& operator=(const HttpServer&) = delete;
 
-    // Build JSON snapshot from current PluginData state.
+    // Build JSON snapshot from current PluginData state into `out` (cleared
+    // first, so its capacity is reused).
     // Must only be called from the game thread (PluginData is not thread-safe).
-    std::string buildJsonSnapshot() const;
+    void buildJsonSnapshot(std::string& out) const;
+
+    // Rebuild the snapshot into m_snapshotBuffer and publish it: swapped with
+    // m_cachedJson under the mutex, so the two strings trade buffers instead of
+    // reallocating, then wake the SSE streams. Game thread only.
+    void publishSnapshot();
 
     // Server thread entry point
     void serverThread();
@@ -103,6 +114,11 @@ private:
     uint64_t m_sseSequence;                 // Incrementing SSE event ID (per-client tracking)
     std::string m_cachedJson;
 
+    // Game thread only: the next snapshot is built here (then swapped with
+    // m_cachedJson), and buildJsonSnapshot()'s working vectors live in the scratch.
+    std::string m_snapshotBuffer;
+    std::unique_ptr<http_server_detail::SnapshotScratch> m_snapshotScratch;
+
     // Broadcaster panel-force command, emitted in every snapshot as
     // "overlayCmd":{panel,seq}. m_forcedSeq increments per keypress; the client
     // acts only when it changes (edge-triggered). Atomic: written on the game
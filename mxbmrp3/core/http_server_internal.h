@@ -11,12 +11,26 @@
 // ============================================================================
 #pragma once
 
+#include "battle_groups.h"
+
 #include <cmath>
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace http_server_detail {
 
+// Working buffers for buildJsonSnapshot(), owned by the HttpServer and reused
+// build after build (game thread only): once they reach the field's size a
+// snapshot rebuild allocates nothing.
+struct SnapshotScratch {
+    BattleGroups battles;
+    std::vector<std::pair<int, int>> bySector[4];  // (ms, raceNum) per sector
+    std::vector<int> lapTimes;                     // one rider's completed laps
+    std::vector<char> lapValid;
+};
+
 // Append a JSON-escaped string value (handles \, ", control chars)
 inline void appendJsonString(std::string& out, const char* str) {
     out += '"';
@@ -9,6 +9,8 @@
 // Called on the game thread only (PluginData is not thread-safe). Uses direct
 // string building instead of nlohmann::json to avoid per-frame heap allocations
 // from json objects — this runs every time standings change, so it must be fast.
+// The output string and the working vectors (SnapshotScratch) are owned by the
+// HttpServer and reused, so a steady-state rebuild does not allocate.
 // ============================================================================
 
 #include "http_server.h"
@@ -20,6 +22,8 @@
 #include "font_config.h"
 #include "tracked_riders_manager.h"
 #include "director_manager.h"
+#include "../diagnostics/tracer.h"
+#include "../diagnostics/alloc_counter.h"
 
 #include <algorithm>
 #include <chrono>
@@ -30,16 +34,20 @@
 using namespace PluginConstants;
 using namespace http_server_detail;
 
-std::string HttpServer::buildJsonSnapshot() const {
+void HttpServer::buildJsonSnapshot(std::string& out) const {
+    TRACE_SCOPE("HttpServer::buildJsonSnapshot");
+    ALLOC_PHASE(AllocCounter::Phase::SNAPSHOT);
     const PluginData& pd = PluginData::getInstance();
     const SessionData& session = pd.getSessionData();
     const auto& classificationOrder = pd.getDisplayClassificationOrder();
     const auto& raceEntries = pd.getRaceEntries();
     const auto& standings = pd.getStandings();
     int displayRaceNum = pd.getDisplayRaceNum();
+    SnapshotScratch& scratch = *m_snapshotScratch;
 
-    // Pre-allocate ~16KB - typical for a 30-rider grid with events
-    std::string out;
+    // Pre-allocate ~16KB - typical for a 30-rider grid with events (a no-op once
+    // the reused buffer has grown past it)
+    out.clear();
     out.reserve(16384);
 
     // No active session (cleared/menu) — return minimal idle snapshot.
@@ -52,7 +60,7 @@ std::string HttpServer::buildJsonSnapshot() const {
                ",\"pluginVersion\":\"";
         out += PLUGIN_VERSION;
         out += "\"},\"standings\":[],\"events\":[]}";
-        return out;
+        return;
     }
 
     // Determine session mode once, used by session and standings sections.
@@ -110,14 +118,16 @@ std::string HttpServer::buildJsonSnapshot() const {
     // the overlay hydrates them from standings[] and renders the panel. ---
     {
         DirectorManager& dir = DirectorManager::getInstance();
-        auto groups = pd.getBattleGroups(dir.getBattleGapMs(), dir.getBattleMaxPos());
+        BattleGroups& groups = scratch.battles;
+        pd.getBattleGroups(dir.getBattleGapMs(), dir.getBattleMaxPos(), groups);
         out += "\"battles\":[";
-        for (size_t gi = 0; gi < groups.size(); ++gi) {
+        for (size_t gi = 0; gi < groups.count(); ++gi) {
             if (gi) out += ",";
             out += "[";
-            for (size_t ri = 0; ri < groups[gi].size(); ++ri) {
+            const int* group = groups.group(gi);
+            for (size_t ri = 0; ri < groups.groupSize(gi); ++ri) {
                 if (ri) out += ",";
-                appendJsonInt(out, groups[gi][ri]);
+                appendJsonInt(out, group[ri]);
             }
             out += "]";
         }
@@ -136,7 +146,8 @@ std::string HttpServer::buildJsonSnapshot() const {
         out += "\"sectors\":[";
         {
             constexpr int kTopN = 8;   // ranked riders shown per sector
-            std::vector<std::pair<int,int>> bySec[4];  // (ms, raceNum) per sector
+            std::vector<std::pair<int,int>>* bySec = scratch.bySector;  // (ms, raceNum) per sector
+            for (int i = 0; i < 4; ++i) bySec[i].clear();
             for (const auto& kv : standings) {
                 const IdealLapData* il = pd.getIdealLapData(kv.second.raceNum);
                 if (!il) continue;
@@ -190,11 +201,11 @@ std::string HttpServer::buildJsonSnapshot() const {
             // laps (invalid laps included — their time still elapsed, so cumulative /
             // position / gap must count them; validity is recorded in parallel so the
             // client's pace/best-lap views can exclude them). Matches collectField().
-            std::vector<int> t;
-            std::vector<char> v;
+            std::vector<int>& t = scratch.lapTimes;
+            std::vector<char>& v = scratch.lapValid;
+            t.clear();
+            v.clear();
             bool anyInvalid = false;
-            t.reserve(log->size());
-            v.reserve(log->size());
             for (auto it = log->rbegin(); it != log->rend(); ++it) {
                 if (it->isComplete && it->lapTime > 0) {
                     t.push_back(it->lapTime);
@@ -632,5 +643,4 @@ std::string HttpServer::buildJsonSnapshot() const {
     }
 
     out += "]}";
-    return out;
 }
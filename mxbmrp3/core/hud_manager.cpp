@@ -7,6 +7,7 @@
 #include "../diagnostics/timer.h"
 #include "asset_manager.h"
 #include "companion_window.h"
+#include "frame_export.h"
 #include "input_manager.h"
 #include "xinput_reader.h"
 #include "plugin_data.h"
@@ -15,6 +16,7 @@
 #include "director_manager.h"
 #include "profile_manager.h"
 #include "ui_config.h"
+#include "track_geometry_cache.h"
 #include "../hud/base_hud.h"
 #include "../hud/standings_hud.h"
 #include "../hud/performance_hud.h"
@@ -119,6 +121,7 @@ void HudManager::initialize() {
 
     // Pre-allocate render data vectors for optimal performance
     m_quads.reserve(INITIAL_QUAD_CAPACITY);
+    m_frameStrings.reserve(INITIAL_STRING_CAPACITY);
     m_strings.reserve(INITIAL_STRING_CAPACITY);
 
     // Setup default resources (this prepares the resource lists)
@@ -464,6 +467,7 @@ void HudManager::clear(bool allowCrossSingleton) {
     // alive, so we still stop it here (deterministic, joins before we continue).
     if (allowCrossSingleton) {
         CompanionWindow::getInstance().stop();
+        FrameExport::getInstance().stop();   // same reasoning: joins its image thread
     }
 
 #if GAME_HAS_RECORDS_PROVIDER
@@ -475,6 +479,11 @@ void HudManager::clear(bool allowCrossSingleton) {
     }
 #endif
 
+    // Stop the ribbon pyramid worker. It touches no HUD state (it only reads its
+    // own copy of the segments), so the ordering is free; joining here keeps the
+    // thread from outliving Shutdown().
+    m_trackRibbons.clear();
+
     // Reset cached HUD pointers BEFORE destroying the objects
     // This prevents any dangling pointer window (defensive programming)
     m_pIdealLap = nullptr;
@@ -530,6 +539,7 @@ void HudManager::clear(bool allowCrossSingleton) {
     // Now safe to destroy HUD objects
     m_huds.clear();
     m_quads.clear();
+    m_frameStrings.clear();
     m_strings.clear();
 
     // Clean up resource name storage
@@ -589,6 +599,13 @@ int HudManager::initializeResources(int* piNumSprites, char** pszSpriteName, int
 
     m_bResourcesInitialized = true;
 
+    // The companion window renders the same sprite/font indices, so hand it the
+    // tables now — this is the only point they change, so submit() never re-sends them.
+    CompanionWindow::getInstance().setResources(m_fontNames, m_spriteNames,
+                                                AssetManager::getInstance().getFirstIconSpriteIndex());
+    FrameExport::getInstance().setResources(m_fontNames, m_spriteNames,
+                                            AssetManager::getInstance().getFirstIconSpriteIndex());
+
     DEBUG_INFO_F("Resources initialized: %d sprites, %d fonts", numSprites, numFonts);
 
     for (const auto& name : m_spriteNames) {
@@ -759,7 +776,14 @@ void HudManager::updateTrackCenterline(int numSegments, Unified::TrackSegment* s
     }
 
     DEBUG_INFO_F("HudManager: Updating track centerline with %d segments", numSegments);
-    m_pMapHud->updateTrackData(numSegments, segments, raceData);
+    // Track geometry from the disk cache when it matches this centerline, else the
+    // coarsest ribbon level now and the rest on a worker (see track_ribbon_pyramid.h)
+    const float sfMeters = raceData ? raceData[0] : 0.0f;
+    m_trackRibbons.build(segments, numSegments, sfMeters,
+                         TrackGeometryCache::filePath(PluginManager::getInstance().getSavePath(),
+                                                      PluginData::getInstance().getSessionData().trackId));
+    const auto geometry = m_trackRibbons.current();
+    m_pMapHud->updateTrackData(numSegments, segments, raceData, geometry.get());
 }
 
 void HudManager::updateRiderPositions(int numVehicles, Unified::TrackPositionData* positions) {
@@ -768,20 +792,10 @@ void HudManager::updateRiderPositions(int numVehicles, Unified::TrackPositionDat
         return;
     }
 
-    // Update MapHud
-    if (m_pMapHud) {
-        m_pMapHud->updateRiderPositions(numVehicles, positions);
-    }
-
-    // Update RadarHud
-    if (m_pRadarHud) {
-        m_pRadarHud->updateRiderPositions(numVehicles, positions);
-    }
-
-    // Update GapBarHud (for flat map mode)
-    if (m_pGapBar) {
-        m_pGapBar->updateRiderPositions(numVehicles, positions);
-    }
+    // MapHud, RadarHud and GapBarHud markers: ingest only, the next frames push
+    // the positions dead-reckoned to their draw time (updateRiderMotion)
+    m_riderMotion.update(positions, numVehicles, RiderMotion::nowUs());
+    m_bRiderMotionDirty = true;
 
     // Update CompassWidget (heading from the displayed rider's yaw)
     if (m_pCompass) {
@@ -12,6 +12,8 @@
 #include "../game/game_config.h"
 #include "../game/unified_types.h"
 #include "../hud/base_hud.h"
+#include "track_ribbon_pyramid.h"
+#include "rider_motion.h"
 
 // Forward declarations to avoid circular dependency with plugin_data.h
 enum class DataChangeType;
@@ -85,8 +87,15 @@ public:
     // or nullptr if unavailable. Values <= 0 are treated as "not present".
     void updateTrackCenterline(int numSegments, Unified::TrackSegment* segments, const float* raceData);
 
-    // Rider position data handling (high-frequency update)
+    // Per-track world-ribbon LOD pyramid, rebuilt (off-thread) by
+    // updateTrackCenterline. Shared by the HUDs that draw track geometry.
+    const TrackRibbonPyramid& getTrackRibbons() const { return m_trackRibbons; }
+
+    // Rider position data handling (high-frequency update). Timing consumers get
+    // the batch as-is; the map, radar and gap bar markers get it through
+    // getRiderMotion(), dead-reckoned to each frame by updateHuds().
     void updateRiderPositions(int numVehicles, Unified::TrackPositionData* positions);
+    const RiderMotion& getRiderMotion() const { return m_riderMotion; }
 
     // Get HUD references for settings persistence
     // Note: These assert m_bInitialized - only call after initialize() and before shutdown()
@@ -196,7 +205,7 @@ private:
     // the game frame exactly; companion=true uses each HUD's companion instance
     // (on/off + position). See collectRenderData.
     void collectSurface(std::vector<SPluginQuad_t>& outQuads,
-                        std::vector<SPluginString_t>& outStrings, bool companion);
+                        CompactStringArena& outStrings, bool companion);
     // Debug/alignment aid (INI-only, off by default): append the HUD snap-grid lattice
     // as thin quads on top of the frame. Every Nth line uses the "major" color/thickness.
     void appendGridOverlay(std::vector<SPluginQuad_t>& outQuads) const;
@@ -205,6 +214,8 @@ private:
     void setupDefaultResources();
     void handleSettingsButton();
     void handleDirectorButton();
+    // Push the rider positions predicted for this frame to the marker HUDs.
+    void updateRiderMotion();
     void persistDirectorEnabled();  // save the director on/off mode (auto-save-gated)
 
     bool m_bInitialized;
@@ -269,6 +280,17 @@ private:
     class EventLogHud* m_pEventLog;
     class BenchmarkWidget* m_pBenchmark;
 
+    TrackRibbonPyramid m_trackRibbons;
+
+    // Rider kinematics from RaceTrackPosition, and this frame's prediction.
+    // Pushed while the batch is new or a rider is still inside its
+    // extrapolation window as of the last push; between batches only to HUDs
+    // with hasIncrementalMotion().
+    RiderMotion m_riderMotion;
+    std::vector<Unified::TrackPositionData> m_predictedPositions;
+    long long m_lastMotionPushUs = 0;
+    bool m_bRiderMotionDirty = false;
+
     // Temporary HUD visibility toggle (doesn't modify actual visibility state)
     bool m_bAllHudsToggledOff;
     bool m_bAllWidgetsToggledOff;
@@ -277,12 +299,16 @@ private:
     bool m_bSuppressInGame = false;
     bool m_lastActiveCompanion = false;  // track focus surface to refresh settings on change
 
-    // Collected render data from all HUDs
+    // Collected render data from all HUDs. Strings are assembled compactly
+    // (m_frameStrings) and expanded into the game's layout once, into m_strings —
+    // the buffer handed to the game.
     std::vector<SPluginQuad_t> m_quads;
+    CompactStringArena m_frameStrings;
     std::vector<SPluginString_t> m_strings;
-    // Companion-surface frame (built only while the companion window is open).
+    // Companion-surface frame (built only while the companion window is open). Stays
+    // compact: the window thread expands it (see CompanionWindow::Frame).
     std::vector<SPluginQuad_t> m_companionQuads;
-    std::vector<SPluginString_t> m_companionStrings;
+    CompactStringArena m_companionStrings;
 
     // Resource management - dynamically sized based on discovered assets
     std::vector<std::string> m_spriteNames;
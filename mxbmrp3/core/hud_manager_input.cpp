@@ -12,6 +12,7 @@
 #include "hud_manager.h"
 #include "../diagnostics/logger.h"
 #include "../diagnostics/timer.h"
+#include "../diagnostics/tracer.h"
 #include "asset_manager.h"
 #include "companion_window.h"
 #include "input_manager.h"
@@ -285,6 +286,11 @@ void HudManager::processKeyboardInput() {
         DirectorManager::getInstance().toggleLock();  // transient - not persisted
     }
 
+    // Dev: timeline trace capture. The second press writes mxbmrp3\traces\trace_*.json.
+    if (hotkeyMgr.wasActionTriggered(HotkeyAction::TOGGLE_TRACE)) {
+        Tracer::getInstance().toggle(PluginManager::getInstance().getSavePath());
+    }
+
     // Custom segment timer: Add drops a boundary point at the current position,
     // Remove deletes the last one. PluginData owns the state and emits the notice.
     // Nudge the map so the boundary markers appear/clear immediately (it only
@@ -13,8 +13,11 @@
 #include "hud_manager.h"
 #include "../diagnostics/logger.h"
 #include "../diagnostics/timer.h"
+#include "../diagnostics/tracer.h"
+#include "../diagnostics/alloc_counter.h"
 #include "asset_manager.h"
 #include "companion_window.h"
+#include "frame_export.h"
 #include "input_manager.h"
 #include "xinput_reader.h"
 #include "plugin_data.h"
@@ -125,6 +128,7 @@ void HudManager::produceFrame(int iState) {
     if (!m_bInitialized) {
         m_bSuppressInGame = false;
         m_quads.clear();
+        m_frameStrings.clear();
         m_strings.clear();
         return;
     }
@@ -205,10 +209,28 @@ void HudManager::produceFrame(int iState) {
     if (companion.isEnabled()) {
         // The companion gets its OWN frame (per-HUD companion on/off + position),
         // built by collectRenderData when the window is open.
-        companion.submit(m_companionQuads, m_companionStrings, m_fontNames, m_spriteNames,
-                         AssetManager::getInstance().getFirstIconSpriteIndex());
+        companion.submit(m_companionQuads, m_companionStrings);
     }
 
+    // Render-pipeline bytes written this frame, for the BenchmarkWidget: the collected
+    // game frame, its one expansion, and (window open) the companion frame collected
+    // and then copied into its triple-buffer slot.
+    if (bm.active) {
+        size_t bytes = m_quads.size() * sizeof(SPluginQuad_t) + m_frameStrings.byteSize() +
+                       m_strings.size() * sizeof(SPluginString_t);
+        if (companion.isEnabled())
+            bytes += 2 * (m_companionQuads.size() * sizeof(SPluginQuad_t) + m_companionStrings.byteSize());
+        bm.frameBytesMoved = static_cast<long long>(bytes);
+    }
+
+    // Opt-in shared-memory export for external readers ([Advanced] frameExport). It
+    // publishes the game surface's frame — what the game itself draws — whatever the
+    // display target. reconcile() is two compares when the mode hasn't changed.
+    FrameExport& frameExport = FrameExport::getInstance();
+    frameExport.reconcile(static_cast<FrameExport::Mode>(UiConfig::getInstance().getFrameExport()),
+                          UiConfig::getInstance().getFrameExportWidth());
+    frameExport.publish(m_quads, m_strings);
+
     // COMPANION mode suppresses the in-game HUD — EXCEPT while the settings menu is
     // showing IN-GAME, so the user can always reopen settings and switch back. The
     // menu renders only on the active surface (see collectSurface), so gate on the
@@ -221,6 +243,7 @@ void HudManager::produceFrame(int iState) {
 }
 
 void HudManager::updateHuds() {
+    TRACE_SCOPE("HudManager::updateHuds");
     // When focus moves between the game and companion windows, refresh the settings
     // menu so its per-HUD checkboxes reflect the now-active surface's instance.
     bool activeCompanion = InputManager::getInstance().getActiveSurface() == InputManager::Surface::Companion;
@@ -296,6 +319,9 @@ void HudManager::updateHuds() {
         }
     }
 
+    // Rider markers: this frame's dead-reckoned positions, before the HUDs rebuild
+    updateRiderMotion();
+
     // Now update all HUDs
     for (auto& hud : m_huds) {
         if (hud) {
@@ -315,16 +341,46 @@ void HudManager::updateHuds() {
             }
 
             // Always call update() to handle data/layout dirty flags
+            ALLOC_PHASE(AllocCounter::Phase::HUD_UPDATE);
             hud->update();
         }
     }
 }
 
+void HudManager::updateRiderMotion() {
+    // Nothing new since the last push and every rider already held at its last
+    // sample or window end: the HUDs have these positions.
+    const long long now = RiderMotion::nowUs();
+    const bool newBatch = m_bRiderMotionDirty;
+    if (!newBatch && !m_riderMotion.isMoving(m_lastMotionPushUs)) {
+        return;
+    }
+    m_bRiderMotionDirty = false;
+    m_lastMotionPushUs = now;
+
+    // A new batch goes to every HUD. In between, only the HUDs that redraw just
+    // their rider layer for it get the frame's prediction: a rotate-to-player or
+    // zoomed map rebuilds in full per push, so it steps at the batch rate.
+    m_riderMotion.predict(now, m_predictedPositions);
+    const int count = static_cast<int>(m_predictedPositions.size());
+    const Unified::TrackPositionData* positions = m_predictedPositions.data();
+    if (m_pMapHud && (newBatch || m_pMapHud->hasIncrementalMotion())) {
+        m_pMapHud->updateRiderPositions(count, positions);
+    }
+    if (m_pRadarHud && (newBatch || m_pRadarHud->hasIncrementalMotion())) {
+        m_pRadarHud->updateRiderPositions(count, positions);
+    }
+    if (m_pGapBar) m_pGapBar->updateRiderPositions(count, positions);
+}
+
 void HudManager::collectRenderData() {
     // Game surface: byte-identical to before. Then, only when the companion window
     // is open, build its frame from each HUD's companion instance (own on/off +
     // position; mirrors the game until diverged).
-    collectSurface(m_quads, m_strings, /*companion=*/false);
+    collectSurface(m_quads, m_frameStrings, /*companion=*/false);
+    // The one expansion into the game's SPluginString_t layout (the buffer Draw hands
+    // over, and what the plugin thread / frame export copy from).
+    m_frameStrings.expandInto(m_strings);
     if (CompanionWindow::getInstance().isEnabled()) {
         // Decouple from the start: the first frame the companion is on, snapshot each
         // HUD's game state into its companion instance so the two are independent
@@ -341,8 +397,9 @@ void HudManager::collectRenderData() {
 // copying a HUD's primitives (reusing all the shadow logic), translates that HUD's
 // appended range by its (companion - game) offset delta.
 void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
-                                std::vector<SPluginString_t>& outStrings,
+                                CompactStringArena& outStrings,
                                 bool companion) {
+    TRACE_SCOPE(companion ? "HudManager::collectSurface (companion)" : "HudManager::collectSurface");
 
     // Get drop shadow settings once (avoid repeated singleton calls)
     const UiConfig& uiConfig = UiConfig::getInstance();
@@ -354,11 +411,13 @@ void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
     // Calculate total capacity needed to minimize allocations
     size_t totalQuads = 0;
     size_t totalStrings = 0;
+    size_t totalText = 0;
 
     for (const auto& hud : m_huds) {
         if (hud) {
             totalQuads += hud->getQuads().size();
             totalStrings += hud->getStrings().size();
+            totalText += hud->getStrings().textBytes();
         }
     }
 
@@ -387,15 +446,16 @@ void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
         DEBUG_INFO_F("HudManager quads capacity increased to %zu", newCapacity);
     }
 
+    // Shadow copies share their source's text, so only the records double.
     if (outStrings.capacity() < totalStrings) {
         size_t newCapacity = totalStrings * CAPACITY_GROWTH_FACTOR;
-        outStrings.reserve(newCapacity);
+        outStrings.reserve(newCapacity, totalText * CAPACITY_GROWTH_FACTOR);
         DEBUG_INFO_F("HudManager strings capacity increased to %zu", newCapacity);
     }
 
     // Clear existing data but keep allocated memory
     outQuads.resize(0);
-    outStrings.resize(0);
+    outStrings.clear();
 
     // The interactive chrome — the mouse pointer and the OPEN settings menu — belongs
     // to the surface the user is actually on, not both. Otherwise the companion
@@ -456,8 +516,7 @@ void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
             }
 
             const auto& hudQuads = hud->getQuads();
-            const auto& hudStrings = hud->getStrings();
-            const auto& skipShadowFlags = hud->getStringSkipShadow();
+            const CompactStringArena& hudStrings = hud->getStrings();
 
             // Per-HUD drop shadow: the global setting unless this HUD has an ini-only override.
             bool hudShadow = hud->getEffectiveDropShadow(dropShadowEnabled);
@@ -473,8 +532,8 @@ void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
             // this keeps them in lockstep if addTitleString ever gains a skip flag).
             int titleStrIdx = hud->m_titleStringIndex;
             bool titleStrSkips = titleStrIdx >= 0 &&
-                                 titleStrIdx < static_cast<int>(skipShadowFlags.size()) &&
-                                 skipShadowFlags[titleStrIdx];
+                                 titleStrIdx < static_cast<int>(hudStrings.size()) &&
+                                 hudStrings[titleStrIdx].skipShadow();
             bool shadowTitleIcon = hudShadow && !titleStrSkips && titleIconIdx >= 0 &&
                                    titleIconIdx < static_cast<int>(hudQuads.size());
             if (shadowTitleIcon) {
@@ -504,29 +563,31 @@ void HudManager::collectSurface(std::vector<SPluginQuad_t>& outQuads,
                 outQuads.insert(outQuads.end(), hudQuads.begin(), hudQuads.end());
             }
 
-            // For strings: if drop shadow enabled, add shadow before each non-skipped string
+            // Strings: the HUD's text arena is appended in one bulk copy; records are
+            // rebased onto it. A drop shadow is just another record over the same text.
+            uint32_t textBase = outStrings.appendText(hudStrings);
             if (hudShadow) {
-                for (size_t i = 0; i < hudStrings.size(); ++i) {
-                    const auto& str = hudStrings[i];
-                    bool skipShadow = (i < skipShadowFlags.size()) ? skipShadowFlags[i] : false;
+                for (const CompactString& src : hudStrings) {
+                    CompactString str = src;
+                    str.textOffset += textBase;
 
-                    if (!skipShadow) {
+                    if (!str.skipShadow()) {
                         // Add shadow string first (so it renders behind)
-                        SPluginString_t shadowStr = str;
+                        CompactString shadowStr = str;
                         // Offset proportional to font size, capped at EXTRA_LARGE to avoid exaggerated shadows on oversized fonts
                         float shadowSize = std::min(str.m_fSize, PluginConstants::FontSizes::EXTRA_LARGE);
                         shadowStr.m_afPos[0] += shadowSize * shadowOffsetXPct;
                         shadowStr.m_afPos[1] += shadowSize * shadowOffsetYPct;
-                        shadowStr.m_ulColor = shadowColor;
-                        outStrings.push_back(shadowStr);
+                        shadowStr.m_ulColor = static_cast<uint32_t>(shadowColor);
+                        outStrings.push(shadowStr);
                     }
 
                     // Add original string
-                    outStrings.push_back(str);
+                    outStrings.push(str);
                 }
             } else {
                 // No drop shadow - use efficient bulk copy
-                outStrings.insert(outStrings.end(), hudStrings.begin(), hudStrings.end());
+                outStrings.pushAll(hudStrings, textBase);
             }
 
             // Companion surface: shift this HUD's just-appended primitives to its
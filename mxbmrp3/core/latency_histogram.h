@@ -0,0 +1,118 @@
+// ============================================================================
+// core/latency_histogram.h
+// Fixed-memory log-linear (HDR-style) latency histogram for the built-in
+// profiler (BenchmarkMetrics, BenchmarkWidget, PerformanceHud).
+//
+// Values are microseconds. 0..31 us get one bucket each; above that every power
+// of two is split into 16 buckets, so a bucket is at most 1/16 (6.25%) of its
+// value wide. Values past MAX_VALUE (~67 s) land in the last bucket; min / max /
+// sum stay exact. record() is O(1) (a bit scan and an increment) with no
+// allocation, so a histogram can run for a whole race weekend at constant
+// memory (BUCKETS x 4 bytes) and answer "what was our p99.9 Draw".
+//
+// Header-only and Win32-free so tests/unit can pin the bucket math.
+// ============================================================================
+#pragma once
+
+#include <array>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>   // _BitScanReverse64 (x64-only project)
+#endif
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;         // buckets per power of two
+    static constexpr int MAX_BITS = 26;
+    static constexpr long long MAX_VALUE = (1LL << MAX_BITS) - 1;
+    static constexpr int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    void record(long long us) {
+        if (us < 0) us = 0;
+        if (m_count == 0 || us < m_min) m_min = us;
+        if (us > m_max) m_max = us;
+        m_sum += us;
+        ++m_count;
+        ++m_buckets[bucketIndex(us > MAX_VALUE ? MAX_VALUE : us)];
+    }
+
+    void reset() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_sum = 0;
+        m_min = 0;
+        m_max = 0;
+    }
+
+    uint64_t count() const { return m_count; }
+    long long min() const { return m_min; }
+    long long max() const { return m_max; }
+    double mean() const { return m_count ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0; }
+
+    // Values at the given quantiles (0..1, ascending), in one pass over the
+    // buckets. Each is the middle of the bucket holding that rank, clamped to the
+    // exact min/max, so it is within half a bucket width of the true value (the
+    // top rank returns max() itself). Empty histogram: all zero.
+    void quantiles(const double* q, long long* out, int n) const {
+        int qi = 0;
+        if (m_count == 0) {
+            for (; qi < n; ++qi) out[qi] = 0;
+            return;
+        }
+        uint64_t cumulative = 0;
+        for (int b = 0; b < BUCKETS && qi < n; ++b) {
+            cumulative += m_buckets[b];
+            while (qi < n && cumulative >= rankOf(q[qi])) {
+                if (rankOf(q[qi]) >= m_count) { out[qi++] = m_max; continue; }   // the top sample is exact
+                long long v = bucketLow(b) + (bucketWidth(b) - 1) / 2;
+                out[qi++] = v < m_min ? m_min : (v > m_max ? m_max : v);
+            }
+        }
+        for (; qi < n; ++qi) out[qi] = m_max;
+    }
+
+    long long quantile(double q) const {
+        long long v = 0;
+        quantiles(&q, &v, 1);
+        return v;
+    }
+
+    // Bucket math (public for the unit tests).
+    static int bucketIndex(long long v) {
+        if (v < 2 * SUB_COUNT) return static_cast<int>(v);
+#ifdef _MSC_VER
+        unsigned long msbIndex;
+        _BitScanReverse64(&msbIndex, static_cast<unsigned long long>(v));
+        const int msb = static_cast<int>(msbIndex);
+#else
+        const int msb = 63 - __builtin_clzll(static_cast<unsigned long long>(v));
+#endif
+        const int shift = msb - SUB_BITS;
+        return (shift + 1) * SUB_COUNT + static_cast<int>(v >> shift) - SUB_COUNT;
+    }
+    static long long bucketLow(int b) {
+        if (b < 2 * SUB_COUNT) return b;
+        const int shift = b / SUB_COUNT - 1;
+        return static_cast<long long>(b % SUB_COUNT + SUB_COUNT) << shift;
+    }
+    static long long bucketWidth(int b) {
+        return b < 2 * SUB_COUNT ? 1 : 1LL << (b / SUB_COUNT - 1);
+    }
+
+private:
+    uint64_t rankOf(double q) const {
+        if (q <= 0.0) return 1;
+        if (q >= 1.0) return m_count;
+        const double r = q * static_cast<double>(m_count);
+        uint64_t rank = static_cast<uint64_t>(r);
+        if (static_cast<double>(rank) < r) ++rank;   // ceil
+        return rank < 1 ? 1 : rank;
+    }
+
+    std::array<uint32_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+    long long m_sum = 0;
+    long long m_min = 0;
+    long long m_max = 0;
+};
@@ -33,6 +33,13 @@ inline uint64_t counterToMicroseconds(long long frequency, long long counter) {
            ((counter % frequency) * 1000000LL) / frequency;
 }
 
+// Raw performance counter ticks (0 on failure). For timing short intervals
+// without the microsecond rounding of getCurrentTimeMicroseconds.
+inline long long getCounter() {
+    LARGE_INTEGER currentTime;
+    return QueryPerformanceCounter(&currentTime) ? currentTime.QuadPart : 0;
+}
+
 // Gets current time in microseconds
 // frequency: Result from initializeFrequency()
 inline uint64_t getCurrentTimeMicroseconds(long long frequency) {
@@ -827,10 +827,10 @@ void PluginData::clear() {
     // of a same-track session (the MapHud likewise keeps its split markers).
     resetSegmentTimer();
 
-    // Reset benchmark metrics (preserves active flag, clears all registrations)
-    bool bmWasActive = m_benchmarkMetrics.active;
-    m_benchmarkMetrics = BenchmarkMetrics{};
-    m_benchmarkMetrics.active = bmWasActive;
+    // Reset benchmark metrics for the new session. In place: registrations stay
+    // (HUDs registered once at startup keep their indices) and the histograms are
+    // too large for a temporary.
+    m_benchmarkMetrics.resetSession();
 
     // Clear event log
     m_eventLog.clear();
@@ -19,6 +19,9 @@
 #include "plugin_constants.h"  // For Placeholders namespace
 #include "event_log_types.h"   // For EventLogEntry, EventLogType
 #include "segment_cumulative.h" // For SegmentCumulative (segment-timer aggregation)
+#include "latency_histogram.h"  // For LatencyHistogram (benchmark tail latency)
+#include "history_ring.h"       // For SampleHistory / HistoryRing (telemetry graph history)
+#include "battle_groups.h"      // For BattleGroups (getBattleGroups output)
 
 // Forward declarations
 struct XInputData;
@@ -295,6 +298,7 @@ struct CallbackTimingEntry {
     long long totalTimeUs;      // Accumulated time this frame (microseconds)
     long long peakTimeUs;       // Peak single-call time over measurement window
     int callCount;              // Number of calls this frame
+    LatencyHistogram latency;   // Every call this session (per-call us)
 
     CallbackTimingEntry() : totalTimeUs(0), peakTimeUs(0), callCount(0) {
         name[0] = '\0';
@@ -306,6 +310,7 @@ struct HudTimingEntry {
     char name[24];              // HUD name (e.g., "Standings", "Map")
     long long lastRebuildTimeUs; // Duration of last rebuildRenderData() call
     int rebuildCount;           // Number of rebuilds over measurement window
+    LatencyHistogram latency;   // Every rebuild this session (us)
 
     HudTimingEntry() : lastRebuildTimeUs(0), rebuildCount(0) {
         name[0] = '\0';
@@ -330,6 +335,7 @@ struct BenchmarkMetrics {
     long long collectRenderTimeUs = 0;  // Time spent in collectRenderData()
     int totalQuads = 0;                 // Total quads rendered this frame
     int totalStrings = 0;               // Total strings rendered this frame
+    long long frameBytesMoved = 0;      // Render-pipeline bytes written this frame (collect + expand + copies)
 
     // Active flag - when false, timing macros skip per-callback recording
     bool active = false;
@@ -345,6 +351,21 @@ struct BenchmarkMetrics {
         collectRenderTimeUs = 0;
         totalQuads = 0;
         totalStrings = 0;
+        frameBytesMoved = 0;
+    }
+
+    // New session: drop the latency histograms and window counters but keep the
+    // registrations (callback timers and HUDs hold their indices for the process).
+    void resetSession() {
+        reset();
+        for (int i = 0; i < callbackCount; ++i) {
+            callbacks[i].peakTimeUs = 0;
+            callbacks[i].latency.reset();
+        }
+        for (int i = 0; i < hudCount; ++i) {
+            huds[i].rebuildCount = 0;
+            huds[i].latency.reset();
+        }
     }
 
     // Register a callback slot (returns index, -1 if full)
@@ -371,6 +392,7 @@ struct BenchmarkMetrics {
         if (timeUs > callbacks[index].peakTimeUs) {
             callbacks[index].peakTimeUs = timeUs;
         }
+        callbacks[index].latency.record(timeUs);
     }
 
     // Record a HUD rebuild timing
@@ -378,6 +400,7 @@ struct BenchmarkMetrics {
         if (index < 0 || index >= hudCount) return;
         huds[index].lastRebuildTimeUs = timeUs;
         huds[index].rebuildCount++;
+        huds[index].latency.record(timeUs);
     }
 };
 
@@ -448,7 +471,9 @@ struct InputTelemetryData {
                            xinputConnected(false) {}
 };
 
-// History buffers for graphing telemetry and input data over time
+// History buffers for graphing telemetry and input data over time. Fixed-size
+// rings (core/history_ring.h): pushed at telemetry rate without allocating, read
+// by the graphs in place.
 struct HistoryBuffers {
     // Stick sample with X and Y position (used for both sticks)
     struct StickSample {
@@ -459,38 +484,33 @@ struct HistoryBuffers {
         StickSample(float _x, float _y) : x(_x), y(_y) {}
     };
 
-    // History buffers (newest at back, oldest at front)
-    std::deque<float> throttle;
-    std::deque<float> frontBrake;
-    std::deque<float> rearBrake;
-    std::deque<float> clutch;
-    std::deque<float> steer;
-    std::deque<float> rpm;               // Engine RPM (normalized 0-1 range)
-    std::deque<float> gear;              // Current gear (normalized 0-1 range, gear/numberOfGears)
-    std::deque<float> frontSusp;         // Front suspension compression (normalized 0-1 range)
-    std::deque<float> rearSusp;          // Rear suspension compression (normalized 0-1 range)
-    std::deque<StickSample> leftStick;   // Left analog stick (steering/throttle)
-    std::deque<StickSample> rightStick;  // Right analog stick (rider lean)
-
     // History configuration (time depends on telemetry rate set in plugin_manager.cpp)
     // At 100Hz physics rate: 200 samples = 2 seconds of data for telemetry graphs
     static constexpr size_t MAX_TELEMETRY_HISTORY = 200;
     // At 100Hz physics rate: 50 samples = 500ms of data for stick trails
     static constexpr size_t MAX_STICK_HISTORY = 50;
-
-    // Add sample to history buffer
-    void addSample(std::deque<float>& buffer, float value) {
-        buffer.push_back(value);
-        if (buffer.size() > MAX_TELEMETRY_HISTORY) {
-            buffer.pop_front();
-        }
+    using StickHistory = HistoryRing<StickSample, 64>;
+
+    // History buffers (oldest first, newest at back())
+    SampleHistory throttle{MAX_TELEMETRY_HISTORY};
+    SampleHistory frontBrake{MAX_TELEMETRY_HISTORY};
+    SampleHistory rearBrake{MAX_TELEMETRY_HISTORY};
+    SampleHistory clutch{MAX_TELEMETRY_HISTORY};
+    SampleHistory steer{MAX_TELEMETRY_HISTORY};
+    SampleHistory rpm{MAX_TELEMETRY_HISTORY};          // Engine RPM (normalized 0-1 range)
+    SampleHistory gear{MAX_TELEMETRY_HISTORY};         // Current gear (normalized 0-1 range, gear/numberOfGears)
+    SampleHistory frontSusp{MAX_TELEMETRY_HISTORY};    // Front suspension compression (normalized 0-1 range)
+    SampleHistory rearSusp{MAX_TELEMETRY_HISTORY};     // Rear suspension compression (normalized 0-1 range)
+    StickHistory leftStick{MAX_STICK_HISTORY};   // Left analog stick (steering/throttle)
+    StickHistory rightStick{MAX_STICK_HISTORY};  // Right analog stick (rider lean)
+
+    // Add sample to history buffer (the oldest drops out once the window is full)
+    void addSample(SampleHistory& buffer, float value) {
+        buffer.push(value);
     }
 
-    void addStickSample(std::deque<StickSample>& buffer, float x, float y) {
-        buffer.emplace_back(x, y);
-        if (buffer.size() > MAX_STICK_HISTORY) {
-            buffer.pop_front();
-        }
+    void addStickSample(StickHistory& buffer, float x, float y) {
+        buffer.push(StickSample(x, y));
     }
 
     void clear() {
@@ -1007,9 +1027,10 @@ public:
     // stable, unlike realTimeGap which flickers with the active-track-pos batch) is
     // > 0 and <= gapThresholdMs are greedily chained into a group (front rider first).
     // maxLeaderPos > 0 drops groups
-    // whose front rider is beyond that position (0 = no limit). Returns groups of race
-    // numbers; only groups of 2+ riders are returned.
-    std::vector<std::vector<int>> getBattleGroups(int gapThresholdMs, int maxLeaderPos) const;
+    // whose front rider is beyond that position (0 = no limit). Refills `out` (a
+    // caller-owned flat buffer, see battle_groups.h) with groups of race numbers;
+    // only groups of 2+ riders are returned.
+    void getBattleGroups(int gapThresholdMs, int maxLeaderPos, BattleGroups& out) const;
 
     // Display classification: official order with optional DNS filtering
     const std::vector<int>& getDisplayClassificationOrder() const;
@@ -1388,6 +1409,19 @@ public:
     void addEventLogEntry(EventLogType type, const char* message, const char* detail = nullptr, int iconColorSlot = -1);
     const std::deque<EventLogEntry>& getEventLog() const { return m_eventLog; }
 
+    // ========================================================================
+    // State keyframes (see plugin_data_keyframe.cpp)
+    // ========================================================================
+    // The race state (session, entries, standings, lap logs, leader timing points,
+    // track positions, event log) as one self-contained blob, so a tape replay can
+    // start mid-session from the nearest keyframe instead of re-applying every
+    // earlier callback. Telemetry, the segment timer and settings are not part of it.
+    // writeKeyframe replaces out's contents (reusing its capacity). restoreKeyframe
+    // replaces the race state wholesale; on a truncated or foreign blob it returns
+    // false and leaves the state cleared.
+    void writeKeyframe(std::vector<uint8_t>& out) const;
+    bool restoreKeyframe(const uint8_t* data, size_t size);
+
 private:
     PluginData() : m_currentSessionTime(0), m_playerRaceNum(-1), m_bPlayerRaceNumValid(false),
                    m_bPlayerNotFoundWarned(false), m_bWaitingForPlayerEntry(false),
@@ -1438,8 +1472,24 @@ private:
     std::unordered_map<int, int> m_lastValidOfficialGap;  // Cache of last valid official gap per rider (prevents flicker)
     std::vector<int> m_classificationOrder;  // Official race position order from game
     int m_lastLeaderRaceNum = -1;  // Previous race leader (for leader change detection, race sessions only)
-    mutable std::unordered_map<int, int> m_positionCache;  // Cached position lookup (race number -> position), rebuilt when classification changes
+
+    // Race number -> 1-based position, rebuilt from a classification order. A flat
+    // vector sorted by race number rather than a hash map: a rebuild reuses the
+    // capacity, so the per-classification refresh stops allocating once the field
+    // is known, and a 50-rider binary search beats hashing anyway.
+    struct PositionLookup {
+        std::vector<std::pair<int, int>> entries;  // (raceNum, position)
+        void rebuild(const std::vector<int>& order);
+        int find(int raceNum) const;               // -1 when absent
+        void clear() { entries.clear(); }
+    };
+    mutable PositionLookup m_positionCache;  // Cached position lookup (race number -> position), rebuilt when classification changes
     mutable bool m_bPositionCacheDirty;  // Flag to rebuild position cache
+
+    // getBattleGroups() scratch: the racing, on-track field in position order. Kept
+    // so the per-call sort reuses its capacity.
+    struct BattleCandidate { int pos; int raceNum; int gap; int gapLaps; };
+    mutable std::vector<BattleCandidate> m_battleCandidates;
     std::unordered_map<int, int> m_raceStartPositions;  // raceNum -> official starting position (1-based), snapshotted at race green flag
     std::unordered_map<int, int> m_lastSfPositions;     // raceNum -> position at last start/finish crossing (rolling, "Since S/F" mode)
     std::unordered_map<int, int> m_lastSplitPositions;  // raceNum -> position at last split crossing (rolling, "Since split" mode)
@@ -1450,7 +1500,7 @@ private:
 
     // DNS-filtered cache (derived from official classification order, rebuilt when dirty)
     mutable std::vector<int> m_filteredClassificationOrder;
-    mutable std::unordered_map<int, int> m_filteredPositionCache;
+    mutable PositionLookup m_filteredPositionCache;
     mutable bool m_bFilteredOrderDirty = true;
 
     std::unordered_map<int, TrackPositionData> m_trackPositions;  // Real-time track positions
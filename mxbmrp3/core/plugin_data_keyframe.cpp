@@ -0,0 +1,424 @@
+// ============================================================================
+// core/plugin_data_keyframe.cpp
+// State keyframes: PluginData's race state written to one blob and restored from
+// it. The recorder embeds one in the tape every few seconds
+// (Recording::EventType::StateKeyframe); the integration harness restores the
+// nearest one to start a replay mid-session (PluginHost::replayTapeFrom).
+//
+// Layout: magic + version, then the sections in the order writeKeyframe() emits
+// them. Every struct goes field by field through one field list that serves both
+// directions (sessionFields, standingsFields, ...), so the blob doesn't depend on
+// struct layout or padding and identical state gives identical bytes. Integers
+// and floats are stored as in memory (little-endian, like the tapes), strings as
+// a length + bytes, containers as a count + elements.
+//
+// Clocks (in the clock's own ticks): a steady_clock point is stored as its age at
+// capture and restored relative to now, so a running timer (lap timer anchor,
+// hazard/notice timers) keeps running; a default (epoch) point means "inactive"
+// and stays that way. system_clock points (event log wall time) are stored as is.
+//
+// MAINTENANCE: a new race-state member, or a field added to one of the structs
+// below, goes into its field list here; bump KEYFRAME_VERSION whenever the byte
+// layout changes (restore refuses other versions, it doesn't migrate - the tape's
+// callbacks are the archive, keyframes only accelerate replaying them).
+// ============================================================================
+
+#include "plugin_data.h"
+#include "plugin_utils.h"
+#include "rumble_profile_manager.h"
+#include "../diagnostics/logger.h"
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+constexpr char KEYFRAME_MAGIC[8] = { 'M', 'X', 'B', 'K', 'E', 'Y', '\0', '\0' };
+constexpr uint32_t KEYFRAME_VERSION = 1;
+constexpr int64_t CLOCK_INACTIVE = INT64_MIN;
+
+using SteadyPoint = std::chrono::steady_clock::time_point;
+using SystemPoint = std::chrono::system_clock::time_point;
+
+// Appends fields to a keyframe.
+class KeyframeOut {
+public:
+    KeyframeOut(std::vector<uint8_t>& out, SteadyPoint now) : m_out(out), m_now(now) {}
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type operator()(const T& v) { raw(&v, sizeof(v)); }
+    template <size_t N>
+    void operator()(const char (&s)[N]) {
+        const uint16_t len = static_cast<uint16_t>(strnlen(s, N - 1));
+        (*this)(len);
+        raw(s, len);
+    }
+    void operator()(const SteadyPoint& t) {
+        (*this)(t == SteadyPoint{} ? CLOCK_INACTIVE : static_cast<int64_t>((m_now - t).count()));
+    }
+    void operator()(const SystemPoint& t) { (*this)(static_cast<int64_t>(t.time_since_epoch().count())); }
+    void operator()(const HazardType& h) { (*this)(static_cast<int32_t>(h)); }
+    void operator()(const EventLogType& e) { (*this)(static_cast<uint8_t>(e)); }
+    void count(size_t n) { (*this)(static_cast<uint32_t>(n)); }
+    void raw(const void* p, size_t n) {
+        const uint8_t* b = static_cast<const uint8_t*>(p);
+        m_out.insert(m_out.end(), b, b + n);
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    SteadyPoint m_now;
+};
+
+// Reads fields back. Once a read runs past the end every later one reads zero and
+// ok() stays false, so the sections parse straight through and get checked once.
+class KeyframeIn {
+public:
+    KeyframeIn(const uint8_t* data, size_t size, SteadyPoint now) : m_p(data), m_left(size), m_now(now) {}
+
+    bool ok() const { return m_ok; }
+    size_t left() const { return m_left; }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type operator()(T& v) {
+        v = T{};
+        raw(&v, sizeof(v));
+    }
+    template <size_t N>
+    void operator()(char (&s)[N]) {
+        uint16_t len = 0;
+        (*this)(len);
+        if (len > N - 1) { m_ok = false; len = 0; }
+        raw(s, len);
+        s[m_ok ? len : 0] = '\0';
+    }
+    void operator()(SteadyPoint& t) {
+        int64_t age = CLOCK_INACTIVE;
+        (*this)(age);
+        t = age == CLOCK_INACTIVE ? SteadyPoint{} : m_now - SteadyPoint::duration(age);
+    }
+    void operator()(SystemPoint& t) {
+        int64_t ticks = 0;
+        (*this)(ticks);
+        t = SystemPoint(SystemPoint::duration(ticks));
+    }
+    void operator()(HazardType& h) {
+        int32_t v = 0;
+        (*this)(v);
+        h = static_cast<HazardType>(v);
+    }
+    void operator()(EventLogType& e) {
+        uint8_t v = 0;
+        (*this)(v);
+        e = static_cast<EventLogType>(v);
+    }
+    // An element count; refused when even one byte per element couldn't follow.
+    size_t count() {
+        uint32_t n = 0;
+        (*this)(n);
+        if (n > m_left) { m_ok = false; return 0; }
+        return n;
+    }
+    void raw(void* p, size_t n) {
+        if (!m_ok || n > m_left) { m_ok = false; return; }
+        std::memcpy(p, m_p, n);
+        m_p += n;
+        m_left -= n;
+    }
+
+private:
+    const uint8_t* m_p;
+    size_t m_left;
+    SteadyPoint m_now;
+    bool m_ok = true;
+};
+
+// ---------------------------------------------------------------------------
+// Field lists (S is the struct, const when writing)
+// ---------------------------------------------------------------------------
+
+// sessionGeneration is left out on purpose: it's this process's own counter, and
+// the restore already bumps it (clear()), which is what its consumers key on.
+template <typename F, typename S>
+void sessionFields(F& f, S& s) {
+    f(s.riderName); f(s.bikeName); f(s.category); f(s.trackId); f(s.trackName);
+    f(s.trackLength); f(s.eventType); f(s.serverType); f(s.serverName);
+    f(s.shiftRPM); f(s.limiterRPM); f(s.steerLock);
+    f(s.engineOptTemperature); f(s.engineTempAlarmLow); f(s.engineTempAlarmHigh);
+    f(s.session); f(s.sessionSeries); f(s.sessionState); f(s.sessionLength); f(s.sessionNumLaps);
+    f(s.conditions); f(s.airTemperature); f(s.trackTemperature); f(s.setupFileName);
+    f(s.overtimeStarted); f(s.finishLap); f(s.lastSessionTime); f(s.leaderFinishTime);
+    f(s.sessionTimeExpired);
+}
+
+template <typename F, typename S>
+void standingsFields(F& f, S& s) {
+    f(s.raceNum); f(s.state); f(s.bestLap); f(s.bestLapNum); f(s.numLaps);
+    f(s.gap); f(s.gapLaps); f(s.realTimeGap); f(s.penalty); f(s.pit);
+    f(s.finishTime); f(s.numLapsAtLeaderFinish); f(s.sessionFinished);
+}
+
+template <typename F, typename S>
+void trackPositionFields(F& f, S& s) {
+    f(s.trackPos); f(s.numLaps); f(s.sessionTime); f(s.crashed);
+    f(s.previousTrackPos); f(s.wrongWay); f(s.wrongWaySince);
+    f(s.lastSignificantTrackPos); f(s.stationarySince); f(s.hazardClearedAt);
+    f(s.hazardType); f(s.hazardConfirmed); f(s.pitExitGraceStart); f(s.movedSincePitExit);
+    f(s.sessionCrashCount); f(s.prevCrashedState);
+}
+
+template <typename F, typename S>
+void currentLapFields(F& f, S& s) {
+    f(s.lapNum); f(s.split1); f(s.split2); f(s.split3);
+}
+
+template <typename F, typename S>
+void idealLapFields(F& f, S& s) {
+    f(s.lastCompletedLapNum); f(s.lastLapTime);
+    f(s.lastLapSector1); f(s.lastLapSector2); f(s.lastLapSector3); f(s.lastLapSector4);
+    f(s.bestSector1); f(s.bestSector2); f(s.bestSector3); f(s.bestSector4);
+    f(s.previousBestLapTime);
+    f(s.previousBestSector1); f(s.previousBestSector2); f(s.previousBestSector3); f(s.previousBestSector4);
+    f(s.previousIdealSector1); f(s.previousIdealSector2); f(s.previousIdealSector3); f(s.previousIdealSector4);
+}
+
+template <typename F, typename S>
+void lapLogFields(F& f, S& s) {
+    f(s.lapNum); f(s.sector1); f(s.sector2); f(s.sector3); f(s.sector4);
+    f(s.lapTime); f(s.isValid); f(s.isComplete);
+}
+
+template <typename F, typename S>
+void lapTimerFields(F& f, S& s) {
+    f(s.anchorTime); f(s.anchorAccumulatedTime); f(s.anchorValid);
+    f(s.pausedAt); f(s.isPaused);
+    f(s.lastTrackPos); f(s.lastLapNum); f(s.trackMonitorInitialized);
+    f(s.currentLapNum); f(s.currentSector); f(s.lastSplit1Time); f(s.lastSplit2Time);
+    f(s.anchoredFromRaceStart);
+}
+
+template <typename F, typename S>
+void eventLogFields(F& f, S& s) {
+    f(s.type); f(s.sessionTimeMs); f(s.steadyTime); f(s.systemTime);
+    f(s.message); f(s.detail); f(s.iconColorSlot);
+}
+
+// ---------------------------------------------------------------------------
+// Containers
+// ---------------------------------------------------------------------------
+
+void writeIntMap(KeyframeOut& out, const std::unordered_map<int, int>& m) {
+    out.count(m.size());
+    for (const auto& kv : m) { out(kv.first); out(kv.second); }
+}
+
+void readIntMap(KeyframeIn& in, std::unordered_map<int, int>& m) {
+    for (size_t n = in.count(); n > 0 && in.ok(); --n) {
+        int k = 0, v = 0;
+        in(k); in(v);
+        m[k] = v;
+    }
+}
+
+template <typename T>
+void writeMap(KeyframeOut& out, const std::unordered_map<int, T>& m, void (*fields)(KeyframeOut&, const T&)) {
+    out.count(m.size());
+    for (const auto& kv : m) { out(kv.first); fields(out, kv.second); }
+}
+
+template <typename T>
+void readMap(KeyframeIn& in, std::unordered_map<int, T>& m, void (*fields)(KeyframeIn&, T&)) {
+    for (size_t n = in.count(); n > 0 && in.ok(); --n) {
+        int k = 0;
+        in(k);
+        fields(in, m[k]);
+    }
+}
+
+template <typename T>
+void writeVector(KeyframeOut& out, const std::vector<T>& v) {
+    out.count(v.size());
+    for (const T& x : v) out(x);
+}
+
+template <typename T>
+void readVector(KeyframeIn& in, std::vector<T>& v) {
+    v.resize(in.count());
+    for (T& x : v) in(x);
+}
+
+} // namespace
+
+void PluginData::writeKeyframe(std::vector<uint8_t>& out) const {
+    out.clear();
+    KeyframeOut w(out, std::chrono::steady_clock::now());
+    w.raw(KEYFRAME_MAGIC, sizeof(KEYFRAME_MAGIC));
+    w(KEYFRAME_VERSION);
+
+    sessionFields(w, m_sessionData);
+
+    w.count(m_raceEntries.size());
+    for (const auto& kv : m_raceEntries) {
+        w(kv.second.raceNum);
+        w(kv.second.name);
+        w(kv.second.bikeName);
+    }
+
+    writeMap(w, m_standings, standingsFields<KeyframeOut, const StandingsData>);
+    writeIntMap(w, m_lastValidOfficialGap);
+    writeVector(w, m_classificationOrder);
+    w(m_lastLeaderRaceNum);
+    writeIntMap(w, m_raceStartPositions);
+    writeIntMap(w, m_lastSfPositions);
+    writeIntMap(w, m_lastSplitPositions);
+
+    writeMap(w, m_trackPositions, trackPositionFields<KeyframeOut, const TrackPositionData>);
+    w.count(m_activeTrackPosRiders.size());
+    for (int raceNum : m_activeTrackPosRiders) w(raceNum);
+
+    writeMap(w, m_riderCurrentLap, currentLapFields<KeyframeOut, const CurrentLapData>);
+    writeMap(w, m_riderIdealLap, idealLapFields<KeyframeOut, const IdealLapData>);
+    w.count(m_riderLapLog.size());
+    for (const auto& kv : m_riderLapLog) {
+        w(kv.first);
+        w.count(kv.second.size());
+        for (const LapLogEntry& e : kv.second) lapLogFields(w, e);
+    }
+    writeMap(w, m_riderBestLap, lapLogFields<KeyframeOut, const LapLogEntry>);
+    lapLogFields(w, m_overallBestLap);
+    lapLogFields(w, m_previousOverallBestLap);
+
+    lapTimerFields(w, m_displayLapTimer);
+    w(m_displayLapTimerRaceNum);
+    w(m_awaitingGateDrop);
+    w(m_gateDropSawHold);
+
+    w.count(m_leaderTimingPoints.size());
+    for (const auto& kv : m_leaderTimingPoints) {
+        w(kv.first);
+        for (const LeaderTimingPoint& p : kv.second) { w(p.sessionTime); w(p.lapNum); }
+    }
+
+    w(m_currentSessionTime);
+    w(m_iPendingPlayerRaceNum);
+    w(m_bWaitingForPlayerEntry);
+    w(m_bPlayerIsRunning);
+    w(m_drawState);
+    w(m_spectatedRaceNum);
+    w(m_liveGapMs);
+    w(m_liveGapValid);
+    w(m_newSessionPB); w(m_sessionPBTime);
+    w(m_newFastestLap); w(m_fastestLapTime);
+    w(m_newAllTimePB); w(m_allTimePBTime);
+    w(m_newDefaultSetup); w(m_defaultSetupTime);
+    writeVector(w, m_splitPositions);
+
+    w.count(m_eventLog.size());
+    for (const EventLogEntry& e : m_eventLog) eventLogFields(w, e);
+}
+
+bool PluginData::restoreKeyframe(const uint8_t* data, size_t size) {
+    // Start from a cleared store: everything a keyframe doesn't carry (telemetry,
+    // segment timer, derived caches) reads as after an event exit.
+    clear();
+
+    KeyframeIn r(data, size, std::chrono::steady_clock::now());
+    char magic[sizeof(KEYFRAME_MAGIC)] = {};
+    uint32_t version = 0;
+    r.raw(magic, sizeof(magic));
+    r(version);
+    if (!r.ok() || std::memcmp(magic, KEYFRAME_MAGIC, sizeof(magic)) != 0 || version != KEYFRAME_VERSION) {
+        DEBUG_WARN_F("Keyframe: not a v%u state keyframe (%zu bytes), ignored", KEYFRAME_VERSION, size);
+        return false;
+    }
+
+    sessionFields(r, m_sessionData);
+
+    for (size_t n = r.count(); n > 0 && r.ok(); --n) {
+        int raceNum = -1;
+        char name[sizeof(RaceEntryData::name)] = {};
+        char bikeName[sizeof(RaceEntryData::bikeName)] = {};
+        r(raceNum); r(name); r(bikeName);
+        m_raceEntries[raceNum] = RaceEntryData(raceNum, name, bikeName,
+            PluginUtils::getBikeAbbreviationPtr(bikeName), PluginUtils::getBikeBrandName(bikeName),
+            PluginUtils::getBikeBrandColor(bikeName));
+    }
+
+    readMap(r, m_standings, standingsFields<KeyframeIn, StandingsData>);
+    readIntMap(r, m_lastValidOfficialGap);
+    readVector(r, m_classificationOrder);
+    r(m_lastLeaderRaceNum);
+    readIntMap(r, m_raceStartPositions);
+    readIntMap(r, m_lastSfPositions);
+    readIntMap(r, m_lastSplitPositions);
+
+    readMap(r, m_trackPositions, trackPositionFields<KeyframeIn, TrackPositionData>);
+    for (size_t n = r.count(); n > 0 && r.ok(); --n) {
+        int raceNum = -1;
+        r(raceNum);
+        m_activeTrackPosRiders.insert(raceNum);
+    }
+
+    readMap(r, m_riderCurrentLap, currentLapFields<KeyframeIn, CurrentLapData>);
+    readMap(r, m_riderIdealLap, idealLapFields<KeyframeIn, IdealLapData>);
+    for (size_t n = r.count(); n > 0 && r.ok(); --n) {
+        int raceNum = -1;
+        r(raceNum);
+        std::deque<LapLogEntry>& log = m_riderLapLog[raceNum];
+        log.resize(r.count());
+        for (LapLogEntry& e : log) lapLogFields(r, e);
+    }
+    readMap(r, m_riderBestLap, lapLogFields<KeyframeIn, LapLogEntry>);
+    lapLogFields(r, m_overallBestLap);
+    lapLogFields(r, m_previousOverallBestLap);
+
+    lapTimerFields(r, m_displayLapTimer);
+    r(m_displayLapTimerRaceNum);
+    r(m_awaitingGateDrop);
+    r(m_gateDropSawHold);
+
+    for (size_t n = r.count(); n > 0 && r.ok(); --n) {
+        int lap = 0;
+        r(lap);
+        for (LeaderTimingPoint& p : m_leaderTimingPoints[lap]) { r(p.sessionTime); r(p.lapNum); }
+    }
+
+    r(m_currentSessionTime);
+    r(m_iPendingPlayerRaceNum);
+    r(m_bWaitingForPlayerEntry);
+    r(m_bPlayerIsRunning);
+    r(m_drawState);
+    r(m_spectatedRaceNum);
+    r(m_liveGapMs);
+    r(m_liveGapValid);
+    r(m_newSessionPB); r(m_sessionPBTime);
+    r(m_newFastestLap); r(m_fastestLapTime);
+    r(m_newAllTimePB); r(m_allTimePBTime);
+    r(m_newDefaultSetup); r(m_defaultSetupTime);
+    readVector(r, m_splitPositions);
+
+    for (size_t n = r.count(); n > 0 && r.ok(); --n) {
+        m_eventLog.emplace_back();
+        eventLogFields(r, m_eventLog.back());
+    }
+
+    if (!r.ok() || r.left() != 0) {
+        DEBUG_WARN_F("Keyframe: truncated or malformed (%zu bytes, %zu unread), state cleared", size, r.left());
+        clear();
+        return false;
+    }
+
+    RumbleProfileManager::getInstance().setCurrentBike(m_sessionData.bikeName);
+
+    // Everything changed at once: let every consumer rebuild.
+    notifyHudManager(DataChangeType::SessionData);
+    notifyHudManager(DataChangeType::RaceEntries);
+    notifyHudManager(DataChangeType::Standings);
+    notifyHudManager(DataChangeType::IdealLap);
+    notifyHudManager(DataChangeType::LapLog);
+    notifyHudManager(DataChangeType::SpectateTarget);
+    notifyHudManager(DataChangeType::EventLog);
+
+    DEBUG_INFO_F("Keyframe restored: %zu bytes, %zu entries, session time %d ms",
+                 size, m_raceEntries.size(), m_currentSessionTime);
+    return true;
+}
@@ -22,6 +22,7 @@
 #include "../diagnostics/logger.h"
 #include "../diagnostics/timer.h"
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstring>
 
@@ -333,31 +334,40 @@ void PluginData::setClassificationOrder(const std::vector<int>& order) {
 int PluginData::getPositionForRaceNum(int raceNum) const {
     // Rebuild cache if dirty (only happens when classification changes)
     if (m_bPositionCacheDirty) {
-        m_positionCache.clear();
-
         // Build position cache from classification order
         // Position is simply the index in classification order (1-based)
         // This matches how StandingsHud calculates positions
-        for (size_t i = 0; i < m_classificationOrder.size(); ++i) {
-            m_positionCache[m_classificationOrder[i]] = static_cast<int>(i) + 1;
-        }
+        m_positionCache.rebuild(m_classificationOrder);
         m_bPositionCacheDirty = false;
     }
 
-    // Lookup position in cache (O(1) operation)
-    auto it = m_positionCache.find(raceNum);
-    if (it != m_positionCache.end()) {
-        return it->second;
+    return m_positionCache.find(raceNum);  // -1 = not found in standings
+}
+
+void PluginData::PositionLookup::rebuild(const std::vector<int>& order) {
+    entries.clear();
+    for (size_t i = 0; i < order.size(); ++i) {
+        entries.emplace_back(order[i], static_cast<int>(i) + 1);
+    }
+    std::sort(entries.begin(), entries.end());
+}
+
+int PluginData::PositionLookup::find(int raceNum) const {
+    // A race number listed twice resolves to its last (highest) position, as the
+    // map it replaces did (later writes won).
+    auto it = std::upper_bound(entries.begin(), entries.end(), std::make_pair(raceNum, INT_MAX));
+    if (it == entries.begin() || (it - 1)->first != raceNum) {
+        return -1;
     }
-    return -1;  // Not found in standings
+    return (it - 1)->second;
 }
 
-std::vector<std::vector<int>> PluginData::getBattleGroups(int gapThresholdMs, int maxLeaderPos) const {
+void PluginData::getBattleGroups(int gapThresholdMs, int maxLeaderPos, BattleGroups& out) const {
+    out.clear();
     // Build the racing, on-track field ordered by position, each rider carrying its
     // official split gap to the leader (stable; see the gap-source note below).
-    struct R { int pos; int raceNum; int gap; int gapLaps; };
-    std::vector<R> rs;
-    rs.reserve(m_standings.size());
+    std::vector<BattleCandidate>& rs = m_battleCandidates;
+    rs.clear();
     // Defer battles during the opening lap of a race: off the start the whole field is
     // bunched nose-to-tail and "everyone is battling", so gap-based groups there are just
     // noise. A rider still on their first lap (numLaps == 0) is left out of the grouping;
@@ -385,9 +395,9 @@ std::vector<std::vector<int>> PluginData::getBattleGroups(int gapThresholdMs, in
         int g = s.gap;
         rs.push_back({ pos, s.raceNum, g, s.gapLaps });
     }
-    std::sort(rs.begin(), rs.end(), [](const R& a, const R& b) { return a.pos < b.pos; });
+    std::sort(rs.begin(), rs.end(),
+              [](const BattleCandidate& a, const BattleCandidate& b) { return a.pos < b.pos; });
 
-    std::vector<std::vector<int>> groups;
     size_t i = 0;
     while (i < rs.size()) {
         size_t j = i;
@@ -400,17 +410,14 @@ std::vector<std::vector<int>> PluginData::getBattleGroups(int gapThresholdMs, in
         }
         if (j > i) {
             if (maxLeaderPos <= 0 || rs[i].pos <= maxLeaderPos) {
-                std::vector<int> grp;
-                grp.reserve(j - i + 1);
-                for (size_t k = i; k <= j; ++k) grp.push_back(rs[k].raceNum);
-                groups.push_back(std::move(grp));
+                for (size_t k = i; k <= j; ++k) out.riders.push_back(rs[k].raceNum);
+                out.endGroup();
             }
             i = j + 1;
         } else {
             i = i + 1;
         }
     }
-    return groups;
 }
 
 void PluginData::snapshotRaceStartPositions() {
@@ -464,10 +471,7 @@ const std::vector<int>& PluginData::getDisplayClassificationOrder() const {
             }
         }
         // Also rebuild filtered position cache
-        m_filteredPositionCache.clear();
-        for (size_t i = 0; i < m_filteredClassificationOrder.size(); ++i) {
-            m_filteredPositionCache[m_filteredClassificationOrder[i]] = static_cast<int>(i) + 1;
-        }
+        m_filteredPositionCache.rebuild(m_filteredClassificationOrder);
         m_bFilteredOrderDirty = false;
     }
 
@@ -479,11 +483,7 @@ int PluginData::getDisplayPositionForRaceNum(int raceNum) const {
     if (m_filterDnsRiders) {
         // Ensure filtered order is up to date (rebuilds caches if dirty)
         getDisplayClassificationOrder();
-        auto it = m_filteredPositionCache.find(raceNum);
-        if (it != m_filteredPositionCache.end()) {
-            return it->second;
-        }
-        return -1;  // DNS rider filtered out, or not found
+        return m_filteredPositionCache.find(raceNum);  // -1 = DNS rider filtered out, or not found
     }
 
     return getPositionForRaceNum(raceNum);
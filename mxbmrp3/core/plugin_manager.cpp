@@ -8,6 +8,8 @@
 #include "plugin_utils.h"
 #include "../diagnostics/logger.h"
 #include "../diagnostics/timer.h"
+#include "../diagnostics/tracer.h"
+#include "../diagnostics/alloc_counter.h"
 #include "hud_manager.h"
 #include "input_manager.h"
 #include "hotkey_manager.h"
@@ -59,7 +61,9 @@
 using namespace PluginConstants;
 
 // RAII helper macro to automatically measure and accumulate callback execution time
-// Also records per-callback timing for the benchmark widget when active
+// Also records per-callback timing for the benchmark widget when active, a
+// trace event (diagnostics/tracer.h) while a capture is running, and charges
+// heap allocations to the callback phase (diagnostics/alloc_counter.h)
 // Usage: Add ACCUMULATE_CALLBACK_TIME(name) at the start of any plugin callback
 #define ACCUMULATE_CALLBACK_TIME_NAMED(callbackName) \
     static int _cbIdx = -1; \
@@ -77,7 +81,9 @@ using namespace PluginConstants;
             auto& bm = PluginData::getInstance().getBenchmarkMetrics(); \
             if (bm.active && _idx >= 0) { bm.recordCallback(_idx, elapsed); } \
         } \
-    } _cbtimer(_cbIdx)
+    } _cbtimer(_cbIdx); \
+    TRACE_SCOPE(callbackName); \
+    ALLOC_PHASE(AllocCounter::Phase::GAME_CALLBACK)
 
 // Backward-compatible version (no per-callback recording)
 #define ACCUMULATE_CALLBACK_TIME() \
@@ -131,6 +137,12 @@ void PluginManager::initialize(const char* savePath) {
     EventRecorder::getInstance().beginSessionRecording(savePath);
 #endif
 
+    // [Trace] enabled=1: capture the timeline from launch (written at shutdown or
+    // on the TOGGLE_TRACE hotkey). Off by default.
+    if (Tracer::getInstance().getCaptureAtStartup()) {
+        Tracer::getInstance().start();
+    }
+
 #if GAME_HAS_DISCORD
     // Initialize Discord Rich Presence (runs in background thread)
     DiscordManager::getInstance().initialize();
@@ -217,6 +229,11 @@ void PluginManager::shutdown() {
     m_bShutdown = true;
     DEBUG_INFO("PluginManager shutdown");
 
+    // Write out a running trace capture while the threads it describes still exist,
+    // and let the writer finish before the process goes away.
+    Tracer::getInstance().stop(m_savePath);
+    Tracer::getInstance().waitForWrite();
+
     // Stop the plugin worker thread FIRST (before any singleton it touches is torn
     // down). stop() joins it and then drains any still-queued callbacks inline, so
     // PluginData is consistent for the stats/settings saves below. No-op if off.
@@ -284,6 +301,7 @@ void PluginManager::shutdown() {
 }
 
 int PluginManager::handleStartup(const char* savePath) {
+    TRACE_SCOPE("Startup");
     // Safety: Check for null pointer from API
     if (savePath != nullptr) {
         strncpy_s(m_savePath, sizeof(m_savePath), savePath, sizeof(m_savePath) - 1);
@@ -317,6 +335,7 @@ int PluginManager::handleStartup(const char* savePath) {
 
 void PluginManager::handleShutdown() {
     SCOPED_TIMER_THRESHOLD("Plugin::handleShutdown", 1000);
+    TRACE_SCOPE("Shutdown");
     DEBUG_INFO("=== Shutdown ===");
     shutdown();
     m_savePath[0] = '\0';
@@ -416,6 +435,7 @@ void PluginManager::handleRunTelemetry(Unified::TelemetryData* psTelemetryData)
 
 int PluginManager::handleDrawInit(int* piNumSprites, char** pszSpriteName, int* piNumFonts, char** pszFontName) {
     SCOPED_TIMER_THRESHOLD("Plugin::handleDrawInit", 1000);
+    TRACE_SCOPE("DrawInit");
     DEBUG_INFO("=== Draw Init ===");
 
     // Safety: Check for null pointers from API
@@ -440,6 +460,8 @@ void PluginManager::handleDraw(int iState, int* piNumQuads, void** ppQuad, int*
     // this frame (non-blocking) and hand back the most recently finished, triple-
     // buffered frame. A hiccup on our side can never stall the game's Draw.
     if (pt.enabled()) {
+        TRACE_SCOPE("Draw (handoff)");
+        ALLOC_PHASE(AllocCounter::Phase::DRAW);
         if (piNumQuads == nullptr || ppQuad == nullptr ||
             piNumString == nullptr || ppString == nullptr) {
             return;
@@ -459,6 +481,7 @@ void PluginManager::handleDraw(int iState, int* piNumQuads, void** ppQuad, int*
     }
 
     ACCUMULATE_CALLBACK_TIME_NAMED("Draw");
+    ALLOC_PHASE(AllocCounter::Phase::DRAW);
 
     // Delegate to DrawHandler for performance tracking and rendering
     DrawHandler::getInstance().handleDraw(iState, piNumQuads, ppQuad, piNumString, ppString);
@@ -648,10 +671,12 @@ void PluginManager::handleRaceVehicleData(Unified::RaceVehicleData* psRaceVehicl
 }
 
 int PluginManager::handleSpectateVehicles(int iNumVehicles, Unified::SpectateVehicle* pasVehicleData, int iCurSelection, int* piSelect) {
+    TRACE_SCOPE("SpectateVehicles");
     return SpectateHandler::getInstance().handleSpectateVehicles(iNumVehicles, pasVehicleData, iCurSelection, piSelect);
 }
 
 int PluginManager::handleSpectateCameras(int iNumCameras, void* pCameraData, int iCurSelection, int* piSelect) {
+    TRACE_SCOPE("SpectateCameras");
     return SpectateHandler::getInstance().handleSpectateCameras(iNumCameras, pCameraData, iCurSelection, piSelect);
 }
 
@@ -9,6 +9,8 @@
 #include "plugin_data.h"
 #include "../handlers/draw_handler.h"
 #include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+#include "../diagnostics/alloc_counter.h"
 
 #include <future>
 #ifdef MXBMRP3_TEST_BUILD
@@ -215,6 +217,8 @@ bool PluginThread::takeFrame(const SPluginQuad_t*& quads, int& numQuads,
 }
 
 void PluginThread::buildAndPublishFrame() {
+    TRACE_SCOPE("PluginThread::buildAndPublishFrame");
+    ALLOC_PHASE(AllocCounter::Phase::DRAW);
     HudManager& hud = HudManager::getInstance();
 
     // Run the full update + collect on THIS (worker) thread. produceFrame() owns the
@@ -245,6 +249,10 @@ void PluginThread::buildAndPublishFrame() {
         if (bm.active) {
             bm.totalQuads = static_cast<int>(hud.gameFrameQuads().size());
             bm.totalStrings = static_cast<int>(hud.gameFrameStrings().size());
+            // Plus the copy into the triple-buffer slot below.
+            bm.frameBytesMoved += static_cast<long long>(
+                hud.gameFrameQuads().size() * sizeof(SPluginQuad_t) +
+                hud.gameFrameStrings().size() * sizeof(SPluginString_t));
         }
     }
 
@@ -265,6 +273,7 @@ void PluginThread::buildAndPublishFrame() {
 }
 
 void PluginThread::threadMain() {
+    TRACE_THREAD_NAME("plugin worker");
     while (m_run.load(std::memory_order_acquire)) {
         std::deque<std::function<void()>> batch;
         bool doFrame = false;
@@ -294,9 +303,12 @@ void PluginThread::threadMain() {
         // mid-batch — so already-dequeued commands aren't silently dropped (stop()'s
         // drain only covers what's still in m_queue). Each is individually guarded so
         // one bad command can't kill the worker or skip the rest.
-        for (auto& cmd : batch) {
-            try { if (cmd) cmd(); } catch (...) {
-                DEBUG_ERROR("PluginThread: queued callback threw");
+        if (!batch.empty()) {
+            TRACE_SCOPE("PluginThread::drainQueue");
+            for (auto& cmd : batch) {
+                try { if (cmd) cmd(); } catch (...) {
+                    DEBUG_ERROR("PluginThread: queued callback threw");
+                }
             }
         }
 
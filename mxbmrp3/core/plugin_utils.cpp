@@ -5,6 +5,7 @@
 #include "plugin_utils.h"
 #include "plugin_constants.h"
 #include "plugin_data.h"
+#include "time_format.h"
 #include "../game/game_config.h"
 #include <climits>
 #include <cstdio>
@@ -69,19 +70,14 @@ void PluginUtils::formatSessionClock(int lapsToGo, int sessionTimeMs, char* buff
     }
 }
 
+// The four timing formatters below share the snprintf-free kernel in
+// time_format.h (output byte-identical to the printf formats they replaced).
 void PluginUtils::formatLapTime(int lapTimeMs, char* buffer, size_t bufferSize) {
     if (lapTimeMs >= 0) {
-        using namespace PluginConstants::TimeConversion;
-        int minutes = lapTimeMs / MS_PER_MINUTE;
-        int seconds = (lapTimeMs % MS_PER_MINUTE) / MS_PER_SECOND;
-        int ms = lapTimeMs % MS_PER_SECOND;
-
-        bool compact = PluginData::getInstance().isShortTimeFormat();
-        if (compact && minutes == 0) {
-            snprintf(buffer, bufferSize, "%d.%03d", seconds, ms);
-        } else {
-            snprintf(buffer, bufferSize, "%d:%02d.%03d", minutes, seconds, ms);
-        }
+        char tmp[time_format::MAX_LEN + 1];
+        const size_t len = time_format::write(time_format::Mode::LAP, lapTimeMs,
+                                              PluginData::getInstance().isShortTimeFormat(), tmp);
+        time_format::copyTruncated(tmp, len, buffer, bufferSize);
     }
     else {
         buffer[0] = '\0';
@@ -89,44 +85,21 @@ void PluginUtils::formatLapTime(int lapTimeMs, char* buffer, size_t bufferSize)
 }
 
 void PluginUtils::formatTimeDiff(char* buffer, size_t bufferSize, int diffMs) {
-    using namespace PluginConstants::TimeConversion;
-
-    // Handle sign and protect against INT_MIN overflow
-    char sign = '+';
-    int absDiff = diffMs;
-    if (diffMs < 0) {
-        sign = '-';
-        // Protect against overflow: -INT_MIN would overflow, cap at INT_MAX
-        absDiff = (diffMs == INT_MIN) ? INT_MAX : -diffMs;
-    }
-
-    int minutes = absDiff / MS_PER_MINUTE;
-    int seconds = (absDiff % MS_PER_MINUTE) / MS_PER_SECOND;
-    int ms = absDiff % MS_PER_SECOND;
-
     // Always millisecond precision (matching the game UI and formatLapTime).
     // Short time format only drops the leading "0:" for sub-minute gaps;
-    // full format always shows the minutes field.
-    if (PluginData::getInstance().isShortTimeFormat() && minutes == 0) {
-        snprintf(buffer, bufferSize, "%c%d.%03d", sign, seconds, ms);
-    } else {
-        snprintf(buffer, bufferSize, "%c%d:%02d.%03d", sign, minutes, seconds, ms);
-    }
+    // full format always shows the minutes field. INT_MIN is capped at INT_MAX.
+    char tmp[time_format::MAX_LEN + 1];
+    const size_t len = time_format::write(time_format::Mode::DIFF, diffMs,
+                                          PluginData::getInstance().isShortTimeFormat(), tmp);
+    time_format::copyTruncated(tmp, len, buffer, bufferSize);
 }
 
 void PluginUtils::formatLapTimeTenths(int lapTimeMs, char* buffer, size_t bufferSize) {
     if (lapTimeMs >= 0) {
-        using namespace PluginConstants::TimeConversion;
-        int minutes = lapTimeMs / MS_PER_MINUTE;
-        int seconds = (lapTimeMs % MS_PER_MINUTE) / MS_PER_SECOND;
-        int tenths = (lapTimeMs % MS_PER_SECOND) / 100;  // Convert ms to tenths
-
-        bool compact = PluginData::getInstance().isShortTimeFormat();
-        if (compact && minutes == 0) {
-            snprintf(buffer, bufferSize, "%d.%d", seconds, tenths);
-        } else {
-            snprintf(buffer, bufferSize, "%d:%02d.%d", minutes, seconds, tenths);
-        }
+        char tmp[time_format::MAX_LEN + 1];
+        const size_t len = time_format::write(time_format::Mode::LAP_TENTHS, lapTimeMs,
+                                              PluginData::getInstance().isShortTimeFormat(), tmp);
+        time_format::copyTruncated(tmp, len, buffer, bufferSize);
     }
     else {
         buffer[0] = '\0';
@@ -134,27 +107,31 @@ void PluginUtils::formatLapTimeTenths(int lapTimeMs, char* buffer, size_t buffer
 }
 
 void PluginUtils::formatGapCompact(char* buffer, size_t bufferSize, int diffMs) {
-    using namespace PluginConstants::TimeConversion;
+    // "+13.3" below one minute, "+1:13.3" above - regardless of the short format.
+    char tmp[time_format::MAX_LEN + 1];
+    const size_t len = time_format::write(time_format::Mode::GAP_COMPACT, diffMs, false, tmp);
+    time_format::copyTruncated(tmp, len, buffer, bufferSize);
+}
 
-    // Handle sign and protect against INT_MIN overflow
-    char sign = '+';
-    int absDiff = diffMs;
-    if (diffMs < 0) {
-        sign = '-';
-        absDiff = (diffMs == INT_MIN) ? INT_MAX : -diffMs;
-    }
+void PluginUtils::TimeFormatMemo::formatLapTime(int lapTimeMs, char* buffer, size_t bufferSize) {
+    if (lapTimeMs < 0) { buffer[0] = '\0'; return; }
+    m_memo.format(time_format::Mode::LAP, lapTimeMs, PluginData::getInstance().isShortTimeFormat(),
+                  buffer, bufferSize);
+}
 
-    int minutes = absDiff / MS_PER_MINUTE;
-    int seconds = (absDiff % MS_PER_MINUTE) / MS_PER_SECOND;
-    int tenths = (absDiff % MS_PER_SECOND) / 100;
+void PluginUtils::TimeFormatMemo::formatTimeDiff(char* buffer, size_t bufferSize, int diffMs) {
+    m_memo.format(time_format::Mode::DIFF, diffMs, PluginData::getInstance().isShortTimeFormat(),
+                  buffer, bufferSize);
+}
 
-    if (minutes > 0) {
-        // >= 1 minute: show "+1:13.3"
-        snprintf(buffer, bufferSize, "%c%d:%02d.%d", sign, minutes, seconds, tenths);
-    } else {
-        // < 1 minute: show "+13.3" (compact format)
-        snprintf(buffer, bufferSize, "%c%d.%d", sign, seconds, tenths);
-    }
+void PluginUtils::TimeFormatMemo::formatLapTimeTenths(int lapTimeMs, char* buffer, size_t bufferSize) {
+    if (lapTimeMs < 0) { buffer[0] = '\0'; return; }
+    m_memo.format(time_format::Mode::LAP_TENTHS, lapTimeMs, PluginData::getInstance().isShortTimeFormat(),
+                  buffer, bufferSize);
+}
+
+void PluginUtils::TimeFormatMemo::formatGapCompact(char* buffer, size_t bufferSize, int diffMs) {
+    m_memo.format(time_format::Mode::GAP_COMPACT, diffMs, false, buffer, bufferSize);
 }
 
 void PluginUtils::formatSectorTime(int sectorTimeMs, char* buffer, size_t bufferSize) {
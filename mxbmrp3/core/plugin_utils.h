@@ -10,6 +10,8 @@
 #include <sstream>
 #include <iomanip>
 
+#include "time_format.h"
+
 class PluginUtils {
 public:
     static void formatTimeMinutesSeconds(int milliseconds, char* buffer, size_t bufferSize);
@@ -42,6 +44,20 @@ public:
     // Single decimal (tenths) for cleaner pitboard-style display
     static void formatGapCompact(char* buffer, size_t bufferSize, int diffMs);
 
+    // Memoized versions of the four timing formatters above, for HUDs that rebuild
+    // whole tables of times (standings, lap log, timing, pitboard, ideal lap). Same
+    // signatures and output; an unchanged (value, format) cell is a copy instead of a
+    // reformat. One per HUD instance — not thread-safe, like the HUD that owns it.
+    class TimeFormatMemo {
+    public:
+        void formatLapTime(int lapTimeMs, char* buffer, size_t bufferSize);
+        void formatTimeDiff(char* buffer, size_t bufferSize, int diffMs);
+        void formatLapTimeTenths(int lapTimeMs, char* buffer, size_t bufferSize);
+        void formatGapCompact(char* buffer, size_t bufferSize, int diffMs);
+    private:
+        time_format::Memo m_memo;
+    };
+
     // Format sector time as "SS.mmm" (for sectors under 1 minute)
     // Used by RecordsHud for MXB-Ranked sector times
     static void formatSectorTime(int sectorTimeMs, char* buffer, size_t bufferSize);
@@ -0,0 +1,150 @@
+// ============================================================================
+// core/rider_motion.cpp
+// Velocity estimation and dead reckoning for rider markers. See rider_motion.h.
+// ============================================================================
+#include "rider_motion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(MXBMRP3_TEST_BUILD)
+// Injectable clock for the headless extrapolation test. -1 = real steady_clock
+// (production path). Never compiled into a shipping DLL.
+static long long s_riderMotionTestNowUs = -1;
+void RiderMotion::testSetNowUs(long long us) { s_riderMotionTestNowUs = us; }
+#endif
+
+long long RiderMotion::nowUs() {
+#if defined(MXBMRP3_TEST_BUILD)
+    if (s_riderMotionTestNowUs >= 0) {
+        return s_riderMotionTestNowUs;
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace {
+    // Shortest signed difference b - a for values that wrap at `period`.
+    float wrappedDelta(float a, float b, float period) {
+        float d = std::fmod(b - a, period);
+        if (d >= period * 0.5f) d -= period;
+        else if (d < -period * 0.5f) d += period;
+        return d;
+    }
+}
+
+const RiderMotion::State* RiderMotion::find(int raceNum, size_t hint, const std::vector<State>& states) {
+    // Batches usually list the same riders in the same order: try the slot first.
+    if (hint < states.size() && states[hint].sample.raceNum == raceNum) {
+        return &states[hint];
+    }
+    for (const State& s : states) {
+        if (s.sample.raceNum == raceNum) return &s;
+    }
+    return nullptr;
+}
+
+void RiderMotion::estimate(const State& previous, State& next) {
+    const long long dtUs = next.timeUs - previous.timeUs;
+    if (dtUs < MIN_SAMPLE_INTERVAL_US) {
+        // Burst: the newer sample stands in for the older one, the motion is unchanged
+        next.vx = previous.vx;
+        next.vy = previous.vy;
+        next.vz = previous.vz;
+        next.yawRate = previous.yawRate;
+        next.trackPosRate = previous.trackPosRate;
+        next.hasVelocity = previous.hasVelocity && !next.sample.crashed;
+        return;
+    }
+    if (dtUs > MAX_SAMPLE_INTERVAL_US || next.sample.crashed || previous.sample.crashed) {
+        return;   // hasVelocity stays false: hold at the sample
+    }
+
+    const float dt = static_cast<float>(dtUs) * 1e-6f;
+    const Unified::TrackPositionData& a = previous.sample;
+    const Unified::TrackPositionData& b = next.sample;
+    const float vx = (b.posX - a.posX) / dt;
+    const float vy = (b.posY - a.posY) / dt;
+    const float vz = (b.posZ - a.posZ) / dt;
+    const float speedSq = vx * vx + vy * vy + vz * vz;
+    if (speedSq > MAX_SPEED_MPS * MAX_SPEED_MPS) {
+        return;   // teleport (reset, pit exit, spectate jump)
+    }
+    const float yawRate = std::clamp(wrappedDelta(a.yaw, b.yaw, 360.0f) / dt, -MAX_YAW_RATE_DPS, MAX_YAW_RATE_DPS);
+    if (speedSq < MIN_SPEED_MPS * MIN_SPEED_MPS && std::fabs(yawRate) < MIN_YAW_RATE_DPS) {
+        return;   // standing still: hold at the sample
+    }
+    next.vx = vx;
+    next.vy = vy;
+    next.vz = vz;
+    next.yawRate = yawRate;
+    next.trackPosRate = wrappedDelta(a.trackPos, b.trackPos, 1.0f) / dt;
+    next.hasVelocity = true;
+}
+
+void RiderMotion::update(const Unified::TrackPositionData* positions, int count, long long timeUs) {
+    m_previous.swap(m_riders);
+    if (count <= 0 || positions == nullptr) {
+        m_riders.clear();
+        return;
+    }
+    m_riders.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < m_riders.size(); ++i) {
+        State& next = m_riders[i];
+        next = State();
+        next.sample = positions[i];
+        next.timeUs = timeUs;
+        if (const State* previous = find(positions[i].raceNum, i, m_previous)) {
+            estimate(*previous, next);
+        }
+    }
+}
+
+void RiderMotion::extrapolate(const State& state, long long nowUs, Unified::TrackPositionData& out) {
+    out = state.sample;
+    if (!state.hasVelocity) {
+        return;
+    }
+    const long long elapsedUs = std::clamp(nowUs - state.timeUs, 0LL, MAX_EXTRAPOLATION_US);
+    const float t = static_cast<float>(elapsedUs) * 1e-6f;
+    out.posX += state.vx * t;
+    out.posY += state.vy * t;
+    out.posZ += state.vz * t;
+    // Yaw keeps the game's range convention: at most a fraction of a turn is added,
+    // and the HUDs only take its sine/cosine.
+    out.yaw += state.yawRate * t;
+    float trackPos = out.trackPos + state.trackPosRate * t;
+    if (trackPos < 0.0f) trackPos += 1.0f;
+    else if (trackPos >= 1.0f) trackPos -= 1.0f;
+    out.trackPos = trackPos;
+}
+
+void RiderMotion::predict(long long nowUs, std::vector<Unified::TrackPositionData>& out) const {
+    out.resize(m_riders.size());
+    for (size_t i = 0; i < m_riders.size(); ++i) {
+        extrapolate(m_riders[i], nowUs, out[i]);
+    }
+}
+
+bool RiderMotion::predictRider(int raceNum, long long nowUs, Unified::TrackPositionData& out) const {
+    const State* state = find(raceNum, 0, m_riders);
+    if (!state) {
+        return false;
+    }
+    extrapolate(*state, nowUs, out);
+    return true;
+}
+
+bool RiderMotion::isMoving(long long nowUs) const {
+    for (const State& s : m_riders) {
+        if (s.hasVelocity && nowUs - s.timeUs < MAX_EXTRAPOLATION_US) return true;
+    }
+    return false;
+}
+
+void RiderMotion::clear() {
+    m_riders.clear();
+    m_previous.clear();
+}
@@ -0,0 +1,92 @@
+// ============================================================================
+// core/rider_motion.h
+// Per-rider kinematic state from RaceTrackPosition batches, dead-reckoned to
+// the current Draw time so rider markers move every frame instead of stepping
+// at the callback rate (~30 Hz against a 240 Hz render loop).
+//
+// Each batch updates a rider's last sample and, from the previous sample and
+// the two arrival times, its velocity (world x/y/z), yaw rate and trackPos
+// rate. predict() advances every rider of the latest batch by
+//   min(now - sampleTime, MAX_EXTRAPOLATION_US)
+// at that velocity, so a rider whose data stops coasts for at most the window
+// and then holds still (a late or dropped batch costs a little overshoot, never
+// a runaway marker). No velocity is estimated across a gap, a teleport (reset,
+// pit exit) or a crash, nor for a rider standing still (slower than
+// MIN_SPEED_MPS and turning slower than MIN_YAW_RATE_DPS - sample noise, not
+// motion): those riders are drawn at their last sample, and isMoving() lets the
+// HUDs stop redrawing them.
+//
+// Samples are stamped on arrival (the game's position batch carries no time of
+// its own). Two batches handled back to back — a queued burst on the plugin
+// thread — are closer than MIN_SAMPLE_INTERVAL_US: the newer sample replaces
+// the older one and the rider keeps the velocity it had.
+//
+// Display only: lap timing, S/F detection and the gap HUDs keep using the raw
+// trackPos. Owned by HudManager; callbacks and draws arrive on one thread.
+// ============================================================================
+#pragma once
+
+#include <vector>
+
+#include "../game/unified_types.h"
+
+class RiderMotion {
+public:
+    // Longest a rider is extrapolated past its last sample: three missed
+    // batches at the game's ~30 Hz.
+    static constexpr long long MAX_EXTRAPOLATION_US = 100000;
+    // Closer samples are a burst, not a measurement (see the header comment).
+    static constexpr long long MIN_SAMPLE_INTERVAL_US = 2000;
+    // Samples further apart (the rider left the batch and came back) don't
+    // give a usable velocity.
+    static constexpr long long MAX_SAMPLE_INTERVAL_US = 500000;
+    // Anything faster between two samples is a teleport.
+    static constexpr float MAX_SPEED_MPS = 100.0f;
+    static constexpr float MAX_YAW_RATE_DPS = 720.0f;
+    // Anything slower (on both) is a rider standing still: at most 1 cm and
+    // 0.2 degrees over the extrapolation window.
+    static constexpr float MIN_SPEED_MPS = 0.1f;
+    static constexpr float MIN_YAW_RATE_DPS = 2.0f;
+
+    // Ingest one RaceTrackPosition batch received at timeUs. The batch is the
+    // new rider set: riders missing from it are dropped (the game reports the
+    // riders nearest the camera, and the HUDs show what it last reported).
+    void update(const Unified::TrackPositionData* positions, int count, long long timeUs);
+
+    // Every rider of the latest batch, in batch order, dead-reckoned to nowUs.
+    // Reuses out's capacity.
+    void predict(long long nowUs, std::vector<Unified::TrackPositionData>& out) const;
+    // One rider; false when it isn't in the latest batch.
+    bool predictRider(int raceNum, long long nowUs, Unified::TrackPositionData& out) const;
+
+    // Whether predict(nowUs) can still differ from a later predict(): some rider
+    // has a velocity (is not standing still) and is inside its extrapolation
+    // window.
+    bool isMoving(long long nowUs) const;
+
+    int riderCount() const { return static_cast<int>(m_riders.size()); }
+    void clear();
+
+    // Microseconds on the steady clock (the clock samples and predictions share).
+    static long long nowUs();
+#if defined(MXBMRP3_TEST_BUILD)
+    static void testSetNowUs(long long us);   // -1 = real clock
+#endif
+
+private:
+    struct State {
+        Unified::TrackPositionData sample;
+        long long timeUs = 0;
+        float vx = 0.0f, vy = 0.0f, vz = 0.0f;   // m/s
+        float yawRate = 0.0f;                    // deg/s
+        float trackPosRate = 0.0f;               // trackPos/s
+        bool hasVelocity = false;
+    };
+
+    static void estimate(const State& previous, State& next);
+    static void extrapolate(const State& state, long long nowUs, Unified::TrackPositionData& out);
+    static const State* find(int raceNum, size_t hint, const std::vector<State>& states);
+
+    std::vector<State> m_riders;    // latest batch order
+    std::vector<State> m_previous;  // scratch: the batch before, while matching
+};
@@ -509,6 +509,8 @@ namespace Settings {
             constexpr Setting BLUE_FLAG_AWARENESS_DISTANCE = {"blueFlagAwarenessDistance", "Blue flag detection range in meters (10-500, default 100.0)"};
             constexpr Setting GAP_NOTIFY_INTERVAL_MS = {"gapNotifyIntervalMs", "Min interval between live-gap HUD refreshes in ms; 0=refresh on every change (0-1000, default 100)"};
             constexpr Setting PLUGIN_THREAD = {"pluginThread", "EXPERIMENTAL: run the plugin's callbacks + HUD render build on its own thread so hiccups never stall the game frame (1=on, 0=off default). Read once at startup"};
+            constexpr Setting FRAME_EXPORT = {"frameExport", "Publish each HUD frame to shared memory (Local\\mxbmrp3_frames) for external apps: 0=off default, 1=primitives (quads/strings), 2=rendered RGBA image"};
+            constexpr Setting FRAME_EXPORT_WIDTH = {"frameExportWidth", "Image width for frameExport=2, height is 16:9 (320-3840, default 1280)"};
             constexpr Setting WEB_SERVER_PORT = {"webServerPort", "Web server port (1024-65535, default 8080)"};
             constexpr Setting WEB_SERVER_THROTTLE_MS = {"webServerThrottleMs", "Min interval between SSE pushes in ms (50-5000, default 250)"};
             constexpr Setting WEB_SERVER_BIND_ADDRESS = {"webServerBindAddress", "Bind address (default 127.0.0.1, use 0.0.0.0 for network access)"};
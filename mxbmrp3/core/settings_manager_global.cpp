@@ -13,6 +13,7 @@
 #include "hud_manager.h"
 #include "profile_manager.h"
 #include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
 #include "../hud/ideal_lap_hud.h"
 #include "../hud/lap_log_hud.h"
 #include "../hud/friends_hud.h"
@@ -232,6 +233,8 @@ void SettingsManager::writeGlobalSettings(std::ostream& out, const HudManager& h
     out << IniOnly::Advanced::BLUE_FLAG_AWARENESS_DISTANCE.key << "=" << PluginData::getInstance().getBlueFlagAwarenessDistance() << " ; " << IniOnly::Advanced::BLUE_FLAG_AWARENESS_DISTANCE.description << "\n";
     out << IniOnly::Advanced::GAP_NOTIFY_INTERVAL_MS.key << "=" << PluginData::getInstance().getGapNotifyIntervalMs() << " ; " << IniOnly::Advanced::GAP_NOTIFY_INTERVAL_MS.description << "\n";
     out << IniOnly::Advanced::PLUGIN_THREAD.key << "=" << (UiConfig::getInstance().getPluginThread() ? 1 : 0) << " ; " << IniOnly::Advanced::PLUGIN_THREAD.description << "\n";
+    out << IniOnly::Advanced::FRAME_EXPORT.key << "=" << UiConfig::getInstance().getFrameExport() << " ; " << IniOnly::Advanced::FRAME_EXPORT.description << "\n";
+    out << IniOnly::Advanced::FRAME_EXPORT_WIDTH.key << "=" << UiConfig::getInstance().getFrameExportWidth() << " ; " << IniOnly::Advanced::FRAME_EXPORT_WIDTH.description << "\n";
 #if GAME_HAS_HTTP_SERVER
     out << IniOnly::Advanced::WEB_SERVER_PORT.key << "=" << HttpServer::getInstance().getPort() << " ; " << IniOnly::Advanced::WEB_SERVER_PORT.description << "\n";
     out << IniOnly::Advanced::WEB_SERVER_THROTTLE_MS.key << "=" << HttpServer::getInstance().getThrottleMs() << " ; " << IniOnly::Advanced::WEB_SERVER_THROTTLE_MS.description << "\n";
@@ -436,9 +439,17 @@ void SettingsManager::writeGlobalSettings(std::ostream& out, const HudManager& h
     // tape for the test harness. No HUD / no hotkey / no settings-menu control.
     out << "[Recorder]\n";
     out << "enabled=" << (EventRecorder::getInstance().isRecordingEnabled() ? 1 : 0)
-        << " ; Dev-only: capture the raw callback stream to mxbmrp3\\tapes\\ for headless replay\n\n";
+        << " ; Dev-only: capture the raw callback stream to mxbmrp3\\tapes\\ for headless replay\n";
+    out << "keyframeSeconds=" << EventRecorder::getInstance().getKeyframeSeconds()
+        << " ; State keyframe interval for mid-session replay starts (0 = none)\n\n";
 #endif
 
+    // Write Trace section (global; hidden developer tool). Off by default; the
+    // TOGGLE_TRACE hotkey starts/stops a capture at any time.
+    out << "[Trace]\n";
+    out << "enabled=" << (Tracer::getInstance().getCaptureAtStartup() ? 1 : 0)
+        << " ; Dev-only: capture a timeline from launch to mxbmrp3\\traces\\ (Chrome trace JSON)\n\n";
+
     // Write Hotkeys section. Keys are named per action (e.g. standings_key) so
     // the file is self-documenting; values are numeric codes: _key = Windows
     // virtual-key code, _mod = modifier bitmask (1=Ctrl, 2=Shift, 4=Alt),
@@ -720,6 +731,10 @@ bool SettingsManager::applyGlobalLine(const std::string& section, const std::str
                 PluginData::getInstance().setGapNotifyIntervalMs(std::stoi(value));
             } else if (key == "pluginThread") {
                 UiConfig::getInstance().setPluginThread(std::stoi(value) != 0);
+            } else if (key == "frameExport") {
+                UiConfig::getInstance().setFrameExport(std::stoi(value));
+            } else if (key == "frameExportWidth") {
+                UiConfig::getInstance().setFrameExportWidth(std::stoi(value));
             }
 #if GAME_HAS_HTTP_SERVER
             else if (key == "webServerPort") {
@@ -1069,12 +1084,15 @@ bool SettingsManager::applyGlobalLine(const std::string& section, const std::str
     }
 
 #if GAME_HAS_RECORDER
-    // Handle Recorder section (hidden dev tool). Only reads the enabled flag;
-    // the actual session tape is opened at startup if enabled (see plugin_manager).
+    // Handle Recorder section (hidden dev tool). Reads the enabled flag and the
+    // keyframe interval; the actual session tape is opened at startup if enabled
+    // (see plugin_manager).
     if (section == "Recorder") {
         try {
             if (key == "enabled") {
                 EventRecorder::getInstance().setRecordingEnabled(std::stoi(value) != 0);
+            } else if (key == "keyframeSeconds") {
+                EventRecorder::getInstance().setKeyframeSeconds(std::stoi(value));
             }
         } catch (const std::exception& e) {
             DEBUG_WARN_F("Recorder: Failed to parse setting '%s': %s", key.c_str(), e.what());
@@ -1083,6 +1101,19 @@ bool SettingsManager::applyGlobalLine(const std::string& section, const std::str
     }
 #endif
 
+    // Handle Trace section (hidden dev tool). Only sets the flag; the capture is
+    // started at startup (see plugin_manager).
+    if (section == "Trace") {
+        try {
+            if (key == "enabled") {
+                Tracer::getInstance().setCaptureAtStartup(std::stoi(value) != 0);
+            }
+        } catch (const std::exception& e) {
+            DEBUG_WARN_F("Trace: Failed to parse setting '%s': %s", key.c_str(), e.what());
+        }
+        return true;
+    }
+
     // Handle Hotkeys section
     if (section == "Hotkeys") {
         HotkeyManager& hotkeyMgr = HotkeyManager::getInstance();
@@ -0,0 +1,578 @@
+// ============================================================================
+// core/tape_io.h
+// The MXBHREC v2 block container, and a reader for both tape versions. Shared by
+// the writer (core/event_recorder.cpp) and every reader (the integration
+// harness's tape.h / PluginHost::replayTape(), tools/mxbmrp3_replay). Standard
+// library + miniz's raw deflate only, so all of them include it as-is.
+//
+// v1 is the 72-byte FileHeader followed by the event stream itself:
+//   [EventHeader 16 B][payload] [EventHeader][payload] ... to EOF
+// A session is dominated by near-identical RaceTrackPosition / RunTelemetry /
+// Draw records, so v1 tapes compress extremely well - which is why fixtures were
+// gzipped by hand. v2 keeps the same FileHeader (version = 2) and the same event
+// framing, but groups whole events into blocks of about BLOCK_BYTES, each stored
+// raw-deflated:
+//   FileHeader | Block* | IndexEntry[blockCount] | IndexFooter
+//   Block = BlockHeader (magic "BLK2", raw/stored sizes, event count, first
+//           timestamp) + storedBytes of deflate (or raw bytes, BLOCK_STORED)
+// No event spans blocks, so any block decodes on its own: the index (one entry per
+// block: file offset, first timestamp, first event ordinal) lets a reader seek by
+// time or event without touching the blocks before it. The index is written when
+// the recording closes; a tape cut short by a crash has none (its last block is
+// the one open at the writer's last checkpoint, or missing if the crash tore
+// that checkpoint), and readers simply walk the blocks from the front until the
+// first incomplete one.
+//
+// Delta stage (BLOCK_DELTA). Before deflate, the high-rate records - RunTelemetry
+// (SPluginsBikeData_t, 100 Hz), RaceTrackPosition and RaceClassification (the
+// whole grid, every tick) - are stored as the difference from the previous record
+// of the same type and size IN THE SAME BLOCK: uint32 words subtracted (wrapping),
+// a trailing partial word byte-wise. Most fields move a little or not at all from
+// one sample to the next, so the residue is mostly zero words and small integers,
+// which deflate packs far better than the records themselves (Farm14: 51x -> 90x).
+// The first record of each type in a block stays whole, so every block is its own
+// keyframe and still decodes without the blocks before it. Framing (EventFrame) is
+// never coded; decodeBlock() undoes the stage after inflate, so readers get the
+// original bytes.
+//
+// State keyframes (BLOCK_KEYFRAME). A StateKeyframe event (KEYFRAME_EVENT: the
+// plugin's race state, PluginData::writeKeyframe) always starts a new block, and
+// that block is flagged, so a reader finds the nearest keyframe before a time
+// from the block table and headers alone (MappedTape::seekKeyframe) and replays
+// from there - decoding one block, not the session before it. v1 tapes can carry
+// keyframes too; they are found by walking the event table.
+//
+// All integers little-endian; structs use default alignment with explicit sizes
+// (static_asserts below) so the layout is the same for every compiler that builds
+// a reader.
+// ============================================================================
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#ifndef _WIN32
+#include <sys/types.h>   // off_t (fseeko/ftello)
+#endif
+
+#include "../vendor/miniz/miniz_tdef.h"
+#include "../vendor/miniz/miniz_tinfl.h"
+
+namespace tape_io {
+
+// 64-bit file positions. fseek/ftell take a long, which is 32-bit on Win64 (the
+// shipping target): past 2 GB a block offset or the index position would wrap.
+inline int seek64(FILE* f, int64_t offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(f, offset, origin);
+#else
+    return fseeko(f, static_cast<off_t>(offset), origin);
+#endif
+}
+inline int64_t tell64(FILE* f) {
+#ifdef _WIN32
+    return _ftelli64(f);
+#else
+    return static_cast<int64_t>(ftello(f));
+#endif
+}
+
+constexpr char FILE_MAGIC[8] = { 'M', 'X', 'B', 'H', 'R', 'E', 'C', '\0' };
+constexpr uint32_t VERSION_RAW = 1;      // v1: bare event stream
+constexpr uint32_t VERSION_BLOCKS = 2;   // v2: deflated blocks + index
+constexpr size_t FILE_HEADER_BYTES = 72; // sizeof(FileHeader) in both mirrors
+constexpr size_t VERSION_OFFSET = 8;     // FileHeader::version
+constexpr size_t NUM_EVENTS_OFFSET = 12; // FileHeader::numEvents
+
+// Raw bytes of whole events per block. Every block restarts deflate's
+// dictionary and Huffman tables, so blocks much smaller than this lose a lot of
+// ratio (a 13 KB block - one recorder handoff of a race - compresses ~22x where
+// 256 KB gets ~51x); a few hundred events per block still seeks finely. An event
+// bigger than this (a long centerline) becomes a block of its own.
+constexpr size_t BLOCK_BYTES = 256 * 1024;
+// Sanity cap for readers: no block claims more than this (a corrupt header
+// must not make a reader allocate gigabytes).
+constexpr uint32_t MAX_BLOCK_BYTES = 64u * 1024u * 1024u;
+
+// Same framing as Recording::EventHeader / tape.h's EventHeader.
+struct EventFrame {
+    uint32_t eventType;
+    uint32_t dataSize;
+    uint64_t timestampUs;
+};
+static_assert(sizeof(EventFrame) == 16, "EventFrame must match the 16-byte EventHeader");
+
+constexpr uint32_t BLOCK_STORED = 0x1;   // payload is the raw events (deflate didn't help)
+constexpr uint32_t BLOCK_DELTA = 0x2;    // inflated events carry the delta stage (header comment)
+constexpr uint32_t BLOCK_KEYFRAME = 0x4; // the block's first event is a StateKeyframe
+
+// Recording::EventType::StateKeyframe: not a game callback, a PluginData snapshot.
+constexpr uint32_t KEYFRAME_EVENT = 28;
+
+// Event types the delta stage codes, as a bit set of Recording::EventType values:
+// RunTelemetry (11), RaceClassification (24), RaceTrackPosition (25).
+constexpr uint32_t DELTA_TYPES = (1u << 11) | (1u << 24) | (1u << 25);
+inline bool deltaCoded(uint32_t eventType) { return eventType < 32 && ((DELTA_TYPES >> eventType) & 1u); }
+
+// out = cur - ref over n bytes: uint32 words (wrapping), then the tail byte-wise.
+// out may alias cur.
+inline void deltaSub(uint8_t* out, const uint8_t* cur, const uint8_t* ref, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t a, b;
+        std::memcpy(&a, cur + i, 4);
+        std::memcpy(&b, ref + i, 4);
+        a -= b;
+        std::memcpy(out + i, &a, 4);
+    }
+    for (; i < n; ++i) out[i] = static_cast<uint8_t>(cur[i] - ref[i]);
+}
+
+// Inverse of deltaSub, in place: buf += ref.
+inline void deltaAdd(uint8_t* buf, const uint8_t* ref, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t a, b;
+        std::memcpy(&a, buf + i, 4);
+        std::memcpy(&b, ref + i, 4);
+        a += b;
+        std::memcpy(buf + i, &a, 4);
+    }
+    for (; i < n; ++i) buf[i] = static_cast<uint8_t>(buf[i] + ref[i]);
+}
+
+// dataSize of the EventFrame at frame (unaligned).
+inline uint32_t frameDataSize(const uint8_t* frame) {
+    uint32_t n;
+    std::memcpy(&n, frame + offsetof(EventFrame, dataSize), sizeof(n));
+    return n;
+}
+
+// Undo the delta stage over one inflated block, in place. False if the framing
+// doesn't walk the block exactly.
+inline bool deltaDecode(std::vector<uint8_t>& block) {
+    size_t prev[32];
+    for (size_t& p : prev) p = SIZE_MAX;
+    uint8_t* base = block.data();
+    size_t pos = 0;
+    while (pos < block.size()) {
+        EventFrame ef;
+        if (block.size() - pos < sizeof(ef)) return false;
+        std::memcpy(&ef, base + pos, sizeof(ef));
+        if (ef.dataSize > block.size() - pos - sizeof(ef)) return false;
+        if (deltaCoded(ef.eventType)) {
+            const size_t ref = prev[ef.eventType];
+            if (ref != SIZE_MAX && frameDataSize(base + ref) == ef.dataSize) {
+                deltaAdd(base + pos + sizeof(ef), base + ref + sizeof(ef), ef.dataSize);
+            }
+            prev[ef.eventType] = pos;
+        }
+        pos += sizeof(ef) + ef.dataSize;
+    }
+    return true;
+}
+
+struct BlockHeader {
+    char magic[4];               // "BLK2"
+    uint32_t rawBytes;           // decoded size: whole events
+    uint32_t storedBytes;        // bytes following this header
+    uint32_t eventCount;
+    uint64_t firstTimestampUs;   // timestampUs of the block's first event
+    uint32_t flags;              // BLOCK_STORED | BLOCK_DELTA | BLOCK_KEYFRAME
+    uint32_t reserved;
+};
+static_assert(sizeof(BlockHeader) == 32, "BlockHeader is 32 bytes on disk");
+
+struct IndexEntry {
+    uint64_t fileOffset;         // of the block's BlockHeader
+    uint64_t firstTimestampUs;
+    uint32_t firstEvent;         // ordinal of the block's first event in the tape
+    uint32_t eventCount;
+};
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry is 24 bytes on disk");
+
+struct IndexFooter {
+    uint64_t indexOffset;        // of the first IndexEntry
+    uint32_t blockCount;
+    uint32_t reserved;
+    char magic[8];               // "MXBHIDX\0" - the last 8 bytes of an indexed tape
+};
+static_assert(sizeof(IndexFooter) == 24, "IndexFooter is 24 bytes on disk");
+
+constexpr char BLOCK_MAGIC[4] = { 'B', 'L', 'K', '2' };
+constexpr char INDEX_MAGIC[8] = { 'M', 'X', 'B', 'H', 'I', 'D', 'X', '\0' };
+
+// ----------------------------------------------------------------------------
+// BlockWriter: turns a v1-framed event stream into v2 blocks on a FILE*, then
+// appends the index. The caller writes the FileHeader (version 2) first and
+// hands over runs of WHOLE events; it never sees a block boundary. Not thread-
+// safe - the recorder drives it from its writer thread only.
+//
+// checkpoint() hands everything so far to the OS (fflush, not fsync) without
+// closing the block: the open block is (re)written in place at its file offset,
+// and the next checkpoint or the block's completion overwrites it again. Only
+// the open block is ever rewritten, so a write torn by a crash loses that block
+// (up to BLOCK_BYTES raw) but never a closed one. A stored block never
+// shrinks - if a rewrite compresses smaller, the deflate stream is zero-padded to
+// the previous length (inflate stops at the stream's final block) - so a rewrite
+// can't leave a stale tail where the next block or the index will go.
+//
+// The delta stage is applied as events arrive (m_coded mirrors m_open), so a
+// checkpoint only pays for the deflate. A block that falls back to BLOCK_STORED
+// stores the original events, not the coded ones. A StateKeyframe event closes
+// the open block and opens a BLOCK_KEYFRAME one.
+// ----------------------------------------------------------------------------
+class BlockWriter {
+public:
+    // Deflate effort: greedy parsing with a short probe chain. Tapes are
+    // repetitive enough that this keeps most of the default level's ratio at
+    // well above its speed, which matters because checkpoints recompress the open
+    // block on the recorder's writer thread.
+    static constexpr int DEFLATE_FLAGS = 16 | TDEFL_GREEDY_PARSING_FLAG;
+
+    // offset: file position of the first block (FILE_HEADER_BYTES).
+    void begin(uint64_t offset) {
+        m_offset = offset;
+        m_events = 0;
+        m_rawBytes = 0;
+        m_index.clear();
+        m_open.clear();
+        m_openEvents = 0;
+        m_openStored = 0;
+        m_coded.clear();
+        resetDelta();
+        if (!m_deflate) m_deflate.reset(new tdefl_compressor);
+    }
+
+    // Delta stage on or off for the blocks that follow (on by default). Off writes
+    // plain deflated blocks - for size comparisons; readers handle both.
+    void setDelta(bool on) { m_delta = on; }
+
+    // Append events (whole [EventFrame][payload] records), writing out each block
+    // they fill. Returns false on an I/O error or a record that overruns len.
+    bool write(FILE* f, const uint8_t* data, size_t len) {
+        size_t pos = 0;
+        while (pos < len) {
+            EventFrame ef;
+            if (len - pos < sizeof(ef)) return false;
+            std::memcpy(&ef, data + pos, sizeof(ef));
+            const size_t bytes = sizeof(ef) + ef.dataSize;
+            if (bytes > len - pos) return false;
+            const bool keyframe = ef.eventType == KEYFRAME_EVENT;
+            if (!m_open.empty() && (keyframe || m_open.size() + bytes > BLOCK_BYTES)) {
+                if (!writeOpen(f, /*close=*/true)) return false;
+            }
+            if (m_open.empty()) {
+                m_openFirstUs = ef.timestampUs;
+                m_openKeyframe = keyframe;
+            }
+            const size_t at = m_open.size();
+            m_open.insert(m_open.end(), data + pos, data + pos + bytes);
+            if (m_delta) appendCoded(ef, at);
+            ++m_openEvents;
+            pos += bytes;
+        }
+        return true;
+    }
+
+    // Write the open block as it stands (it stays open). See the class comment.
+    bool checkpoint(FILE* f) { return m_open.empty() || writeOpen(f, /*close=*/false); }
+
+    // Close the open block, then append the index + footer. Returns false on an
+    // I/O error.
+    bool finish(FILE* f) {
+        if (!m_open.empty() && !writeOpen(f, /*close=*/true)) return false;
+        IndexFooter footer{};
+        footer.indexOffset = m_offset;
+        footer.blockCount = static_cast<uint32_t>(m_index.size());
+        std::memcpy(footer.magic, INDEX_MAGIC, sizeof(footer.magic));
+        if (seek64(f, static_cast<int64_t>(m_offset), SEEK_SET) != 0) return false;
+        if (!m_index.empty() &&
+            std::fwrite(m_index.data(), sizeof(IndexEntry), m_index.size(), f) != m_index.size()) {
+            return false;
+        }
+        if (std::fwrite(&footer, sizeof(footer), 1, f) != 1) return false;
+        std::fflush(f);
+        m_offset += m_index.size() * sizeof(IndexEntry) + sizeof(footer);
+        return true;
+    }
+
+    uint32_t events() const { return m_events; }                  // in closed blocks
+    size_t blocks() const { return m_index.size(); }              // closed blocks
+    uint64_t rawBytes() const { return m_rawBytes; }              // event bytes in closed blocks
+    // File bytes written so far, the open block's latest checkpoint included.
+    uint64_t fileBytes() const { return m_offset + (m_openStored ? sizeof(BlockHeader) + m_openStored : 0); }
+
+private:
+    bool writeOpen(FILE* f, bool close) {
+        const size_t raw = m_open.size();
+        m_out.resize(raw > m_openStored ? raw : m_openStored);
+        size_t inSize = raw, outSize = raw;
+        tdefl_init(m_deflate.get(), nullptr, nullptr, DEFLATE_FLAGS);
+        const bool deflated =
+            tdefl_compress(m_deflate.get(), m_delta ? m_coded.data() : m_open.data(), &inSize, m_out.data(), &outSize, TDEFL_FINISH) == TDEFL_STATUS_DONE &&
+            outSize < raw;
+
+        BlockHeader bh{};
+        std::memcpy(bh.magic, BLOCK_MAGIC, sizeof(bh.magic));
+        bh.rawBytes = static_cast<uint32_t>(raw);
+        bh.eventCount = m_openEvents;
+        bh.firstTimestampUs = m_openFirstUs;
+        const uint8_t* body;
+        if (deflated) {
+            if (outSize < m_openStored) {
+                std::memset(m_out.data() + outSize, 0, m_openStored - outSize);
+                outSize = m_openStored;
+            }
+            bh.storedBytes = static_cast<uint32_t>(outSize);
+            bh.flags = m_delta ? BLOCK_DELTA : 0;
+            body = m_out.data();
+        } else {
+            // raw >= any earlier stored size: the block only ever grew.
+            bh.storedBytes = static_cast<uint32_t>(raw);
+            bh.flags = BLOCK_STORED;
+            body = m_open.data();
+        }
+        if (m_openKeyframe) bh.flags |= BLOCK_KEYFRAME;
+        if (seek64(f, static_cast<int64_t>(m_offset), SEEK_SET) != 0 ||
+            std::fwrite(&bh, sizeof(bh), 1, f) != 1 ||
+            std::fwrite(body, 1, bh.storedBytes, f) != bh.storedBytes) {
+            return false;
+        }
+        std::fflush(f);
+        m_openStored = bh.storedBytes;
+        if (!close) return true;
+
+        m_index.push_back({ m_offset, bh.firstTimestampUs, m_events, bh.eventCount });
+        m_offset += sizeof(bh) + bh.storedBytes;
+        m_events += bh.eventCount;
+        m_rawBytes += raw;
+        m_open.clear();
+        m_coded.clear();
+        resetDelta();
+        m_openEvents = 0;
+        m_openStored = 0;
+        return true;
+    }
+
+    void resetDelta() {
+        for (size_t& p : m_prev) p = SIZE_MAX;
+    }
+
+    // Append the coded copy of the event just added to m_open at offset `at`.
+    void appendCoded(const EventFrame& ef, size_t at) {
+        const size_t bytes = sizeof(ef) + ef.dataSize;
+        m_coded.insert(m_coded.end(), m_open.begin() + static_cast<std::ptrdiff_t>(at),
+                       m_open.begin() + static_cast<std::ptrdiff_t>(at + bytes));
+        if (!deltaCoded(ef.eventType)) return;
+        const size_t ref = m_prev[ef.eventType];
+        if (ref != SIZE_MAX && frameDataSize(m_open.data() + ref) == ef.dataSize) {
+            deltaSub(m_coded.data() + at + sizeof(ef), m_open.data() + at + sizeof(ef),
+                     m_open.data() + ref + sizeof(ef), ef.dataSize);
+        }
+        m_prev[ef.eventType] = at;
+    }
+
+    std::unique_ptr<tdefl_compressor> m_deflate;   // ~300 KB of state, reused per block
+    std::vector<uint8_t> m_open;                   // events of the open block
+    std::vector<uint8_t> m_coded;                  // m_open after the delta stage
+    std::vector<uint8_t> m_out;                    // deflate output scratch
+    size_t m_prev[32] = {};                        // offset in m_open of each type's last record
+    bool m_delta = true;
+    uint64_t m_openFirstUs = 0;
+    bool m_openKeyframe = false;                   // the open block starts with a StateKeyframe
+    uint32_t m_openEvents = 0;
+    size_t m_openStored = 0;                       // bytes the open block occupies on disk
+    std::vector<IndexEntry> m_index;
+    uint64_t m_offset = 0;                         // where the open block starts
+    uint32_t m_events = 0;
+    uint64_t m_rawBytes = 0;
+};
+
+// Decode one block body into out (resized to rawBytes). False if it is corrupt.
+inline bool decodeBlock(const BlockHeader& bh, const uint8_t* stored, std::vector<uint8_t>& out) {
+    out.resize(bh.rawBytes);
+    if (bh.flags & BLOCK_STORED) {
+        if (bh.storedBytes != bh.rawBytes) return false;
+        if (bh.rawBytes) std::memcpy(out.data(), stored, bh.rawBytes);
+        return true;
+    }
+    const size_t n = tinfl_decompress_mem_to_mem(out.data(), out.size(), stored, bh.storedBytes,
+                                                 TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    if (n != bh.rawBytes) return false;
+    return !(bh.flags & BLOCK_DELTA) || deltaDecode(out);
+}
+
+// A .tape.gz (how v1 fixtures are committed) inflated into out. One gzip member:
+// 10-byte header, optional FEXTRA / FNAME / FCOMMENT / FHCRC, raw deflate, 8-byte
+// trailer (not verified). False if it isn't gzip or doesn't inflate.
+inline bool gunzip(const uint8_t* gz, size_t size, std::vector<uint8_t>& out) {
+    out.clear();
+    if (size < 18 || gz[0] != 0x1F || gz[1] != 0x8B || gz[2] != 8) return false;
+    const uint8_t flg = gz[3];
+    size_t pos = 10;
+    if (flg & 0x04) pos += 2 + (gz[pos] | (gz[pos + 1] << 8));
+    for (uint8_t bit : { uint8_t{ 0x08 }, uint8_t{ 0x10 } }) {   // NUL-terminated name, comment
+        if (!(flg & bit)) continue;
+        while (pos < size && gz[pos]) ++pos;
+        ++pos;
+    }
+    if (flg & 0x02) pos += 2;
+    if (pos >= size) return false;
+    size_t outLen = 0;
+    void* raw = tinfl_decompress_mem_to_heap(gz + pos, size - pos, &outLen, 0);
+    if (!raw) return false;
+    out.assign(static_cast<const uint8_t*>(raw), static_cast<const uint8_t*>(raw) + outLen);
+    std::free(raw);                              // miniz's default MZ_FREE
+    return true;
+}
+
+inline bool blockHeaderValid(const BlockHeader& bh) {
+    return std::memcmp(bh.magic, BLOCK_MAGIC, sizeof(bh.magic)) == 0 &&
+           bh.rawBytes <= MAX_BLOCK_BYTES && bh.storedBytes <= MAX_BLOCK_BYTES &&
+           bh.rawBytes >= bh.eventCount * sizeof(EventFrame);
+}
+
+// ----------------------------------------------------------------------------
+// Reader: sequential events from a v1 or v2 tape.
+//
+//   tape_io::Reader r;
+//   if (!r.open(path)) ...;            // bad magic / unknown version / no file
+//   tape_io::EventFrame ev; const uint8_t* payload;
+//   while (r.next(ev, payload)) dispatch(ev.eventType, payload);
+//
+// payload stays valid until the next call. Reading stops cleanly at EOF, at a
+// truncated record or block (a crash-cut tape), and at a v2 tape's index.
+// ----------------------------------------------------------------------------
+class Reader {
+public:
+    Reader() = default;
+    ~Reader() { close(); }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool open(const char* path) {
+        close();
+        FILE* f = std::fopen(path, "rb");
+        return f && open(f);
+    }
+
+    // Adopt an already-open stream positioned at the FileHeader (closed by close()).
+    bool open(FILE* f) {
+        close();
+        m_file = f;
+        if (std::fread(m_header, 1, FILE_HEADER_BYTES, m_file) != FILE_HEADER_BYTES ||
+            std::memcmp(m_header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+            close();
+            return false;
+        }
+        std::memcpy(&m_version, m_header + VERSION_OFFSET, sizeof(m_version));
+        if (m_version != VERSION_RAW && m_version != VERSION_BLOCKS) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (m_file) std::fclose(m_file);
+        m_file = nullptr;
+        m_block.clear();
+        m_blockPos = 0;
+        m_blocksRead = 0;
+        m_version = 0;
+    }
+
+    bool isOpen() const { return m_file != nullptr; }
+    uint32_t version() const { return m_version; }
+    // The 72 FileHeader bytes as stored (numEvents, start/end times, ...).
+    const uint8_t* headerBytes() const { return m_header; }
+    uint32_t headerNumEvents() const {
+        uint32_t n;
+        std::memcpy(&n, m_header + NUM_EVENTS_OFFSET, sizeof(n));
+        return n;
+    }
+    size_t blocksRead() const { return m_blocksRead; }
+
+    bool next(EventFrame& ev, const uint8_t*& payload) {
+        if (!m_file) return false;
+        if (m_version == VERSION_RAW) {
+            if (std::fread(&ev, sizeof(ev), 1, m_file) != 1) return false;
+            if (ev.dataSize > MAX_BLOCK_BYTES) return false;
+            m_payload.resize(ev.dataSize);
+            if (ev.dataSize && std::fread(m_payload.data(), 1, ev.dataSize, m_file) != ev.dataSize) return false;
+            payload = m_payload.data();
+            return true;
+        }
+        while (m_blockPos >= m_block.size()) {
+            if (!readBlock()) return false;
+        }
+        if (m_blockPos + sizeof(ev) > m_block.size()) return false;
+        std::memcpy(&ev, m_block.data() + m_blockPos, sizeof(ev));
+        m_blockPos += sizeof(ev);
+        if (ev.dataSize > m_block.size() - m_blockPos) return false;
+        payload = m_block.data() + m_blockPos;
+        m_blockPos += ev.dataSize;
+        return true;
+    }
+
+    // v2: read the index from the end of the file (restores the read position).
+    // False for v1 tapes and for v2 tapes without a valid index (crash-cut).
+    bool readIndex(std::vector<IndexEntry>& out) {
+        out.clear();
+        if (!m_file || m_version != VERSION_BLOCKS) return false;
+        const int64_t pos = tell64(m_file);
+        bool ok = false;
+        IndexFooter footer;
+        if (seek64(m_file, -static_cast<int64_t>(sizeof(footer)), SEEK_END) == 0 &&
+            std::fread(&footer, sizeof(footer), 1, m_file) == 1 &&
+            std::memcmp(footer.magic, INDEX_MAGIC, sizeof(footer.magic)) == 0) {
+            const int64_t footerAt = tell64(m_file) - static_cast<int64_t>(sizeof(footer));
+            const uint64_t indexBytes = static_cast<uint64_t>(footer.blockCount) * sizeof(IndexEntry);
+            if (footer.indexOffset >= FILE_HEADER_BYTES &&
+                footer.indexOffset + indexBytes == static_cast<uint64_t>(footerAt)) {
+                out.resize(footer.blockCount);
+                ok = seek64(m_file, static_cast<int64_t>(footer.indexOffset), SEEK_SET) == 0 &&
+                     (out.empty() || std::fread(out.data(), sizeof(IndexEntry), out.size(), m_file) == out.size());
+                if (!ok) out.clear();
+            }
+        }
+        seek64(m_file, pos, SEEK_SET);
+        return ok;
+    }
+
+    // v2: continue sequential reading from the block at entry.fileOffset (an
+    // IndexEntry from readIndex).
+    bool seekBlock(const IndexEntry& entry) {
+        if (!m_file || m_version != VERSION_BLOCKS) return false;
+        m_block.clear();
+        m_blockPos = 0;
+        return seek64(m_file, static_cast<int64_t>(entry.fileOffset), SEEK_SET) == 0;
+    }
+
+private:
+    bool readBlock() {
+        BlockHeader bh;
+        if (std::fread(&bh, sizeof(bh), 1, m_file) != 1 || !blockHeaderValid(bh)) return false;
+        m_stored.resize(bh.storedBytes);
+        if (bh.storedBytes && std::fread(m_stored.data(), 1, bh.storedBytes, m_file) != bh.storedBytes) return false;
+        if (!decodeBlock(bh, m_stored.data(), m_block)) return false;
+        m_blockPos = 0;
+        ++m_blocksRead;
+        return true;
+    }
+
+    FILE* m_file = nullptr;
+    uint8_t m_header[FILE_HEADER_BYTES] = {};
+    uint32_t m_version = 0;
+    std::vector<uint8_t> m_payload;   // v1: the current event's payload
+    std::vector<uint8_t> m_stored;    // v2: the current block as stored
+    std::vector<uint8_t> m_block;     // v2: the current block decoded
+    size_t m_blockPos = 0;
+    size_t m_blocksRead = 0;
+};
+
+}  // namespace tape_io
@@ -0,0 +1,323 @@
+// ============================================================================
+// core/tape_map.h
+// Random-access tape reader over a memory-mapped file. Where tape_io::Reader
+// streams a tape front to back through a FILE*, MappedTape maps it read-only and
+// keeps an offset table, so a reader can jump to an event ordinal or a recorded
+// time and iterate from there, optionally only the event types it cares about.
+// Shared by the integration harness (PluginHost::replayTape), the native tape
+// tool (tools/mxbmrp3_tape) and tools/mxbmrp3_replay; like tape_io.h it needs
+// nothing beyond the standard library, miniz and the OS mapping call.
+//
+// Offset tables:
+//   v1  one entry per event (its EventFrame's file offset), built by walking the
+//       frames once at open - no payload is touched, so this is a pointer chase
+//       over the mapping. A record cut short at the end is dropped.
+//   v2  one entry per block: the tape's index when it has one, else rebuilt by
+//       walking the BlockHeaders (they carry event count and first timestamp, so
+//       nothing is inflated). Per-event offsets within a block are computed when
+//       the block is decoded.
+//
+// Zero-copy: v1 payloads and BLOCK_STORED blocks point straight into the
+// mapping; a deflated block is inflated once into a per-reader buffer when the
+// iteration enters it, and its payloads point there. A payload pointer stays
+// valid until the iteration moves to another block (v1: until close()).
+// Payloads are NOT aligned - memcpy the fields, or copy the payload, before
+// casting to a game struct.
+//
+//   tape_io::MappedTape t;
+//   if (!t.open(path)) ...;
+//   t.seek(90 * 1000000ull);                       // first event at/after 90 s
+//   t.setTypeFilter(tape_io::MappedTape::typeBit(24));
+//   tape_io::EventFrame ev; const uint8_t* payload;
+//   while (t.next(ev, payload)) ...;
+//
+// Timestamps are assumed non-decreasing (the recorder stamps events in callback
+// order from one steady clock); seek() on a tape that isn't still lands on a
+// valid event, just not necessarily the first one at that time.
+// ============================================================================
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "file_mapping.h"
+#include "tape_io.h"
+
+namespace tape_io {
+
+class MappedTape {
+public:
+    static constexpr uint64_t ALL_TYPES = ~uint64_t{ 0 };
+    // Filter bit of an event type (Recording::EventType value).
+    static constexpr uint64_t typeBit(uint32_t eventType) { return eventType < 64 ? uint64_t{ 1 } << eventType : 0; }
+
+    MappedTape() = default;
+    MappedTape(const MappedTape&) = delete;
+    MappedTape& operator=(const MappedTape&) = delete;
+
+    // Map a tape file. False if it is missing, not MXBHREC or an unknown version.
+    bool open(const char* path) {
+        close();
+        if (m_map.open(path) && attach(m_map.data(), m_map.size())) return true;
+        close();
+        return false;
+    }
+
+    // A tape already in memory (e.g. a gunzipped fixture). The caller keeps the
+    // bytes alive and unchanged until close().
+    bool openBuffer(const uint8_t* data, size_t size) {
+        close();
+        return attach(data, size);
+    }
+
+    void close() {
+        m_map.close();
+        m_data = nullptr;
+        m_size = 0;
+        m_version = 0;
+        m_events.clear();
+        m_blocks.clear();
+        m_indexed = false;
+        m_eventCount = 0;
+        m_pos = 0;
+        m_curBlock = NO_BLOCK;
+        m_curOffsets.clear();
+        m_filter = ALL_TYPES;
+    }
+
+    bool isOpen() const { return m_data != nullptr; }
+    uint32_t version() const { return m_version; }
+    const uint8_t* headerBytes() const { return m_data; }
+    uint32_t headerNumEvents() const {
+        uint32_t n = 0;
+        if (m_data) std::memcpy(&n, m_data + NUM_EVENTS_OFFSET, sizeof(n));
+        return n;
+    }
+    // Events reachable through the offset table (a crash-cut tail excluded).
+    uint64_t eventCount() const { return m_eventCount; }
+    // v2: blocks in the table, and whether it came from the tape's index (false:
+    // rebuilt from the block headers of a tape without one).
+    size_t blockCount() const { return m_blocks.size(); }
+    bool indexed() const { return m_indexed; }
+    // Ordinal of the event the next next() considers (before filtering).
+    uint64_t position() const { return m_pos; }
+
+    // Only yield events whose typeBit() is in mask (ALL_TYPES: everything).
+    void setTypeFilter(uint64_t mask) { m_filter = mask; }
+
+    // Position so next() starts at event n (n == eventCount(): at the end).
+    bool seekEvent(uint64_t n) {
+        if (!m_data || n > m_eventCount) return false;
+        m_pos = n;
+        return true;
+    }
+
+    // Position at the first event with timestampUs >= t (the end if none).
+    bool seek(uint64_t timestampUs) {
+        if (!m_data) return false;
+        if (m_version == VERSION_RAW) {
+            auto it = std::lower_bound(m_events.begin(), m_events.end(), timestampUs,
+                                       [this](uint64_t off, uint64_t t) { return frameAt(off).timestampUs < t; });
+            m_pos = static_cast<uint64_t>(it - m_events.begin());
+            return true;
+        }
+        // The first block starting at/after t; the answer may sit at the end of
+        // the block before it.
+        auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), timestampUs,
+                                   [](const IndexEntry& b, uint64_t t) { return b.firstTimestampUs < t; });
+        size_t b = static_cast<size_t>(it - m_blocks.begin());
+        if (b == 0) { m_pos = 0; return true; }
+        --b;
+        if (!enterBlock(b)) return false;
+        const IndexEntry& e = m_blocks[b];
+        for (uint32_t k = 0; k < e.eventCount; ++k) {
+            if (frameIn(k).timestampUs >= timestampUs) { m_pos = e.firstEvent + k; return true; }
+        }
+        m_pos = e.firstEvent + e.eventCount;
+        return true;
+    }
+
+    // Position at the last StateKeyframe event at/before t, so next() yields it and
+    // then the events that follow. False (position unchanged) if there is none.
+    // v2 finds it from the block headers (BLOCK_KEYFRAME) without decoding; v1
+    // walks its event table back from t.
+    bool seekKeyframe(uint64_t timestampUs) {
+        if (!m_data) return false;
+        if (m_version == VERSION_RAW) {
+            auto it = std::upper_bound(m_events.begin(), m_events.end(), timestampUs,
+                                       [this](uint64_t t, uint64_t off) { return t < frameAt(off).timestampUs; });
+            for (size_t n = static_cast<size_t>(it - m_events.begin()); n-- > 0;) {
+                if (frameAt(m_events[n]).eventType == KEYFRAME_EVENT) { m_pos = n; return true; }
+            }
+            return false;
+        }
+        auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), timestampUs,
+                                   [](uint64_t t, const IndexEntry& b) { return t < b.firstTimestampUs; });
+        for (size_t b = static_cast<size_t>(it - m_blocks.begin()); b-- > 0;) {
+            BlockHeader bh;
+            std::memcpy(&bh, m_data + m_blocks[b].fileOffset, sizeof(bh));
+            if ((bh.flags & BLOCK_KEYFRAME) && m_blocks[b].eventCount > 0) { m_pos = m_blocks[b].firstEvent; return true; }
+        }
+        return false;
+    }
+
+    // The next event passing the filter; false at the end (or a corrupt block).
+    bool next(EventFrame& ev, const uint8_t*& payload) {
+        while (m_pos < m_eventCount) {
+            const uint64_t n = m_pos++;
+            if (m_version == VERSION_RAW) {
+                const uint64_t off = m_events[static_cast<size_t>(n)];
+                ev = frameAt(off);
+                if (!(typeBit(ev.eventType) & m_filter)) continue;
+                payload = m_data + off + sizeof(EventFrame);
+                return true;
+            }
+            if (m_curBlock == NO_BLOCK || n < m_blocks[m_curBlock].firstEvent ||
+                n >= uint64_t{ m_blocks[m_curBlock].firstEvent } + m_blocks[m_curBlock].eventCount) {
+                if (!enterBlock(blockOf(n))) { m_pos = m_eventCount; return false; }
+            }
+            const uint32_t k = static_cast<uint32_t>(n - m_blocks[m_curBlock].firstEvent);
+            ev = frameIn(k);
+            if (!(typeBit(ev.eventType) & m_filter)) continue;
+            payload = m_cur + m_curOffsets[k] + sizeof(EventFrame);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    static constexpr size_t NO_BLOCK = ~size_t{ 0 };
+
+    bool attach(const uint8_t* data, size_t size) {
+        if (size < FILE_HEADER_BYTES || std::memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) return false;
+        std::memcpy(&m_version, data + VERSION_OFFSET, sizeof(m_version));
+        if (m_version != VERSION_RAW && m_version != VERSION_BLOCKS) { m_version = 0; return false; }
+        m_data = data;
+        m_size = size;
+        if (m_version == VERSION_RAW) buildEventTable();
+        else if (!loadIndex()) buildBlockTable();
+        return true;
+    }
+
+    EventFrame frameAt(uint64_t off) const {
+        EventFrame ef;
+        std::memcpy(&ef, m_data + off, sizeof(ef));
+        return ef;
+    }
+
+    EventFrame frameIn(uint32_t k) const {
+        EventFrame ef;
+        std::memcpy(&ef, m_cur + m_curOffsets[k], sizeof(ef));
+        return ef;
+    }
+
+    void buildEventTable() {
+        // The header's count is only a hint (0 on a crash-cut tape, corrupt on a
+        // bad one): never reserve beyond what the file could hold.
+        m_events.reserve(std::min<size_t>(headerNumEvents(), m_size / sizeof(EventFrame)));
+        uint64_t off = FILE_HEADER_BYTES;
+        while (m_size - off >= sizeof(EventFrame)) {
+            const uint64_t bytes = sizeof(EventFrame) + uint64_t{ frameDataSize(m_data + off) };
+            if (bytes > m_size - off) break;   // torn last record
+            m_events.push_back(off);
+            off += bytes;
+        }
+        m_eventCount = m_events.size();
+    }
+
+    // The tape's own index, checked against the mapping (every block in bounds,
+    // ordinals contiguous).
+    bool loadIndex() {
+        IndexFooter footer;
+        if (m_size < FILE_HEADER_BYTES + sizeof(footer)) return false;
+        std::memcpy(&footer, m_data + m_size - sizeof(footer), sizeof(footer));
+        if (std::memcmp(footer.magic, INDEX_MAGIC, sizeof(footer.magic)) != 0) return false;
+        const uint64_t indexBytes = uint64_t{ footer.blockCount } * sizeof(IndexEntry);
+        if (footer.indexOffset < FILE_HEADER_BYTES || footer.indexOffset + indexBytes != m_size - sizeof(footer)) return false;
+        m_blocks.resize(footer.blockCount);
+        if (indexBytes) std::memcpy(m_blocks.data(), m_data + footer.indexOffset, static_cast<size_t>(indexBytes));
+        uint64_t next = 0;
+        for (const IndexEntry& e : m_blocks) {
+            if (e.firstEvent != next || e.fileOffset + sizeof(BlockHeader) > footer.indexOffset) {
+                m_blocks.clear();
+                return false;
+            }
+            next += e.eventCount;
+        }
+        m_indexed = true;
+        m_eventCount = next;
+        return true;
+    }
+
+    // No (valid) index: walk the block headers up to the first incomplete block.
+    void buildBlockTable() {
+        uint64_t off = FILE_HEADER_BYTES, next = 0;
+        while (m_size - off >= sizeof(BlockHeader)) {
+            BlockHeader bh;
+            std::memcpy(&bh, m_data + off, sizeof(bh));
+            if (!blockHeaderValid(bh) || bh.storedBytes > m_size - off - sizeof(bh)) break;
+            m_blocks.push_back({ off, bh.firstTimestampUs, static_cast<uint32_t>(next), bh.eventCount });
+            next += bh.eventCount;
+            off += sizeof(bh) + bh.storedBytes;
+        }
+        m_eventCount = next;
+    }
+
+    size_t blockOf(uint64_t n) const {
+        auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), n,
+                                   [](uint64_t v, const IndexEntry& b) { return v < b.firstEvent; });
+        return static_cast<size_t>(it - m_blocks.begin()) - 1;
+    }
+
+    // Make block b current: decode it (or point into the mapping when it is stored
+    // as-is) and lay out its per-event offsets.
+    bool enterBlock(size_t b) {
+        if (b == m_curBlock) return true;
+        m_curBlock = NO_BLOCK;
+        const IndexEntry& e = m_blocks[b];
+        BlockHeader bh;
+        std::memcpy(&bh, m_data + e.fileOffset, sizeof(bh));
+        const uint8_t* stored = m_data + e.fileOffset + sizeof(bh);
+        if (!blockHeaderValid(bh) || bh.eventCount != e.eventCount ||
+            bh.storedBytes > m_size - e.fileOffset - sizeof(bh)) {
+            return false;
+        }
+        if ((bh.flags & BLOCK_STORED) && !(bh.flags & BLOCK_DELTA)) {
+            if (bh.storedBytes != bh.rawBytes) return false;
+            m_cur = stored;
+        } else {
+            if (!decodeBlock(bh, stored, m_decoded)) return false;
+            m_cur = m_decoded.data();
+        }
+        m_curOffsets.resize(bh.eventCount);
+        uint32_t off = 0;
+        for (uint32_t k = 0; k < bh.eventCount; ++k) {
+            if (bh.rawBytes - off < sizeof(EventFrame)) return false;
+            const uint32_t dataSize = frameDataSize(m_cur + off);
+            if (dataSize > bh.rawBytes - off - sizeof(EventFrame)) return false;
+            m_curOffsets[k] = off;
+            off += static_cast<uint32_t>(sizeof(EventFrame)) + dataSize;
+        }
+        m_curBlock = b;
+        return true;
+    }
+
+    FileMapping m_map;
+    const uint8_t* m_data = nullptr;     // the tape (mapping or caller's buffer)
+    size_t m_size = 0;
+    uint32_t m_version = 0;
+    std::vector<uint64_t> m_events;      // v1: file offset of each EventFrame
+    std::vector<IndexEntry> m_blocks;    // v2: one per block
+    bool m_indexed = false;
+    uint64_t m_eventCount = 0;
+    uint64_t m_pos = 0;
+    uint64_t m_filter = ALL_TYPES;
+    size_t m_curBlock = NO_BLOCK;        // v2: the decoded block
+    const uint8_t* m_cur = nullptr;      // its events (m_decoded, or the mapping)
+    std::vector<uint32_t> m_curOffsets;  // EventFrame offset of each of its events
+    std::vector<uint8_t> m_decoded;
+};
+
+}  // namespace tape_io
@@ -19,9 +19,11 @@
 #include "ui_config.h"
 #include "hud_manager.h"
 #include "companion_window.h"
+#include "frame_export.h"
 #include "../hud/settings_hud.h"
 #include "../hud/standings_hud.h"
 #include "../hud/map_hud.h"
+#include "../hud/radar_hud.h"
 #include "../hud/benchmark_widget.h"
 #include "../hud/event_log_hud.h"
 #include "../hud/notices_hud.h"
@@ -44,6 +46,8 @@
 #include "update_checker.h"
 #include "update_downloader.h"
 #include "http_server.h"
+#include "../diagnostics/tracer.h"
+#include "../diagnostics/alloc_counter.h"
 #include "../game/game_config.h"
 #if GAME_HAS_RECORDER
 #include "event_recorder.h"
@@ -54,6 +58,7 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstring>
 
 extern "C" {
 
@@ -214,6 +219,16 @@ __declspec(dllexport) void MXBMRP3_Test_ShowSettings(int visible) {
 __declspec(dllexport) void MXBMRP3_Test_CompanionWindow(int on) {
     CompanionWindow::getInstance().setEnabled(on != 0);
 }
+// Shared-memory frame export: set [Advanced] frameExport / frameExportWidth (the next
+// Draw reconciles the mapping), and read how many frames were published since the
+// mapping was (re)created — so a reader test can tell drops from never-published.
+__declspec(dllexport) void MXBMRP3_Test_FrameExport(int mode, int width) {
+    UiConfig::getInstance().setFrameExport(mode);
+    UiConfig::getInstance().setFrameExportWidth(width);
+}
+__declspec(dllexport) long long MXBMRP3_Test_FrameExportPublished() {
+    return static_cast<long long>(FrameExport::getInstance().getPublishedFrames());
+}
 __declspec(dllexport) void MXBMRP3_Test_GetActiveTab(char* out, int cap) {
     if (!out || cap <= 0) return;
     const char* name = HudManager::getInstance().getSettingsHud().getActiveTabName();
@@ -649,6 +664,11 @@ __declspec(dllexport) void MXBMRP3_Test_MapSetRotate(int on) {
 __declspec(dllexport) void MXBMRP3_Test_MapSetZoom(int on) {
     HudManager::getInstance().getMapHud().setZoomEnabled(on != 0);
 }
+// Zoom range in meters (clamped by the HUD to 50-500), to animate the view
+// range the way the Range setting / hotkeys do.
+__declspec(dllexport) void MXBMRP3_Test_MapSetZoomDistance(int meters) {
+    HudManager::getInstance().getMapHud().setZoomDistance(static_cast<float>(meters));
+}
 // Legacy preset shim, kept so older drivers/tests keep meaning the same thing:
 // 0=AUTO (adaptive, 100%), 1=HIGH (fixed, 200% = 1.0m), 2=LOW (fixed, 60% ≈
 // 3.3m). New code uses the percent/adaptive hooks below.
@@ -719,6 +739,16 @@ __declspec(dllexport) int MXBMRP3_Test_MapQuadSumSq(double* sumSqX, double* sumS
     if (sumSqY) *sumSqY = sy2;
     return static_cast<int>(quads.size());
 }
+// Wait up to timeoutMs for the track-ribbon LOD pyramid of the latest
+// TrackCenterline to finish its off-thread build. 2 = complete, read from the
+// track geometry cache; 1 = complete, built (and cache written); 0 = still only
+// the coarsest level; -1 = no track loaded.
+__declspec(dllexport) int MXBMRP3_Test_TrackRibbonsWait(int timeoutMs) {
+    const TrackRibbonPyramid& ribbons = HudManager::getInstance().getTrackRibbons();
+    if (!ribbons.current()) return -1;
+    if (!ribbons.testWaitComplete(timeoutMs)) return 0;
+    return ribbons.current()->fromCache ? 2 : 1;
+}
 // Read + reset the accumulated per-phase rebuild time (microseconds), rebuild
 // count (return value), and ribbon-cache hit/miss counts. Attributes the map's
 // per-frame cost to bounds/layout vs ribbon vs markers vs riders.
@@ -735,6 +765,37 @@ __declspec(dllexport) long long MXBMRP3_Test_MapProfile(
     if (ribbonMiss) *ribbonMiss = miss;
     return c;
 }
+__declspec(dllexport) void MXBMRP3_Test_RadarSetVisible(int visible) {
+    HudManager::getInstance().getRadarHud().setVisible(visible != 0);
+}
+// Read + reset RadarHud's static-layer and rider-layer time (microseconds);
+// returns the number of rider-layer renders since the last read.
+__declspec(dllexport) long long MXBMRP3_Test_RadarProfile(double* staticUs, double* ridersUs) {
+    double st = 0, ri = 0; long long c = 0;
+    radarHudReadProfile(st, ri, c);
+    if (staticUs) *staticUs = st;
+    if (ridersUs) *ridersUs = ri;
+    return c;
+}
+
+// --- Rider motion seam. Samples are stamped on arrival and predictions made at
+// Draw time, both on RiderMotion's clock: the extrapolation test injects it (µs;
+// -1 restores the real one) so callback and frame times follow the tape. ---
+__declspec(dllexport) void MXBMRP3_Test_RiderMotionSetNowUs(long long us) {
+    RiderMotion::testSetNowUs(us);
+}
+// The marker position of raceNum dead-reckoned to RiderMotion's now:
+// out[0..4] = posX, posY, posZ, yaw, trackPos. 0 when the rider isn't in the
+// latest RaceTrackPosition batch.
+__declspec(dllexport) int MXBMRP3_Test_RiderMotionPredict(int raceNum, float* out) {
+    Unified::TrackPositionData p;
+    if (!HudManager::getInstance().getRiderMotion().predictRider(raceNum, RiderMotion::nowUs(), p)) return 0;
+    if (out) {
+        out[0] = p.posX; out[1] = p.posY; out[2] = p.posZ;
+        out[3] = p.yaw; out[4] = p.trackPos;
+    }
+    return 1;
+}
 
 // Toggle the developer BenchmarkWidget (always created; normally gated behind
 // developer mode in the UI). on=1 activates the built-in profiler (per-callback +
@@ -746,6 +807,87 @@ __declspec(dllexport) void MXBMRP3_Test_BenchmarkWidget(int on) {
     if (bw) bw->setVisible(on != 0);
 }
 
+// Switch the built-in profiler's collection on/off WITHOUT the BenchmarkWidget:
+// no widget on screen, no per-interval counter resets, no report on exit. For a
+// driver that reads the per-HUD rebuild counters itself (MXBMRP3_Test_BenchmarkHuds).
+__declspec(dllexport) void MXBMRP3_Test_BenchmarkCollect(int on) {
+    PluginData::getInstance().getBenchmarkMetrics().active = (on != 0);
+}
+
+// The profiler's per-HUD rebuild counters: fills up to `max` entries of lastUs
+// (duration of that HUD's latest rebuildRenderData(), us) and counts (rebuilds
+// so far), and returns the number of registered HUDs. A driver polling after each
+// callback sees every rebuild as a count step, so it can histogram lastUs itself
+// (tests/native/tape_bench.cpp). Names via MXBMRP3_Test_BenchmarkHudName.
+__declspec(dllexport) int MXBMRP3_Test_BenchmarkHuds(long long* lastUs, int* counts, int max) {
+    const auto& bm = PluginData::getInstance().getBenchmarkMetrics();
+    for (int i = 0; i < bm.hudCount && i < max; ++i) {
+        if (lastUs) lastUs[i] = bm.huds[i].lastRebuildTimeUs;
+        if (counts) counts[i] = bm.huds[i].rebuildCount;
+    }
+    return bm.hudCount;
+}
+
+__declspec(dllexport) const char* MXBMRP3_Test_BenchmarkHudName(int index) {
+    const auto& bm = PluginData::getInstance().getBenchmarkMetrics();
+    return (index >= 0 && index < bm.hudCount) ? bm.huds[index].name : "";
+}
+
+// Timeline tracer (diagnostics/tracer.h), as the TOGGLE_TRACE hotkey drives it.
+// TraceStop writes the capture under the startup save path, waits for the
+// writer thread and returns the file (empty if none); TraceEvents is the number
+// of events recorded so far.
+__declspec(dllexport) void MXBMRP3_Test_TraceStart() {
+    Tracer::getInstance().start();
+}
+
+__declspec(dllexport) const char* MXBMRP3_Test_TraceStop() {
+    static std::string s_path;
+    s_path = Tracer::getInstance().stop(PluginManager::getInstance().getSavePath());
+    Tracer::getInstance().waitForWrite();
+    return s_path.c_str();
+}
+
+__declspec(dllexport) long long MXBMRP3_Test_TraceEvents() {
+    return static_cast<long long>(Tracer::getInstance().eventsRecorded());
+}
+
+// Heap allocation accounting (diagnostics/alloc_counter.h). AllocThreadCounts
+// fills the CALLING thread's allocations / requested bytes per phase (index =
+// AllocCounter::Phase; the harness calls every export on one thread, which is
+// the game thread in legacy mode); AllocTotals the same over all threads since
+// the last AllocResetTotals. Both return the phase count.
+__declspec(dllexport) int MXBMRP3_Test_AllocCounting() {
+    return AllocCounter::enabled() ? 1 : 0;
+}
+
+__declspec(dllexport) int MXBMRP3_Test_AllocThreadCounts(long long* allocs, long long* bytes, int max) {
+    for (int i = 0; i < AllocCounter::PHASE_COUNT && i < max; ++i) {
+        const AllocCounter::Counts c = AllocCounter::threadCounts(static_cast<AllocCounter::Phase>(i));
+        if (allocs) allocs[i] = static_cast<long long>(c.allocs);
+        if (bytes) bytes[i] = static_cast<long long>(c.bytes);
+    }
+    return AllocCounter::PHASE_COUNT;
+}
+
+__declspec(dllexport) int MXBMRP3_Test_AllocTotals(long long* allocs, long long* bytes, int max) {
+    for (int i = 0; i < AllocCounter::PHASE_COUNT && i < max; ++i) {
+        const AllocCounter::Counts c = AllocCounter::totalCounts(static_cast<AllocCounter::Phase>(i));
+        if (allocs) allocs[i] = static_cast<long long>(c.allocs);
+        if (bytes) bytes[i] = static_cast<long long>(c.bytes);
+    }
+    return AllocCounter::PHASE_COUNT;
+}
+
+__declspec(dllexport) void MXBMRP3_Test_AllocResetTotals() {
+    AllocCounter::resetTotals();
+}
+
+__declspec(dllexport) const char* MXBMRP3_Test_AllocPhaseName(int phase) {
+    return (phase >= 0 && phase < AllocCounter::PHASE_COUNT)
+        ? AllocCounter::phaseName(static_cast<AllocCounter::Phase>(phase)) : "";
+}
+
 // Force every HUD/widget visible (or hidden) so the benchmark driver can profile
 // the plugin with EVERYTHING enabled, not just the default-on HUDs.
 __declspec(dllexport) void MXBMRP3_Test_ShowAllHuds(int on) {
@@ -1013,6 +1155,22 @@ __declspec(dllexport) int MXBMRP3_Test_RecordsFetchState() {
 }
 #endif
 
+// PluginData state keyframes (plugin_data_keyframe.cpp). CaptureKeyframe copies
+// the serialized state into out if it fits and returns its size either way (call
+// again with a bigger buffer); RestoreKeyframe returns 1 on success. keyframe_test
+// uses these to build keyframed tapes offline and start replays mid-session.
+__declspec(dllexport) int MXBMRP3_Test_CaptureKeyframe(uint8_t* out, int cap) {
+    static std::vector<uint8_t> buf;
+    PluginData::getInstance().writeKeyframe(buf);
+    if (out && cap >= static_cast<int>(buf.size())) memcpy(out, buf.data(), buf.size());
+    return static_cast<int>(buf.size());
+}
+__declspec(dllexport) int MXBMRP3_Test_RestoreKeyframe(const void* data, int size) {
+    if (!data || size <= 0) return 0;
+    return PluginData::getInstance().restoreKeyframe(static_cast<const uint8_t*>(data),
+                                                     static_cast<size_t>(size)) ? 1 : 0;
+}
+
 #if GAME_HAS_RECORDER
 // Callback-tape recorder: open a tape at an explicit path and finalize it. Lets a
 // test record the live callback stream it drives, then replay the produced tape
@@ -1026,6 +1184,20 @@ __declspec(dllexport) int MXBMRP3_Test_StartRecording(const char* path) {
 __declspec(dllexport) void MXBMRP3_Test_StopRecording() {
     EventRecorder::getInstance().stopRecording();
 }
+// State keyframe interval ([Recorder] keyframeSeconds; 0 = none).
+__declspec(dllexport) void MXBMRP3_Test_SetKeyframeSeconds(int seconds) {
+    EventRecorder::getInstance().setKeyframeSeconds(seconds);
+}
+// Game-thread cost of the current/last recording (EventRecorder::getStats), for
+// recorder_test and the perf driver. Any pointer may be null.
+__declspec(dllexport) void MXBMRP3_Test_RecorderStats(long long* events, double* avgEventNs,
+                                                     double* maxEventUs, long long* buffersWritten) {
+    const EventRecorder::Stats st = EventRecorder::getInstance().getStats();
+    if (events) *events = static_cast<long long>(st.events);
+    if (avgEventNs) *avgEventNs = st.avgEventNs;
+    if (maxEventUs) *maxEventUs = st.maxEventUs;
+    if (buffersWritten) *buffersWritten = static_cast<long long>(st.buffersWritten);
+}
 #endif
 
 } // extern "C"
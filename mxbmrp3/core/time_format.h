@@ -0,0 +1,176 @@
+// ============================================================================
+// core/time_format.h
+// snprintf-free kernels behind PluginUtils::formatLapTime / formatTimeDiff /
+// formatLapTimeTenths / formatGapCompact, plus a small memo over them.
+//
+// Timing-heavy HUDs (standings, lap log, timing, pitboard, ideal lap) format a
+// time for every cell on every rebuild, and snprintf's format-string parsing was
+// most of that cost (standings_perf_driver's "format" phase). The kernels write
+// digits straight from a two-digit lookup table into a fixed-width scratch and
+// copy it out with snprintf's truncation rule, so output is byte-identical to
+// the printf formats they replace (pinned by tests/unit/test_plugin_utils.cpp).
+//
+// Pure standard C++: the compact ("short time format") flag is a parameter here;
+// the PluginUtils wrappers read it from PluginData.
+// ============================================================================
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace time_format {
+
+enum class Mode : uint8_t {
+    LAP = 0,          // "M:SS.mmm"; compact and < 1 min -> "S.mmm"; negative -> ""
+    DIFF = 1,         // "+M:SS.mmm"; compact and < 1 min -> "+S.mmm"
+    LAP_TENTHS = 2,   // "M:SS.s";   compact and < 1 min -> "S.s";   negative -> ""
+    GAP_COMPACT = 3,  // "+S.s" below 1 min, else "+M:SS.s" (compact flag unused)
+};
+
+// Longest output: sign + 5 minute digits (INT_MAX ms) + ":SS.mmm".
+constexpr size_t MAX_LEN = 13;
+
+namespace detail {
+constexpr char DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline char* put2(char* p, unsigned v) {
+    std::memcpy(p, DIGIT_PAIRS + 2 * v, 2);
+    return p + 2;
+}
+
+inline char* put3(char* p, unsigned v) {
+    *p++ = static_cast<char>('0' + v / 100);
+    return put2(p, v % 100);
+}
+
+// "%d" for a non-negative value, no padding.
+inline char* putUint(char* p, unsigned v) {
+    char tmp[10];
+    char* t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        const unsigned q = v / 100;
+        t -= 2;
+        std::memcpy(t, DIGIT_PAIRS + 2 * (v - q * 100), 2);
+        v = q;
+    }
+    if (v >= 10) {
+        t -= 2;
+        std::memcpy(t, DIGIT_PAIRS + 2 * v, 2);
+    } else {
+        *--t = static_cast<char>('0' + v);
+    }
+    const size_t n = static_cast<size_t>(tmp + sizeof(tmp) - t);
+    std::memcpy(p, t, n);
+    return p + n;
+}
+}  // namespace detail
+
+// Format into out (at least MAX_LEN + 1 bytes, NUL-terminated); returns the length.
+inline size_t write(Mode mode, int value, bool compact, char* out) {
+    char* p = out;
+    unsigned abs;
+    if (mode == Mode::DIFF || mode == Mode::GAP_COMPACT) {
+        // Signed modes: same INT_MIN guard as the original (-INT_MIN caps at INT_MAX).
+        *p++ = value < 0 ? '-' : '+';
+        if (value >= 0)                                   abs = static_cast<unsigned>(value);
+        else if (value == std::numeric_limits<int>::min()) abs = static_cast<unsigned>(std::numeric_limits<int>::max());
+        else                                              abs = static_cast<unsigned>(-value);
+    } else {
+        if (value < 0) { out[0] = '\0'; return 0; }
+        abs = static_cast<unsigned>(value);
+    }
+
+    const unsigned minutes = abs / 60000;
+    const unsigned seconds = (abs % 60000) / 1000;
+    const unsigned millis = abs % 1000;
+    const bool tenths = (mode == Mode::LAP_TENTHS || mode == Mode::GAP_COMPACT);
+    const bool dropMinutes = (mode == Mode::GAP_COMPACT) ? minutes == 0 : (compact && minutes == 0);
+
+    if (dropMinutes) {
+        p = detail::putUint(p, seconds);
+    } else {
+        p = detail::putUint(p, minutes);
+        *p++ = ':';
+        p = detail::put2(p, seconds);
+    }
+    *p++ = '.';
+    if (tenths) *p++ = static_cast<char>('0' + millis / 100);
+    else        p = detail::put3(p, millis);
+    *p = '\0';
+    return static_cast<size_t>(p - out);
+}
+
+// Copy len bytes of src into buffer the way snprintf would have written them:
+// truncated to bufferSize - 1 and always NUL-terminated; nothing for size 0.
+inline void copyTruncated(const char* src, size_t len, char* buffer, size_t bufferSize) {
+    if (bufferSize == 0) return;
+    const size_t n = len < bufferSize - 1 ? len : bufferSize - 1;
+    std::memcpy(buffer, src, n);
+    buffer[n] = '\0';
+}
+
+// Memo keyed by (value, mode, compact). A standings rebuild formats mostly the
+// same best laps and slowly-moving gaps as the last one, so a hit replaces the
+// formatting with a 16-byte copy; a miss formats into the least-recently-used way
+// of its set. Two-way so a pair of cells that hash alike doesn't thrash every
+// rebuild. Per HUD (not global) so one HUD's churn can't evict another's cells.
+class Memo {
+public:
+    // A full standings table is ~100 distinct cells (best, last, gap per rider);
+    // 256 sets x 2 ways hold that with few collisions at ~10 KB per HUD.
+    static constexpr int SET_BITS = 8;
+    static constexpr size_t SETS = size_t{ 1 } << SET_BITS;
+
+    void format(Mode mode, int value, bool compact, char* buffer, size_t bufferSize) {
+        const uint8_t key = static_cast<uint8_t>(static_cast<uint8_t>(mode) | (compact ? 0x04 : 0));
+        Entry* set = m_entries[setOf(value, key)];
+        if (set[0].key != key || set[0].value != value) {
+            if (set[1].key == key && set[1].value == value) {
+                std::swap(set[0], set[1]);            // way 0 is most recently used
+                ++m_hits;
+            } else {
+                set[1] = set[0];
+                set[0].len = static_cast<uint8_t>(write(mode, value, compact, set[0].text));
+                set[0].value = value;
+                set[0].key = key;
+                ++m_misses;
+            }
+        } else {
+            ++m_hits;
+        }
+        copyTruncated(set[0].text, set[0].len, buffer, bufferSize);
+    }
+
+    uint32_t hits() const { return m_hits; }
+    uint32_t misses() const { return m_misses; }
+
+private:
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    struct Entry {
+        int value = 0;
+        uint8_t key = EMPTY;
+        uint8_t len = 0;
+        char text[MAX_LEN + 1] = {};
+    };
+
+    static size_t setOf(int value, uint8_t key) {
+        // Multiply-xorshift mix of value and key, so the four modes of one value and
+        // neighbouring values spread over unrelated sets.
+        uint32_t h = static_cast<uint32_t>(value) * 0x9E3779B1u + key * 0x85EBCA77u;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        return h >> (32 - SET_BITS);
+    }
+
+    Entry m_entries[SETS][2];
+    uint32_t m_hits = 0;
+    uint32_t m_misses = 0;
+};
+
+}  // namespace time_format
@@ -0,0 +1,231 @@
+// ============================================================================
+// core/track_geometry_cache.cpp
+// Track geometry cache file: layout, load (memory-mapped) and save. See
+// track_geometry_cache.h.
+//
+// Layout (all fields native-endian, 4-byte aligned throughout):
+//   Header   magic "MXBTGEO\0", version, numSegments, segmentHash (u64),
+//            levelCount, familyCount, chunk, finestSpacing, bounds (4 floats)
+//   Arc      (numSegments + 1) x ArcPoint
+//   Ribbons  familyCount x levelCount, each: u32 samples, u32 chunks,
+//            cx[samples] cy[samples] upx[samples] upy[samples], chunks x ChunkBounds
+// ============================================================================
+#include "track_geometry_cache.h"
+
+#include <cstring>
+
+#include "../diagnostics/logger.h"
+#include "atomic_file_writer.h"
+#include "file_mapping.h"
+
+#include <windows.h>
+
+namespace TrackGeometryCache {
+
+namespace {
+    constexpr char MAGIC[8] = { 'M', 'X', 'B', 'T', 'G', 'E', 'O', '\0' };
+    constexpr const char* CACHE_SUBDIRECTORY = "mxbmrp3\\trackcache";
+    constexpr const char* CACHE_EXTENSION = ".geo";
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t numSegments;
+        uint64_t segmentHash;
+        uint32_t levelCount;
+        uint32_t familyCount;
+        uint32_t chunk;
+        float finestSpacing;
+        TrackRibbonPyramid::Bounds bounds;
+    };
+    static_assert(sizeof(Header) == 56, "track cache header layout");
+    static_assert(sizeof(TrackModel::ArcPoint) == 16, "track cache ArcPoint layout");
+    static_assert(sizeof(TrackRibbonPyramid::ChunkBounds) == 16, "track cache ChunkBounds layout");
+
+    template <typename T>
+    void append(std::string& out, const T* data, size_t count) {
+        out.append(reinterpret_cast<const char*>(data), sizeof(T) * count);
+    }
+
+    // Bounds-checked sequential reads over the mapping.
+    struct Cursor {
+        const uint8_t* p;
+        size_t left;
+
+        template <typename T>
+        bool read(T* out, size_t count) {
+            const size_t bytes = sizeof(T) * count;
+            if (bytes > left) return false;
+            if (bytes) std::memcpy(out, p, bytes);
+            p += bytes;
+            left -= bytes;
+            return true;
+        }
+        template <typename T>
+        bool readVector(std::vector<T>& out, size_t count, bool skip = false) {
+            const size_t bytes = sizeof(T) * count;
+            if (bytes > left) return false;   // before sizing anything by a garbage count
+            if (!skip) {
+                // Straight from the mapping (every array is 4-byte aligned in the
+                // file), without zero-filling a resize first.
+                const T* first = reinterpret_cast<const T*>(p);
+                out.assign(first, first + count);
+            }
+            p += bytes;
+            left -= bytes;
+            return true;
+        }
+    };
+
+    // FNV-1a over 32-bit words instead of bytes: every segment field is 4 bytes,
+    // and a byte-wise pass over a long track was ~0.1 ms of the load callback.
+    template <typename T>
+    void hashWord(uint64_t& h, const T& field) {
+        static_assert(sizeof(T) == sizeof(uint32_t), "segment fields are 32-bit");
+        uint32_t word;
+        std::memcpy(&word, &field, sizeof(word));
+        h ^= word;
+        h *= 1099511628211ull;
+    }
+}
+
+uint64_t hashSegments(const std::vector<Unified::TrackSegment>& segments) {
+    uint64_t h = 14695981039346656037ull;
+    for (const Unified::TrackSegment& s : segments) {
+        // Field by field: the struct's padding (if any) is not part of the key.
+        hashWord(h, s.type);
+        hashWord(h, s.length);
+        hashWord(h, s.radius);
+        hashWord(h, s.angle);
+        hashWord(h, s.startX);
+        hashWord(h, s.startY);
+        hashWord(h, s.height);
+    }
+    return h;
+}
+
+std::string filePath(const char* savePath, const char* trackId) {
+    if (!trackId || !trackId[0]) {
+        return std::string();
+    }
+    std::string path = (savePath && savePath[0]) ? savePath : ".";
+    if (path.back() != '/' && path.back() != '\\') {
+        path += '\\';
+    }
+    path += CACHE_SUBDIRECTORY;
+    path += '\\';
+    // Track ids are short folder names; keep the file name portable regardless.
+    for (const char* c = trackId; *c; ++c) {
+        const char ch = *c;
+        const bool safe = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+                          (ch >= '0' && ch <= '9') || ch == '_' || ch == '-' || ch == '.';
+        path += safe ? ch : '_';
+    }
+    path += CACHE_EXTENSION;
+    return path;
+}
+
+bool load(const std::string& path, uint64_t segmentHash, size_t numSegments,
+          TrackRibbonPyramid::Levels& out, bool coarseOnly) {
+    FileMapping map;
+    if (!map.open(path.c_str())) {
+        return false;   // no cache yet (the common cold case, not worth a log line)
+    }
+    Cursor in{ map.data(), map.size() };
+
+    Header h;
+    if (!in.read(&h, 1) || std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        DEBUG_WARN_F("TrackGeometryCache: %s is not a track cache, rebuilding", path.c_str());
+        return false;
+    }
+    if (h.version != FORMAT_VERSION || h.segmentHash != segmentHash || h.numSegments != numSegments ||
+        h.levelCount != TrackRibbonPyramid::LEVEL_COUNT || h.familyCount != TrackRibbonPyramid::FAMILY_COUNT ||
+        h.chunk != TrackRibbonPyramid::CHUNK || h.finestSpacing != TrackRibbonPyramid::FINEST_SPACING) {
+        DEBUG_INFO_F("TrackGeometryCache: %s is stale (track or format changed), rebuilding", path.c_str());
+        return false;
+    }
+
+    out.bounds = h.bounds;
+    out.segmentHash = segmentHash;
+    bool ok = in.readVector(out.arc, numSegments + 1);
+    for (auto& family : out.ribbons) {
+        for (int level = 0; level < TrackRibbonPyramid::LEVEL_COUNT; ++level) {
+            TrackRibbonPyramid::Ribbon& ribbon = family[level];
+            // Skipped levels are still walked, so their sizes are validated too.
+            const bool skip = coarseOnly && level != TrackRibbonPyramid::COARSEST_LEVEL;
+            uint32_t samples = 0, chunks = 0;
+            ok = ok && in.read(&samples, 1) && in.read(&chunks, 1)
+                 && chunks == (samples + TrackRibbonPyramid::CHUNK - 1) / TrackRibbonPyramid::CHUNK
+                 && in.readVector(ribbon.cx, samples, skip) && in.readVector(ribbon.cy, samples, skip)
+                 && in.readVector(ribbon.upx, samples, skip) && in.readVector(ribbon.upy, samples, skip)
+                 && in.readVector(ribbon.chunks, chunks, skip);
+        }
+    }
+    if (!ok || in.left != 0) {
+        DEBUG_WARN_F("TrackGeometryCache: %s is truncated or corrupt, rebuilding", path.c_str());
+        return false;
+    }
+    out.complete = !coarseOnly;
+    out.fromCache = true;
+    return true;
+}
+
+bool save(const std::string& path, const TrackRibbonPyramid::Levels& levels, size_t numSegments) {
+    if (path.empty() || !levels.complete || levels.arc.size() != numSegments + 1) {
+        return false;
+    }
+
+    // <save>\mxbmrp3 may not exist yet either: create both levels.
+    const size_t fileSep = path.find_last_of('\\');
+    if (fileSep != std::string::npos) {
+        const std::string cacheDir = path.substr(0, fileSep);
+        const size_t dirSep = cacheDir.find_last_of('\\');
+        if (dirSep != std::string::npos) {
+            CreateDirectoryA(cacheDir.substr(0, dirSep).c_str(), NULL);
+        }
+        CreateDirectoryA(cacheDir.c_str(), NULL);
+    }
+
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.numSegments = static_cast<uint32_t>(numSegments);
+    h.segmentHash = levels.segmentHash;
+    h.levelCount = TrackRibbonPyramid::LEVEL_COUNT;
+    h.familyCount = TrackRibbonPyramid::FAMILY_COUNT;
+    h.chunk = TrackRibbonPyramid::CHUNK;
+    h.finestSpacing = TrackRibbonPyramid::FINEST_SPACING;
+    h.bounds = levels.bounds;
+
+    size_t bytes = sizeof(Header) + levels.arc.size() * sizeof(TrackModel::ArcPoint);
+    for (const auto& family : levels.ribbons) {
+        for (const TrackRibbonPyramid::Ribbon& ribbon : family) {
+            bytes += 2 * sizeof(uint32_t) + 4 * sizeof(float) * ribbon.size()
+                   + sizeof(TrackRibbonPyramid::ChunkBounds) * ribbon.chunks.size();
+        }
+    }
+    std::string out;
+    out.reserve(bytes);
+    append(out, &h, 1);
+    append(out, levels.arc.data(), levels.arc.size());
+    for (const auto& family : levels.ribbons) {
+        for (const TrackRibbonPyramid::Ribbon& ribbon : family) {
+            const uint32_t counts[2] = { static_cast<uint32_t>(ribbon.size()),
+                                         static_cast<uint32_t>(ribbon.chunks.size()) };
+            append(out, counts, 2);
+            append(out, ribbon.cx.data(), ribbon.size());
+            append(out, ribbon.cy.data(), ribbon.size());
+            append(out, ribbon.upx.data(), ribbon.size());
+            append(out, ribbon.upy.data(), ribbon.size());
+            append(out, ribbon.chunks.data(), ribbon.chunks.size());
+        }
+    }
+
+    if (!AtomicFileWriter::writeFileAtomic(path, out)) {
+        return false;   // AtomicFileWriter logged why
+    }
+    DEBUG_INFO_F("TrackGeometryCache: wrote %s (%zu bytes)", path.c_str(), out.size());
+    return true;
+}
+
+}  // namespace TrackGeometryCache
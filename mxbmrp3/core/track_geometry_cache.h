@@ -0,0 +1,51 @@
+// ============================================================================
+// core/track_geometry_cache.h
+// On-disk cache of the geometry derived from a track's centerline: bounds,
+// arc-length table and every TrackRibbonPyramid level. One file per track,
+//   <savePath>\mxbmrp3\trackcache\<trackId>.geo
+// validated on load by FORMAT_VERSION and a hash of the segment array, so a
+// changed track (or a changed sampler — bump FORMAT_VERSION) just misses and
+// the next build overwrites the file.
+//
+// load() memory-maps the file (core/file_mapping.h) and copies the arrays
+// straight into a TrackRibbonPyramid::Levels: no arc walk, no trig. The finer
+// levels are most of the file (megabytes on a long track), so the track-load
+// path reads only the coarse part (coarseOnly) and the pyramid's worker copies
+// the rest. save()
+// serializes a complete Levels through AtomicFileWriter, so a crash mid-write
+// never leaves a truncated cache behind. Native byte order and float layout
+// (the file never leaves the machine that wrote it).
+// ============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "track_ribbon_pyramid.h"
+
+namespace TrackGeometryCache {
+
+// Bump whenever the file layout OR anything that derives the cached geometry
+// (TrackRibbonPyramid::buildRibbon / computeBounds, TrackModel::buildArcTable,
+// the level ladder) changes: old files then miss and are rebuilt.
+constexpr uint32_t FORMAT_VERSION = 1;
+
+// FNV-1a (32-bit words) over every field of every segment.
+uint64_t hashSegments(const std::vector<Unified::TrackSegment>& segments);
+
+// The cache file for a track, or empty when there is no track id to key it by.
+std::string filePath(const char* savePath, const char* trackId);
+
+// Fill `out` (bounds, arc table, every level; complete + fromCache set) from the
+// file at `path` if it exists, is intact and matches hash/numSegments.
+// coarseOnly: only COARSEST_LEVEL's ribbons (complete stays false); the whole
+// file is still validated.
+bool load(const std::string& path, uint64_t segmentHash, size_t numSegments,
+          TrackRibbonPyramid::Levels& out, bool coarseOnly = false);
+
+// Write a complete Levels (creates the trackcache directory if needed).
+bool save(const std::string& path, const TrackRibbonPyramid::Levels& levels, size_t numSegments);
+
+}  // namespace TrackGeometryCache
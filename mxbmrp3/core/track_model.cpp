@@ -0,0 +1,245 @@
+// ============================================================================
+// core/track_model.cpp
+// Arc-length table, uniform pose table and nearest-point grid for a track
+// centerline. See track_model.h.
+// ============================================================================
+#include "track_model.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // PluginConstants::TrackSegmentType::STRAIGHT (this TU stays free of the
+    // plugin headers so the unit tests can build it standalone).
+    constexpr int SEGMENT_STRAIGHT = 0;
+
+    // Nearest-point grid: cells span a few samples of track, and the grid has
+    // at most GRID_CELLS_PER_SAMPLE cells per sample (a sprawling enduro loop
+    // gets bigger cells rather than a mostly empty multi-megabyte grid).
+    constexpr float GRID_SAMPLES_PER_CELL = 4.0f;
+    constexpr float GRID_CELLS_PER_SAMPLE = 4.0f;
+
+    float segmentRadius(const Unified::TrackSegment& segment) {
+        return (segment.type == SEGMENT_STRAIGHT) ? 0.0f : segment.radius;
+    }
+}
+
+// ============================================================================
+// Exact layer
+// ============================================================================
+
+// The walk MapHud::centerlinePositionAt used to repeat per lookup, done once.
+void TrackModel::buildArcTable(const std::vector<Unified::TrackSegment>& segments,
+                               std::vector<ArcPoint>& out) {
+    out.clear();
+    if (segments.empty()) {
+        return;
+    }
+    out.reserve(segments.size() + 1);
+
+    float accumulated = 0.0f;
+    float currentX = segments[0].startX;
+    float currentY = segments[0].startY;
+    float currentAngle = segments[0].angle;  // degrees, 0 = north
+    out.push_back({ accumulated, currentX, currentY, currentAngle });
+    for (const auto& segment : segments) {
+        // Advance to end of this segment (exact, straight or arc)
+        advanceAlongArc(currentX, currentY, currentAngle, segmentRadius(segment), segment.length);
+        accumulated += segment.length;
+        out.push_back({ accumulated, currentX, currentY, currentAngle });
+    }
+}
+
+bool TrackModel::positionAt(const std::vector<ArcPoint>& arc,
+                            const std::vector<Unified::TrackSegment>& segments,
+                            float meters, float& outX, float& outY, float& outAngleDeg) {
+    if (arc.size() != segments.size() + 1 || segments.empty() || meters < 0.0f) {
+        return false;
+    }
+
+    // The target lies in the first segment whose END is at/after it.
+    auto end = std::lower_bound(arc.begin() + 1, arc.end(), meters,
+                                [](const ArcPoint& p, float m) { return p.distance < m; });
+    if (end == arc.end()) {
+        return false;  // meters past end of track
+    }
+    const size_t i = static_cast<size_t>(end - arc.begin()) - 1;
+
+    // Exact position/heading at the target offset (straight or arc).
+    outX = arc[i].x;
+    outY = arc[i].y;
+    outAngleDeg = arc[i].headingDeg;
+    advanceAlongArc(outX, outY, outAngleDeg, segmentRadius(segments[i]), meters - arc[i].distance);
+    return true;
+}
+
+// ============================================================================
+// Uniform layer
+// ============================================================================
+
+void TrackModel::build(const std::vector<Unified::TrackSegment>& segments, const std::vector<ArcPoint>& arc,
+                       float sfMeters) {
+    *this = TrackModel();
+    if (segments.empty() || arc.size() != segments.size() + 1 || !(arc.back().distance > 0.0f)) {
+        return;
+    }
+    m_length = arc.back().distance;
+    m_sfMeters = (sfMeters > 0.0f) ? std::fmod(sfMeters, m_length) : 0.0f;
+
+    const size_t n = std::clamp(static_cast<size_t>(std::ceil(m_length / TABLE_SPACING)),
+                                MIN_TABLE_SAMPLES, MAX_TABLE_SAMPLES);
+    m_step = m_length / static_cast<float>(n);
+    m_invStep = static_cast<float>(n) / m_length;
+
+    // One forward pass: sample k lands in the same segment positionAt() would
+    // pick (the first whose end is at/after it) and is placed exactly.
+    m_x.resize(n + 1);
+    m_y.resize(n + 1);
+    m_heading.resize(n + 1);
+    size_t seg = 0;
+    for (size_t k = 0; k <= n; ++k) {
+        const float d = (k == n) ? m_length : static_cast<float>(k) * m_step;
+        while (seg + 1 < segments.size() && arc[seg + 1].distance < d) {
+            ++seg;
+        }
+        float x = arc[seg].x, y = arc[seg].y, heading = arc[seg].headingDeg;
+        advanceAlongArc(x, y, heading, segmentRadius(segments[seg]), d - arc[seg].distance);
+        m_x[k] = x;
+        m_y[k] = y;
+        m_heading[k] = heading;
+    }
+
+    // Bucket grid over the samples.
+    const auto [minX, maxX] = std::minmax_element(m_x.begin(), m_x.end());
+    const auto [minY, maxY] = std::minmax_element(m_y.begin(), m_y.end());
+    const float area = (*maxX - *minX) * (*maxY - *minY);
+    m_cellSize = std::max({ m_step * GRID_SAMPLES_PER_CELL,
+                            std::sqrt(area / (static_cast<float>(n) * GRID_CELLS_PER_SAMPLE)), 0.001f });
+    m_gridMinX = *minX;
+    m_gridMinY = *minY;
+    m_gridW = static_cast<int>((*maxX - *minX) / m_cellSize) + 1;
+    m_gridH = static_cast<int>((*maxY - *minY) / m_cellSize) + 1;
+
+    auto cellOf = [&](size_t k) {
+        const int cx = std::min(static_cast<int>((m_x[k] - m_gridMinX) / m_cellSize), m_gridW - 1);
+        const int cy = std::min(static_cast<int>((m_y[k] - m_gridMinY) / m_cellSize), m_gridH - 1);
+        return static_cast<size_t>(cy) * m_gridW + cx;
+    };
+    m_cellStart.assign(static_cast<size_t>(m_gridW) * m_gridH + 1, 0);
+    for (size_t k = 0; k < n; ++k) {
+        ++m_cellStart[cellOf(k) + 1];
+    }
+    for (size_t c = 1; c < m_cellStart.size(); ++c) {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+    m_cellItems.resize(n);
+    std::vector<uint32_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t k = 0; k < n; ++k) {
+        m_cellItems[fill[cellOf(k)]++] = static_cast<uint32_t>(k);
+    }
+}
+
+float TrackModel::distanceAt(float trackPos) const {
+    if (!(m_length > 0.0f)) return 0.0f;
+    float meters = std::fmod(trackPos * m_length + m_sfMeters, m_length);
+    if (meters < 0.0f) meters += m_length;
+    return meters;
+}
+
+float TrackModel::trackPosAt(float meters) const {
+    if (!(m_length > 0.0f)) return 0.0f;
+    float pos = (meters - m_sfMeters) / m_length;
+    pos -= std::floor(pos);
+    return (pos >= 1.0f) ? 0.0f : pos;   // floor rounding can leave exactly 1
+}
+
+void TrackModel::locate(float meters, size_t& index, float& t) const {
+    const size_t n = m_x.size() - 1;
+    const float f = std::clamp(meters * m_invStep, 0.0f, static_cast<float>(n));
+    index = std::min(static_cast<size_t>(f), n - 1);
+    t = f - static_cast<float>(index);
+}
+
+void TrackModel::worldAt(float trackPos, float& outX, float& outY) const {
+    if (!valid()) { outX = outY = 0.0f; return; }
+    size_t k; float t;
+    locate(distanceAt(trackPos), k, t);
+    outX = m_x[k] + (m_x[k + 1] - m_x[k]) * t;
+    outY = m_y[k] + (m_y[k + 1] - m_y[k]) * t;
+}
+
+float TrackModel::headingAt(float trackPos) const {
+    if (!valid()) return 0.0f;
+    size_t k; float t;
+    locate(distanceAt(trackPos), k, t);
+    float heading = std::fmod(m_heading[k] + (m_heading[k + 1] - m_heading[k]) * t, 360.0f);
+    return (heading < 0.0f) ? heading + 360.0f : heading;
+}
+
+void TrackModel::poseAt(float trackPos, float& outX, float& outY, float& outHeadingDeg) const {
+    worldAt(trackPos, outX, outY);
+    outHeadingDeg = headingAt(trackPos);
+}
+
+float TrackModel::nearestTrackPos(float x, float y, float* outDistance) const {
+    if (!valid()) return -1.0f;
+
+    // Every point of piece [k, k+1] is within m_step of sample k, so once a ring
+    // of cells is further than (best + m_step) nothing beyond it can win.
+    const int qx = std::clamp(static_cast<int>(std::floor((x - m_gridMinX) / m_cellSize)), 0, m_gridW - 1);
+    const int qy = std::clamp(static_cast<int>(std::floor((y - m_gridMinY) / m_cellSize)), 0, m_gridH - 1);
+    float bestSq = std::numeric_limits<float>::infinity();
+    float bestMeters = 0.0f;
+
+    auto testCell = [&](int cx, int cy) {
+        const size_t cell = static_cast<size_t>(cy) * m_gridW + cx;
+        for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+            const uint32_t k = m_cellItems[i];
+            const float ax = m_x[k], ay = m_y[k];
+            const float abx = m_x[k + 1] - ax, aby = m_y[k + 1] - ay;
+            const float lenSq = abx * abx + aby * aby;
+            float t = (lenSq > 0.0f) ? ((x - ax) * abx + (y - ay) * aby) / lenSq : 0.0f;
+            t = std::clamp(t, 0.0f, 1.0f);
+            const float dx = x - (ax + abx * t), dy = y - (ay + aby * t);
+            const float dSq = dx * dx + dy * dy;
+            if (dSq < bestSq) {
+                bestSq = dSq;
+                bestMeters = (static_cast<float>(k) + t) * m_step;
+            }
+        }
+    };
+    auto cellDistance = [&](int cx, int cy) {
+        const float x0 = m_gridMinX + cx * m_cellSize, y0 = m_gridMinY + cy * m_cellSize;
+        const float dx = std::max({ x0 - x, 0.0f, x - (x0 + m_cellSize) });
+        const float dy = std::max({ y0 - y, 0.0f, y - (y0 + m_cellSize) });
+        return std::sqrt(dx * dx + dy * dy);
+    };
+
+    const int maxRing = std::max({ qx, qy, m_gridW - 1 - qx, m_gridH - 1 - qy });
+    for (int r = 0; r <= maxRing; ++r) {
+        const float reach = std::sqrt(bestSq) + m_step;   // inf until something is found
+        bool ringInReach = false;
+        for (int cy = qy - r; cy <= qy + r; ++cy) {
+            if (cy < 0 || cy >= m_gridH) continue;
+            const bool edgeRow = (cy == qy - r || cy == qy + r);
+            for (int cx = qx - r; cx <= qx + r; cx += (edgeRow ? 1 : 2 * r)) {
+                if (cx >= 0 && cx < m_gridW && cellDistance(cx, cy) <= reach) {
+                    ringInReach = true;
+                    testCell(cx, cy);
+                }
+                if (r == 0) break;
+            }
+        }
+        if (!ringInReach && r > 0) break;   // rings only get further from here
+    }
+
+    if (outDistance) *outDistance = std::sqrt(bestSq);
+    return trackPosAt(bestMeters);
+}
+
+float TrackModel::separationMeters(float trackPosA, float trackPosB) const {
+    float d = std::abs(trackPosA - trackPosB);
+    d -= std::floor(d);
+    if (d > 0.5f) d = 1.0f - d;   // the other way round the lap
+    return d * m_length;
+}
@@ -0,0 +1,125 @@
+// ============================================================================
+// core/track_model.h
+// Arc-length model of a track centerline: the one place that maps the game's
+// normalized trackPos to world geometry and back.
+//
+// trackPos (0..1) is S/F-relative; the centerline is delivered from its own
+// data start, with the S/F line raceData[0] meters along it. Distances below
+// are "meters" from the data start, and trackPos maps to
+//   meters = (trackPos * length + sfMeters) mod length.
+//
+// Two layers:
+//  - Exact (static): the arc-length table (pose at every segment start, running
+//    sums in walk order) and positionAt(), a binary search plus one exact arc
+//    step. What track-load work (bounds, race markers) uses, and what the
+//    cache stores (core/track_geometry_cache.h).
+//  - Uniform (built per centerline by build()): the pose every ~TABLE_SPACING
+//    meters, so worldAt / headingAt / poseAt are an index and a lerp (O(1)),
+//    and a bucket grid over those samples for nearestTrackPos (O(1) for a
+//    point near the track; the search widens ring by ring otherwise). Linear
+//    interpolation between samples is within spacing^2 / (8 * radius) of the
+//    exact arc: ~1 mm at 1 m spacing on a 100 m radius. Heading is exact at
+//    the samples; between two that straddle a straight/curve junction it is
+//    off by at most that piece's turn (spacing / radius).
+//
+// Built on TrackRibbonPyramid's worker and published with the complete level
+// set (TrackRibbonPyramid::Levels::model); immutable afterwards, so readers on
+// any thread share it through the Levels snapshot.
+// ============================================================================
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../game/unified_types.h"
+
+class TrackModel {
+public:
+    // Advance (x, y, headingDeg) by `dist` meters along a circular arc of signed
+    // radius (the heading convention is move = sin/cos of heading, turn rate =
+    // 1/radius). This is the *exact* arc position - independent of how finely the
+    // curve is subdivided - so the rendered ribbon and the marker positions that
+    // index into it agree exactly. Reduces to a straight line as |radius| grows.
+    static void advanceAlongArc(float& x, float& y, float& headingDeg, float radius, float dist) {
+        constexpr float PI = 3.14159265f;   // PluginConstants::Math, kept bit-identical
+        constexpr float DEG_TO_RAD = PI / 180.0f;
+        constexpr float RAD_TO_DEG = 180.0f / PI;
+        float h0 = headingDeg * DEG_TO_RAD;
+        if (std::abs(radius) < 0.01f) {  // effectively straight
+            x += std::sin(h0) * dist;
+            y += std::cos(h0) * dist;
+            return;
+        }
+        float theta = dist / radius;  // signed turn (radians)
+        x += radius * (std::cos(h0) - std::cos(h0 + theta));
+        y += radius * (std::sin(h0 + theta) - std::sin(h0));
+        headingDeg += theta * RAD_TO_DEG;
+    }
+
+    // Arc-length table: arc[i] is the pose at the start of segment i and the
+    // distance walked to reach it; arc[n] is the end of the track (its distance
+    // is the track length). Running sums in walk order, so a lookup reproduces
+    // the sequential walk bit for bit.
+    struct ArcPoint { float distance, x, y, headingDeg; };
+    static void buildArcTable(const std::vector<Unified::TrackSegment>& segments, std::vector<ArcPoint>& out);
+    // Exact position + heading `meters` along the centerline from the data start.
+    // False when meters is negative or past the end.
+    static bool positionAt(const std::vector<ArcPoint>& arc, const std::vector<Unified::TrackSegment>& segments,
+                           float meters, float& outX, float& outY, float& outAngleDeg);
+
+    // Uniform table resolution: ~1 m, clamped so a short track still has a
+    // usable table and a long enduro loop stays ~200 KB.
+    static constexpr float TABLE_SPACING = 1.0f;
+    static constexpr size_t MIN_TABLE_SAMPLES = 64;
+    static constexpr size_t MAX_TABLE_SAMPLES = 16384;
+
+    // Build the uniform table and the nearest-point grid. `arc` must be
+    // buildArcTable(segments). sfMeters: raceData[0] (<= 0 when unknown: the
+    // data start is taken as the S/F line).
+    void build(const std::vector<Unified::TrackSegment>& segments, const std::vector<ArcPoint>& arc,
+               float sfMeters);
+
+    bool valid() const { return !m_x.empty(); }
+    float length() const { return m_length; }
+    float sfMeters() const { return m_sfMeters; }
+    size_t tableSize() const { return m_x.size(); }   // samples, including the closing one
+
+    // trackPos <-> meters from the data start (both wrap).
+    float distanceAt(float trackPos) const;
+    float trackPosAt(float meters) const;
+
+    // O(1) lookups by trackPos. Heading in degrees [0, 360), 0 = north.
+    // Callers check valid() first; an invalid model answers the origin / 0.
+    void worldAt(float trackPos, float& outX, float& outY) const;
+    float headingAt(float trackPos) const;
+    void poseAt(float trackPos, float& outX, float& outY, float& outHeadingDeg) const;
+
+    // trackPos of the centerline point nearest (x, y), and optionally its
+    // distance from the centerline in meters. -1 when !valid().
+    float nearestTrackPos(float x, float y, float* outDistance = nullptr) const;
+
+    // Shortest along-track distance between two trackPos values, either way
+    // round the lap (the radar's "same piece of track" test).
+    float separationMeters(float trackPosA, float trackPosB) const;
+
+private:
+    // Index + lerp weight of data-start `meters` in the uniform table.
+    void locate(float meters, size_t& index, float& t) const;
+
+    float m_length = 0.0f;
+    float m_sfMeters = 0.0f;
+    float m_step = 0.0f;       // meters between uniform samples
+    float m_invStep = 0.0f;
+    // Uniform samples k = 0..N at k * m_step meters from the data start; the
+    // heading is continuous (unwrapped) so neighbours always lerp correctly.
+    std::vector<float> m_x, m_y, m_heading;
+
+    // Bucket grid: sample k (0..N-1) is filed under the cell holding it, and
+    // stands for the polyline piece [k, k+1]. CSR layout.
+    float m_gridMinX = 0.0f, m_gridMinY = 0.0f, m_cellSize = 1.0f;
+    int m_gridW = 0, m_gridH = 0;
+    std::vector<uint32_t> m_cellStart;   // m_gridW * m_gridH + 1 offsets into m_cellItems
+    std::vector<uint32_t> m_cellItems;
+};
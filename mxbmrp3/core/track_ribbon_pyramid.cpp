@@ -0,0 +1,391 @@
+// ============================================================================
+// core/track_ribbon_pyramid.cpp
+// World-ribbon sampler and the per-track LOD pyramid built off-thread. See
+// track_ribbon_pyramid.h for the level ladder and the threading contract.
+// ============================================================================
+#include "track_ribbon_pyramid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+
+#include "../diagnostics/logger.h"
+#include "plugin_constants.h"
+#include "track_geometry_cache.h"
+
+using namespace PluginConstants;
+using namespace PluginConstants::Math;
+
+// ============================================================================
+// Sampler
+// ============================================================================
+
+// Emits the same sequence of sample points the map's renderTrack loop always
+// generated (same subdivision, same exact advanceAlongArc positions, same
+// per-point heading), unconditionally: no view cull, no screen conversion, so
+// the result depends only on the track shape and the LOD inputs.
+void TrackRibbonPyramid::buildRibbon(const std::vector<Unified::TrackSegment>& segments, float spacing,
+                                     int curveMinSteps, bool subdivideStraights, Ribbon& out) {
+    out.clear();
+    if (segments.empty()) {
+        return;
+    }
+    out.reserve(segments.size() * 4);
+
+    // Emit one centerline sample: store position + UNIT perpendicular (half-width is
+    // applied per-frame per pass by the renderer, so it isn't baked in here).
+    // DEDUPE: the per-segment loops emit each segment joint twice (end of segment
+    // k == start of segment k+1) — a degenerate zero-area quad per boundary that
+    // the game still pays per-quad overhead for. Skip a sample identical to the
+    // previous one (the perpendicular is continuous across a joint, so keeping
+    // the first is exact).
+    auto emit = [&](float cx, float cy, float headingDeg) {
+        if (!out.empty() && out.cx.back() == cx && out.cy.back() == cy) {
+            return;
+        }
+        float perpRad = (headingDeg + 90.0f) * DEG_TO_RAD;
+        out.push(cx, cy, std::sin(perpRad), std::cos(perpRad));
+    };
+
+    float currentX = segments[0].startX;
+    float currentY = segments[0].startY;
+    float currentAngle = segments[0].angle;
+
+    // SHORT-SEGMENT MERGE: a segment shorter than the sample spacing doesn't
+    // deserve samples of its own — it only advances the walk (exact geometry;
+    // the next emitted sample lands where it should). Without this, the ribbon
+    // floors at ~2 samples per segment, so on segment-DENSE tracks (real tracks
+    // carry 100-200+ segments, many of them tiny) the low end of the detail
+    // dial stopped doing anything: 20% through 160% all emitted the same count.
+    // `carry` accumulates the skipped length so a RUN of short segments still
+    // gets a sample roughly every spacing meters, not zero forever.
+    float carry = 0.0f;
+    for (const auto& segment : segments) {
+        float startX = currentX;
+        float startY = currentY;
+
+        if (segment.length + carry < spacing) {
+            // Too short for its own samples: advance exactly, emit nothing.
+            float radius = (segment.type == TrackSegmentType::STRAIGHT) ? 0.0f : segment.radius;
+            TrackModel::advanceAlongArc(currentX, currentY, currentAngle, radius, segment.length);
+            carry += segment.length;
+            continue;
+        }
+        carry = 0.0f;
+
+        if (segment.type == TrackSegmentType::STRAIGHT) {
+            float angleRad = currentAngle * DEG_TO_RAD;
+            float dx = std::sin(angleRad) * segment.length;
+            float dy = std::cos(angleRad) * segment.length;
+
+            // 1 quad when not zoomed (optimal); subdivide with LOD when zoomed for
+            // clean clipping at close range. Perpendicular is constant on a straight.
+            int numSteps = 1;
+            if (subdivideStraights) {
+                numSteps = std::max(1, static_cast<int>(segment.length / spacing));
+            }
+            for (int i = 0; i <= numSteps; ++i) {
+                float t = static_cast<float>(i) / numSteps;
+                emit(startX + dx * t, startY + dy * t, currentAngle);
+            }
+            currentX += dx;
+            currentY += dy;
+        } else {
+            // Curve: subdivide, placing each point with exact arc geometry so the
+            // ribbon and the marker positions (centerlinePositionAt) agree.
+            float segRadius = segment.radius;  // signed (positive = right, negative = left)
+            float arcLength = segment.length;
+            int numSteps = std::max(curveMinSteps, static_cast<int>(arcLength / spacing));
+            float stepLength = arcLength / numSteps;
+            for (int i = 0; i <= numSteps; ++i) {
+                float tempX = startX, tempY = startY, tempAngle = currentAngle;
+                TrackModel::advanceAlongArc(tempX, tempY, tempAngle, segRadius, stepLength * i);
+                emit(tempX, tempY, tempAngle);
+            }
+            TrackModel::advanceAlongArc(currentX, currentY, currentAngle, segRadius, arcLength);
+        }
+    }
+    // Close the walk: if the track ended inside a merged run, the endpoint was
+    // never emitted — the ribbon would stop short of the start/finish seam.
+    // (emit() dedupes, so this is a no-op when the last segment emitted it.)
+    emit(currentX, currentY, currentAngle);
+
+    // Per-chunk world bounds of the sample centers, for the renderer's chunk cull.
+    const size_t count = out.size();
+    out.chunks.reserve((count + CHUNK - 1) / CHUNK);
+    for (size_t begin = 0; begin < count; begin += CHUNK) {
+        const size_t end = std::min(begin + CHUNK, count);
+        ChunkBounds cb{ out.cx[begin], out.cx[begin], out.cy[begin], out.cy[begin] };
+        for (size_t i = begin + 1; i < end; ++i) {
+            cb.minX = std::min(cb.minX, out.cx[i]);
+            cb.maxX = std::max(cb.maxX, out.cx[i]);
+            cb.minY = std::min(cb.minY, out.cy[i]);
+            cb.maxY = std::max(cb.maxY, out.cy[i]);
+        }
+        out.chunks.push_back(cb);
+    }
+}
+
+// ============================================================================
+// Bounds
+// ============================================================================
+
+// Moved from MapHud::calculateTrackBounds (which now pads/scales the result).
+TrackRibbonPyramid::Bounds TrackRibbonPyramid::computeBounds(const std::vector<Unified::TrackSegment>& segments) {
+    Bounds b;
+    if (segments.empty()) {
+        return b;
+    }
+
+    // Initialize bounds with first segment start position
+    b.minX = b.maxX = segments[0].startX;
+    b.minY = b.maxY = segments[0].startY;
+
+    // Calculate bounds by traversing all segments
+    float currentX = segments[0].startX;
+    float currentY = segments[0].startY;
+    float currentAngle = segments[0].angle;
+
+    for (const auto& segment : segments) {
+        // Update bounds with current position
+        b.minX = std::min(b.minX, currentX);
+        b.maxX = std::max(b.maxX, currentX);
+        b.minY = std::min(b.minY, currentY);
+        b.maxY = std::max(b.maxY, currentY);
+
+        // Calculate end position based on segment type
+        if (segment.type == TrackSegmentType::STRAIGHT) {
+            // Straight segment
+            float angleRad = currentAngle * DEG_TO_RAD;
+            float dx = std::sin(angleRad) * segment.length;
+            float dy = std::cos(angleRad) * segment.length;
+            currentX += dx;
+            currentY += dy;
+        } else {
+            // Curved segment - simple stepping approach
+            float segRadius = segment.radius;
+            float arcLength = segment.length;
+            float absRadius = std::abs(segRadius);
+
+            // Safety: Skip curved segments with invalid radius to avoid division by zero
+            if (absRadius < 0.01f) {
+                DEBUG_WARN_F("MapHud: Curved segment with invalid radius %.3f, skipping", segRadius);
+                continue;
+            }
+
+            // Sample points along the curve for accurate bounds, using the exact arc
+            // geometry (same as the ribbon/markers). Fixed 2m sampling step - bounds
+            // don't need to track LOD (computed once at track-load and must not
+            // depend on a setting that can change later).
+            constexpr float BOUNDS_SAMPLE_STEP_METERS = 2.0f;
+            int numSamples = std::max(3, static_cast<int>(arcLength / BOUNDS_SAMPLE_STEP_METERS));
+            float stepLength = arcLength / numSamples;
+
+            for (int i = 1; i <= numSamples; ++i) {
+                float tempX = currentX, tempY = currentY, tempAngle = currentAngle;
+                TrackModel::advanceAlongArc(tempX, tempY, tempAngle, segRadius, stepLength * i);
+
+                b.minX = std::min(b.minX, tempX);
+                b.maxX = std::max(b.maxX, tempX);
+                b.minY = std::min(b.minY, tempY);
+                b.maxY = std::max(b.maxY, tempY);
+            }
+
+            // Advance current position and angle to the end of the curve (exact).
+            TrackModel::advanceAlongArc(currentX, currentY, currentAngle, segRadius, arcLength);
+        }
+
+        // Update bounds with end position
+        b.minX = std::min(b.minX, currentX);
+        b.maxX = std::max(b.maxX, currentX);
+        b.minY = std::min(b.minY, currentY);
+        b.maxY = std::max(b.maxY, currentY);
+    }
+    return b;
+}
+
+// ============================================================================
+// Level ladder
+// ============================================================================
+
+float TrackRibbonPyramid::levelSpacing(int level) {
+    return std::ldexp(FINEST_SPACING, std::clamp(level, 0, COARSEST_LEVEL));
+}
+
+int TrackRibbonPyramid::nearestLevel(float spacing) {
+    if (!(spacing > FINEST_SPACING)) {
+        return 0;   // also NaN
+    }
+    const long level = std::lround(std::log2(spacing / FINEST_SPACING));
+    return static_cast<int>(std::min<long>(level, COARSEST_LEVEL));
+}
+
+const TrackRibbonPyramid::Ribbon& TrackRibbonPyramid::Levels::select(float spacing, int curveMinSteps,
+                                                                     int* levelOut) const {
+    const int level = complete ? nearestLevel(spacing) : COARSEST_LEVEL;
+    if (levelOut) *levelOut = level;
+    return ribbons[familyFor(curveMinSteps)][level];
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+TrackRibbonPyramid::~TrackRibbonPyramid() {
+    // Safety net — HudManager::clear() calls clear() first on shutdown.
+    cancelAndJoin();
+}
+
+void TrackRibbonPyramid::cancelAndJoin() {
+    m_generation.fetch_add(1, std::memory_order_relaxed);   // the running worker is now stale
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void TrackRibbonPyramid::clear() {
+    cancelAndJoin();
+    publish(nullptr);
+}
+
+std::shared_ptr<const TrackRibbonPyramid::Levels> TrackRibbonPyramid::publish(std::shared_ptr<const Levels> levels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels.swap(levels);
+    return levels;
+}
+
+std::shared_ptr<const TrackRibbonPyramid::Levels> TrackRibbonPyramid::current() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_levels;
+}
+
+void TrackRibbonPyramid::build(const Unified::TrackSegment* segments, int numSegments, float sfMeters,
+                               std::string cachePath) {
+    // Stop the previous track's worker before anything for the new one exists.
+    cancelAndJoin();
+    const uint32_t generation = m_generation.load(std::memory_order_relaxed);
+
+    std::vector<Unified::TrackSegment> track;
+    if (segments && numSegments > 0) {
+        track.assign(segments, segments + numSegments);
+    }
+    const uint64_t hash = TrackGeometryCache::hashSegments(track);
+
+    // Warm cache: the track-load geometry and the coarsest level straight from
+    // the file; the worker then copies the finer levels instead of walking them.
+    // Cold: the same set computed here, on this thread. Either way consumers
+    // never see the old track's geometry (or none) while the worker runs.
+    auto coarse = std::make_shared<Levels>();
+    const bool warm = !track.empty() && !cachePath.empty()
+                      && TrackGeometryCache::load(cachePath, hash, track.size(), *coarse, true);
+    if (!warm) {
+        *coarse = Levels();
+        coarse->segmentHash = hash;
+        coarse->bounds = computeBounds(track);
+        TrackModel::buildArcTable(track, coarse->arc);
+        const float coarseSpacing = levelSpacing(COARSEST_LEVEL);
+        buildRibbon(track, coarseSpacing, 1, true, coarse->ribbons[0][COARSEST_LEVEL]);
+        buildRibbon(track, coarseSpacing, 3, true, coarse->ribbons[1][COARSEST_LEVEL]);
+    }
+    coarse->generation = generation;
+    coarse->complete = track.empty();   // nothing to refine
+    // The previous track's set is megabytes in many large blocks; freeing it
+    // here cost the load callback ~1 ms, so the worker drops it instead.
+    std::shared_ptr<const Levels> retired = publish(coarse);
+
+    if (track.empty()) {
+        return;
+    }
+    m_worker = std::thread(&TrackRibbonPyramid::buildAllLevels, this, std::move(track),
+                           std::shared_ptr<const Levels>(coarse), sfMeters, std::move(cachePath),
+                           std::move(retired));
+}
+
+void TrackRibbonPyramid::buildAllLevels(std::vector<Unified::TrackSegment> segments,
+                                        std::shared_ptr<const Levels> coarse,
+                                        float sfMeters, std::string cachePath,
+                                        std::shared_ptr<const Levels> retired) {
+    // Exception barrier: an uncaught throw in a std::thread calls
+    // std::terminate() and kills the host game process. The ribbon vectors
+    // allocate; under memory pressure that throws. On failure the coarse set
+    // stays published, which is still correct geometry.
+    try {
+        retired.reset();   // last reference, unless a reader still holds it
+        const uint32_t generation = coarse->generation;
+        auto stale = [&]() { return m_generation.load(std::memory_order_relaxed) != generation; };
+
+        // The coarse part came from the cache: the rest is there too (unless the
+        // file changed since, in which case fall through and rebuild it).
+        if (coarse->fromCache) {
+            auto cached = std::make_shared<Levels>();
+            if (TrackGeometryCache::load(cachePath, coarse->segmentHash, segments.size(), *cached)) {
+                cached->generation = generation;
+                cached->model.build(segments, cached->arc, sfMeters);
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (stale()) return;
+                m_levels = std::move(cached);
+                DEBUG_INFO_F("TrackRibbonPyramid: %d levels for %zu segments loaded from %s",
+                             LEVEL_COUNT, segments.size(), cachePath.c_str());
+                return;
+            }
+        }
+
+        auto levels = std::make_shared<Levels>();
+        levels->generation = generation;
+        levels->segmentHash = coarse->segmentHash;
+        levels->bounds = coarse->bounds;
+        levels->arc = coarse->arc;
+        // Coarse to fine (cheapest first), so a cancel abandons little work.
+        for (int level = COARSEST_LEVEL; level >= 0; --level) {
+            for (int family = 0; family < FAMILY_COUNT; ++family) {
+                if (stale()) return;
+                if (level == COARSEST_LEVEL) {
+                    levels->ribbons[family][level] = coarse->ribbons[family][level];
+                } else {
+                    buildRibbon(segments, levelSpacing(level), family == 0 ? 1 : 3, true,
+                                levels->ribbons[family][level]);
+                }
+            }
+        }
+        levels->model.build(segments, levels->arc, sfMeters);
+        levels->complete = true;
+
+        size_t samples = 0;
+        for (const auto& family : levels->ribbons) {
+            for (const Ribbon& ribbon : family) samples += ribbon.size();
+        }
+
+        // Write the cache before publishing, so "complete" means the next load of
+        // this track is warm. A failed write only costs the next load a rebuild.
+        if (!cachePath.empty() && !stale()) {
+            TrackGeometryCache::save(cachePath, *levels, segments.size());
+        }
+
+        // Publish only if no newer build started meanwhile (its coarse set is
+        // already live and must not be replaced with this track's geometry).
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (stale()) return;
+            m_levels = std::move(levels);
+        }
+        DEBUG_INFO_F("TrackRibbonPyramid: %d levels built for %zu segments (%zu samples)",
+                     LEVEL_COUNT, segments.size(), samples);
+    } catch (const std::exception& e) {
+        DEBUG_WARN_F("TrackRibbonPyramid: level build failed: %s", e.what());
+    } catch (...) {
+        DEBUG_WARN("TrackRibbonPyramid: level build failed (unknown exception)");
+    }
+}
+
+#if defined(MXBMRP3_TEST_BUILD)
+bool TrackRibbonPyramid::testWaitComplete(int timeoutMs) const {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        std::shared_ptr<const Levels> levels = current();
+        if (levels && levels->complete) return true;
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+#endif
@@ -0,0 +1,159 @@
+// ============================================================================
+// core/track_ribbon_pyramid.h
+// Precomputed world-space track ribbons at a fixed ladder of LOD spacings,
+// built once per track load.
+//
+// A world ribbon is the track centerline sampled every ~spacing meters (center
+// + unit perpendicular per sample), in world meters and independent of any view
+// transform — what MapHud::renderTrack transforms to screen every rebuild. The
+// sampling walk (exact arc geometry per sample) is the expensive part. MapHud
+// caches one ribbon per LOD, but with zoom on the LOD follows the view range, so
+// an animating zoom re-walked the whole track every time the resolved spacing
+// moved and the map hitched.
+//
+// The pyramid removes the walk from the view path: LEVEL_COUNT ribbons at
+// spacings FINEST_SPACING * 2^level (0.25 m .. 64 m — the same clamp range as
+// the map's resolved spacing), for both curve-subdivision floors the map uses
+// (adaptive detail 1, fixed detail 3). A consumer picks the level nearest its
+// spacing in O(1) (nearestLevel, log2 rounding) and never builds anything.
+//
+// Threading contract:
+//  - build() runs on the thread that delivers TrackCenterline (HudManager::
+//    updateTrackCenterline). It builds the COARSEST level synchronously (a few
+//    samples per segment — microseconds) and publishes it, so a consumer always
+//    has geometry for the new track, then hands the segments to a worker thread
+//    that builds every level and publishes the complete set.
+//  - Until the complete set is published, Levels::select() returns the coarsest
+//    level for any spacing (complete == false).
+//  - Published Levels are immutable. current() hands out a shared_ptr under a
+//    mutex, so a reader keeps its snapshot alive across a rebuild even if a new
+//    track (or the completed set) is published meanwhile.
+//  - A new build() or clear() cancels an in-flight worker (it checks between
+//    ribbons) and joins it before proceeding; the destructor joins too.
+//    HudManager::clear() calls clear() on the orchestrated shutdown path.
+//  - The worker body carries the top-level exception barrier: an uncaught throw
+//    in a std::thread calls std::terminate() and kills the host game.
+//
+// Each published set also carries the rest of the track-load geometry: the
+// centerline bounds and the arc-length table (pose at every segment start), so
+// a consumer never walks the segments itself; the complete set adds the
+// TrackModel (core/track_model.h) for O(1) trackPos <-> world queries. With a
+// cache path, build() first tries the on-disk copy (core/track_geometry_cache.h):
+// on a hit the coarse set published synchronously is read from the file and the
+// worker copies the finer levels from it instead of walking them; a miss builds
+// as above and the worker writes the file before publishing the complete set.
+// Either way the worker builds the TrackModel (it is not cached).
+//
+// Shared by every HUD that wants track-relative geometry (HudManager::
+// getTrackRibbons()): MapHud draws the ribbons, RadarHud reads the model.
+// ============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../game/unified_types.h"
+#include "track_model.h"
+
+class TrackRibbonPyramid {
+public:
+    // Samples per cull chunk: each ribbon carries a world bounding box per chunk
+    // so a renderer can reject most of the track (zoom mode) before transforming.
+    static constexpr size_t CHUNK = 32;
+    struct ChunkBounds { float minX, maxX, minY, maxY; };
+
+    // Structure of arrays (one contiguous float array per field) so transform
+    // kernels stream each field with vector loads.
+    struct Ribbon {
+        std::vector<float> cx, cy;     // center
+        std::vector<float> upx, upy;   // UNIT perpendicular
+        std::vector<ChunkBounds> chunks;   // centers of samples [k*CHUNK, (k+1)*CHUNK)
+        size_t size() const { return cx.size(); }
+        bool empty() const { return cx.empty(); }
+        void clear() { cx.clear(); cy.clear(); upx.clear(); upy.clear(); chunks.clear(); }
+        void reserve(size_t n) { cx.reserve(n); cy.reserve(n); upx.reserve(n); upy.reserve(n); }
+        void push(float x, float y, float ux, float uy) {
+            cx.push_back(x); cy.push_back(y); upx.push_back(ux); upy.push_back(uy);
+        }
+    };
+
+    // Walk the centerline into `out` at the given spacing. curveMinSteps floors
+    // the subdivision of a curve; straights are one quad unless
+    // subdivideStraights (zoom mode, for clean clipping at close range). This is
+    // THE ribbon sampler: MapHud's on-demand cache and every pyramid level use it.
+    static void buildRibbon(const std::vector<Unified::TrackSegment>& segments, float spacing,
+                            int curveMinSteps, bool subdivideStraights, Ribbon& out);
+
+    // Raw (unpadded) centerline extents, curves sampled every 2 m.
+    struct Bounds { float minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f; };
+    static Bounds computeBounds(const std::vector<Unified::TrackSegment>& segments);
+
+    static constexpr int LEVEL_COUNT = 9;
+    static constexpr float FINEST_SPACING = 0.25f;   // level 0; level i = 0.25 * 2^i
+    static constexpr int COARSEST_LEVEL = LEVEL_COUNT - 1;   // 64 m
+    static float levelSpacing(int level);
+    // Level whose spacing is nearest (in log2) to `spacing`, clamped to the ladder.
+    static int nearestLevel(float spacing);
+
+    // Curve-subdivision floor families (MapHud: adaptive detail -> 1, fixed -> 3).
+    // Pyramid ribbons always subdivide straights: they serve the zoom view.
+    static constexpr int FAMILY_COUNT = 2;
+    static int familyFor(int curveMinSteps) { return curveMinSteps <= 1 ? 0 : 1; }
+
+    struct Levels {
+        uint32_t generation = 0;   // bumps per build(): a new track
+        bool complete = false;     // every level built (else only COARSEST_LEVEL)
+        bool fromCache = false;    // read from the on-disk cache, not built
+        uint64_t segmentHash = 0;  // TrackGeometryCache::hashSegments of the source track
+        Bounds bounds;
+        std::vector<TrackModel::ArcPoint> arc;   // TrackModel::buildArcTable
+        TrackModel model;          // uniform trackPos <-> world model; valid() once complete
+        Ribbon ribbons[FAMILY_COUNT][LEVEL_COUNT];
+
+        // The ribbon to draw at `spacing`, and the level it came from. Falls back
+        // to the coarsest level until the set is complete.
+        const Ribbon& select(float spacing, int curveMinSteps, int* levelOut = nullptr) const;
+    };
+
+    TrackRibbonPyramid() = default;
+    ~TrackRibbonPyramid();
+
+    TrackRibbonPyramid(const TrackRibbonPyramid&) = delete;
+    TrackRibbonPyramid& operator=(const TrackRibbonPyramid&) = delete;
+
+    // Start a build for a new track (see the threading contract above).
+    // sfMeters: raceData[0] (the S/F line along the centerline; <= 0 unknown).
+    // cachePath: the track's geometry cache file, or empty for no disk cache.
+    void build(const Unified::TrackSegment* segments, int numSegments, float sfMeters = 0.0f,
+               std::string cachePath = {});
+    // Cancel + join the worker and drop the published set.
+    void clear();
+    // The published set, or null before the first build().
+    std::shared_ptr<const Levels> current() const;
+
+#if defined(MXBMRP3_TEST_BUILD)
+    // Block until the complete set for the latest build is published (or
+    // timeoutMs passes). Returns true when complete.
+    bool testWaitComplete(int timeoutMs) const;
+#endif
+
+private:
+    void cancelAndJoin();
+    void buildAllLevels(std::vector<Unified::TrackSegment> segments,
+                        std::shared_ptr<const Levels> coarse,
+                        float sfMeters, std::string cachePath,
+                        std::shared_ptr<const Levels> retired);   // Runs in the worker thread
+    // Swap in a new set; returns the one it replaced.
+    std::shared_ptr<const Levels> publish(std::shared_ptr<const Levels> levels);
+
+    mutable std::mutex m_mutex;    // guards m_levels
+    std::shared_ptr<const Levels> m_levels;
+    std::thread m_worker;
+    std::atomic<uint32_t> m_generation{0};   // latest build(); a worker for an older one stops
+};
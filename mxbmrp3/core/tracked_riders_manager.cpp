@@ -165,14 +165,22 @@ bool TrackedRidersManager::removeTrackedRider(const std::string& name) {
     return true;
 }
 
+// Lookups run for every standings row on every rebuild. Game names rarely carry
+// surrounding whitespace, so only those that do pay for a normalized copy.
+static bool needsTrim(const std::string& name) {
+    auto ws = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    return !name.empty() && (ws(name.front()) || ws(name.back()));
+}
+
 bool TrackedRidersManager::isTracked(const std::string& name) const {
-    std::string normalizedName = normalizeName(name);
-    return m_trackedRiders.find(normalizedName) != m_trackedRiders.end();
+    if (m_trackedRiders.empty()) return false;
+    auto it = needsTrim(name) ? m_trackedRiders.find(normalizeName(name)) : m_trackedRiders.find(name);
+    return it != m_trackedRiders.end();
 }
 
 const TrackedRiderConfig* TrackedRidersManager::getTrackedRider(const std::string& name) const {
-    std::string normalizedName = normalizeName(name);
-    auto it = m_trackedRiders.find(normalizedName);
+    if (m_trackedRiders.empty()) return nullptr;
+    auto it = needsTrim(name) ? m_trackedRiders.find(normalizeName(name)) : m_trackedRiders.find(name);
     if (it != m_trackedRiders.end()) {
         return &it->second;
     }
@@ -118,6 +118,14 @@ public:
     bool getPluginThread() const { return m_bPluginThread.load(std::memory_order_relaxed); }
     void setPluginThread(bool enabled) { m_bPluginThread.store(enabled, std::memory_order_relaxed); }
 
+    // Shared-memory frame export (INI-only, off by default): 0=off, 1=primitives,
+    // 2=rendered RGBA image of frameExportWidth (16:9). See core/frame_export.{h,cpp};
+    // HudManager reconciles it every frame. Atomic for the same reason as pluginThread.
+    int getFrameExport() const { return m_frameExport.load(std::memory_order_relaxed); }
+    void setFrameExport(int mode) { m_frameExport.store((mode < 0 || mode > 2) ? 0 : mode, std::memory_order_relaxed); }
+    int getFrameExportWidth() const { return m_frameExportWidth.load(std::memory_order_relaxed); }
+    void setFrameExportWidth(int w) { m_frameExportWidth.store((w < 320) ? 320 : (w > 3840) ? 3840 : w, std::memory_order_relaxed); }
+
     // Drop shadow settings (for text rendering)
     bool getDropShadow() const { return m_bDropShadow; }
     void setDropShadow(bool enabled) { m_bDropShadow = enabled; }
@@ -150,6 +158,8 @@ private:
     float m_fCursorActivationThreshold = 0.015f;  // Mouse travel from rest before cursor appears (~29px horiz on 1080p)
     bool m_bTitleIcons = true;       // HUD title identity icons enabled by default
     std::atomic<bool> m_bPluginThread{ false };  // Experimental plugin worker thread (INI-only, off by default; live-toggle via reconcileEnabled)
+    std::atomic<int> m_frameExport{ 0 };         // Shared-memory frame export (INI-only, off by default)
+    std::atomic<int> m_frameExportWidth{ 1280 }; // Image width for frameExport=2
 
     // Grid overlay (INI-only debug aid)
     bool m_bGridOverlay = false;                       // Off by default
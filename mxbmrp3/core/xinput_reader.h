@@ -9,12 +9,13 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <deque>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "history_ring.h"
+
 // Forward declare WinRT types to avoid pulling headers into every translation unit
 namespace winrt::Windows::Gaming::Input {
     struct RawGameController;
@@ -340,20 +341,20 @@ public:
     static constexpr size_t MAX_RUMBLE_HISTORY = 200;
 
     // Get history buffers for graph visualization
-    const std::deque<float>& getHeavyMotorHistory() const { return m_heavyMotorHistory; }
-    const std::deque<float>& getLightMotorHistory() const { return m_lightMotorHistory; }
-    const std::deque<float>& getSuspensionHistory() const { return m_suspensionHistory; }
-    const std::deque<float>& getWheelspinHistory() const { return m_wheelspinHistory; }
-    const std::deque<float>& getLockupHistory() const { return m_lockupHistory; }
-    const std::deque<float>& getWheelieHistory() const { return m_wheelieHistory; }
-    const std::deque<float>& getRpmHistory() const { return m_rpmHistory; }
-    const std::deque<float>& getSlideHistory() const { return m_slideHistory; }
-    const std::deque<float>& getSurfaceHistory() const { return m_surfaceHistory; }
-    const std::deque<float>& getSteerHistory() const { return m_steerHistory; }
-    const std::deque<float>& getRevLimiterHistory() const { return m_revLimiterHistory; }
-    const std::deque<float>& getPitLimiterHistory() const { return m_pitLimiterHistory; }
-    const std::deque<float>& getSuspensionRearHistory() const { return m_suspensionRearHistory; }
-    const std::deque<float>& getLockupRearHistory() const { return m_lockupRearHistory; }
+    const SampleHistory& getHeavyMotorHistory() const { return m_heavyMotorHistory; }
+    const SampleHistory& getLightMotorHistory() const { return m_lightMotorHistory; }
+    const SampleHistory& getSuspensionHistory() const { return m_suspensionHistory; }
+    const SampleHistory& getWheelspinHistory() const { return m_wheelspinHistory; }
+    const SampleHistory& getLockupHistory() const { return m_lockupHistory; }
+    const SampleHistory& getWheelieHistory() const { return m_wheelieHistory; }
+    const SampleHistory& getRpmHistory() const { return m_rpmHistory; }
+    const SampleHistory& getSlideHistory() const { return m_slideHistory; }
+    const SampleHistory& getSurfaceHistory() const { return m_surfaceHistory; }
+    const SampleHistory& getSteerHistory() const { return m_steerHistory; }
+    const SampleHistory& getRevLimiterHistory() const { return m_revLimiterHistory; }
+    const SampleHistory& getPitLimiterHistory() const { return m_pitLimiterHistory; }
+    const SampleHistory& getSuspensionRearHistory() const { return m_suspensionRearHistory; }
+    const SampleHistory& getLockupRearHistory() const { return m_lockupRearHistory; }
 
     // Process telemetry and apply rumble effects
     // suspVelFront/suspVelRear: front/rear suspension compression velocity (m/s, positive = compression).
@@ -475,28 +476,25 @@ private:
     float m_lastSuspensionRumbleRear;
     float m_lastLockupRumbleRear;
 
-    // History buffers for graph visualization
-    std::deque<float> m_heavyMotorHistory;
-    std::deque<float> m_lightMotorHistory;
-    std::deque<float> m_suspensionHistory;
-    std::deque<float> m_wheelspinHistory;
-    std::deque<float> m_lockupHistory;
-    std::deque<float> m_wheelieHistory;
-    std::deque<float> m_rpmHistory;
-    std::deque<float> m_slideHistory;
-    std::deque<float> m_surfaceHistory;
-    std::deque<float> m_steerHistory;
-    std::deque<float> m_revLimiterHistory;
-    std::deque<float> m_pitLimiterHistory;
-    std::deque<float> m_suspensionRearHistory;
-    std::deque<float> m_lockupRearHistory;
-
-    // Helper to push value to history buffer with size limit
-    void pushToHistory(std::deque<float>& buffer, float value) {
-        buffer.push_back(value);
-        if (buffer.size() > MAX_RUMBLE_HISTORY) {
-            buffer.pop_front();
-        }
+    // History buffers for graph visualization (fixed rings, no allocation per sample)
+    SampleHistory m_heavyMotorHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_lightMotorHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_suspensionHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_wheelspinHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_lockupHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_wheelieHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_rpmHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_slideHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_surfaceHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_steerHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_revLimiterHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_pitLimiterHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_suspensionRearHistory{MAX_RUMBLE_HISTORY};
+    SampleHistory m_lockupRearHistory{MAX_RUMBLE_HISTORY};
+
+    // Helper to push value to history buffer (the ring drops the oldest once full)
+    void pushToHistory(SampleHistory& buffer, float value) {
+        buffer.push(value);
     }
 
     // Rumble configuration
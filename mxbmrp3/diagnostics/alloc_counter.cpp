@@ -0,0 +1,134 @@
+// ============================================================================
+// diagnostics/alloc_counter.cpp
+// Heap allocation accounting: counters, phases and (when counting is compiled
+// in) the replacement global operator new/delete. See alloc_counter.h.
+// ============================================================================
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace AllocCounter {
+
+namespace {
+    // Plain arrays of atomics / PODs: constant-initialized, so the first
+    // allocation of the process (or of a thread) can count itself without
+    // running any initializer that might allocate in turn.
+    struct AtomicCounts {
+        std::atomic<uint64_t> allocs{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+    AtomicCounts g_totals[PHASE_COUNT];
+
+    thread_local Counts t_counts[PHASE_COUNT];
+    thread_local Phase t_phase = Phase::OTHER;
+
+    const char* const PHASE_NAMES[PHASE_COUNT] = {
+        "Other", "Callback", "Draw", "HudUpdate", "Snapshot", "Director"
+    };
+}
+
+const char* phaseName(Phase phase) {
+    const int i = static_cast<int>(phase);
+    return (i >= 0 && i < PHASE_COUNT) ? PHASE_NAMES[i] : "?";
+}
+
+bool enabled() {
+#ifdef MXBMRP3_ALLOC_COUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+
+Counts threadCounts(Phase phase) {
+    const int i = static_cast<int>(phase);
+    return (i >= 0 && i < PHASE_COUNT) ? t_counts[i] : Counts{};
+}
+
+Counts totalCounts(Phase phase) {
+    Counts c;
+    const int i = static_cast<int>(phase);
+    if (i < 0 || i >= PHASE_COUNT) return c;
+    c.allocs = g_totals[i].allocs.load(std::memory_order_relaxed);
+    c.frees = g_totals[i].frees.load(std::memory_order_relaxed);
+    c.bytes = g_totals[i].bytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+uint64_t totalAllocs() {
+    uint64_t n = 0;
+    for (const AtomicCounts& t : g_totals) n += t.allocs.load(std::memory_order_relaxed);
+    return n;
+}
+
+void resetTotals() {
+    for (AtomicCounts& t : g_totals) {
+        t.allocs.store(0, std::memory_order_relaxed);
+        t.frees.store(0, std::memory_order_relaxed);
+        t.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+Phase setPhase(Phase phase) {
+    const Phase previous = t_phase;
+    t_phase = phase;
+    return previous;
+}
+
+void onAlloc(uint64_t bytes) {
+    const int i = static_cast<int>(t_phase);
+    ++t_counts[i].allocs;
+    t_counts[i].bytes += bytes;
+    g_totals[i].allocs.fetch_add(1, std::memory_order_relaxed);
+    g_totals[i].bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void onFree() {
+    const int i = static_cast<int>(t_phase);
+    ++t_counts[i].frees;
+    g_totals[i].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace AllocCounter
+
+#ifdef MXBMRP3_ALLOC_COUNTING
+// Replacement global allocation functions. Only the plain forms: the nothrow,
+// array and sized forms of the standard library forward to these, and the
+// over-aligned forms keep their own (uncounted) allocator on both sides.
+// malloc/free underneath, as the default implementations do.
+void* operator new(std::size_t size) {
+    AllocCounter::onAlloc(size);
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    AllocCounter::onFree();
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    ::operator delete(p);
+}
+#endif
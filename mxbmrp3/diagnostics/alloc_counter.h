@@ -0,0 +1,83 @@
+// ============================================================================
+// diagnostics/alloc_counter.h
+// Heap allocation accounting. With counting compiled in, the global operator
+// new/delete (alloc_counter.cpp) count every allocation twice: into the calling
+// thread's own counters and into process-wide totals, both split by the phase
+// the thread is in. ALLOC_PHASE(Phase::X) sets the phase for the enclosing
+// scope; nested scopes restore the outer phase on exit, so an allocation is
+// charged to the innermost phase only (a HUD update inside Draw counts as
+// HudUpdate, not Draw).
+//
+// Counting is on in the test builds (MXBMRP3_TEST_BUILD: the mingw integration
+// DLL and the native core), where the MXBMRP3_Test_Alloc* hooks and the
+// integration allocation test read it. Define MXBMRP3_ALLOC_COUNTING in any
+// other build to get the BenchmarkWidget's "Allocs/frame" row in-game. Without
+// it, ALLOC_PHASE compiles out and every query returns zero.
+// ============================================================================
+#pragma once
+
+#include <cstdint>
+
+#if defined(MXBMRP3_TEST_BUILD) && !defined(MXBMRP3_ALLOC_COUNTING)
+#define MXBMRP3_ALLOC_COUNTING
+#endif
+
+namespace AllocCounter {
+
+enum class Phase : uint8_t {
+    OTHER = 0,      // startup, settings, hotkeys, background threads...
+    GAME_CALLBACK,  // a game callback (ACCUMULATE_CALLBACK_TIME_NAMED), Draw excluded
+    DRAW,           // Draw: HUD updates, surface collect, frame handoff
+    HUD_UPDATE,     // a HUD's update() in HudManager::updateHuds (data pull + rebuilds)
+    SNAPSHOT,       // HttpServer::buildJsonSnapshot (the /api/state document)
+    DIRECTOR,       // DirectorManager::evaluate (auto-director scoring, ~3x/s)
+    COUNT
+};
+constexpr int PHASE_COUNT = static_cast<int>(Phase::COUNT);
+
+const char* phaseName(Phase phase);
+
+struct Counts {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;     // requested bytes, allocations only
+};
+
+// False when counting is compiled out (all counts stay zero).
+bool enabled();
+
+// The calling thread's counts for one phase, since the thread started.
+Counts threadCounts(Phase phase);
+// All threads, since process start or the last resetTotals().
+Counts totalCounts(Phase phase);
+// All threads and phases: allocations since process start or resetTotals().
+uint64_t totalAllocs();
+void resetTotals();
+
+// Hot-path internals, used by operator new/delete and ALLOC_PHASE.
+Phase setPhase(Phase phase);   // returns the previous phase
+void onAlloc(uint64_t bytes);
+void onFree();
+
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase) : m_previous(setPhase(phase)) {}
+    ~PhaseScope() { setPhase(m_previous); }
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    Phase m_previous;
+};
+
+}  // namespace AllocCounter
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+
+#ifdef MXBMRP3_ALLOC_COUNTING
+// Usage: ALLOC_PHASE(AllocCounter::Phase::DRAW); - charges the enclosing scope.
+#define ALLOC_PHASE(phase) AllocCounter::PhaseScope ALLOC_CONCAT(_allocPhase, __LINE__)(phase)
+#else
+#define ALLOC_PHASE(phase) ((void)0)
+#endif
@@ -0,0 +1,140 @@
+// ============================================================================
+// diagnostics/trace_buffer.h
+// Storage and serialization for the timeline tracer (diagnostics/tracer.h).
+// One TraceBuffer per thread: a fixed-size ring of complete events written only
+// by its owner, so recording is a slot store plus one release store - no lock,
+// no allocation. A reader on another thread snapshots the newest events; the
+// Tracer only does so after ending the capture, so at most the scopes already in
+// flight are still writing. When the ring is full, the oldest events are
+// overwritten, like a flight recorder. copyEvents() takes such a snapshot into a
+// ThreadEvents, which the Tracer's writer thread formats while the rings are
+// free to record the next capture.
+//
+// Clock-agnostic (events carry raw ticks) and Win32-free, so the unit tests
+// exercise the ring and the Chrome trace JSON directly.
+// ============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Trace {
+
+// A complete ("X") event. `name` must outlive the buffer: string literals, or a
+// pointer from Tracer::intern().
+struct Event {
+    const char* name;
+    int64_t start;      // ticks
+    int64_t duration;   // ticks
+};
+
+// One thread's events copied out of its ring (TraceBuffer::copyEvents).
+struct ThreadEvents {
+    uint32_t threadId = 0;
+    std::string threadName;
+    std::vector<Event> events;
+};
+
+class TraceBuffer {
+public:
+    // Events the reader skips at the old end of a full ring: the owner may be
+    // overwriting those slots while the snapshot is taken.
+    static constexpr uint32_t READ_SLACK = 8;
+
+    TraceBuffer(uint32_t threadId, uint32_t capacityPow2)
+        : m_threadId(threadId), m_mask(capacityPow2 - 1),
+          m_events(new Event[capacityPow2]) {}
+
+    // Owner thread only.
+    void push(const char* name, int64_t start, int64_t end) {
+        const uint64_t head = m_head.load(std::memory_order_relaxed);
+        m_events[head & m_mask] = Event{ name, start, end - start };
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // Any thread. Visits the retained events oldest-first.
+    template <typename F>
+    void forEach(F&& fn) const {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t keep = static_cast<uint64_t>(m_mask) + 1 - READ_SLACK;
+        const uint64_t first = head > keep ? head - keep : 0;
+        for (uint64_t i = first; i < head; ++i) fn(m_events[i & m_mask]);
+    }
+
+    // Any thread. The retained events that started at or after fromTicks,
+    // oldest-first, with this ring's thread id and name.
+    void copyEvents(int64_t fromTicks, ThreadEvents& out) const {
+        out.threadId = m_threadId;
+        out.threadName = m_threadName;
+        out.events.clear();
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t keep = static_cast<uint64_t>(m_mask) + 1 - READ_SLACK;
+        out.events.reserve(static_cast<size_t>(head < keep ? head : keep));
+        forEach([&](const Event& e) {
+            if (e.start >= fromTicks) out.events.push_back(e);
+        });
+    }
+
+    uint64_t totalPushed() const { return m_head.load(std::memory_order_acquire); }
+    uint32_t threadId() const { return m_threadId; }
+    const std::string& threadName() const { return m_threadName; }
+    void setThreadName(const char* name) { m_threadName = name ? name : ""; }
+
+private:
+    uint32_t m_threadId;
+    uint32_t m_mask;
+    std::string m_threadName;
+    std::unique_ptr<Event[]> m_events;
+    std::atomic<uint64_t> m_head{0};
+};
+
+inline void appendJsonString(std::string& out, const char* s) {
+    out += '"';
+    for (; s && *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') { out += '\\'; out += static_cast<char>(c); }
+        else if (c < 0x20) { char esc[8]; snprintf(esc, sizeof(esc), "\\u%04x", c); out += esc; }
+        else out += static_cast<char>(c);
+    }
+    out += '"';
+}
+
+// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev): a thread_name
+// record per named thread, then every event that started at or after
+// `fromTicks`, with timestamps in microseconds relative to it.
+inline std::string formatChromeTrace(const std::vector<ThreadEvents>& threads,
+                                     int64_t fromTicks, int64_t ticksPerSecond, uint32_t pid) {
+    const double usPerTick = ticksPerSecond > 0 ? 1e6 / static_cast<double>(ticksPerSecond) : 1.0;
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char num[160];
+    for (const ThreadEvents& t : threads) {
+        if (!t.threadName.empty()) {
+            snprintf(num, sizeof(num), "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+                     first ? "" : ",", pid, t.threadId);
+            out += num;
+            appendJsonString(out, t.threadName.c_str());
+            out += "}}";
+            first = false;
+        }
+        for (const Event& e : t.events) {
+            if (e.start < fromTicks) continue;
+            snprintf(num, sizeof(num), "%s\n{\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                     first ? "" : ",", pid, t.threadId,
+                     static_cast<double>(e.start - fromTicks) * usPerTick,
+                     static_cast<double>(e.duration) * usPerTick);
+            out += num;
+            appendJsonString(out, e.name);
+            out += '}';
+            first = false;
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+}  // namespace Trace
@@ -0,0 +1,151 @@
+// ============================================================================
+// diagnostics/tracer.cpp
+// Timeline tracer: per-thread ring registration, capture start/stop and the
+// Chrome trace file. See tracer.h.
+// ============================================================================
+#include "tracer.h"
+#include "logger.h"
+#include "../core/atomic_file_writer.h"
+#include "../core/performance_timer.h"
+
+#include <windows.h>
+#include <ctime>
+
+std::atomic<bool> Tracer::s_active{false};
+
+namespace {
+    // The calling thread's ring (owned by Tracer::m_buffers) and its label.
+    thread_local Trace::TraceBuffer* t_buffer = nullptr;
+    thread_local const char* t_threadName = nullptr;
+
+    long long ticksPerSecond() {
+        static const long long freq = PerformanceTimer::initializeFrequency();
+        return freq;
+    }
+}
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::~Tracer() {
+    // Static teardown, possibly under the loader lock: don't join. Shutdown has
+    // already waited for the file (PluginManager::shutdown).
+    if (m_writer.joinable()) m_writer.detach();
+}
+
+int64_t Tracer::now() {
+    return PerformanceTimer::getCounter();
+}
+
+Trace::TraceBuffer* Tracer::threadBuffer() {
+    if (t_buffer) return t_buffer;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(std::make_unique<Trace::TraceBuffer>(
+        static_cast<uint32_t>(GetCurrentThreadId()), EVENTS_PER_THREAD));
+    t_buffer = m_buffers.back().get();
+    if (t_threadName) t_buffer->setThreadName(t_threadName);
+    return t_buffer;
+}
+
+void Tracer::record(const char* name, int64_t startTicks, int64_t endTicks) {
+    threadBuffer()->push(name, startTicks, endTicks);
+}
+
+void Tracer::setThreadName(const char* name) {
+    t_threadName = name;
+    if (t_buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);   // the writer reads names under this lock
+        t_buffer->setThreadName(name);
+    }
+}
+
+const char* Tracer::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::string& s : m_names) {
+        if (s == name) return s.c_str();
+    }
+    m_names.push_back(name);   // deque: existing elements never move
+    return m_names.back().c_str();
+}
+
+uint64_t Tracer::eventsRecorded() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t total = 0;
+    for (const auto& b : m_buffers) total += b->totalPushed();
+    return total;
+}
+
+void Tracer::start() {
+    if (active()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_captureStart = now();
+    }
+    s_active.store(true, std::memory_order_relaxed);
+    DEBUG_INFO("Tracer: capture started");
+}
+
+std::string Tracer::stop(const char* savePath) {
+    if (!active()) return "";
+    s_active.store(false, std::memory_order_relaxed);
+
+    // Only the copy happens here; formatting (several MB of JSON per full ring)
+    // and the file write run on the writer thread.
+    std::vector<Trace::ThreadEvents> threads;
+    int64_t captureStart;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        captureStart = m_captureStart;
+        threads.resize(m_buffers.size());
+        for (size_t i = 0; i < m_buffers.size(); ++i) m_buffers[i]->copyEvents(captureStart, threads[i]);
+    }
+
+    if (!savePath || savePath[0] == '\0') {
+        DEBUG_WARN("Tracer: no save path - capture discarded");
+        return "";
+    }
+
+    // savePath/mxbmrp3/traces/trace_YYYYMMDD_HHMMSS.json, next to benchmarks/.
+    std::string dir = savePath;
+    if (dir.back() != '/' && dir.back() != '\\') dir += '\\';
+    dir += "mxbmrp3";
+
+    time_t t = time(nullptr);
+    struct tm timeInfo;
+    // cppcheck-suppress uninitvar
+    localtime_s(&timeInfo, &t);
+    char fileTimestamp[20];
+    strftime(fileTimestamp, sizeof(fileTimestamp), "%Y%m%d_%H%M%S", &timeInfo);
+    std::string filePath = dir + "\\traces\\trace_" + fileTimestamp + ".json";
+
+    // One write at a time; a previous one still running is finished first.
+    waitForWrite();
+    const int64_t ticks = ticksPerSecond();
+    const uint32_t pid = static_cast<uint32_t>(GetCurrentProcessId());
+    m_writer = std::thread([threads = std::move(threads), dir, filePath, captureStart, ticks, pid]() {
+        try {
+            CreateDirectoryA(dir.c_str(), nullptr);
+            CreateDirectoryA((dir + "\\traces").c_str(), nullptr);
+            const std::string json = Trace::formatChromeTrace(threads, captureStart, ticks, pid);
+            if (!AtomicFileWriter::writeFileAtomic(filePath, json)) {
+                DEBUG_WARN_F("Tracer: Failed to write %s", filePath.c_str());
+                return;
+            }
+            DEBUG_INFO_F("Tracer: capture written to %s (%zu bytes)", filePath.c_str(), json.size());
+        } catch (...) {
+            DEBUG_WARN_F("Tracer: Failed to write %s", filePath.c_str());
+        }
+    });
+    return filePath;
+}
+
+void Tracer::waitForWrite() {
+    if (m_writer.joinable()) m_writer.join();
+}
+
+void Tracer::toggle(const char* savePath) {
+    if (active()) stop(savePath);
+    else start();
+}
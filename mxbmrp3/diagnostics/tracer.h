@@ -0,0 +1,110 @@
+// ============================================================================
+// diagnostics/tracer.h
+// Low-overhead timeline tracing for finding frame spikes in a real session.
+// TRACE_SCOPE("name") records one complete event (start + duration) into the
+// calling thread's lock-free ring (diagnostics/trace_buffer.h) while a capture
+// is running. stop() copies the rings out under the lock and hands them to a
+// writer thread, which formats them as a Chrome trace JSON and writes
+// <save>/mxbmrp3/traces/trace_YYYYMMDD_HHMMSS.json - a full ring is several
+// MB of JSON, too slow to build on the game thread. Open it in ui.perfetto.dev
+// or chrome://tracing.
+//
+// Capture is toggled at runtime with the TOGGLE_TRACE hotkey (unbound by default)
+// or started at launch with [Trace] enabled=1 in the INI. With no capture
+// running, a scope costs one relaxed atomic load. Defining MXBMRP3_NO_TRACING
+// compiles every scope out.
+// ============================================================================
+#pragma once
+
+#include "trace_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Tracer {
+public:
+    static Tracer& getInstance();
+
+    // Per-thread ring size (events). A full ring keeps the newest ones.
+    static constexpr uint32_t EVENTS_PER_THREAD = 1u << 16;
+
+    static bool active() { return s_active.load(std::memory_order_relaxed); }
+    static int64_t now();
+
+    // Begin a capture. Events recorded before this call are not written.
+    void start();
+    // End the capture and start writing it under savePath on the writer thread.
+    // Returns the file being written, or "" when no capture was running or there
+    // is no save path; a failed write is logged by the writer.
+    std::string stop(const char* savePath);
+    // Hotkey helper: start, or stop and write.
+    void toggle(const char* savePath);
+    // Block until the last stop()'s file is written (shutdown, test hooks).
+    // start/stop/toggle/waitForWrite are called from one thread at a time.
+    void waitForWrite();
+
+    // [Trace] enabled: start a capture when the settings load.
+    void setCaptureAtStartup(bool enabled) { m_captureAtStartup = enabled; }
+    bool getCaptureAtStartup() const { return m_captureAtStartup; }
+
+    // Called by TraceScope on the recording thread.
+    void record(const char* name, int64_t startTicks, int64_t endTicks);
+
+    // Label the calling thread in the trace (a string literal).
+    void setThreadName(const char* name);
+
+    // A stable copy of a runtime name (e.g. a HUD's), valid for the process lifetime.
+    const char* intern(const std::string& name);
+
+    uint64_t eventsRecorded() const;
+
+private:
+    Tracer() = default;
+    ~Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    Trace::TraceBuffer* threadBuffer();
+
+    static std::atomic<bool> s_active;
+
+    mutable std::mutex m_mutex;   // guards the buffer list and the name pool
+    std::vector<std::unique_ptr<Trace::TraceBuffer>> m_buffers;
+    std::deque<std::string> m_names;
+    int64_t m_captureStart = 0;
+    bool m_captureAtStartup = false;
+    std::thread m_writer;         // formats and writes the last stopped capture
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : m_name(name), m_start(Tracer::active() ? Tracer::now() : 0) {}
+    ~TraceScope() {
+        if (m_start) Tracer::getInstance().record(m_name, m_start, Tracer::now());
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifndef MXBMRP3_NO_TRACING
+// Usage: TRACE_SCOPE("HudManager::updateHuds"); - times the enclosing scope.
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(_traceScope, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Tracer::getInstance().setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
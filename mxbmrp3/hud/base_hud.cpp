@@ -16,6 +16,7 @@
 #include "../diagnostics/logger.h"
 #include "../handlers/draw_handler.h"
 #include "../diagnostics/timer.h"
+#include "../diagnostics/tracer.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -249,8 +250,23 @@ bool BaseHud::clampPositionToBounds(float& offsetX, float& offsetY, const Window
     return needsAdjustment;
 }
 
+const char* BaseHud::getTraceName() {
+    if (!m_traceName) {
+        // Same name the benchmark profiler shows (it names the HUDs that have no
+        // texture base), else the texture base.
+        const auto& bm = PluginData::getInstance().getBenchmarkMetrics();
+        std::string name = (m_benchmarkIndex >= 0 && m_benchmarkIndex < bm.hudCount)
+            ? std::string(bm.huds[m_benchmarkIndex].name) : getTextureBaseName();
+        m_traceName = Tracer::getInstance().intern("Rebuild " + (name.empty() ? std::string("hud") : name));
+    }
+    return m_traceName;
+}
+
 void BaseHud::processDirtyFlags() {
-    if (isDataDirty()) {
+    // Layout and motion on the same frame: one full rebuild covers both rather
+    // than a layout pass followed by a motion pass.
+    if (isDataDirty() || (isLayoutDirty() && isMotionDirty())) {
+        TRACE_SCOPE(getTraceName());
         // Time the rebuild if benchmark is active and this HUD is registered
         auto& bm = PluginData::getInstance().getBenchmarkMetrics();
         if (bm.active && m_benchmarkIndex >= 0) {
@@ -264,6 +280,7 @@ void BaseHud::processDirtyFlags() {
         onAfterDataRebuild();
         clearDataDirty();
         clearLayoutDirty();
+        clearMotionDirty();
     }
     else if (isLayoutDirty()) {
         rebuildLayout();
@@ -273,6 +290,10 @@ void BaseHud::processDirtyFlags() {
         positionTitleIcon();
         clearLayoutDirty();
     }
+    else if (isMotionDirty()) {
+        rebuildMotion();
+        clearMotionDirty();
+    }
 }
 
 // ============================================================================
@@ -12,10 +12,12 @@
 #include <array>
 #include <atomic>
 #include "../game/game_config.h"
+#include "../core/compact_strings.h"
 #include "../core/input_manager.h"
 #include "../core/plugin_data.h"
 #include "../core/color_config.h"
 #include "../core/font_config.h"
+#include "polyline_builder.h"
 
 // Configuration for individual HUD strings with per-string padding and backgrounds
 struct HudStringConfig {
@@ -73,8 +75,7 @@ public:
     virtual bool handlesDataType(DataChangeType dataType) const = 0;
 
     const std::vector<SPluginQuad_t>& getQuads() const { return m_quads; }
-    const std::vector<SPluginString_t>& getStrings() const { return m_strings; }
-    const std::vector<bool>& getStringSkipShadow() const { return m_stringSkipShadow; }
+    const CompactStringArena& getStrings() const { return m_strings; }
 
     // Visibility controls
     virtual void setVisible(bool visible) {
@@ -258,6 +259,8 @@ public:
     // Benchmark profiling support
     void setBenchmarkIndex(int index) { m_benchmarkIndex = index; }
     int getBenchmarkIndex() const { return m_benchmarkIndex; }
+    // Trace event name for this HUD's rebuild ("Rebuild <texture base>"), interned once.
+    const char* getTraceName();
 
     void setDataDirty() {
         m_bDataDirty = true;
@@ -268,6 +271,12 @@ public:
         m_bLayoutDirty = true;
     }
 
+    // Only moving content changed (rider markers dead-reckoned to this frame):
+    // handled by rebuildMotion() unless a data/layout rebuild is pending anyway.
+    void setMotionDirty() {
+        m_bMotionDirty = true;
+    }
+
     // Process dirty flags immediately (without full update logic)
     // Only rebuilds if already marked dirty - use after batch settings changes
     void rebuildIfDirty() {
@@ -298,12 +307,15 @@ protected:
     bool clampPositionToBounds(float& offsetX, float& offsetY, const WindowBounds& windowBounds) const;
     virtual void rebuildRenderData() = 0;
     virtual void rebuildLayout() { rebuildRenderData(); }
+    virtual void rebuildMotion() { rebuildRenderData(); }
 
     bool isDataDirty() const { return m_bDataDirty; }
     bool isLayoutDirty() const { return m_bLayoutDirty; }
+    bool isMotionDirty() const { return m_bMotionDirty; }
 
     void clearDataDirty() { m_bDataDirty = false; }
     void clearLayoutDirty() { m_bLayoutDirty = false; }
+    void clearMotionDirty() { m_bMotionDirty = false; }
 
     void setBounds(float left, float top, float right, float bottom);
 
@@ -316,8 +328,10 @@ protected:
     // Standard Dirty Flag Handling
     // ========================================================================
     // Call processDirtyFlags() in update() implementations to handle the common pattern:
-    //   - If data dirty: rebuild all, call onAfterDataRebuild(), clear both flags
+    //   - If data dirty (or layout and motion both): rebuild all, call
+    //     onAfterDataRebuild(), clear every flag
     //   - Else if layout dirty: rebuild layout only, clear layout flag
+    //   - Else if motion dirty: rebuildMotion(), clear motion flag
     //
     // Override onAfterDataRebuild() if widget needs to update caches after rebuildRenderData().
     void processDirtyFlags();
@@ -328,10 +342,10 @@ protected:
     void addString(const char* text, float x, float y, int justify, int fontIndex,
                    unsigned long color, float fontSize, bool skipShadow = false);
 
-    // Clear strings and associated shadow flags (use instead of m_strings.clear()).
-    // Also invalidates the title-icon/string indices so a rebuild path that clears
-    // strings without re-emitting the title can't leave them pointing at a stale quad.
-    void clearStrings() { m_strings.clear(); m_stringSkipShadow.clear(); m_titleStringIndex = -1; m_titleIconQuadIndex = -1; }
+    // Clear strings (use instead of m_strings.clear()). Also invalidates the
+    // title-icon/string indices so a rebuild path that clears strings without
+    // re-emitting the title can't leave them pointing at a stale quad.
+    void clearStrings() { m_strings.clear(); m_titleStringIndex = -1; m_titleIconQuadIndex = -1; }
     void addTitleString(const char* text, float x, float y, int justify, int fontIndex,
                         unsigned long color, float fontSize);
     void addBackgroundQuad(float x, float y, float width, float height);
@@ -340,6 +354,16 @@ protected:
     // the height in normalized units; the sprite is tinted by color.
     void addIcon(float x, float y, int spriteIndex, unsigned long color, float size);
     void addLineSegment(float x1, float y1, float x2, float y2, unsigned long color, float thickness);
+    // Thin polyline through (xs[i], ys[i]) for i < count, batched: one quad per
+    // straight run instead of one per segment. A run continues while the next
+    // vertex stays within PolylineBuilder::COLLINEAR_PX of its line, and vertices
+    // closer than PolylineBuilder::MIN_SEGMENT_PX to the run's start are dropped
+    // (display pixels, see displayPixelsPerUnit()). A segment that stays on its
+    // own gets exactly addLineSegment()'s quad, full alpha included. Geometry in
+    // hud/polyline_builder.h.
+    void addPolyline(const float* xs, const float* ys, size_t count, unsigned long color, float thickness);
+    // Scratch for HUDs assembling a polyline for addPolyline() (kept to reuse capacity)
+    std::vector<float> m_polylineX, m_polylineY;
     void addHorizontalGridLine(float x, float y, float width, unsigned long color, float thickness);
     static void setQuadPositions(SPluginQuad_t& quad, float x, float y, float width, float height);
 
@@ -435,14 +459,23 @@ protected:
                             const char* topLabel, const char* midLabel, const char* botLabel,
                             const ScaledDimensions& dims);
 
-    // One scrolling history trace: a polyline over a deque of 0..1 samples, with
-    // the newest sample pinned to the right edge (the graph scrolls left as the
-    // deque fills). Segments where both endpoints are near zero are skipped so an
-    // idle channel costs nothing. maxHistory fixes the point spacing so the graph
-    // width is constant regardless of how full the deque is.
-    void addStripChartHistoryLine(const std::deque<float>& history, unsigned long color,
+    // Display pixels per unit of normalized X: the 16:9 UI area's pixel width
+    // (pillarboxed on wider windows). Before the game window is known, a 4K-wide
+    // UI, so nothing sized from it merges points a real display would separate.
+    float displayPixelsPerUnit() const;
+
+    // One scrolling history trace over a SampleHistory of 0..1 samples, with the
+    // newest sample pinned to the right edge (the graph scrolls left as the
+    // history fills). maxHistory fixes the point spacing so the graph width is
+    // constant regardless of how full the history is. The trace reads the
+    // history's mip level that fits the plot's pixel columns: one point per
+    // sample while the plot is wider than the history (the common case), a
+    // min/max stroke per pixel column when it is narrower. skipIdle drops
+    // segments whose endpoints are both near zero, so an idle channel costs
+    // nothing. Drawn with addPolyline(), one call per unbroken run.
+    void addStripChartHistoryLine(const SampleHistory& history, unsigned long color,
                                   float x, float y, float width, float height,
-                                  float lineThickness, size_t maxHistory);
+                                  float lineThickness, size_t maxHistory, bool skipIdle = true);
 
     // Helper method to calculate text color with opacity (eliminates duplication in widgets)
     unsigned long getTextColorWithOpacity(uint8_t r = 255, uint8_t g = 255, uint8_t b = 255) const;
@@ -499,8 +532,7 @@ public:
     bool getEffectiveDropShadow(bool globalDefault) const { return m_dropShadowOverride.value_or(globalDefault); }
 
     std::vector<SPluginQuad_t> m_quads;
-    std::vector<SPluginString_t> m_strings;
-    std::vector<bool> m_stringSkipShadow;  // Parallel to m_strings: true = skip drop shadow for this string
+    CompactStringArena m_strings;  // compact records + text; expanded once per frame (core/compact_strings.h)
     std::vector<HudStringConfig> m_styledStringConfigs;  // Storage for styled string configurations
     float m_fScale;
 
@@ -555,13 +587,19 @@ public:
 
     // Benchmark profiling index (registered in BenchmarkMetrics, -1 = not registered)
     int m_benchmarkIndex;
+    const char* m_traceName = nullptr;   // see getTraceName()
 
 private:
+    // addPolyline()'s working set: offset points and per-segment unit normals/lengths
+    std::vector<float> m_polylineOffsetX, m_polylineOffsetY;
+    PolylineBuilder::Scratch m_polyline;
+
     // Atomic for the same cross-thread reason as m_bVisible (see comment
     // there). Note setDataDirty() writes BOTH flags, so the background
     // callers that mark HUDs dirty reach m_bLayoutDirty too.
     std::atomic<bool> m_bDataDirty;
     std::atomic<bool> m_bLayoutDirty;
+    std::atomic<bool> m_bMotionDirty{false};
 
     bool m_bDraggable;
     bool m_bDragging;
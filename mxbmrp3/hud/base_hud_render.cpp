@@ -48,21 +48,10 @@ namespace {
 // and rows scramble on drag/scale.
 void BaseHud::addString(const char* text, float x, float y, int justify, int fontIndex,
                         unsigned long color, float fontSize, bool skipShadow) {
-    SPluginString_t stringEntry;
-
-    strncpy_s(stringEntry.m_szString, sizeof(stringEntry.m_szString), text, sizeof(stringEntry.m_szString) - 1);
-    stringEntry.m_szString[sizeof(stringEntry.m_szString) - 1] = '\0';
-
     applyOffset(x, y);
-    stringEntry.m_afPos[0] = x;
-    stringEntry.m_afPos[1] = y;
-    stringEntry.m_iFont = fontIndex;
-    stringEntry.m_fSize = fontSize;
-    stringEntry.m_iJustify = justify;
-    stringEntry.m_ulColor = color;
-
-    m_strings.push_back(stringEntry);
-    m_stringSkipShadow.push_back(skipShadow);  // Track shadow flag (shadow generated at collection time)
+    // A compact record + the text in the HUD's arena; the shadow flag rides in the
+    // record (the shadow itself is generated at collection time).
+    m_strings.add(text, x, y, justify, fontIndex, color, fontSize, skipShadow);
 }
 
 void BaseHud::addTitleString(const char* text, float x, float y, int justify, int fontIndex,
@@ -240,43 +229,32 @@ void BaseHud::addIcon(float x, float y, int spriteIndex, unsigned long color, fl
 }
 
 void BaseHud::addLineSegment(float x1, float y1, float x2, float y2, unsigned long color, float thickness) {
-    using namespace PluginConstants;
-
-    SPluginQuad_t quadEntry;
-
     // Apply offset
     applyOffset(x1, y1);
     applyOffset(x2, y2);
 
-    // Calculate perpendicular direction for thickness
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float len = std::sqrt(dx * dx + dy * dy);
-
-    if (len < 0.0001f) return;  // Skip zero-length segments
-
-    // Perpendicular vector (normalized) - try reversed direction
-    float px = dy / len;
-    float py = -dx / len;
-
-    // Half thickness offset (apply aspect ratio correction to horizontal component)
-    float hx = (px * thickness * 0.5f) / PluginConstants::UI_ASPECT_RATIO;
-    float hy = py * thickness * 0.5f;
+    // The pixel scales only drive addPolyline()'s run merging
+    const PolylineBuilder::Stroke stroke{ color, thickness, PluginConstants::UI_ASPECT_RATIO, 0.0f, 0.0f };
+    PolylineBuilder::appendSegment(m_quads, x1, y1, x2, y2, stroke);
+}
 
-    // Create rectangle quad (match stick trail pattern exactly: p1+perp, p1-perp, p2-perp, p2+perp)
-    quadEntry.m_aafPos[0][0] = x1 + hx;
-    quadEntry.m_aafPos[0][1] = y1 + hy;
-    quadEntry.m_aafPos[1][0] = x1 - hx;
-    quadEntry.m_aafPos[1][1] = y1 - hy;
-    quadEntry.m_aafPos[2][0] = x2 - hx;
-    quadEntry.m_aafPos[2][1] = y2 - hy;
-    quadEntry.m_aafPos[3][0] = x2 + hx;
-    quadEntry.m_aafPos[3][1] = y2 + hy;
+void BaseHud::addPolyline(const float* xs, const float* ys, size_t count, unsigned long color, float thickness) {
+    using namespace PluginConstants;
 
-    quadEntry.m_iSprite = SpriteIndex::SOLID_COLOR;
-    quadEntry.m_ulColor = color | 0xFF000000;  // Ensure full alpha
+    if (count < 2) return;
+    m_polylineOffsetX.resize(count);
+    m_polylineOffsetY.resize(count);
+    const float offsetX = m_fOffsetX, offsetY = m_fOffsetY;
+    for (size_t i = 0; i < count; ++i) {
+        m_polylineOffsetX[i] = xs[i] + offsetX;
+        m_polylineOffsetY[i] = ys[i] + offsetY;
+    }
 
-    m_quads.push_back(quadEntry);
+    // Runs are merged in display pixels (16:9 UI, so y has 9/16 the pixels of x)
+    const float pxX = displayPixelsPerUnit();
+    const PolylineBuilder::Stroke stroke{ color, thickness, UI_ASPECT_RATIO, pxX, pxX / UI_ASPECT_RATIO };
+    PolylineBuilder::appendPolyline(m_quads, m_polylineOffsetX.data(), m_polylineOffsetY.data(), count,
+                                    stroke, m_polyline);
 }
 
 void BaseHud::addNeedleQuad(float centerX, float centerY, float angleRad,
@@ -444,32 +422,70 @@ void BaseHud::addStripChartFrame(float x, float y, float width, float height,
     addString(botLabel, labelX, y + height - dims.lineHeightSmall, PluginConstants::Justify::LEFT, labelFont, labelColor, dims.fontSizeSmall);
 }
 
-void BaseHud::addStripChartHistoryLine(const std::deque<float>& history, unsigned long color,
+float BaseHud::displayPixelsPerUnit() const {
+    const InputManager& input = InputManager::getInstance();
+    const int winW = input.getWindowWidth(), winH = input.getWindowHeight();
+    if (winW <= 0 || winH <= 0) return 3840.0f;
+    return std::min(static_cast<float>(winW), static_cast<float>(winH) * PluginConstants::UI_ASPECT_RATIO);
+}
+
+void BaseHud::addStripChartHistoryLine(const SampleHistory& history, unsigned long color,
                                        float x, float y, float width, float height,
-                                       float lineThickness, size_t maxHistory) {
+                                       float lineThickness, size_t maxHistory, bool skipIdle) {
     if (history.size() < 2) return;
 
     // Calculate point spacing based on max history size for consistent graph width
-    float pointSpacing = width / (maxHistory - 1);
-
+    const float pointSpacing = width / (maxHistory - 1);
     // Offset so newest data is always at right edge (scrolls left as data fills in)
-    size_t offset = maxHistory - history.size();
-
-    // Draw line segments connecting consecutive points
-    for (size_t i = 0; i < history.size() - 1; ++i) {
-        float value1 = std::max(0.0f, std::min(1.0f, history[i]));
-        float value2 = std::max(0.0f, std::min(1.0f, history[i + 1]));
-
-        // Skip segments where both values are near zero
-        if (value1 < 0.01f && value2 < 0.01f) continue;
-
-        float x1 = x + (offset + i) * pointSpacing;
-        float x2 = x + (offset + i + 1) * pointSpacing;
-        float y1 = y + height - (value1 * height);
-        float y2 = y + height - (value2 * height);
+    const size_t offset = maxHistory - std::min(history.size(), maxHistory);
+    // One column per display pixel at most; a plot wider than the history reads
+    // every sample (level 0).
+    const size_t pixelColumns = std::max<size_t>(2, static_cast<size_t>(width * displayPixelsPerUnit()));
+    const int level = history.levelFor(pixelColumns);
+    const size_t columns = history.columnCount(level);
+
+    // Walk the points left to right, breaking the polyline at idle segments.
+    m_polylineX.clear();
+    m_polylineY.clear();
+    bool hasLast = false;
+    float lastX = 0.0f, lastValue = 0.0f;
+    auto flush = [&]() {
+        if (m_polylineX.size() >= 2) {
+            addPolyline(m_polylineX.data(), m_polylineY.data(), m_polylineX.size(), color, lineThickness);
+        }
+        m_polylineX.clear();
+        m_polylineY.clear();
+    };
+    auto addPoint = [&](float px, float value) {
+        if (hasLast) {
+            // Skip segments where both values are near zero
+            if (skipIdle && lastValue < 0.01f && value < 0.01f) {
+                flush();
+            } else {
+                if (m_polylineX.empty()) {
+                    m_polylineX.push_back(lastX);
+                    m_polylineY.push_back(y + height - (lastValue * height));
+                }
+                m_polylineX.push_back(px);
+                m_polylineY.push_back(y + height - (value * height));
+            }
+        }
+        hasLast = true;
+        lastX = px;
+        lastValue = value;
+    };
 
-        addLineSegment(x1, y1, x2, y2, color, lineThickness);
+    for (size_t j = 0; j < columns; ++j) {
+        const SampleHistory::Column c = history.column(level, j);
+        const float px = x + (offset + c.last) * pointSpacing;
+        const float hi = std::max(0.0f, std::min(1.0f, c.hi));
+        const float lo = std::max(0.0f, std::min(1.0f, c.lo));
+        // A min/max column (mip levels only) enters at its max and leaves at its
+        // min, a vertical stroke at its x; at level 0 both are the sample.
+        addPoint(px, hi);
+        if (lo != hi) addPoint(px, lo);
     }
+    flush();
 }
 
 void BaseHud::setQuadPositions(SPluginQuad_t& quad, float x, float y, float width, float height) {
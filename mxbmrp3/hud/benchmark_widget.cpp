@@ -13,6 +13,7 @@
 #include <windows.h>  // CreateDirectoryA
 
 #include "../diagnostics/logger.h"
+#include "../diagnostics/alloc_counter.h"
 #include "../core/atomic_file_writer.h"
 #include "../core/plugin_utils.h"
 #include "../core/plugin_data.h"
@@ -65,13 +66,8 @@ void BenchmarkWidget::setVisible(bool visible) {
         m_callbackSnapshots.fill({});
         m_hudSnapshots.fill({});
 
-        // Reset peak values in benchmark metrics
-        for (int i = 0; i < bm.callbackCount; ++i) {
-            bm.callbacks[i].peakTimeUs = 0;
-        }
-        for (int i = 0; i < bm.hudCount; ++i) {
-            bm.huds[i].rebuildCount = 0;
-        }
+        // Reset peaks, counts and the latency histograms in benchmark metrics
+        bm.resetSession();
 
         // Start a new full-session FPS / duration window
         resetSessionStats();
@@ -85,6 +81,18 @@ void BenchmarkWidget::resetSessionStats() {
     m_maxFrameTimeUs = 0.0;
     m_sumFrameTimeUs = 0.0;
     m_frameSampleCount = 0;
+    m_frameTimeHist.reset();
+    m_frameTimeSnapshot = {};
+    m_haveLastAllocTotal = false;
+    m_allocsPerFrameHist.reset();
+    m_allocsPerFrameSnapshot = {};
+}
+
+void BenchmarkWidget::snapshotLatency(const LatencyHistogram& hist, LatencySnapshot& out) {
+    static constexpr double QUANTILES[LATENCY_COLUMNS - 1] = { 0.50, 0.90, 0.99, 0.999 };
+    hist.quantiles(QUANTILES, out.values, LATENCY_COLUMNS - 1);
+    out.values[LATENCY_COLUMNS - 1] = hist.max();
+    out.count = static_cast<long long>(hist.count());
 }
 
 void BenchmarkWidget::sampleFrameTime() {
@@ -102,10 +110,21 @@ void BenchmarkWidget::sampleFrameTime() {
             }
             m_sumFrameTimeUs += deltaUs;
             ++m_frameSampleCount;
+            m_frameTimeHist.record(static_cast<long long>(deltaUs));
         }
     }
     m_lastFrameTime = now;
     m_haveLastFrameTime = true;
+
+    // Allocations since the previous frame, all threads (the Draw path should sit at 0)
+    if (AllocCounter::enabled()) {
+        const uint64_t allocTotal = AllocCounter::totalAllocs();
+        if (m_haveLastAllocTotal && allocTotal >= m_lastAllocTotal) {
+            m_allocsPerFrameHist.record(static_cast<long long>(allocTotal - m_lastAllocTotal));
+        }
+        m_lastAllocTotal = allocTotal;
+        m_haveLastAllocTotal = true;
+    }
 }
 
 void BenchmarkWidget::update() {
@@ -142,6 +161,7 @@ void BenchmarkWidget::takeSnapshot() {
         m_callbackSnapshots[i].totalTimeUs = static_cast<float>(bm.callbacks[i].totalTimeUs);
         m_callbackSnapshots[i].peakTimeUs = static_cast<float>(bm.callbacks[i].peakTimeUs);
         m_callbackSnapshots[i].callCount = bm.callbacks[i].callCount;
+        snapshotLatency(bm.callbacks[i].latency, m_callbackSnapshots[i].latency);
     }
 
     // Snapshot HUD rebuild timing
@@ -151,7 +171,10 @@ void BenchmarkWidget::takeSnapshot() {
                   bm.huds[i].name, _TRUNCATE);
         m_hudSnapshots[i].lastRebuildTimeUs = static_cast<float>(bm.huds[i].lastRebuildTimeUs);
         m_hudSnapshots[i].rebuildsInInterval = bm.huds[i].rebuildCount;
+        snapshotLatency(bm.huds[i].latency, m_hudSnapshots[i].latency);
     }
+    snapshotLatency(m_frameTimeHist, m_frameTimeSnapshot);
+    snapshotLatency(m_allocsPerFrameHist, m_allocsPerFrameSnapshot);
 
     // Snapshot aggregate metrics
     m_totalCallbackTimeUs = 0;
@@ -161,6 +184,7 @@ void BenchmarkWidget::takeSnapshot() {
     m_collectRenderTimeUs = static_cast<float>(bm.collectRenderTimeUs);
     m_totalQuadCount = bm.totalQuads;
     m_totalStringCount = bm.totalStrings;
+    m_frameBytesMoved = bm.frameBytesMoved;
 
     // Reset all counters for next interval
     for (int i = 0; i < bm.callbackCount; ++i) {
@@ -188,7 +212,7 @@ void BenchmarkWidget::rebuildRenderData() {
     rowCount += 1;     // Callback section header
     int activeCallbacks = 0;
     for (int i = 0; i < m_snapshotCount; ++i) {
-        if (m_callbackSnapshots[i].callCount > 0) {
+        if (m_callbackSnapshots[i].latency.count > 0) {
             activeCallbacks++;
         }
     }
@@ -197,13 +221,14 @@ void BenchmarkWidget::rebuildRenderData() {
     rowCount += 1;     // HUD rebuilds header
     int activeHuds = 0;
     for (int i = 0; i < m_hudSnapshotCount; ++i) {
-        if (m_hudSnapshots[i].rebuildsInInterval > 0 || m_hudSnapshots[i].lastRebuildTimeUs > 0) {
+        if (m_hudSnapshots[i].latency.count > 0) {
             activeHuds++;
         }
     }
     rowCount += (activeHuds > 0) ? activeHuds : 1;  // At least "(none)" row
     rowCount += 1;     // Blank separator
-    rowCount += 3;     // Footer (collect time, quads, strings)
+    rowCount += 4;     // Footer (collect time, quads, frame time, total)
+    if (AllocCounter::enabled()) rowCount += 1;  // Allocs/frame
 
     float titleHeight = m_bShowTitle ? dim.lineHeightLarge : 0.0f;
     float backgroundHeight = dim.paddingV + titleHeight + (rowCount * dim.lineHeightNormal) + dim.paddingV;
@@ -219,26 +244,46 @@ void BenchmarkWidget::rebuildRenderData() {
         this->getFont(FontCategory::TITLE), this->getColor(ColorSlot::PRIMARY), dim.fontSizeLarge);
     currentY += titleHeight;
 
-    // Column right-edge X positions for the value columns (right-aligned). Time columns
-    // are 7 chars, count columns 5 chars, with 2-char gaps. Headers right-align to the
-    // same X as their values, so they line up regardless of header font size.
+    // Column right-edge X positions (right-aligned). Both tables share the layout: a
+    // session count, then p50 / p90 / p99 / p99.9 / max latency, 6 chars each (5 + gap),
+    // all in us over the whole session. Headers right-align to the same X as their
+    // values, so they line up regardless of header font size.
     float rightEdge = contentStartX + PluginUtils::calculateMonospaceTextWidth(CONTENT_WIDTH_CHARS, dim.fontSize);
     float charW = PluginUtils::calculateMonospaceTextWidth(1, dim.fontSize);
-    float colCalls = rightEdge;
-    float colPeak  = rightEdge - 7.0f * charW;
-    float colTotal = rightEdge - 16.0f * charW;
-    float colCount = rightEdge;
-    float colLast  = rightEdge - 7.0f * charW;
+    float colLatency[LATENCY_COLUMNS];
+    for (int c = 0; c < LATENCY_COLUMNS; ++c) {
+        colLatency[c] = rightEdge - static_cast<float>((LATENCY_COLUMNS - 1 - c) * 6) * charW;
+    }
+    float colCount = rightEdge - static_cast<float>(LATENCY_COLUMNS * 6) * charW;
+    static constexpr const char* LATENCY_LABELS[LATENCY_COLUMNS] = { "p50", "p90", "p99", "p99.9", "Max" };
     int labelFont = this->getFont(FontCategory::STRONG);
     int valueFont = this->getFont(FontCategory::DIGITS);
     unsigned long labelColor = this->getColor(ColorSlot::TERTIARY);
 
+    // One table row's numbers: count + latency columns, 100000 us and up as "123k".
+    auto addLatencyRow = [&](const LatencySnapshot& lat, unsigned long color) {
+        char buf[24];   // "%lld" of any long long, plus the "k" suffix
+        if (lat.count < 1000000) snprintf(buf, sizeof(buf), "%lld", lat.count);
+        else snprintf(buf, sizeof(buf), "%.1fM", static_cast<double>(lat.count) / 1.0e6);
+        addString(buf, colCount, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
+        for (int c = 0; c < LATENCY_COLUMNS; ++c) {
+            long long v = lat.values[c];
+            if (v < 100000) snprintf(buf, sizeof(buf), "%lld", v);
+            else snprintf(buf, sizeof(buf), "%lldk", v / 1000);
+            addString(buf, colLatency[c], currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
+        }
+    };
+    auto addLatencyHeader = [&](const char* countLabel) {
+        addLabel(countLabel, colCount, currentY, Justify::RIGHT, labelFont, labelColor, dim);
+        for (int c = 0; c < LATENCY_COLUMNS; ++c) {
+            addLabel(LATENCY_LABELS[c], colLatency[c], currentY, Justify::RIGHT, labelFont, labelColor, dim);
+        }
+    };
+
     // === CALLBACK SECTION ===
     addString("Callbacks", contentStartX, currentY, Justify::LEFT,
         labelFont, this->getColor(ColorSlot::PRIMARY), dim.fontSize);
-    addLabel("Total us", colTotal, currentY, Justify::RIGHT, labelFont, labelColor, dim);
-    addLabel("Peak us", colPeak, currentY, Justify::RIGHT, labelFont, labelColor, dim);
-    addLabel("Calls", colCalls, currentY, Justify::RIGHT, labelFont, labelColor, dim);
+    addLatencyHeader("Calls");
     currentY += dim.lineHeightNormal;
 
     if (activeCallbacks == 0) {
@@ -247,30 +292,26 @@ void BenchmarkWidget::rebuildRenderData() {
         currentY += dim.lineHeightNormal;
     } else {
         for (int i = 0; i < m_snapshotCount; ++i) {
-            if (m_callbackSnapshots[i].callCount <= 0) continue;
+            const LatencySnapshot& lat = m_callbackSnapshots[i].latency;
+            if (lat.count <= 0) continue;
 
             // Callback name (left-aligned)
             addString(m_callbackSnapshots[i].name, contentStartX, currentY, Justify::LEFT,
                 this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
 
-            // Color based on peak single-call time vs frame budget (4170us at 240fps)
+            // Color based on p99 single-call time vs frame budget (4170us at 240fps)
             // Green < 1000us (< 25%), Yellow < 2500us (< 60%), Red > 2500us
+            long long p99 = lat.values[2];
             unsigned long color;
-            if (m_callbackSnapshots[i].peakTimeUs < 1000.0f) {
+            if (p99 < 1000) {
                 color = this->getColor(ColorSlot::POSITIVE);
-            } else if (m_callbackSnapshots[i].peakTimeUs < 2500.0f) {
+            } else if (p99 < 2500) {
                 color = this->getColor(ColorSlot::WARNING);
             } else {
                 color = this->getColor(ColorSlot::NEGATIVE);
             }
 
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%.0f", m_callbackSnapshots[i].totalTimeUs);
-            addString(buf, colTotal, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
-            snprintf(buf, sizeof(buf), "%.0f", m_callbackSnapshots[i].peakTimeUs);
-            addString(buf, colPeak, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
-            snprintf(buf, sizeof(buf), "%d", m_callbackSnapshots[i].callCount);
-            addString(buf, colCalls, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
+            addLatencyRow(lat, color);
             currentY += dim.lineHeightNormal;
         }
     }
@@ -281,8 +322,7 @@ void BenchmarkWidget::rebuildRenderData() {
     // === HUD REBUILD SECTION ===
     addString("HUD rebuilds", contentStartX, currentY, Justify::LEFT,
         labelFont, this->getColor(ColorSlot::PRIMARY), dim.fontSize);
-    addLabel("Last us", colLast, currentY, Justify::RIGHT, labelFont, labelColor, dim);
-    addLabel("Count", colCount, currentY, Justify::RIGHT, labelFont, labelColor, dim);
+    addLatencyHeader("Count");
     currentY += dim.lineHeightNormal;
 
     if (activeHuds == 0) {
@@ -291,27 +331,25 @@ void BenchmarkWidget::rebuildRenderData() {
         currentY += dim.lineHeightNormal;
     } else {
         for (int i = 0; i < m_hudSnapshotCount; ++i) {
-            if (m_hudSnapshots[i].rebuildsInInterval <= 0 && m_hudSnapshots[i].lastRebuildTimeUs <= 0) continue;
+            const LatencySnapshot& lat = m_hudSnapshots[i].latency;
+            if (lat.count <= 0) continue;
 
             // HUD name
             addString(m_hudSnapshots[i].name, contentStartX, currentY, Justify::LEFT,
                 this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
 
-            // Color based on rebuild time
+            // Color based on p99 rebuild time
+            long long p99 = lat.values[2];
             unsigned long color;
-            if (m_hudSnapshots[i].lastRebuildTimeUs < 100.0f) {
+            if (p99 < 100) {
                 color = this->getColor(ColorSlot::POSITIVE);
-            } else if (m_hudSnapshots[i].lastRebuildTimeUs < 500.0f) {
+            } else if (p99 < 500) {
                 color = this->getColor(ColorSlot::WARNING);
             } else {
                 color = this->getColor(ColorSlot::NEGATIVE);
             }
 
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%.0f", m_hudSnapshots[i].lastRebuildTimeUs);
-            addString(buf, colLast, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
-            snprintf(buf, sizeof(buf), "%d", m_hudSnapshots[i].rebuildsInInterval);
-            addString(buf, colCount, currentY, Justify::RIGHT, valueFont, color, dim.fontSize);
+            addLatencyRow(lat, color);
             currentY += dim.lineHeightNormal;
         }
     }
@@ -325,6 +363,11 @@ void BenchmarkWidget::rebuildRenderData() {
     snprintf(footer, sizeof(footer), "Collect render: %.0f us", m_collectRenderTimeUs);
     addString(footer, contentStartX, currentY, Justify::LEFT,
         this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
+
+    // Render-pipeline bytes written per frame (collect + expand + copies).
+    snprintf(footer, sizeof(footer), "Moved: %.1f KB", static_cast<double>(m_frameBytesMoved) / 1024.0);
+    addString(footer, rightEdge, currentY, Justify::RIGHT,
+        this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
     currentY += dim.lineHeightNormal;
 
     snprintf(footer, sizeof(footer), "Quads: %d", m_totalQuadCount);
@@ -336,6 +379,24 @@ void BenchmarkWidget::rebuildRenderData() {
         this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
     currentY += dim.lineHeightNormal;
 
+    // Frame interval percentiles over the session (stutter shows up in p99.9)
+    snprintf(footer, sizeof(footer), "Frame ms  p50 %.2f  p99 %.2f  p99.9 %.2f  max %.0f",
+             m_frameTimeSnapshot.values[0] / 1000.0, m_frameTimeSnapshot.values[2] / 1000.0,
+             m_frameTimeSnapshot.values[3] / 1000.0, m_frameTimeSnapshot.values[4] / 1000.0);
+    addString(footer, contentStartX, currentY, Justify::LEFT,
+        this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
+    currentY += dim.lineHeightNormal;
+
+    // Heap allocations per frame over the session (steady state should be p50 0)
+    if (AllocCounter::enabled()) {
+        snprintf(footer, sizeof(footer), "Allocs/frame  p50 %lld  p99 %lld  max %lld",
+                 m_allocsPerFrameSnapshot.values[0], m_allocsPerFrameSnapshot.values[2],
+                 m_allocsPerFrameSnapshot.values[4]);
+        addString(footer, contentStartX, currentY, Justify::LEFT,
+            this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::SECONDARY), dim.fontSize);
+        currentY += dim.lineHeightNormal;
+    }
+
     // Total callback time
     snprintf(footer, sizeof(footer), "Total callback: %.0f us (%.2f ms)",
              m_totalCallbackTimeUs, m_totalCallbackTimeUs / 1000.0f);
@@ -429,12 +490,77 @@ bool BenchmarkWidget::exportReport(const char* savePath) const {
     }
     out += "\n";
 
+    // Session latency (whole benchmark session, not the last snapshot interval)
+    auto latencyHeader = [&](const char* title, const char* countLabel) {
+        out += title;
+        snprintf(line, sizeof(line), "%-24s %10s %8s %8s %8s %8s %8s\n",
+                 "Name", countLabel, "p50 us", "p90 us", "p99 us", "p99.9 us", "Max us"); out += line;
+        snprintf(line, sizeof(line), "%-24s %10s %8s %8s %8s %8s %8s\n", "------------------------",
+                 "----------", "--------", "--------", "--------", "--------", "--------"); out += line;
+    };
+    auto latencyRow = [&](const char* name, const LatencySnapshot& lat) {
+        if (lat.count <= 0) return;
+        snprintf(line, sizeof(line), "%-24s %10lld %8lld %8lld %8lld %8lld %8lld\n", name,
+                 lat.count, lat.values[0], lat.values[1], lat.values[2], lat.values[3], lat.values[4]);
+        out += line;
+    };
+    latencyHeader("=== CALLBACK LATENCY (session) ===\n", "Calls");
+    for (int i = 0; i < m_snapshotCount; ++i) {
+        latencyRow(m_callbackSnapshots[i].name, m_callbackSnapshots[i].latency);
+    }
+    out += "\n";
+    latencyHeader("=== HUD REBUILD LATENCY (session) ===\n", "Rebuilds");
+    for (int i = 0; i < m_hudSnapshotCount; ++i) {
+        latencyRow(m_hudSnapshots[i].name, m_hudSnapshots[i].latency);
+    }
+    out += "\n";
+
+    // Frame intervals over the session. "1% low" FPS is the rate at the p99 frame time.
+    out += "=== FRAME TIME (session) ===\n";
+    if (m_frameTimeSnapshot.count > 0) {
+        const long long* v = m_frameTimeSnapshot.values;
+        snprintf(line, sizeof(line), "Frame ms: p50 %.2f, p90 %.2f, p99 %.2f, p99.9 %.2f, max %.2f (%lld frames)\n",
+                 v[0] / 1000.0, v[1] / 1000.0, v[2] / 1000.0, v[3] / 1000.0, v[4] / 1000.0,
+                 m_frameTimeSnapshot.count); out += line;
+        if (v[2] > 0 && v[3] > 0) {
+            snprintf(line, sizeof(line), "1%% low FPS: %.1f, 0.1%% low FPS: %.1f\n",
+                     1.0e6 / static_cast<double>(v[2]), 1.0e6 / static_cast<double>(v[3])); out += line;
+        }
+    } else {
+        out += "Frame ms: (no samples)\n";
+    }
+    out += "\n";
+
+    // Heap allocations (builds with allocation counting only)
+    if (AllocCounter::enabled()) {
+        out += "=== ALLOCATIONS ===\n";
+        if (m_allocsPerFrameSnapshot.count > 0) {
+            const long long* v = m_allocsPerFrameSnapshot.values;
+            snprintf(line, sizeof(line), "Allocs/frame: p50 %lld, p90 %lld, p99 %lld, p99.9 %lld, max %lld (%lld frames)\n",
+                     v[0], v[1], v[2], v[3], v[4], m_allocsPerFrameSnapshot.count); out += line;
+        } else {
+            out += "Allocs/frame: (no samples)\n";
+        }
+        snprintf(line, sizeof(line), "%-24s %12s %12s %14s\n", "Phase", "Allocs", "Frees", "Bytes"); out += line;
+        snprintf(line, sizeof(line), "%-24s %12s %12s %14s\n", "------------------------",
+                 "------------", "------------", "--------------"); out += line;
+        for (int i = 0; i < AllocCounter::PHASE_COUNT; ++i) {
+            const auto phase = static_cast<AllocCounter::Phase>(i);
+            const AllocCounter::Counts c = AllocCounter::totalCounts(phase);
+            snprintf(line, sizeof(line), "%-24s %12llu %12llu %14llu\n", AllocCounter::phaseName(phase),
+                     static_cast<unsigned long long>(c.allocs), static_cast<unsigned long long>(c.frees),
+                     static_cast<unsigned long long>(c.bytes)); out += line;
+        }
+        out += "\n";
+    }
+
     // Aggregate
     out += "=== AGGREGATE ===\n";
     snprintf(line, sizeof(line), "Total callback time: %.0f us (%.2f ms)\n", m_totalCallbackTimeUs, m_totalCallbackTimeUs / 1000.0f); out += line;
     snprintf(line, sizeof(line), "Collect render time: %.0f us\n", m_collectRenderTimeUs); out += line;
     snprintf(line, sizeof(line), "Total quads: %d\n", m_totalQuadCount); out += line;
     snprintf(line, sizeof(line), "Total strings: %d\n", m_totalStringCount); out += line;
+    snprintf(line, sizeof(line), "Bytes moved per frame: %lld\n", m_frameBytesMoved); out += line;
 
     if (!AtomicFileWriter::writeFileAtomic(filePath, out)) {
         DEBUG_WARN_F("BenchmarkWidget: Failed to write %s", filePath.c_str());
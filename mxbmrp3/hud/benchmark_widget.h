@@ -7,6 +7,7 @@
 
 #include "base_hud.h"
 #include "../core/plugin_constants.h"
+#include "../core/latency_histogram.h"
 #include <array>
 #include <chrono>
 
@@ -33,18 +34,27 @@ private:
     // Layout constants
     static constexpr float START_X = 0.0f;
     static constexpr float START_Y = 0.0f;
-    static constexpr int CONTENT_WIDTH_CHARS = 40;  // Wide enough for "CallbackName    0.123ms  Peak 0.456ms"
+    static constexpr int CONTENT_WIDTH_CHARS = 54;  // Name + count + five 6-char latency columns
 
     // Snapshot interval - update displayed values at a readable rate
     static constexpr int SNAPSHOT_INTERVAL_FRAMES = 30;  // Update ~8x per second at 240fps
     int m_frameCounter = 0;
 
+    // Session latency columns, read from the LatencyHistograms at each snapshot
+    static constexpr int LATENCY_COLUMNS = 5;  // p50, p90, p99, p99.9, max
+    struct LatencySnapshot {
+        long long values[LATENCY_COLUMNS];  // us
+        long long count;                    // samples this session
+    };
+    static void snapshotLatency(const LatencyHistogram& hist, LatencySnapshot& out);
+
     // Snapshot of timing data (updated every SNAPSHOT_INTERVAL_FRAMES)
     struct CallbackSnapshot {
         char name[24];
         float totalTimeUs;     // Total accumulated time over snapshot interval
         float peakTimeUs;    // Peak time over snapshot interval
         int callCount;       // Calls during snapshot interval
+        LatencySnapshot latency;  // Per-call latency over the session
     };
 
     static constexpr int MAX_CALLBACKS = 32;
@@ -56,6 +66,7 @@ private:
         char name[24];
         float lastRebuildTimeUs;
         int rebuildsInInterval;
+        LatencySnapshot latency;  // Rebuild latency over the session
     };
 
     static constexpr int MAX_HUD_SNAPSHOTS = 32;
@@ -67,6 +78,7 @@ private:
     float m_collectRenderTimeUs = 0.0f;
     int m_totalQuadCount = 0;
     int m_totalStringCount = 0;
+    long long m_frameBytesMoved = 0;
 
     // Benchmark session FPS / duration tracking (full-session, not per-snapshot)
     std::chrono::steady_clock::time_point m_sessionStart{};
@@ -76,6 +88,15 @@ private:
     double m_maxFrameTimeUs = 0.0;
     double m_sumFrameTimeUs = 0.0;
     long long m_frameSampleCount = 0;
+    LatencyHistogram m_frameTimeHist;   // Frame intervals (us) over the session
+    LatencySnapshot m_frameTimeSnapshot{};
+
+    // Heap allocations per frame (all threads, frame to frame) over the session.
+    // Only sampled when allocation counting is compiled in (AllocCounter::enabled()).
+    uint64_t m_lastAllocTotal = 0;
+    bool m_haveLastAllocTotal = false;
+    LatencyHistogram m_allocsPerFrameHist;  // Counts, not us; same bucket math
+    LatencySnapshot m_allocsPerFrameSnapshot{};
 
     void resetSessionStats();
     void sampleFrameTime();
@@ -415,7 +415,7 @@ void EventLogHud::rebuildLayout() {
         size_t msgIdx = stringIndex;
         positionString(stringIndex++, messageX, currentY);     // message
         // Detail: position after message text (message width + 1 char gap)
-        int msgLen = static_cast<int>(strlen(m_strings[msgIdx].m_szString));
+        int msgLen = static_cast<int>(m_strings.length(msgIdx));
         float detailX = messageX + PluginUtils::calculateMonospaceTextWidth(msgLen + 1, dim.fontSize);
         positionString(stringIndex++, detailX, currentY);      // detail
         currentY += dim.lineHeightNormal;
@@ -23,6 +23,7 @@ GapBarHud::GapBarHud()
     : m_bestLapTime(0)
     , m_hasBestLap(false)
     , m_currentTrackPos(0.0f)
+    , m_displayTrackPos(0.0f)
     , m_currentLapNum(0)
     , m_observedLapStart(false)
     , m_cachedDisplayRaceNum(-1)
@@ -254,6 +255,7 @@ void GapBarHud::updateTrackPosition(int raceNum, float trackPos, int lapNum) {
     // Clamp track position to valid range (defensive - API should provide valid values)
     trackPos = std::clamp(trackPos, 0.0f, 1.0f);
     m_currentTrackPos = trackPos;
+    m_displayTrackPos = trackPos;
 
     if (!m_trackMonitor.initialized) {
         m_trackMonitor.lastTrackPos = trackPos;
@@ -489,6 +491,7 @@ void GapBarHud::resetTimingState() {
     m_hasBestLap = false;
     m_bestLapTime = 0;
     m_currentTrackPos = 0.0f;
+    m_displayTrackPos = 0.0f;
     m_currentLapNum = 0;
     m_observedLapStart = false;
     m_cachedLastCompletedLapNum = -1;
@@ -745,13 +748,21 @@ void GapBarHud::updateRiderPositions(int numVehicles, const Unified::TrackPositi
         return;
     }
 
+    // The self marker follows the displayed rider's predicted position; timing and
+    // S/F detection keep the raw trackPos from updateTrackPosition()
+    for (int i = 0; i < numVehicles; ++i) {
+        if (positions[i].raceNum == m_cachedDisplayRaceNum) {
+            m_displayTrackPos = std::clamp(positions[i].trackPos, 0.0f, 1.0f);
+            break;
+        }
+    }
+
     // Only store if we're showing opponents
     if (m_markerMode == MarkerMode::OPPONENTS || m_markerMode == MarkerMode::GHOST_OPPONENTS) {
         m_riderPositions.assign(positions, positions + numVehicles);
-        if (isVisibleAnySurface()) {
-            setDataDirty();
-        }
     }
+    // No dirty flag: update() already rebuilds every UPDATE_INTERVAL_MS while
+    // visible, and a marker on the bar moves well under a pixel per rebuild
 }
 
 // ============================================================================
@@ -883,8 +894,9 @@ void GapBarHud::renderRiderMarkers(float innerX, float innerY, float innerWidth,
         spriteIndex = assetMgr.getFirstIconSpriteIndex() + m_riderIconIndex - 1;
         globalShapeIndex = m_riderIconIndex;
     } else {
-        // Default to circle-chevron-up
-        spriteIndex = assetMgr.getIconSpriteIndex("circle-chevron-up");
+        // Default to circle-chevron-up (static name: no string temporary per rebuild)
+        static const std::string DEFAULT_ICON = "circle-chevron-up";
+        spriteIndex = assetMgr.getIconSpriteIndex(DEFAULT_ICON);
         globalShapeIndex = spriteIndex - assetMgr.getFirstIconSpriteIndex() + 1;
     }
 
@@ -967,8 +979,8 @@ void GapBarHud::renderRiderMarkers(float innerX, float innerY, float innerWidth,
     }
 
     // === Render self marker (always on top) ===
-    if (m_currentTrackPos > 0.001f) {
-        float markerX = innerX + (innerWidth * m_currentTrackPos);
+    if (m_displayTrackPos > 0.001f) {
+        float markerX = innerX + (innerWidth * m_displayTrackPos);
 
         // Check if player is tracked - use their configured color and shape (like RadarHud).
         // Default to the accent slot so the player's own marker matches StandingsHud/MapHud.
@@ -137,7 +137,8 @@ public:
     // Track position update for lap timing (called from HudManager)
     void updateTrackPosition(int raceNum, float trackPos, int lapNum);
 
-    // Rider positions update for flat map mode (called from HudManager)
+    // Rider positions update for flat map mode and the self marker (called from
+    // HudManager every frame while riders move, dead-reckoned to the frame)
     void updateRiderPositions(int numVehicles, const Unified::TrackPositionData* positions);
 
     // Allow SettingsHud and SettingsManager to access private members
@@ -197,6 +198,7 @@ private:
     GapBarAnchor m_anchor;            // Anchor for current lap timing
     GapBarTrackMonitor m_trackMonitor;  // For S/F line detection
     float m_currentTrackPos;          // Current position on track (0.0-1.0)
+    float m_displayTrackPos;          // Self marker position: m_currentTrackPos dead-reckoned to the frame
     int m_currentLapNum;              // Current lap number
     bool m_observedLapStart;          // Did we see this lap start at S/F?
 
@@ -233,7 +233,7 @@ void IdealLapHud::rebuildRenderData() {
 
         // Show ideal time or placeholder
         if (idealTimeMs > 0) {
-            PluginUtils::formatLapTime(idealTimeMs, timeStr, sizeof(timeStr));
+            m_timeFormat.formatLapTime(idealTimeMs, timeStr, sizeof(timeStr));
             addString(timeStr, timeRightX, currentY, Justify::RIGHT, this->getFont(FontCategory::DIGITS), this->getColor(ColorSlot::PRIMARY), dim.fontSize);
         } else {
             strcpy_s(timeStr, sizeof(timeStr), Placeholders::LAP_TIME);
@@ -248,7 +248,7 @@ void IdealLapHud::rebuildRenderData() {
                 // New PB equals current best - compare to previous best to show improvement
                 diff = currentTimeMs - previousBestMs;
             }
-            PluginUtils::formatTimeDiff(diffStr, sizeof(diffStr), diff);
+            m_timeFormat.formatTimeDiff(diffStr, sizeof(diffStr), diff);
             unsigned long diffColor = (diff <= 0)
                 ? this->getColor(ColorSlot::POSITIVE)   // On pace or faster (green)
                 : this->getColor(ColorSlot::NEGATIVE);  // Slower (red)
@@ -309,7 +309,7 @@ void IdealLapHud::rebuildRenderData() {
 
         // Show actual lap time
         if (actualLapTime > 0) {
-            PluginUtils::formatLapTime(actualLapTime, timeStr, sizeof(timeStr));
+            m_timeFormat.formatLapTime(actualLapTime, timeStr, sizeof(timeStr));
             addString(timeStr, timeRightX, currentY, Justify::RIGHT, this->getFont(FontCategory::DIGITS), this->getColor(ColorSlot::PRIMARY), dim.fontSize);
         } else {
             strcpy_s(timeStr, sizeof(timeStr), Placeholders::LAP_TIME);
@@ -324,7 +324,7 @@ void IdealLapHud::rebuildRenderData() {
                 // Beat or matched ideal - compare to previous ideal to show improvement
                 diff = actualLapTime - prevIdealTime;
             }
-            PluginUtils::formatTimeDiff(diffStr, sizeof(diffStr), diff);
+            m_timeFormat.formatTimeDiff(diffStr, sizeof(diffStr), diff);
             unsigned long diffColor = (diff <= 0)
                 ? this->getColor(ColorSlot::POSITIVE)   // On pace or faster (green)
                 : this->getColor(ColorSlot::NEGATIVE);  // Slower (red)
@@ -353,7 +353,7 @@ void IdealLapHud::rebuildRenderData() {
         addLabel("Ideal", m_columns.label, currentY, Justify::LEFT, this->getFont(FontCategory::STRONG), this->getColor(ColorSlot::TERTIARY), dim);
 
         if (idealLapTime > 0) {
-            PluginUtils::formatLapTime(idealLapTime, timeStr, sizeof(timeStr));
+            m_timeFormat.formatLapTime(idealLapTime, timeStr, sizeof(timeStr));
             addString(timeStr, timeRightX, currentY, Justify::RIGHT, this->getFont(FontCategory::DIGITS), this->getColor(ColorSlot::POSITIVE), dim.fontSize);
         } else {
             strcpy_s(timeStr, sizeof(timeStr), Placeholders::LAP_TIME);
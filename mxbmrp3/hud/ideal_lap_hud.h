@@ -5,6 +5,7 @@
 #pragma once
 
 #include "base_hud.h"
+#include "../core/plugin_utils.h"
 #include "../core/plugin_constants.h"
 #include "../core/widget_constants.h"
 #include <chrono>
@@ -71,4 +72,7 @@ private:
 
     ColumnPositions m_columns;
     uint32_t m_enabledRows = ROW_DEFAULT;  // Bitfield of enabled rows
+
+    // Memoized lap-time/gap formatting for this HUD's cells (see PluginUtils::TimeFormatMemo)
+    PluginUtils::TimeFormatMemo m_timeFormat;
 };
@@ -330,11 +330,11 @@ void LapLogHud::rebuildRenderData() {
 
             // Format S1: official time if crossed, else live elapsed if in S1
             if (officialS1 > 0) {
-                PluginUtils::formatLapTime(officialS1, s1Str, sizeof(s1Str));
+                m_timeFormat.formatLapTime(officialS1, s1Str, sizeof(s1Str));
             } else if (activeSector == 0) {
                 int elapsed = data.getElapsedSectorTime(0);
                 if (elapsed > 0) {
-                    PluginUtils::formatLapTime(elapsed, s1Str, sizeof(s1Str));
+                    m_timeFormat.formatLapTime(elapsed, s1Str, sizeof(s1Str));
                 } else {
                     strcpy_s(s1Str, sizeof(s1Str), Placeholders::LAP_TIME);
                 }
@@ -344,11 +344,11 @@ void LapLogHud::rebuildRenderData() {
 
             // Format S2: official time if crossed, else live elapsed if in S2
             if (officialS2 > 0) {
-                PluginUtils::formatLapTime(officialS2, s2Str, sizeof(s2Str));
+                m_timeFormat.formatLapTime(officialS2, s2Str, sizeof(s2Str));
             } else if (activeSector == 1) {
                 int elapsed = data.getElapsedSectorTime(1);
                 if (elapsed > 0) {
-                    PluginUtils::formatLapTime(elapsed, s2Str, sizeof(s2Str));
+                    m_timeFormat.formatLapTime(elapsed, s2Str, sizeof(s2Str));
                 } else {
                     strcpy_s(s2Str, sizeof(s2Str), Placeholders::LAP_TIME);
                 }
@@ -360,7 +360,7 @@ void LapLogHud::rebuildRenderData() {
             if (activeSector == 2) {
                 int elapsed = data.getElapsedSectorTime(2);
                 if (elapsed > 0) {
-                    PluginUtils::formatLapTime(elapsed, s3Str, sizeof(s3Str));
+                    m_timeFormat.formatLapTime(elapsed, s3Str, sizeof(s3Str));
                 } else {
                     strcpy_s(s3Str, sizeof(s3Str), Placeholders::LAP_TIME);
                 }
@@ -373,7 +373,7 @@ void LapLogHud::rebuildRenderData() {
             if (activeSector == 3) {
                 int elapsed = data.getElapsedSectorTime(3);
                 if (elapsed > 0) {
-                    PluginUtils::formatLapTime(elapsed, s4Str, sizeof(s4Str));
+                    m_timeFormat.formatLapTime(elapsed, s4Str, sizeof(s4Str));
                 } else {
                     strcpy_s(s4Str, sizeof(s4Str), Placeholders::LAP_TIME);
                 }
@@ -385,7 +385,7 @@ void LapLogHud::rebuildRenderData() {
             // Format lap time: live elapsed time
             int elapsedLapTime = data.getElapsedLapTime();
             if (elapsedLapTime > 0) {
-                PluginUtils::formatLapTime(elapsedLapTime, timeStr, sizeof(timeStr));
+                m_timeFormat.formatLapTime(elapsedLapTime, timeStr, sizeof(timeStr));
             } else {
                 strcpy_s(timeStr, sizeof(timeStr), Placeholders::LAP_TIME);
             }
@@ -427,7 +427,7 @@ void LapLogHud::rebuildRenderData() {
 
             if (data.hasValidLiveGap()) {
                 int liveGap = data.getLiveGap();
-                PluginUtils::formatTimeDiff(gapStr, sizeof(gapStr), liveGap);
+                m_timeFormat.formatTimeDiff(gapStr, sizeof(gapStr), liveGap);
                 if (liveGap > 0) {
                     gapColor = this->getColor(ColorSlot::NEGATIVE);  // Behind PB (red)
                 } else if (liveGap < 0) {
@@ -485,26 +485,26 @@ void LapLogHud::rebuildRenderData() {
 
             // Format sector times using central formatting (M:SS.mmm)
             if (entry.sector1 > 0) {
-                PluginUtils::formatLapTime(entry.sector1, s1Str, sizeof(s1Str));
+                m_timeFormat.formatLapTime(entry.sector1, s1Str, sizeof(s1Str));
             } else {
                 strcpy_s(s1Str, sizeof(s1Str), Placeholders::GENERIC);
             }
 
             if (entry.sector2 > 0) {
-                PluginUtils::formatLapTime(entry.sector2, s2Str, sizeof(s2Str));
+                m_timeFormat.formatLapTime(entry.sector2, s2Str, sizeof(s2Str));
             } else {
                 strcpy_s(s2Str, sizeof(s2Str), Placeholders::GENERIC);
             }
 
             if (entry.sector3 > 0) {
-                PluginUtils::formatLapTime(entry.sector3, s3Str, sizeof(s3Str));
+                m_timeFormat.formatLapTime(entry.sector3, s3Str, sizeof(s3Str));
             } else {
                 strcpy_s(s3Str, sizeof(s3Str), Placeholders::GENERIC);
             }
 
 #if GAME_SECTOR_COUNT >= 4
             if (entry.sector4 > 0) {
-                PluginUtils::formatLapTime(entry.sector4, s4Str, sizeof(s4Str));
+                m_timeFormat.formatLapTime(entry.sector4, s4Str, sizeof(s4Str));
             } else {
                 strcpy_s(s4Str, sizeof(s4Str), Placeholders::GENERIC);
             }
@@ -512,7 +512,7 @@ void LapLogHud::rebuildRenderData() {
 
             // Format lap time
             if (entry.lapTime > 0 && entry.isComplete) {
-                PluginUtils::formatLapTime(entry.lapTime, timeStr, sizeof(timeStr));
+                m_timeFormat.formatLapTime(entry.lapTime, timeStr, sizeof(timeStr));
             } else {
                 strcpy_s(timeStr, sizeof(timeStr), Placeholders::LAP_TIME);
             }
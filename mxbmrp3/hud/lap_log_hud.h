@@ -5,6 +5,7 @@
 #pragma once
 
 #include "base_hud.h"
+#include "../core/plugin_utils.h"
 #include "../core/plugin_constants.h"
 #include "../core/widget_constants.h"
 #include <chrono>
@@ -95,4 +96,7 @@ private:
 
     // Get current sector index (0=S1 in progress, 1=S2, 2=S3, -1=no active lap)
     int getCurrentActiveSector() const;
+
+    // Memoized lap-time/gap formatting for this HUD's cells (see PluginUtils::TimeFormatMemo)
+    PluginUtils::TimeFormatMemo m_timeFormat;
 };
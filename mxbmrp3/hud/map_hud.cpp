@@ -12,6 +12,7 @@
 #include "../core/ui_config.h"
 #include "../core/asset_manager.h"
 #include "../core/tracked_riders_manager.h"
+#include "../core/hud_manager.h"
 #include "../diagnostics/logger.h"
 #include <cmath>
 #include <algorithm>
@@ -107,6 +108,7 @@ void MapHud::update() {
     if (!isVisibleAnySurface()) {
         clearDataDirty();
         clearLayoutDirty();
+        clearMotionDirty();
         return;
     }
 
@@ -297,7 +299,8 @@ void MapHud::updatePositionFromAnchor() {
     }
 }
 
-void MapHud::updateTrackData(int numSegments, const Unified::TrackSegment* segments, const float* raceData) {
+void MapHud::updateTrackData(int numSegments, const Unified::TrackSegment* segments, const float* raceData,
+                             const TrackRibbonPyramid::Levels* geometry) {
     if (numSegments <= 0 || segments == nullptr) {
         DEBUG_WARN("MapHud: Invalid track data");
         return;
@@ -316,6 +319,16 @@ void MapHud::updateTrackData(int numSegments, const Unified::TrackSegment* segme
     m_ribbonCacheValid = false;   // Cached ribbon quads belong to the old track
     m_worldRibbonValid = false;   // Cached world centerline belongs to the old track
 
+    // Bounds and arc table: take the pyramid's copy when it describes this track
+    // (it may come straight from the disk cache), else derive them here.
+    if (geometry && geometry->arc.size() == m_trackSegments.size() + 1) {
+        m_trackRawBounds = geometry->bounds;
+        m_trackArc = geometry->arc;
+    } else {
+        m_trackRawBounds = TrackRibbonPyramid::computeBounds(m_trackSegments);
+        TrackModel::buildArcTable(m_trackSegments, m_trackArc);
+    }
+
     // Calculate track bounds and scale
     calculateTrackBounds();
 
@@ -356,38 +369,7 @@ void MapHud::updateTrackData(int numSegments, const Unified::TrackSegment* segme
 }
 
 bool MapHud::centerlinePositionAt(float meters, float& outX, float& outY, float& outAngleDeg) const {
-    if (m_trackSegments.empty() || meters < 0.0f) {
-        return false;
-    }
-
-    float accumulated = 0.0f;
-    float currentX = m_trackSegments[0].startX;
-    float currentY = m_trackSegments[0].startY;
-    float currentAngle = m_trackSegments[0].angle;  // degrees, 0 = north
-
-    for (const auto& segment : m_trackSegments) {
-        float segLen = segment.length;
-        if (accumulated + segLen >= meters) {
-            // Target lies within this segment
-            float offset = meters - accumulated;
-
-            // Exact position/heading at the target offset (straight or arc).
-            outX = currentX;
-            outY = currentY;
-            outAngleDeg = currentAngle;
-            float radius = (segment.type == TrackSegmentType::STRAIGHT) ? 0.0f : segment.radius;
-            advanceAlongArc(outX, outY, outAngleDeg, radius, offset);
-            return true;
-        }
-
-        // Advance to end of this segment (exact, straight or arc)
-        float radius = (segment.type == TrackSegmentType::STRAIGHT) ? 0.0f : segment.radius;
-        advanceAlongArc(currentX, currentY, currentAngle, radius, segLen);
-        accumulated += segLen;
-    }
-
-    // meters past end of track
-    return false;
+    return TrackModel::positionAt(m_trackArc, m_trackSegments, meters, outX, outY, outAngleDeg);
 }
 
 void MapHud::updateRiderPositions(int numVehicles, const Unified::TrackPositionData* positions) {
@@ -400,82 +382,44 @@ void MapHud::updateRiderPositions(int numVehicles, const Unified::TrackPositionD
     // Use assign() for better performance - single allocation instead of multiple push_back calls
     m_riderPositions.assign(positions, positions + numVehicles);
 
-    // Mark data as dirty to trigger render update
-    setDataDirty();
+    // Only the riders moved: rebuildMotion() decides how much to redo
+    setMotionDirty();
 }
 
-void MapHud::calculateTrackBounds() {
-    if (m_trackSegments.empty()) {
+void MapHud::rebuildMotion() {
+    // Rotate-to-player and zoom re-derive the whole view from the player's pose
+    // (HudManager only pushes those new batches, see hasIncrementalMotion())
+    if (!m_riderLayer.valid || m_bRotateToPlayer || m_bZoomEnabled) {
+        rebuildRenderData();
         return;
     }
 
-    using namespace PluginConstants::Math;
-
-    // Initialize bounds with first segment start position
-    m_minX = m_maxX = m_trackSegments[0].startX;
-    m_minY = m_maxY = m_trackSegments[0].startY;
-
-    // Calculate bounds by traversing all segments
-    float currentX = m_trackSegments[0].startX;
-    float currentY = m_trackSegments[0].startY;
-    float currentAngle = m_trackSegments[0].angle;
-
-    for (const auto& segment : m_trackSegments) {
-        // Update bounds with current position
-        m_minX = std::min(m_minX, currentX);
-        m_maxX = std::max(m_maxX, currentX);
-        m_minY = std::min(m_minY, currentY);
-        m_maxY = std::max(m_maxY, currentY);
-
-        // Calculate end position based on segment type
-        if (segment.type == TrackSegmentType::STRAIGHT) {
-            // Straight segment
-            float angleRad = currentAngle * DEG_TO_RAD;
-            float dx = std::sin(angleRad) * segment.length;
-            float dy = std::cos(angleRad) * segment.length;
-            currentX += dx;
-            currentY += dy;
-        } else {
-            // Curved segment - simple stepping approach
-            float segRadius = segment.radius;
-            float arcLength = segment.length;
-            float absRadius = std::abs(segRadius);
-
-            // Safety: Skip curved segments with invalid radius to avoid division by zero
-            if (absRadius < 0.01f) {
-                DEBUG_WARN_F("MapHud: Curved segment with invalid radius %.3f, skipping", segRadius);
-                continue;
-            }
+#if defined(MXBMRP3_TEST_BUILD)
+    auto profRidersStart = ProfClock::now();
+#endif
 
-            // Sample points along the curve for accurate bounds, using the exact arc
-            // geometry (same as the ribbon/markers). Fixed 2m sampling step - bounds
-            // don't need to track LOD (computed once at track-load and must not
-            // depend on a setting that can change later).
-            constexpr float BOUNDS_SAMPLE_STEP_METERS = 2.0f;
-            int numSamples = std::max(3, static_cast<int>(arcLength / BOUNDS_SAMPLE_STEP_METERS));
-            float stepLength = arcLength / numSamples;
-
-            for (int i = 1; i <= numSamples; ++i) {
-                float tempX = currentX, tempY = currentY, tempAngle = currentAngle;
-                advanceAlongArc(tempX, tempY, tempAngle, segRadius, stepLength * i);
-
-                m_minX = std::min(m_minX, tempX);
-                m_maxX = std::max(m_maxX, tempX);
-                m_minY = std::min(m_minY, tempY);
-                m_maxY = std::max(m_maxY, tempY);
-            }
+    m_quads.resize(m_riderLayer.quadStart);
+    m_strings.truncate(m_riderLayer.stringStart);
+    m_riderClickRegions.clear();
+    renderRiders(m_riderLayer.rotation, m_riderLayer.clipLeft, m_riderLayer.clipTop,
+                 m_riderLayer.clipRight, m_riderLayer.clipBottom);
 
-            // Advance current position and angle to the end of the curve (exact).
-            advanceAlongArc(currentX, currentY, currentAngle, segRadius, arcLength);
-        }
+#if defined(MXBMRP3_TEST_BUILD)
+    g_mapRidersUs += usSince(profRidersStart);
+    ++g_mapProfCount;
+#endif
+}
 
-        // Update bounds with end position
-        m_minX = std::min(m_minX, currentX);
-        m_maxX = std::max(m_maxX, currentX);
-        m_minY = std::min(m_minY, currentY);
-        m_maxY = std::max(m_maxY, currentY);
+void MapHud::calculateTrackBounds() {
+    if (m_trackSegments.empty()) {
+        return;
     }
 
+    m_minX = m_trackRawBounds.minX;
+    m_maxX = m_trackRawBounds.maxX;
+    m_minY = m_trackRawBounds.minY;
+    m_maxY = m_trackRawBounds.maxY;
+
     // Add padding (5% of track size)
     float paddingX = (m_maxX - m_minX) * 0.05f;
     float paddingY = (m_maxY - m_minY) * 0.05f;
@@ -540,6 +484,7 @@ void MapHud::rebuildRenderData() {
     m_quads.clear();
     clearStrings();
     m_riderClickRegions.clear();
+    m_riderLayer.valid = false;
 
     // Don't render until we have track data
     // TrackCenterline callback fires during track load, before first render
@@ -717,6 +662,9 @@ void MapHud::rebuildRenderData() {
     // Build the ribbon-cache key from the values renderTrack actually sees
     // (captured here, AFTER the zoom overrides and offset adjustment above).
     // See TrackRibbonKey in the header for the caching rationale.
+    // Zoom draws from the shared LOD pyramid: hold this rebuild's snapshot.
+    m_trackGeometry = HudManager::getInstance().getTrackRibbons().current();
+    m_ribbonLevels = m_bZoomEnabled ? m_trackGeometry : nullptr;
     TrackRibbonKey ribbonKey;
     ribbonKey.angle = rotation.angle;
     ribbonKey.minX = m_minX;
@@ -742,6 +690,8 @@ void MapHud::rebuildRenderData() {
     ribbonKey.zoomEnabled = m_bZoomEnabled;
     ribbonKey.showOutline = m_bShowOutline;
     ribbonKey.showTitle = m_bShowTitle;
+    ribbonKey.ribbonLevelsGeneration = m_ribbonLevels ? m_ribbonLevels->generation : 0;
+    ribbonKey.ribbonLevelsComplete = m_ribbonLevels && m_ribbonLevels->complete;
     ribbonKey.outlineColor = outlineColor;
     ribbonKey.fillColor = fillColor;
 
@@ -800,7 +750,18 @@ void MapHud::rebuildRenderData() {
 
     // Render rider positions last, on top of the track and all markers; within
     // renderRiders the local player is drawn last of all so the player's own icon is
-    // the most visible element.
+    // the most visible element. The static layer ends here (see RiderLayer).
+    m_quads.reserve(m_quads.size() + Unified::MAX_RACE_ENTRIES);
+    m_strings.reserve(m_strings.size() + Unified::MAX_RACE_ENTRIES,
+                      m_strings.textBytes() + Unified::MAX_RACE_ENTRIES * RIDER_LABEL_BYTES);
+    m_riderLayer.quadStart = m_quads.size();
+    m_riderLayer.stringStart = m_strings.size();
+    m_riderLayer.rotation = rotation;
+    m_riderLayer.clipLeft = clipLeft;
+    m_riderLayer.clipTop = clipTop;
+    m_riderLayer.clipRight = clipRight;
+    m_riderLayer.clipBottom = clipBottom;
+    m_riderLayer.valid = !usingZoom && !m_bRotateToPlayer;
     renderRiders(rotation, clipLeft, clipTop, clipRight, clipBottom);
 
 #if defined(MXBMRP3_TEST_BUILD)
@@ -6,7 +6,9 @@
 
 #include "base_hud.h"
 #include "../game/unified_types.h"
+#include "../core/track_ribbon_pyramid.h"
 #include <array>
+#include <cstdint>
 #include <vector>
 
 class MapHud : public BaseHud {
@@ -32,10 +34,20 @@ public:
     // Update track centerline data
     // raceData: float array [S/F, split1, split2, holeshot] in meters along centerline,
     // or nullptr if unavailable.
-    void updateTrackData(int numSegments, const Unified::TrackSegment* segments, const float* raceData);
-
-    // Update rider positions (called frequently - must be fast)
+    // geometry: the track's published TrackRibbonPyramid set (bounds + arc table
+    // already derived, possibly read from the disk cache), or nullptr to derive
+    // them from the segments here.
+    void updateTrackData(int numSegments, const Unified::TrackSegment* segments, const float* raceData,
+                         const TrackRibbonPyramid::Levels* geometry = nullptr);
+
+    // Update rider positions (called every frame while riders move, with the
+    // positions dead-reckoned to the frame - must be fast). Marks motion dirty:
+    // see rebuildMotion().
     void updateRiderPositions(int numVehicles, const Unified::TrackPositionData* positions);
+    // Whether rebuildMotion() only rewrites the rider layer (fixed view, layer
+    // built). Otherwise a motion push is a full rebuild, and HudManager pushes
+    // only new batches, not every frame's prediction.
+    bool hasIncrementalMotion() const { return m_riderLayer.valid && !m_bRotateToPlayer && !m_bZoomEnabled; }
 
     // Rotation mode - rotate map so local player always points up
     void setRotateToPlayer(bool rotate) {
@@ -251,6 +263,9 @@ protected:
     void rebuildRenderData() override;
     // Note: rebuildLayout() uses base class default (full rebuild)
     // This is appropriate for HUDs with many dynamically-generated quads
+    // Position-only frames: rewrite just the rider layer when the view doesn't
+    // follow the player (see RiderLayer); otherwise a full rebuild.
+    void rebuildMotion() override;
 
 private:
     // Click region for rider selection (spectator switching)
@@ -261,6 +276,9 @@ private:
 
     // Track segment storage
     std::vector<Unified::TrackSegment> m_trackSegments;
+    // Track-load geometry derived from m_trackSegments (see updateTrackData)
+    TrackRibbonPyramid::Bounds m_trackRawBounds;           // unpadded centerline extents
+    std::vector<TrackModel::ArcPoint> m_trackArc;  // pose at every segment start
 
     // Race marker layout (fixed size for the supported games)
     static constexpr int RACE_MARKER_COUNT = 4;
@@ -286,6 +304,24 @@ private:
     // Click regions for rider selection (populated during renderRiders)
     std::vector<RiderClickRegion> m_riderClickRegions;
 
+    // The output is two layers. The static layer (background, track ribbon, S/F,
+    // split and segment markers) comes first; the rider layer (icons, labels)
+    // is the tail of m_quads and m_strings from these starts. With a fixed view
+    // (no rotate-to-player, no zoom) nothing in the static layer depends on rider
+    // positions, so rebuildMotion() rewrites only the tail, in place, with the
+    // same transform and clip. A full rebuild reserves room behind the static
+    // layer for MAX_RACE_ENTRIES riders, so that rewrite never reallocates.
+    struct RiderLayer {
+        bool valid = false;
+        size_t quadStart = 0;
+        size_t stringStart = 0;
+        RotationCache rotation;
+        float clipLeft = 0.0f, clipTop = 0.0f, clipRight = 0.0f, clipBottom = 0.0f;
+    };
+    RiderLayer m_riderLayer;
+    // Per rider: one icon quad, one label of at most this many bytes
+    static constexpr size_t RIDER_LABEL_BYTES = 20;
+
     // Map rendering configuration
     static constexpr float MAP_HEIGHT = 0.33f;  // Map height as fraction of screen (0.33 = 33%)
     static constexpr float MAP_PADDING = 0.01f;  // Padding from screen edge
@@ -372,6 +408,8 @@ private:
         bool zoomEnabled = false;
         bool showOutline = false;
         bool showTitle = false;
+        uint32_t ribbonLevelsGeneration = 0;   // pyramid snapshot (zoom mode)
+        bool ribbonLevelsComplete = false;
         unsigned long outlineColor = 0;
         unsigned long fillColor = 0;
 
@@ -393,6 +431,8 @@ private:
                 && zoomEnabled == o.zoomEnabled
                 && showOutline == o.showOutline
                 && showTitle == o.showTitle
+                && ribbonLevelsGeneration == o.ribbonLevelsGeneration
+                && ribbonLevelsComplete == o.ribbonLevelsComplete
                 && outlineColor == o.outlineColor
                 && fillColor == o.fillColor;
         }
@@ -404,7 +444,7 @@ private:
     // World-space ribbon centerline cache: one sample point per ribbon vertex along
     // the WHOLE track (center position + unit perpendicular), in world meters. This
     // is the output of the expensive part of renderTrack() — the per-sample arc
-    // walk (advanceAlongArc) and perpendicular trig — and it is INDEPENDENT of the
+    // walk (TrackModel::advanceAlongArc) and perpendicular trig — and it is INDEPENDENT of the
     // view transform (rotation angle, zoom pan, HUD offset, track colors), which are
     // applied per-frame in worldToScreen()/applyOffset(). It is also independent of
     // the track WIDTH scale (half-width is applied per-frame to the unit perp) and
@@ -419,7 +459,12 @@ private:
     // m_worldRibbonValid in updateTrackData(). NOTE (maintenance invariant): if you
     // make the emitted world points depend on a NEW input, add it to WorldRibbonKey
     // — miss it and the ribbon serves stale geometry in rotate/zoom.
-    struct WorldRibbonPoint { float cx, cy, upx, upy; };  // center + UNIT perpendicular
+    // Stored as a structure of arrays with per-chunk world bounds (the shared
+    // TrackRibbonPyramid::Ribbon), so renderTrack culls whole chunks (most of the
+    // track in zoom mode) and streams the survivors through a 4-wide kernel.
+    static constexpr size_t RIBBON_CHUNK = TrackRibbonPyramid::CHUNK;   // samples per cull chunk
+    using RibbonChunkBounds = TrackRibbonPyramid::ChunkBounds;
+    using WorldRibbon = TrackRibbonPyramid::Ribbon;
     // Key fields: detail scale/baseline are FOLDED into the resolved lodSpacing
     // (they act only through it), so they don't appear separately; adaptiveDetail
     // also drives curveMinSteps, so it must be keyed in its own right.
@@ -432,15 +477,40 @@ private:
                 && lodSpacing == o.lodSpacing;
         }
     };
-    std::vector<WorldRibbonPoint> m_worldRibbon;
+    WorldRibbon m_worldRibbon;
     WorldRibbonKey m_worldRibbonKey;
     bool m_worldRibbonValid = false;
+    // renderTrack scratch: the transform kernel writes every sample's screen-space
+    // left/right edge points and a visibility flag (inside the world cull bounds AND
+    // centerline inside the clip rect) here, then the emission pass turns runs of
+    // visible samples into quads. Member so its capacity survives across rebuilds.
+    struct RibbonEdges {
+        std::vector<float> lx, ly, rx, ry;
+        std::vector<uint8_t> visible;
+        std::vector<uint8_t> chunkLive;   // per WorldRibbon chunk: survived the chunk cull
+    };
+    RibbonEdges m_ribbonEdges;
     // (Re)build m_worldRibbon for the current track/LOD if its key changed. Called
     // from renderTrack (twice per rebuild, for the outline+fill passes — the second
     // call is a cheap key-check hit).
     void ensureWorldRibbon(float lodSpacing, int curveMinSteps);
 
-    // Calculate track bounds from segments
+    // Zoom mode resolves the LOD from the view range, so an animating zoom moved
+    // lodSpacing every frame and re-walked the track through ensureWorldRibbon.
+    // With zoom on, renderTrack instead takes the nearest level of the shared
+    // per-track pyramid (HudManager::getTrackRibbons(), built off-thread at track
+    // load; the coarsest level until the rest is done). m_ribbonLevels is the
+    // snapshot for the current rebuild, taken in rebuildRenderData; its
+    // generation/complete are part of TrackRibbonKey so the screen-quad cache
+    // re-emits when the finer levels arrive. Zoom off keeps the on-demand cache
+    // (its LOD only moves on layout/setting changes, and straights stay 1 quad).
+    std::shared_ptr<const TrackRibbonPyramid::Levels> m_ribbonLevels;
+    // The same snapshot regardless of zoom: its TrackModel (once complete)
+    // places the segment-timer markers.
+    std::shared_ptr<const TrackRibbonPyramid::Levels> m_trackGeometry;
+    const WorldRibbon& selectWorldRibbon(float lodSpacing, int curveMinSteps);
+
+    // Pad m_trackRawBounds and fit the map to them
     void calculateTrackBounds();
 
     // Calculate zoom bounds centered on player position
@@ -465,6 +535,11 @@ private:
     // Uses pre-calculated rotation cache to avoid redundant trig in loops
     void worldToScreen(float worldX, float worldY, float& screenX, float& screenY, const RotationCache& rotation) const;
 
+    // worldToScreen + title offset + HUD offset folded into one affine map
+    // (screen = [a b; d e] * world + [tx ty]), for batch transforms of many points.
+    struct ScreenTransform { float a, b, tx, d, e, ty; };
+    ScreenTransform createScreenTransform(const RotationCache& rotation, float titleOffset) const;
+
     // Render the track as quads (takes pre-calculated rotation cache, color, and width multiplier)
     void renderTrack(const RotationCache& rotation, unsigned long trackColor, float widthMultiplier,
                      float clipLeft, float clipTop, float clipRight, float clipBottom);
@@ -488,8 +563,8 @@ private:
                              const RotationCache& rotation,
                              float clipLeft, float clipTop, float clipRight, float clipBottom);
 
-    // Walk segments to compute world XY + tangent angle at the given distance along
-    // the centerline. Returns false if distance is out of range or track empty.
+    // World XY + tangent angle at the given distance along the centerline (arc
+    // table lookup). Returns false if distance is out of range or track empty.
     bool centerlinePositionAt(float meters, float& outX, float& outY, float& outAngleDeg) const;
 
     // Render rider positions as strings (takes pre-calculated rotation cache and clip bounds)
@@ -189,3 +189,39 @@ void MapHud::worldToScreen(float worldX, float worldY, float& screenX, float& sc
     screenX = normX * scaleX;
     screenY = (1.0f - normY) * scaleY;  // Flip Y axis since screen Y increases downward
 }
+
+// The same mapping as worldToScreen (plus title offset and applyOffset), with the
+// normalize -> rotate about center -> scale -> flip Y chain multiplied out into a
+// single affine transform. Identity rotation is cos 1 / sin 0, so one formula
+// covers both cases.
+MapHud::ScreenTransform MapHud::createScreenTransform(const RotationCache& rotation, float titleOffset) const {
+    constexpr float MIN_TRACK_EXTENT = 1e-3f;  // Same degenerate-track guard as worldToScreen
+    float trackWidth = std::max(m_maxX - m_minX, MIN_TRACK_EXTENT);
+    float trackHeight = std::max(m_maxY - m_minY, MIN_TRACK_EXTENT);
+    float maxDimension = std::max(trackWidth, trackHeight);
+    float invMax = 1.0f / maxDimension;
+
+    float centerX = (trackWidth / maxDimension) * 0.5f;
+    float centerY = (trackHeight / maxDimension) * 0.5f;
+    float c = rotation.hasRotation ? rotation.cosAngle : 1.0f;
+    float s = rotation.hasRotation ? rotation.sinAngle : 0.0f;
+
+    float scaleX = (m_fBaseMapWidth * m_fScale) / (trackWidth / maxDimension);
+    float scaleY = (m_fBaseMapHeight * m_fScale) / (trackHeight / maxDimension);
+
+    // Normalized, centered origin: world (0,0) -> (-minX/max - centerX, -minY/max - centerY)
+    float ox = -m_minX * invMax - centerX;
+    float oy = -m_minY * invMax - centerY;
+    float rotOx = ox * c - oy * s + centerX;
+    float rotOy = ox * s + oy * c + centerY;
+
+    ScreenTransform t;
+    t.a = scaleX * c * invMax;
+    t.b = -scaleX * s * invMax;
+    t.tx = scaleX * rotOx;
+    t.d = -scaleY * s * invMax;
+    t.e = -scaleY * c * invMax;
+    t.ty = scaleY * (1.0f - rotOy) + titleOffset;
+    applyOffset(t.tx, t.ty);
+    return t;
+}
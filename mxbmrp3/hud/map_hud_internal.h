@@ -26,27 +26,6 @@ inline constexpr float OUTLINE_WIDTH_MULTIPLIER = 1.4f;
 // Default icon filename
 inline constexpr const char* DEFAULT_RIDER_ICON = "circle-chevron-up";
 
-// Advance (x, y, headingDeg) by `dist` meters along a circular arc of signed
-// radius (the heading convention is move = sin/cos of heading, turn rate =
-// 1/radius). This is the *exact* arc position - independent of how finely the
-// curve is subdivided - so the rendered ribbon (renderTrack) and the marker
-// positions that index into it (centerlinePositionAt) agree exactly. Reduces to a
-// straight line as |radius| grows. Previously both used forward-Euler stepping
-// with different step counts, so markers drifted off the ribbon through curves.
-inline void advanceAlongArc(float& x, float& y, float& headingDeg, float radius, float dist) {
-    using namespace PluginConstants::Math;
-    float h0 = headingDeg * DEG_TO_RAD;
-    if (std::abs(radius) < 0.01f) {  // effectively straight
-        x += std::sin(h0) * dist;
-        y += std::cos(h0) * dist;
-        return;
-    }
-    float theta = dist / radius;  // signed turn (radians)
-    x += radius * (std::cos(h0) - std::cos(h0 + theta));
-    y += radius * (std::sin(h0 + theta) - std::sin(h0));
-    headingDeg += theta * RAD_TO_DEG;
-}
-
 // Helper to get shape index from filename (returns 1 if not found)
 inline int getShapeIndexByFilename(const char* filename) {
     const auto& assetMgr = AssetManager::getInstance();
@@ -19,11 +19,88 @@
 #include <algorithm>
 #include <unordered_map>
 
+// SSE2 is part of the x64 baseline (MSVC _M_X64, GCC/Clang __SSE2__); other
+// targets take the scalar loop in transformRibbon.
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define MXBMRP3_RIBBON_SSE2
+#endif
+
 using namespace PluginConstants;
 using namespace PluginConstants::Math;
 
 using namespace map_hud_detail;
 
+namespace {
+
+// Inputs of the ribbon transform kernel: the affine world->screen map
+// (MapHud::ScreenTransform), the pass half-width, and the cull/clip boxes.
+struct RibbonTransform {
+    float a, b, tx, d, e, ty;
+    float halfWidth;
+    float cullMinX, cullMaxX, cullMinY, cullMaxY;        // world
+    float clipLeft, clipRight, clipTop, clipBottom;      // screen
+};
+
+// For each world ribbon sample: screen center = T(c), screen half-edge =
+// L(up * halfWidth) with L the linear part of T, so left/right = center +/- edge.
+// visible = inside the world cull box AND screen center inside the clip rect.
+// Branch-free; four samples per step with SSE2, scalar tail.
+void transformRibbon(const RibbonTransform& p, size_t n,
+                     const float* cx, const float* cy, const float* upx, const float* upy,
+                     float* lx, float* ly, float* rx, float* ry, uint8_t* visible) {
+    size_t i = 0;
+#if defined(MXBMRP3_RIBBON_SSE2)
+    const __m128 a = _mm_set1_ps(p.a), b = _mm_set1_ps(p.b), tx = _mm_set1_ps(p.tx);
+    const __m128 d = _mm_set1_ps(p.d), e = _mm_set1_ps(p.e), ty = _mm_set1_ps(p.ty);
+    const __m128 hw = _mm_set1_ps(p.halfWidth);
+    const __m128 cullMinX = _mm_set1_ps(p.cullMinX), cullMaxX = _mm_set1_ps(p.cullMaxX);
+    const __m128 cullMinY = _mm_set1_ps(p.cullMinY), cullMaxY = _mm_set1_ps(p.cullMaxY);
+    const __m128 clipL = _mm_set1_ps(p.clipLeft), clipR = _mm_set1_ps(p.clipRight);
+    const __m128 clipT = _mm_set1_ps(p.clipTop), clipB = _mm_set1_ps(p.clipBottom);
+    for (; i + 4 <= n; i += 4) {
+        const __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i);
+        const __m128 ux = _mm_mul_ps(_mm_loadu_ps(upx + i), hw);
+        const __m128 uy = _mm_mul_ps(_mm_loadu_ps(upy + i), hw);
+        const __m128 sx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), tx);
+        const __m128 sy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d, x), _mm_mul_ps(e, y)), ty);
+        const __m128 ex = _mm_add_ps(_mm_mul_ps(a, ux), _mm_mul_ps(b, uy));
+        const __m128 ey = _mm_add_ps(_mm_mul_ps(d, ux), _mm_mul_ps(e, uy));
+        _mm_storeu_ps(lx + i, _mm_add_ps(sx, ex));
+        _mm_storeu_ps(ly + i, _mm_add_ps(sy, ey));
+        _mm_storeu_ps(rx + i, _mm_sub_ps(sx, ex));
+        _mm_storeu_ps(ry + i, _mm_sub_ps(sy, ey));
+
+        const __m128 inCull = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(x, cullMinX), _mm_cmple_ps(x, cullMaxX)),
+            _mm_and_ps(_mm_cmpge_ps(y, cullMinY), _mm_cmple_ps(y, cullMaxY)));
+        const __m128 inClip = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(sx, clipL), _mm_cmple_ps(sx, clipR)),
+            _mm_and_ps(_mm_cmpge_ps(sy, clipT), _mm_cmple_ps(sy, clipB)));
+        const int mask = _mm_movemask_ps(_mm_and_ps(inCull, inClip));
+        visible[i]     = static_cast<uint8_t>(mask & 1);
+        visible[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+        visible[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+        visible[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+    }
+#endif
+    for (; i < n; ++i) {
+        const float x = cx[i], y = cy[i];
+        const float ux = upx[i] * p.halfWidth, uy = upy[i] * p.halfWidth;
+        const float sx = p.a * x + p.b * y + p.tx;
+        const float sy = p.d * x + p.e * y + p.ty;
+        const float ex = p.a * ux + p.b * uy;
+        const float ey = p.d * ux + p.e * uy;
+        lx[i] = sx + ex; ly[i] = sy + ey;
+        rx[i] = sx - ex; ry[i] = sy - ey;
+        const bool inCull = x >= p.cullMinX && x <= p.cullMaxX && y >= p.cullMinY && y <= p.cullMaxY;
+        const bool inClip = sx >= p.clipLeft && sx <= p.clipRight && sy >= p.clipTop && sy <= p.clipBottom;
+        visible[i] = static_cast<uint8_t>(inCull && inClip);
+    }
+}
+
+}  // namespace
+
 void MapHud::renderTrack(const RotationCache& rotation, unsigned long trackColor, float widthMultiplier,
                          float clipLeft, float clipTop, float clipRight, float clipBottom) {
     if (m_trackSegments.empty()) {
@@ -86,93 +163,83 @@ void MapHud::renderTrack(const RotationCache& rotation, unsigned long trackColor
     // (they're sub-pixel anyway). Fixed mode keeps min=3 for consistency.
     const int curveMinSteps = m_bAdaptiveDetail ? 1 : 3;
 
-    // (Re)build the view-independent world-space centerline for this LOD. This is
-    // the expensive arc walk; it's cached across the per-frame rebuilds that
-    // rotate/zoom trigger (see WorldRibbonPoint in the header) so those modes only
-    // pay the cheap transform below, not a full re-tessellation.
-    ensureWorldRibbon(lodSpacing, curveMinSteps);
-
-    // Lambda to check if a point is within culling bounds
-    auto isPointInBounds = [&](float x, float y) -> bool {
-        return x >= cullMinX && x <= cullMaxX && y >= cullMinY && y <= cullMaxY;
-    };
-
-    // Lambda to check if a point is inside the clip region
-    auto isPointInClip = [&](float x, float y) -> bool {
-        return x >= clipLeft && x <= clipRight && y >= clipTop && y <= clipBottom;
-    };
-
-    // Lambda to check if quad centerline is inside clip region
-    // Using centerline (not vertices) ensures outline and track clip at same position
-    auto isQuadCenterlineInside = [&](float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3) -> bool {
-        // Centerline points: midpoint of each edge pair (left-right)
-        // Quad vertices: 0=prevLeft, 1=currLeft, 2=currRight, 3=prevRight
-        float prevCenterX = (x0 + x3) * 0.5f;
-        float prevCenterY = (y0 + y3) * 0.5f;
-        float currCenterX = (x1 + x2) * 0.5f;
-        float currCenterY = (y1 + y2) * 0.5f;
-        return isPointInClip(prevCenterX, prevCenterY) && isPointInClip(currCenterX, currCenterY);
-    };
+    // The view-independent world-space centerline for this LOD. The arc walk
+    // behind it is cached across the per-frame rebuilds rotate-to-player
+    // triggers, and precomputed per level for zoom (see selectWorldRibbon in the
+    // header), so those modes only pay the cheap transform below.
+    const WorldRibbon& ribbon = selectWorldRibbon(lodSpacing, curveMinSteps);
 
-    // Transform the cached world centerline into screen-space ribbon quads. The
-    // per-frame work is: world-space cull (cheap bounds test) -> apply the pass
-    // half-width to the cached unit perpendicular -> worldToScreen + HUD offset ->
-    // clip -> emit. The world cull + clip reproduce the previous behavior exactly:
-    // a point outside the (world) cull bounds breaks ribbon continuity (as the old
+    // Transform-and-clip pass: every cached sample to screen-space edge points plus
+    // a visibility flag, in one branch-free sweep over the SoA arrays (see
+    // transformRibbon). The world cull + clip reproduce the previous behavior: a
+    // point outside the (world) cull bounds breaks ribbon continuity (as the old
     // per-segment cull did), and a quad whose centerline falls outside the (screen)
     // clip rect is skipped while continuity is preserved (as createRibbonQuad did).
-    float prevLeftX = 0.0f, prevLeftY = 0.0f, prevRightX = 0.0f, prevRightY = 0.0f;
-    bool hasPrevPoint = false;
-    for (const auto& p : m_worldRibbon) {
-        // World-space cull: outside bounds breaks the ribbon (matches the old
-        // per-segment cull; anything culled here maps outside the clip rect anyway).
-        if (!isPointInBounds(p.cx, p.cy)) {
-            hasPrevPoint = false;
+    // Clipping on the sample's own screen center is the old edge-midpoint test
+    // ((left + right) / 2 == center).
+    const size_t count = ribbon.size();
+    RibbonEdges& edges = m_ribbonEdges;
+    edges.lx.resize(count); edges.ly.resize(count);
+    edges.rx.resize(count); edges.ry.resize(count);
+    edges.visible.resize(count);
+
+    const ScreenTransform xf = createScreenTransform(rotation, titleOffset);
+    RibbonTransform params;
+    params.a = xf.a; params.b = xf.b; params.tx = xf.tx;
+    params.d = xf.d; params.e = xf.e; params.ty = xf.ty;
+    params.halfWidth = halfWidth;
+    params.cullMinX = cullMinX; params.cullMaxX = cullMaxX;
+    params.cullMinY = cullMinY; params.cullMaxY = cullMaxY;
+    params.clipLeft = clipLeft; params.clipRight = clipRight;
+    params.clipTop = clipTop; params.clipBottom = clipBottom;
+    // Chunk pass: a chunk whose bounding box misses the cull box is all-invisible
+    // without being transformed; the rest go through the kernel.
+    const size_t chunkCount = ribbon.chunks.size();
+    edges.chunkLive.resize(chunkCount);
+    for (size_t k = 0; k < chunkCount; ++k) {
+        const size_t begin = k * RIBBON_CHUNK;
+        const size_t len = std::min(RIBBON_CHUNK, count - begin);
+        const RibbonChunkBounds& cb = ribbon.chunks[k];
+        const bool live = !(cb.maxX < cullMinX || cb.minX > cullMaxX || cb.maxY < cullMinY || cb.minY > cullMaxY);
+        edges.chunkLive[k] = live ? 1 : 0;
+        if (!live) {
+            std::fill_n(edges.visible.begin() + begin, len, uint8_t{0});
             continue;
         }
+        transformRibbon(params, len,
+                        ribbon.cx.data() + begin, ribbon.cy.data() + begin,
+                        ribbon.upx.data() + begin, ribbon.upy.data() + begin,
+                        edges.lx.data() + begin, edges.ly.data() + begin,
+                        edges.rx.data() + begin, edges.ry.data() + begin,
+                        edges.visible.data() + begin);
+    }
 
-        // Edge points = centerline +/- unit perpendicular * half-width (per pass).
-        float leftX = p.cx + p.upx * halfWidth;
-        float leftY = p.cy + p.upy * halfWidth;
-        float rightX = p.cx - p.upx * halfWidth;
-        float rightY = p.cy - p.upy * halfWidth;
-
-        float screenLeftX, screenLeftY, screenRightX, screenRightY;
-        worldToScreen(leftX, leftY, screenLeftX, screenLeftY, rotation);
-        worldToScreen(rightX, rightY, screenRightX, screenRightY, rotation);
-        screenLeftY += titleOffset;
-        screenRightY += titleOffset;
-        applyOffset(screenLeftX, screenLeftY);
-        applyOffset(screenRightX, screenRightY);
-
-        if (hasPrevPoint &&
-            isQuadCenterlineInside(prevLeftX, prevLeftY, screenLeftX, screenLeftY,
-                                   screenRightX, screenRightY, prevRightX, prevRightY)) {
-            // Quad connecting previous edges to current (counter-clockwise to match engine)
+    // Emission pass: a quad joins every pair of consecutive visible samples
+    // (counter-clockwise to match engine: prevLeft, currLeft, currRight, prevRight).
+    // A culled chunk has no visible sample, so no quad ends in it: skip it.
+    const uint8_t* visible = edges.visible.data();
+    for (size_t k = 0; k < chunkCount; ++k) {
+        const size_t begin = k * RIBBON_CHUNK;
+        const size_t end = std::min(begin + RIBBON_CHUNK, count);
+        if (!edges.chunkLive[k]) continue;
+        for (size_t i = (begin == 0) ? 1 : begin; i < end; ++i) {
+            if (!(visible[i - 1] & visible[i])) continue;
             SPluginQuad_t quad;
-            quad.m_aafPos[0][0] = prevLeftX;   quad.m_aafPos[0][1] = prevLeftY;
-            quad.m_aafPos[1][0] = screenLeftX; quad.m_aafPos[1][1] = screenLeftY;
-            quad.m_aafPos[2][0] = screenRightX; quad.m_aafPos[2][1] = screenRightY;
-            quad.m_aafPos[3][0] = prevRightX;  quad.m_aafPos[3][1] = prevRightY;
+            quad.m_aafPos[0][0] = edges.lx[i - 1]; quad.m_aafPos[0][1] = edges.ly[i - 1];
+            quad.m_aafPos[1][0] = edges.lx[i];     quad.m_aafPos[1][1] = edges.ly[i];
+            quad.m_aafPos[2][0] = edges.rx[i];     quad.m_aafPos[2][1] = edges.ry[i];
+            quad.m_aafPos[3][0] = edges.rx[i - 1]; quad.m_aafPos[3][1] = edges.ry[i - 1];
             quad.m_iSprite = PluginConstants::SpriteIndex::SOLID_COLOR;
             quad.m_ulColor = trackColor;
             m_quads.push_back(quad);
         }
-
-        // Continuity is preserved even when the quad was clipped (matches old behavior).
-        prevLeftX = screenLeftX; prevLeftY = screenLeftY;
-        prevRightX = screenRightX; prevRightY = screenRightY;
-        hasPrevPoint = true;
     }
 }
 
 // Build the view-independent world-space ribbon centerline (center + unit
-// perpendicular per sample) for the current track at the given LOD. This is the
-// arc-walk half of the old renderTrack loop, lifted out and cached: it emits the
-// SAME sequence of sample points the old loop generated (same subdivision, same
-// exact advanceAlongArc positions, same per-point heading), but unconditionally
-// (no view cull, no screen conversion) so the result depends only on the track
-// shape and LOD. renderTrack() then culls + transforms these per frame.
+// perpendicular per sample) for the current track at the given LOD, through the
+// shared sampler (TrackRibbonPyramid::buildRibbon). renderTrack() then culls +
+// transforms these per frame.
 void MapHud::ensureWorldRibbon(float lodSpacing, int curveMinSteps) {
     WorldRibbonKey key;
     key.adaptiveDetail = m_bAdaptiveDetail;   // scale/baseline are folded into lodSpacing
@@ -182,97 +249,23 @@ void MapHud::ensureWorldRibbon(float lodSpacing, int curveMinSteps) {
         return;  // Same track + LOD: reuse (the win in rotate/zoom)
     }
 
-    m_worldRibbon.clear();
-    if (m_trackSegments.empty()) {
-        m_worldRibbonKey = key;
-        m_worldRibbonValid = true;
-        return;
-    }
-    m_worldRibbon.reserve(m_trackSegments.size() * 4);
-
-    // Emit one centerline sample: store position + UNIT perpendicular (half-width is
-    // applied per-frame per pass in renderTrack, so it isn't baked in here).
-    // DEDUPE: the per-segment loops emit each segment joint twice (end of segment
-    // k == start of segment k+1) — a degenerate zero-area quad per boundary that
-    // the game still pays per-quad overhead for. Skip a sample identical to the
-    // previous one (the perpendicular is continuous across a joint, so keeping
-    // the first is exact).
-    auto emit = [&](float cx, float cy, float headingDeg) {
-        if (!m_worldRibbon.empty()) {
-            const auto& last = m_worldRibbon.back();
-            if (last.cx == cx && last.cy == cy) return;
-        }
-        float perpRad = (headingDeg + 90.0f) * DEG_TO_RAD;
-        m_worldRibbon.push_back({ cx, cy, std::sin(perpRad), std::cos(perpRad) });
-    };
-
-    float currentX = m_trackSegments[0].startX;
-    float currentY = m_trackSegments[0].startY;
-    float currentAngle = m_trackSegments[0].angle;
-
-    // SHORT-SEGMENT MERGE: a segment shorter than the sample spacing doesn't
-    // deserve samples of its own — it only advances the walk (exact geometry;
-    // the next emitted sample lands where it should). Without this, the ribbon
-    // floors at ~2 samples per segment, so on segment-DENSE tracks (real tracks
-    // carry 100-200+ segments, many of them tiny) the low end of the detail
-    // dial stopped doing anything: 20% through 160% all emitted the same count.
-    // `carry` accumulates the skipped length so a RUN of short segments still
-    // gets a sample roughly every lodSpacing meters, not zero forever.
-    float carry = 0.0f;
-    for (const auto& segment : m_trackSegments) {
-        float startX = currentX;
-        float startY = currentY;
-
-        if (segment.length + carry < lodSpacing) {
-            // Too short for its own samples: advance exactly, emit nothing.
-            float radius = (segment.type == TrackSegmentType::STRAIGHT) ? 0.0f : segment.radius;
-            advanceAlongArc(currentX, currentY, currentAngle, radius, segment.length);
-            carry += segment.length;
-            continue;
-        }
-        carry = 0.0f;
-
-        if (segment.type == TrackSegmentType::STRAIGHT) {
-            float angleRad = currentAngle * DEG_TO_RAD;
-            float dx = std::sin(angleRad) * segment.length;
-            float dy = std::cos(angleRad) * segment.length;
-
-            // 1 quad when not zoomed (optimal); subdivide with LOD when zoomed for
-            // clean clipping at close range. Perpendicular is constant on a straight.
-            int numSteps = 1;
-            if (m_bZoomEnabled) {
-                numSteps = std::max(1, static_cast<int>(segment.length / lodSpacing));
-            }
-            for (int i = 0; i <= numSteps; ++i) {
-                float t = static_cast<float>(i) / numSteps;
-                emit(startX + dx * t, startY + dy * t, currentAngle);
-            }
-            currentX += dx;
-            currentY += dy;
-        } else {
-            // Curve: subdivide, placing each point with exact arc geometry so the
-            // ribbon and the marker positions (centerlinePositionAt) agree.
-            float segRadius = segment.radius;  // signed (positive = right, negative = left)
-            float arcLength = segment.length;
-            int numSteps = std::max(curveMinSteps, static_cast<int>(arcLength / lodSpacing));
-            float stepLength = arcLength / numSteps;
-            for (int i = 0; i <= numSteps; ++i) {
-                float tempX = startX, tempY = startY, tempAngle = currentAngle;
-                advanceAlongArc(tempX, tempY, tempAngle, segRadius, stepLength * i);
-                emit(tempX, tempY, tempAngle);
-            }
-            advanceAlongArc(currentX, currentY, currentAngle, segRadius, arcLength);
-        }
-    }
-    // Close the walk: if the track ended inside a merged run, the endpoint was
-    // never emitted — the ribbon would stop short of the start/finish seam.
-    // (emit() dedupes, so this is a no-op when the last segment emitted it.)
-    emit(currentX, currentY, currentAngle);
-
+    TrackRibbonPyramid::buildRibbon(m_trackSegments, lodSpacing, curveMinSteps, m_bZoomEnabled,
+                                    m_worldRibbon);
     m_worldRibbonKey = key;
     m_worldRibbonValid = true;
 }
 
+// Zoom mode: nearest pyramid level (no walk on the view path). Without a
+// snapshot (no TrackCenterline through HudManager yet) fall back to the
+// on-demand cache, which is always correct for m_trackSegments.
+const MapHud::WorldRibbon& MapHud::selectWorldRibbon(float lodSpacing, int curveMinSteps) {
+    if (m_bZoomEnabled && m_ribbonLevels) {
+        return m_ribbonLevels->select(lodSpacing, curveMinSteps);
+    }
+    ensureWorldRibbon(lodSpacing, curveMinSteps);
+    return m_worldRibbon;
+}
+
 void MapHud::renderStartMarker(const RotationCache& rotation,
                                float clipLeft, float clipTop, float clipRight, float clipBottom) {
     if (m_trackSegments.empty()) {
@@ -468,21 +461,32 @@ void MapHud::renderSegmentMarkers(const RotationCache& rotation,
 
     // Custom segment-timer boundary points (training tool). Unlike the fixed race
     // markers, these are placed live via hotkey, so resolve them at render time.
-    // Each point's trackPos (0-1) is S/F-relative (0 at start/finish), but
-    // centerlinePositionAt measures meters from the centerline's data start. Map
-    // back by adding the S/F offset (raceData[0]) and wrapping: meters =
-    // (pos*totalLength + sfMeters) mod totalLength.
+    // Each point's trackPos (0-1) is S/F-relative (0 at start/finish); the
+    // track's TrackModel maps it straight to a pose. Until the model is built
+    // (the first frames after a track load), map back to centerline meters by
+    // hand: meters = (pos*totalLength + sfMeters) mod totalLength.
     const PluginData::SegmentTimerData& seg = PluginData::getInstance().getSegmentTimer();
     if (seg.points.empty()) {
         return;
     }
 
-    float totalLength = 0.0f;
-    for (const auto& s : m_trackSegments) totalLength += s.length;
+    unsigned long segColor = this->getColor(ColorSlot::ACCENT);  // accent = the player's own segments
+    const TrackModel* model = (m_trackGeometry && m_trackGeometry->model.valid()) ? &m_trackGeometry->model : nullptr;
+    if (model) {
+        for (float pos : seg.points) {
+            RaceMarker m;
+            model->poseAt(pos, m.worldX, m.worldY, m.angleDeg);
+            m.valid = true;
+            drawDirectionMarker(m, segColor, rotation, clipLeft, clipTop, clipRight, clipBottom);
+        }
+        return;
+    }
+
+    // Same running sum as the segment walk, precomputed in the arc table
+    const float totalLength = m_trackArc.empty() ? 0.0f : m_trackArc.back().distance;
     if (totalLength <= 0.0f) return;
 
     float sfOffset = (m_sfMeters > 0.0f) ? m_sfMeters : 0.0f;
-    unsigned long segColor = this->getColor(ColorSlot::ACCENT);  // accent = the player's own segments
     for (float pos : seg.points) {
         float meters = std::fmod(pos * totalLength + sfOffset, totalLength);
         if (meters < 0.0f) meters += totalLength;
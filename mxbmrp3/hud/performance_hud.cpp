@@ -238,7 +238,6 @@ void PerformanceHud::rebuildRenderData() {
     // Position legend: if showing graphs, place after graph + gap; otherwise start at left edge
     float legendStartX = showGraphs ? (contentStartX + graphWidth + gapWidth) : contentStartX;
 
-    float pointSpacing = graphWidth / (GRAPH_HISTORY_SIZE - 1);
     float lineThickness = stripChartLineThickness();  // Line thickness for graph rendering
 
     // FPS Section: subheading, then graph on left + legend on right
@@ -260,36 +259,8 @@ void PerformanceHud::rebuildRenderData() {
                                fpsTopBuf, fpsMidBuf, "0 FPS", dims);
 
             // Render FPS graph (continuous line segments)
-            for (int i = 0; i < GRAPH_HISTORY_SIZE - 1; ++i) {
-                int histIdx1 = (m_historyIndex + i) % GRAPH_HISTORY_SIZE;
-                int histIdx2 = (m_historyIndex + i + 1) % GRAPH_HISTORY_SIZE;
-                float fps1 = m_fpsHistory[histIdx1];
-                float fps2 = m_fpsHistory[histIdx2];
-
-                if (fps1 > 0 && fps2 > 0) {
-                    float normalizedValue1 = fps1 / MAX_FPS_DISPLAY;
-                    float normalizedValue2 = fps2 / MAX_FPS_DISPLAY;
-                    if (normalizedValue1 > 1.0f) normalizedValue1 = 1.0f;
-                    if (normalizedValue2 > 1.0f) normalizedValue2 = 1.0f;
-
-                    float x1 = contentStartX + i * pointSpacing;
-                    float y1 = currentY + graphHeight - (normalizedValue1 * graphHeight);
-                    float x2 = contentStartX + (i + 1) * pointSpacing;
-                    float y2 = currentY + graphHeight - (normalizedValue2 * graphHeight);
-
-                    // Use color from the first point for consistency
-                    unsigned long color;
-                    if (fps1 >= 60.0f) {
-                        color = this->getColor(ColorSlot::POSITIVE);  // Green: good performance
-                    } else if (fps1 >= 30.0f) {
-                        color = this->getColor(ColorSlot::WARNING);   // Yellow: caution
-                    } else {
-                        color = this->getColor(ColorSlot::NEGATIVE);  // Red: bad performance
-                    }
-
-                    addLineSegment(x1, y1, x2, y2, color, lineThickness);
-                }
-            }
+            addHistoryGraph(m_fpsHistory, MAX_FPS_DISPLAY, &PerformanceHud::fpsColor,
+                            contentStartX, currentY, graphWidth, graphHeight, lineThickness);
         }
 
         // FPS Legend (vertical format on right side)
@@ -367,37 +338,8 @@ void PerformanceHud::rebuildRenderData() {
                                msTopBuf, msMidBuf, "0.0 ms", dims);
 
             // Render Plugin Time graph (continuous line segments, 0-4ms range)
-            for (int i = 0; i < GRAPH_HISTORY_SIZE - 1; ++i) {
-                int histIdx1 = (m_historyIndex + i) % GRAPH_HISTORY_SIZE;
-                int histIdx2 = (m_historyIndex + i + 1) % GRAPH_HISTORY_SIZE;
-                float pluginTimeMs1 = m_pluginTimeHistory[histIdx1];
-                float pluginTimeMs2 = m_pluginTimeHistory[histIdx2];
-
-                if (pluginTimeMs1 > 0 && pluginTimeMs2 > 0) {
-                    // Normalize to 0-4ms range
-                    float normalizedValue1 = pluginTimeMs1 / MAX_PLUGIN_TIME_MS;
-                    float normalizedValue2 = pluginTimeMs2 / MAX_PLUGIN_TIME_MS;
-                    if (normalizedValue1 > 1.0f) normalizedValue1 = 1.0f;
-                    if (normalizedValue2 > 1.0f) normalizedValue2 = 1.0f;
-
-                    float x1 = contentStartX + i * pointSpacing;
-                    float y1 = currentY + graphHeight - (normalizedValue1 * graphHeight);
-                    float x2 = contentStartX + (i + 1) * pointSpacing;
-                    float y2 = currentY + graphHeight - (normalizedValue2 * graphHeight);
-
-                    // Use color from the first point for consistency
-                    unsigned long color;
-                    if (pluginTimeMs1 < 2.0f) {
-                        color = this->getColor(ColorSlot::POSITIVE);  // Green: <2ms (safe)
-                    } else if (pluginTimeMs1 < 3.0f) {
-                        color = this->getColor(ColorSlot::WARNING);   // Yellow: 2-3ms (caution)
-                    } else {
-                        color = this->getColor(ColorSlot::NEGATIVE);  // Red: >3ms (heavy)
-                    }
-
-                    addLineSegment(x1, y1, x2, y2, color, lineThickness);
-                }
-            }
+            addHistoryGraph(m_pluginTimeHistory, MAX_PLUGIN_TIME_MS, &PerformanceHud::pluginTimeColor,
+                            contentStartX, currentY, graphWidth, graphHeight, lineThickness);
         }
 
         // CPU Legend (vertical format on right side)
@@ -498,6 +440,60 @@ void PerformanceHud::recalculatePluginTimeMinMax() {
     }
 }
 
+unsigned long PerformanceHud::fpsColor(float fps) const {
+    if (fps >= 60.0f) return this->getColor(ColorSlot::POSITIVE);  // Green: good performance
+    if (fps >= 30.0f) return this->getColor(ColorSlot::WARNING);   // Yellow: caution
+    return this->getColor(ColorSlot::NEGATIVE);                    // Red: bad performance
+}
+
+unsigned long PerformanceHud::pluginTimeColor(float pluginTimeMs) const {
+    if (pluginTimeMs < 2.0f) return this->getColor(ColorSlot::POSITIVE);  // Green: <2ms (safe)
+    if (pluginTimeMs < 3.0f) return this->getColor(ColorSlot::WARNING);   // Yellow: 2-3ms (caution)
+    return this->getColor(ColorSlot::NEGATIVE);                           // Red: >3ms (heavy)
+}
+
+void PerformanceHud::addHistoryGraph(const std::array<float, GRAPH_HISTORY_SIZE>& history, float maxValue,
+                                     unsigned long (PerformanceHud::*colorOf)(float) const,
+                                     float x, float y, float width, float height, float lineThickness) {
+    float pointSpacing = width / (GRAPH_HISTORY_SIZE - 1);
+    unsigned long runColor = 0;
+    m_polylineX.clear();
+    m_polylineY.clear();
+    auto flush = [&]() {
+        if (m_polylineX.size() >= 2) {
+            addPolyline(m_polylineX.data(), m_polylineY.data(), m_polylineX.size(), runColor, lineThickness);
+        }
+        m_polylineX.clear();
+        m_polylineY.clear();
+    };
+    auto pointY = [&](float value) {
+        // Normalize to the graph ceiling
+        float normalizedValue = value / maxValue;
+        if (normalizedValue > 1.0f) normalizedValue = 1.0f;
+        return y + height - (normalizedValue * height);
+    };
+
+    for (int i = 0; i < GRAPH_HISTORY_SIZE - 1; ++i) {
+        float value1 = history[(m_historyIndex + i) % GRAPH_HISTORY_SIZE];
+        float value2 = history[(m_historyIndex + i + 1) % GRAPH_HISTORY_SIZE];
+        if (value1 <= 0 || value2 <= 0) {
+            flush();
+            continue;
+        }
+        // Use color from the first point for consistency
+        unsigned long color = (this->*colorOf)(value1);
+        if (!m_polylineX.empty() && color != runColor) flush();
+        if (m_polylineX.empty()) {
+            runColor = color;
+            m_polylineX.push_back(x + i * pointSpacing);
+            m_polylineY.push_back(pointY(value1));
+        }
+        m_polylineX.push_back(x + (i + 1) * pointSpacing);
+        m_polylineY.push_back(pointY(value2));
+    }
+    flush();
+}
+
 void PerformanceHud::resetToDefaults() {
     m_bVisible = false;  // Hidden by default
     m_bShowTitle = true;
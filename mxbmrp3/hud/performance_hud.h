@@ -102,6 +102,16 @@ private:
     void recalculateFpsMinMax();
     void recalculatePluginTimeMinMax();
 
+    // Graph colour bands (green / yellow / red) for a sample
+    unsigned long fpsColor(float fps) const;
+    unsigned long pluginTimeColor(float pluginTimeMs) const;
+    // One history graph, oldest sample at the left edge. Segments are coloured by
+    // their first sample; each run of one colour between missing samples (<= 0)
+    // is a single addPolyline() call.
+    void addHistoryGraph(const std::array<float, GRAPH_HISTORY_SIZE>& history, float maxValue,
+                         unsigned long (PerformanceHud::*colorOf)(float) const,
+                         float x, float y, float width, float height, float lineThickness);
+
     uint32_t m_enabledElements = ELEM_DEFAULT;  // Bitfield of enabled metrics
     uint8_t m_displayMode = DISPLAY_DEFAULT;    // Display mode (graphs/values/both)
 };
@@ -421,7 +421,7 @@ void PitboardHud::rebuildRenderData() {
         }
         if (timeToShow > 0) {
             char timeStr[16];
-            PluginUtils::formatLapTimeTenths(timeToShow, timeStr, sizeof(timeStr));
+            m_timeFormat.formatLapTimeTenths(timeToShow, timeStr, sizeof(timeStr));
             float lastLapPosX = centerX + (backgroundWidth * layout.lastLapX);
             float lastLapPosY = currentY + (backgroundHeight * layout.lastLapY);
             addString(timeStr, lastLapPosX, lastLapPosY, Justify::CENTER,
@@ -454,7 +454,7 @@ void PitboardHud::rebuildRenderData() {
             if (effectiveMode == GAP_LEADER && gapMs <= 0) {
                 snprintf(gapStr, sizeof(gapStr), "Leader");
             } else {
-                PluginUtils::formatGapCompact(gapStr, sizeof(gapStr), gapMs);
+                m_timeFormat.formatGapCompact(gapStr, sizeof(gapStr), gapMs);
             }
 
             float gapPosX = centerX + (backgroundWidth * layout.gapX);
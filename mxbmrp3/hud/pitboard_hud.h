@@ -6,6 +6,7 @@
 #pragma once
 
 #include "base_hud.h"
+#include "../core/plugin_utils.h"
 #include "../core/plugin_constants.h"
 #include "../core/widget_constants.h"
 #include <chrono>
@@ -156,4 +157,7 @@ private:
 
     // Initialize default layouts for known variants
     void initDefaultLayouts();
+
+    // Memoized lap-time/gap formatting for this HUD's cells (see PluginUtils::TimeFormatMemo)
+    PluginUtils::TimeFormatMemo m_timeFormat;
 };
@@ -0,0 +1,148 @@
+// ============================================================================
+// hud/polyline_builder.h
+// The line-quad geometry behind BaseHud::addLineSegment() and addPolyline().
+//
+// A line segment is one SOLID_COLOR quad: the two endpoints pushed out by half
+// the thickness along the segment's unit normal, the horizontal component
+// divided by the UI aspect ratio so the stroke is as thick across as it is
+// down. appendPolyline() batches a whole trace: it walks the points once and
+// emits one quad per straight run instead of one per segment. A run starts at
+// a vertex and
+//   - skips vertices within MIN_SEGMENT_PX of that start (sub-pixel wiggle),
+//   - extends while the next vertex stays within COLLINEAR_PX of the run's line
+//     and moves forward along it (a reversal always breaks the run),
+// both measured in display pixels. A segment that stays on its own is emitted
+// by the same code as appendSegment(), so it is bit-identical to
+// addLineSegment()'s quad.
+//
+// Header-only and Win32-free (SPluginQuad_t comes from the game config, as in
+// core/hud_sw_renderer.h), so tests/unit/test_hud_sw_renderer.cpp can check
+// the merge rules and rasterize the result against the per-segment quads.
+// ============================================================================
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../game/game_config.h"   // SPluginQuad_t (per game)
+
+namespace PolylineBuilder {
+
+constexpr float COLLINEAR_PX = 0.25f;     // max distance of a merged vertex from its run's line
+constexpr float MIN_SEGMENT_PX = 0.5f;    // vertices closer than this to a run's start are dropped
+
+// How a line is stroked. thickness and the points are normalized UI units;
+// pxX/pxY are display pixels per unit on each axis (only the merge tolerances
+// use them).
+struct Stroke {
+    unsigned long color;
+    float thickness;
+    float aspect;      // UI width / height (PluginConstants::UI_ASPECT_RATIO)
+    float pxX, pxY;
+};
+
+// appendPolyline()'s per-segment unit normals and lengths, kept by the caller
+// to reuse capacity.
+struct Scratch {
+    std::vector<float> nx, ny, len;
+};
+
+// One quad from (x1, y1) to (x2, y2) along unit normal (px, py).
+inline void appendQuad(std::vector<SPluginQuad_t>& out, float x1, float y1, float x2, float y2,
+                       float px, float py, const Stroke& s) {
+    // Half thickness offset (apply aspect ratio correction to horizontal component)
+    const float hx = (px * s.thickness * 0.5f) / s.aspect;
+    const float hy = py * s.thickness * 0.5f;
+
+    // p1+perp, p1-perp, p2-perp, p2+perp (the stick trail's corner order)
+    SPluginQuad_t quad;
+    quad.m_aafPos[0][0] = x1 + hx;
+    quad.m_aafPos[0][1] = y1 + hy;
+    quad.m_aafPos[1][0] = x1 - hx;
+    quad.m_aafPos[1][1] = y1 - hy;
+    quad.m_aafPos[2][0] = x2 - hx;
+    quad.m_aafPos[2][1] = y2 - hy;
+    quad.m_aafPos[3][0] = x2 + hx;
+    quad.m_aafPos[3][1] = y2 + hy;
+    quad.m_iSprite = 0;                    // SpriteIndex::SOLID_COLOR
+    quad.m_ulColor = s.color | 0xFF000000;  // Ensure full alpha
+    out.push_back(quad);
+}
+
+// addLineSegment(): one quad, nothing for a zero-length segment.
+inline void appendSegment(std::vector<SPluginQuad_t>& out, float x1, float y1, float x2, float y2,
+                          const Stroke& s) {
+    const float dx = x2 - x1;
+    const float dy = y2 - y1;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    if (len < 0.0001f) return;  // Skip zero-length segments
+    appendQuad(out, x1, y1, x2, y2, dy / len, -dx / len, s);
+}
+
+// addPolyline(): the points (xs[i], ys[i]) for i < count, merged into runs.
+inline void appendPolyline(std::vector<SPluginQuad_t>& out, const float* xs, const float* ys,
+                           size_t count, const Stroke& s, Scratch& scratch) {
+    if (count < 2) return;
+    const size_t segments = count - 1;
+    scratch.nx.resize(segments);
+    scratch.ny.resize(segments);
+    scratch.len.resize(segments);
+
+    // Pass 1 (branch-free, vectorizable): every segment's length and unit
+    // normal, the same arithmetic as appendSegment().
+    for (size_t i = 0; i < segments; ++i) {
+        const float dx = xs[i + 1] - xs[i];
+        const float dy = ys[i + 1] - ys[i];
+        const float len = std::sqrt(dx * dx + dy * dy);
+        const float safeLen = std::max(len, 1e-12f);   // zero-length segments are skipped below
+        scratch.len[i] = len;
+        scratch.nx[i] = dy / safeLen;
+        scratch.ny[i] = -dx / safeLen;
+    }
+
+    // Grow geometrically: graph HUDs call this once per run, and an exact
+    // reserve() per call would reallocate every time.
+    const size_t needed = out.size() + segments;
+    if (needed > out.capacity()) {
+        out.reserve(std::max(needed, out.capacity() * 2));
+    }
+
+    // Pass 2: runs, in display pixels.
+    const float minSegmentSq = MIN_SEGMENT_PX * MIN_SEGMENT_PX;
+    size_t a = 0;
+    while (a < segments) {
+        // Drop vertices within a sub-pixel of the run's start (never the last one).
+        size_t b = a + 1;
+        float ux = (xs[b] - xs[a]) * s.pxX, uy = (ys[b] - ys[a]) * s.pxY;
+        while (b < segments && ux * ux + uy * uy < minSegmentSq) {
+            ++b;
+            ux = (xs[b] - xs[a]) * s.pxX;
+            uy = (ys[b] - ys[a]) * s.pxY;
+        }
+        const float runLen = std::sqrt(ux * ux + uy * uy);
+        if (runLen > 0.0f) {
+            ux /= runLen;
+            uy /= runLen;
+            // Extend while the next vertex stays on the run's line and moves forward.
+            while (b < segments) {
+                const float ex = (xs[b + 1] - xs[a]) * s.pxX, ey = (ys[b + 1] - ys[a]) * s.pxY;
+                const float sx = (xs[b + 1] - xs[b]) * s.pxX, sy = (ys[b + 1] - ys[b]) * s.pxY;
+                if (std::fabs(ux * ey - uy * ex) > COLLINEAR_PX || ux * sx + uy * sy < 0.0f) break;
+                ++b;
+            }
+        }
+
+        if (b == a + 1) {
+            if (scratch.len[a] >= 0.0001f) {  // Skip zero-length segments
+                appendQuad(out, xs[a], ys[a], xs[b], ys[b], scratch.nx[a], scratch.ny[a], s);
+            }
+        } else {
+            appendSegment(out, xs[a], ys[a], xs[b], ys[b], s);
+        }
+        a = b;
+    }
+}
+
+}  // namespace PolylineBuilder
@@ -10,6 +10,7 @@
 #include "../core/ui_config.h"
 #include "../core/asset_manager.h"
 #include "../core/tracked_riders_manager.h"
+#include "../core/hud_manager.h"
 #include "../diagnostics/logger.h"
 #include <cmath>
 #include <algorithm>
@@ -17,6 +18,24 @@
 using namespace PluginConstants;
 using namespace PluginConstants::Math;
 
+#if defined(MXBMRP3_TEST_BUILD)
+#include <chrono>
+// Static vs rider layer timing for the headless perf drivers (test builds only).
+namespace {
+    using ProfClock = std::chrono::steady_clock;
+    double g_radarStaticUs = 0.0, g_radarRidersUs = 0.0;
+    long long g_radarProfCount = 0;
+    inline double usSince(ProfClock::time_point a) {
+        return std::chrono::duration<double, std::micro>(ProfClock::now() - a).count();
+    }
+}
+void radarHudReadProfile(double& staticUs, double& ridersUs, long long& count) {
+    staticUs = g_radarStaticUs; ridersUs = g_radarRidersUs; count = g_radarProfCount;
+    g_radarStaticUs = g_radarRidersUs = 0.0;
+    g_radarProfCount = 0;
+}
+#endif
+
 // Default icon filenames
 static constexpr const char* DEFAULT_RIDER_ICON = "circle";
 static constexpr const char* DEFAULT_PROXIMITY_ARROW_ICON = "angle-up";
@@ -70,6 +89,7 @@ void RadarHud::update() {
     if (!isVisibleAnySurface()) {
         clearDataDirty();
         clearLayoutDirty();
+        clearMotionDirty();
         return;
     }
 
@@ -162,8 +182,8 @@ void RadarHud::updateRiderPositions(int numVehicles, const Unified::TrackPositio
     // Copy rider positions (fast operation - runs at high frequency)
     m_riderPositions.assign(positions, positions + numVehicles);
 
-    // Mark data as dirty to trigger render update
-    setDataDirty();
+    // Only the riders moved: rebuildMotion() rewrites just the rider layer
+    setMotionDirty();
 }
 
 void RadarHud::renderRiderSprite(float radarX, float radarY, float yaw, unsigned long color,
@@ -352,6 +372,10 @@ ProximityGradient RadarHud::buildProximityGradient() const {
 }
 
 void RadarHud::rebuildRenderData() {
+#if defined(MXBMRP3_TEST_BUILD)
+    auto profStaticStart = ProfClock::now();
+#endif
+
     m_quads.clear();
     clearStrings();
 
@@ -374,6 +398,92 @@ void RadarHud::rebuildRenderData() {
     // Set bounds for dragging
     setBounds(x, y, x + width, y + height);
 
+    RiderLayer& layer = m_riderLayer;
+    layer.x = x;
+    layer.y = y;
+    layer.width = width;
+    layer.height = height;
+    layer.centerX = x + width * 0.5f;
+    layer.centerY = y + titleHeight + dim.paddingV + radarRadius;
+    layer.radarRadius = radarRadius;
+
+    // Build proximity gradient once (shared by sector overlay and proximity arrows)
+    layer.gradient = buildProximityGradient();
+
+    // Auto-hide fades the frame with the riders: it's drawn in the rider layer
+    if (m_radarMode == RadarMode::ON) {
+        renderFrame(1.0f);
+    }
+
+    // The static layer ends here; the rider layer is rewritten behind it
+    m_quads.reserve(m_quads.size() + RIDER_LAYER_QUADS);
+    m_strings.reserve(m_strings.size() + RIDER_LAYER_STRINGS,
+                      m_strings.textBytes() + RIDER_LAYER_STRINGS * RIDER_LABEL_BYTES);
+    layer.quadStart = m_quads.size();
+    layer.stringStart = m_strings.size();
+    layer.valid = true;
+
+#if defined(MXBMRP3_TEST_BUILD)
+    g_radarStaticUs += usSince(profStaticStart);
+    auto profRidersStart = ProfClock::now();
+#endif
+
+    renderRiderLayer();
+
+#if defined(MXBMRP3_TEST_BUILD)
+    g_radarRidersUs += usSince(profRidersStart);
+    ++g_radarProfCount;
+#endif
+}
+
+void RadarHud::rebuildMotion() {
+    if (!m_riderLayer.valid) {
+        rebuildRenderData();
+        return;
+    }
+
+#if defined(MXBMRP3_TEST_BUILD)
+    auto profRidersStart = ProfClock::now();
+#endif
+
+    m_quads.resize(m_riderLayer.quadStart);
+    m_strings.truncate(m_riderLayer.stringStart);
+    renderRiderLayer();
+
+#if defined(MXBMRP3_TEST_BUILD)
+    g_radarRidersUs += usSince(profRidersStart);
+    ++g_radarProfCount;
+#endif
+}
+
+void RadarHud::renderFrame(float opacity) {
+    const RiderLayer& layer = m_riderLayer;
+
+    // Add background (opacity scaled by max rider visibility when fade enabled)
+    float savedOpacity = m_fBackgroundOpacity;
+    m_fBackgroundOpacity = savedOpacity * opacity;
+    addBackgroundQuad(layer.x, layer.y, layer.width, layer.height);
+    m_fBackgroundOpacity = savedOpacity;
+
+    // Add title (also fades with background when fade enabled)
+    if (m_bShowTitle) {
+        auto dim = getScaledDimensions();
+        float titleX = layer.x + dim.paddingH;
+        float titleY = layer.y + dim.paddingV;
+        unsigned long titleColor = PluginUtils::applyOpacity(
+            this->getColor(ColorSlot::PRIMARY), opacity);
+        addTitleString("RADAR", titleX, titleY, Justify::LEFT,
+                      this->getFont(FontCategory::SMALL), titleColor, dim.fontSizeLarge);
+    }
+}
+
+void RadarHud::renderRiderLayer() {
+    const RiderLayer& layer = m_riderLayer;
+    const float centerX = layer.centerX;
+    const float centerY = layer.centerY;
+    const float radarRadius = layer.radarRadius;
+    const ProximityGradient& gradient = layer.gradient;
+
     // Get plugin data and find local player (needed for opacity calculation)
     const PluginData& pluginData = PluginData::getInstance();
     int displayRaceNum = pluginData.getDisplayRaceNum();
@@ -396,8 +506,8 @@ void RadarHud::rebuildRenderData() {
         sinYaw = std::sin(yawRad);
     }
 
-    // Build proximity gradient once (shared by sector overlay and proximity arrows)
-    const ProximityGradient gradient = buildProximityGradient();
+    // Track geometry for the along-track distance filters below
+    m_trackGeometry = HudManager::getInstance().getTrackRibbons().current();
 
     // If radar mode is OFF, skip radar rendering but still render proximity arrows
     if (m_radarMode == RadarMode::OFF) {
@@ -424,8 +534,8 @@ void RadarHud::rebuildRenderData() {
             if (trackDist > 0.5f) trackDist = 1.0f - trackDist;
 
             float trackFadeOpacity = 1.0f;
-            if (trackLength > 0.0f) {
-                float trackDistMeters = trackDist * trackLength;
+            float trackDistMeters = trackSeparationMeters(pos.trackPos, localPlayer->trackPos, trackLength);
+            if (trackDistMeters >= 0.0f) {
                 if (trackDistMeters >= m_fRadarRangeMeters) continue;
                 trackFadeOpacity = 1.0f - (trackDistMeters / m_fRadarRangeMeters);
             } else {
@@ -438,29 +548,10 @@ void RadarHud::rebuildRenderData() {
         }
     }
 
-    // Add background (opacity scaled by max rider visibility when fade enabled)
-    float savedOpacity = m_fBackgroundOpacity;
-    m_fBackgroundOpacity = savedOpacity * maxRiderOpacity;
-    addBackgroundQuad(x, y, width, height);
-    m_fBackgroundOpacity = savedOpacity;
-
-    // Add title (also fades with background when fade enabled)
-    if (m_bShowTitle) {
-        float titleX = x + dim.paddingH;
-        float titleY = y + dim.paddingV;
-        unsigned long titleColor = PluginUtils::applyOpacity(
-            this->getColor(ColorSlot::PRIMARY), maxRiderOpacity);
-        addTitleString("RADAR", titleX, titleY, Justify::LEFT,
-                      this->getFont(FontCategory::SMALL), titleColor, dim.fontSizeLarge);
+    if (m_radarMode == RadarMode::AUTO_HIDE) {
+        renderFrame(maxRiderOpacity);
     }
 
-    // Calculate radar center position
-    float centerX = x + width * 0.5f;
-    float centerY = y + titleHeight + dim.paddingV + radarRadius;
-
-    // Number of sectors for proximity highlighting (4 = front, right, back, left)
-    constexpr int NUM_SECTORS = 4;
-
     // Track closest rider distance per section (for intensity-based highlighting)
     // Section angles (in radar space where 0° = forward/up, 90° each):
     // Section 0: 315°-45° (front)
@@ -502,8 +593,8 @@ void RadarHud::rebuildRenderData() {
             if (trackDist > 0.5f) trackDist = 1.0f - trackDist;  // Handle wraparound
 
             float trackLength = pluginData.getSessionData().trackLength;
-            if (trackLength > 0.0f) {
-                float trackDistMeters = trackDist * trackLength;
+            float trackDistMeters = trackSeparationMeters(pos.trackPos, localPlayer->trackPos, trackLength);
+            if (trackDistMeters >= 0.0f) {
                 if (trackDistMeters > m_fAlertDistance) continue;
             } else {
                 // Fallback: use 5% of track as threshold if track length unknown
@@ -664,9 +755,9 @@ void RadarHud::rebuildRenderData() {
         if (trackDist > 0.5f) trackDist = 1.0f - trackDist;  // Handle wraparound
 
         float trackLength = pluginData.getSessionData().trackLength;
-        if (trackLength > 0.0f) {
+        float trackDistMeters = trackSeparationMeters(pos.trackPos, localPlayer->trackPos, trackLength);
+        if (trackDistMeters >= 0.0f) {
             // Use actual track distance in meters, tied to radar range
-            float trackDistMeters = trackDist * trackLength;
             if (trackDistMeters >= m_fRadarRangeMeters) {
                 continue;  // Beyond radar range on track
             }
@@ -847,6 +938,18 @@ void RadarHud::resetToDefaults() {
     setDataDirty();
 }
 
+float RadarHud::trackSeparationMeters(float trackPosA, float trackPosB, float trackLength) const {
+    if (m_trackGeometry && m_trackGeometry->model.valid()) {
+        return m_trackGeometry->model.separationMeters(trackPosA, trackPosB);
+    }
+    if (trackLength <= 0.0f) {
+        return -1.0f;
+    }
+    float trackDist = std::abs(trackPosA - trackPosB);
+    if (trackDist > 0.5f) trackDist = 1.0f - trackDist;  // Handle wraparound
+    return trackDist * trackLength;
+}
+
 void RadarHud::renderProximityArrows(const Unified::TrackPositionData* localPlayer,
                                       float playerX, float playerZ,
                                       float cosYaw, float sinYaw,
@@ -892,8 +995,8 @@ void RadarHud::renderProximityArrows(const Unified::TrackPositionData* localPlay
         float trackDist = std::abs(pos.trackPos - localPlayer->trackPos);
         if (trackDist > 0.5f) trackDist = 1.0f - trackDist;
 
-        if (trackLength > 0.0f) {
-            float trackDistMeters = trackDist * trackLength;
+        float trackDistMeters = trackSeparationMeters(pos.trackPos, localPlayer->trackPos, trackLength);
+        if (trackDistMeters >= 0.0f) {
             if (trackDistMeters > m_fAlertDistance) continue;
         } else {
             constexpr float FALLBACK_THRESHOLD = 0.05f;
@@ -6,6 +6,8 @@
 
 #include "base_hud.h"
 #include "../game/unified_types.h"
+#include "../core/track_ribbon_pyramid.h"
+#include <memory>
 #include <vector>
 
 // Proximity gradient colors for sector overlays and distance-mode arrows.
@@ -30,6 +32,8 @@ public:
 
     // Update rider positions (called frequently - must be fast)
     void updateRiderPositions(int numVehicles, const Unified::TrackPositionData* positions);
+    // Whether rebuildMotion() only rewrites the rider layer (see MapHud).
+    bool hasIncrementalMotion() const { return m_riderLayer.valid; }
 
     // Distance/range configuration (in meters)
     void setRadarRange(float rangeMeters);
@@ -158,6 +162,8 @@ public:
 
 protected:
     void rebuildRenderData() override;
+    // Position-only frames: rewrite just the rider layer (see RiderLayer)
+    void rebuildMotion() override;
 
 private:
     // Rider position storage (updated frequently)
@@ -173,6 +179,38 @@ private:
     static constexpr size_t RESERVE_QUADS = 60;            // Background + rider arrows
     static constexpr size_t RESERVE_STRINGS = 60;          // Title + rider labels
 
+    // Proximity sectors (front, right, back, left; the front one is never drawn)
+    static constexpr int NUM_SECTORS = 4;
+
+    // The output is two layers. The static layer is the background and title,
+    // laid out by a full rebuild; everything else is drawn relative to the
+    // player (sectors, riders, labels, proximity arrows) and is the rider layer,
+    // the tail of m_quads and m_strings from these starts. rebuildMotion()
+    // rewrites only that tail, in place: a full rebuild reserves room for
+    // MAX_RACE_ENTRIES riders behind the static layer. In auto-hide mode the
+    // background and title fade with the nearest rider, so they move into the
+    // rider layer and the static layer is empty.
+    struct RiderLayer {
+        bool valid = false;
+        size_t quadStart = 0;
+        size_t stringStart = 0;
+        float x = 0.0f, y = 0.0f, width = 0.0f, height = 0.0f;
+        float centerX = 0.0f, centerY = 0.0f, radarRadius = 0.0f;
+        ProximityGradient gradient{};
+    };
+    RiderLayer m_riderLayer;
+    // Per rider: icon + proximity arrow quads and a label drawn as up to five
+    // strings (four outline passes) of at most RIDER_LABEL_BYTES each; plus the
+    // sectors and, in auto-hide, the background, title and title icon
+    static constexpr size_t RIDER_LABEL_BYTES = 20;
+    static constexpr size_t RIDER_LAYER_QUADS = Unified::MAX_RACE_ENTRIES * 2 + NUM_SECTORS + 2;
+    static constexpr size_t RIDER_LAYER_STRINGS = Unified::MAX_RACE_ENTRIES * 5 + 1;
+
+    // Background and title; in auto-hide, faded to the nearest rider's opacity
+    void renderFrame(float opacity);
+    // Everything that moves with the riders (see RiderLayer)
+    void renderRiderLayer();
+
     // Rider colorization
     RiderColorMode m_riderColorMode;
 
@@ -219,6 +257,15 @@ private:
                                float cosYaw, float sinYaw,
                                const ProximityGradient& gradient);
 
+    // Helper: Shortest along-track distance between two trackPos values in meters
+    // (skips riders on parallel straights). From the track's TrackModel once the
+    // centerline is loaded, else the session's track length; negative when
+    // neither is known (callers then fall back to a fraction of the lap).
+    float trackSeparationMeters(float trackPosA, float trackPosB, float trackLength) const;
+
+    // Track geometry snapshot for the current rider layer (its TrackModel)
+    std::shared_ptr<const TrackRibbonPyramid::Levels> m_trackGeometry;
+
     // Helper: Build proximity gradient from NEGATIVE/NEUTRAL/POSITIVE color slots
     ProximityGradient buildProximityGradient() const;
 
@@ -233,3 +280,11 @@ private:
     };
     CachedIcons m_iconCache;
 };
+
+#if defined(MXBMRP3_TEST_BUILD)
+// Perf profiling (test builds only): read + reset the accumulated RadarHud time
+// (microseconds) in the static layer and in the rider layer, and the number of
+// rider-layer renders, since the last read. A position-only frame adds to the
+// rider layer alone.
+void radarHudReadProfile(double& staticUs, double& ridersUs, long long& count);
+#endif
@@ -40,7 +40,7 @@ void RumbleHud::update() {
 
     // Rebuild only when new telemetry arrived (data dirty fires per
     // InputTelemetry change, ~100Hz while riding) or layout changed. The rumble
-    // effect values and their history deques are all telemetry-driven, so the
+    // effect values and their history rings are all telemetry-driven, so the
     // graph output is identical between telemetry ticks — rebuilding every render
     // frame (~2,600 line-segment quads with all channels on) wasted most of the
     // work at 240fps. Same fix TelemetryHud received for the identical pattern.
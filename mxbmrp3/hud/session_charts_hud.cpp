@@ -13,7 +13,6 @@
 #include <cstdio>
 #include <cmath>
 #include <deque>
-#include <unordered_map>
 
 using namespace PluginConstants;
 
@@ -80,6 +79,7 @@ SessionChartsHud::SessionChartsHud() {
     // rare 4-chart + max-rows + full MAX_LAP_LOG_STORAGE config reallocs a little.
     m_quads.reserve(4096);
     m_strings.reserve(64);
+    m_series.reset(false, static_cast<size_t>(HudLimits::MAX_LAP_LOG_STORAGE));
 
     setTextureBaseName("session_charts_hud");
 
@@ -117,64 +117,82 @@ bool SessionChartsHud::handlesDataType(DataChangeType dataType) const {
 // Data collection
 // ---------------------------------------------------------------------------
 
-void SessionChartsHud::collectField(FieldData& field) const {
+bool SessionChartsHud::appendNewLaps(int slot, const std::deque<LapLogEntry>* log) {
+    LapCursor& cursor = m_lapCursors[slot];
+    const SessionChartsMath::FieldSeries::Rider& rider = m_series.rider(slot);
+    if (!log || log->empty()) return rider.lapMs.empty();
+
+    // Newest-first: walk back to the latest lap already in the series. It must
+    // still be there, unchanged, and the oldest one must not have been dropped.
+    size_t newer = log->size();
+    if (!rider.lapMs.empty()) {
+        newer = 0;
+        while (newer < log->size() && (*log)[newer].lapNum > cursor.lastLapNum) ++newer;
+        if (newer == log->size()) return false;
+        const LapLogEntry& last = (*log)[newer];
+        if (last.lapNum != cursor.lastLapNum || last.lapTime != rider.lapMs.back()) return false;
+        if (log->back().lapNum > cursor.firstLapNum) return false;
+    }
+
+    // Append oldest-first, completed laps only. Keep INVALID laps too: their time
+    // still elapsed, so cumulative/position/gap must include them (an invalidated
+    // lap doesn't rewind the race). Validity is recorded in parallel so
+    // pace/best-lap can exclude them.
+    for (size_t k = newer; k-- > 0;) {
+        const LapLogEntry& e = (*log)[k];
+        if (!e.isComplete || e.lapTime <= 0) continue;
+        if (rider.lapMs.empty()) cursor.firstLapNum = e.lapNum;
+        m_series.appendLap(slot, e.lapTime, e.isValid);
+        cursor.lastLapNum = e.lapNum;
+    }
+    return true;
+}
+
+void SessionChartsHud::collectField(FieldData& field) {
     const PluginData& pluginData = PluginData::getInstance();
     const std::vector<int>& order = pluginData.getClassificationOrder();
-
-    field.raceNums = order;
-    field.isRace = pluginData.isRaceSession();
-    field.lapMs.assign(order.size(), {});
-    field.lapValid.assign(order.size(), {});
-
-    for (size_t i = 0; i < order.size(); ++i) {
-        const std::deque<LapLogEntry>* log = pluginData.getLapLog(order[i]);
-        if (!log) continue;
-        // Deque is newest-first; reverse to oldest-first, keep completed laps only.
-        // Keep INVALID laps too: their time still elapsed, so cumulative/position/gap
-        // must include them (an invalidated lap doesn't rewind the race). Validity is
-        // recorded in parallel so pace/best-lap can exclude them.
-        std::vector<int>& laps = field.lapMs[i];
-        std::vector<char>& valid = field.lapValid[i];
-        laps.reserve(log->size());
-        valid.reserve(log->size());
-        for (auto it = log->rbegin(); it != log->rend(); ++it) {
-            if (it->isComplete && it->lapTime > 0) {
-                laps.push_back(it->lapTime);
-                valid.push_back(it->isValid ? 1 : 0);
+    const bool isRace = pluginData.isRaceSession();
+
+    // Normally one pass appends the laps completed since the last rebuild. When a
+    // log no longer extends the series, or a rider with laps left the
+    // classification, the series restarts and the second pass refills it.
+    bool current = (m_series.isRace() == isRace);
+    for (int pass = 0; pass < 2; ++pass) {
+        if (!current) {
+            m_series.reset(isRace, static_cast<size_t>(HudLimits::MAX_LAP_LOG_STORAGE));
+            m_lapCursors.clear();
+        }
+        current = true;
+        ++m_syncPass;
+        for (int raceNum : order) {
+            const int slot = m_series.addRider(raceNum);
+            if (slot >= static_cast<int>(m_lapCursors.size())) m_lapCursors.resize(slot + 1);
+            m_lapCursors[slot].seenPass = m_syncPass;
+            if (!appendNewLaps(slot, pluginData.getLapLog(raceNum))) { current = false; break; }
+        }
+        for (size_t slot = 0; current && slot < m_lapCursors.size(); ++slot) {
+            if (m_lapCursors[slot].seenPass != m_syncPass &&
+                !m_series.rider(static_cast<int>(slot)).lapMs.empty()) {
+                current = false;
             }
         }
-        field.maxLap = std::max(field.maxLap, static_cast<int>(laps.size()));
-    }
-
-    // Cumulative race time (drives the race trace; race only).
-    field.cumulative.assign(order.size(), {});
-    for (size_t i = 0; i < order.size(); ++i) {
-        field.cumulative[i] = SessionChartsMath::cumulative(field.lapMs[i]);
-    }
-
-    // Ranking basis for the position and gap charts: cumulative race time in a
-    // race, best-lap-so-far otherwise. The latter gives the provisional
-    // qualifying/practice order and each rider's gap to the session-best lap.
-    std::vector<std::vector<long long>> rank(order.size());
-    for (size_t i = 0; i < order.size(); ++i) {
-        rank[i] = field.isRace ? field.cumulative[i]
-                               : SessionChartsMath::bestLapSoFar(field.lapMs[i], field.lapValid[i]);
+        if (current) break;
     }
-    field.positions = SessionChartsMath::positionsPerLap(rank, field.raceNums);
-    field.gaps = SessionChartsMath::gapToLeaderPerLap(rank);
 
-    // Reference pace / trace need a mass start — race only.
-    if (field.isRace) {
-        int leader = SessionChartsMath::leaderIndex(field.cumulative, field.raceNums);
-        if (leader >= 0 && !field.cumulative[leader].empty()) {
-            field.refPaceMs = SessionChartsMath::referencePaceMs(
-                field.cumulative[leader].back(),
-                static_cast<int>(field.cumulative[leader].size()));
-        }
-    }
+    field.series = &m_series;
+    field.raceNums = order;
+    field.slots.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) field.slots[i] = m_series.slotOf(order[i]);
+    field.isRace = isRace;
+    field.maxLap = m_series.maxLap();
+    // Reference pace / trace need a mass start — race only. Off-race the series
+    // ranks by best-lap-so-far: the provisional qualifying/practice order and
+    // each rider's gap to the session-best lap.
+    field.refPaceMs = m_series.refPaceMs();
 }
 
-void SessionChartsHud::selectDrawn(const FieldData& field, std::vector<DrawnRider>& drawn) const {
+void SessionChartsHud::selectDrawn(const FieldData& field, std::vector<DrawnRider>& drawn) {
+    drawn.clear();
     const int n = static_cast<int>(field.raceNums.size());
     if (n == 0) return;
 
@@ -192,8 +210,8 @@ void SessionChartsHud::selectDrawn(const FieldData& field, std::vector<DrawnRide
 
     // Build the set of classification indices to draw: top-N pinned plus a
     // window centered on the player (StandingsHud algorithm, standings_hud.cpp).
-    std::vector<int> indices;
-    indices.reserve(rows);
+    std::vector<int>& indices = m_drawIndices;
+    indices.clear();
     auto addIdx = [&](int i) {
         if (i < 0 || i >= n) return;
         for (int existing : indices) if (existing == i) return;  // dedupe overlap
@@ -222,12 +240,14 @@ void SessionChartsHud::selectDrawn(const FieldData& field, std::vector<DrawnRide
     // whole point of a progression chart is to follow one line over time. The
     // race-number ranking is 0..size-1, so every on-screen line gets a distinct hue
     // (the drawn count is capped at the palette size).
-    std::vector<int> byNum = indices;
+    std::vector<int>& byNum = m_drawByNum;
+    byNum.assign(indices.begin(), indices.end());
     std::sort(byNum.begin(), byNum.end(), [&](int a, int b) {
         return field.raceNums[a] < field.raceNums[b];
     });
-    std::unordered_map<int, unsigned long> colorFor;   // fieldIdx -> colour
-    std::unordered_map<unsigned long, int> brandOrdinal;
+    std::vector<unsigned long>& colorFor = m_colorFor;   // fieldIdx -> colour
+    colorFor.assign(n, 0);
+    m_brandOrdinals.clear();
     int slot = 0;
     for (int idx : byNum) {
         unsigned long color;
@@ -235,7 +255,12 @@ void SessionChartsHud::selectDrawn(const FieldData& field, std::vector<DrawnRide
             const RaceEntryData* entry = pluginData.getRaceEntry(field.raceNums[idx]);
             unsigned long base = (entry && entry->bikeBrandColor) ? entry->bikeBrandColor
                                                                   : PALETTE[slot % PALETTE_SIZE];
-            int ord = brandOrdinal[base]++;
+            // Riders of this brand so far (a linear scan: at most one entry per drawn rider).
+            auto brand = m_brandOrdinals.begin();
+            while (brand != m_brandOrdinals.end() && brand->first != base) ++brand;
+            int ord = 0;
+            if (brand == m_brandOrdinals.end()) m_brandOrdinals.push_back({ base, 1 });
+            else ord = brand->second++;
             switch (ord % 5) {
                 case 0: color = base; break;
                 case 1: color = PluginUtils::lightenColor(base, 0.35f); break;
@@ -279,24 +304,24 @@ void SessionChartsHud::rebuildRenderData() {
     // Collect and derive data, then select which riders to draw. Note: we always
     // render the chart frame (grid + axes) even before any laps exist; the lines
     // and their inline "#num" tags simply fill in as laps arrive.
-    FieldData field;
+    FieldData& field = m_field;
     collectField(field);
-    std::vector<DrawnRider> drawn;
+    std::vector<DrawnRider>& drawn = m_drawn;
     selectDrawn(field, drawn);
     const bool isRace = field.isRace;
 
     // Which charts to render, stacked vertically top-to-bottom (whichever checkboxes
     // are enabled, in a fixed order). Each is a subheading + a graph.
-    std::vector<ChartType> charts;
-    if (m_enabledCharts & CHART_LAP)   charts.push_back(ChartType::LAP);
-    if (m_enabledCharts & CHART_TRACE) charts.push_back(ChartType::TRACE);
-    if (m_enabledCharts & CHART_GAP)   charts.push_back(ChartType::GAP);
-    if (m_enabledCharts & CHART_PACE)  charts.push_back(ChartType::PACE);
+    ChartType charts[4];
+    int nCharts = 0;
+    if (m_enabledCharts & CHART_LAP)   charts[nCharts++] = ChartType::LAP;
+    if (m_enabledCharts & CHART_TRACE) charts[nCharts++] = ChartType::TRACE;
+    if (m_enabledCharts & CHART_GAP)   charts[nCharts++] = ChartType::GAP;
+    if (m_enabledCharts & CHART_PACE)  charts[nCharts++] = ChartType::PACE;
 
     // Dimensions. Every chart gets the full height, so the HUD grows taller as charts
     // are added (a multi-chart stack can exceed the screen — position/scale is the
     // user's to set).
-    int nCharts = static_cast<int>(charts.size());
     float titleHeight = m_bShowTitle ? dims.lineHeightLarge : 0.0f;
     float subHeadH = dims.lineHeightNormal;                        // per-chart subheading row
     float chartGapY = dims.lineHeightNormal;                       // full-row gap between stacked charts (keeps the HUD on-grid and matching Performance's section gap)
@@ -323,13 +348,14 @@ void SessionChartsHud::rebuildRenderData() {
         currentY += titleHeight;
     }
 
-    if (charts.empty()) {
+    if (nCharts == 0) {
         addString("No charts enabled", contentStartX + graphWidth * 0.5f, currentY,
             Justify::CENTER, this->getFont(FontCategory::NORMAL),
             this->getColor(ColorSlot::MUTED), dims.fontSize);
     }
     float y = currentY;
-    for (ChartType ct : charts) {
+    for (int c = 0; c < nCharts; ++c) {
+        const ChartType ct = charts[c];
         // Subheading (chart name), styled like StandingsHud's session line.
         addString(chartNameOf(ct, isRace), contentStartX, y, Justify::LEFT,
             this->getFont(FontCategory::TITLE), this->getColor(ColorSlot::PRIMARY), dims.fontSize);
@@ -407,13 +433,15 @@ void SessionChartsHud::drawLapChart(float px, float py, float pw, float ph,
     // absolute track position and give each its own row. Every line is then exactly
     // one row, so its end tag lines up with the line and never overlaps another.
     // rowOf[di][lap] = 0-based row (rank among the shown present), or -1 if absent.
-    std::vector<std::vector<int>> rowOf(K);
+    std::vector<std::vector<int>>& rowOf = m_lapRows;
+    if (static_cast<int>(rowOf.size()) < K) rowOf.resize(K);
     for (int di = 0; di < K; ++di)
-        rowOf[di].assign(field.positions[drawn[di].fieldIdx].size(), -1);
+        rowOf[di].assign(field.positions(drawn[di].fieldIdx).size(), -1);
     for (int lap = 0; lap < field.maxLap; ++lap) {
-        std::vector<std::pair<int, int>> present;  // (absolute position, di)
+        std::vector<std::pair<int, int>>& present = m_lapPresent;  // (absolute position, di)
+        present.clear();
         for (int di = 0; di < K; ++di) {
-            const std::vector<int>& pos = field.positions[drawn[di].fieldIdx];
+            const std::vector<int>& pos = field.positions(drawn[di].fieldIdx);
             if (lap < static_cast<int>(pos.size()) && pos[lap] > 0)
                 present.push_back({ pos[lap], di });
         }
@@ -422,19 +450,17 @@ void SessionChartsHud::drawLapChart(float px, float py, float pw, float ph,
             rowOf[present[r].second][lap] = r;
     }
 
-    const float lineThickness = 0.0022f * dims.scale;
-    const float dotSize = 0.004f * dims.scale;
     for (int di = 0; di < K; ++di) {
         const DrawnRider& d = drawn[di];
-        float thick = d.isPlayer ? lineThickness * 1.6f : lineThickness;
-        Pt prev, tag;
+        const LineStyle style = lineStyle(d, px);
+        Pt tag;
         for (int lap = 0; lap < static_cast<int>(rowOf[di].size()); ++lap) {
-            if (rowOf[di][lap] < 0) { prev.ok = false; continue; }
+            if (rowOf[di][lap] < 0) { drawRun(style); continue; }
             Pt cur{ xForLap(px, pw, lap, field.maxLap), yForRow(rowOf[di][lap]), true };
-            if (prev.ok) addLineSegment(prev.x, prev.y, cur.x, cur.y, d.color, thick);
-            if (m_enabledElements & ELEM_DOTS) addDot(cur.x, cur.y, d.color, dotSize);
-            prev = cur; tag = cur;
+            m_polylineX.push_back(cur.x); m_polylineY.push_back(cur.y);
+            tag = cur;
         }
+        drawRun(style);
         if ((m_enabledElements & ELEM_LEGEND) && tag.ok)
             addRiderTag(tag.x, tag.y, field.raceNums[d.fieldIdx], d.color);
     }
@@ -446,7 +472,7 @@ void SessionChartsHud::drawLapChart(float px, float py, float pw, float ph,
         for (int lap = field.maxLap - 1; lap >= 0; --lap) {
             int best = -1, worst = -1;
             for (int di = 0; di < K; ++di) {
-                const std::vector<int>& p = field.positions[drawn[di].fieldIdx];
+                const std::vector<int>& p = field.positions(drawn[di].fieldIdx);
                 if (lap >= static_cast<int>(p.size()) || p[lap] <= 0) continue;
                 if (best < 0 || p[lap] < best)  best = p[lap];
                 if (worst < 0 || p[lap] > worst) worst = p[lap];
@@ -478,13 +504,14 @@ void SessionChartsHud::drawTraceChart(float px, float py, float pw, float ph,
     // fence) so one rider who lost minutes can't stretch the axis and crush the
     // pack into a sliver. The outlier's line is still drawn, clipped to the chart
     // edge below. Always include 0 so the reference (zero) line stays on screen.
-    std::vector<long long> vals;
+    std::vector<long long>& vals = m_rangeSample;
+    vals.clear();
     for (const DrawnRider& d : drawn) {
-        const std::vector<long long>& cum = field.cumulative[d.fieldIdx];
+        const std::vector<long long>& cum = field.cumulative(d.fieldIdx);
         for (size_t l = 0; l < cum.size(); ++l)
             vals.push_back(SessionChartsMath::traceValueMs(field.refPaceMs, static_cast<int>(l) + 1, cum[l]));
     }
-    SessionChartsMath::AxisRange rr = SessionChartsMath::robustRange(vals);
+    SessionChartsMath::AxisRange rr = SessionChartsMath::robustRangeInPlace(vals);
     long long vMin = std::min<long long>(rr.valid ? rr.lo : 0, 0);
     long long vMax = std::max<long long>(rr.valid ? rr.hi : 0, 0);
     if (vMax - vMin < 1000) { vMax += 500; vMin -= 500; }  // at least a 1s span
@@ -513,19 +540,16 @@ void SessionChartsHud::drawTraceChart(float px, float py, float pw, float ph,
         }
     }
 
-    const float lineThickness = 0.0022f * dims.scale;
-    const float dotSize = 0.004f * dims.scale;
     for (const DrawnRider& d : drawn) {
-        const std::vector<long long>& cum = field.cumulative[d.fieldIdx];
-        float thick = d.isPlayer ? lineThickness * 1.6f : lineThickness;
-        Pt prev, tag;
+        const std::vector<long long>& cum = field.cumulative(d.fieldIdx);
+        Pt tag;
         for (size_t l = 0; l < cum.size(); ++l) {
             long long v = SessionChartsMath::traceValueMs(field.refPaceMs, static_cast<int>(l) + 1, cum[l]);
             Pt cur{ xForLap(px, pw, static_cast<int>(l), field.maxLap), yForVal(v), true };
-            if (prev.ok) addLineSegment(prev.x, prev.y, cur.x, cur.y, d.color, thick);
-            if (m_enabledElements & ELEM_DOTS) addDot(cur.x, cur.y, d.color, dotSize);
-            prev = cur; tag = cur;
+            m_polylineX.push_back(cur.x); m_polylineY.push_back(cur.y);
+            tag = cur;
         }
+        drawRun(lineStyle(d, px));
         if ((m_enabledElements & ELEM_LEGEND) && tag.ok)
             addRiderTag(tag.x, tag.y, field.raceNums[d.fieldIdx], d.color);
     }
@@ -556,11 +580,12 @@ void SessionChartsHud::drawGapChart(float px, float py, float pw, float ph,
     // sentinel through bestLapSoFar -> gap, so exclude those from the range sample
     // (else the fence lands on the sentinel and crushes the real pack). Their lines
     // still draw, clipped to the bottom edge.
-    std::vector<long long> vals;
+    std::vector<long long>& vals = m_rangeSample;
+    vals.clear();
     for (const DrawnRider& d : drawn)
-        for (long long g : field.gaps[d.fieldIdx])
+        for (long long g : field.gaps(d.fieldIdx))
             if (g < SessionChartsMath::kNoValidLap / 2) vals.push_back(g);
-    SessionChartsMath::AxisRange rr = SessionChartsMath::robustRange(vals);
+    SessionChartsMath::AxisRange rr = SessionChartsMath::robustRangeInPlace(vals);
     long long gapMax = std::max<long long>(1000, rr.valid ? rr.hi : 0);  // at least a 1s span
 
     auto yForGap = [&](long long g) {  // 0 at top, growing downward; clip to edge
@@ -575,19 +600,15 @@ void SessionChartsHud::drawGapChart(float px, float py, float pw, float ph,
         addHorizontalGridLine(px, py + ph, pw, gridColor, gridThickness);     // gapMax
     }
 
-    const float lineThickness = 0.0022f * dims.scale;
-    const float dotSize = 0.004f * dims.scale;
     for (const DrawnRider& d : drawn) {
-        const std::vector<long long>& gaps = field.gaps[d.fieldIdx];
-        const std::vector<long long>& cum = field.cumulative[d.fieldIdx];
-        float thick = d.isPlayer ? lineThickness * 1.6f : lineThickness;
-        Pt prev, tag;
-        for (size_t l = 0; l < cum.size(); ++l) {
+        const std::vector<long long>& gaps = field.gaps(d.fieldIdx);
+        Pt tag;
+        for (size_t l = 0; l < gaps.size(); ++l) {
             Pt cur{ xForLap(px, pw, static_cast<int>(l), field.maxLap), yForGap(gaps[l]), true };
-            if (prev.ok) addLineSegment(prev.x, prev.y, cur.x, cur.y, d.color, thick);
-            if (m_enabledElements & ELEM_DOTS) addDot(cur.x, cur.y, d.color, dotSize);
-            prev = cur; tag = cur;
+            m_polylineX.push_back(cur.x); m_polylineY.push_back(cur.y);
+            tag = cur;
         }
+        drawRun(lineStyle(d, px));
         if ((m_enabledElements & ELEM_LEGEND) && tag.ok)
             addRiderTag(tag.x, tag.y, field.raceNums[d.fieldIdx], d.color);
     }
@@ -614,21 +635,22 @@ void SessionChartsHud::drawPaceChart(float px, float py, float pw, float ph,
     // every completed lap raw. (Cumulative/gap/position keep invalid laps — the time
     // still elapsed — so this is a pace-only exclusion.)
     auto isValidLap = [&](int fieldIdx, int lapIndex0) {
-        const std::vector<char>& v = field.lapValid[fieldIdx];
+        const std::vector<char>& v = field.lapValid(fieldIdx);
         return lapIndex0 >= static_cast<int>(v.size()) || v[lapIndex0] != 0;
     };
 
     // Median across clean laps (baseline for outlier filtering), so an invalid or
     // opening lap doesn't skew the racing-pace band.
-    std::vector<int> allLaps;
+    std::vector<int>& allLaps = m_paceSample;
+    allLaps.clear();
     for (const DrawnRider& d : drawn) {
-        const std::vector<int>& laps = field.lapMs[d.fieldIdx];
+        const std::vector<int>& laps = field.lapMs(d.fieldIdx);
         for (size_t l = 0; l < laps.size(); ++l) {
             if (filter && (!isValidLap(d.fieldIdx, static_cast<int>(l)) || l == 0)) continue;
             allLaps.push_back(laps[l]);
         }
     }
-    int median = SessionChartsMath::medianMs(allLaps);
+    int median = SessionChartsMath::medianMsInPlace(allLaps);
 
     auto included = [&](int fieldIdx, int lapIndex0, int lapMs) {
         if (!filter) return true;
@@ -639,7 +661,7 @@ void SessionChartsHud::drawPaceChart(float px, float py, float pw, float ph,
     // Auto-fit Y range across included laps.
     long long vMin = -1, vMax = -1;
     for (const DrawnRider& d : drawn) {
-        const std::vector<int>& laps = field.lapMs[d.fieldIdx];
+        const std::vector<int>& laps = field.lapMs(d.fieldIdx);
         for (size_t l = 0; l < laps.size(); ++l) {
             if (!included(d.fieldIdx, static_cast<int>(l), laps[l])) continue;
             if (vMin < 0 || laps[l] < vMin) vMin = laps[l];
@@ -665,19 +687,17 @@ void SessionChartsHud::drawPaceChart(float px, float py, float pw, float ph,
         addHorizontalGridLine(px, py + ph, pw, gridColor, gridThickness);
     }
 
-    const float lineThickness = 0.0022f * dims.scale;
-    const float dotSize = 0.004f * dims.scale;
     for (const DrawnRider& d : drawn) {
-        const std::vector<int>& laps = field.lapMs[d.fieldIdx];
-        float thick = d.isPlayer ? lineThickness * 1.6f : lineThickness;
-        Pt prev, tag;
+        const std::vector<int>& laps = field.lapMs(d.fieldIdx);
+        const LineStyle style = lineStyle(d, px);
+        Pt tag;
         for (size_t l = 0; l < laps.size(); ++l) {
-            if (!included(d.fieldIdx, static_cast<int>(l), laps[l])) { prev.ok = false; continue; }
+            if (!included(d.fieldIdx, static_cast<int>(l), laps[l])) { drawRun(style); continue; }
             Pt cur{ xForLap(px, pw, static_cast<int>(l), field.maxLap), yForVal(laps[l]), true };
-            if (prev.ok) addLineSegment(prev.x, prev.y, cur.x, cur.y, d.color, thick);
-            if (m_enabledElements & ELEM_DOTS) addDot(cur.x, cur.y, d.color, dotSize);
-            prev = cur; tag = cur;
+            m_polylineX.push_back(cur.x); m_polylineY.push_back(cur.y);
+            tag = cur;
         }
+        drawRun(style);
         if ((m_enabledElements & ELEM_LEGEND) && tag.ok)
             addRiderTag(tag.x, tag.y, field.raceNums[d.fieldIdx], d.color);
     }
@@ -692,6 +712,42 @@ void SessionChartsHud::drawPaceChart(float px, float py, float pw, float ph,
     }
 }
 
+// ---------------------------------------------------------------------------
+// Rider lines
+// ---------------------------------------------------------------------------
+
+SessionChartsHud::LineStyle SessionChartsHud::lineStyle(const DrawnRider& d, float px) const {
+    const auto dims = getScaledDimensions();
+    const float lineThickness = 0.0022f * dims.scale;
+    LineStyle style;
+    style.color = d.color;
+    style.thickness = d.isPlayer ? lineThickness * 1.6f : lineThickness;
+    style.dotSize = 0.004f * dims.scale;
+    style.x0 = px;
+    style.pxPerUnit = displayPixelsPerUnit();
+    return style;
+}
+
+void SessionChartsHud::drawRun(const LineStyle& style) {
+    // One unbroken run of a rider's line, decimated to the plot's pixel columns so
+    // a long session doesn't emit a quad per lap per rider, then drawn as one
+    // batched polyline with the dots on top.
+    SessionChartsMath::decimateMinMax(m_polylineX.data(), m_polylineY.data(), m_polylineX.size(),
+                                      style.x0, style.pxPerUnit, m_runKeep);
+    // Compact the kept points in place (indices are ascending, so k <= keep[k]).
+    for (size_t k = 0; k < m_runKeep.size(); ++k) {
+        m_polylineX[k] = m_polylineX[m_runKeep[k]];
+        m_polylineY[k] = m_polylineY[m_runKeep[k]];
+    }
+    const size_t kept = m_runKeep.size();
+    addPolyline(m_polylineX.data(), m_polylineY.data(), kept, style.color, style.thickness);
+    if (m_enabledElements & ELEM_DOTS) {
+        for (size_t k = 0; k < kept; ++k) addDot(m_polylineX[k], m_polylineY[k], style.color, style.dotSize);
+    }
+    m_polylineX.clear();
+    m_polylineY.clear();
+}
+
 // ---------------------------------------------------------------------------
 // Inline line tag ("#num" at the end of a rider's line, in the rider's colour)
 // ---------------------------------------------------------------------------
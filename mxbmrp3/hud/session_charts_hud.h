@@ -21,7 +21,9 @@
 #include "../core/widget_constants.h"
 #include "session_charts_math.h"
 #include <vector>
+#include <deque>
 #include <cstdint>
+#include <utility>
 
 class SessionChartsHud : public BaseHud {
 public:
@@ -94,18 +96,24 @@ protected:
 private:
     void rebuildRenderData() override;
 
-    // Full-field lap-time table and everything derived from it (positions and
-    // gaps must be computed over the WHOLE field, not just the drawn subset).
+    // The chart field for one rebuild: the classification order mapped onto
+    // m_series slots, plus the per-rider series (positions and gaps are computed
+    // over the WHOLE field, not just the drawn subset). Indexed by
+    // classification index; the arrays themselves live in m_series.
     struct FieldData {
+        const SessionChartsMath::FieldSeries* series = nullptr;
         std::vector<int> raceNums;                       // classification order
-        std::vector<std::vector<int>> lapMs;             // per rider, oldest-first
-        std::vector<std::vector<char>> lapValid;         // per rider per lap (1=valid); parallel to lapMs
-        std::vector<std::vector<long long>> cumulative;  // per rider per lap (for trace)
-        std::vector<std::vector<int>> positions;         // per rider per lap (1-based)
-        std::vector<std::vector<long long>> gaps;        // per rider per lap (ms behind reference)
+        std::vector<int> slots;                          // m_series slot per classification index
         long long refPaceMs = 0;                         // leader avg lap (trace baseline)
         int maxLap = 0;                                  // max completed laps in field
         bool isRace = false;                             // race vs practice/qualifying
+
+        const SessionChartsMath::FieldSeries::Rider& rider(int i) const { return series->rider(slots[i]); }
+        const std::vector<int>& lapMs(int i) const { return rider(i).lapMs; }              // oldest-first
+        const std::vector<char>& lapValid(int i) const { return rider(i).lapValid; }       // 1=valid
+        const std::vector<long long>& cumulative(int i) const { return rider(i).cumulative; }
+        const std::vector<int>& positions(int i) const { return rider(i).positions; }     // 1-based
+        const std::vector<long long>& gaps(int i) const { return rider(i).gaps; }         // ms behind reference
     };
 
     // A rider selected for drawing (index into FieldData arrays + presentation).
@@ -115,8 +123,14 @@ private:
         bool isPlayer = false;
     };
 
-    void collectField(FieldData& field) const;
-    void selectDrawn(const FieldData& field, std::vector<DrawnRider>& drawn) const;
+    // Bring m_series up to date with the lap logs (appending only laps it hasn't
+    // seen), then describe the field in classification order.
+    void collectField(FieldData& field);
+    // Append rider `slot`'s newly completed laps from its newest-first log. False
+    // when the log no longer extends what the series holds (cleared, a new
+    // session, the storage cap dropped its oldest lap): the series must restart.
+    bool appendNewLaps(int slot, const std::deque<LapLogEntry>* log);
+    void selectDrawn(const FieldData& field, std::vector<DrawnRider>& drawn);
 
     // Draw one chart into the cell rect (x,y,w,h). Reserves room inside the cell
     // for axis labels, then dispatches to the per-type renderer. The frame (grid +
@@ -131,6 +145,22 @@ private:
     void drawPaceChart (float px, float py, float pw, float ph, const FieldData&, const std::vector<DrawnRider>&);
     void drawRaceOnlyNote(float x, float y, float w, float h);
 
+    // How a rider's line is drawn, and the pixel grid it is decimated to (x0 = the
+    // plot's left edge, pxPerUnit = display pixels per unit of normalized X).
+    struct LineStyle {
+        unsigned long color = 0;
+        float thickness = 0.0f;
+        float dotSize = 0.0f;
+        float x0 = 0.0f;
+        float pxPerUnit = 0.0f;
+    };
+    LineStyle lineStyle(const DrawnRider& d, float px) const;
+    // Draw the unbroken run collected in m_polylineX/m_polylineY, min/max-
+    // decimated to pixel columns (SessionChartsMath::decimateMinMax), as one
+    // addPolyline() with the dots on top, then empty it. The charts call it wherever a line
+    // breaks and after each rider.
+    void drawRun(const LineStyle& style);
+
     // Draw a rider's "#num" tag in small font at (x,y) — the end of its line — in
     // the rider's colour, so lines are labelled inline instead of via a legend
     // column. Always at the line's endpoint (line and label stay vertically aligned);
@@ -172,4 +202,38 @@ private:
 
     // Advanced tuning (INI-only, not in the UI): pace-chart outlier threshold.
     float m_outlierFactor = 1.4f;
+
+    // Every rider's lap series, kept across rebuilds: a LapLog change appends the
+    // new laps and re-ranks their lap columns only, so a rebuild costs the laps
+    // completed since the last one plus the geometry, not riders x laps.
+    SessionChartsMath::FieldSeries m_series;
+    // Per slot: the lapNum of the first and latest log entry appended, to find
+    // where a newest-first log picks up, and the sync pass that last saw it in
+    // the classification.
+    struct LapCursor {
+        int firstLapNum = -1;
+        int lastLapNum = -1;
+        unsigned seenPass = 0;
+    };
+    std::vector<LapCursor> m_lapCursors;
+    unsigned m_syncPass = 0;
+
+    // drawRun()'s kept-point indices; the run itself is BaseHud's polyline
+    // scratch. Both are reused across riders and rebuilds.
+    std::vector<size_t> m_runKeep;
+
+    // Per-rebuild working sets, kept so a rebuild reuses their capacity instead
+    // of allocating: the field description and drawn riders, selectDrawn()'s
+    // index lists and colours (per classification index) and brand counts, the
+    // Lap chart's row ranks, and the range/median samples.
+    FieldData m_field;
+    std::vector<DrawnRider> m_drawn;
+    std::vector<int> m_drawIndices;
+    std::vector<int> m_drawByNum;
+    std::vector<unsigned long> m_colorFor;
+    std::vector<std::pair<unsigned long, int>> m_brandOrdinals;   // (base colour, riders so far)
+    std::vector<std::vector<int>> m_lapRows;
+    std::vector<std::pair<int, int>> m_lapPresent;
+    std::vector<long long> m_rangeSample;
+    std::vector<int> m_paceSample;
 };
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstdio>
+#include <utility>
 
 namespace SessionChartsMath {
 
@@ -205,14 +206,16 @@ inline std::vector<std::vector<long long>> gapToLeaderPerLap(
 
 // Median lap time (ms) of a sample, used as the baseline for outlier filtering
 // on the pace chart. Returns 0 for an empty sample. Averages the two middle
-// values for an even count.
-inline int medianMs(std::vector<int> laps) {
+// values for an even count. medianMsInPlace() sorts the caller's sample instead
+// of a copy, so a HUD can reuse one buffer across rebuilds.
+inline int medianMsInPlace(std::vector<int>& laps) {
     if (laps.empty()) return 0;
     std::sort(laps.begin(), laps.end());
     size_t mid = laps.size() / 2;
     if (laps.size() % 2 == 1) return laps[mid];
     return static_cast<int>((static_cast<long long>(laps[mid - 1]) + laps[mid]) / 2);
 }
+inline int medianMs(std::vector<int> laps) { return medianMsInPlace(laps); }
 
 // Whether a lap should be excluded from the pace chart's racing-pace band.
 // The opening lap (index 0) is always an outlier (standing start), as is any lap
@@ -276,7 +279,8 @@ inline void formatSecs(char* buf, size_t n, long long ms, bool showSign) {
     }
 }
 
-inline AxisRange robustRange(std::vector<long long> vals, double k = 1.5) {
+// robustRangeInPlace() sorts the caller's sample (see medianMsInPlace()).
+inline AxisRange robustRangeInPlace(std::vector<long long>& vals, double k = 1.5) {
     AxisRange r;
     if (vals.empty()) return r;
     std::sort(vals.begin(), vals.end());
@@ -294,5 +298,166 @@ inline AxisRange robustRange(std::vector<long long> vals, double k = 1.5) {
     r.valid = true;
     return r;
 }
+inline AxisRange robustRange(std::vector<long long> vals, double k = 1.5) {
+    return robustRangeInPlace(vals, k);
+}
+
+// Min/max bucket decimation (M4) of one unbroken polyline, for drawing at display
+// resolution. Points are bucketed by pixel column, floor((x - x0) * pxPerUnit);
+// from each column only its first, lowest, highest and last point are kept, in
+// their original order. A line through the kept points covers the same vertical
+// extent in every column and enters and leaves it at the same places, so it
+// rasterizes the same as the full polyline, while the point count is capped at
+// 4 per column however long the series grows. A column of one or two points
+// keeps them all, so a chart with less than a lap per pixel is unchanged.
+// x must be non-decreasing (lap order). Writes the kept indices into `keep`.
+inline void decimateMinMax(const float* xs, const float* ys, size_t count,
+                           float x0, float pxPerUnit, std::vector<size_t>& keep) {
+    keep.clear();
+    size_t start = 0;
+    while (start < count) {
+        const long long column = static_cast<long long>(std::floor((xs[start] - x0) * pxPerUnit));
+        size_t end = start + 1;
+        size_t lo = start, hi = start;
+        while (end < count && static_cast<long long>(std::floor((xs[end] - x0) * pxPerUnit)) == column) {
+            if (ys[end] < ys[lo]) lo = end;
+            if (ys[end] > ys[hi]) hi = end;
+            ++end;
+        }
+        const size_t last = end - 1;
+        size_t picks[4] = { start, std::min(lo, hi), std::max(lo, hi), last };
+        for (size_t idx : picks) {
+            if (keep.empty() || keep.back() < idx) keep.push_back(idx);
+        }
+        start = end;
+    }
+}
+
+// The whole field's series, kept incrementally: riders get a slot once and their
+// completed laps are appended oldest-first as they come in. Appending lap l of a
+// rider touches column l only — the rider's cumulative time and best-lap-so-far
+// up to l are final once the lap is in, and the positions and gaps at lap l
+// depend only on the riders that have completed lap l. Each column is kept
+// sorted by (ranking basis, raceNum), so an append is a binary-search insert plus
+// a re-number of the riders it passes: O(riders at that lap), not the riders x
+// laps of a full recompute. The result is exactly what cumulative(),
+// bestLapSoFar(), positionsPerLap(), gapToLeaderPerLap() and leaderIndex() give
+// for the same laps (see test_session_charts_math.cpp).
+class FieldSeries {
+public:
+    struct Rider {
+        int raceNum = 0;
+        std::vector<int> lapMs;              // oldest-first
+        std::vector<char> lapValid;          // parallel to lapMs (1=valid)
+        std::vector<long long> cumulative;   // race time after each lap
+        std::vector<long long> rank;         // ranking basis: cumulative (race) or best lap so far
+        std::vector<int> positions;          // 1-based, per lap
+        std::vector<long long> gaps;         // ms behind the lap's leader
+    };
+
+    // Drop every rider. lapCapacity is reserved per rider slot so appends don't
+    // reallocate within a session.
+    void reset(bool isRace, size_t lapCapacity) {
+        m_riders.clear();
+        m_columns.clear();
+        m_isRace = isRace;
+        m_lapCapacity = lapCapacity;
+    }
+
+    // Slot of raceNum, adding an empty rider if it has none yet.
+    int addRider(int raceNum) {
+        int slot = slotOf(raceNum);
+        if (slot >= 0) return slot;
+        Rider r;
+        r.raceNum = raceNum;
+        r.lapMs.reserve(m_lapCapacity);
+        r.lapValid.reserve(m_lapCapacity);
+        r.cumulative.reserve(m_lapCapacity);
+        r.rank.reserve(m_lapCapacity);
+        r.positions.reserve(m_lapCapacity);
+        r.gaps.reserve(m_lapCapacity);
+        m_riders.push_back(std::move(r));
+        return static_cast<int>(m_riders.size()) - 1;
+    }
+
+    int slotOf(int raceNum) const {
+        for (size_t i = 0; i < m_riders.size(); ++i) {
+            if (m_riders[i].raceNum == raceNum) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Append the rider's next completed lap and update that lap's column.
+    void appendLap(int slot, int lapMs, bool valid) {
+        Rider& r = m_riders[slot];
+        const size_t lap = r.lapMs.size();
+        r.lapMs.push_back(lapMs);
+        r.lapValid.push_back(valid ? 1 : 0);
+        r.cumulative.push_back((lap > 0 ? r.cumulative.back() : 0) + lapMs);
+        if (m_isRace) {
+            r.rank.push_back(r.cumulative.back());
+        } else {
+            const long long best = (lap > 0) ? r.rank.back() : kNoValidLap;
+            r.rank.push_back((valid && lapMs < best) ? lapMs : best);
+        }
+        r.positions.push_back(0);
+        r.gaps.push_back(0);
+
+        if (m_columns.size() <= lap) {
+            m_columns.emplace_back();
+            m_columns.back().reserve(m_riders.size());
+        }
+        std::vector<Entry>& column = m_columns[lap];
+        const Entry e{ r.rank.back(), r.raceNum, slot };
+        auto it = std::lower_bound(column.begin(), column.end(), e, [](const Entry& a, const Entry& b) {
+            if (a.value != b.value) return a.value < b.value;
+            return a.raceNum < b.raceNum;
+        });
+        const size_t at = static_cast<size_t>(it - column.begin());
+        column.insert(it, e);
+        for (size_t k = at; k < column.size(); ++k) {
+            m_riders[column[k].slot].positions[lap] = static_cast<int>(k) + 1;
+        }
+        const long long leader = column.front().value;
+        if (at == 0) {
+            for (const Entry& c : column) m_riders[c.slot].gaps[lap] = c.value - leader;
+        } else {
+            r.gaps[lap] = e.value - leader;
+        }
+    }
+
+    const Rider& rider(int slot) const { return m_riders[slot]; }
+    size_t riderCount() const { return m_riders.size(); }
+    bool isRace() const { return m_isRace; }
+    int maxLap() const { return static_cast<int>(m_columns.size()); }
+
+    // leaderIndex() over the slots: most laps, then lowest cumulative, then lowest
+    // raceNum — in a race that is the head of the deepest column. -1 off-race or
+    // before any lap.
+    int leaderSlot() const {
+        if (!m_isRace || m_columns.empty()) return -1;
+        return m_columns.back().front().slot;
+    }
+
+    // referencePaceMs() of the race leader (0 without one).
+    long long refPaceMs() const {
+        const int leader = leaderSlot();
+        if (leader < 0) return 0;
+        const Rider& r = m_riders[leader];
+        return referencePaceMs(r.cumulative.back(), static_cast<int>(r.cumulative.size()));
+    }
+
+private:
+    struct Entry {
+        long long value;
+        int raceNum;
+        int slot;
+    };
+
+    std::vector<Rider> m_riders;
+    std::vector<std::vector<Entry>> m_columns;   // per lap, sorted by (value, raceNum)
+    bool m_isRace = false;
+    size_t m_lapCapacity = 0;
+};
 
 } // namespace SessionChartsMath
@@ -624,7 +624,7 @@ void StandingsHud::rebuildRenderData() {
                 // Non-race: show best lap time (right-aligned like numeric gaps)
                 if (entry.bestLap > 0) {
                     char tmp[16];
-                    PluginUtils::formatLapTime(entry.bestLap, tmp, sizeof(tmp));
+                    m_timeFormat.formatLapTime(entry.bestLap, tmp, sizeof(tmp));
                     snprintf(entry.formattedGap, sizeof(entry.formattedGap), "%s", tmp);
                 } else {
                     strcpy_s(entry.formattedGap, sizeof(entry.formattedGap), Placeholders::GENERIC);
@@ -633,11 +633,11 @@ void StandingsHud::rebuildRenderData() {
                 // Race finished: show finish time (right-aligned like numeric gaps)
                 if (effectiveGapRef == GapReferenceMode::LEADER && leaderFinishTime > 0) {
                     char tmp[16];
-                    PluginUtils::formatLapTime(leaderFinishTime, tmp, sizeof(tmp));
+                    m_timeFormat.formatLapTime(leaderFinishTime, tmp, sizeof(tmp));
                     snprintf(entry.formattedGap, sizeof(entry.formattedGap), "%s", tmp);
                 } else if (effectiveGapRef == GapReferenceMode::PLAYER && playerStanding && playerStanding->finishTime > 0) {
                     char tmp[16];
-                    PluginUtils::formatLapTime(playerStanding->finishTime, tmp, sizeof(tmp));
+                    m_timeFormat.formatLapTime(playerStanding->finishTime, tmp, sizeof(tmp));
                     snprintf(entry.formattedGap, sizeof(entry.formattedGap), "%s", tmp);
                 } else {
                     entry.gapStyle = DisplayEntry::GapStyle::LABEL;
@@ -683,7 +683,7 @@ void StandingsHud::rebuildRenderData() {
                     // Player has no lap time yet — show absolute best lap times as fallback
                     if (entry.bestLap > 0) {
                         char tmp[16];
-                        PluginUtils::formatLapTime(entry.bestLap, tmp, sizeof(tmp));
+                        m_timeFormat.formatLapTime(entry.bestLap, tmp, sizeof(tmp));
                         snprintf(entry.formattedGap, sizeof(entry.formattedGap), "%s", tmp);
                     } else {
                         strcpy_s(entry.formattedGap, sizeof(entry.formattedGap), Placeholders::GENERIC);
@@ -693,7 +693,7 @@ void StandingsHud::rebuildRenderData() {
                     if (canUseLiveForRider && (playerLiveGap > 0 || playerIsLeader) &&
                                (entry.realTimeGap > 0 || entry.position == Position::FIRST)) {
                         int relativeGap = entry.realTimeGap - playerLiveGap;
-                        PluginUtils::formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), relativeGap);
+                        m_timeFormat.formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), relativeGap);
                         entry.gapStyle = DisplayEntry::GapStyle::LIVE;
                     } else if (entry.officialGap > 0 || entry.gapLaps > 0 || entry.position == Position::FIRST) {
                         int relativeLapGap = entry.gapLaps - playerGapLaps;
@@ -701,7 +701,7 @@ void StandingsHud::rebuildRenderData() {
                         if (relativeLapGap != 0) {
                             snprintf(entry.formattedGap, sizeof(entry.formattedGap), "%+dL", relativeLapGap);
                         } else if (relativeTimeGap != 0) {
-                            PluginUtils::formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), relativeTimeGap);
+                            m_timeFormat.formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), relativeTimeGap);
                         } else {
                             strcpy_s(entry.formattedGap, sizeof(entry.formattedGap), Placeholders::GENERIC);
                         }
@@ -711,12 +711,12 @@ void StandingsHud::rebuildRenderData() {
                 } else {
                     // Leader-relative gaps
                     if (canUseLiveForRider) {
-                        PluginUtils::formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), entry.realTimeGap);
+                        m_timeFormat.formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), entry.realTimeGap);
                         entry.gapStyle = DisplayEntry::GapStyle::LIVE;
                     } else if (isLapped) {
                         snprintf(entry.formattedGap, sizeof(entry.formattedGap), "+%dL", entry.gapLaps);
                     } else if (entry.officialGap > 0) {
-                        PluginUtils::formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), entry.officialGap);
+                        m_timeFormat.formatTimeDiff(entry.formattedGap, sizeof(entry.formattedGap), entry.officialGap);
                     } else {
                         strcpy_s(entry.formattedGap, sizeof(entry.formattedGap), Placeholders::GENERIC);
                     }
@@ -736,7 +736,7 @@ void StandingsHud::rebuildRenderData() {
 
         // Format best lap time
         if (entry.hasBestLap) {
-            PluginUtils::formatLapTime(entry.bestLap, entry.formattedLapTime, sizeof(entry.formattedLapTime));
+            m_timeFormat.formatLapTime(entry.bestLap, entry.formattedLapTime, sizeof(entry.formattedLapTime));
         }
         else {
             strcpy_s(entry.formattedLapTime, sizeof(entry.formattedLapTime), Placeholders::LAP_TIME);
@@ -744,7 +744,7 @@ void StandingsHud::rebuildRenderData() {
 
         // Format last lap time (cuts included; 0/none -> placeholder)
         if (entry.hasLastLap) {
-            PluginUtils::formatLapTime(entry.lastLap, entry.formattedLastLap, sizeof(entry.formattedLastLap));
+            m_timeFormat.formatLapTime(entry.lastLap, entry.formattedLastLap, sizeof(entry.formattedLastLap));
         }
         else {
             strcpy_s(entry.formattedLastLap, sizeof(entry.formattedLastLap), Placeholders::LAP_TIME);
@@ -1126,8 +1126,7 @@ void StandingsHud::resetToDefaults() {
     m_bShowSessionInfo = true;
     m_bLiveGaps = false;
     m_activeAnimations.clear();
-    m_previousPositions.clear();
-    m_previousSlots.clear();
+    m_previousPlacements.clear();
     m_cachedIconStates.clear();
     setDataDirty();
 }
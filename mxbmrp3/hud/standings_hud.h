@@ -5,6 +5,7 @@
 #pragma once
 
 #include "base_hud.h"
+#include "../core/plugin_utils.h"
 #include "../core/plugin_data.h"
 #include "../core/plugin_constants.h"
 #include "../core/widget_constants.h"
@@ -294,6 +295,9 @@ private:
     // Each entry encodes: raceNum -> (hazardType | blueFlagged | inPit | lastLap | directorLock)
     std::unordered_map<int, uint8_t> m_cachedIconStates;
 
+    // Memoized lap-time/gap formatting for this HUD's cells (see PluginUtils::TimeFormatMemo)
+    PluginUtils::TimeFormatMemo m_timeFormat;
+
     // Cached icon sprite indices (avoid string-based map lookups per rider per frame)
     struct CachedIcons {
         int circleExclamation = 0;
@@ -371,8 +375,16 @@ private:
         std::chrono::steady_clock::time_point startTime;
     };
     std::unordered_map<int, RowAnimation> m_activeAnimations;  // raceNum -> active animation
-    std::unordered_map<int, int> m_previousPositions;           // raceNum -> last known race position
-    std::unordered_map<int, int> m_previousSlots;               // raceNum -> last known display slot (visibility check)
+    // Last rebuild's visible riders (race position + display slot), sorted by
+    // raceNum. Flat vectors swapped each rebuild, so the steady state allocates nothing.
+    struct RowPlacement {
+        int raceNum;
+        int position;       // Race position
+        int slot;           // Display slot (visibility check)
+        bool operator<(const RowPlacement& o) const { return raceNum < o.raceNum; }
+    };
+    std::vector<RowPlacement> m_previousPlacements;
+    std::vector<RowPlacement> m_currentPlacements;              // Scratch for updateAnimationState
     std::chrono::steady_clock::time_point m_frameTime = std::chrono::steady_clock::now();
 
     float m_animationDurationMs = 500.0f;  // Duration of position slide animation (configurable 50-1000)
@@ -392,7 +404,7 @@ private:
     // highlight cross-fades against it (1.0 - fade) so the row stays visually solid.
     float getSlideFade(int raceNum) const;
 
-    // Start animations for any riders whose position changed, update m_previousPositions
+    // Start animations for any riders whose position changed, update m_previousPlacements
     void updateAnimationState();
 
     // Returns true if any animations are still in progress
@@ -52,61 +52,53 @@ float StandingsHud::getSlideFade(int raceNum) const {
 
 void StandingsHud::updateAnimationState() {
     if (m_animationMode == AnimationMode::OFF) {
-        m_previousPositions.clear();
-        m_previousSlots.clear();
+        m_previousPlacements.clear();
         m_activeAnimations.clear();
         return;
     }
 
     auto now = std::chrono::steady_clock::now();
 
-    // Build current maps: raceNum -> race position, raceNum -> display slot index
-    std::unordered_map<int, int> currentPositions;
-    std::unordered_map<int, int> currentSlots;
+    // Build current placements: raceNum -> race position + display slot index
+    m_currentPlacements.clear();
     for (int i = 0; i < static_cast<int>(m_displayEntries.size()); ++i) {
         const auto& entry = m_displayEntries[i];
         if (!entry.isPlaceholder && entry.raceNum >= 0) {
-            currentPositions[entry.raceNum] = entry.position;
-            currentSlots[entry.raceNum] = i;
+            m_currentPlacements.push_back({ entry.raceNum, entry.position, i });
         }
     }
+    std::sort(m_currentPlacements.begin(), m_currentPlacements.end());
 
     // Detect race position changes (not display slot changes from window scrolling)
     int maxSlot = static_cast<int>(m_displayEntries.size()) - 1;
-    for (const auto& [raceNum, currentPos] : currentPositions) {
-        auto prevIt = m_previousPositions.find(raceNum);
-        if (prevIt != m_previousPositions.end() && prevIt->second != currentPos) {
-            // Only animate riders that were also visible in the previous frame
-            auto prevSlotIt = m_previousSlots.find(raceNum);
-            if (prevSlotIt == m_previousSlots.end()) continue;
-
-            auto slotIt = currentSlots.find(raceNum);
-            if (slotIt != currentSlots.end()) {
-                int currentSlot = slotIt->second;
-                // Estimate the previous slot from the race-position delta instead of
-                // reading m_previousSlots directly. m_previousSlots tracks the actual
-                // slot occupied last frame, but the visible window can scroll
-                // independently (DNS filter changes, top-N pinning, spectator switch),
-                // and using the raw previous slot would inflate the slide distance
-                // when only the window moved. Posing the delta in race-position space
-                // produces the correct visual move for pure overtakes, and degrades
-                // gracefully when both an overtake and a window shift happen in the
-                // same frame.
-                int posDelta = prevIt->second - currentPos;  // positive = moved up
-                int estimatedPrevSlot = currentSlot + posDelta;
-                // Clamp to visible range so animations never start from far off-screen
-                estimatedPrevSlot = std::max(-1, std::min(estimatedPrevSlot, maxSlot + 1));
-                m_activeAnimations[raceNum] = { estimatedPrevSlot, currentSlot, now };
-            }
-        }
+    for (const RowPlacement& current : m_currentPlacements) {
+        // Only animate riders that were also visible in the previous frame
+        auto prevIt = std::lower_bound(m_previousPlacements.begin(), m_previousPlacements.end(), current);
+        if (prevIt == m_previousPlacements.end() || prevIt->raceNum != current.raceNum) continue;
+        if (prevIt->position == current.position) continue;
+
+        int currentSlot = current.slot;
+        // Estimate the previous slot from the race-position delta instead of
+        // reading the previous slot directly. That tracks the actual slot
+        // occupied last frame, but the visible window can scroll
+        // independently (DNS filter changes, top-N pinning, spectator switch),
+        // and using the raw previous slot would inflate the slide distance
+        // when only the window moved. Posing the delta in race-position space
+        // produces the correct visual move for pure overtakes, and degrades
+        // gracefully when both an overtake and a window shift happen in the
+        // same frame.
+        int posDelta = prevIt->position - current.position;  // positive = moved up
+        int estimatedPrevSlot = currentSlot + posDelta;
+        // Clamp to visible range so animations never start from far off-screen
+        estimatedPrevSlot = std::max(-1, std::min(estimatedPrevSlot, maxSlot + 1));
+        m_activeAnimations[current.raceNum] = { estimatedPrevSlot, currentSlot, now };
     }
 
     // Note: cleanup of finished animations happens in update(), not here.
     // This method only runs on data change; cleanup must run every frame.
 
     // Update previous positions and slots for next comparison
-    m_previousPositions = std::move(currentPositions);
-    m_previousSlots = std::move(currentSlots);
+    m_previousPlacements.swap(m_currentPlacements);
 }
 
 bool StandingsHud::hasActiveAnimations() const {
@@ -288,176 +288,53 @@ void TelemetryHud::addCombinedInputGraph(const HistoryBuffers& history, const Bi
     // input% labels — the shared strip-chart frame.
     addStripChartFrame(x, y, width, height, "100%", "50%", "0%", dims);
 
-    // Draw input histories as line graphs (only enabled inputs)
-    struct InputLine {
-        const std::deque<float>& data;
-        unsigned long color;
-        const char* label;
-    };
-
-    // Match performance graph logic: spacing based on max history, not current size
-    float pointSpacing = width / (HistoryBuffers::MAX_TELEMETRY_HISTORY - 1);
+    // Draw input histories as line graphs (only enabled inputs). Spacing is based
+    // on max history, not current size (matches the performance graph).
+    const size_t maxHistory = HistoryBuffers::MAX_TELEMETRY_HISTORY;
     float lineThickness = stripChartLineThickness();  // Line thickness for graph rendering
 
-    // PERFORMANCE OPTIMIZATION: Merge 4 separate loops into single pass
-    // Previous: 4 × O(199) = 796 iterations per frame
-    // New: 1 × O(199) = 199 iterations per frame (75% reduction)
-    // At 144 fps: reduces 114,624 iterations/sec to 28,656 iterations/sec
-    //
-    // Render inputs in order within each iteration: brake, clutch, RPM, then throttle
-    // This maintains the visual appearance (throttle appears on top) while reducing iterations
-    for (size_t i = 0; i < HistoryBuffers::MAX_TELEMETRY_HISTORY - 1; ++i) {
-        // Front brake graph (always available - available for player and spectated riders)
-        if (m_enabledElements & ELEM_FRONT_BRAKE) {
-            const std::deque<float>& data = history.frontBrake;
-            if (i < data.size() && (i + 1) < data.size()) {
-                // Offset so newest data is always at right edge
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::FRONT_BRAKE, lineThickness);
-                }
-            }
-        }
-
-        // Rear brake graph (only available when ON_TRACK, not in spectate/replay)
-        if ((m_enabledElements & ELEM_REAR_BRAKE) && hasFullTelemetry) {
-            const std::deque<float>& data = history.rearBrake;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::REAR_BRAKE, lineThickness);
-                }
-            }
-        }
-
-        // Clutch graph (only available when ON_TRACK, not in spectate/replay)
-        if ((m_enabledElements & ELEM_CLUTCH) && hasFullTelemetry) {
-            const std::deque<float>& data = history.clutch;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::CLUTCH, lineThickness);
-                }
-            }
-        }
+    // Render inputs in order: brake, clutch, RPM, suspension, gear, then throttle,
+    // so throttle is drawn on top. Each trace is one batched polyline per run.
 
-        // RPM graph
-        if (m_enabledElements & ELEM_RPM) {
-            const std::deque<float>& data = history.rpm;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, ColorPalette::GRAY, lineThickness);
-                }
-            }
-        }
-
-        // Front suspension graph (only available when ON_TRACK, not in spectate/replay)
-        if ((m_enabledElements & ELEM_FRONT_SUSP) && hasFullTelemetry && bikeTelemetry.frontSuspMaxTravel > 0) {
-            const std::deque<float>& data = history.frontSusp;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::FRONT_SUSP, lineThickness);
-                }
-            }
-        }
-
-        // Rear suspension graph (only available when ON_TRACK, not in spectate/replay)
-        if ((m_enabledElements & ELEM_REAR_SUSP) && hasFullTelemetry && bikeTelemetry.rearSuspMaxTravel > 0) {
-            const std::deque<float>& data = history.rearSusp;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::REAR_SUSP, lineThickness);
-                }
-            }
-        }
-
-        // Gear graph (always available)
-        if (m_enabledElements & ELEM_GEAR) {
-            const std::deque<float>& data = history.gear;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                // Render even at 0 (neutral) for gear
-                float y1 = y + height - (value1 * height);
-                float y2 = y + height - (value2 * height);
-                addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::GEAR, lineThickness);
-            }
-        }
-
-        // Throttle graph (rendered last within each iteration so it appears on top)
-        if (m_enabledElements & ELEM_THROTTLE) {
-            const std::deque<float>& data = history.throttle;
-            if (i < data.size() && (i + 1) < data.size()) {
-                size_t offset = HistoryBuffers::MAX_TELEMETRY_HISTORY - data.size();
-                float x1 = x + (offset + i) * pointSpacing;
-                float x2 = x + (offset + i + 1) * pointSpacing;
-
-                float value1 = std::max(0.0f, std::min(1.0f, data[i]));
-                float value2 = std::max(0.0f, std::min(1.0f, data[i + 1]));
-
-                if (value1 >= 0.01f || value2 >= 0.01f) {
-                    float y1 = y + height - (value1 * height);
-                    float y2 = y + height - (value2 * height);
-                    addLineSegment(x1, y1, x2, y2, PluginConstants::SemanticColors::THROTTLE, lineThickness);
-                }
-            }
-        }
+    // Front brake graph (always available - available for player and spectated riders)
+    if (m_enabledElements & ELEM_FRONT_BRAKE) {
+        addStripChartHistoryLine(history.frontBrake, PluginConstants::SemanticColors::FRONT_BRAKE,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // Rear brake graph (only available when ON_TRACK, not in spectate/replay)
+    if ((m_enabledElements & ELEM_REAR_BRAKE) && hasFullTelemetry) {
+        addStripChartHistoryLine(history.rearBrake, PluginConstants::SemanticColors::REAR_BRAKE,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // Clutch graph (only available when ON_TRACK, not in spectate/replay)
+    if ((m_enabledElements & ELEM_CLUTCH) && hasFullTelemetry) {
+        addStripChartHistoryLine(history.clutch, PluginConstants::SemanticColors::CLUTCH,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // RPM graph
+    if (m_enabledElements & ELEM_RPM) {
+        addStripChartHistoryLine(history.rpm, ColorPalette::GRAY,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // Front suspension graph (only available when ON_TRACK, not in spectate/replay)
+    if ((m_enabledElements & ELEM_FRONT_SUSP) && hasFullTelemetry && bikeTelemetry.frontSuspMaxTravel > 0) {
+        addStripChartHistoryLine(history.frontSusp, PluginConstants::SemanticColors::FRONT_SUSP,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // Rear suspension graph (only available when ON_TRACK, not in spectate/replay)
+    if ((m_enabledElements & ELEM_REAR_SUSP) && hasFullTelemetry && bikeTelemetry.rearSuspMaxTravel > 0) {
+        addStripChartHistoryLine(history.rearSusp, PluginConstants::SemanticColors::REAR_SUSP,
+                                 x, y, width, height, lineThickness, maxHistory);
+    }
+    // Gear graph (always available; rendered even at 0 = neutral)
+    if (m_enabledElements & ELEM_GEAR) {
+        addStripChartHistoryLine(history.gear, PluginConstants::SemanticColors::GEAR,
+                                 x, y, width, height, lineThickness, maxHistory, /*skipIdle=*/false);
+    }
+    // Throttle graph (rendered last so it appears on top)
+    if (m_enabledElements & ELEM_THROTTLE) {
+        addStripChartHistoryLine(history.throttle, PluginConstants::SemanticColors::THROTTLE,
+                                 x, y, width, height, lineThickness, maxHistory);
     }
 }
 
@@ -525,17 +525,17 @@ void TimingHud::rebuildRenderData() {
         strcpy_s(timeBuffer, sizeof(timeBuffer), "INVALID");
     } else if (m_isFrozen) {
         if (m_officialData.time > 0) {
-            PluginUtils::formatLapTime(m_officialData.time, timeBuffer, sizeof(timeBuffer));
+            m_timeFormat.formatLapTime(m_officialData.time, timeBuffer, sizeof(timeBuffer));
         } else {
             strcpy_s(timeBuffer, sizeof(timeBuffer), Placeholders::LAP_TIME);
             timePlaceholder = true;
         }
     } else if (riderFinished && riderFinishTime > 0) {
-        PluginUtils::formatLapTime(riderFinishTime, timeBuffer, sizeof(timeBuffer));
+        m_timeFormat.formatLapTime(riderFinishTime, timeBuffer, sizeof(timeBuffer));
     } else {
         int elapsed = pluginData.getElapsedLapTime();
         if (elapsed >= 0) {
-            PluginUtils::formatLapTime(elapsed, timeBuffer, sizeof(timeBuffer));
+            m_timeFormat.formatLapTime(elapsed, timeBuffer, sizeof(timeBuffer));
         } else {
             strcpy_s(timeBuffer, sizeof(timeBuffer), Placeholders::LAP_TIME);
             timePlaceholder = true;
@@ -549,7 +549,7 @@ void TimingHud::rebuildRenderData() {
         if (segShowFrozen) {
             // Frozen just-completed boundary: the running total from the chain start
             // (or the isolated arc off a clean run) and its cumulative delta-to-best.
-            PluginUtils::formatLapTime(static_cast<int>(seg.cum.lastTime * 1000.0f + 0.5f),
+            m_timeFormat.formatLapTime(static_cast<int>(seg.cum.lastTime * 1000.0f + 0.5f),
                                        timeBuffer, sizeof(timeBuffer));
             timePlaceholder = false;
             if (seg.cum.lastHasDelta) {
@@ -568,7 +568,7 @@ void TimingHud::rebuildRenderData() {
                 std::chrono::steady_clock::now() - seg.runStart).count();
             double shownSec = seg.cum.active ? (static_cast<double>(seg.cum.time) + liveArcSec)
                                              : liveArcSec;
-            PluginUtils::formatLapTime(static_cast<int>(shownSec * 1000.0 + 0.5),
+            m_timeFormat.formatLapTime(static_cast<int>(shownSec * 1000.0 + 0.5),
                                        timeBuffer, sizeof(timeBuffer));
             timePlaceholder = false;
             segGap.reset();
@@ -612,13 +612,13 @@ void TimingHud::rebuildRenderData() {
         RowValue out;
         const GapData* gapData = getGapDataForType(type);
         if (showGapData && gapData && gapData->hasGap) {
-            PluginUtils::formatTimeDiff(out.value, sizeof(out.value), gapData->gap);
+            m_timeFormat.formatTimeDiff(out.value, sizeof(out.value), gapData->gap);
             out.isFaster = gapData->isFaster;
             out.isSlower = gapData->isSlower;
         } else {
             int refTime = cumulativeReferenceMs(type, targetSplit);
             if (refTime > 0) {
-                PluginUtils::formatLapTime(refTime, out.value, sizeof(out.value));
+                m_timeFormat.formatLapTime(refTime, out.value, sizeof(out.value));
                 out.isReference = true;
             } else {
                 const char* missing = (type == GAP_TO_RECORD) ? Placeholders::NOT_AVAILABLE : Placeholders::GENERIC;
@@ -642,11 +642,11 @@ void TimingHud::rebuildRenderData() {
         // A custom segment has only its own session best, shown as a single "Best" row.
         RowValue segRow;
         if (showGapData && segGap.hasGap) {
-            PluginUtils::formatTimeDiff(segRow.value, sizeof(segRow.value), segGap.gap);
+            m_timeFormat.formatTimeDiff(segRow.value, sizeof(segRow.value), segGap.gap);
             segRow.isFaster = segGap.isFaster;
             segRow.isSlower = segGap.isSlower;
         } else if (segRefBestMs > 0) {
-            PluginUtils::formatLapTime(segRefBestMs, segRow.value, sizeof(segRow.value));
+            m_timeFormat.formatLapTime(segRefBestMs, segRow.value, sizeof(segRow.value));
             segRow.isReference = true;
         } else {
             strcpy_s(segRow.value, sizeof(segRow.value), Placeholders::GENERIC);
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "base_hud.h"
+#include "../core/plugin_utils.h"
 #include "../core/ui_config.h"  // For PBScope enum
 #include "../core/plugin_data.h"
 #include "../core/plugin_constants.h"
@@ -261,4 +262,7 @@ private:
     static constexpr int MAX_DURATION_MS = 10000;  // 10 seconds maximum
     static constexpr int DEFAULT_DURATION_MS = 5000;  // 5 seconds default
     static constexpr int DURATION_STEP_MS = 1000;  // 1 second steps
+
+    // Memoized lap-time/gap formatting for this HUD's cells (see PluginUtils::TimeFormatMemo)
+    PluginUtils::TimeFormatMemo m_timeFormat;
 };
@@ -358,16 +358,10 @@ void VersionWidget::renderGame() {
     char scoreText[32];
     snprintf(scoreText, sizeof(scoreText), "L%d  SCORE: %d", m_level, m_score);
 
-    SPluginString_t scoreString;
-    strncpy_s(scoreString.m_szString, sizeof(scoreString.m_szString), scoreText, _TRUNCATE);
-    scoreString.m_afPos[0] = m_gameLeft + 0.01f;
-    scoreString.m_afPos[1] = m_gameTop + 0.01f;
-    scoreString.m_iFont = this->getFont(FontCategory::NORMAL);
-    scoreString.m_fSize = FontSizes::SMALL;
-    scoreString.m_iJustify = Justify::LEFT;
-    scoreString.m_ulColor = this->getColor(ColorSlot::PRIMARY);
-    m_strings.push_back(scoreString);
-    m_stringSkipShadow.push_back(false);  // Game text should have shadows
+    // Absolute game-area positions (no HUD offset), so straight into the arena rather
+    // than through addString(). Game text keeps its drop shadow.
+    m_strings.add(scoreText, m_gameLeft + 0.01f, m_gameTop + 0.01f, Justify::LEFT,
+                  this->getFont(FontCategory::NORMAL), this->getColor(ColorSlot::PRIMARY), FontSizes::SMALL);
 
     // Instructions or game state message
     const char* message = nullptr;
@@ -378,17 +372,9 @@ void VersionWidget::renderGame() {
     }
 
     if (message) {
-        SPluginString_t msgString;
-        strncpy_s(msgString.m_szString, sizeof(msgString.m_szString), message,
-                  sizeof(msgString.m_szString) - 1);
-        msgString.m_afPos[0] = m_gameLeft + GAME_AREA_WIDTH / 2.0f;
-        msgString.m_afPos[1] = m_gameTop + GAME_AREA_HEIGHT - 0.04f;
-        msgString.m_iFont = this->getFont(FontCategory::NORMAL);
-        msgString.m_fSize = FontSizes::NORMAL;
-        msgString.m_iJustify = Justify::CENTER;
-        msgString.m_ulColor = this->getColor(ColorSlot::SECONDARY);
-        m_strings.push_back(msgString);
-        m_stringSkipShadow.push_back(false);  // Game text should have shadows
+        m_strings.add(message, m_gameLeft + GAME_AREA_WIDTH / 2.0f, m_gameTop + GAME_AREA_HEIGHT - 0.04f,
+                      Justify::CENTER, this->getFont(FontCategory::NORMAL),
+                      this->getColor(ColorSlot::SECONDARY), FontSizes::NORMAL);
     }
 
     // Set bounds to game area for potential interaction
@@ -188,17 +188,42 @@ function fmtChartSecs(ms, showSign) {
     return sign + whole + "." + frac + "s";
 }
 function esc(s) { return String(s).replace(/&/g, "&amp;").replace(/</g, "&lt;").replace(/>/g, "&gt;"); }
+// Min/max bucket decimation of one unbroken run of [x, y] px points (port of
+// decimateMinMax() in session_charts_math.h): per pixel column keep the first,
+// lowest, highest and last point, in order, so a long race draws the same line
+// with at most 4 points per column.
+function cmDecimateMinMax(run) {
+    var out = [], start = 0;
+    while (start < run.length) {
+        var col = Math.floor(run[start][0]), end = start + 1, lo = start, hi = start;
+        while (end < run.length && Math.floor(run[end][0]) === col) {
+            if (run[end][1] < run[lo][1]) lo = end;
+            if (run[end][1] > run[hi][1]) hi = end;
+            end++;
+        }
+        var picks = [start, Math.min(lo, hi), Math.max(lo, hi), end - 1];
+        for (var k = 0; k < 4; k++) {
+            if (!out.length || out[out.length - 1] < picks[k]) out.push(picks[k]);
+        }
+        start = end;
+    }
+    return out.map(function (i) { return run[i]; });
+}
 // Emit a rider's polyline as one <polyline> per contiguous run (a run breaks where
-// pts[i] is null — an absent lap). Thicker for the on-camera subject.
+// pts[i] is null — an absent lap), decimated to the SVG's pixel columns. Thicker
+// for the on-camera subject.
 function svgPolyline(pts, color, subject) {
     var w = subject ? 3.0 : 1.8, out = "", run = [];
     function flush() {
-        if (run.length >= 2) out += '<polyline class="chart-line" stroke="' + color + '" stroke-width="' + w + '" points="' + run.join(" ") + '"/>';
+        if (run.length >= 2) {
+            var kept = cmDecimateMinMax(run).map(function (p) { return p[0].toFixed(1) + "," + p[1].toFixed(1); });
+            out += '<polyline class="chart-line" stroke="' + color + '" stroke-width="' + w + '" points="' + kept.join(" ") + '"/>';
+        }
         run = [];
     }
     for (var i = 0; i < pts.length; i++) {
         if (!pts[i]) { flush(); continue; }
-        run.push(pts[i][0].toFixed(1) + "," + pts[i][1].toFixed(1));
+        run.push(pts[i]);
     }
     flush();
     return out;
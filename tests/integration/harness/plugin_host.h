@@ -18,12 +18,14 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <string>
 #include <vector>
 #include <sstream>
 
 #include "plugin_api.h"
 #include "tape.h"
+#include "../../../mxbmrp3/core/tape_map.h"
 #include "nlohmann/json.hpp"
 
 // Unbuffered progress trace (stderr) so a Wine crash still shows how far we got.
@@ -82,6 +84,8 @@ public:
         m_ruChannels    = sym<void(*)(float*,float*,float*,float*,float*,float*,float*,float*,float*,float*,float*,float*)>("MXBMRP3_Test_RumbleChannels");
         m_startRec  = sym<int(*)(const char*)>("MXBMRP3_Test_StartRecording");
         m_stopRec   = sym<void(*)()>("MXBMRP3_Test_StopRecording");
+        m_captureKf = sym<int(*)(uint8_t*, int)>("MXBMRP3_Test_CaptureKeyframe");
+        m_restoreKf = sym<int(*)(const void*, int)>("MXBMRP3_Test_RestoreKeyframe");
         m_resetAll  = sym<void(*)()>("MXBMRP3_Test_ResetAll");
         m_resetActiveProfile = sym<void(*)()>("MXBMRP3_Test_ResetActiveProfile");
         m_resetHud  = sym<void(*)(const char*, int)>("MXBMRP3_Test_ResetHud");
@@ -94,6 +98,7 @@ public:
         m_dirIsLocked = sym<int(*)()>("MXBMRP3_Test_DirectorIsLocked");
         m_dirNextLockedCam = sym<int(*)(int)>("MXBMRP3_Test_DirectorNextLockedCamera");
         m_dirSetNowMs = sym<void(*)(long long)>("MXBMRP3_Test_DirectorSetNowMs");
+        m_motionSetNowUs = sym<void(*)(long long)>("MXBMRP3_Test_RiderMotionSetNowUs");
         m_dirSetStories = sym<void(*)(int)>("MXBMRP3_Test_DirectorSetStories");
         m_eventLogEnableDirector = sym<void(*)(int)>("MXBMRP3_Test_EventLogEnableDirector");
         m_timingConfig = sym<void(*)(int,int,int)>("MXBMRP3_Test_TimingConfig");
@@ -129,6 +134,9 @@ public:
         m_anAppStarted = sym<void(*)(char*, int)>("MXBMRP3_Test_AnalyticsAppStarted");
         m_anSessionEnd = sym<void(*)()>("MXBMRP3_Test_AnalyticsQueueSessionEnd");
         m_anCustom     = sym<void(*)(const char*)>("MXBMRP3_Test_AnalyticsQueueCustom");
+        m_showAllHuds  = sym<void(*)(int)>("MXBMRP3_Test_ShowAllHuds");
+        m_allocCounting = sym<int(*)()>("MXBMRP3_Test_AllocCounting");
+        m_allocThreadCounts = sym<int(*)(long long*, long long*, int)>("MXBMRP3_Test_AllocThreadCounts");
         m_anSeedCrash  = sym<void(*)(const char*, const char*, const char*)>("MXBMRP3_Test_AnalyticsSeedCrash");
         m_anDrain      = sym<int(*)(char*, int)>("MXBMRP3_Test_AnalyticsDrainPending");
         m_extractInstall = sym<int(*)(const char*, const char*, int, char*, int)>("MXBMRP3_Test_ExtractAndInstall");
@@ -197,9 +205,10 @@ public:
     // --- driving the game callbacks -----------------------------------------
     void eventInit(const char* trackName, const char* riderName,
                    float trackLength = 1600.0f, int type = 2,
-                   const char* bikeName = "Test 450") {
+                   const char* bikeName = "Test 450", const char* trackId = "") {
         SPluginsBikeEvent_t ev{};
         setStr(ev.m_szRiderName, riderName);
+        setStr(ev.m_szTrackID, trackId);   // empty by default: keys nothing (stats, track cache)
         setStr(ev.m_szBikeName, bikeName);
         setStr(ev.m_szCategory, "MX1");
         setStr(ev.m_szTrackName, trackName);
@@ -363,7 +372,14 @@ public:
         int nq = 0, ns = 0; void* q = nullptr; void* s = nullptr;
         m_draw(1, &nq, &q, &ns, &s);
         m_lastGameQuads = nq; m_lastGameStrings = ns;   // what draw() EMITTED to the game
+        if (m_drawObserver) m_drawObserver(m_lastReplayTimeMs, nq, q, ns, s);
     }
+    // Observe every draw()'s output arrays (SPluginQuad_t / SPluginString_t as the
+    // game would receive them; valid only for the duration of the call) together
+    // with the replay sim time (ms) it was drawn at. Used by the offline renderer's
+    // frame exporter (tools/mxbmrp3_render/frame_dump.cpp). Pass {} to detach.
+    using DrawObserver = std::function<void(long long simMs, int nq, const void* q, int ns, const void* s)>;
+    void setDrawObserver(DrawObserver fn) { m_drawObserver = std::move(fn); }
     // Quad/string counts the last draw() emitted to the game surface (0 when the
     // in-game HUD is suppressed in COMPANION mode). Distinct from the raw game
     // frame in getGameQuads() (which is always the full frame).
@@ -421,7 +437,7 @@ public:
     }
 
     // --- replay a recorded callback tape ------------------------------------
-    // Read a MXBHREC tape (the recorder format) and dispatch each recorded
+    // Map a MXBHREC tape (the recorder format, v1 or v2; core/tape_map.h) and dispatch each recorded
     // callback into the plugin's real exports — the same events the game sent,
     // headless. Handles the snapshot-affecting inputs (event/session/entries/
     // classification/lap/track-position/communication/session-state/draw) plus
@@ -430,22 +446,19 @@ public:
     // yourself first (Startup in the tape, if any, is ignored). Returns the count
     // of events applied, or -1 if the file is missing/not a tape.
     int replayTape(const std::string& path) {
-        FILE* f = fopen(path.c_str(), "rb");
-        if (!f) { HOST_TRACE("replayTape: cannot open %s", path.c_str()); return -1; }
-        tape::FileHeader fh{};
-        if (fread(&fh, sizeof(fh), 1, f) != 1 || std::memcmp(fh.magic, "MXBHREC", 7) != 0) {
-            HOST_TRACE("replayTape: %s is not a MXBHREC tape", path.c_str());
-            fclose(f); return -1;
+        tape_io::MappedTape reader;
+        if (!reader.open(path.c_str())) {
+            HOST_TRACE("replayTape: %s is missing or not a MXBHREC v1/v2 tape", path.c_str());
+            return -1;
         }
         int applied = 0;
-        tape::EventHeader eh{};
+        tape_io::EventFrame ev{};
+        const uint8_t* payload = nullptr;
         std::vector<uint8_t> buf;
-        while (fread(&eh, sizeof(eh), 1, f) == 1) {
-            buf.resize(eh.dataSize);
-            if (eh.dataSize && fread(buf.data(), 1, eh.dataSize, f) != eh.dataSize) break;
-            if (dispatch(static_cast<tape::EventType>(eh.eventType), buf)) ++applied;
+        while (reader.next(ev, payload)) {
+            buf.assign(payload, payload + ev.dataSize);   // aligned copy (mapped payloads aren't) for the struct casts
+            if (dispatch(static_cast<tape::EventType>(ev.eventType), buf)) ++applied;
         }
-        fclose(f);
         return applied;
     }
 
@@ -456,7 +469,10 @@ public:
     // recorded cadence instead of collapsing into the few real milliseconds a naive
     // replay takes. The director must be enabled and the draw-state spectating first
     // (see the test). Each cut it makes is logged by cutTo(); parse the plugin log to
-    // reconstruct the broadcast. Restores the real clock on exit. Returns events applied.
+    // reconstruct the broadcast. The rider-motion clock (MXBMRP3_Test_RiderMotionSetNowUs)
+    // follows the same sim time, so position batches are stamped and markers
+    // dead-reckoned at their recorded times. Restores the real clocks on exit.
+    // Returns events applied.
     // drawTickMs > 0 interleaves synthetic Draw() calls at that sim-time cadence
     // between recorded events. The real plugin pumps Draw every frame (which drives
     // the director's per-frame pacing pump, pollPacing), but a slimmed tape often
@@ -466,43 +482,155 @@ public:
     // 100 (10 Hz) for a broadcast-faithful replay; 0 (default) keeps the original
     // data-only behavior the existing director_broadcast_test relies on.
     int replayTapeTimed(const std::string& path, long long drawTickMs = 0) {
-        FILE* f = fopen(path.c_str(), "rb");
-        if (!f) { HOST_TRACE("replayTapeTimed: cannot open %s", path.c_str()); return -1; }
-        tape::FileHeader fh{};
-        if (fread(&fh, sizeof(fh), 1, f) != 1 || std::memcmp(fh.magic, "MXBHREC", 7) != 0) {
-            HOST_TRACE("replayTapeTimed: %s is not a MXBHREC tape", path.c_str());
-            fclose(f); return -1;
+        tape_io::MappedTape reader;
+        if (!reader.open(path.c_str())) {
+            HOST_TRACE("replayTapeTimed: %s is missing or not a MXBHREC v1/v2 tape", path.c_str());
+            return -1;
         }
         int applied = 0;
         long long lastTickMs = -1;
-        tape::EventHeader eh{};
+        tape_io::EventFrame eh{};
+        const uint8_t* payload = nullptr;
         std::vector<uint8_t> buf;
-        while (fread(&eh, sizeof(eh), 1, f) == 1) {
-            buf.resize(eh.dataSize);
-            if (eh.dataSize && fread(buf.data(), 1, eh.dataSize, f) != eh.dataSize) break;
+        while (reader.next(eh, payload)) {
+            buf.assign(payload, payload + eh.dataSize);
             const long long evMs = static_cast<long long>(eh.timestampUs / 1000);
             // Pump Draw ticks up to this event's time so the director's wall-clock
             // pacing advances even across a stretch with no data events.
             if (drawTickMs > 0) {
                 if (lastTickMs < 0) lastTickMs = evMs;
                 for (long long t = lastTickMs + drawTickMs; t <= evMs; t += drawTickMs) {
+                    m_lastReplayTimeMs = t;
                     if (m_dirSetNowMs) m_dirSetNowMs(t);
+                    if (m_motionSetNowUs) m_motionSetNowUs(t * 1000);
                     draw();
                     lastTickMs = t;
                 }
             }
             m_lastReplayTimeMs = evMs;
             if (m_dirSetNowMs) m_dirSetNowMs(m_lastReplayTimeMs);
+            if (m_motionSetNowUs) m_motionSetNowUs(m_lastReplayTimeMs * 1000);
             if (dispatch(static_cast<tape::EventType>(eh.eventType), buf)) ++applied;
         }
-        fclose(f);
-        if (m_dirSetNowMs) m_dirSetNowMs(-1);   // restore the real clock
+        if (m_dirSetNowMs) m_dirSetNowMs(-1);   // restore the real clocks
+        if (m_motionSetNowUs) m_motionSetNowUs(-1);
+        return applied;
+    }
+    // --- state keyframes (PluginData::writeKeyframe / restoreKeyframe) ---------
+    // The plugin's race state as one blob, and back. restoreKeyframe() replaces
+    // the state wholesale (entries, standings, laps, timing points, event log).
+    std::vector<uint8_t> captureKeyframe() {
+        std::vector<uint8_t> out;
+        if (!m_captureKf) { HOST_TRACE("MXBMRP3_Test_CaptureKeyframe not exported"); return out; }
+        out.resize(static_cast<size_t>(m_captureKf(nullptr, 0)));
+        if (!out.empty()) m_captureKf(out.data(), static_cast<int>(out.size()));
+        return out;
+    }
+    bool restoreKeyframe(const uint8_t* data, size_t size) {
+        return m_restoreKf && m_restoreKf(data, static_cast<int>(size)) != 0;
+    }
+
+    // Replay `src` like replayTape() while re-writing it to `dst` as a v2 tape with
+    // a StateKeyframe inserted before the first event at or after every intervalUs
+    // (the recorder's own cadence, offline - so the checked-in fixtures, which
+    // predate keyframes, can exercise mid-session starts). onKeyframe (optional)
+    // runs right after each capture, before that event is applied. Returns the
+    // number of keyframes written, or -1 on a missing tape / write error.
+    int keyframeTape(const std::string& src, const std::string& dst, uint64_t intervalUs,
+                     const std::function<void(uint64_t)>& onKeyframe = nullptr) {
+        tape_io::MappedTape reader;
+        if (!reader.open(src.c_str()) || intervalUs == 0) {
+            HOST_TRACE("keyframeTape: %s is missing or not a MXBHREC v1/v2 tape", src.c_str());
+            return -1;
+        }
+        FILE* f = fopen(dst.c_str(), "wb");
+        if (!f) return -1;
+        uint8_t header[tape_io::FILE_HEADER_BYTES];
+        memcpy(header, reader.headerBytes(), sizeof(header));
+        const uint32_t version = tape_io::VERSION_BLOCKS;
+        memcpy(header + tape_io::VERSION_OFFSET, &version, sizeof(version));
+        bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+        tape_io::BlockWriter writer;
+        writer.begin(tape_io::FILE_HEADER_BYTES);
+        std::vector<uint8_t> record, buf;
+        auto put = [&](uint32_t type, uint64_t ts, const uint8_t* data, uint32_t size) {
+            const tape_io::EventFrame ef{ type, size, ts };
+            record.resize(sizeof(ef) + size);
+            memcpy(record.data(), &ef, sizeof(ef));
+            if (size) memcpy(record.data() + sizeof(ef), data, size);
+            ok = ok && writer.write(f, record.data(), record.size());
+        };
+        int keyframes = 0;
+        uint32_t events = 0;
+        uint64_t nextUs = intervalUs;
+        tape_io::EventFrame ev{};
+        const uint8_t* payload = nullptr;
+        while (reader.next(ev, payload)) {
+            if (ev.timestampUs >= nextUs) {
+                const std::vector<uint8_t> kf = captureKeyframe();
+                put(tape_io::KEYFRAME_EVENT, ev.timestampUs, kf.data(), static_cast<uint32_t>(kf.size()));
+                ++keyframes; ++events;
+                if (onKeyframe) onKeyframe(ev.timestampUs);
+                while (nextUs <= ev.timestampUs) nextUs += intervalUs;
+            }
+            put(ev.eventType, ev.timestampUs, payload, ev.dataSize);
+            ++events;
+            buf.assign(payload, payload + ev.dataSize);
+            dispatch(static_cast<tape::EventType>(ev.eventType), buf);
+        }
+        ok = ok && writer.finish(f);
+        ok = ok && tape_io::seek64(f, static_cast<int64_t>(tape_io::NUM_EVENTS_OFFSET), SEEK_SET) == 0
+                && fwrite(&events, sizeof(events), 1, f) == 1;
+        ok = (fclose(f) == 0) && ok;
+        return ok ? keyframes : -1;
+    }
+
+    // Start a replay mid-session: restore the last StateKeyframe at or before
+    // fromUs (core/tape_map.h seekKeyframe), then dispatch the events after it up
+    // to (excluding) untilUs. Call startup() yourself first, as for replayTape().
+    // Returns the events applied, or -1 if the tape has no keyframe at or before
+    // fromUs (or it doesn't restore).
+    int replayTapeFrom(const std::string& path, uint64_t fromUs, uint64_t untilUs = UINT64_MAX) {
+        tape_io::MappedTape reader;
+        if (!reader.open(path.c_str()) || !reader.seekKeyframe(fromUs)) {
+            HOST_TRACE("replayTapeFrom: %s has no keyframe at or before %llu us",
+                       path.c_str(), static_cast<unsigned long long>(fromUs));
+            return -1;
+        }
+        tape_io::EventFrame ev{};
+        const uint8_t* payload = nullptr;
+        std::vector<uint8_t> buf;
+        if (!reader.next(ev, payload) || ev.eventType != tape_io::KEYFRAME_EVENT) return -1;
+        buf.assign(payload, payload + ev.dataSize);
+        if (!restoreKeyframe(buf.data(), buf.size())) return -1;
+        int applied = 0;
+        while (reader.next(ev, payload) && ev.timestampUs < untilUs) {
+            buf.assign(payload, payload + ev.dataSize);
+            if (dispatch(static_cast<tape::EventType>(ev.eventType), buf)) ++applied;
+        }
         return applied;
     }
-    // Sim time (ms) of the last event fed by replayTapeTimed() — i.e. the tape's end,
+
+    // Sim time (ms) of the last event (or Draw tick) fed by replayTapeTimed() — i.e. the tape's end,
     // used to attribute screen time to the final shot (which has no following cut).
     long long lastReplayTimeMs() const { return m_lastReplayTimeMs; }
 
+    // --- heap allocation accounting (diagnostics/alloc_counter.h) -------------
+    // Force every HUD/widget visible so a replay exercises the whole render path.
+    void showAllHuds(bool on) { if (m_showAllHuds) m_showAllHuds(on ? 1 : 0); }
+    // True when the DLL was built with allocation counting (the test build is).
+    bool allocCounting() { return m_allocCounting && m_allocCounting() != 0; }
+    // This thread's allocations per AllocCounter::Phase, cumulative; empty if the
+    // hook is missing. Callbacks run on the calling thread, so in legacy (worker
+    // off) mode this is exactly what the plugin allocated while serving them.
+    std::vector<long long> allocThreadCounts() {
+        std::vector<long long> out;
+        if (!m_allocThreadCounts) { HOST_TRACE("MXBMRP3_Test_AllocThreadCounts not exported"); return out; }
+        out.resize(static_cast<size_t>(m_allocThreadCounts(nullptr, nullptr, 0)));
+        if (!out.empty()) m_allocThreadCounts(out.data(), nullptr, static_cast<int>(out.size()));
+        return out;
+    }
+
     // --- settings actions (test hooks) --------------------------------------
     void resetAll() { if (m_resetAll) m_resetAll(); }
     // Reset the ACTIVE profile / one HUD to factory defaults (do NOT persist on
@@ -996,6 +1124,8 @@ private:
     void        (*m_ruChannels)(float*,float*,float*,float*,float*,float*,float*,float*,float*,float*,float*,float*) = nullptr;
     int         (*m_startRec)(const char*) = nullptr;
     void        (*m_stopRec)() = nullptr;
+    int         (*m_captureKf)(uint8_t*, int) = nullptr;
+    int         (*m_restoreKf)(const void*, int) = nullptr;
     void        (*m_resetAll)() = nullptr;
     void        (*m_resetActiveProfile)() = nullptr;
     void        (*m_resetHud)(const char*, int) = nullptr;
@@ -1008,6 +1138,7 @@ private:
     int         (*m_dirIsLocked)() = nullptr;
     int         (*m_dirNextLockedCam)(int) = nullptr;
     void        (*m_dirSetNowMs)(long long) = nullptr;
+    void        (*m_motionSetNowUs)(long long) = nullptr;
     void        (*m_eventLogEnableDirector)(int) = nullptr;
     void        (*m_timingConfig)(int,int,int) = nullptr;
     int         (*m_timingReferenceMs)(int,int) = nullptr;
@@ -1064,6 +1195,10 @@ private:
     int         (*m_recFetchState)() = nullptr;
     int         m_lastGameQuads = 0;
     int         m_lastGameStrings = 0;
+    DrawObserver m_drawObserver;
+    void        (*m_showAllHuds)(int) = nullptr;
+    int         (*m_allocCounting)() = nullptr;
+    int         (*m_allocThreadCounts)(long long*, long long*, int) = nullptr;
     void        (*m_getActiveTab)(char*, int) = nullptr;
     void        (*m_capturedSections)(char*, int) = nullptr;
     void        (*m_anPrime)() = nullptr;
@@ -7,12 +7,18 @@
 // [Recorder] enabled=1) can be replayed headlessly into the plugin via
 // PluginHost::replayTape().
 //
+// Two container versions, both read through the plugin's own
+// mxbmrp3/core/tape_io.h (included as-is; replayTape maps them with
+// core/tape_map.h): v1 stores that event stream bare; v2 (what the recorder
+// writes) packs it into deflated blocks with a block index at the end. Test
+// binaries link miniz for the inflate (run_tests.sh).
+//
 // MAINTENANCE: keep the EventType values, FileHeader and EventHeader layouts,
 // and the two compound-payload packings (RaceClassification, RaceTrackPosition)
 // byte-identical to mxbmrp3/core/event_recorder.{h,cpp}. Default alignment
 // (NOT packed), matching the recorder.
 //
-// TapeWriter lets a test synthesize a tape (used to round-trip-verify the
+// TapeWriter lets a test synthesize a v1 tape (used to round-trip-verify the
 // replayer without a game); the real fidelity comes from a recorded tape.
 // ============================================================================
 #pragma once
@@ -22,6 +28,7 @@
 #include <string>
 #include <vector>
 #include "plugin_api.h"
+#include "../../../mxbmrp3/core/tape_io.h"
 
 namespace tape {
 
@@ -33,23 +40,26 @@ enum class EventType : uint32_t {
     RaceAddEntry = 19, RaceRemoveEntry = 20, RaceLap = 21, RaceSplit = 22,
     RaceHoleshot = 23, RaceClassification = 24, RaceTrackPosition = 25,
     RaceCommunication = 26, RaceVehicleData = 27,
+    StateKeyframe = 28,    // PluginData state, not a callback (see keyframe_test)
 };
 
 struct FileHeader {
     char magic[8];         // "MXBHREC\0"
-    uint32_t version;      // 1
+    uint32_t version;      // 1 (bare events) or 2 (tape_io blocks)
     uint32_t numEvents;    // total events (informational; the replayer reads to EOF)
     uint64_t startTimeUs;
     uint64_t endTimeUs;
     uint32_t flags;
     char reserved[32];
 };
+static_assert(sizeof(FileHeader) == tape_io::FILE_HEADER_BYTES, "FileHeader must match the recorder's");
 
 struct EventHeader {
     uint32_t eventType;
     uint32_t dataSize;     // payload bytes that follow
     uint64_t timestampUs;  // since recording start (ignored on replay)
 };
+static_assert(sizeof(EventHeader) == sizeof(tape_io::EventFrame), "EventHeader must match the recorder's");
 
 // The RaceClassification payload prefix (header struct + entry count), followed
 // by `numEntries` SPluginsRaceClassificationEntry_t. Matches the recorder.
@@ -72,8 +82,11 @@ public:
         fwrite(&h, sizeof(h), 1, m_f);
         return true;
     }
+    // Timestamp (us since recording start) stamped on the events written after
+    // this; 0 by default. Only replayTapeTimed() reads it.
+    void setTimestampUs(uint64_t us) { m_timestampUs = us; }
     void writeSimple(EventType t, const void* data, uint32_t size) {
-        EventHeader eh{ (uint32_t)t, size, 0 };
+        EventHeader eh{ (uint32_t)t, size, m_timestampUs };
         fwrite(&eh, sizeof(eh), 1, m_f);
         if (data && size) fwrite(data, size, 1, m_f);
         ++m_count;
@@ -101,6 +114,7 @@ public:
 private:
     FILE* m_f = nullptr;
     uint32_t m_count = 0;
+    uint64_t m_timestampUs = 0;
 };
 
 }  // namespace tape
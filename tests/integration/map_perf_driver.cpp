@@ -14,9 +14,22 @@
 // effect of its ribbon-quad cache — is isolated as a delta over a map-off baseline.
 //
 //   x86_64-w64-mingw32-g++ -std=c++17 -O2 map_perf_driver.cpp -o map_perf_driver.exe
-//   wine map_perf_driver.exe mxbmrp3_test.dlo
+//   wine map_perf_driver.exe mxbmrp3_test.dlo [segments]
+//
+// Built with -DMXBMRP3_NATIVE (tests/native/Makefile, build/map_perf_driver
+// [segments]) it links the core statically, as perf_driver.cpp does. The optional
+// segment count (default 256) sets how many curve segments the synthetic circular
+// track is cut into.
+// A radar section reports RadarHud's static vs rider-layer time with the map off.
+// A final section times track loads (TrackCenterline + first Draw, and until the
+// full LOD set is published) with the track geometry cache cold vs warm.
 // ============================================================================
+#if defined(MXBMRP3_NATIVE)
+#include <dlfcn.h>
+#include <time.h>
+#else
 #include <windows.h>
+#endif
 #include <cstdio>
 #include <cstdint>
 #include <cstring>
@@ -54,8 +67,16 @@ typedef long long (*PFN_MapProfile)(double*, double*, double*, double*, long lon
 typedef int  (*PFN_MapQuadStats)(double*, double*, int*);
 static PFN_MapProfile MapProfile = nullptr;
 
+#if defined(MXBMRP3_NATIVE)
+static uint64_t nowUs() { timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return (uint64_t)t.tv_sec * 1000000u + (uint64_t)t.tv_nsec / 1000u; }
+#define SAVE_DIR "/tmp/mxbperf/"
+#define HOST_NAME "native"
+#else
 static LARGE_INTEGER g_freq;
 static uint64_t nowUs() { LARGE_INTEGER t; QueryPerformanceCounter(&t); return (uint64_t)(t.QuadPart * 1000000.0 / g_freq.QuadPart); }
+#define SAVE_DIR "Z:\\tmp\\mxbperf\\"
+#define HOST_NAME "headless/Wine"
+#endif
 
 static const int RIDERS = 50;
 static const double BUDGET_US = 4170.0;
@@ -75,9 +96,11 @@ static SPluginsRaceTrackPosition_t* g_pos;
 
 // Run the realistic frame loop: mutate positions -> RaceTrackPosition (dirties
 // the map) -> Draw (rebuilds). Time only the Draw. Returns sorted stats.
-static void runScenario(Stat& out, int frames) {
+// perFrame (optional) runs before each frame's callbacks, e.g. to animate zoom.
+static void runScenario(Stat& out, int frames, void (*perFrame)(int) = nullptr) {
     out.init(frames);
     for (int i = 0; i < frames; ++i) {
+        if (perFrame) perFrame(i);
         for (int r = 0; r < RIDERS; ++r) {
             g_pos[r].m_fTrackPos = (float)((i + r) % 1000) / 1000.0f;
             g_pos[r].m_fPosX = (float)((i * 3 + r * 7) % 1600);
@@ -111,11 +134,19 @@ static void reportProfile(const char* name) {
 }
 
 int main(int argc, char** argv) {
+#if defined(MXBMRP3_NATIVE)
+    const int segArg = 1;
+    void* h = dlopen(nullptr, RTLD_NOW);   // the core is linked in (-rdynamic, whole archive)
+    if (!h) { printf("FAIL: dlopen %s\n", dlerror()); return 2; }
+    auto S = [&](const char* n){ return dlsym(h, n); };
+#else
+    const int segArg = 2;
     const char* dll = (argc > 1) ? argv[1] : "mxbmrp3_test.dlo";
     QueryPerformanceFrequency(&g_freq);
     HMODULE h = LoadLibraryA(dll);
     if (!h) { printf("FAIL: LoadLibrary %lu\n", GetLastError()); return 2; }
     auto S = [&](const char* n){ return GetProcAddress(h, n); };
+#endif
     auto Startup=(PFN_Startup)S("Startup"); auto Shutdown=(PFN_Shutdown)S("Shutdown");
     auto EventInit=(PFN_DS)S("EventInit"); auto RaceEvent=(PFN_DS)S("RaceEvent");
     auto RaceSession=(PFN_DS)S("RaceSession"); auto RaceAddEntry=(PFN_DS)S("RaceAddEntry");
@@ -132,7 +163,7 @@ int main(int argc, char** argv) {
     if (!Startup || !Draw || !RaceTrackPosition) { printf("FAIL: missing core exports\n"); return 2; }
     if (!MapVisible || !MapRotate || !MapZoom || !MapDetail) { printf("FAIL: missing map hooks (rebuild the DLL)\n"); return 2; }
 
-    char savePath[] = "Z:\\tmp\\mxbperf\\";
+    char savePath[] = SAVE_DIR;
     Startup(savePath);
 
     SPluginsBikeEvent_t ev{}; strcpy(ev.m_szRiderName,"Player"); strcpy(ev.m_szBikeName,"Test 450");
@@ -153,7 +184,8 @@ int main(int argc, char** argv) {
     // integration only turns on curve segments, so it collapsed to a 1D line ->
     // zero X-width -> divide-by-zero in worldToScreen -> NaN offset -> the ribbon
     // cache could never compare equal. That was a synthetic-track artifact.)
-    const int SEGS=256; SPluginsTrackSegment_t* segs=(SPluginsTrackSegment_t*)calloc(SEGS,sizeof(SPluginsTrackSegment_t));
+    const int SEGS = (argc > segArg && atoi(argv[segArg]) > 0) ? atoi(argv[segArg]) : 256;
+    SPluginsTrackSegment_t* segs=(SPluginsTrackSegment_t*)calloc(SEGS,sizeof(SPluginsTrackSegment_t));
     const float TRACK_LEN=1600.0f, RADIUS=TRACK_LEN/(2.0f*3.14159265f);
     for (int i=0;i<SEGS;++i){ segs[i].m_iType=1; segs[i].m_fLength=TRACK_LEN/SEGS; segs[i].m_fRadius=RADIUS; segs[i].m_fAngle=0.0f; }
     float raceData[4]={800.0f,400.0f,1200.0f,0.0f};
@@ -169,7 +201,8 @@ int main(int argc, char** argv) {
 
     const int FRAMES = 12000;
 
-    printf("\n=== MXBMRP3 MAP HUD perf probe (50 riders, interleaved TrackPos+Draw, headless/Wine) ===\n");
+    printf("\n=== MXBMRP3 MAP HUD perf probe (50 riders, %d-segment track, interleaved TrackPos+Draw, %s) ===\n",
+           SEGS, HOST_NAME);
     printf("Realistic hot loop: each frame mutates positions, fires RaceTrackPosition (dirties map), then Draw.\n");
     printf("%d frames per scenario. Delta column = Draw avg over the map-off baseline.\n\n", FRAMES);
     printf("%-30s %8s %8s %8s %9s  %9s\n","scenario (Draw us)","avg","p50","p99","max","vs map-off");
@@ -208,6 +241,19 @@ int main(int argc, char** argv) {
     resetProf(); Stat zoom; runScenario(zoom, FRAMES);
     report("map ON, zoom", zoom, baseAvg); reportProfile("zoom");
 
+    // Zoom with the range animating (a Range hotkey held / zoom easing): with
+    // fixed detail the ribbon spacing follows the range, so every frame asks for
+    // a different LOD. Served from the per-track LOD pyramid, not a re-walk.
+    static PFN_MapI s_zoomDistance = (PFN_MapI)S("MXBMRP3_Test_MapSetZoomDistance");
+    Stat zoomAnim{};
+    if (s_zoomDistance) {
+        MapDetail(1);   // fixed 1.0 m/quad at max range, scaled by range
+        resetProf();
+        runScenario(zoomAnim, FRAMES, [](int i) { s_zoomDistance(50 + (i * 3) % 451); });
+        report("map ON, zoom range animating", zoomAnim, baseAvg); reportProfile("zoom animating");
+        s_zoomDistance(100); MapDetail(0);
+    }
+
     // Rotate + zoom together (worst case).
     MapRotate(1);
     resetProf(); Stat both; runScenario(both, FRAMES);
@@ -236,10 +282,88 @@ int main(int argc, char** argv) {
         MapRotate(0); MapPct(100);
     }
 
+    // Radar, map off: on a position-only frame only its rider layer is rewritten
+    // (the static background/title layer stays), so the static column should
+    // be ~0. Rider 1 becomes the local player so the radar has a center.
+    auto RadarVisible = (PFN_MapI)S("MXBMRP3_Test_RadarSetVisible");
+    auto RadarProfile = (long long (*)(double*, double*))S("MXBMRP3_Test_RadarProfile");
+    Stat radar{};
+    if (RadarVisible && RadarProfile) {
+        SPluginsRaceAddEntry_t e{}; e.m_iRaceNum = 1; strcpy(e.m_szName, "Player"); strcpy(e.m_szBikeName, "Test 450");
+        strcpy(e.m_szBikeShortName, "T450"); strcpy(e.m_szCategory, "MX1"); e.m_iNumberOfGears = 5; e.m_iMaxRPM = 13000;
+        RaceAddEntry(&e, (int)sizeof(e));
+        MapVisible(0); RadarVisible(1);
+        { Stat warm; runScenario(warm, 500); free(warm.us); }
+        double st = 0, ri = 0;
+        RadarProfile(&st, &ri);
+        runScenario(radar, FRAMES);
+        printf("\n");
+        report("radar ON, map off", radar, baseAvg);
+        long long c = RadarProfile(&st, &ri);
+        if (c > 0) printf("    %-26s static %6.2f  riders %6.1f   (%lld renders)\n", "radar", st / c, ri / c, c);
+        RadarVisible(0); MapVisible(1);
+    }
+
+    // Track load: the frame that delivers TrackCenterline (the callback + the
+    // first Draw), and how long until the full LOD set is published, with the
+    // track geometry cache cold (file deleted: bounds/arc/coarse level walked on
+    // the callback, the rest on the worker, which then writes the file) vs warm
+    // (everything read back from the file). A long enduro-style loop so the walk
+    // is visible: ENDURO_SEGS alternating straights and curves, ~22 km.
+    auto RibbonsWait = (int (*)(int))S("MXBMRP3_Test_TrackRibbonsWait");
+    Stat cbCold{}, cbWarm{}, loadCold{}, loadWarm{}, readyCold{}, readyWarm{};
+    if (TrackCenterline && RibbonsWait) {
+        const int ENDURO_SEGS = 2000, LOAD_REPS = 30;
+        SPluginsTrackSegment_t* enduro = (SPluginsTrackSegment_t*)calloc(ENDURO_SEGS, sizeof(SPluginsTrackSegment_t));
+        for (int i = 0; i < ENDURO_SEGS; ++i) {
+            if (i % 2 == 0) { enduro[i].m_iType = 0; enduro[i].m_fLength = 12.0f; }
+            else {
+                enduro[i].m_iType = 1; enduro[i].m_fLength = 10.0f;
+                enduro[i].m_fRadius = ((i / 2) % 4 < 2 ? 1.0f : -1.0f) * (float)(40 + (i * 37) % 120);
+            }
+        }
+        SPluginsBikeEvent_t ev2 = ev; strcpy(ev2.m_szTrackID, "perf_enduro"); strcpy(ev2.m_szTrackName, "PerfEnduro");
+        EventInit(&ev2, (int)sizeof(ev2));
+        const char* cacheFile = SAVE_DIR "mxbmrp3\\trackcache\\perf_enduro.geo";
+        cbCold.init(LOAD_REPS); cbWarm.init(LOAD_REPS); loadCold.init(LOAD_REPS); loadWarm.init(LOAD_REPS);
+        readyCold.init(LOAD_REPS); readyWarm.init(LOAD_REPS);
+        MapVisible(1);
+        int warmHits = 0;
+        for (int rep = 0; rep < LOAD_REPS * 2; ++rep) {
+            const bool cold = (rep % 2 == 0);
+            if (cold) remove(cacheFile);
+            int nq, ns; void *q, *sp;
+            uint64_t t0 = nowUs();
+            TrackCenterline(ENDURO_SEGS, enduro, raceData);
+            uint64_t tc = nowUs();
+            Draw(0, &nq, &q, &ns, &sp);
+            uint64_t t1 = nowUs();
+            int state = RibbonsWait(30000);
+            uint64_t t2 = nowUs();
+            if (!cold && state == 2) ++warmHits;
+            (cold ? cbCold : cbWarm).add((double)(tc - t0));
+            (cold ? loadCold : loadWarm).add((double)(t1 - t0));
+            (cold ? readyCold : readyWarm).add((double)(t2 - t0));
+        }
+        qsort(cbCold.us, cbCold.n, sizeof(double), cmp); qsort(cbWarm.us, cbWarm.n, sizeof(double), cmp);
+        qsort(loadCold.us, loadCold.n, sizeof(double), cmp); qsort(loadWarm.us, loadWarm.n, sizeof(double), cmp);
+        qsort(readyCold.us, readyCold.n, sizeof(double), cmp); qsort(readyWarm.us, readyWarm.n, sizeof(double), cmp);
+        printf("\n--- track load (%d-segment enduro loop, %d reps each; load frame = TrackCenterline + first Draw) ---\n",
+               ENDURO_SEGS, LOAD_REPS);
+        report("TrackCenterline, cache cold", cbCold, -1);
+        report("TrackCenterline, cache warm", cbWarm, -1);
+        report("load frame, cache cold", loadCold, -1);
+        report("load frame, cache warm", loadWarm, -1);
+        report("all LOD levels ready, cold", readyCold, -1);
+        report("all LOD levels ready, warm", readyWarm, -1);
+        printf("    warm loads served from the cache: %d / %d\n", warmHits, LOAD_REPS);
+        free(enduro);
+    }
+
     printf("\nBudget = %.0f us/frame (240fps). Baseline map-off Draw avg = %.1f us.\n", BUDGET_US, baseAvg);
     printf("Machine-readable:\n");
-    printf("MAPPERF off=%.1f default=%.1f rotate=%.1f zoom=%.1f both=%.1f\n",
-        baseAvg, avg(def), avg(rot), avg(zoom), avg(both));
+    printf("MAPPERF off=%.1f default=%.1f rotate=%.1f zoom=%.1f both=%.1f load_cold=%.1f load_warm=%.1f\n",
+        baseAvg, avg(def), avg(rot), avg(zoom), avg(both), pct(loadCold, 0.5), pct(loadWarm, 0.5));
     fflush(stdout);
     if (Shutdown) Shutdown();
     return 0;
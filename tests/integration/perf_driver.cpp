@@ -10,7 +10,9 @@
 // positions, then times the hot callbacks: Draw (per-frame render build),
 // RaceTrackPosition (high-frequency, full grid), RaceClassification (standings
 // rebuild), RunTelemetry (100Hz player). Reports per-call avg/p50/p99/max and a
-// projection to a full warmup+race session.
+// projection to a full warmup+race session. With the test build's recorder hooks
+// present, it then records a race-shaped stream (Draw + 50-rider positions +
+// telemetry) to a tape and reports the recorder's game-thread cost per event.
 //
 // Caveats (printed in the report): absolute numbers include Wine overhead and
 // vary with host CPU; use for relative cost, hot-path ID, and regression, not as
@@ -18,8 +20,18 @@
 //
 //   x86_64-w64-mingw32-g++ perf_driver.cpp -o perf_driver.exe
 //   wine perf_driver.exe mxbmrp3_test.dlo
+//
+// Built with -DMXBMRP3_NATIVE (tests/native/Makefile) the same driver links the
+// plugin core statically into a Linux executable - no DLL, no Wine - and resolves
+// the exports from its own symbol table, so perf/valgrind/heaptrack see the
+// plugin's code directly.
 // ============================================================================
+#if defined(MXBMRP3_NATIVE)
+#include <dlfcn.h>
+#include <time.h>
+#else
 #include <windows.h>
+#endif
 #include <cstdio>
 #include <cstdint>
 #include <cstring>
@@ -60,9 +72,20 @@ typedef void (*PFN_Class)(void*, int, void*, int);
 typedef void (*PFN_TrackPos)(int, void*, int);
 typedef void (*PFN_Draw)(int, int*, void**, int*, void**);
 typedef void (*PFN_TrackCenter)(int, void*, void*);
-
+typedef int  (*PFN_StartRec)(const char*);
+typedef void (*PFN_StopRec)();
+typedef void (*PFN_RecStats)(long long*, double*, double*, long long*);
+
+#if defined(MXBMRP3_NATIVE)
+static uint64_t nowUs() { timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return (uint64_t)t.tv_sec * 1000000u + (uint64_t)t.tv_nsec / 1000u; }
+#define SAVE_DIR "/tmp/mxbperf/"
+#define HOST_NAME "native"
+#else
 static LARGE_INTEGER g_freq;
 static uint64_t nowUs() { LARGE_INTEGER t; QueryPerformanceCounter(&t); return (uint64_t)(t.QuadPart * 1000000.0 / g_freq.QuadPart); }
+#define SAVE_DIR "Z:\\tmp\\mxbperf\\"
+#define HOST_NAME "Wine"
+#endif
 
 // Per-callback timing: keep all samples so we can report percentiles.
 struct Stat {
@@ -78,12 +101,19 @@ static const int RIDERS = 50;
 static const double BUDGET_US = 4170.0;  // 240 fps frame budget
 
 int main(int argc, char** argv) {
+#if defined(MXBMRP3_NATIVE)
+    (void)argc; (void)argv;
+    void* h = dlopen(nullptr, RTLD_NOW);   // the core is linked in (-rdynamic, whole archive)
+    if (!h) { printf("FAIL: dlopen %s\n", dlerror()); return 2; }
+    auto S = [&](const char* n){ return dlsym(h, n); };
+#else
     const char* dll = (argc > 1) ? argv[1] : "mxbmrp3_test.dlo";
     QueryPerformanceFrequency(&g_freq);
 
     HMODULE h = LoadLibraryA(dll);
     if (!h) { printf("FAIL: LoadLibrary %lu\n", GetLastError()); return 2; }
     auto S = [&](const char* n){ return GetProcAddress(h, n); };
+#endif
     auto Startup=(PFN_Startup)S("Startup"); auto Shutdown=(PFN_Shutdown)S("Shutdown");
     auto EventInit=(PFN_DS)S("EventInit"); auto RaceEvent=(PFN_DS)S("RaceEvent");
     auto RaceSession=(PFN_DS)S("RaceSession"); auto RaceAddEntry=(PFN_DS)S("RaceAddEntry");
@@ -92,7 +122,7 @@ int main(int argc, char** argv) {
     auto Draw=(PFN_Draw)S("Draw");
     if (!Startup || !Draw) { printf("FAIL: missing exports\n"); return 2; }
 
-    char savePath[] = "Z:\\tmp\\mxbperf\\";
+    char savePath[] = SAVE_DIR;
     Startup(savePath);
 
     // --- Populate a full 50-rider race on a real track ----------------------
@@ -146,7 +176,7 @@ int main(int argc, char** argv) {
     Stat* all[4]={&draw,&tpos,&cla,&telem};
     for (auto* s: all) qsort(s->us,s->n,sizeof(double),cmp);
 
-    printf("\n=== MXBMRP3 CPU perf baseline (50 riders, headless/Wine) ===\n");
+    printf("\n=== MXBMRP3 CPU perf baseline (50 riders, headless/%s) ===\n", HOST_NAME);
     printf("%-34s %8s %8s %8s %8s %9s\n","callback","n","avg us","p50 us","p99 us","max us");
     printf("%-34s %8s %8s %8s %8s %9s\n","--------","-","------","------","------","------");
     for (auto* s: all) printf("%-34s %8d %8.1f %8.1f %8.1f %9.1f\n",
@@ -168,13 +198,38 @@ int main(int argc, char** argv) {
     printf("\nProjected plugin CPU over a ~%.0fs session (warmup+race):\n", sessionS);
     printf("  Draw %.2fs  TrackPos %.2fs  Telemetry %.2fs  Classification %.2fs\n", drawCpu,tposCpu,telemCpu,claCpu);
     printf("  total %.2fs = %.2f%% of one CPU core over the session\n", total, 100.0*total/sessionS);
+#if defined(MXBMRP3_NATIVE)
+    printf("\nNOTE: native Linux build of the core (no Wine); varies with host CPU.\n");
+    printf("Compare native runs with native runs - not with the Wine baseline.\n");
+#else
     printf("\nNOTE: includes Wine overhead and varies with host CPU. Use for relative\n");
     printf("cost, hot-path identification, and regression detection - not exact\n");
     printf("Windows figures. Baseline captured on the CI/dev host.\n");
+#endif
+
+    // --- Recorder on: game-thread cost per recorded event ---------------------
+    // A race-shaped mix at realistic ratios (per 240fps Draw: ~0.4 telemetry,
+    // ~0.125 full-grid positions) recorded to a tape. The recorder's own counter
+    // covers timestamp + framing + payload copy + buffer handoff for each event.
+    double recNs = 0.0;
+    auto StartRec=(PFN_StartRec)S("MXBMRP3_Test_StartRecording");
+    auto StopRec=(PFN_StopRec)S("MXBMRP3_Test_StopRecording");
+    auto RecStats=(PFN_RecStats)S("MXBMRP3_Test_RecorderStats");
+    if (StartRec && StopRec && RecStats && StartRec(SAVE_DIR "perf.tape")) {
+        for (int i=0;i<24000;++i){ int nq,ns; void*q; void*s; Draw(0,&nq,&q,&ns,&s);
+            if (i%5<2 && RunTelemetry) RunTelemetry(&bd,(int)sizeof(bd),(float)i*0.01f,(float)(i%1000)/1000.0f);
+            if (i%8==0) RaceTrackPosition(RIDERS,pos,(int)sizeof(pos[0])); }
+        StopRec();
+        long long recEvents=0, handoffs=0; double recMaxUs=0.0;
+        RecStats(&recEvents,&recNs,&recMaxUs,&handoffs);
+        printf("\nRecorder on (tape written by a background thread):\n");
+        printf("  %lld events, game-thread cost %.0f ns/event avg, %.1f us max, %lld buffer handoffs\n",
+            recEvents, recNs, recMaxUs, handoffs);
+    }
 
     // Machine-readable line for the harness threshold check.
-    printf("\nPERF draw_avg_us=%.1f draw_p99_us=%.1f tpos_avg_us=%.1f cla_avg_us=%.1f\n",
-        dAvg, dP99, avg(tpos), avg(cla));
+    printf("\nPERF draw_avg_us=%.1f draw_p99_us=%.1f tpos_avg_us=%.1f cla_avg_us=%.1f rec_event_ns=%.0f\n",
+        dAvg, dP99, avg(tpos), avg(cla), recNs);
     fflush(stdout);
     if (Shutdown) Shutdown();
     return 0;
@@ -59,6 +59,9 @@ echo "== Building plugin DLL (per-file 'CXX ...' progress below) =="
 # compile is the slow part of a run, and its per-file "CXX ..." lines are the main
 # sign of life. Run it directly (no pipe) so nothing block-buffers the output.
 "${HERE}/build.sh" || { echo "ERROR: plugin build failed"; exit 1; }
+# The harness reads MXBHREC v2 tapes (deflated blocks, mxbmrp3/core/tape_io.h),
+# so tests link the plugin build's miniz objects (plain C, no plugin code).
+MINIZ_OBJS=("${BUILD}/obj/vendor/miniz/"*.o)
 
 # Which tests to run (basename filter; default all).
 mapfile -t ALL < <(cd "${TESTS_DIR}" && ls *.cpp 2>/dev/null | sort)
@@ -82,13 +85,18 @@ echo "wine: $(wine --version 2>/dev/null)  prefix: ${WINEPREFIX}"
 rm -rf "${SAVE_ROOT}"
 
 # Decompress committed callback-tape fixtures so replay tests can read them at
-# Z:\tmp\mxbmrp3-tests\fixtures\<name> (they're stored gzipped to keep the repo small).
+# Z:\tmp\mxbmrp3-tests\fixtures\<name> (v1 tapes are stored gzipped to keep the
+# repo small; v2 tapes are already deflated and are copied as-is).
 if compgen -G "${TESTS_DIR}/fixtures/"'*.gz' >/dev/null 2>&1; then
     mkdir -p "${SAVE_ROOT}/fixtures"
     for gz in "${TESTS_DIR}/fixtures/"*.gz; do
         gunzip -c "${gz}" > "${SAVE_ROOT}/fixtures/$(basename "${gz%.gz}")"
     done
 fi
+if compgen -G "${TESTS_DIR}/fixtures/"'*.tape' >/dev/null 2>&1; then
+    mkdir -p "${SAVE_ROOT}/fixtures"
+    cp "${TESTS_DIR}/fixtures/"*.tape "${SAVE_ROOT}/fixtures/"
+fi
 
 rc=0
 total=${#SELECTED[@]}
@@ -102,7 +110,7 @@ for src in "${SELECTED[@]}"; do
     echo "== [${i}/${total}] ${name} (cap ${PER_TEST_TIMEOUT}s) =="
     # Compile (ccache-cached) then link, so an unchanged test is a cache hit.
     if ! ${CCACHE} "${CXX}" "${CXXFLAGS[@]}" "${INCS[@]}" -c "${TESTS_DIR}/${src}" -o "${obj}" \
-       || ! "${CXX}" "${LDFLAGS[@]}" "${obj}" -o "${exe}" "${LIBS[@]}"; then
+       || ! "${CXX}" "${LDFLAGS[@]}" "${obj}" "${MINIZ_OBJS[@]}" -o "${exe}" "${LIBS[@]}"; then
         echo "FAIL: ${name} failed to compile"; rc=1; continue
     fi
     # Clean, pre-created save dir for this test (Z:\tmp\mxbmrp3-tests\<short>\).
@@ -11,6 +11,11 @@
 #
 #   python3 slim_tape.py MASTER.tape OUT.tape --profile min
 #   python3 slim_tape.py MASTER.tape OUT.tape --keep 3,15,17,24 --stats
+#   python3 slim_tape.py MASTER.tape OUT.tape --profile full --v2   # just re-pack
+#
+# Reads both container versions (v1: the bare event stream; v2: the recorder's
+# delta-coded, deflated blocks + index, mxbmrp3/core/tape_io.h). Writes v1 by default — what
+# the committed .gz fixtures are — or v2 with --v2, which needs no gzip.
 #
 # Profiles (each is a KEEP set of event-type ids):
 #   min    snapshot state-changers only (standings/session/events). ~tiny.
@@ -20,20 +25,53 @@
 #   all    everything except Draw (33k/session of pure render spam) — for
 #          telemetry / vehicle-data / FMX tests. Largest.
 #   full   verbatim copy (drops nothing).
-# Gzip the output before committing to tests/integration/tests/fixtures/.
+# Gzip a v1 output before committing to tests/integration/tests/fixtures/.
 # ============================================================================
-import sys, struct, argparse, collections
+import sys, struct, argparse, collections, zlib, array
 
 NAMES = {1:'Startup',2:'Shutdown',3:'EventInit',4:'EventDeinit',5:'RunInit',
 6:'RunDeinit',7:'RunStart',8:'RunStop',9:'RunLap',10:'RunSplit',11:'RunTelemetry',
 12:'DrawInit',13:'Draw',14:'TrackCenterline',15:'RaceEvent',16:'RaceDeinit',
 17:'RaceSession',18:'RaceSessionState',19:'RaceAddEntry',20:'RaceRemoveEntry',
 21:'RaceLap',22:'RaceSplit',23:'RaceHoleshot',24:'RaceClassification',
-25:'RaceTrackPosition',26:'RaceCommunication',27:'RaceVehicleData'}
+25:'RaceTrackPosition',26:'RaceCommunication',27:'RaceVehicleData',
+28:'StateKeyframe'}
 HDR = 72  # sizeof(FileHeader), default alignment — see harness/tape.h
+# v2 container (mirrors mxbmrp3/core/tape_io.h).
+BLOCK_HDR = struct.Struct('<4sIIIQII')    # magic, rawBytes, storedBytes, eventCount, firstTimestampUs, flags, reserved
+INDEX_ENTRY = struct.Struct('<QQII')      # fileOffset, firstTimestampUs, firstEvent, eventCount
+FOOTER = struct.Struct('<QII8s')          # indexOffset, blockCount, reserved, magic
+BLOCK_STORED = 0x1
+BLOCK_DELTA = 0x2
+BLOCK_KEYFRAME = 0x4                      # block opens with a StateKeyframe
+KEYFRAME_EVENT = 28
+BLOCK_BYTES = 256 * 1024
+DELTA_TYPES = {11, 24, 25}                # RunTelemetry, RaceClassification, RaceTrackPosition
+
+def _delta(payload, ref, sign):
+    """payload -/+ ref: uint32 words (wrapping), then the tail byte-wise."""
+    n = len(payload) & ~3
+    a, b = array.array('I', payload[:n]), array.array('I', ref[:n])
+    words = array.array('I', [(x + sign * y) & 0xFFFFFFFF for x, y in zip(a, b)]).tobytes()
+    return words + bytes((x + sign * y) & 0xFF for x, y in zip(payload[n:], ref[n:]))
+
+def delta_block(block, sign):
+    """Apply (sign=-1) or undo (sign=+1) the BLOCK_DELTA stage over one block's events."""
+    out, prev, off = bytearray(block), {}, 0
+    while off + 16 <= len(block):
+        et, sz, _ = struct.unpack_from('<IIQ', block, off)
+        if et in DELTA_TYPES:
+            ref = prev.get(et)
+            if ref is not None and ref[1] == sz:
+                src = out if sign > 0 else block       # decode refers to decoded records
+                out[off + 16:off + 16 + sz] = _delta(block[off + 16:off + 16 + sz],
+                                                     src[ref[0]:ref[0] + sz], sign)
+            prev[et] = (off + 16, sz)
+        off += 16 + sz
+    return bytes(out)
 
 # Snapshot state-changers (what replayTape applies that reaches /api/state).
-MIN = {3, 15, 17, 18, 19, 20, 21, 24, 26}
+MIN = {3, 15, 17, 18, 19, 20, 21, 24, 26, 28}   # + keyframes (mid-session starts)
 PROFILES = {
     'min':  MIN,
     'gaps': MIN | {22, 23, 25},                    # + splits, holeshot, track positions
@@ -41,12 +79,66 @@ PROFILES = {
     'full': set(NAMES),                            # verbatim
 }
 
+def event_stream(data, path):
+    """The bare [EventHeader][payload]* stream of a v1 or v2 tape."""
+    version = struct.unpack_from('<I', data, 8)[0]
+    if version == 1:
+        return data[HDR:]
+    if version != 2:
+        sys.exit(f'{path}: unknown tape version {version}')
+    out, off = bytearray(), HDR
+    while off + BLOCK_HDR.size <= len(data):
+        magic, raw, stored, _, _, flags, _ = BLOCK_HDR.unpack_from(data, off)
+        if magic != b'BLK2' or off + BLOCK_HDR.size + stored > len(data):
+            break                                  # the index, or a crash-cut tail
+        body = data[off + BLOCK_HDR.size:off + BLOCK_HDR.size + stored]
+        if not flags & BLOCK_STORED:
+            body = zlib.decompressobj(-15).decompress(body)
+        out += delta_block(body, +1) if flags & BLOCK_DELTA else body
+        off += BLOCK_HDR.size + stored
+    return bytes(out)
+
+def pack_v2(header, records):
+    """header (72 B, version patched to 2) + delta-coded, deflated blocks + index + footer."""
+    out = bytearray(header)
+    struct.pack_into('<I', out, 8, 2)
+    index, block, first_ts, count, ordinal, keyframe = [], bytearray(), 0, 0, 0, False
+    def close():
+        nonlocal block, count, ordinal
+        body = zlib.compress(delta_block(bytes(block), -1), 9)[2:-4]  # raw deflate (strip zlib header/adler)
+        flags = BLOCK_DELTA
+        if len(body) >= len(block):
+            body, flags = bytes(block), BLOCK_STORED
+        if keyframe:
+            flags |= BLOCK_KEYFRAME
+        index.append(INDEX_ENTRY.pack(len(out), first_ts, ordinal, count))
+        out.extend(BLOCK_HDR.pack(b'BLK2', len(block), len(body), count, first_ts, flags, 0))
+        out.extend(body)
+        ordinal += count
+        block, count = bytearray(), 0
+    for rec in records:
+        is_keyframe = struct.unpack_from('<I', rec, 0)[0] == KEYFRAME_EVENT
+        if block and (is_keyframe or len(block) + len(rec) > BLOCK_BYTES):
+            close()
+        if not block:
+            first_ts = struct.unpack_from('<Q', rec, 8)[0]
+            keyframe = is_keyframe
+        block += rec; count += 1
+    if block:
+        close()
+    index_offset = len(out)
+    for e in index:
+        out += e
+    out += FOOTER.pack(index_offset, len(index), 0, b'MXBHIDX\0')
+    return out
+
 def main():
     ap = argparse.ArgumentParser()
     ap.add_argument('src'); ap.add_argument('dst')
     ap.add_argument('--profile', choices=PROFILES, default='min')
     ap.add_argument('--keep', help='explicit comma-separated event-type ids (overrides profile)')
     ap.add_argument('--stats', action='store_true', help='print the kept/dropped histogram')
+    ap.add_argument('--v2', action='store_true', help='write the v2 block container (no gzip needed)')
     a = ap.parse_args()
 
     keep = set(int(x) for x in a.keep.split(',')) if a.keep else PROFILES[a.profile]
@@ -54,18 +146,25 @@ def main():
     if data[:7] != b'MXBHREC':
         sys.exit(f'{a.src}: not a MXBHREC tape')
 
-    out = bytearray(data[:HDR])
-    off, kept = HDR, 0
+    stream = event_stream(data, a.src)
+    header = bytearray(data[:HDR])
+    records, off = [], 0
     khist, dhist = collections.Counter(), collections.Counter()
-    while off + 16 <= len(data):
-        et, sz, _ = struct.unpack_from('<IIQ', data, off)
-        rec = data[off:off + 16 + sz]
+    while off + 16 <= len(stream):
+        et, sz, _ = struct.unpack_from('<IIQ', stream, off)
+        rec = stream[off:off + 16 + sz]
         off += 16 + sz
         if et in keep:
-            out += rec; kept += 1; khist[et] += 1
+            records.append(rec); khist[et] += 1
         else:
             dhist[et] += 1
-    struct.pack_into('<I', out, 12, kept)           # patch numEvents
+    kept = len(records)
+    struct.pack_into('<I', header, 12, kept)        # patch numEvents
+    if a.v2:
+        out = pack_v2(header, records)
+    else:
+        struct.pack_into('<I', header, 8, 1)
+        out = header + b''.join(records)
     open(a.dst, 'wb').write(out)
 
     print(f'{a.src} ({len(data)} B) -> {a.dst} ({len(out)} B), {kept} events kept '
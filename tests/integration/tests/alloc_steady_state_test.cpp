@@ -0,0 +1,164 @@
+// ============================================================================
+// tests/integration/tests/alloc_steady_state_test.cpp
+// Steady-state heap allocation ceiling for the draw path, the game callbacks,
+// the web overlay snapshot and the auto-director.
+//
+// The test DLL counts every operator new per thread and per phase
+// (diagnostics/alloc_counter.h). We replay the 24-rider race tape with every HUD
+// visible and a 60 Hz Draw pump, and after a warm-up (vectors reaching capacity,
+// caches filling, first layouts) read how many allocations each Draw charged to
+// the draw path (Draw + HUD updates) and how many the data callbacks made.
+//
+// The draw path must not allocate on a typical frame: the median is pinned at 0.
+// A frame that rebuilds a text HUD still allocates, so the p99 is gated at a
+// ceiling instead (~8 natively; Windows measured 105 before the session charts
+// kept their working sets across rebuilds). What still allocates on a rebuild,
+// all of it std::string building or copying:
+//   - StandingsHud: DisplayEntry::fromRaceEntry copies rider/bike names, and
+//     renderRiderRow formats each row's cells;
+//   - EventLogHud, LapLogHud, RecordsHud and SessionHud format their lines, and
+//     PluginUtils::fitText returns the truncated copy;
+//   - RecordsHud's StatsManager::getPersonalBestForCategory lookup builds its
+//     track/category key strings.
+// Strings that fit the small-string buffer don't allocate, so the count
+// depends on name lengths and on the STL (hence the headroom over native).
+//
+// The second case turns the web server and the director on: every data change
+// then rebuilds the /api/state JSON and every spectated Draw may run a director
+// evaluation. Both refill member buffers, so a typical frame charges nothing to
+// either phase; a cut still logs and posts an event-log line, hence the ceiling.
+//
+// Legacy mode (plugin worker off): every export runs on this thread, so the
+// calling thread's counters are exactly what the plugin allocated serving them.
+// ============================================================================
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+#include "integration_main.h"
+#include "plugin_host.h"
+#include "assertions.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+// AllocCounter::Phase indices (diagnostics/alloc_counter.h)
+constexpr int PHASE_CALLBACK = 1;
+constexpr int PHASE_DRAW = 2;
+constexpr int PHASE_HUD_UPDATE = 3;
+constexpr int PHASE_SNAPSHOT = 4;
+constexpr int PHASE_DIRECTOR = 5;
+
+constexpr long long kDrawTickMs = 16;        // ~60 Hz Draw pump
+constexpr size_t kWarmupFrames = 600;        // ~10 s of sim time
+constexpr long long kP99Ceiling = 64;        // allocations on a rebuild-heavy frame
+constexpr double kCallbackAllocsPerEvent = 0.05;
+constexpr size_t kPollFrames = 60;           // /api/state poll every ~1 s keeps the snapshot live
+constexpr long long kSnapshotDirectorP99 = 8;     // a director cut (log line + event-log entry)
+constexpr double kSnapshotDirectorPerFrame = 0.2;
+}
+
+TEST_CASE("alloc: the draw path does not allocate on a steady-state frame") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    host.startup("Z:\\tmp\\mxbmrp3-tests\\allocs\\");
+    REQUIRE(host.allocCounting());
+    host.showAllHuds(true);
+
+    std::vector<long long> drawAllocs;   // per Draw, after warm-up
+    long long lastDraw = 0, lastCallback = 0;
+    long long callbackAllocs = 0;
+    size_t frames = 0;
+    host.setDrawObserver([&](long long, int, const void*, int, const void*) {
+        const std::vector<long long> c = host.allocThreadCounts();
+        if (c.size() <= PHASE_HUD_UPDATE) return;
+        const long long draw = c[PHASE_DRAW] + c[PHASE_HUD_UPDATE];
+        if (++frames > kWarmupFrames) {
+            drawAllocs.push_back(draw - lastDraw);
+            callbackAllocs += c[PHASE_CALLBACK] - lastCallback;
+        }
+        lastDraw = draw;
+        lastCallback = c[PHASE_CALLBACK];
+    });
+
+    const int applied = host.replayTapeTimed(
+        "Z:\\tmp\\mxbmrp3-tests\\fixtures\\race_farm14_24riders.tape", kDrawTickMs);
+    host.setDrawObserver({});
+    REQUIRE(applied > 0);
+    REQUIRE(drawAllocs.size() > 1000);
+
+    std::vector<long long> sorted = drawAllocs;
+    std::sort(sorted.begin(), sorted.end());
+    const long long p50 = sorted[sorted.size() / 2];
+    const long long p99 = sorted[sorted.size() * 99 / 100];
+    const long long maxAllocs = sorted.back();
+    const double perEvent = static_cast<double>(callbackAllocs) / applied;
+    MESSAGE("draw allocs/frame over " << sorted.size() << " frames: p50=" << p50
+            << " p99=" << p99 << " max=" << maxAllocs
+            << "  callback allocs/event=" << perEvent);
+
+    CHECK(p50 == 0);
+    CHECK(p99 <= kP99Ceiling);
+    CHECK(perEvent < kCallbackAllocsPerEvent);
+
+    host.shutdown();
+}
+
+TEST_CASE("alloc: the web snapshot and the director do not allocate on a steady-state frame") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    host.startup("Z:\\tmp\\mxbmrp3-tests\\allocs\\");
+    REQUIRE(host.allocCounting());
+    REQUIRE(host.startHttp());
+    host.draw();                     // state 1 = spectate, so the director actually directs
+    host.directorSetEnabled(true);
+
+    // Per Draw (after warm-up): what the snapshot rebuilds and the director charged
+    // since the previous Draw, whichever callback or Draw they ran under.
+    std::vector<long long> frameAllocs;
+    long long last = 0;
+    size_t frames = 0;
+    std::set<std::string> bodies;    // distinct served snapshots: the rebuild really ran
+    std::set<int> subjects;          // distinct directed riders: the director really cut
+    host.setDrawObserver([&](long long, int, const void*, int, const void*) {
+        const std::vector<long long> c = host.allocThreadCounts();
+        if (c.size() <= PHASE_DIRECTOR) return;
+        const long long n = c[PHASE_SNAPSHOT] + c[PHASE_DIRECTOR];
+        if (++frames > kWarmupFrames) frameAllocs.push_back(n - last);
+        last = n;
+        if (frames % kPollFrames == 0) {
+            const auto state = host.state();
+            if (frames > kWarmupFrames && state.is_object()) {
+                bodies.insert(state.dump());
+                subjects.insert(state["director"].value("subject", -1));
+            }
+        }
+    });
+
+    const int applied = host.replayTapeTimed(
+        "Z:\\tmp\\mxbmrp3-tests\\fixtures\\race_farm14_24riders.tape", kDrawTickMs);
+    host.setDrawObserver({});
+    REQUIRE(applied > 0);
+    REQUIRE(frameAllocs.size() > 1000);
+    CHECK(bodies.size() > 10);
+    subjects.erase(-1);
+    CHECK(subjects.size() > 1);
+
+    std::vector<long long> sorted = frameAllocs;
+    std::sort(sorted.begin(), sorted.end());
+    long long total = 0;
+    for (long long n : frameAllocs) total += n;
+    const long long p50 = sorted[sorted.size() / 2];
+    const long long p99 = sorted[sorted.size() * 99 / 100];
+    const double perFrame = static_cast<double>(total) / frameAllocs.size();
+    MESSAGE("snapshot+director allocs/frame over " << sorted.size() << " frames: p50=" << p50
+            << " p99=" << p99 << " max=" << sorted.back() << " mean=" << perFrame
+            << "  snapshots seen=" << bodies.size() << " subjects=" << subjects.size());
+
+    CHECK(p50 == 0);
+    CHECK(p99 <= kSnapshotDirectorP99);
+    CHECK(perFrame < kSnapshotDirectorPerFrame);
+
+    host.shutdown();
+}
@@ -0,0 +1,180 @@
+// ============================================================================
+// tests/integration/tests/frame_export_test.cpp
+// Shared-memory frame export ([Advanced] frameExport, core/frame_export.cpp):
+// an external reader maps "Local\mxbmrp3_frames" and must receive the plugin's
+// frames INTACT and at FULL RATE, without ever blocking Draw().
+//
+//  * PRIMITIVES: a reader thread in this process (the mapping is just as visible
+//    to another one) polls readLatest() while the main thread drives Draw() faster
+//    than any game. Every frame it gets must be byte-identical to what that Draw()
+//    handed the game (recorded via the draw observer, keyed by frame number), and
+//    it must see nearly all of them — a drop means the reader was lapped, which at
+//    this rate would mean the writer is far slower than it should be.
+//  * IMAGE: the mapping is re-created at the requested RGBA geometry and frames
+//    rendered off-thread arrive with a consistent, non-empty payload.
+//  * OFF closes the mapping.
+//
+// The ABI header is included from the plugin tree: it is standard-library only,
+// exactly as an external reader would consume it.
+// ============================================================================
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+#include "integration_main.h"
+#include "plugin_host.h"
+#include "../../../mxbmrp3/core/frame_export_abi.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+namespace {
+
+typedef void (*PFN_FrameExport)(int, int);
+typedef long long (*PFN_FrameExportPublished)();
+
+constexpr int kQuadBytes = 40, kStringBytes = 124;
+
+struct Mapping {
+    HANDLE h = nullptr;
+    const frame_export::ShmHeader* hdr = nullptr;
+    bool open() {
+        h = OpenFileMappingA(FILE_MAP_READ, FALSE, frame_export::MAPPING_NAME);
+        if (!h) return false;
+        const void* v = MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION mbi{};
+        if (!v || !VirtualQuery(v, &mbi, sizeof(mbi))) return false;
+        hdr = static_cast<const frame_export::ShmHeader*>(v);
+        return frame_export::headerValid(hdr, mbi.RegionSize);
+    }
+    ~Mapping() {
+        if (hdr) UnmapViewOfFile(hdr);
+        if (h) CloseHandle(h);
+    }
+};
+
+void populateRace(PluginHost& host) {
+    host.eventInit("TestTrack", "Alice");
+    host.raceEvent("TestTrack");
+    host.session(/*session=*/6, /*numLaps=*/10, /*lengthMs=*/0);
+    host.addEntry(10, "Alice");
+    host.addEntry(22, "Bob");
+    host.classify(6, 300000, {
+        { .num = 10, .best = 90000, .laps = 5, .gap = 0 },
+        { .num = 22, .best = 91000, .laps = 5, .gap = 1500 },
+    });
+}
+
+} // namespace
+
+TEST_CASE("frame export: primitives arrive intact at full rate, image mode, off") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    auto setExport = host.sym<PFN_FrameExport>("MXBMRP3_Test_FrameExport");
+    auto published = host.sym<PFN_FrameExportPublished>("MXBMRP3_Test_FrameExportPublished");
+    REQUIRE_MESSAGE((setExport && published), "MXBMRP3_Test_FrameExport* hooks not exported (test build?)");
+    host.startup("Z:\\tmp\\mxbmrp3-tests\\frame_export\\");
+    populateRace(host);
+
+    // --- PRIMITIVES ---------------------------------------------------------
+    // (Scoped: each Mapping is released before the next mode re-creates the object.)
+    {
+        setExport(1, 0);
+        host.draw();                                   // reconcile creates the mapping
+        Mapping m;
+        REQUIRE(m.open());
+        CHECK(m.hdr->format == frame_export::FORMAT_PRIMITIVES);
+        CHECK(m.hdr->writerPid == GetCurrentProcessId());
+        const long long base = published();
+        REQUIRE(base >= 1);
+
+        // Expected bytes per frame number, recorded from what Draw() returned.
+        std::map<uint64_t, std::vector<uint8_t>> expected;
+        host.setDrawObserver([&](long long, int nq, const void* q, int ns, const void* s) {
+            std::vector<uint8_t> bytes(static_cast<size_t>(nq) * kQuadBytes + static_cast<size_t>(ns) * kStringBytes);
+            if (nq) std::memcpy(bytes.data(), q, static_cast<size_t>(nq) * kQuadBytes);
+            if (ns) std::memcpy(bytes.data() + static_cast<size_t>(nq) * kQuadBytes, s, static_cast<size_t>(ns) * kStringBytes);
+            expected[static_cast<uint64_t>(published())] = std::move(bytes);
+        });
+
+        std::atomic<bool> stop{ false };
+        std::map<uint64_t, std::vector<uint8_t>> received;
+        int lapped = 0;
+        std::thread reader([&] {
+            std::vector<uint8_t> buf(m.hdr->slotBytes - sizeof(frame_export::SlotHeader));
+            frame_export::SlotHeader meta;
+            uint64_t last = static_cast<uint64_t>(base);
+            while (!stop.load()) {
+                switch (frame_export::readLatest(m.hdr, last, meta, buf.data(), buf.size())) {
+                case frame_export::ReadResult::Ok:
+                    received[meta.frame].assign(buf.begin(), buf.begin() + meta.payloadBytes);
+                    last = meta.frame;
+                    break;
+                case frame_export::ReadResult::Lapped: ++lapped; break;
+                case frame_export::ReadResult::NoNewFrame: std::this_thread::yield(); break;
+                }
+            }
+        });
+
+        // ~250 fps of varying content (the telemetry speed moves several HUDs).
+        constexpr int kDraws = 500;
+        for (int i = 0; i < kDraws; ++i) {
+            host.telemetry(10.0f + static_cast<float>(i % 40), 3, static_cast<float>(i) * 0.004f);
+            host.draw();
+            std::this_thread::sleep_for(std::chrono::milliseconds(4));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stop.store(true);
+        reader.join();
+        host.setDrawObserver({});
+
+        CHECK(published() == base + kDraws);
+        int mismatched = 0;
+        for (const auto& kv : received) {
+            auto it = expected.find(kv.first);
+            if (it == expected.end() || it->second != kv.second) ++mismatched;
+        }
+        INFO("received " << received.size() << " / " << kDraws << ", lapped " << lapped);
+        CHECK(mismatched == 0);
+        CHECK(received.size() >= static_cast<size_t>(kDraws * 9 / 10));
+    }
+
+    // --- IMAGE --------------------------------------------------------------
+    {
+        setExport(2, 640);
+        host.draw();
+        Mapping img;
+        REQUIRE(img.open());
+        CHECK(img.hdr->format == frame_export::FORMAT_RGBA);
+        CHECK(img.hdr->width == 640u);
+        CHECK(img.hdr->height == 360u);
+        for (int i = 0; i < 20; ++i) {
+            host.draw();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        {
+            std::vector<uint8_t> buf(img.hdr->slotBytes - sizeof(frame_export::SlotHeader));
+            frame_export::SlotHeader meta;
+            REQUIRE(frame_export::readLatest(img.hdr, 0, meta, buf.data(), buf.size()) == frame_export::ReadResult::Ok);
+            CHECK(meta.payloadBytes == 640u * 360u * 4u);
+            CHECK(meta.quadCount > 0u);
+            // The HUD drew something over the backdrop (12,15,20,255).
+            bool nonBackdrop = false;
+            for (size_t p = 0; p + 3 < meta.payloadBytes && !nonBackdrop; p += 4)
+                nonBackdrop = buf[p] != 12 || buf[p + 1] != 15 || buf[p + 2] != 20;
+            CHECK(nonBackdrop);
+        }
+        CHECK(published() >= 1);
+    }
+
+    // --- OFF ----------------------------------------------------------------
+    setExport(0, 0);
+    host.draw();
+    const long long atOff = published();
+    for (int i = 0; i < 5; ++i) host.draw();
+    CHECK(published() == atOff);   // nothing published while off
+    HANDLE gone = OpenFileMappingA(FILE_MAP_READ, FALSE, frame_export::MAPPING_NAME);
+    CHECK(gone == nullptr);        // and the named object is gone with the last handle
+    if (gone) CloseHandle(gone);
+    host.shutdown();
+}
@@ -0,0 +1,106 @@
+// ============================================================================
+// tests/integration/tests/keyframe_test.cpp
+// State keyframes — starting a replay mid-session. Re-writes each golden tape
+// with a StateKeyframe (PluginData::writeKeyframe) every N seconds while
+// replaying it (PluginHost::keyframeTape), then, in a fresh plugin:
+//   - restoring each keyframe alone reproduces the /api/state snapshot the full
+//     replay had at that point;
+//   - restoring a mid-session keyframe and replaying only the tail ends on the
+//     same final snapshot as the full replay.
+// Wall-clock fields (event-log clockTime/clockMs, the overlay command sequence)
+// are stripped before comparing: they record when the replay ran, not the race.
+// See TESTING.md.
+// ============================================================================
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+#include "integration_main.h"
+#include "plugin_host.h"
+#include "assertions.h"
+
+#include <map>
+
+namespace {
+
+void stripWallClock(nlohmann::json& j) {
+    if (j.is_object()) {
+        j.erase("clockTime");
+        j.erase("clockMs");
+        if (j.contains("overlayCmd") && j["overlayCmd"].is_object()) j["overlayCmd"].erase("seq");
+        for (auto& v : j) stripWallClock(v);
+    } else if (j.is_array()) {
+        for (auto& v : j) stripWallClock(v);
+    }
+}
+
+nlohmann::json stableSnapshot(PluginHost& host) {
+    nlohmann::json d = host.snapshot();
+    stripWallClock(d);
+    return d;
+}
+
+void checkKeyframes(const char* name, const std::string& src, uint64_t intervalUs) {
+    const std::string dir = std::string("Z:\\tmp\\mxbmrp3-tests\\keyframe_") + name + "\\";
+    const std::string dst = "Z:\\tmp\\mxbmrp3-tests\\fixtures\\keyframed_" + std::string(name) + ".tape";
+    std::map<uint64_t, nlohmann::json> atKeyframe;
+    nlohmann::json finalState;
+
+    {
+        PluginHost host(dllPath());
+        REQUIRE(host.loaded());
+        host.startup(dir.c_str());
+        const int keyframes = host.keyframeTape(src, dst, intervalUs,
+            [&](uint64_t ts) { atKeyframe[ts] = stableSnapshot(host); });
+        REQUIRE(keyframes >= 2);
+        CHECK(keyframes == static_cast<int>(atKeyframe.size()));
+        finalState = stableSnapshot(host);
+        REQUIRE(finalState.is_object());
+        host.shutdown();
+    }
+
+    // The keyframed tape still replays from the start (keyframes are skipped).
+    {
+        PluginHost host(dllPath());
+        REQUIRE(host.loaded());
+        host.startup(dir.c_str());
+        CHECK(host.replayTape(dst) > 0);
+        CHECK((stableSnapshot(host) == finalState));
+        host.shutdown();
+    }
+
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    host.startup(dir.c_str());
+
+    // Before the first keyframe there is nothing to start from.
+    CHECK(host.replayTapeFrom(dst, atKeyframe.begin()->first - 1) == -1);
+
+    // Each keyframe on its own restores the state the full replay had there.
+    for (const auto& kf : atKeyframe) {
+        CAPTURE(kf.first);
+        CHECK(host.replayTapeFrom(dst, kf.first, kf.first) == 0);
+        CHECK((stableSnapshot(host) == kf.second));
+    }
+
+    // A mid-session keyframe plus the tail reaches the full replay's final state.
+    auto mid = atKeyframe.begin();
+    std::advance(mid, atKeyframe.size() / 2);
+    CHECK(host.replayTapeFrom(dst, mid->first + 1) > 0);
+    const nlohmann::json tail = stableSnapshot(host);
+    if (tail != finalState) {
+        const std::string diff = nlohmann::json::diff(finalState, tail).dump();
+        MESSAGE(diff);
+    }
+    CHECK((tail == finalState));
+
+    host.shutdown();
+}
+
+} // namespace
+
+TEST_CASE("keyframes: single-lap race restores mid-session") {
+    checkKeyframes("mxbclub", "Z:\\tmp\\mxbmrp3-tests\\fixtures\\race2_mxbclub_1lap.tape", 20ull * 1000000ull);
+}
+
+TEST_CASE("keyframes: 24-rider race restores mid-session") {
+    checkKeyframes("farm14", "Z:\\tmp\\mxbmrp3-tests\\fixtures\\race_farm14_24riders.tape", 60ull * 1000000ull);
+}
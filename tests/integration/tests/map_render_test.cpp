@@ -10,7 +10,10 @@
 //     round-trip (which forces the world cache to rebuild) and across visiting
 //     rotate / zoom (which must not corrupt the cache).
 // It also guards the degenerate-track NaN path: a valid 2D loop must never
-// produce a non-finite vertex.
+// produce a non-finite vertex. And a frame where only rider positions moved
+// redoes only the map's and radar's rider layers (their static-layer profile
+// phases stay at zero); a rotate-to-player map, which would rebuild in full,
+// skips those frames and redraws per batch; riders standing still redraw nothing.
 // Self-contained doctest; see run_tests.sh / TESTING.md.
 // ============================================================================
 #define DOCTEST_CONFIG_IMPLEMENT
@@ -342,3 +345,276 @@ TEST_CASE("map: degenerate 1D track renders finite (worldToScreen divide-by-zero
 
     host.shutdown();
 }
+
+TEST_CASE("map: zoom draws from the track-ribbon LOD pyramid built off-thread") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    REQUIRE(host.startup("Z:\\tmp\\mxbmrp3-tests\\map\\") >= 0);
+
+    auto MapVisible   = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetVisible");
+    auto MapZoom      = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetZoom");
+    auto MapStatsFn   = host.sym<PFN_MapQuadStats>("MXBMRP3_Test_MapQuadStats");
+    auto RibbonsWait  = host.sym<int(*)(int)>("MXBMRP3_Test_TrackRibbonsWait");
+    REQUIRE(MapVisible);
+    REQUIRE(MapZoom);
+    REQUIRE(MapStatsFn);
+    REQUIRE(RibbonsWait);
+
+    host.eventInit("PerfTrack", "Player");
+    host.raceEvent("PerfTrack");
+    host.session(6, 2);
+    host.addEntry(1, "Rider 1");
+    host.classify(6, 120000, { { .num = 1, .best = 90000, .gap = 0 } });
+    host.raceTrackPosition({ { .num = 1, .trackPos = 0.10f, .posX = 100.0f, .posZ = 50.0f, .yaw = 45.0f } });
+    MapVisible(1);
+    MapZoom(1);
+
+    CHECK(RibbonsWait(0) == -1);   // no track yet
+
+    auto read = [&]() -> MapStats {
+        host.draw();
+        MapStats s{};
+        s.count = MapStatsFn(&s.sumX, &s.sumY, &s.nonFinite);
+        CHECK(s.nonFinite == 0);
+        return s;
+    };
+
+    // The coarsest level is published synchronously with the track, so the very
+    // first zoomed frame already has a ribbon — whether or not the worker is done.
+    host.trackCenterline(circleTrack(), { 800.0f, 400.0f, 1200.0f, 0.0f });
+    MapStats first = read();
+    CHECK(first.count > 0);
+
+    // Once the full set lands the map re-emits from the nearest (finer) level:
+    // never fewer quads than the coarse fallback, and stable from then on.
+    REQUIRE(RibbonsWait(5000) == 1);
+    MapStats done = read();
+    MapStats again = read();
+    INFO("zoom quads: first=" << first.count << " complete=" << done.count);
+    CHECK(done.count >= first.count);
+    CHECK(again.count == done.count);
+    CHECK(again.sumX == doctest::Approx(done.sumX));
+
+    // A new track restarts the build; the old set must not come back.
+    host.trackCenterline(circleTrack(64, 4800.0f), { 2400.0f, 1200.0f, 3600.0f, 0.0f });
+    CHECK(read().count > 0);
+    REQUIRE(RibbonsWait(5000) == 1);
+    CHECK(read().count > 0);
+
+    MapZoom(0);
+    host.shutdown();
+}
+
+TEST_CASE("map: track geometry cache is written cold, read warm, and rebuilt when stale or corrupt") {
+    // The plugin creates <savePath>\mxbmrp3 but not savePath itself; the cache
+    // creates mxbmrp3\trackcache under it. Start from no cache at all.
+    namespace fs = std::filesystem;
+    const std::string savePath = "Z:\\tmp\\mxbmrp3-tests\\map-cache\\";
+    const std::string cacheFile = savePath + "mxbmrp3\\trackcache\\cachetrack.geo";
+    fs::remove_all(savePath + "mxbmrp3\\trackcache");
+    fs::create_directories(savePath);
+
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    REQUIRE(host.startup(savePath.c_str()) >= 0);
+
+    auto MapVisible   = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetVisible");
+    auto MapZoom      = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetZoom");
+    auto MapStatsFn   = host.sym<PFN_MapQuadStats>("MXBMRP3_Test_MapQuadStats");
+    auto RibbonsWait  = host.sym<int(*)(int)>("MXBMRP3_Test_TrackRibbonsWait");
+    REQUIRE(MapVisible);
+    REQUIRE(MapZoom);
+    REQUIRE(MapStatsFn);
+    REQUIRE(RibbonsWait);
+
+    // The cache is keyed by the track id (EventInit), so give this track one.
+    host.eventInit("CacheTrack", "Player", 1600.0f, 2, "Test 450", "cachetrack");
+    host.raceEvent("CacheTrack");
+    host.session(6, 2);
+    host.addEntry(1, "Rider 1");
+    host.classify(6, 120000, { { .num = 1, .best = 90000, .gap = 0 } });
+    host.raceTrackPosition({ { .num = 1, .trackPos = 0.10f, .posX = 100.0f, .posZ = 50.0f, .yaw = 45.0f } });
+    MapVisible(1);
+
+    // Default view (bounds, race markers from the arc table) + zoom (pyramid levels).
+    struct Views { MapStats def, zoom; };
+    auto read = [&]() -> Views {
+        Views v{};
+        MapZoom(0);
+        host.draw();
+        v.def.count = MapStatsFn(&v.def.sumX, &v.def.sumY, &v.def.nonFinite);
+        MapZoom(1);
+        host.draw();
+        v.zoom.count = MapStatsFn(&v.zoom.sumX, &v.zoom.sumY, &v.zoom.nonFinite);
+        CHECK(v.def.nonFinite == 0);
+        CHECK(v.zoom.nonFinite == 0);
+        return v;
+    };
+    auto same = [](const Views& a, const Views& b) {
+        CHECK(a.def.count == b.def.count);
+        CHECK(a.def.sumX == b.def.sumX);   // bit-identical: the cache stores what was built
+        CHECK(a.def.sumY == b.def.sumY);
+        CHECK(a.zoom.count == b.zoom.count);
+        CHECK(a.zoom.sumX == b.zoom.sumX);
+        CHECK(a.zoom.sumY == b.zoom.sumY);
+    };
+    const std::vector<float> markers = { 800.0f, 400.0f, 1200.0f, 0.0f };
+
+    // Cold: built on the worker, which writes the file before publishing.
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 1);
+    CHECK(fs::exists(cacheFile));
+    Views cold = read();
+    CHECK(cold.def.count > 0);
+    CHECK(cold.zoom.count > 0);
+
+    // Warm: the same centerline again is read back from the file, identically.
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 2);
+    same(read(), cold);
+
+    // A different centerline under the same id misses (segment hash) and
+    // overwrites the file; the original then misses once and is warm again.
+    host.trackCenterline(circleTrack(64, 4800.0f), { 2400.0f, 1200.0f, 3600.0f, 0.0f });
+    REQUIRE(RibbonsWait(5000) == 1);
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 1);
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 2);
+
+    // A truncated file is rejected (never read past its end) and rebuilt.
+    const auto fullSize = fs::file_size(cacheFile);
+    fs::resize_file(cacheFile, fullSize / 2);
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 1);
+    same(read(), cold);
+    CHECK(fs::file_size(cacheFile) == fullSize);
+    host.trackCenterline(circleTrack(), markers);
+    REQUIRE(RibbonsWait(5000) == 2);
+
+    MapZoom(0);
+    host.shutdown();
+}
+
+TEST_CASE("map + radar: a position-only frame rewrites only the rider layer") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    REQUIRE(host.startup("Z:\\tmp\\mxbmrp3-tests\\map\\") >= 0);
+
+    typedef long long (*PFN_MapProfile)(double*, double*, double*, double*, long long*, long long*);
+    typedef long long (*PFN_RadarProfile)(double*, double*);
+    auto MapVisible   = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetVisible");
+    auto MapRotate    = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetRotate");
+    auto RadarVisible = host.sym<PFN_MapI>("MXBMRP3_Test_RadarSetVisible");
+    auto MapProfile   = host.sym<PFN_MapProfile>("MXBMRP3_Test_MapProfile");
+    auto RadarProfile = host.sym<PFN_RadarProfile>("MXBMRP3_Test_RadarProfile");
+    auto MapStatsFn   = host.sym<PFN_MapQuadStats>("MXBMRP3_Test_MapQuadStats");
+    REQUIRE(MapVisible);
+    REQUIRE(MapRotate);
+    REQUIRE(RadarVisible);
+    REQUIRE(MapProfile);
+    REQUIRE(RadarProfile);
+    REQUIRE(MapStatsFn);
+
+    // The player (#1) with two riders a few meters behind, all heading north.
+    host.eventInit("PerfTrack", "Player");
+    host.raceEvent("PerfTrack");
+    host.session(6, 2);
+    host.addEntry(1, "Player");
+    host.addEntry(2, "Rider 2");
+    host.addEntry(3, "Rider 3");
+    host.trackCenterline(circleTrack(), { 800.0f, 400.0f, 1200.0f, 0.0f });
+    host.classify(6, 120000, {
+        { .num = 1, .best = 90000, .gap = 0 },
+        { .num = 2, .best = 90500, .gap = 500 },
+        { .num = 3, .best = 91000, .gap = 1000 },
+    });
+    auto batch = [&](float z) {
+        host.raceTrackPosition({
+            { .num = 1, .trackPos = 0.100f, .posX = 0.0f, .posZ = z, .yaw = 0.0f },
+            { .num = 2, .trackPos = 0.098f, .posX = 2.0f, .posZ = z - 4.0f, .yaw = 0.0f },
+            { .num = 3, .trackPos = 0.096f, .posX = -2.0f, .posZ = z - 8.0f, .yaw = 0.0f },
+        });
+    };
+    MapVisible(1);
+    RadarVisible(1);
+
+    // Two batches 30 ms apart give every rider a velocity (~30 m/s north); the
+    // frame after them is a full rebuild.
+    batch(100.0f);
+    host.draw();
+    Sleep(30);
+    batch(101.0f);
+    host.draw();
+
+    auto drawMarkerFrames = [&](int frames) {
+        double d = 0, dr = 0; long long l = 0;
+        MapProfile(&d, &d, &d, &d, &l, &l);
+        RadarProfile(&d, &dr);
+        int moved = 0;
+        double lastX = 0, lastY = 0;
+        MapStatsFn(&lastX, &lastY, nullptr);
+        for (int i = 0; i < frames; ++i) {
+            Sleep(2);   // all inside the 100 ms extrapolation window
+            host.draw();
+            double sx = 0, sy = 0;
+            MapStatsFn(&sx, &sy, nullptr);
+            if (sx != lastX || sy != lastY) ++moved;
+            lastX = sx; lastY = sy;
+        }
+        return moved;
+    };
+
+    // No callback between these frames: the dead-reckoned markers move on each,
+    // and only the rider layers are redone.
+    const int FRAMES = 5;
+    const int moved = drawMarkerFrames(FRAMES);
+    double bounds = -1, ribbon = -1, markers = -1, riders = -1; long long hits = 0, miss = 0;
+    const long long mapRenders = MapProfile(&bounds, &ribbon, &markers, &riders, &hits, &miss);
+    double radarStatic = -1, radarRiders = -1;
+    const long long radarRenders = RadarProfile(&radarStatic, &radarRiders);
+    CHECK(moved >= FRAMES - 1);
+    CHECK(mapRenders >= FRAMES - 1);
+    CHECK(bounds == 0.0);
+    CHECK(ribbon == 0.0);
+    CHECK(markers == 0.0);
+    CHECK(riders > 0.0);
+    CHECK(hits + miss == 0);   // the ribbon cache wasn't even consulted
+    CHECK(radarRenders >= FRAMES - 1);
+    CHECK(radarStatic == 0.0);
+    CHECK(radarRiders > 0.0);
+
+    // Rotate-to-player re-derives the view from the player's pose, so a motion
+    // push is a full rebuild: the map gets only new batches, while the radar
+    // keeps redrawing its rider layer every frame.
+    MapRotate(1);
+    batch(102.0f);
+    host.draw();
+    Sleep(30);
+    batch(103.0f);
+    host.draw();
+    const int rotatedMoved = drawMarkerFrames(3);
+    const long long rotatedRenders = MapProfile(&bounds, &ribbon, &markers, &riders, &hits, &miss);
+    CHECK(rotatedMoved == 0);
+    CHECK(rotatedRenders == 0);
+    CHECK(RadarProfile(&radarStatic, &radarRiders) >= 2);
+    batch(104.0f);
+    host.draw();
+    MapProfile(&bounds, &ribbon, &markers, &riders, &hits, &miss);
+    CHECK(bounds > 0.0);
+    CHECK(hits + miss > 0);
+    MapRotate(0);
+
+    // Riders standing still (the same position twice) aren't moving: after the
+    // batch's frame, neither HUD redraws anything.
+    batch(110.0f);
+    host.draw();
+    Sleep(30);
+    batch(110.0f);
+    host.draw();
+    CHECK(drawMarkerFrames(3) == 0);
+    CHECK(MapProfile(&bounds, &ribbon, &markers, &riders, &hits, &miss) == 0);
+    CHECK(RadarProfile(&radarStatic, &radarRiders) == 0);
+
+    host.shutdown();
+}
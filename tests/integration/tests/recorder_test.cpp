@@ -5,11 +5,14 @@
 //   1. DISABLED: with the recorder off (the default), the mxb_api taps do nothing
 //      and no tape is written (exercises the fast-path guards).
 //   2. FORMAT: with recording on, a known synthetic event stream produces a
-//      well-formed MXBHREC tape — asserted by parsing the RAW bytes (magic,
-//      framing, per-type counts, payload sizes, the compound RaceClassification /
-//      RaceTrackPosition packings, and RaceHoleshot).
+//      well-formed MXBHREC v2 tape — asserted on the decoded events (framing,
+//      per-type counts, payload sizes, the compound RaceClassification /
+//      RaceTrackPosition packings, and RaceHoleshot) and the block index.
 //   3. REPLAY: replaying that tape dispatches every event (including RaceHoleshot)
 //      and reconstructs the standings.
+// Along the way it checks the asynchronous write path: events reach the disk on
+// the FLUSH_INTERVAL time bound while recording is still running (crash-safety),
+// and the recorder's game-thread cost stats account for every event.
 //
 // IMPORTANT — this test uses exactly ONE PluginHost and calls shutdown() before it
 // unloads. Do NOT add a second host or drop the shutdown():
@@ -60,12 +63,23 @@ bool fileExists(const std::string& path) {
     return false;
 }
 
-// A parsed tape: the header + every [EventHeader, payload] framed to EOF. Uses the
-// harness's own tape:: structs (the byte-for-byte contract with the recorder), so
-// this validates the ON-DISK format directly, not just what replay reconstructs.
+// On-disk size via the directory entry: the recorder holds the tape open for
+// writing, which (secure CRT sharing) can refuse a second fopen.
+long long fileSize(const std::string& path) {
+    WIN32_FILE_ATTRIBUTE_DATA fa;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &fa)) return -1;
+    return (static_cast<long long>(fa.nFileSizeHigh) << 32) | fa.nFileSizeLow;
+}
+
+typedef void (*PFN_RecorderStats)(long long*, double*, double*, long long*);
+
+// A parsed tape: the header + every event, decoded through tape_io::Reader (the
+// same reader replay uses) and cross-checked against the v2 block index, so this
+// validates the ON-DISK container as well as what replay reconstructs.
 struct ParsedTape {
-    bool ok = false;               // magic + version valid and the framing walked cleanly to EOF
+    bool ok = false;               // v2 header valid, every block decoded, index consistent with them
     tape::FileHeader header{};
+    size_t blocks = 0;
     std::vector<tape::EventHeader> events;
     std::vector<std::vector<uint8_t>> payloads;   // parallel to events
 
@@ -84,25 +98,29 @@ struct ParsedTape {
 
 ParsedTape parseTape(const std::string& path) {
     ParsedTape p;
-    FILE* f = fopen(path.c_str(), "rb");
-    if (!f) return p;
-    std::vector<uint8_t> buf;
-    { char tmp[8192]; size_t r; while ((r = fread(tmp, 1, sizeof(tmp), f)) > 0) buf.insert(buf.end(), tmp, tmp + r); }
-    fclose(f);
-    if (buf.size() < sizeof(tape::FileHeader)) return p;
-    std::memcpy(&p.header, buf.data(), sizeof(tape::FileHeader));
-    if (std::memcmp(p.header.magic, "MXBHREC\0", 8) != 0 || p.header.version != 1) return p;
-    size_t off = sizeof(tape::FileHeader);
-    while (off + sizeof(tape::EventHeader) <= buf.size()) {
-        tape::EventHeader eh{};
-        std::memcpy(&eh, buf.data() + off, sizeof(eh));
-        off += sizeof(eh);
-        if (off + eh.dataSize > buf.size()) return p;   // truncated payload → framing broken
-        p.events.push_back(eh);
-        p.payloads.emplace_back(buf.begin() + off, buf.begin() + off + eh.dataSize);
-        off += eh.dataSize;
+    tape_io::Reader r;
+    if (!r.open(path.c_str())) return p;
+    std::memcpy(&p.header, r.headerBytes(), sizeof(tape::FileHeader));
+    if (p.header.version != tape_io::VERSION_BLOCKS) return p;   // the recorder writes v2
+    tape_io::EventFrame ev{};
+    const uint8_t* payload = nullptr;
+    while (r.next(ev, payload)) {
+        p.events.push_back({ ev.eventType, ev.dataSize, ev.timestampUs });
+        p.payloads.emplace_back(payload, payload + ev.dataSize);
+    }
+    p.blocks = r.blocksRead();
+
+    // The index must describe exactly the blocks just walked: contiguous event
+    // ordinals covering every event, first timestamps matching the events.
+    std::vector<tape_io::IndexEntry> index;
+    if (!r.readIndex(index) || index.size() != p.blocks) return p;
+    uint32_t next = 0;
+    for (const auto& e : index) {
+        if (e.firstEvent != next || e.firstEvent >= p.events.size() ||
+            e.firstTimestampUs != p.events[e.firstEvent].timestampUs) return p;
+        next += e.eventCount;
     }
-    p.ok = (off == buf.size());   // consumed exactly to EOF: every frame's size was right
+    p.ok = (next == p.events.size());
     return p;
 }
 }  // namespace
@@ -142,14 +160,40 @@ TEST_CASE("recorder: off writes nothing; on writes a well-formed tape that repla
     });
     h.raceTrackPosition({ {10, 0.9f}, {22, 0.6f}, {7, 0.3f} });  // 1x RaceTrackPosition (3)
     h.raceHoleshot(/*raceNum=*/10, /*timeMs=*/4200);   // 1x RaceHoleshot (recorded, no plugin action)
+
+    // Time-bounded crash safety: everything so far sits in the game thread's memory
+    // buffer. Once it has been collecting for FLUSH_INTERVAL (500 ms), the next event
+    // hands it to the writer thread, which puts it on disk while we are STILL
+    // recording - what an abnormal exit would leave behind.
+    const long long sizeBefore = fileSize(tape);
+    Sleep(600);
+    h.draw();                                          // + Draw events (not counted below)
+    long long sizeDuring = sizeBefore;
+    for (int i = 0; i < 100 && sizeDuring <= sizeBefore; ++i) {
+        Sleep(10);
+        sizeDuring = fileSize(tape);
+    }
+    CHECK(sizeDuring > sizeBefore);                    // flushed without a stop
     h.stopRecording();
 
-    // (3) FORMAT: parse the raw bytes and assert the on-disk framing is exactly right.
+    // (3) FORMAT: decode the tape and assert the on-disk framing is exactly right.
     ParsedTape t = parseTape(tape);
-    REQUIRE(t.ok);                                       // magic + version ok, framed cleanly to EOF
+    REQUIRE(t.ok);                                       // v2, every block decodes, index agrees
     REQUIRE(t.events.size() > 0);
     CHECK(t.header.numEvents == (uint32_t)t.events.size());   // finalized header count is self-consistent
 
+    // Game-thread cost accounting covers every event on the tape.
+    if (auto stats = h.sym<PFN_RecorderStats>("MXBMRP3_Test_RecorderStats")) {
+        long long events = 0, handoffs = 0;
+        double avgNs = 0.0, maxUs = 0.0;
+        stats(&events, &avgNs, &maxUs, &handoffs);
+        CHECK(events == (long long)t.events.size());
+        CHECK(avgNs > 0.0);
+        CHECK(maxUs >= avgNs / 1000.0);
+        CHECK(handoffs >= 1);                          // the time-bound handoff above
+        MESSAGE("recorder game-thread cost: " << avgNs << " ns/event avg, " << maxUs << " us max");
+    }
+
     CHECK(t.count(tape::EventType::EventInit)         == 1);
     CHECK(t.count(tape::EventType::RaceEvent)         == 1);
     CHECK(t.count(tape::EventType::RaceSession)       == 1);
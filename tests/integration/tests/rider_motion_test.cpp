@@ -0,0 +1,234 @@
+// ============================================================================
+// tests/integration/tests/rider_motion_test.cpp
+// Rider-marker dead reckoning (core/rider_motion.h) through the real callback
+// path. Synthesizes a tape of six riders lapping a circular track at 20-35 m/s,
+// their RaceTrackPosition batches at the game's ~30 Hz with +-1 ms delivery
+// jitter and a 300 ms dropout, then replays it with replayTapeTimed() at a
+// 250 Hz Draw cadence (the injected rider-motion clock follows the tape). At
+// every frame the marker each HUD was fed (MXBMRP3_Test_RiderMotionPredict) is
+// compared with the analytic position at that frame time:
+//   * while batches flow, the p99 marker error stays around a decimeter, an
+//     order of magnitude under holding the last sample (what the markers showed
+//     before: up to a whole batch interval of travel, ~1 m at these speeds);
+//   * in the dropout a marker coasts for MAX_EXTRAPOLATION_US and then holds,
+//     never running away;
+//   * the map's rider quads move between frames that got no new batch.
+// The committed fixture tapes carry no position batches (they're slimmed), so
+// the stream is built here. Self-contained doctest; see run_tests.sh / TESTING.md.
+// ============================================================================
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+#include "integration_main.h"
+#include "plugin_host.h"
+#include "tape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+typedef void (*PFN_MapI)(int);
+typedef int  (*PFN_MapQuadStats)(double*, double*, int*);
+typedef int  (*PFN_MotionPredict)(int, float*);
+
+namespace {
+
+constexpr double PI = 3.14159265358979;
+constexpr float TRACK_LENGTH = 1600.0f;
+constexpr double RADIUS = TRACK_LENGTH / (2.0 * PI);
+constexpr int RIDERS = 6;
+constexpr long long DRAW_TICK_MS = 4;      // 250 Hz
+constexpr long long TAPE_END_MS = 5000;
+constexpr long long DROPOUT_FROM_MS = 3000;
+constexpr long long DROPOUT_TO_MS = 3300;
+constexpr long long MAX_EXTRAPOLATION_MS = 100;   // RiderMotion::MAX_EXTRAPOLATION_US
+
+// Same loop as map_render_test: a circle of curve segments, S/F at 0 m.
+std::vector<TrackSegmentRow> circleTrack(int segs = 64) {
+    std::vector<TrackSegmentRow> v(segs);
+    for (int i = 0; i < segs; ++i) {
+        v[i].type = 1;
+        v[i].length = TRACK_LENGTH / segs;
+        v[i].radius = static_cast<float>(RADIUS);
+        v[i].angle = 0.0f;
+    }
+    return v;
+}
+
+double speedOf(int rider) { return 20.0 + 3.0 * rider; }   // m/s
+
+// Where rider `rider` (0-based) really is at tMs: clockwise round the circle.
+SPluginsRaceTrackPosition_t truth(int rider, double tMs) {
+    const double theta = rider * 0.9 + speedOf(rider) * tMs / 1000.0 / RADIUS;
+    SPluginsRaceTrackPosition_t p{};
+    p.m_iRaceNum = rider + 1;
+    p.m_fPosX = static_cast<float>(RADIUS * std::sin(theta));
+    p.m_fPosY = 0.0f;
+    p.m_fPosZ = static_cast<float>(RADIUS * std::cos(theta));
+    double yaw = std::fmod(theta * 180.0 / PI + 90.0, 360.0);
+    if (yaw > 180.0) yaw -= 360.0;
+    p.m_fYaw = static_cast<float>(yaw);
+    double pos = std::fmod(theta / (2.0 * PI), 1.0);
+    p.m_fTrackPos = static_cast<float>(pos < 0.0 ? pos + 1.0 : pos);
+    return p;
+}
+
+double distance(const float* predicted, const SPluginsRaceTrackPosition_t& t) {
+    return std::hypot(predicted[0] - t.m_fPosX, predicted[2] - t.m_fPosZ);
+}
+
+double quantile(std::vector<double> v, double q) {
+    std::sort(v.begin(), v.end());
+    return v[static_cast<size_t>(q * (v.size() - 1))];
+}
+
+struct Batch { long long sampleMs; long long arrivalMs; };
+
+}  // namespace
+
+TEST_CASE("rider motion: markers are dead-reckoned to each frame and hold after the window") {
+    PluginHost host(dllPath());
+    REQUIRE(host.loaded());
+    REQUIRE(host.startup("Z:\\tmp\\mxbmrp3-tests\\rider_motion\\") >= 0);
+
+    auto MapVisible = host.sym<PFN_MapI>("MXBMRP3_Test_MapSetVisible");
+    auto MapStatsFn = host.sym<PFN_MapQuadStats>("MXBMRP3_Test_MapQuadStats");
+    auto Predict = host.sym<PFN_MotionPredict>("MXBMRP3_Test_RiderMotionPredict");
+    REQUIRE(MapVisible);
+    REQUIRE(MapStatsFn);
+    REQUIRE(Predict);
+
+    host.eventInit("MotionTrack", "Player");
+    host.raceEvent("MotionTrack");
+    host.session(6, 2);
+    for (int i = 1; i <= RIDERS; ++i) host.addEntry(i, ("Rider " + std::to_string(i)).c_str());
+    host.trackCenterline(circleTrack(), { 0.0f, 400.0f, 1200.0f, 0.0f });
+    std::vector<ClassRow> rows;
+    for (int i = 1; i <= RIDERS; ++i) rows.push_back({ .num = i, .best = 90000 + i * 500, .gap = (i - 1) * 500 });
+    host.classify(6, 120000, rows);
+    MapVisible(1);
+    host.draw();
+
+    // --- The position stream: sampled every 1/30 s, delivered -1/0/+1 ms late. --
+    std::vector<Batch> batches;
+    for (int k = 0;; ++k) {
+        const long long sampleMs = std::llround(k * 1000.0 / 30.0);
+        if (sampleMs > TAPE_END_MS) break;
+        if (sampleMs > DROPOUT_FROM_MS && sampleMs < DROPOUT_TO_MS) continue;
+        batches.push_back({ sampleMs, std::max(0LL, sampleMs + (k % 3) - 1) });
+    }
+    const std::string tapePath = "Z:\\tmp\\mxbmrp3-tests\\rider_motion\\motion.rec";
+    {
+        tape::TapeWriter w;
+        REQUIRE(w.open(tapePath));
+        for (const Batch& b : batches) {
+            std::vector<SPluginsRaceTrackPosition_t> positions;
+            for (int r = 0; r < RIDERS; ++r) positions.push_back(truth(r, static_cast<double>(b.sampleMs)));
+            w.setTimestampUs(static_cast<uint64_t>(b.arrivalMs) * 1000u);
+            w.writeTrackPosition(positions);
+        }
+    }
+
+    // --- Observe every frame. A Draw tick at t runs before an event stamped t,
+    // so the batch on screen is the last one that arrived strictly before t. ---
+    std::vector<double> predictedErr, heldErr;
+    int movedFrames = 0, staleFrames = 0;
+    double lastSumX = 0.0, lastSumY = 0.0;
+    long long lastDropoutMs = -1;
+    std::vector<float> frozenAt, frozenLater;
+    long long lastArrivalBeforeDropout = 0;
+    for (const Batch& b : batches) {
+        if (b.arrivalMs <= DROPOUT_FROM_MS) lastArrivalBeforeDropout = b.arrivalMs;
+    }
+    size_t seen = 0;
+    long long seenAtLastFrame = -1;
+
+    host.setDrawObserver([&](long long simMs, int, const void*, int, const void*) {
+        while (seen < batches.size() && batches[seen].arrivalMs < simMs) ++seen;
+        if (seen < 3) return;   // velocity needs two samples; skip the first interval
+        const Batch& latest = batches[seen - 1];
+
+        double sumX = 0.0, sumY = 0.0;
+        int bad = 0;
+        MapStatsFn(&sumX, &sumY, &bad);
+        CHECK(bad == 0);
+        if (static_cast<long long>(seen) == seenAtLastFrame) {
+            ++staleFrames;
+            if (sumX != lastSumX || sumY != lastSumY) ++movedFrames;
+        }
+        seenAtLastFrame = static_cast<long long>(seen);
+        lastSumX = sumX;
+        lastSumY = sumY;
+
+        const long long sinceMs = simMs - latest.arrivalMs;
+        for (int r = 0; r < RIDERS; ++r) {
+            float out[5] = {};
+            REQUIRE(Predict(r + 1, out) == 1);
+            if (sinceMs <= 40) {
+                const SPluginsRaceTrackPosition_t now = truth(r, static_cast<double>(simMs));
+                predictedErr.push_back(distance(out, now));
+                const SPluginsRaceTrackPosition_t held = truth(r, static_cast<double>(latest.sampleMs));
+                const float heldPos[5] = { held.m_fPosX, held.m_fPosY, held.m_fPosZ, held.m_fYaw, held.m_fTrackPos };
+                heldErr.push_back(distance(heldPos, now));
+            }
+        }
+
+        // In the dropout: one frame just past the window, one near its end.
+        if (latest.arrivalMs == lastArrivalBeforeDropout && simMs > DROPOUT_FROM_MS) {
+            std::vector<float>* into = nullptr;
+            if (frozenAt.empty() && sinceMs > MAX_EXTRAPOLATION_MS) into = &frozenAt;
+            else if (sinceMs > 250) into = &frozenLater;
+            if (into) {
+                into->clear();
+                for (int r = 0; r < RIDERS; ++r) {
+                    float out[5] = {};
+                    Predict(r + 1, out);
+                    into->insert(into->end(), out, out + 5);
+                }
+            }
+            lastDropoutMs = simMs;
+        }
+    });
+    REQUIRE(host.replayTapeTimed(tapePath, DRAW_TICK_MS) == static_cast<int>(batches.size()));
+    host.setDrawObserver({});
+
+    REQUIRE(predictedErr.size() > 1000);
+    const double p50 = quantile(predictedErr, 0.5), p99 = quantile(predictedErr, 0.99);
+    const double maxErr = *std::max_element(predictedErr.begin(), predictedErr.end());
+    const double heldP50 = quantile(heldErr, 0.5), heldP99 = quantile(heldErr, 0.99);
+    printf("rider motion: %zu marker samples, error p50 %.3f m p99 %.3f m max %.3f m"
+           " (last-sample hold: p50 %.3f m p99 %.3f m); map moved on %d/%d frames without a batch\n",
+           predictedErr.size(), p50, p99, maxErr, heldP50, heldP99, movedFrames, staleFrames);
+
+    CHECK(p99 < 0.15);
+    CHECK(maxErr < 0.25);
+    CHECK(p50 * 5.0 < heldP50);
+    CHECK(p99 * 5.0 < heldP99);
+
+    // The map follows the prediction between batches: (almost) every frame that
+    // got no new batch still moved the rider quads. The few that don't are
+    // the dropout's held frames.
+    REQUIRE(staleFrames > 500);
+    CHECK(movedFrames > staleFrames * 8 / 10);
+
+    // Dropout: the markers coasted for the window, then froze where they were.
+    REQUIRE(lastDropoutMs > DROPOUT_FROM_MS + 250);
+    REQUIRE(frozenAt.size() == RIDERS * 5u);
+    REQUIRE(frozenLater.size() == RIDERS * 5u);
+    for (int r = 0; r < RIDERS; ++r) {
+        const float* a = &frozenAt[r * 5];
+        const float* b = &frozenLater[r * 5];
+        CHECK(a[0] == b[0]);
+        CHECK(a[2] == b[2]);
+        CHECK(a[4] == b[4]);
+        // ...no further than the window's worth of travel from the last sample.
+        const SPluginsRaceTrackPosition_t last = truth(r, static_cast<double>(
+            std::find_if(batches.rbegin(), batches.rend(), [&](const Batch& x) {
+                return x.arrivalMs == lastArrivalBeforeDropout; })->sampleMs));
+        const double coast = distance(a, last);
+        CHECK(coast <= speedOf(r) * 0.1 + 0.5);
+        CHECK(coast >= speedOf(r) * 0.1 - 0.5);
+    }
+    host.shutdown();
+}
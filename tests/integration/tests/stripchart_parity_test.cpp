@@ -3,14 +3,17 @@
 // Pins the rendered primitives of the four "strip chart" HUDs — Telemetry,
 // Rumble, Performance and Session Charts — whose shared grid-line / axis-label /
 // history-polyline blocks were consolidated into the BaseHud strip-chart helpers
-// (addStripChartFrame / addStripChartHistoryLine, base_hud.{h,cpp}). NOTE on
-// coverage: the deterministic setup keeps the rumble history deques EMPTY (rumble
-// processing is disabled for determinism) and telemetry draws its polylines via
-// its own inline multi-channel loop — so addStripChartHistoryLine's non-empty
-// path is pinned only lightly here; it was a verbatim move of RumbleHud's
-// addHistoryGraph, and its geometry math is what the frame/grid checks share.
-// There is no
-// pixel test for these HUDs, so this is the guard that the consolidation (and any
+// (addStripChartFrame / addStripChartHistoryLine, base_hud.{h,cpp}). Every
+// history trace now goes through addStripChartHistoryLine -> addPolyline, so the
+// Telemetry phase (eight channels over a fixed ramp) is what pins the non-empty
+// polyline path; the rumble history rings stay EMPTY (rumble processing is
+// disabled for determinism). The Telemetry and Session Charts quad fields were
+// re-pinned when the polylines were batched (collinear runs merge into one quad,
+// and telemetry's traces are drawn channel by channel rather than interleaved
+// per sample); their string fields did not move. The merge rules themselves are
+// checked in tests/unit/test_hud_sw_renderer.cpp, which rasterizes batched
+// polylines against one addLineSegment quad per segment. There is no pixel
+// test for these HUDs, so this is the guard that the consolidation (and any
 // future change to the shared helpers) is quad/string-identical: each HUD is
 // rendered alone from a deterministic synthetic session and its full primitive
 // fingerprint (counts + position/color/text checksums) is compared against golden
@@ -32,7 +35,7 @@
 //  * Telemetry: TelemetryHud clears the shared history buffers on show, so the
 //    fixed telemetry ramp is fed AFTER its phase INI is applied.
 //  * Rumble: rumble processing is disabled via the hook, so the effect history
-//    deques stay empty and the legend reads a constant 0% — the frame (grid +
+//    rings stay empty and the legend reads a constant 0% — the frame (grid +
 //    axis labels + bars + legend) is fully deterministic. The moved history-
 //    polyline path is exercised deterministically by the Telemetry HUD's traces
 //    (same emission math; Rumble's own traces depend on wall-clock effect state).
@@ -301,10 +304,10 @@ TEST_CASE("strip-chart HUDs: primitive parity goldens") {
         MESSAGE("telemetry:  " << fpStr(f));
         CHECK(fpStr(f2) == fpStr(f));         // stable across draws
         // GOLDEN(telemetry)
-        checkAgainst(f, { 102, 24,
-                          610.201179266, 436195095084.0, 0.0,
+        checkAgainst(f, { 34, 24,
+                          203.127387762, 144940802604.0, 0.0,
                           34.286767483, 85684202790.0, 24000.43, 14463422246.0,
-                          0xc53667d279d58c8cULL, 0x362ba1aa23bf7c7cULL });
+                          0xe15ddb9ee183e4fcULL, 0x362ba1aa23bf7c7cULL });
     }
 
     // =========================================================================
@@ -407,10 +410,10 @@ TEST_CASE("strip-chart HUDs: primitive parity goldens") {
         MESSAGE("charts:     " << fpStr(f));
         CHECK(fpStr(f2) == fpStr(f));
         // GOLDEN(charts)
-        checkAgainst(f, { 54, 66,
-                          295.355640173, 230722193649.0, 0.0,
+        checkAgainst(f, { 50, 66,
+                          276.338757157, 213567684279.0, 0.0,
                           97.364435256, 235651418535.0, 70801.06, 37242547186.0,
-                          0xeb4b86e9782e2853ULL, 0xf648732bd0d2f7e6ULL });
+                          0x5f0cd4cb6146291bULL, 0xf648732bd0d2f7e6ULL });
     }
 
     // --- Baseline again: phases must leave nothing behind -----------------------
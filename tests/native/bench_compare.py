@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# ============================================================================
+# tests/native/bench_compare.py [options] <results.json>...
+# Gates tape_bench runs against the committed baseline (bench_baseline.json).
+# Pass every run's JSON: repeated runs of the same tape are combined into a
+# median and a spread (max - min) per metric, and the spread is the noise
+# estimate.
+#
+# For each callback type and HUD, p50 and p99 are compared. A metric regresses
+# when current - baseline exceeds
+#     max(rel * baseline, floor, k * noise)
+# where rel is --rel-p50 / --rel-p99, floor is --floor-us (or two ticks of the
+# HUD timer's 1 us resolution), and noise is the larger of the baseline's and
+# this run's spread. Percentiles from too few samples are not gated: p99 needs
+# --min-p99-count samples and p50 needs --min-count. Baseline values are scaled
+# by the hosts' calibration ratio (calib_ns) first, so a faster or slower
+# machine does not read as a change.
+#
+#   bench_compare.py --baseline bench_baseline.json build/bench/*.json
+#   bench_compare.py --baseline bench_baseline.json --update build/bench/*.json
+#
+# Exit 0 = no regression, 1 = regression, 2 = usage / unreadable input.
+# ============================================================================
+import argparse, json, statistics, sys
+
+METRICS = ("p50_ns", "p99_ns")
+SECTIONS = ("callbacks", "huds_rebuild")
+
+
+def summarize(runs):
+    """{tape: {section: {name: {count, p50_ns: {median, spread}, ...}}}} + calib."""
+    grouped = {}
+    for r in runs:
+        grouped.setdefault(r["tape"], []).append(r)
+    tapes = {}
+    for tape, rs in sorted(grouped.items()):
+        out = {"runs": len(rs), "draw_hz": rs[0].get("draw_hz", 0), "huds": rs[0].get("huds", "")}
+        for sec in SECTIONS:
+            names = sorted({n for r in rs for n in r.get(sec, {})})
+            entries = {}
+            for n in names:
+                samples = [r[sec][n] for r in rs if n in r.get(sec, {})]
+                e = {"count": min(s["count"] for s in samples)}
+                for m in METRICS:
+                    vals = [s[m] for s in samples]
+                    e[m] = {"median": statistics.median(vals), "spread": max(vals) - min(vals)}
+                entries[n] = e
+            out[sec] = entries
+        tapes[tape] = out
+    calib = statistics.median(r["calib_ns"] for r in runs)
+    return {"schema": 1, "calib_ns": calib, "tapes": tapes}
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Gate tape_bench results against a baseline.")
+    ap.add_argument("results", nargs="+", help="tape_bench JSON files (repeated runs welcome)")
+    ap.add_argument("--baseline", required=True)
+    ap.add_argument("--update", action="store_true", help="write the results as the new baseline")
+    ap.add_argument("--rel-p50", type=float, default=0.15)
+    ap.add_argument("--rel-p99", type=float, default=0.30)
+    ap.add_argument("--floor-us", type=float, default=2.0)
+    ap.add_argument("--k", type=float, default=2.0, help="noise multiplier (x spread)")
+    ap.add_argument("--min-count", type=int, default=20)
+    ap.add_argument("--min-p99-count", type=int, default=200)
+    ap.add_argument("--no-scale", action="store_true", help="don't scale by calib_ns")
+    a = ap.parse_args()
+
+    try:
+        runs = [json.load(open(p)) for p in a.results]
+    except (OSError, ValueError) as e:
+        print(f"bench_compare: cannot read results: {e}")
+        return 2
+    cur = summarize(runs)
+
+    if a.update:
+        with open(a.baseline, "w") as f:
+            json.dump(cur, f, indent=1, sort_keys=True)
+            f.write("\n")
+        print(f"bench_compare: wrote {a.baseline} ({len(cur['tapes'])} tape(s), {len(runs)} run(s))")
+        return 0
+
+    try:
+        base = json.load(open(a.baseline))
+    except (OSError, ValueError) as e:
+        print(f"bench_compare: cannot read baseline: {e}")
+        return 2
+
+    scale = 1.0 if a.no_scale else cur["calib_ns"] / base["calib_ns"]
+    print(f"bench_compare: {len(runs)} run(s); host speed vs baseline x{scale:.2f}"
+          f"{' (scaling off)' if a.no_scale else ''}")
+
+    regressions, improvements, checked = [], [], 0
+    for tape, ct in cur["tapes"].items():
+        bt = base["tapes"].get(tape)
+        if bt is None:
+            print(f"  {tape}: not in baseline (new tape; run with --update to add it)")
+            continue
+        for sec in SECTIONS:
+            floor = a.floor_us * 1000.0
+            if sec == "huds_rebuild":
+                floor = max(floor, 2000.0)          # 1 us timer resolution
+            for name, ce in ct.get(sec, {}).items():
+                be = bt.get(sec, {}).get(name)
+                if be is None:
+                    continue
+                for m, rel, need in (("p50_ns", a.rel_p50, a.min_count),
+                                     ("p99_ns", a.rel_p99, a.min_p99_count)):
+                    if min(ce["count"], be["count"]) < need:
+                        continue
+                    b = be[m]["median"] * scale
+                    c = ce[m]["median"]
+                    noise = max(be[m]["spread"] * scale, ce[m]["spread"])
+                    allowed = max(rel * b, floor, a.k * noise)
+                    checked += 1
+                    row = (tape, sec, name, m[:-3], b / 1000.0, c / 1000.0, allowed / 1000.0)
+                    if c - b > allowed:
+                        regressions.append(row)
+                    elif b - c > allowed:
+                        improvements.append(row)
+        for sec in SECTIONS:
+            for name in bt.get(sec, {}):
+                if name not in ct.get(sec, {}):
+                    print(f"  {tape}: {sec} '{name}' missing from this run")
+
+    def show(title, rows):
+        print(f"\n{title}:")
+        print(f"  {'tape':<28} {'callback / HUD':<26} {'pct':<4} {'base us':>10} {'now us':>10} {'allowed':>9}")
+        for tape, sec, name, m, b, c, al in rows:
+            print(f"  {tape:<28} {name:<26} {m:<4} {b:>10.2f} {c:>10.2f} {al:>9.2f}")
+
+    if improvements:
+        show("faster than baseline (consider --update)", improvements)
+    if regressions:
+        show("REGRESSIONS", regressions)
+    print(f"\nbench_compare: {checked} percentiles checked, {len(regressions)} regression(s), "
+          f"{len(improvements)} improvement(s)")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,27 @@
+// ============================================================================
+// tests/native/platform/bcrypt.h
+// CNG for the native build. BCryptGenRandom is real (getrandom); the SHA-256
+// hash provider is not available, so BCryptOpenAlgorithmProvider fails and the
+// update installer's checksum path reports an error, as on a broken CNG.
+// ============================================================================
+#pragma once
+#include "windows.h"
+
+typedef PVOID BCRYPT_ALG_HANDLE;
+typedef PVOID BCRYPT_HASH_HANDLE;
+
+#define BCRYPT_SUCCESS(status) (((NTSTATUS)(status)) >= 0)
+#define BCRYPT_USE_SYSTEM_PREFERRED_RNG 0x00000002
+#define BCRYPT_SHA256_ALGORITHM L"SHA256"
+#define BCRYPT_OBJECT_LENGTH L"ObjectLength"
+#define BCRYPT_HASH_LENGTH L"HashDigestLength"
+
+NTSTATUS BCryptGenRandom(BCRYPT_ALG_HANDLE alg, PUCHAR buffer, ULONG length, ULONG flags);
+NTSTATUS BCryptOpenAlgorithmProvider(BCRYPT_ALG_HANDLE* alg, LPCWSTR algId, LPCWSTR impl, ULONG flags);
+NTSTATUS BCryptCloseAlgorithmProvider(BCRYPT_ALG_HANDLE alg, ULONG flags);
+NTSTATUS BCryptGetProperty(PVOID object, LPCWSTR property, PUCHAR output, ULONG length, ULONG* result, ULONG flags);
+NTSTATUS BCryptCreateHash(BCRYPT_ALG_HANDLE alg, BCRYPT_HASH_HANDLE* hash, PUCHAR object, ULONG objectLength,
+                          PUCHAR secret, ULONG secretLength, ULONG flags);
+NTSTATUS BCryptHashData(BCRYPT_HASH_HANDLE hash, PUCHAR input, ULONG length, ULONG flags);
+NTSTATUS BCryptFinishHash(BCRYPT_HASH_HANDLE hash, PUCHAR output, ULONG length, ULONG flags);
+NTSTATUS BCryptDestroyHash(BCRYPT_HASH_HANDLE hash);
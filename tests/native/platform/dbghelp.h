@@ -0,0 +1,16 @@
+// tests/native/platform/dbghelp.h - minidump API for the crash handler, which the
+// native build never arms (no SEH); declared so crash_handler.cpp compiles.
+#pragma once
+#include "windows.h"
+
+typedef enum _MINIDUMP_TYPE {
+    MiniDumpNormal = 0x0, MiniDumpWithDataSegs = 0x1, MiniDumpWithFullMemory = 0x2,
+    MiniDumpWithUnloadedModules = 0x20, MiniDumpWithIndirectlyReferencedMemory = 0x40,
+    MiniDumpWithProcessThreadData = 0x100, MiniDumpWithThreadInfo = 0x1000
+} MINIDUMP_TYPE;
+typedef struct _MINIDUMP_EXCEPTION_INFORMATION {
+    DWORD ThreadId; PEXCEPTION_POINTERS ExceptionPointers; BOOL ClientPointers;
+} MINIDUMP_EXCEPTION_INFORMATION, *PMINIDUMP_EXCEPTION_INFORMATION;
+
+BOOL MiniDumpWriteDump(HANDLE process, DWORD pid, HANDLE file, MINIDUMP_TYPE type,
+                       PMINIDUMP_EXCEPTION_INFORMATION exception, PVOID userStream, PVOID callback);
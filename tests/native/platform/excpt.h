@@ -0,0 +1,3 @@
+// tests/native/platform/excpt.h - SEH filter values live in windows.h here.
+#pragma once
+#include "windows.h"
@@ -0,0 +1,514 @@
+// ============================================================================
+// tests/native/platform/platform_posix.cpp
+// POSIX implementations of the Win32 surface declared in windows.h and its
+// companion headers. See windows.h for what is real and what fails gracefully.
+// ============================================================================
+#include "windows.h"
+#include "bcrypt.h"
+#include "dbghelp.h"
+#include "shellapi.h"
+#include "winhttp.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/random.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+thread_local DWORD t_lastError = ERROR_SUCCESS;
+
+// Maps errno onto the Win32 codes the plugin checks for.
+DWORD fromErrno(int e) {
+    switch (e) {
+        case 0: return ERROR_SUCCESS;
+        case ENOENT: return ERROR_FILE_NOT_FOUND;
+        case ENOTDIR: return ERROR_PATH_NOT_FOUND;
+        case EACCES: case EPERM: case EROFS: return ERROR_ACCESS_DENIED;
+        case EEXIST: return ERROR_ALREADY_EXISTS;
+        case EBADF: return ERROR_INVALID_HANDLE;
+        default: return ERROR_ACCESS_DENIED;
+    }
+}
+
+BOOL failErrno() {
+    t_lastError = fromErrno(errno);
+    return FALSE;
+}
+
+// 100 ns ticks between 1601-01-01 (FILETIME epoch) and 1970-01-01.
+constexpr uint64_t FILETIME_UNIX_OFFSET = 116444736000000000ull;
+
+FILETIME toFileTime(const struct timespec& ts) {
+    const uint64_t t = FILETIME_UNIX_OFFSET + static_cast<uint64_t>(ts.tv_sec) * 10000000ull +
+                       static_cast<uint64_t>(ts.tv_nsec) / 100;
+    FILETIME ft;
+    ft.dwLowDateTime = static_cast<DWORD>(t);
+    ft.dwHighDateTime = static_cast<DWORD>(t >> 32);
+    return ft;
+}
+
+void toSystemTime(const struct timespec& ts, bool local, LPSYSTEMTIME st) {
+    struct tm tm;
+    if (local) localtime_r(&ts.tv_sec, &tm); else gmtime_r(&ts.tv_sec, &tm);
+    st->wYear = static_cast<WORD>(tm.tm_year + 1900);
+    st->wMonth = static_cast<WORD>(tm.tm_mon + 1);
+    st->wDayOfWeek = static_cast<WORD>(tm.tm_wday);
+    st->wDay = static_cast<WORD>(tm.tm_mday);
+    st->wHour = static_cast<WORD>(tm.tm_hour);
+    st->wMinute = static_cast<WORD>(tm.tm_min);
+    st->wSecond = static_cast<WORD>(tm.tm_sec);
+    st->wMilliseconds = static_cast<WORD>(ts.tv_nsec / 1000000);
+}
+
+DWORD attributesOf(const struct stat& st) {
+    return S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY
+         : S_ISLNK(st.st_mode) ? FILE_ATTRIBUTE_REPARSE_POINT
+         : FILE_ATTRIBUTE_NORMAL;
+}
+
+// Handles: files are an fd, find handles an open directory plus the pattern.
+// Both live behind one heap object so CloseHandle/FindClose can tell them apart.
+struct NativeHandle {
+    enum Kind { File, Find } kind;
+    int fd = -1;
+    DIR* dir = nullptr;
+    std::string dirPath;   // directory being enumerated, with trailing '/'
+    std::string pattern;   // fnmatch pattern for entry names (may contain '\')
+    size_t prefixLen = 0;  // pattern chars before its last '\' (stripped from cFileName)
+};
+
+NativeHandle* asHandle(HANDLE h, NativeHandle::Kind kind) {
+    if (!h || h == INVALID_HANDLE_VALUE) return nullptr;
+    NativeHandle* n = static_cast<NativeHandle*>(h);
+    return n->kind == kind ? n : nullptr;
+}
+
+bool fillFindData(NativeHandle* h, LPWIN32_FIND_DATAA data) {
+    while (struct dirent* e = readdir(h->dir)) {
+        if (fnmatch(h->pattern.c_str(), e->d_name, FNM_NOESCAPE) != 0) continue;
+        struct stat st;
+        if (lstat((h->dirPath + e->d_name).c_str(), &st) != 0) continue;
+        memset(data, 0, sizeof(*data));
+        data->dwFileAttributes = attributesOf(st);
+        data->ftCreationTime = data->ftLastAccessTime = data->ftLastWriteTime = toFileTime(st.st_mtim);
+        data->nFileSizeHigh = static_cast<DWORD>(static_cast<uint64_t>(st.st_size) >> 32);
+        data->nFileSizeLow = static_cast<DWORD>(st.st_size);
+        strncpy_s(data->cFileName, sizeof(data->cFileName), e->d_name + h->prefixLen, _TRUNCATE);
+        return true;
+    }
+    t_lastError = ERROR_NO_MORE_FILES;
+    return false;
+}
+
+bool copyFile(const char* from, const char* to, bool failIfExists) {
+    const int in = open(from, O_RDONLY | O_CLOEXEC);
+    if (in < 0) return false;
+    const int out = open(to, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | (failIfExists ? O_EXCL : 0), 0644);
+    if (out < 0) { const int e = errno; close(in); errno = e; return false; }
+    char buf[64 * 1024];
+    bool ok = true;
+    for (ssize_t n; ok && (n = read(in, buf, sizeof(buf))) != 0;) {
+        if (n < 0) { ok = (errno == EINTR); continue; }
+        for (ssize_t off = 0; ok && off < n;) {
+            const ssize_t w = write(out, buf + off, static_cast<size_t>(n - off));
+            if (w < 0) ok = (errno == EINTR); else off += w;
+        }
+    }
+    const int e = errno;
+    close(in);
+    if (close(out) != 0) ok = false;
+    errno = e;
+    return ok;
+}
+
+// UTF-8 -> code points -> wchar_t (UTF-32 here), and back. Invalid bytes become
+// U+FFFD, as MultiByteToWideChar does without MB_ERR_INVALID_CHARS.
+size_t decodeUtf8(const unsigned char* s, size_t n, size_t& i) {
+    const unsigned char c = s[i++];
+    if (c < 0x80) return c;
+    const int extra = (c >= 0xF0 && c < 0xF8) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : -1;
+    if (extra < 0 || i + extra > n) return 0xFFFD;
+    size_t cp = c & (0x3F >> extra);
+    for (int k = 0; k < extra; ++k) {
+        if ((s[i] & 0xC0) != 0x80) return 0xFFFD;
+        cp = (cp << 6) | (s[i++] & 0x3F);
+    }
+    return cp;
+}
+
+size_t encodeUtf8(uint32_t cp, char* out) {
+    if (cp < 0x80) { out[0] = static_cast<char>(cp); return 1; }
+    if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+} // namespace
+
+// --- errors and processes ------------------------------------------------------
+DWORD GetLastError() { return t_lastError; }
+HANDLE GetCurrentProcess() { return reinterpret_cast<HANDLE>(static_cast<intptr_t>(-1)); }
+DWORD GetCurrentProcessId() { return static_cast<DWORD>(getpid()); }
+DWORD GetCurrentThreadId() { return static_cast<DWORD>(syscall(SYS_gettid)); }
+
+DWORD GetEnvironmentVariableA(LPCSTR name, LPSTR buffer, DWORD size) {
+    const char* v = getenv(name);
+    if (!v) { t_lastError = 203; return 0; }   // ERROR_ENVVAR_NOT_FOUND
+    const DWORD len = static_cast<DWORD>(strlen(v));
+    if (!buffer || size <= len) return len + 1;
+    memcpy(buffer, v, len + 1);
+    return len;
+}
+
+void OutputDebugStringA(LPCSTR) {}
+
+LONG InterlockedExchange(volatile LONG* target, LONG value) {
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+// --- clocks --------------------------------------------------------------------
+// QPC ticks are nanoseconds of CLOCK_MONOTONIC.
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    count->QuadPart = static_cast<LONGLONG>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* freq) {
+    freq->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+
+DWORD GetTickCount() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<DWORD>(static_cast<uint64_t>(ts.tv_sec) * 1000ull + static_cast<uint64_t>(ts.tv_nsec) / 1000000ull);
+}
+
+void GetLocalTime(LPSYSTEMTIME st) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    toSystemTime(ts, true, st);
+}
+
+void GetSystemTime(LPSYSTEMTIME st) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    toSystemTime(ts, false, st);
+}
+
+void GetSystemTimeAsFileTime(LPFILETIME ft) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    *ft = toFileTime(ts);
+}
+
+LONG CompareFileTime(const FILETIME* a, const FILETIME* b) {
+    const uint64_t x = (static_cast<uint64_t>(a->dwHighDateTime) << 32) | a->dwLowDateTime;
+    const uint64_t y = (static_cast<uint64_t>(b->dwHighDateTime) << 32) | b->dwLowDateTime;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+void Sleep(DWORD ms) {
+    struct timespec ts = { static_cast<time_t>(ms / 1000), static_cast<long>(ms % 1000) * 1000000L };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+// --- files and directories -------------------------------------------------------
+HANDLE CreateFileA(LPCSTR path, DWORD access, DWORD, LPSECURITY_ATTRIBUTES, DWORD disposition, DWORD, HANDLE) {
+    int flags = O_CLOEXEC;
+    if ((access & GENERIC_READ) && (access & GENERIC_WRITE)) flags |= O_RDWR;
+    else if (access & GENERIC_WRITE) flags |= O_WRONLY;
+    else flags |= O_RDONLY;
+    switch (disposition) {
+        case CREATE_NEW: flags |= O_CREAT | O_EXCL; break;
+        case CREATE_ALWAYS: flags |= O_CREAT | O_TRUNC; break;
+        case OPEN_ALWAYS: flags |= O_CREAT; break;
+        default: break;   // OPEN_EXISTING
+    }
+    const int fd = open(path, flags, 0644);
+    if (fd < 0) { failErrno(); return INVALID_HANDLE_VALUE; }
+    NativeHandle* h = new NativeHandle{NativeHandle::File};
+    h->fd = fd;
+    return h;
+}
+
+BOOL ReadFile(HANDLE h, LPVOID buffer, DWORD toRead, LPDWORD read, LPOVERLAPPED) {
+    NativeHandle* f = asHandle(h, NativeHandle::File);
+    if (read) *read = 0;
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    ssize_t n;
+    while ((n = ::read(f->fd, buffer, toRead)) < 0 && errno == EINTR) {}
+    if (n < 0) return failErrno();
+    if (read) *read = static_cast<DWORD>(n);
+    return TRUE;
+}
+
+BOOL WriteFile(HANDLE h, LPCVOID buffer, DWORD toWrite, LPDWORD written, LPOVERLAPPED) {
+    NativeHandle* f = asHandle(h, NativeHandle::File);
+    if (written) *written = 0;
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    DWORD done = 0;
+    while (done < toWrite) {
+        const ssize_t n = ::write(f->fd, static_cast<const char*>(buffer) + done, toWrite - done);
+        if (n < 0) { if (errno == EINTR) continue; return failErrno(); }
+        done += static_cast<DWORD>(n);
+    }
+    if (written) *written = done;
+    return TRUE;
+}
+
+BOOL GetFileSizeEx(HANDLE h, PLARGE_INTEGER size) {
+    NativeHandle* f = asHandle(h, NativeHandle::File);
+    struct stat st;
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    if (fstat(f->fd, &st) != 0) return failErrno();
+    size->QuadPart = st.st_size;
+    return TRUE;
+}
+
+BOOL CloseHandle(HANDLE h) {
+    NativeHandle* f = asHandle(h, NativeHandle::File);
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    const int rc = close(f->fd);
+    delete f;
+    return rc == 0 ? TRUE : failErrno();
+}
+
+DWORD GetFileAttributesA(LPCSTR path) {
+    struct stat st;
+    if (lstat(path, &st) != 0) { failErrno(); return INVALID_FILE_ATTRIBUTES; }
+    return attributesOf(st);
+}
+
+BOOL GetFileAttributesExA(LPCSTR path, GET_FILEEX_INFO_LEVELS, LPVOID info) {
+    struct stat st;
+    if (lstat(path, &st) != 0) return failErrno();
+    WIN32_FILE_ATTRIBUTE_DATA* d = static_cast<WIN32_FILE_ATTRIBUTE_DATA*>(info);
+    d->dwFileAttributes = attributesOf(st);
+    d->ftCreationTime = d->ftLastAccessTime = d->ftLastWriteTime = toFileTime(st.st_mtim);
+    d->nFileSizeHigh = static_cast<DWORD>(static_cast<uint64_t>(st.st_size) >> 32);
+    d->nFileSizeLow = static_cast<DWORD>(st.st_size);
+    return TRUE;
+}
+
+BOOL CreateDirectoryA(LPCSTR path, LPSECURITY_ATTRIBUTES) {
+    return mkdir(path, 0755) == 0 ? TRUE : failErrno();
+}
+BOOL RemoveDirectoryA(LPCSTR path) { return rmdir(path) == 0 ? TRUE : failErrno(); }
+BOOL DeleteFileA(LPCSTR path) { return unlink(path) == 0 ? TRUE : failErrno(); }
+
+BOOL CopyFileA(LPCSTR from, LPCSTR to, BOOL failIfExists) {
+    return copyFile(from, to, failIfExists != FALSE) ? TRUE : failErrno();
+}
+
+BOOL MoveFileA(LPCSTR from, LPCSTR to) {
+    struct stat st;
+    if (lstat(to, &st) == 0) { t_lastError = ERROR_ALREADY_EXISTS; return FALSE; }
+    return rename(from, to) == 0 ? TRUE : failErrno();
+}
+
+// rename(2) replaces atomically; MOVEFILE_WRITE_THROUGH maps to syncing the directory.
+BOOL MoveFileExA(LPCSTR from, LPCSTR to, DWORD flags) {
+    if (!(flags & MOVEFILE_REPLACE_EXISTING)) return MoveFileA(from, to);
+    if (rename(from, to) != 0) return failErrno();
+    if (flags & MOVEFILE_WRITE_THROUGH) {
+        const char* slash = strrchr(to, '/');
+        const std::string dir = slash ? std::string(to, slash - to + 1) : std::string(".");
+        const int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) { fsync(fd); close(fd); }
+    }
+    return TRUE;
+}
+
+// The pattern's directory is everything up to the last '/'; the rest (which may
+// hold the plugin's '\' separators - see windows.h) is matched against entry names.
+HANDLE FindFirstFileA(LPCSTR pattern, LPWIN32_FIND_DATAA data) {
+    const char* slash = strrchr(pattern, '/');
+    NativeHandle* h = new NativeHandle{NativeHandle::Find};
+    h->dirPath = slash ? std::string(pattern, slash - pattern + 1) : std::string("./");
+    h->pattern = slash ? slash + 1 : pattern;
+    const size_t bs = h->pattern.rfind('\\');
+    h->prefixLen = (bs == std::string::npos) ? 0 : bs + 1;
+    h->dir = opendir(h->dirPath.c_str());
+    if (!h->dir) { failErrno(); delete h; return INVALID_HANDLE_VALUE; }
+    if (!fillFindData(h, data)) {
+        closedir(h->dir);
+        delete h;
+        t_lastError = ERROR_FILE_NOT_FOUND;
+        return INVALID_HANDLE_VALUE;
+    }
+    return h;
+}
+
+BOOL FindNextFileA(HANDLE h, LPWIN32_FIND_DATAA data) {
+    NativeHandle* f = asHandle(h, NativeHandle::Find);
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    return fillFindData(f, data) ? TRUE : FALSE;
+}
+
+BOOL FindClose(HANDLE h) {
+    NativeHandle* f = asHandle(h, NativeHandle::Find);
+    if (!f) { t_lastError = ERROR_INVALID_HANDLE; return FALSE; }
+    closedir(f->dir);
+    delete f;
+    return TRUE;
+}
+
+// --- modules -------------------------------------------------------------------
+HMODULE GetModuleHandleA(LPCSTR) { t_lastError = 126; return nullptr; }   // ERROR_MOD_NOT_FOUND
+HMODULE GetModuleHandleW(LPCWSTR) { t_lastError = 126; return nullptr; }
+BOOL GetModuleHandleExA(DWORD, LPCSTR, HMODULE* module) {
+    if (module) *module = nullptr;
+    t_lastError = 126;
+    return FALSE;
+}
+DWORD GetModuleFileNameA(HMODULE, LPSTR buffer, DWORD size) {
+    if (buffer && size) buffer[0] = '\0';
+    t_lastError = 126;
+    return 0;
+}
+FARPROC GetProcAddress(HMODULE, LPCSTR) { t_lastError = 127; return nullptr; }   // ERROR_PROC_NOT_FOUND
+
+// --- text ----------------------------------------------------------------------
+// Only CP_UTF8 is used by the plugin. Lengths of -1 include the terminator.
+int MultiByteToWideChar(UINT, DWORD, LPCSTR src, int srcLen, LPWSTR dst, int dstLen) {
+    const size_t n = srcLen < 0 ? strlen(src) + 1 : static_cast<size_t>(srcLen);
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(src);
+    int out = 0;
+    for (size_t i = 0; i < n;) {
+        const size_t cp = decodeUtf8(s, n, i);
+        if (dstLen > 0) {
+            if (out >= dstLen) { t_lastError = ERROR_INSUFFICIENT_BUFFER; return 0; }
+            dst[out] = static_cast<wchar_t>(cp);
+        }
+        ++out;
+    }
+    return out;
+}
+
+int WideCharToMultiByte(UINT, DWORD, LPCWSTR src, int srcLen, LPSTR dst, int dstLen, LPCSTR, BOOL* usedDefault) {
+    const size_t n = srcLen < 0 ? wcslen(src) + 1 : static_cast<size_t>(srcLen);
+    if (usedDefault) *usedDefault = FALSE;
+    int out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char buf[4];
+        const size_t len = encodeUtf8(static_cast<uint32_t>(src[i]), buf);
+        if (dstLen > 0) {
+            if (out + static_cast<int>(len) > dstLen) { t_lastError = ERROR_INSUFFICIENT_BUFFER; return 0; }
+            memcpy(dst + out, buf, len);
+        }
+        out += static_cast<int>(len);
+    }
+    return out;
+}
+
+int GetUserDefaultLocaleName(LPWSTR name, int size) {
+    static const wchar_t kLocale[] = L"en-US";
+    if (size < static_cast<int>(sizeof(kLocale) / sizeof(wchar_t))) { t_lastError = ERROR_INSUFFICIENT_BUFFER; return 0; }
+    wcscpy(name, kLocale);
+    return static_cast<int>(sizeof(kLocale) / sizeof(wchar_t));
+}
+
+// --- registry, console, exceptions (absent) -----------------------------------------
+LSTATUS RegOpenKeyExA(HKEY, LPCSTR, DWORD, DWORD, PHKEY result) {
+    if (result) *result = nullptr;
+    return ERROR_FILE_NOT_FOUND;
+}
+LSTATUS RegQueryValueExA(HKEY, LPCSTR, LPDWORD, LPDWORD, LPBYTE, LPDWORD) { return ERROR_FILE_NOT_FOUND; }
+LSTATUS RegCloseKey(HKEY) { return ERROR_SUCCESS; }
+
+HWND GetConsoleWindow() { return nullptr; }
+
+LPTOP_LEVEL_EXCEPTION_FILTER SetUnhandledExceptionFilter(LPTOP_LEVEL_EXCEPTION_FILTER) { return nullptr; }
+BOOL MiniDumpWriteDump(HANDLE, DWORD, HANDLE, MINIDUMP_TYPE, PMINIDUMP_EXCEPTION_INFORMATION, PVOID, PVOID) {
+    t_lastError = ERROR_NOT_SUPPORTED;
+    return FALSE;
+}
+
+// --- desktop (no keyboard, mouse, windows or display) ---------------------------------
+SHORT GetAsyncKeyState(int) { return 0; }
+BOOL GetCursorPos(LPPOINT pt) { pt->x = pt->y = 0; return FALSE; }
+BOOL ScreenToClient(HWND, LPPOINT) { return FALSE; }
+HWND WindowFromPoint(POINT) { return nullptr; }
+HWND GetForegroundWindow() { return nullptr; }
+HWND GetAncestor(HWND, UINT) { return nullptr; }
+DWORD GetWindowThreadProcessId(HWND, LPDWORD pid) { if (pid) *pid = 0; return 0; }
+BOOL IsWindow(HWND) { return FALSE; }
+BOOL GetClientRect(HWND, LPRECT rect) { memset(rect, 0, sizeof(*rect)); return FALSE; }
+HDC GetDC(HWND) { return nullptr; }
+int ReleaseDC(HWND, HDC) { return 0; }
+HDC CreateCompatibleDC(HDC) { return nullptr; }
+BOOL DeleteDC(HDC) { return FALSE; }
+HBITMAP CreateCompatibleBitmap(HDC, int, int) { return nullptr; }
+HGDIOBJ SelectObject(HDC, HGDIOBJ) { return nullptr; }
+BOOL DeleteObject(HGDIOBJ) { return FALSE; }
+HINSTANCE ShellExecuteA(HWND, LPCSTR, LPCSTR, LPCSTR, LPCSTR, int) {
+    return reinterpret_cast<HINSTANCE>(static_cast<intptr_t>(ERROR_FILE_NOT_FOUND));   // <= 32: failure
+}
+
+// --- network and crypto ----------------------------------------------------------
+
+// No network: every session open fails as if WinHTTP were unavailable.
+HINTERNET WinHttpOpen(LPCWSTR, DWORD, LPCWSTR, LPCWSTR, DWORD) { t_lastError = ERROR_NOT_SUPPORTED; return nullptr; }
+HINTERNET WinHttpConnect(HINTERNET, LPCWSTR, INTERNET_PORT, DWORD) { t_lastError = ERROR_INVALID_HANDLE; return nullptr; }
+HINTERNET WinHttpOpenRequest(HINTERNET, LPCWSTR, LPCWSTR, LPCWSTR, LPCWSTR, LPCWSTR*, DWORD) {
+    t_lastError = ERROR_INVALID_HANDLE;
+    return nullptr;
+}
+BOOL WinHttpCloseHandle(HINTERNET) { return TRUE; }
+BOOL WinHttpSetTimeouts(HINTERNET, int, int, int, int) { return FALSE; }
+BOOL WinHttpSetOption(HINTERNET, DWORD, LPVOID, DWORD) { return FALSE; }
+BOOL WinHttpAddRequestHeaders(HINTERNET, LPCWSTR, DWORD, DWORD) { return FALSE; }
+BOOL WinHttpSendRequest(HINTERNET, LPCWSTR, DWORD, LPVOID, DWORD, DWORD, DWORD_PTR) { return FALSE; }
+BOOL WinHttpReceiveResponse(HINTERNET, LPVOID) { return FALSE; }
+BOOL WinHttpQueryHeaders(HINTERNET, DWORD, LPCWSTR, LPVOID, LPDWORD, LPDWORD) { return FALSE; }
+BOOL WinHttpQueryDataAvailable(HINTERNET, LPDWORD available) { if (available) *available = 0; return FALSE; }
+BOOL WinHttpReadData(HINTERNET, LPVOID, DWORD, LPDWORD read) { if (read) *read = 0; return FALSE; }
+
+NTSTATUS BCryptGenRandom(BCRYPT_ALG_HANDLE, PUCHAR buffer, ULONG length, ULONG) {
+    for (ULONG done = 0; done < length;) {
+        const ssize_t n = getrandom(buffer + done, length - done, 0);
+        if (n < 0) { if (errno == EINTR) continue; return static_cast<NTSTATUS>(0xC0000001L); }   // STATUS_UNSUCCESSFUL
+        done += static_cast<ULONG>(n);
+    }
+    return 0;
+}
+
+// No hash provider (see bcrypt.h).
+NTSTATUS BCryptOpenAlgorithmProvider(BCRYPT_ALG_HANDLE* alg, LPCWSTR, LPCWSTR, ULONG) {
+    if (alg) *alg = nullptr;
+    return static_cast<NTSTATUS>(0xC0000225L);   // STATUS_NOT_FOUND
+}
+NTSTATUS BCryptCloseAlgorithmProvider(BCRYPT_ALG_HANDLE, ULONG) { return 0; }
+NTSTATUS BCryptGetProperty(PVOID, LPCWSTR, PUCHAR, ULONG, ULONG*, ULONG) { return static_cast<NTSTATUS>(0xC0000008L); }
+NTSTATUS BCryptCreateHash(BCRYPT_ALG_HANDLE, BCRYPT_HASH_HANDLE*, PUCHAR, ULONG, PUCHAR, ULONG, ULONG) {
+    return static_cast<NTSTATUS>(0xC0000008L);   // STATUS_INVALID_HANDLE
+}
+NTSTATUS BCryptHashData(BCRYPT_HASH_HANDLE, PUCHAR, ULONG, ULONG) { return static_cast<NTSTATUS>(0xC0000008L); }
+NTSTATUS BCryptFinishHash(BCRYPT_HASH_HANDLE, PUCHAR, ULONG, ULONG) { return static_cast<NTSTATUS>(0xC0000008L); }
+NTSTATUS BCryptDestroyHash(BCRYPT_HASH_HANDLE) { return 0; }
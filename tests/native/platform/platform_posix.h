@@ -0,0 +1,57 @@
+// ============================================================================
+// tests/native/platform/platform_posix.h
+// Force-included (-include) into every TU of the native build, ahead of the
+// plugin's own headers. Supplies the MSVC CRT extensions the plugin calls
+// (Annex-K *_s functions, _stricmp, errno_t) with MSVC semantics, and clears
+// glibc's CHAR_WIDTH macro (<limits.h>, C2x) which would otherwise rewrite
+// plugin_constants.h's CHAR_WIDTH constant. Win32 itself is in windows.h.
+// ============================================================================
+#pragma once
+
+#include <limits.h>
+#undef CHAR_WIDTH
+
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <strings.h>
+
+// strncpy_s / strcpy_s / _TRUNCATE, shared with the ASan harness.
+#include "../../asan/msvc_compat.h"
+
+typedef int errno_t;
+
+// The C++ array-size overloads MSVC adds on top of Annex K.
+template <size_t N>
+static inline errno_t strncpy_s(char (&dest)[N], const char* src, size_t count) {
+    return strncpy_s(dest, N, src, count);
+}
+template <size_t N>
+static inline errno_t strcpy_s(char (&dest)[N], const char* src) {
+    return strcpy_s(dest, N, src);
+}
+
+static inline errno_t localtime_s(struct tm* out, const time_t* t) {
+    return (out && t && localtime_r(t, out)) ? 0 : 22;
+}
+
+static inline errno_t gmtime_s(struct tm* out, const time_t* t) {
+    return (out && t && gmtime_r(t, out)) ? 0 : 22;
+}
+
+static inline errno_t fopen_s(FILE** f, const char* path, const char* mode) {
+    if (!f) return 22;
+    *f = fopen(path, mode);
+    return *f ? 0 : 2;
+}
+
+static inline int _snprintf_s(char* buf, size_t size, size_t /*count*/, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return (n < 0 || static_cast<size_t>(n) >= size) ? -1 : n;
+}
+
+static inline int _stricmp(const char* a, const char* b) { return strcasecmp(a, b); }
+static inline int _strnicmp(const char* a, const char* b, size_t n) { return strncasecmp(a, b, n); }
@@ -0,0 +1,6 @@
+// tests/native/platform/shellapi.h - ShellExecute for the native build; opening
+// a URL or folder is a desktop action and fails (returns an error HINSTANCE).
+#pragma once
+#include "windows.h"
+
+HINSTANCE ShellExecuteA(HWND hwnd, LPCSTR op, LPCSTR file, LPCSTR params, LPCSTR dir, int show);
@@ -0,0 +1,354 @@
+// ============================================================================
+// tests/native/platform/windows.h
+// POSIX platform layer for the native (g++/clang, no Wine) build of the core.
+// Stands in for <windows.h>: the Win32 types, constants and functions the
+// plugin's TUs use, declared here and implemented in platform_posix.cpp.
+//
+// Services the core depends on for its hot paths are real: the clocks
+// (QueryPerformanceCounter, GetTickCount, GetLocalTime, ...), Sleep, files and
+// directories, UTF-8 <-> wide conversion, and BCryptGenRandom. Services that
+// only exist on a Windows desktop fail the way they do on a machine without
+// them: no window, no console, no keys down, no network (WinHTTP opens fail),
+// no registry, no steam_api64.dll (module lookups return null). Paths keep the
+// plugin's '\' separators verbatim, so a save tree lands as flat names like
+// "mxbmrp3\mxbmrp3_settings.ini" inside the save directory - consistent for
+// reads and writes, and nothing outside it is touched.
+//
+// Values of the constants match the Windows SDK where they are persisted or
+// compared (virtual-key codes, error codes, attributes); the layer is only ever
+// compiled for the native build (tests/native/Makefile).
+// ============================================================================
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <ctime>
+
+// --- base types --------------------------------------------------------------
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef BYTE* LPBYTE;
+typedef unsigned char UCHAR;
+typedef BYTE* PUCHAR;
+typedef short SHORT;
+typedef unsigned short WORD;
+typedef unsigned int DWORD;          // 32-bit as on Windows (LLP64), not unsigned long
+typedef DWORD* LPDWORD;
+typedef int LONG;
+typedef unsigned int ULONG;
+typedef ULONG* PULONG;
+typedef int64_t LONGLONG;
+typedef uint64_t ULONGLONG;
+typedef uint64_t DWORD64;
+typedef uint64_t ULONG64;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef intptr_t LONG_PTR;
+typedef uintptr_t UINT_PTR;
+typedef intptr_t INT_PTR;
+typedef unsigned int UINT;
+typedef float FLOAT;
+typedef size_t SIZE_T;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef const char* LPCSTR;
+typedef char* LPSTR;
+typedef const wchar_t* LPCWSTR;
+typedef wchar_t* LPWSTR;
+typedef void* LPVOID;
+typedef void* PVOID;
+typedef const void* LPCVOID;
+typedef long HRESULT;
+typedef LONG NTSTATUS;
+typedef LONG LSTATUS;
+
+typedef void* HANDLE;
+typedef HANDLE HWND;
+typedef HANDLE HDC;
+typedef HANDLE HMODULE;
+typedef HANDLE HINSTANCE;
+typedef HANDLE HBITMAP;
+typedef HANDLE HGDIOBJ;
+typedef HANDLE HKEY;
+typedef HKEY* PHKEY;
+typedef intptr_t (*FARPROC)();
+
+#define WINAPI
+#ifndef __cdecl
+#define __cdecl
+#endif
+
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define INVALID_FILE_ATTRIBUTES ((DWORD)-1)
+
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define ZeroMemory(p, n) memset((p), 0, (n))
+
+// --- structures --------------------------------------------------------------
+typedef union _LARGE_INTEGER { struct { DWORD LowPart; LONG HighPart; }; LONGLONG QuadPart; } LARGE_INTEGER, *PLARGE_INTEGER;
+typedef union _ULARGE_INTEGER { struct { DWORD LowPart; DWORD HighPart; }; ULONGLONG QuadPart; } ULARGE_INTEGER, *PULARGE_INTEGER;
+typedef struct tagRECT { LONG left, top, right, bottom; } RECT, *LPRECT;
+typedef const RECT* LPCRECT;
+typedef struct tagPOINT { LONG x, y; } POINT, *LPPOINT;
+typedef struct tagSIZE { LONG cx, cy; } SIZE;
+typedef struct _FILETIME { DWORD dwLowDateTime, dwHighDateTime; } FILETIME, *LPFILETIME;
+typedef struct _SYSTEMTIME { WORD wYear, wMonth, wDayOfWeek, wDay, wHour, wMinute, wSecond, wMilliseconds; } SYSTEMTIME, *LPSYSTEMTIME;
+typedef struct _SECURITY_ATTRIBUTES { DWORD nLength; LPVOID lpSecurityDescriptor; BOOL bInheritHandle; } SECURITY_ATTRIBUTES, *LPSECURITY_ATTRIBUTES;
+typedef struct _OVERLAPPED { ULONG_PTR Internal, InternalHigh; DWORD Offset, OffsetHigh; HANDLE hEvent; } OVERLAPPED, *LPOVERLAPPED;
+typedef struct _WIN32_FIND_DATAA {
+    DWORD dwFileAttributes; FILETIME ftCreationTime, ftLastAccessTime, ftLastWriteTime;
+    DWORD nFileSizeHigh, nFileSizeLow, dwReserved0, dwReserved1;
+    CHAR cFileName[MAX_PATH]; CHAR cAlternateFileName[14];
+} WIN32_FIND_DATAA, *LPWIN32_FIND_DATAA;
+typedef struct _WIN32_FIND_DATAW {
+    DWORD dwFileAttributes; FILETIME ftCreationTime, ftLastAccessTime, ftLastWriteTime;
+    DWORD nFileSizeHigh, nFileSizeLow, dwReserved0, dwReserved1;
+    WCHAR cFileName[MAX_PATH]; WCHAR cAlternateFileName[14];
+} WIN32_FIND_DATAW, *LPWIN32_FIND_DATAW;
+typedef struct _WIN32_FILE_ATTRIBUTE_DATA {
+    DWORD dwFileAttributes; FILETIME ftCreationTime, ftLastAccessTime, ftLastWriteTime;
+    DWORD nFileSizeHigh, nFileSizeLow;
+} WIN32_FILE_ATTRIBUTE_DATA;
+typedef enum _GET_FILEEX_INFO_LEVELS { GetFileExInfoStandard, GetFileExMaxInfoLevel } GET_FILEEX_INFO_LEVELS;
+
+
+
+// Exceptions (crash handler): never raised natively - no SEH.
+typedef struct _CONTEXT { DWORD64 Rip, Rsp, Rbp; } CONTEXT, *PCONTEXT;
+typedef struct _EXCEPTION_RECORD {
+    DWORD ExceptionCode, ExceptionFlags; struct _EXCEPTION_RECORD* ExceptionRecord; PVOID ExceptionAddress;
+    DWORD NumberParameters; ULONG_PTR ExceptionInformation[15];
+} EXCEPTION_RECORD, *PEXCEPTION_RECORD;
+typedef struct _EXCEPTION_POINTERS { PEXCEPTION_RECORD ExceptionRecord; PCONTEXT ContextRecord; } EXCEPTION_POINTERS, *PEXCEPTION_POINTERS, *LPEXCEPTION_POINTERS;
+typedef LONG (WINAPI *PTOP_LEVEL_EXCEPTION_FILTER)(EXCEPTION_POINTERS*);
+typedef PTOP_LEVEL_EXCEPTION_FILTER LPTOP_LEVEL_EXCEPTION_FILTER;
+typedef LONG (WINAPI *PVECTORED_EXCEPTION_HANDLER)(EXCEPTION_POINTERS*);
+#define EXCEPTION_EXECUTE_HANDLER 1
+#define EXCEPTION_CONTINUE_SEARCH 0
+#define EXCEPTION_ACCESS_VIOLATION 0xC0000005u
+
+// PE image headers (the logger/crash handler inspect the host module; natively
+// GetModuleHandle returns null, so these are only ever type-checked).
+typedef struct _IMAGE_DOS_HEADER { WORD e_magic; WORD e_pad[29]; LONG e_lfanew; } IMAGE_DOS_HEADER, *PIMAGE_DOS_HEADER;
+typedef struct _IMAGE_FILE_HEADER {
+    WORD Machine, NumberOfSections; DWORD TimeDateStamp, PointerToSymbolTable, NumberOfSymbols;
+    WORD SizeOfOptionalHeader, Characteristics;
+} IMAGE_FILE_HEADER;
+typedef struct _IMAGE_NT_HEADERS64 { DWORD Signature; IMAGE_FILE_HEADER FileHeader; } IMAGE_NT_HEADERS64, IMAGE_NT_HEADERS, *PIMAGE_NT_HEADERS;
+#define IMAGE_DOS_SIGNATURE 0x5A4D
+#define IMAGE_NT_SIGNATURE 0x00004550
+
+// --- constants -------------------------------------------------------------
+#define ERROR_SUCCESS 0L
+#define ERROR_FILE_NOT_FOUND 2L
+#define ERROR_PATH_NOT_FOUND 3L
+#define ERROR_ACCESS_DENIED 5L
+#define ERROR_INVALID_HANDLE 6L
+#define ERROR_NOT_SUPPORTED 50L
+#define ERROR_SHARING_VIOLATION 32L
+#define ERROR_LOCK_VIOLATION 33L
+#define ERROR_FILE_EXISTS 80L
+#define ERROR_INSUFFICIENT_BUFFER 122L
+#define ERROR_ALREADY_EXISTS 183L
+#define ERROR_NO_MORE_FILES 18L
+#define ERROR_DEVICE_NOT_CONNECTED 1167L
+
+#define FILE_ATTRIBUTE_READONLY 0x1
+#define FILE_ATTRIBUTE_DIRECTORY 0x10
+#define FILE_ATTRIBUTE_NORMAL 0x80
+#define FILE_ATTRIBUTE_REPARSE_POINT 0x400
+#define GENERIC_READ 0x80000000u
+#define GENERIC_WRITE 0x40000000u
+#define FILE_SHARE_READ 0x1
+#define FILE_SHARE_WRITE 0x2
+#define FILE_SHARE_DELETE 0x4
+#define CREATE_NEW 1
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define OPEN_ALWAYS 4
+#define MOVEFILE_REPLACE_EXISTING 0x1
+#define MOVEFILE_WRITE_THROUGH 0x8
+#define GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT 0x2
+#define GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS 0x4
+#define STD_OUTPUT_HANDLE ((DWORD)-11)
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#define CP_UTF8 65001
+#define LOCALE_NAME_MAX_LENGTH 85
+
+#define HKEY_LOCAL_MACHINE ((HKEY)(ULONG_PTR)0x80000002)
+#define KEY_READ 0x20019
+#define KEY_WOW64_64KEY 0x0100
+
+#define UNW_FLAG_NHANDLER 0x0
+
+// Window manager (the input manager's focus checks).
+#define WS_EX_NOACTIVATE 0x08000000L
+#define SW_SHOWNORMAL 1
+#define GA_ROOT 2
+
+// Virtual-key codes (persisted in the hotkey settings - SDK values).
+#define VK_LBUTTON 0x01
+#define VK_RBUTTON 0x02
+#define VK_MBUTTON 0x04
+#define VK_XBUTTON1 0x05
+#define VK_XBUTTON2 0x06
+#define VK_BACK 0x08
+#define VK_TAB 0x09
+#define VK_RETURN 0x0D
+#define VK_SHIFT 0x10
+#define VK_CONTROL 0x11
+#define VK_MENU 0x12
+#define VK_PAUSE 0x13
+#define VK_CAPITAL 0x14
+#define VK_ESCAPE 0x1B
+#define VK_SPACE 0x20
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_SNAPSHOT 0x2C
+#define VK_INSERT 0x2D
+#define VK_DELETE 0x2E
+#define VK_LWIN 0x5B
+#define VK_RWIN 0x5C
+#define VK_APPS 0x5D
+#define VK_NUMPAD0 0x60
+#define VK_NUMPAD1 0x61
+#define VK_NUMPAD2 0x62
+#define VK_NUMPAD3 0x63
+#define VK_NUMPAD4 0x64
+#define VK_NUMPAD5 0x65
+#define VK_NUMPAD6 0x66
+#define VK_NUMPAD7 0x67
+#define VK_NUMPAD8 0x68
+#define VK_NUMPAD9 0x69
+#define VK_MULTIPLY 0x6A
+#define VK_ADD 0x6B
+#define VK_SUBTRACT 0x6D
+#define VK_DECIMAL 0x6E
+#define VK_DIVIDE 0x6F
+#define VK_F1 0x70
+#define VK_F2 0x71
+#define VK_F3 0x72
+#define VK_F4 0x73
+#define VK_F5 0x74
+#define VK_F6 0x75
+#define VK_F7 0x76
+#define VK_F8 0x77
+#define VK_F9 0x78
+#define VK_F10 0x79
+#define VK_F11 0x7A
+#define VK_F12 0x7B
+#define VK_NUMLOCK 0x90
+#define VK_SCROLL 0x91
+#define VK_LSHIFT 0xA0
+#define VK_RSHIFT 0xA1
+#define VK_LCONTROL 0xA2
+#define VK_RCONTROL 0xA3
+#define VK_LMENU 0xA4
+#define VK_RMENU 0xA5
+#define VK_OEM_1 0xBA
+#define VK_OEM_PLUS 0xBB
+#define VK_OEM_COMMA 0xBC
+#define VK_OEM_MINUS 0xBD
+#define VK_OEM_PERIOD 0xBE
+#define VK_OEM_2 0xBF
+#define VK_OEM_3 0xC0
+#define VK_OEM_4 0xDB
+#define VK_OEM_5 0xDC
+#define VK_OEM_6 0xDD
+#define VK_OEM_7 0xDE
+
+// --- functions (platform_posix.cpp) ------------------------------------------
+// Errors and processes
+DWORD GetLastError();
+HANDLE GetCurrentProcess();
+DWORD GetCurrentProcessId();
+DWORD GetCurrentThreadId();
+DWORD GetEnvironmentVariableA(LPCSTR name, LPSTR buffer, DWORD size);
+void OutputDebugStringA(LPCSTR text);
+LONG InterlockedExchange(volatile LONG* target, LONG value);
+
+// Clocks
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* freq);
+DWORD GetTickCount();
+void GetLocalTime(LPSYSTEMTIME st);
+void GetSystemTime(LPSYSTEMTIME st);
+void GetSystemTimeAsFileTime(LPFILETIME ft);
+LONG CompareFileTime(const FILETIME* a, const FILETIME* b);
+void Sleep(DWORD ms);
+
+
+// Files and directories
+HANDLE CreateFileA(LPCSTR path, DWORD access, DWORD share, LPSECURITY_ATTRIBUTES sa,
+                   DWORD disposition, DWORD flags, HANDLE templ);
+BOOL ReadFile(HANDLE h, LPVOID buffer, DWORD toRead, LPDWORD read, LPOVERLAPPED ov);
+BOOL WriteFile(HANDLE h, LPCVOID buffer, DWORD toWrite, LPDWORD written, LPOVERLAPPED ov);
+BOOL GetFileSizeEx(HANDLE h, PLARGE_INTEGER size);
+BOOL CloseHandle(HANDLE h);
+DWORD GetFileAttributesA(LPCSTR path);
+BOOL GetFileAttributesExA(LPCSTR path, GET_FILEEX_INFO_LEVELS level, LPVOID info);
+BOOL CreateDirectoryA(LPCSTR path, LPSECURITY_ATTRIBUTES sa);
+BOOL RemoveDirectoryA(LPCSTR path);
+BOOL DeleteFileA(LPCSTR path);
+BOOL CopyFileA(LPCSTR from, LPCSTR to, BOOL failIfExists);
+BOOL MoveFileA(LPCSTR from, LPCSTR to);
+BOOL MoveFileExA(LPCSTR from, LPCSTR to, DWORD flags);
+HANDLE FindFirstFileA(LPCSTR pattern, LPWIN32_FIND_DATAA data);
+BOOL FindNextFileA(HANDLE h, LPWIN32_FIND_DATAA data);
+BOOL FindClose(HANDLE h);
+
+// Modules (there is no host .exe or steam_api64.dll natively: lookups fail)
+HMODULE GetModuleHandleA(LPCSTR name);
+HMODULE GetModuleHandleW(LPCWSTR name);
+BOOL GetModuleHandleExA(DWORD flags, LPCSTR name, HMODULE* module);
+DWORD GetModuleFileNameA(HMODULE module, LPSTR buffer, DWORD size);
+FARPROC GetProcAddress(HMODULE module, LPCSTR name);
+
+// Text
+int MultiByteToWideChar(UINT codePage, DWORD flags, LPCSTR src, int srcLen, LPWSTR dst, int dstLen);
+int WideCharToMultiByte(UINT codePage, DWORD flags, LPCWSTR src, int srcLen, LPSTR dst, int dstLen,
+                        LPCSTR defaultChar, BOOL* usedDefault);
+int GetUserDefaultLocaleName(LPWSTR name, int size);
+
+// Registry (absent)
+LSTATUS RegOpenKeyExA(HKEY key, LPCSTR subKey, DWORD options, DWORD access, PHKEY result);
+LSTATUS RegQueryValueExA(HKEY key, LPCSTR name, LPDWORD reserved, LPDWORD type, LPBYTE data, LPDWORD size);
+LSTATUS RegCloseKey(HKEY key);
+
+// Console (absent)
+HWND GetConsoleWindow();
+
+// Exceptions (never raised natively)
+LPTOP_LEVEL_EXCEPTION_FILTER SetUnhandledExceptionFilter(LPTOP_LEVEL_EXCEPTION_FILTER filter);
+
+// Keyboard, mouse and windows (no desktop: no keys down, no windows, calls fail)
+SHORT GetAsyncKeyState(int vk);
+BOOL GetCursorPos(LPPOINT pt);
+BOOL ScreenToClient(HWND hwnd, LPPOINT pt);
+HWND WindowFromPoint(POINT pt);
+HWND GetForegroundWindow();
+HWND GetAncestor(HWND hwnd, UINT flags);
+DWORD GetWindowThreadProcessId(HWND hwnd, LPDWORD pid);
+BOOL IsWindow(HWND hwnd);
+BOOL GetClientRect(HWND hwnd, LPRECT rect);
+
+// GDI (the companion window's warm-up; no display, so GetDC fails)
+HDC GetDC(HWND hwnd);
+int ReleaseDC(HWND hwnd, HDC dc);
+HDC CreateCompatibleDC(HDC dc);
+BOOL DeleteDC(HDC dc);
+HBITMAP CreateCompatibleBitmap(HDC dc, int w, int h);
+HGDIOBJ SelectObject(HDC dc, HGDIOBJ obj);
+BOOL DeleteObject(HGDIOBJ obj);
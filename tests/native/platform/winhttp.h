@@ -0,0 +1,47 @@
+// ============================================================================
+// tests/native/platform/winhttp.h
+// WinHTTP for the native build: declared with the SDK's signatures and values,
+// implemented in platform_posix.cpp as "no network" - WinHttpOpen returns null,
+// so the update checker, records fetcher and analytics take their offline paths.
+// ============================================================================
+#pragma once
+#include "windows.h"
+
+typedef LPVOID HINTERNET;
+typedef WORD INTERNET_PORT;
+
+#define INTERNET_DEFAULT_HTTP_PORT 80
+#define INTERNET_DEFAULT_HTTPS_PORT 443
+#define WINHTTP_ACCESS_TYPE_DEFAULT_PROXY 0
+#define WINHTTP_NO_PROXY_NAME nullptr
+#define WINHTTP_NO_PROXY_BYPASS nullptr
+#define WINHTTP_NO_REFERER nullptr
+#define WINHTTP_DEFAULT_ACCEPT_TYPES nullptr
+#define WINHTTP_NO_ADDITIONAL_HEADERS nullptr
+#define WINHTTP_NO_REQUEST_DATA nullptr
+#define WINHTTP_HEADER_NAME_BY_INDEX nullptr
+#define WINHTTP_NO_HEADER_INDEX nullptr
+#define WINHTTP_FLAG_SECURE 0x00800000
+#define WINHTTP_ADDREQ_FLAG_ADD 0x20000000
+#define WINHTTP_OPTION_REDIRECT_POLICY 88
+#define WINHTTP_OPTION_REDIRECT_POLICY_NEVER 0
+#define WINHTTP_QUERY_CONTENT_LENGTH 5
+#define WINHTTP_QUERY_STATUS_CODE 19
+#define WINHTTP_QUERY_LOCATION 33
+#define WINHTTP_QUERY_FLAG_NUMBER 0x20000000
+
+HINTERNET WinHttpOpen(LPCWSTR agent, DWORD accessType, LPCWSTR proxy, LPCWSTR bypass, DWORD flags);
+HINTERNET WinHttpConnect(HINTERNET session, LPCWSTR server, INTERNET_PORT port, DWORD reserved);
+HINTERNET WinHttpOpenRequest(HINTERNET connect, LPCWSTR verb, LPCWSTR object, LPCWSTR version,
+                             LPCWSTR referrer, LPCWSTR* acceptTypes, DWORD flags);
+BOOL WinHttpCloseHandle(HINTERNET h);
+BOOL WinHttpSetTimeouts(HINTERNET h, int resolve, int connect, int send, int receive);
+BOOL WinHttpSetOption(HINTERNET h, DWORD option, LPVOID buffer, DWORD length);
+BOOL WinHttpAddRequestHeaders(HINTERNET request, LPCWSTR headers, DWORD length, DWORD modifiers);
+BOOL WinHttpSendRequest(HINTERNET request, LPCWSTR headers, DWORD headersLength, LPVOID optional,
+                        DWORD optionalLength, DWORD totalLength, DWORD_PTR context);
+BOOL WinHttpReceiveResponse(HINTERNET request, LPVOID reserved);
+BOOL WinHttpQueryHeaders(HINTERNET request, DWORD infoLevel, LPCWSTR name, LPVOID buffer,
+                         LPDWORD bufferLength, LPDWORD index);
+BOOL WinHttpQueryDataAvailable(HINTERNET request, LPDWORD available);
+BOOL WinHttpReadData(HINTERNET request, LPVOID buffer, DWORD toRead, LPDWORD read);
@@ -0,0 +1,53 @@
+#!/usr/bin/env bash
+# ============================================================================
+# tests/native/run_bench.sh
+# Tape-driven benchmark: replays every committed fixture tape
+# (tests/integration/tests/fixtures/) plus any master dropped in
+# tests/integration/tapes/ through build/tape_bench, BENCH_RUNS times each, and
+# gates the results against bench_baseline.json with bench_compare.py.
+#
+#   ./run_bench.sh                       # build, run, compare
+#   ./run_bench.sh --update              # ... and rewrite the baseline instead
+#   BENCH_DRAW_HZ=0 ./run_bench.sh       # replay recorded Draws (default: 60 Hz)
+#   BENCH_RUNS=5 ./run_bench.sh
+#   PERF_WRAP="perf record -g --" BENCH_RUNS=1 ./run_bench.sh
+#
+# Per-run JSON lands in build/bench/<tape>.<run>.json. Requires: g++, make,
+# python3.
+# ============================================================================
+set -uo pipefail
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${HERE}/../.." && pwd)"
+BUILD="${HERE}/build"
+OUT="${BUILD}/bench"
+SAVE=/tmp/mxbbench
+RUNS="${BENCH_RUNS:-3}"
+DRAW_HZ="${BENCH_DRAW_HZ:-60}"
+BENCH_TIMEOUT="${MXBMRP3_BENCH_TIMEOUT:-600}"
+PERF_WRAP="${PERF_WRAP:-}"
+
+echo "== Building native core + tape_bench =="
+make -C "${HERE}" -j"$(nproc)" || { echo "ERROR: native build failed"; exit 1; }
+
+# Fixtures are committed gzipped (v1) or as v2 .tape; masters are git-ignored .tape.
+rm -rf "${OUT}"; mkdir -p "${OUT}/tapes"
+for gz in "${ROOT}/tests/integration/tests/fixtures/"*.tape.gz; do
+    [ -e "${gz}" ] && gunzip -c "${gz}" > "${OUT}/tapes/$(basename "${gz%.gz}")"
+done
+for t in "${ROOT}/tests/integration/tests/fixtures/"*.tape "${ROOT}/tests/integration/tapes/"*.tape; do
+    [ -e "${t}" ] && cp "${t}" "${OUT}/tapes/"
+done
+
+for tape in "${OUT}/tapes/"*.tape; do
+    name="$(basename "${tape%.tape}")"
+    for run in $(seq 1 "${RUNS}"); do
+        rm -rf "${SAVE}"; mkdir -p "${SAVE}"   # fresh settings each run
+        # shellcheck disable=SC2086  # PERF_WRAP is a command prefix, split on purpose
+        timeout "${BENCH_TIMEOUT}" ${PERF_WRAP} "${BUILD}/tape_bench" --draw-hz "${DRAW_HZ}" \
+            --save "${SAVE}/" --out "${OUT}/${name}.${run}.json" "${tape}"
+        rc=$?
+        if [ "${rc}" -ne 0 ]; then echo "== BENCH FAIL: ${name} run ${run} (exit ${rc}) =="; exit 1; fi
+    done
+done
+
+python3 "${HERE}/bench_compare.py" --baseline "${HERE}/bench_baseline.json" "$@" "${OUT}/"*.json
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# ============================================================================
+# tests/native/run_perf.sh
+# The CPU perf baseline (tests/integration/perf_driver.cpp) on the native Linux
+# build of the core - no Wine in the numbers. Same report, same PERF line and the
+# same gross-regression gate on average Draw time as the Wine runner, with a
+# tighter default ceiling since there is no emulation overhead to absorb.
+#
+#   ./run_perf.sh [draw_max_us]
+#   PERF_WRAP="perf record -g --" ./run_perf.sh          # profile the run
+#   PERF_WRAP="valgrind --tool=cachegrind" ./run_perf.sh
+#
+# Requires: g++ (or clang via CXX/CC), make.
+# ============================================================================
+set -uo pipefail
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD="${HERE}/build"
+DRAW_MAX_US="${1:-1000}"     # gross-regression ceiling
+SAVE=/tmp/mxbperf            # perf_driver's native save path
+PERF_TIMEOUT="${MXBMRP3_PERF_TIMEOUT:-180}"
+PERF_WRAP="${PERF_WRAP:-}"
+
+echo "== Building native core + perf driver =="
+make -C "${HERE}" -j"$(nproc)" || { echo "ERROR: native build failed"; exit 1; }
+
+echo "== Measuring natively =="
+rm -rf "${SAVE}"; mkdir -p "${SAVE}"
+# shellcheck disable=SC2086  # PERF_WRAP is a command prefix, split on purpose
+( cd "${BUILD}" && timeout "${PERF_TIMEOUT}" ${PERF_WRAP} ./perf_driver >/tmp/perf_native_report.txt )
+rc=$?
+cat /tmp/perf_native_report.txt
+
+if [ "${rc}" -eq 124 ]; then echo "== PERF FAIL: driver TIMED OUT after ${PERF_TIMEOUT}s (raise MXBMRP3_PERF_TIMEOUT) =="; exit 1; fi
+if [ "${rc}" -ne 0 ]; then echo "== PERF FAIL (driver exit ${rc}) =="; exit 1; fi
+
+draw_avg=$(sed -n 's/.*draw_avg_us=\([0-9.]*\).*/\1/p' /tmp/perf_native_report.txt)
+[ -z "${draw_avg}" ] && { echo "== PERF FAIL (no PERF line) =="; exit 1; }
+if awk "BEGIN{exit !(${draw_avg} < ${DRAW_MAX_US})}"; then
+    echo "== PERF OK (Draw avg ${draw_avg}us < ${DRAW_MAX_US}us ceiling) =="
+    exit 0
+else
+    echo "== PERF REGRESSION: Draw avg ${draw_avg}us exceeds ${DRAW_MAX_US}us ceiling =="
+    exit 1
+fi
@@ -0,0 +1,480 @@
+// ============================================================================
+// tests/native/tape_bench.cpp
+// Tape-driven benchmark runner. The synthetic drivers (perf_driver and friends)
+// time a made-up 50-rider race. This one replays a REAL callback tape (a
+// committed fixture or a master from tests/integration/tapes/) into the plugin
+// core linked into this binary, and times every callback the game sent.
+//
+// It records two sets of latency histograms:
+//   - per callback type: each export call is timed from outside with the
+//     monotonic clock, in ns.
+//   - per HUD: each rebuildRenderData() is timed by the plugin's own profiler
+//     (PluginData::BenchmarkMetrics, us resolution). The runner polls the
+//     counters after every callback, so it sees each rebuild as one sample.
+// With allocation counting in the core (diagnostics/alloc_counter.h, on in this
+// build) it also counts heap allocations per callback type and per frame (one
+// Draw plus the callbacks since the previous one) into an "allocs" block.
+// Results go to one JSON document per run (schema below). bench_compare.py gates
+// a set of runs against the committed bench_baseline.json.
+//
+//   tape_bench [options] <tape>
+//     --draw-hz N    drop the tape's Draw events and issue Draw at N Hz of tape
+//                    time (slimmed fixtures carry no Draws). 0 = replay the
+//                    recorded Draws as-is (default).
+//     --realtime     pace the replay to the tape's own clock (sleep between
+//                    events) instead of running as fast as possible.
+//     --huds all|default   force every HUD visible (default: all) or keep the
+//                    plugin's default layout.
+//     --out FILE     JSON output (default: stdout).
+//     --save DIR     plugin save path (default /tmp/mxbbench/).
+//     --trace        run a timeline trace capture (diagnostics/tracer.h) over
+//                    the replay and write it under the save path - for
+//                    measuring the tracer's own overhead against a plain run.
+//
+// Histograms are log-linear (HDR-style): exact below 64 ns, then 32 buckets per
+// power of two (~3% bucket width). Percentiles come from the buckets; min, max
+// and sum are exact. The JSON also carries "calib_ns", the time of a fixed CPU
+// workload on this host, so the comparison can scale a baseline recorded on
+// another machine.
+//
+// Built by the native Makefile only (links build/libmxbmrp3_core.a; exports are
+// resolved from the binary's own symbol table, as perf_driver does natively).
+// ============================================================================
+#include <dlfcn.h>
+#include <time.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../integration/harness/tape.h"
+#include "../../mxbmrp3/core/tape_map.h"
+
+typedef int  (*PFN_Startup)(char*);
+typedef void (*PFN_Void)();
+typedef void (*PFN_DS)(void*, int);
+typedef void (*PFN_Telem)(void*, int, float, float);
+typedef void (*PFN_Class)(void*, int, void*, int);
+typedef void (*PFN_TrackPos)(int, void*, int);
+typedef void (*PFN_Draw)(int, int*, void**, int*, void**);
+typedef void (*PFN_TrackCenter)(int, void*, void*);
+
+static uint64_t nowNs() {
+    timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+// --- log-linear latency histogram -------------------------------------------
+class Histogram {
+public:
+    static constexpr int SUB_BITS = 6;                       // 64 exact values, then 32/octave
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int HALF = SUB / 2;
+    static constexpr int BUCKETS = SUB + (64 - SUB_BITS) * HALF;
+
+    void add(uint64_t v) {
+        ++m_counts[index(v)];
+        ++m_n; m_sum += v;
+        if (m_n == 1 || v < m_min) m_min = v;
+        if (v > m_max) m_max = v;
+    }
+    uint64_t count() const { return m_n; }
+
+    // Value at quantile q: the midpoint of the bucket holding the q-th sample,
+    // clamped to the exact observed range.
+    uint64_t quantile(double q) const {
+        if (!m_n) return 0;
+        uint64_t rank = (uint64_t)(q * (double)(m_n - 1)) + 1, seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += m_counts[i];
+            if (seen >= rank) {
+                uint64_t mid = lowerBound(i) + width(i) / 2;
+                return mid < m_min ? m_min : mid > m_max ? m_max : mid;
+            }
+        }
+        return m_max;
+    }
+
+    void writeJson(FILE* f) const {
+        fprintf(f, "{\"count\": %llu, \"sum_ns\": %llu, \"min_ns\": %llu, \"p50_ns\": %llu, "
+                   "\"p90_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu, \"buckets\": [",
+                (unsigned long long)m_n, (unsigned long long)m_sum, (unsigned long long)m_min,
+                (unsigned long long)quantile(0.50), (unsigned long long)quantile(0.90),
+                (unsigned long long)quantile(0.99), (unsigned long long)quantile(0.999),
+                (unsigned long long)m_max);
+        bool first = true;
+        for (int i = 0; i < BUCKETS; ++i) {
+            if (!m_counts[i]) continue;
+            fprintf(f, "%s[%llu, %llu]", first ? "" : ", ",
+                    (unsigned long long)lowerBound(i), (unsigned long long)m_counts[i]);
+            first = false;
+        }
+        fprintf(f, "]}");
+    }
+
+private:
+    static int index(uint64_t v) {
+        if (v < (uint64_t)SUB) return (int)v;
+        const int msb = 63 - __builtin_clzll(v);
+        const int shift = msb - (SUB_BITS - 1);              // >= 1
+        return SUB + (shift - 1) * HALF + (int)((v >> shift) - HALF);
+    }
+    static uint64_t lowerBound(int i) {
+        if (i < SUB) return (uint64_t)i;
+        const int shift = (i - SUB) / HALF + 1;
+        return (uint64_t)((i - SUB) % HALF + HALF) << shift;
+    }
+    static uint64_t width(int i) { return i < SUB ? 1 : (uint64_t)1 << ((i - SUB) / HALF + 1); }
+
+    std::vector<uint64_t> m_counts = std::vector<uint64_t>(BUCKETS, 0);
+    uint64_t m_n = 0, m_sum = 0, m_min = 0, m_max = 0;
+};
+
+// Fixed integer workload (xorshift over a cache-resident table), best of 5, so
+// results from different hosts can be put on one scale.
+static uint64_t calibrate() {
+    std::vector<uint32_t> table(4096);
+    for (size_t i = 0; i < table.size(); ++i) table[i] = (uint32_t)(i * 2654435761u);
+    uint64_t best = UINT64_MAX;
+    volatile uint32_t sink = 0;
+    for (int rep = 0; rep < 5; ++rep) {
+        uint32_t x = 2463534242u, acc = 0;
+        const uint64_t t0 = nowNs();
+        for (int i = 0; i < 2000000; ++i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            acc += table[x & 4095];
+            table[(x >> 12) & 4095] ^= acc;
+        }
+        const uint64_t dt = nowNs() - t0;
+        sink = sink + acc;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+static const char* const kTypeNames[] = {
+    "None", "Startup", "Shutdown", "EventInit", "EventDeinit", "RunInit", "RunDeinit",
+    "RunStart", "RunStop", "RunLap", "RunSplit", "RunTelemetry", "DrawInit", "Draw",
+    "TrackCenterline", "RaceEvent", "RaceDeinit", "RaceSession", "RaceSessionState",
+    "RaceAddEntry", "RaceRemoveEntry", "RaceLap", "RaceSplit", "RaceHoleshot",
+    "RaceClassification", "RaceTrackPosition", "RaceCommunication", "RaceVehicleData",
+    "StateKeyframe",
+};
+static constexpr int kNumTypes = (int)(sizeof(kTypeNames) / sizeof(kTypeNames[0]));
+
+static const int MAX_HUDS = 64;
+
+struct Exports {
+    PFN_Startup Startup; PFN_Void Shutdown;
+    PFN_DS EventInit, RunInit, RunLap, RunSplit, RaceEvent, RaceSession, RaceSessionState,
+           RaceAddEntry, RaceRemoveEntry, RaceLap, RaceSplit, RaceHoleshot, RaceCommunication,
+           RaceVehicleData;
+    PFN_Void EventDeinit, RunDeinit, RunStart, RunStop, RaceDeinit;
+    PFN_Telem RunTelemetry; PFN_Class RaceClassification; PFN_TrackPos RaceTrackPosition;
+    PFN_TrackCenter TrackCenterline; PFN_Draw Draw;
+    void (*BenchmarkCollect)(int);
+    int (*BenchmarkHuds)(long long*, int*, int);
+    const char* (*BenchmarkHudName)(int);
+    void (*ShowAllHuds)(int);
+    void (*TraceStart)();
+    const char* (*TraceStop)();
+    long long (*TraceEvents)();
+    int (*AllocThreadCounts)(long long*, long long*, int);
+};
+
+// Call the export for one recorded event. Returns false for events the runner
+// does not replay (Startup/Shutdown, DrawInit, keyframes, short payloads).
+static bool dispatch(const Exports& x, tape::EventType t, std::vector<uint8_t>& buf) {
+    using ET = tape::EventType;
+    void* p = buf.data();
+    const int size = (int)buf.size();
+    auto ds = [&](PFN_DS fn) { if (!fn) return false; fn(p, size); return true; };
+    auto v  = [&](PFN_Void fn) { if (!fn) return false; fn(); return true; };
+    switch (t) {
+        case ET::EventInit:         return ds(x.EventInit);
+        case ET::EventDeinit:       return v(x.EventDeinit);
+        case ET::RunInit:           return ds(x.RunInit);
+        case ET::RunDeinit:         return v(x.RunDeinit);
+        case ET::RunStart:          return v(x.RunStart);
+        case ET::RunStop:           return v(x.RunStop);
+        case ET::RunLap:            return ds(x.RunLap);
+        case ET::RunSplit:          return ds(x.RunSplit);
+        case ET::RaceEvent:         return ds(x.RaceEvent);
+        case ET::RaceDeinit:        return v(x.RaceDeinit);
+        case ET::RaceSession:       return ds(x.RaceSession);
+        case ET::RaceSessionState:  return ds(x.RaceSessionState);
+        case ET::RaceAddEntry:      return ds(x.RaceAddEntry);
+        case ET::RaceRemoveEntry:   return ds(x.RaceRemoveEntry);
+        case ET::RaceLap:           return ds(x.RaceLap);
+        case ET::RaceSplit:         return ds(x.RaceSplit);
+        case ET::RaceHoleshot:      return ds(x.RaceHoleshot);
+        case ET::RaceCommunication: return ds(x.RaceCommunication);
+        case ET::RaceVehicleData:   return ds(x.RaceVehicleData);
+        case ET::Draw: {
+            int nq = 0, ns = 0; void* q = nullptr; void* s = nullptr;
+            x.Draw(1, &nq, &q, &ns, &s);
+            return true;
+        }
+        case ET::RunTelemetry: {
+            // SPluginsBikeData_t, then the two floats the export takes by value.
+            if (!x.RunTelemetry || size < (int)(2 * sizeof(float))) return false;
+            const int bike = size - (int)(2 * sizeof(float));
+            float tp[2]; std::memcpy(tp, buf.data() + bike, sizeof(tp));
+            x.RunTelemetry(p, bike, tp[0], tp[1]);
+            return true;
+        }
+        case ET::TrackCenterline: {
+            if (!x.TrackCenterline || size < (int)sizeof(int)) return false;
+            int n; std::memcpy(&n, p, sizeof(n));
+            x.TrackCenterline(n, n > 0 ? buf.data() + sizeof(int) : nullptr, nullptr);
+            return true;
+        }
+        case ET::RaceClassification: {
+            if (!x.RaceClassification || buf.size() < sizeof(tape::ClassificationPrefix)) return false;
+            auto* pre = reinterpret_cast<tape::ClassificationPrefix*>(p);
+            x.RaceClassification(&pre->header, (int)sizeof(SPluginsRaceClassification_t),
+                                 buf.data() + sizeof(tape::ClassificationPrefix),
+                                 (int)sizeof(SPluginsRaceClassificationEntry_t));
+            return true;
+        }
+        case ET::RaceTrackPosition: {
+            if (!x.RaceTrackPosition || buf.size() < sizeof(tape::TrackPositionPrefix)) return false;
+            auto* pre = reinterpret_cast<tape::TrackPositionPrefix*>(p);
+            x.RaceTrackPosition(pre->numVehicles, buf.data() + sizeof(tape::TrackPositionPrefix),
+                                (int)sizeof(SPluginsRaceTrackPosition_t));
+            return true;
+        }
+        default: return false;
+    }
+}
+
+static void usage() {
+    fprintf(stderr, "usage: tape_bench [--draw-hz N] [--realtime] [--huds all|default] "
+                    "[--out FILE] [--save DIR] [--trace] <tape>\n");
+}
+
+static std::string baseName(const char* path) {
+    std::string s = path;
+    const size_t slash = s.find_last_of('/');
+    if (slash != std::string::npos) s = s.substr(slash + 1);
+    const size_t dot = s.find(".tape");
+    if (dot != std::string::npos) s = s.substr(0, dot);
+    return s;
+}
+
+int main(int argc, char** argv) {
+    double drawHz = 0.0;
+    bool realtime = false, allHuds = true, trace = false;
+    const char* outPath = nullptr;
+    const char* tapePath = nullptr;
+    std::string save = "/tmp/mxbbench/";
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (!strcmp(a, "--draw-hz") && i + 1 < argc) drawHz = atof(argv[++i]);
+        else if (!strcmp(a, "--realtime")) realtime = true;
+        else if (!strcmp(a, "--trace")) trace = true;
+        else if (!strcmp(a, "--huds") && i + 1 < argc) allHuds = strcmp(argv[++i], "default") != 0;
+        else if (!strcmp(a, "--out") && i + 1 < argc) outPath = argv[++i];
+        else if (!strcmp(a, "--save") && i + 1 < argc) { save = argv[++i]; if (save.back() != '/') save += '/'; }
+        else if (a[0] == '-') { usage(); return 2; }
+        else tapePath = a;
+    }
+    if (!tapePath) { usage(); return 2; }
+
+    void* h = dlopen(nullptr, RTLD_NOW);   // the core is linked in (-rdynamic, whole archive)
+    if (!h) { fprintf(stderr, "FAIL: dlopen %s\n", dlerror()); return 2; }
+    auto S = [&](const char* n) { return dlsym(h, n); };
+    Exports x{};
+    x.Startup = (PFN_Startup)S("Startup");               x.Shutdown = (PFN_Void)S("Shutdown");
+    x.EventInit = (PFN_DS)S("EventInit");                x.EventDeinit = (PFN_Void)S("EventDeinit");
+    x.RunInit = (PFN_DS)S("RunInit");                    x.RunDeinit = (PFN_Void)S("RunDeinit");
+    x.RunStart = (PFN_Void)S("RunStart");                x.RunStop = (PFN_Void)S("RunStop");
+    x.RunLap = (PFN_DS)S("RunLap");                      x.RunSplit = (PFN_DS)S("RunSplit");
+    x.RunTelemetry = (PFN_Telem)S("RunTelemetry");       x.TrackCenterline = (PFN_TrackCenter)S("TrackCenterline");
+    x.RaceEvent = (PFN_DS)S("RaceEvent");                x.RaceDeinit = (PFN_Void)S("RaceDeinit");
+    x.RaceSession = (PFN_DS)S("RaceSession");            x.RaceSessionState = (PFN_DS)S("RaceSessionState");
+    x.RaceAddEntry = (PFN_DS)S("RaceAddEntry");          x.RaceRemoveEntry = (PFN_DS)S("RaceRemoveEntry");
+    x.RaceLap = (PFN_DS)S("RaceLap");                    x.RaceSplit = (PFN_DS)S("RaceSplit");
+    x.RaceHoleshot = (PFN_DS)S("RaceHoleshot");          x.RaceCommunication = (PFN_DS)S("RaceCommunication");
+    x.RaceVehicleData = (PFN_DS)S("RaceVehicleData");
+    x.RaceClassification = (PFN_Class)S("RaceClassification");
+    x.RaceTrackPosition = (PFN_TrackPos)S("RaceTrackPosition");
+    x.Draw = (PFN_Draw)S("Draw");
+    x.BenchmarkCollect = (void(*)(int))S("MXBMRP3_Test_BenchmarkCollect");
+    x.BenchmarkHuds = (int(*)(long long*, int*, int))S("MXBMRP3_Test_BenchmarkHuds");
+    x.BenchmarkHudName = (const char*(*)(int))S("MXBMRP3_Test_BenchmarkHudName");
+    x.ShowAllHuds = (void(*)(int))S("MXBMRP3_Test_ShowAllHuds");
+    x.TraceStart = (void(*)())S("MXBMRP3_Test_TraceStart");
+    x.TraceStop = (const char*(*)())S("MXBMRP3_Test_TraceStop");
+    x.TraceEvents = (long long(*)())S("MXBMRP3_Test_TraceEvents");
+    x.AllocThreadCounts = (int(*)(long long*, long long*, int))S("MXBMRP3_Test_AllocThreadCounts");
+    auto allocCounting = (int(*)())S("MXBMRP3_Test_AllocCounting");
+    const bool countAllocs = x.AllocThreadCounts && allocCounting && allocCounting();
+    if (!x.Startup || !x.Draw || !x.BenchmarkCollect || !x.BenchmarkHuds) {
+        fprintf(stderr, "FAIL: missing exports (a MXBMRP3_TEST_BUILD core is required)\n");
+        return 2;
+    }
+
+    tape_io::MappedTape reader;
+    if (!reader.open(tapePath)) { fprintf(stderr, "FAIL: %s is missing or not a MXBHREC v1/v2 tape\n", tapePath); return 2; }
+
+    const uint64_t calibNs = calibrate();
+
+    std::vector<char> savePath(save.begin(), save.end()); savePath.push_back('\0');
+    x.Startup(savePath.data());
+    if (allHuds && x.ShowAllHuds) x.ShowAllHuds(1);
+    x.BenchmarkCollect(1);
+    if (trace && x.TraceStart) x.TraceStart();
+
+    Histogram byType[kNumTypes];
+    Histogram byHud[MAX_HUDS];
+    long long hudLastUs[MAX_HUDS] = {};
+    int hudCounts[MAX_HUDS] = {}, hudSeen[MAX_HUDS] = {};
+    int hudCount = 0;
+
+    // One rebuild per count step; a HUD that rebuilt twice between polls (only
+    // possible outside Draw) contributes its latest duration once per step.
+    auto pollHuds = [&]() {
+        hudCount = x.BenchmarkHuds(hudLastUs, hudCounts, MAX_HUDS);
+        if (hudCount > MAX_HUDS) hudCount = MAX_HUDS;
+        for (int i = 0; i < hudCount; ++i) {
+            for (int k = hudSeen[i]; k < hudCounts[i]; ++k) byHud[i].add((uint64_t)hudLastUs[i] * 1000u);
+            hudSeen[i] = hudCounts[i];
+        }
+    };
+    // Heap allocations on this (the game) thread, all phases.
+    auto threadAllocs = [&]() -> uint64_t {
+        if (!countAllocs) return 0;
+        long long a[16] = {};
+        const int n = x.AllocThreadCounts(a, nullptr, 16);
+        uint64_t sum = 0;
+        for (int i = 0; i < n && i < 16; ++i) sum += (uint64_t)a[i];
+        return sum;
+    };
+    uint64_t allocTotal[kNumTypes] = {}, allocMax[kNumTypes] = {}, allocEvents[kNumTypes] = {};
+    Histogram allocsPerFrame;
+    uint64_t frameAllocStart = 0;
+    bool frameOpen = false;
+    auto timed = [&](tape::EventType t, std::vector<uint8_t>& buf) {
+        const uint64_t a0 = threadAllocs();
+        if (t == tape::EventType::Draw) {
+            if (frameOpen) allocsPerFrame.add(a0 - frameAllocStart);
+            frameAllocStart = a0;
+            frameOpen = true;
+        }
+        const uint64_t t0 = nowNs();
+        const bool ran = dispatch(x, t, buf);
+        const uint64_t dt = nowNs() - t0;
+        const uint64_t da = threadAllocs() - a0;
+        if (ran) {
+            byType[(int)t].add(dt);
+            ++allocEvents[(int)t];
+            allocTotal[(int)t] += da;
+            if (da > allocMax[(int)t]) allocMax[(int)t] = da;
+            pollHuds();
+        }
+        return ran;
+    };
+    // --realtime: hold each event until the wall clock reaches its tape time.
+    const uint64_t wall0 = nowNs();
+    uint64_t tape0 = UINT64_MAX;
+    auto pace = [&](uint64_t tapeUs) {
+        if (!realtime) return;
+        if (tape0 == UINT64_MAX) tape0 = tapeUs;
+        const uint64_t due = wall0 + (tapeUs - tape0) * 1000u;
+        const uint64_t now = nowNs();
+        if (due > now) {
+            timespec ts{ (time_t)((due - now) / 1000000000u), (long)((due - now) % 1000000000u) };
+            nanosleep(&ts, nullptr);
+        }
+    };
+
+    uint64_t events = 0, replayed = 0, firstUs = 0, lastUs = 0;
+    const uint64_t drawStepUs = drawHz > 0 ? (uint64_t)(1e6 / drawHz) : 0;
+    uint64_t nextDrawUs = 0;
+    std::vector<uint8_t> buf, noPayload;
+    tape_io::EventFrame ev{};
+    const uint8_t* payload = nullptr;
+    while (reader.next(ev, payload)) {
+        if (events++ == 0) { firstUs = ev.timestampUs; nextDrawUs = firstUs + drawStepUs; }
+        lastUs = ev.timestampUs;
+        const auto type = static_cast<tape::EventType>(ev.eventType);
+        if ((int)ev.eventType >= kNumTypes) continue;
+        if (drawStepUs) {
+            if (type == tape::EventType::Draw) continue;     // replaced by the fixed-rate Draws
+            for (; nextDrawUs <= ev.timestampUs; nextDrawUs += drawStepUs) {
+                pace(nextDrawUs);
+                if (timed(tape::EventType::Draw, noPayload)) ++replayed;
+            }
+        }
+        pace(ev.timestampUs);
+        buf.assign(payload, payload + ev.dataSize);          // aligned copy for the struct casts
+        if (timed(type, buf)) ++replayed;
+    }
+    const double wallS = (double)(nowNs() - wall0) / 1e9;
+
+    std::vector<std::string> hudNames;
+    for (int i = 0; i < hudCount; ++i) hudNames.push_back(x.BenchmarkHudName ? x.BenchmarkHudName(i) : "hud");
+    x.BenchmarkCollect(0);
+    if (trace && x.TraceStop) {
+        const long long n = x.TraceEvents ? x.TraceEvents() : 0;
+        fprintf(stderr, "tape_bench: %lld trace events -> %s\n", n, x.TraceStop());
+    }
+    x.Shutdown();
+
+    FILE* f = outPath ? fopen(outPath, "w") : stdout;
+    if (!f) { fprintf(stderr, "FAIL: cannot write %s\n", outPath); return 2; }
+    fprintf(f, "{\n  \"schema\": 1,\n  \"tape\": \"%s\",\n", baseName(tapePath).c_str());
+    fprintf(f, "  \"mode\": \"%s\",\n  \"draw_hz\": %g,\n  \"huds\": \"%s\",\n",
+            realtime ? "realtime" : "fast", drawHz, allHuds ? "all" : "default");
+    fprintf(f, "  \"host\": \"native\",\n  \"compiler\": \"%s\",\n  \"calib_ns\": %llu,\n",
+            __VERSION__, (unsigned long long)calibNs);
+    fprintf(f, "  \"events\": %llu,\n  \"replayed\": %llu,\n  \"tape_s\": %.3f,\n  \"wall_s\": %.3f,\n",
+            (unsigned long long)events, (unsigned long long)replayed,
+            (double)(lastUs - firstUs) / 1e6, wallS);
+    fprintf(f, "  \"callbacks\": {");
+    bool first = true;
+    for (int t = 0; t < kNumTypes; ++t) {
+        if (!byType[t].count()) continue;
+        fprintf(f, "%s\n    \"%s\": ", first ? "" : ",", kTypeNames[t]);
+        byType[t].writeJson(f);
+        first = false;
+    }
+    fprintf(f, "\n  },\n  \"hud_resolution_ns\": 1000,\n  \"huds_rebuild\": {");
+    first = true;
+    for (int i = 0; i < hudCount; ++i) {
+        if (!byHud[i].count()) continue;
+        fprintf(f, "%s\n    \"%s\": ", first ? "" : ",", hudNames[i].c_str());
+        byHud[i].writeJson(f);
+        first = false;
+    }
+    fprintf(f, "\n  }");
+    if (countAllocs) {
+        fprintf(f, ",\n  \"allocs\": {\n    \"per_frame\": ");
+        allocsPerFrame.writeJson(f);
+        fprintf(f, ",\n    \"by_callback\": {");
+        first = true;
+        for (int t = 0; t < kNumTypes; ++t) {
+            if (!allocEvents[t]) continue;
+            fprintf(f, "%s\n      \"%s\": {\"events\": %llu, \"total\": %llu, \"max\": %llu}",
+                    first ? "" : ",", kTypeNames[t], (unsigned long long)allocEvents[t],
+                    (unsigned long long)allocTotal[t], (unsigned long long)allocMax[t]);
+            first = false;
+        }
+        fprintf(f, "\n    }\n  }");
+    }
+    fprintf(f, "\n}\n");
+    if (f != stdout) fclose(f);
+
+    fprintf(stderr, "tape_bench: %s  %llu events (%llu replayed) in %.2fs wall, %.1fs of tape\n",
+            baseName(tapePath).c_str(), (unsigned long long)events, (unsigned long long)replayed,
+            wallS, (double)(lastUs - firstUs) / 1e6);
+    if (countAllocs && allocsPerFrame.count()) {
+        fprintf(stderr, "tape_bench: allocs/frame p50 %llu, p99 %llu, max %llu over %llu frames\n",
+                (unsigned long long)allocsPerFrame.quantile(0.50), (unsigned long long)allocsPerFrame.quantile(0.99),
+                (unsigned long long)allocsPerFrame.quantile(1.0), (unsigned long long)allocsPerFrame.count());
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// ============================================================================
+// tests/native/track_model_bench.cpp
+// Per-query microbenchmark for the shared track model (core/track_model.h).
+// Builds the model for the same 2000-segment enduro loop map_perf_driver loads
+// (~22 km, alternating 12 m straights and 40-160 m radius curves) and times,
+// per call: the uniform-table lookups (worldAt, headingAt, poseAt), the
+// nearest-point grid (nearestTrackPos, points up to 8 m off the centerline),
+// the along-track separation, and the exact arc walk they replace
+// (TrackModel::positionAt: binary search + one arc step). Also the build itself.
+//
+//   track_model_bench [queries]     (default 1000000 per measurement)
+//
+// Each measurement is the best of 5 passes over a fixed pseudo-random query
+// set, so a scheduling hiccup doesn't skew it. The results are folded into a
+// checksum that is printed, so the optimizer can't drop the calls.
+//
+// Built by the native Makefile only (links build/libmxbmrp3_core.a).
+// ============================================================================
+#include <time.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../../mxbmrp3/core/track_model.h"
+
+namespace {
+
+uint64_t nowNs() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<uint64_t>(t.tv_sec) * 1000000000u + static_cast<uint64_t>(t.tv_nsec);
+}
+
+constexpr int PASSES = 5;
+
+// Best-of-PASSES time of `body(i)` over i in [0, count), in ns per call.
+template <typename F>
+double timePerCall(int count, F&& body) {
+    double best = 1e30;
+    for (int pass = 0; pass < PASSES; ++pass) {
+        const uint64_t t0 = nowNs();
+        for (int i = 0; i < count; ++i) body(i);
+        const double ns = static_cast<double>(nowNs() - t0) / count;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int queries = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    if (queries <= 0) {
+        std::fprintf(stderr, "usage: track_model_bench [queries]\n");
+        return 2;
+    }
+
+    const int ENDURO_SEGS = 2000;
+    std::vector<Unified::TrackSegment> segments(ENDURO_SEGS);
+    for (int i = 0; i < ENDURO_SEGS; ++i) {
+        if (i % 2 == 0) { segments[i].type = 0; segments[i].length = 12.0f; }
+        else {
+            segments[i].type = 1; segments[i].length = 10.0f;
+            segments[i].radius = ((i / 2) % 4 < 2 ? 1.0f : -1.0f) * static_cast<float>(40 + (i * 37) % 120);
+        }
+    }
+    std::vector<TrackModel::ArcPoint> arc;
+    TrackModel::buildArcTable(segments, arc);
+
+    TrackModel model;
+    double buildUs = 1e30;
+    for (int pass = 0; pass < PASSES; ++pass) {
+        const uint64_t t0 = nowNs();
+        model.build(segments, arc, 250.0f);
+        const double us = static_cast<double>(nowNs() - t0) / 1000.0;
+        if (us < buildUs) buildUs = us;
+    }
+    if (!model.valid()) {
+        std::fprintf(stderr, "track model failed to build\n");
+        return 1;
+    }
+
+    // Fixed query set: trackPos values, and world points beside the track.
+    std::vector<float> pos(queries), px(queries), py(queries), meters(queries);
+    uint32_t r = 12345;
+    auto next01 = [&]() { r = r * 1664525u + 1013904223u; return static_cast<float>(r >> 8) / 16777216.0f; };
+    for (int i = 0; i < queries; ++i) {
+        pos[i] = next01();
+        meters[i] = model.distanceAt(pos[i]);
+        float x, y;
+        model.worldAt(pos[i], x, y);
+        px[i] = x + (next01() - 0.5f) * 16.0f;
+        py[i] = y + (next01() - 0.5f) * 16.0f;
+    }
+
+    double sink = 0.0;
+    const double worldNs = timePerCall(queries, [&](int i) {
+        float x, y; model.worldAt(pos[i], x, y); sink += x + y; });
+    const double headingNs = timePerCall(queries, [&](int i) { sink += model.headingAt(pos[i]); });
+    const double poseNs = timePerCall(queries, [&](int i) {
+        float x, y, h; model.poseAt(pos[i], x, y, h); sink += x + y + h; });
+    const double nearestNs = timePerCall(queries, [&](int i) { sink += model.nearestTrackPos(px[i], py[i]); });
+    const double separationNs = timePerCall(queries, [&](int i) {
+        sink += model.separationMeters(pos[i], pos[(i + 1) % queries]); });
+    const double exactNs = timePerCall(queries, [&](int i) {
+        float x, y, h; TrackModel::positionAt(arc, segments, meters[i], x, y, h); sink += x + y + h; });
+
+    std::printf("track model: %d segments, %.0f m, %zu table samples, build %.0f us\n",
+                ENDURO_SEGS, model.length(), model.tableSize(), buildUs);
+    std::printf("  %-28s %8.1f ns/query\n", "worldAt", worldNs);
+    std::printf("  %-28s %8.1f ns/query\n", "headingAt", headingNs);
+    std::printf("  %-28s %8.1f ns/query\n", "poseAt", poseNs);
+    std::printf("  %-28s %8.1f ns/query\n", "nearestTrackPos (<= 8 m off)", nearestNs);
+    std::printf("  %-28s %8.1f ns/query\n", "separationMeters", separationNs);
+    std::printf("  %-28s %8.1f ns/query\n", "exact positionAt (arc walk)", exactNs);
+    std::printf("  (checksum %.3g)\n", sink);
+    return 0;
+}
@@ -47,14 +47,14 @@ CXXFLAGS=(-std=c++17 -Wall -Wextra -O1 -g -pthread
 BIN="${OUT}/unit_tests"
 CC="${CC:-gcc}"
 CFLAGS=(-O1 -g)
-MINIZ_OBJ="${OUT}/miniz_tinfl.o"
+MINIZ_SUFFIX=""
 if [[ "${ASAN:-0}" == "1" ]]; then
     CXXFLAGS+=(-fsanitize=address,undefined -fno-sanitize-recover=all
                -fno-sanitize=float-cast-overflow -fno-omit-frame-pointer)
     CFLAGS+=(-fsanitize=address,undefined -fno-sanitize-recover=all
              -fno-omit-frame-pointer)
     BIN="${OUT}/unit_tests_asan"
-    MINIZ_OBJ="${OUT}/miniz_tinfl_asan.o"
+    MINIZ_SUFFIX="_asan"
     echo "ASAN=1 — building unit suite under AddressSanitizer + UBSan"
 fi
 
@@ -76,17 +76,34 @@ SOURCES=("${HERE}/test_plugin_utils.cpp"
          "${HERE}/test_render_frame_buffer.cpp"
          "${HERE}/test_crash_stack_format.cpp"
          "${HERE}/test_hud_sw_renderer.cpp"
+         "${HERE}/test_frame_export_abi.cpp"
+         "${HERE}/test_compact_strings.cpp"
+         "${HERE}/test_tape_io.cpp"
+         "${HERE}/test_tape_map.cpp"
+         "${HERE}/test_trace_buffer.cpp"
+         "${HERE}/test_latency_histogram.cpp"
+         "${HERE}/test_track_model.cpp"
+         "${HERE}/test_rider_motion.cpp"
+         "${HERE}/test_history_ring.cpp"
          "${ROOT}/mxbmrp3/core/hud_sw_renderer.cpp"
-         "${ROOT}/mxbmrp3/core/ui_config.cpp")
+         "${ROOT}/mxbmrp3/core/ui_config.cpp"
+         "${ROOT}/mxbmrp3/core/track_model.cpp"
+         "${ROOT}/mxbmrp3/core/rider_motion.cpp")
 
-# hud_sw_renderer.cpp's .fnt atlas decode links exactly one miniz TU. miniz is
-# C, not C++ — compile it with the C compiler and add the object to the link
-# (sanitized too under ASAN=1, so the DEFLATE path gets OOB coverage).
+# hud_sw_renderer.cpp's .fnt atlas decode inflates, and core/tape_io.h deflates
+# and inflates tape blocks. miniz is C, not C++ — compile the three TUs that
+# cover deflate + inflate with the C compiler and add the objects to the link
+# (sanitized too under ASAN=1, so the DEFLATE paths get OOB coverage).
 echo "Compiling miniz (${CC}) ..."
-"${CC}" "${CFLAGS[@]}" -c "${ROOT}/mxbmrp3/vendor/miniz/miniz_tinfl.c" -o "${MINIZ_OBJ}"
+MINIZ_OBJS=()
+for unit in miniz miniz_tdef miniz_tinfl; do
+    obj="${OUT}/${unit}${MINIZ_SUFFIX}.o"
+    "${CC}" "${CFLAGS[@]}" -c "${ROOT}/mxbmrp3/vendor/miniz/${unit}.c" -o "${obj}"
+    MINIZ_OBJS+=("${obj}")
+done
 
 echo "Compiling unit tests (${CXX}, doctest) ..."
-"${CXX}" "${CXXFLAGS[@]}" "${SOURCES[@]}" "${MINIZ_OBJ}" -o "${BIN}"
+"${CXX}" "${CXXFLAGS[@]}" "${SOURCES[@]}" "${MINIZ_OBJS[@]}" -o "${BIN}"
 
 echo
 ASAN_OPTIONS="${ASAN_OPTIONS:-halt_on_error=1:abort_on_error=1}" \
@@ -0,0 +1,119 @@
+// ============================================================================
+// tests/unit/test_compact_strings.cpp
+// Pure-logic tests for the compact in-pipeline string arena
+// (core/compact_strings.h) that HUDs record into and HudManager expands once per
+// frame. Pins what the render pipeline relies on:
+//   1. expandInto() reproduces exactly the SPluginString_t the old addString()
+//      built (text, position, font, size, justify, color), with the same
+//      99-character truncation.
+//   2. Frame assembly (appendText + push/pushAll) rebases text offsets, so strings
+//      from several HUDs and shadow copies sharing one text all expand correctly.
+//   3. The skip-shadow flag and justify survive packing into one byte.
+//   4. truncate() drops a tail of records and their text (a HUD redrawing
+//      only its last layer), so re-adding after it is the same as a fresh build.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/compact_strings.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+TEST_CASE("CompactStringArena: expand reproduces the game struct") {
+    CompactStringArena a;
+    a.add("1:23.456", 0.25f, 0.5f, 2, 7, 0xFF112233u, 0.0222f);
+    a.add("", 0.1f, 0.2f, 1, 3, 0x80FFFFFFu, 0.01f, true);
+
+    std::vector<SPluginString_t> out;
+    a.expandInto(out);
+    REQUIRE(out.size() == 2);
+    CHECK(std::string(out[0].m_szString) == "1:23.456");
+    CHECK(out[0].m_afPos[0] == 0.25f);
+    CHECK(out[0].m_afPos[1] == 0.5f);
+    CHECK(out[0].m_iJustify == 2);
+    CHECK(out[0].m_iFont == 7);
+    CHECK(out[0].m_ulColor == 0xFF112233u);
+    CHECK(out[0].m_fSize == 0.0222f);
+    CHECK(out[1].m_szString[0] == '\0');     // blank cells still emit a string
+    CHECK(out[1].m_iJustify == 1);
+
+    CHECK_FALSE(a[0].skipShadow());
+    CHECK(a[1].skipShadow());
+    CHECK(a[1].justify() == 1);
+    CHECK(a.length(0) == 8);
+    CHECK(std::string(a.text(0)) == "1:23.456");
+}
+
+TEST_CASE("CompactStringArena: over-long text truncates like the game buffer") {
+    std::string longText(300, 'x');
+    CompactStringArena a;
+    a.add(longText.c_str(), 0, 0, 0, 1, 0, 0.02f);
+    CHECK(a.length(0) == CompactStringArena::MAX_TEXT);
+
+    std::vector<SPluginString_t> out;
+    a.expandInto(out);
+    CHECK(std::string(out[0].m_szString) == std::string(CompactStringArena::MAX_TEXT, 'x'));
+}
+
+TEST_CASE("CompactStringArena: frame assembly rebases text and shares it with shadows") {
+    CompactStringArena hudA, hudB, frame;
+    hudA.add("Alice", 0.1f, 0.1f, 0, 1, 1, 0.02f);
+    hudA.add("P1", 0.2f, 0.1f, 0, 1, 1, 0.02f);
+    hudB.add("Bob", 0.3f, 0.3f, 0, 1, 1, 0.02f);
+
+    // HUD A in bulk; HUD B record by record with a shadow copy in front.
+    frame.pushAll(hudA, frame.appendText(hudA));
+    const uint32_t base = frame.appendText(hudB);
+    CompactString s = hudB[0];
+    s.textOffset += base;
+    CompactString shadow = s;
+    shadow.m_afPos[0] += 0.001f;
+    shadow.m_ulColor = 0xFF000000u;
+    frame.push(shadow);
+    frame.push(s);
+
+    std::vector<SPluginString_t> out;
+    frame.expandInto(out);
+    REQUIRE(out.size() == 4);
+    CHECK(std::string(out[0].m_szString) == "Alice");
+    CHECK(std::string(out[1].m_szString) == "P1");
+    CHECK(std::string(out[2].m_szString) == "Bob");
+    CHECK(std::string(out[3].m_szString) == "Bob");
+    CHECK(out[2].m_ulColor == 0xFF000000u);
+    // The shadow costs a record, not another copy of the text.
+    CHECK(frame.textBytes() == hudA.textBytes() + hudB.textBytes());
+
+    // Re-expanding a shorter frame into the same buffer reuses it.
+    frame.clear();
+    frame.add("x", 0, 0, 0, 1, 1, 0.02f);
+    frame.expandInto(out);
+    REQUIRE(out.size() == 1);
+    CHECK(std::string(out[0].m_szString) == "x");
+}
+
+TEST_CASE("CompactStringArena: truncate drops the tail records and their text") {
+    CompactStringArena a;
+    a.add("Map", 0.1f, 0.1f, 0, 1, 1, 0.02f);
+    a.add("#12", 0.2f, 0.2f, 1, 1, 1, 0.01f);
+    a.add("#7", 0.3f, 0.3f, 1, 1, 1, 0.01f);
+    const size_t headText = 4;   // "Map\0"
+
+    a.truncate(1);
+    CHECK(a.size() == 1);
+    CHECK(a.textBytes() == headText);
+    a.truncate(5);               // past the end: no-op
+    CHECK(a.size() == 1);
+
+    a.add("#44", 0.4f, 0.4f, 1, 1, 1, 0.01f);
+    CompactStringArena fresh;
+    fresh.add("Map", 0.1f, 0.1f, 0, 1, 1, 0.02f);
+    fresh.add("#44", 0.4f, 0.4f, 1, 1, 1, 0.01f);
+    std::vector<SPluginString_t> out, expected;
+    a.expandInto(out);
+    fresh.expandInto(expected);
+    REQUIRE(out.size() == 2);
+    CHECK(std::string(out[1].m_szString) == "#44");
+    CHECK(a.textBytes() == fresh.textBytes());
+    CHECK(std::memcmp(out.data(), expected.data(), sizeof(SPluginString_t) * out.size()) == 0);
+}
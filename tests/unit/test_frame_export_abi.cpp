@@ -0,0 +1,132 @@
+// ============================================================================
+// tests/unit/test_frame_export_abi.cpp
+// Pure-logic tests for the shared-memory frame export protocol
+// (core/frame_export_abi.h). The header is the reader contract, and its seqlock
+// is plain portable atomics over a raw block — so the protocol is pinned here on
+// heap memory, without a file mapping:
+//   1. Layout: slots round-robin after the header, geometry validates.
+//   2. Reader results: NoNewFrame before/after a frame, Ok with intact metadata.
+//   3. A real 2-thread writer/reader race: the reader never returns a torn frame
+//      (every payload byte carries its frame number) and frames only move forward.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/frame_export_abi.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 8-byte aligned heap block standing in for the mapped view.
+struct Block {
+    std::vector<uint64_t> words;
+    explicit Block(size_t bytes) : words((bytes + 7) / 8) {}
+    void* data() { return words.data(); }
+    size_t bytes() const { return words.size() * 8; }
+};
+
+frame_export::ShmHeader* makeHeader(Block& b, uint32_t slotCount, uint32_t slotBytes) {
+    frame_export::initHeader(b.data(), frame_export::FORMAT_RGBA, slotCount, slotBytes,
+                             16, 9, 0, 0, 1234);
+    return static_cast<frame_export::ShmHeader*>(b.data());
+}
+
+// One writer frame whose whole payload is the low byte of its frame number.
+void writeFrame(frame_export::ShmHeader* h, uint32_t payloadBytes) {
+    uint64_t n = 0;
+    frame_export::SlotHeader* s = frame_export::beginFrame(h, n);
+    std::memset(frame_export::payloadOf(s), static_cast<int>(n & 0xFF), payloadBytes);
+    s->quadCount = static_cast<uint32_t>(n);
+    s->payloadBytes = payloadBytes;
+    frame_export::commitFrame(h, s, n);
+}
+
+} // namespace
+
+TEST_CASE("frame export ABI: header layout and validation") {
+    const uint32_t slotBytes = frame_export::rgbaSlotBytes(16, 9);
+    Block b(frame_export::mappingBytes(3, slotBytes));
+    frame_export::ShmHeader* h = makeHeader(b, 3, slotBytes);
+
+    CHECK(frame_export::headerValid(h, b.bytes()));
+    CHECK_FALSE(frame_export::headerValid(h, b.bytes() - slotBytes));   // truncated view
+    CHECK(h->writerPid == 1234u);
+    CHECK(h->latest.load() == 0u);
+
+    // Frames 1..3 fill slots 0..2; frame 4 wraps onto slot 0.
+    auto* base = reinterpret_cast<uint8_t*>(h) + sizeof(frame_export::ShmHeader);
+    CHECK(reinterpret_cast<uint8_t*>(frame_export::slotAt(h, 1)) == base);
+    CHECK(reinterpret_cast<uint8_t*>(frame_export::slotAt(h, 3)) == base + 2 * slotBytes);
+    CHECK(frame_export::slotAt(h, 4) == frame_export::slotAt(h, 1));
+
+    h->magic[0] = 'X';
+    CHECK_FALSE(frame_export::headerValid(h, b.bytes()));
+}
+
+TEST_CASE("frame export ABI: reader sees only complete, newer frames") {
+    const uint32_t payload = 16 * 9 * 4;
+    const uint32_t slotBytes = frame_export::rgbaSlotBytes(16, 9);
+    Block b(frame_export::mappingBytes(4, slotBytes));
+    frame_export::ShmHeader* h = makeHeader(b, 4, slotBytes);
+
+    frame_export::SlotHeader meta;
+    std::vector<uint8_t> dst(payload);
+    CHECK(frame_export::readLatest(h, 0, meta, dst.data(), dst.size()) == frame_export::ReadResult::NoNewFrame);
+
+    writeFrame(h, payload);
+    writeFrame(h, payload);
+    REQUIRE(frame_export::readLatest(h, 0, meta, dst.data(), dst.size()) == frame_export::ReadResult::Ok);
+    CHECK(meta.frame == 2u);
+    CHECK(meta.seq.load() == 4u);
+    CHECK(meta.quadCount == 2u);
+    CHECK(meta.payloadBytes == payload);
+    CHECK(dst.front() == 2);
+    CHECK(dst.back() == 2);
+    CHECK(frame_export::readLatest(h, 2, meta, dst.data(), dst.size()) == frame_export::ReadResult::NoNewFrame);
+
+    // A frame mid-write (odd seq) is never handed out.
+    uint64_t n = 0;
+    frame_export::SlotHeader* s = frame_export::beginFrame(h, n);
+    s->seq.store(2 * n - 1);
+    h->latest.store(n);   // as if latest raced ahead of a commit
+    CHECK(frame_export::readLatest(h, 2, meta, dst.data(), dst.size(), 2) == frame_export::ReadResult::Lapped);
+}
+
+TEST_CASE("frame export ABI: concurrent writer never yields a torn frame") {
+    // Two slots and a large payload make laps (the writer overtaking a copy in
+    // progress) frequent; the reader must detect every one.
+    const uint32_t payload = 64 * 1024;
+    const uint32_t slotBytes = static_cast<uint32_t>(sizeof(frame_export::SlotHeader)) + payload;
+    Block b(frame_export::mappingBytes(2, slotBytes));
+    frame_export::ShmHeader* h = makeHeader(b, 2, slotBytes);
+
+    constexpr int kFrames = 20000;
+    std::atomic<bool> done{ false };
+    std::thread writer([&] {
+        for (int i = 0; i < kFrames; ++i) writeFrame(h, payload);
+        done.store(true);
+    });
+
+    std::vector<uint8_t> dst(payload);
+    frame_export::SlotHeader meta;
+    uint64_t last = 0;
+    int ok = 0, torn = 0, backwards = 0;
+    while (!done.load() || last < static_cast<uint64_t>(kFrames)) {
+        if (frame_export::readLatest(h, last, meta, dst.data(), dst.size()) != frame_export::ReadResult::Ok)
+            continue;
+        const uint8_t tag = static_cast<uint8_t>(meta.frame & 0xFF);
+        for (uint8_t v : dst) if (v != tag) { ++torn; break; }
+        if (meta.quadCount != meta.frame) ++torn;
+        if (meta.frame <= last) ++backwards;
+        last = meta.frame;
+        ++ok;
+    }
+    writer.join();
+
+    CHECK(ok > 0);
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(last == static_cast<uint64_t>(kFrames));
+}
@@ -0,0 +1,135 @@
+// ============================================================================
+// tests/unit/test_history_ring.cpp
+// Pure-logic tests for the strip-chart history rings (core/history_ring.h): the
+// ring keeps exactly the last `window` samples in order across wraps and
+// clear(), its two-span view covers the same samples, and SampleHistory's mip
+// columns and running min/max agree with a brute-force pass over the samples.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/history_ring.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+namespace {
+
+float noise(uint32_t& x) {
+    x = x * 1664525u + 1013904223u;
+    return static_cast<float>(x >> 8) / static_cast<float>(1u << 24);
+}
+
+}  // namespace
+
+TEST_CASE("HistoryRing: keeps the last window samples, oldest first, across wraps") {
+    HistoryRing<int, 8> ring(5);
+    CHECK(ring.empty());
+    CHECK(ring.view().empty());
+    std::deque<int> expect;
+    for (int v = 0; v < 40; ++v) {
+        ring.push(v);
+        expect.push_back(v);
+        if (expect.size() > 5) expect.pop_front();
+
+        REQUIRE(ring.size() == expect.size());
+        CHECK(ring.back() == v);
+        const HistoryView<int> view = ring.view();
+        REQUIRE(view.size() == expect.size());
+        CHECK(view.firstSize > 0);
+        CHECK(view.back() == v);
+        for (size_t i = 0; i < expect.size(); ++i) {
+            CHECK(ring[i] == expect[i]);
+            CHECK(view[i] == expect[i]);
+        }
+        // The spans are the storage itself: first runs to the array's end, second
+        // restarts at its head.
+        if (view.secondSize) CHECK(view.first + view.firstSize == view.second + 8);
+    }
+
+    ring.clear();
+    CHECK(ring.empty());
+    ring.push(99);
+    CHECK(ring.size() == 1);
+    CHECK(ring[0] == 99);
+    CHECK(ring.view().back() == 99);
+}
+
+TEST_CASE("SampleHistory: mip columns and min/max match a brute-force pass") {
+    SampleHistory h(200);
+    std::deque<float> expect;
+    uint32_t seed = 7;
+    for (int n = 0; n < 1500; ++n) {
+        const float v = noise(seed);
+        h.push(v);
+        expect.push_back(v);
+        if (expect.size() > 200) expect.pop_front();
+        if (n % 37 != 0 && n > 4) continue;
+
+        REQUIRE(h.size() == expect.size());
+        float lo = 0.0f, hi = 0.0f;
+        h.minMax(lo, hi);
+        CHECK(lo == *std::min_element(expect.begin(), expect.end()));
+        CHECK(hi == *std::max_element(expect.begin(), expect.end()));
+
+        // Level 0 is the samples themselves.
+        REQUIRE(h.columnCount(0) == expect.size());
+        for (size_t j = 0; j < expect.size(); ++j) {
+            const SampleHistory::Column c = h.column(0, j);
+            CHECK(c.lo == expect[j]);
+            CHECK(c.hi == expect[j]);
+            CHECK(c.last == j);
+        }
+
+        // Every level's columns tile the window newest-aligned: each covers the
+        // samples since the previous column's last, and its min/max bound them
+        // (the oldest may also include samples just before the window).
+        for (int level = 1; level <= SampleHistory::LEVELS; ++level) {
+            const size_t count = h.columnCount(level);
+            REQUIRE(count >= 1);
+            CHECK(count <= (expect.size() >> level) + 2);
+            size_t from = 0;
+            for (size_t j = 0; j < count; ++j) {
+                const SampleHistory::Column c = h.column(level, j);
+                REQUIRE(c.last < expect.size());
+                REQUIRE(c.last >= from);
+                const auto first = expect.begin() + static_cast<std::ptrdiff_t>(from);
+                const auto last = expect.begin() + static_cast<std::ptrdiff_t>(c.last) + 1;
+                CHECK(c.lo <= *std::min_element(first, last));
+                CHECK(c.hi >= *std::max_element(first, last));
+                if (j > 0) {
+                    // Interior columns are exactly their block.
+                    CHECK(c.lo == *std::min_element(first, last));
+                    CHECK(c.hi == *std::max_element(first, last));
+                    CHECK(c.last - from + 1 <= (size_t(1) << level));
+                }
+                from = c.last + 1;
+            }
+            CHECK(from == expect.size());
+        }
+    }
+}
+
+TEST_CASE("SampleHistory: levelFor picks the finest level that fits the pixel columns") {
+    SampleHistory h(200);
+    for (int i = 0; i < 500; ++i) h.push(static_cast<float>(i % 10) * 0.1f);
+    CHECK(h.levelFor(0) == 0);
+    CHECK(h.levelFor(400) == 0);
+    CHECK(h.levelFor(200) == 0);
+    const int level = h.levelFor(60);
+    CHECK(level > 0);
+    CHECK(h.columnCount(level) <= 60);
+    CHECK(h.columnCount(level - 1) > 60);
+    CHECK(h.columnCount(h.levelFor(1)) <= 2);
+
+    // Partly filled: a short history never needs a coarser level.
+    SampleHistory fresh(200);
+    for (int i = 0; i < 30; ++i) fresh.push(0.5f);
+    CHECK(fresh.levelFor(60) == 0);
+    fresh.clear();
+    CHECK(fresh.columnCount(0) == 0);
+    float lo = 1.0f, hi = 1.0f;
+    fresh.minMax(lo, hi);
+    CHECK(lo == 0.0f);
+    CHECK(hi == 0.0f);
+}
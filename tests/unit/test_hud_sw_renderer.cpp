@@ -19,6 +19,12 @@
 //  5. setViewport maps normalized [0,1] into the centered sub-rect while
 //     coords outside [0,1] still land in the surrounding window area (a
 //     scale viewport, NOT a letterbox clip).
+//  6. A Session Charts line min/max-decimated to the display's pixel columns
+//     (SessionChartsMath::decimateMinMax) rasterizes like the full polyline.
+//  7. A batched polyline (PolylineBuilder::appendPolyline, BaseHud::addPolyline)
+//     rasterizes like one addLineSegment() quad per segment, and its merge rules
+//     hold: a lone segment is bit-identical, a straight run is one quad, a
+//     zig-zag or a reversal is not merged, sub-pixel vertices are dropped.
 //
 // Uses the real shipped assets (mxbmrp3_data/fonts + icons), located relative
 // to this file so the test runs from any cwd.
@@ -26,6 +32,8 @@
 #include "doctest.h"
 
 #include "core/hud_sw_renderer.h"
+#include "hud/polyline_builder.h"
+#include "hud/session_charts_math.h"
 
 #include <cmath>
 #include <cstring>
@@ -87,6 +95,34 @@ struct TestFrame {
     }
 };
 
+// Compare the lit coverage of two renders of the same line: a pixel lit in one
+// image must have a lit pixel within one pixel in the other (edge pixels of a
+// 1.6 px line flip with sub-pixel slope changes; a missing or extra stroke
+// would not).
+struct Coverage { int lit = 0, exact = 0, missing = 0, extra = 0; };
+Coverage compareCoverage(const hudsw::Image& a, const hudsw::Image& b) {
+    auto lit = [](const hudsw::Image& im, int px, int py) {
+        return px >= 0 && py >= 0 && px < im.w && py < im.h && at(im, px, py).r > 127;
+    };
+    auto litNear = [&](const hudsw::Image& im, int px, int py) {
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                if (lit(im, px + dx, py + dy)) return true;
+        return false;
+    };
+    Coverage c;
+    for (int py = 0; py < a.h; ++py) {
+        for (int px = 0; px < a.w; ++px) {
+            const bool inA = lit(a, px, py), inB = lit(b, px, py);
+            if (inA) ++c.lit;
+            if (inA == inB) { if (inA) ++c.exact; continue; }
+            if (inA && !litNear(b, px, py)) ++c.missing;
+            if (inB && !litNear(a, px, py)) ++c.extra;
+        }
+    }
+    return c;
+}
+
 }  // namespace
 
 TEST_CASE("hud_sw_renderer: opaque quad fills its interior exactly, background outside") {
@@ -241,3 +277,244 @@ TEST_CASE("hud_sw_renderer: setViewport maps [0,1] into the sub-rect; outside-[0
     CHECK(at(im, 24, 140).b == 250);
     CHECK(at(im, 24, 100).b == 10);    // above it: background
 }
+
+TEST_CASE("hud_sw_renderer: a min/max-decimated chart line rasterizes like the full line") {
+    // A long, noisy series (~8 points per pixel column) squeezed into a 384 px
+    // wide plot on a 1280x720 display, drawn as the charts draw it: one
+    // thickness quad per segment (BaseHud::addLineSegment's geometry).
+    const int W = 1280, H = 720;
+    const float x0 = 0.1f, plotW = 0.3f, thickness = 0.0022f;
+    const size_t N = 3000;
+    std::vector<float> xs(N), ys(N);
+    uint32_t seed = 7;
+    float y = 0.5f;
+    for (size_t i = 0; i < N; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        y += (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.02f;
+        y = std::min(0.8f, std::max(0.2f, y));
+        xs[i] = x0 + plotW * static_cast<float>(i) / static_cast<float>(N - 1);
+        ys[i] = y;
+    }
+    auto segment = [&](size_t a, size_t b) {
+        const float dx = xs[b] - xs[a], dy = ys[b] - ys[a];
+        const float len = std::sqrt(dx * dx + dy * dy);
+        const float hx = (dy / len) * thickness * 0.5f / (16.0f / 9.0f);
+        const float hy = (-dx / len) * thickness * 0.5f;
+        SPluginQuad_t q{};
+        q.m_aafPos[0][0] = xs[a] + hx; q.m_aafPos[0][1] = ys[a] + hy;
+        q.m_aafPos[1][0] = xs[a] - hx; q.m_aafPos[1][1] = ys[a] - hy;
+        q.m_aafPos[2][0] = xs[b] - hx; q.m_aafPos[2][1] = ys[b] - hy;
+        q.m_aafPos[3][0] = xs[b] + hx; q.m_aafPos[3][1] = ys[b] + hy;
+        q.m_ulColor = abgr(255, 255, 255);
+        return q;
+    };
+
+    TestFrame full;
+    for (size_t i = 1; i < N; ++i) full.quads.push_back(segment(i - 1, i));
+    std::vector<size_t> keep;
+    SessionChartsMath::decimateMinMax(xs.data(), ys.data(), N, x0, static_cast<float>(W), keep);
+    TestFrame decimated;
+    for (size_t k = 1; k < keep.size(); ++k) decimated.quads.push_back(segment(keep[k - 1], keep[k]));
+
+    // At most 4 points per column, so the quad count no longer tracks N.
+    const int columns = static_cast<int>(plotW * W) + 1;
+    CHECK(keep.size() <= static_cast<size_t>(columns) * 4);
+    CHECK(decimated.quads.size() * 2 < full.quads.size());
+
+    hudsw::Renderer r;
+    hudsw::Image a; a.resize(W, H);
+    hudsw::Image b; b.resize(W, H);
+    r.render(a, full.build(), 0, 0, 0);
+    r.render(b, decimated.build(), 0, 0, 0);
+    const Coverage c = compareCoverage(a, b);
+    MESSAGE("decimated line: " << keep.size() << "/" << N << " points, " << c.exact << "/" << c.lit
+            << " lit pixels identical, " << c.missing << " missing / " << c.extra << " extra beyond 1 px");
+    REQUIRE(c.lit > 1000);
+    CHECK(c.exact * 100 >= c.lit * 95);
+    CHECK(c.missing == 0);
+    CHECK(c.extra == 0);
+}
+
+// --- Batched polylines (hud/polyline_builder.h) -------------------------------
+// Strokes on a 1280x720 display: 1280 px per unit across, 720 down.
+namespace {
+
+PolylineBuilder::Stroke lineStroke() {
+    return { abgr(255, 255, 255), 0.0022f, 16.0f / 9.0f, 1280.0f, 720.0f };
+}
+
+// Field by field (the struct has padding after m_iSprite).
+bool sameQuad(const SPluginQuad_t& a, const SPluginQuad_t& b) {
+    return std::memcmp(a.m_aafPos, b.m_aafPos, sizeof(a.m_aafPos)) == 0 &&
+           a.m_iSprite == b.m_iSprite && a.m_ulColor == b.m_ulColor;
+}
+
+// addLineSegment() per consecutive pair, as the graphs drew before batching.
+std::vector<SPluginQuad_t> perSegment(const std::vector<float>& xs, const std::vector<float>& ys) {
+    std::vector<SPluginQuad_t> out;
+    for (size_t i = 1; i < xs.size(); ++i)
+        PolylineBuilder::appendSegment(out, xs[i - 1], ys[i - 1], xs[i], ys[i], lineStroke());
+    return out;
+}
+
+std::vector<SPluginQuad_t> polyline(const std::vector<float>& xs, const std::vector<float>& ys) {
+    std::vector<SPluginQuad_t> out;
+    PolylineBuilder::Scratch scratch;
+    PolylineBuilder::appendPolyline(out, xs.data(), ys.data(), xs.size(), lineStroke(), scratch);
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE("polyline_builder: a lone segment is bit-identical to addLineSegment's quad") {
+    // Every direction, short and long, including sub-pixel lengths (a two-point
+    // polyline has nothing to merge or drop).
+    uint32_t seed = 11;
+    auto rnd = [&]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    // Lengths below addLineSegment()'s zero-length cutoff draw nothing either way.
+    int drawn = 0;
+    for (int i = 0; i < 500; ++i) {
+        const float scale = (i % 3 == 0) ? 0.0005f : 0.2f;
+        const float x0 = rnd(), y0 = rnd();
+        const std::vector<float> xs = { x0, x0 + (rnd() - 0.5f) * scale };
+        const std::vector<float> ys = { y0, y0 + (rnd() - 0.5f) * scale };
+        const std::vector<SPluginQuad_t> want = perSegment(xs, ys), got = polyline(xs, ys);
+        REQUIRE(got.size() == want.size());
+        if (got.empty()) continue;
+        CHECK(sameQuad(got[0], want[0]));
+        ++drawn;
+    }
+    CHECK(drawn > 450);
+    CHECK(polyline({ 0.3f, 0.3f }, { 0.4f, 0.4f }).empty());
+}
+
+TEST_CASE("polyline_builder: a flat run merges into one quad spanning it") {
+    std::vector<float> xs, ys;
+    for (int i = 0; i < 200; ++i) {
+        xs.push_back(0.1f + 0.001f * static_cast<float>(i));
+        ys.push_back(0.5f);
+    }
+    const std::vector<SPluginQuad_t> q = polyline(xs, ys);
+    REQUIRE(q.size() == 1);
+    // The run's own segment: first point to last.
+    const std::vector<SPluginQuad_t> whole = perSegment({ xs.front(), xs.back() }, { ys.front(), ys.back() });
+    CHECK(sameQuad(q[0], whole[0]));
+
+    // A slope merges too, and a vertex 0.2 px off the line stays in the run
+    // while one 0.3 px off (past the 0.25 px tolerance) splits it: runs end
+    // before it, through it and just after it.
+    std::vector<float> sx, sy;
+    for (int i = 0; i <= 20; ++i) {
+        sx.push_back(0.2f + 0.01f * static_cast<float>(i));
+        sy.push_back(0.3f + 0.005f * static_cast<float>(i));
+    }
+    CHECK(polyline(sx, sy).size() == 1);
+    std::vector<float> near = sy, far = sy;
+    near[10] += 0.2f / 720.0f;
+    far[10] += 0.3f / 720.0f;
+    CHECK(polyline(sx, near).size() == 1);
+    CHECK(polyline(sx, far).size() == 4);
+}
+
+TEST_CASE("polyline_builder: a zig-zag stays one quad per segment, each exactly addLineSegment's") {
+    std::vector<float> xs, ys;
+    for (int i = 0; i < 40; ++i) {
+        xs.push_back(0.1f + 0.004f * static_cast<float>(i));   // ~5 px steps
+        ys.push_back((i % 2) ? 0.52f : 0.5f);                  // ~14 px swings
+    }
+    const std::vector<SPluginQuad_t> want = perSegment(xs, ys), got = polyline(xs, ys);
+    REQUIRE(got.size() == want.size());
+    REQUIRE(got.size() == xs.size() - 1);
+    for (size_t i = 0; i < got.size(); ++i) CHECK(sameQuad(got[i], want[i]));
+}
+
+TEST_CASE("polyline_builder: a reversal breaks the run; sub-pixel vertices are dropped") {
+    // Out and back along one line: collinear, but the return leg must not be
+    // folded into the outward quad (it would end at the wrong point).
+    const std::vector<float> xs = { 0.1f, 0.2f, 0.3f, 0.15f }, ys = { 0.5f, 0.5f, 0.5f, 0.5f };
+    const std::vector<SPluginQuad_t> q = polyline(xs, ys);
+    REQUIRE(q.size() == 2);
+    CHECK(sameQuad(q[0], perSegment({ 0.1f, 0.3f }, { 0.5f, 0.5f })[0]));
+    CHECK(sameQuad(q[1], perSegment({ 0.3f, 0.15f }, { 0.5f, 0.5f })[0]));
+
+    // A vertex 0.4 px from the run's start is dropped even though it turns the
+    // line; the quad goes straight on to the next vertex. The last vertex is
+    // never dropped.
+    const float px = 1.0f / 1280.0f;
+    const std::vector<SPluginQuad_t> d = polyline({ 0.1f, 0.1f + 0.4f * px, 0.1f }, { 0.5f, 0.5f, 0.55f });
+    REQUIRE(d.size() == 1);
+    CHECK(sameQuad(d[0], perSegment({ 0.1f, 0.1f }, { 0.5f, 0.55f })[0]));
+    const std::vector<SPluginQuad_t> tail = polyline({ 0.1f, 0.1f, 0.1f + 0.4f * px }, { 0.5f, 0.55f, 0.55f });
+    CHECK(tail.size() == 2);
+}
+
+TEST_CASE("hud_sw_renderer: a batched polyline rasterizes like one addLineSegment per segment") {
+    // The traces the graph HUDs batch: a telemetry strip (idle, ramps, a
+    // pinned-full plateau, a noisy stretch, a step), Session Charts lines (a
+    // few points per lap, straight stretches and kinks) and a dense noisy line
+    // (many sub-pixel steps per column).
+    const int W = 1280, H = 720;
+    std::vector<std::vector<float>> xsets, ysets;
+    {
+        std::vector<float> xs, ys;
+        uint32_t seed = 3;
+        for (int i = 0; i < 200; ++i) {
+            float v = 0.0f;
+            if (i >= 20 && i < 60) v = (i - 20) / 40.0f;
+            else if (i >= 60 && i < 90) v = 1.0f;
+            else if (i >= 90 && i < 150) {
+                seed = seed * 1664525u + 1013904223u;
+                v = 0.5f + (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.4f;
+            } else if (i >= 150) v = 0.3f;
+            xs.push_back(0.05f + 0.3f * static_cast<float>(i) / 199.0f);
+            ys.push_back(0.1f + 0.2f - v * 0.2f);
+        }
+        xsets.push_back(xs); ysets.push_back(ys);
+    }
+    for (int rider = 0; rider < 4; ++rider) {
+        std::vector<float> xs, ys;
+        for (int lap = 0; lap <= 30; ++lap) {
+            xs.push_back(0.45f + 0.4f * static_cast<float>(lap) / 30.0f);
+            const float drift = (lap > 12 && lap < 18) ? 0.02f * (rider + 1) : 0.0f;
+            ys.push_back(0.1f + 0.05f * rider + 0.002f * lap + drift);
+        }
+        xsets.push_back(xs); ysets.push_back(ys);
+    }
+    {
+        std::vector<float> xs, ys;
+        uint32_t seed = 7;
+        float y = 0.7f;
+        for (int i = 0; i < 3000; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            y += (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.01f;
+            y = std::min(0.9f, std::max(0.5f, y));
+            xs.push_back(0.1f + 0.8f * static_cast<float>(i) / 2999.0f);
+            ys.push_back(y);
+        }
+        xsets.push_back(xs); ysets.push_back(ys);
+    }
+
+    TestFrame segments, batched;
+    for (size_t t = 0; t < xsets.size(); ++t) {
+        for (const SPluginQuad_t& q : perSegment(xsets[t], ysets[t])) segments.quads.push_back(q);
+        for (const SPluginQuad_t& q : polyline(xsets[t], ysets[t])) batched.quads.push_back(q);
+    }
+    CHECK(batched.quads.size() < segments.quads.size());
+
+    hudsw::Renderer r;
+    hudsw::Image a; a.resize(W, H);
+    hudsw::Image b; b.resize(W, H);
+    r.render(a, segments.build(), 0, 0, 0);
+    r.render(b, batched.build(), 0, 0, 0);
+    const Coverage c = compareCoverage(a, b);
+    MESSAGE("batched polyline: " << batched.quads.size() << "/" << segments.quads.size() << " quads, "
+            << c.exact << "/" << c.lit << " lit pixels identical, " << c.missing << " missing / "
+            << c.extra << " extra beyond 1 px");
+    REQUIRE(c.lit > 3000);
+    CHECK(c.exact * 100 >= c.lit * 95);
+    CHECK(c.missing == 0);
+    CHECK(c.extra == 0);
+}
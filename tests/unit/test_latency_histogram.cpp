@@ -0,0 +1,88 @@
+// ============================================================================
+// tests/unit/test_latency_histogram.cpp
+// Pure-logic tests for the profiler's log-linear latency histogram
+// (core/latency_histogram.h): the bucket index / bound math is contiguous and
+// inverse, every value lands in a bucket no wider than 1/16 of it, and the
+// quantiles come back within half a bucket of the exact sorted-sample answer.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("LatencyHistogram: buckets are contiguous and bounded by 1/16 of the value") {
+    using H = LatencyHistogram;
+    CHECK(H::bucketIndex(0) == 0);
+    CHECK(H::bucketIndex(31) == 31);                      // exact region
+    CHECK(H::bucketIndex(H::MAX_VALUE) == H::BUCKETS - 1);
+
+    long long expectLow = 0;
+    for (int b = 0; b < H::BUCKETS; ++b) {
+        CHECK(H::bucketLow(b) == expectLow);              // no gaps, no overlap
+        const long long w = H::bucketWidth(b);
+        CHECK(H::bucketIndex(H::bucketLow(b)) == b);
+        CHECK(H::bucketIndex(H::bucketLow(b) + w - 1) == b);
+        if (H::bucketLow(b) >= 32) CHECK(w * 16 <= H::bucketLow(b));
+        expectLow += w;
+    }
+    CHECK(expectLow == H::MAX_VALUE + 1);
+}
+
+TEST_CASE("LatencyHistogram: quantiles match the sorted samples within half a bucket") {
+    LatencyHistogram h;
+    std::vector<long long> samples;
+    // Skewed, deterministic: mostly ~100-300 us with a long tail to ~80 ms.
+    uint32_t x = 12345;
+    for (int i = 0; i < 100000; ++i) {
+        x = x * 1664525u + 1013904223u;
+        long long v = 100 + (x >> 24);
+        if ((x & 0x3ff) == 7) v = 5000 + (x >> 16);        // ~0.1% tail
+        samples.push_back(v);
+        h.record(v);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    CHECK(h.count() == samples.size());
+    CHECK(h.min() == samples.front());
+    CHECK(h.max() == samples.back());
+
+    const double qs[] = { 0.5, 0.9, 0.99, 0.999 };
+    long long got[4];
+    h.quantiles(qs, got, 4);
+    for (int i = 0; i < 4; ++i) {
+        const size_t rank = static_cast<size_t>(std::ceil(qs[i] * samples.size()));
+        const long long exact = samples[rank - 1];
+        const long long halfWidth =
+            LatencyHistogram::bucketWidth(LatencyHistogram::bucketIndex(exact)) / 2;
+        CHECK(std::llabs(got[i] - exact) <= halfWidth);
+        CHECK(h.quantile(qs[i]) == got[i]);
+    }
+    CHECK(h.quantile(1.0) == samples.back());
+}
+
+TEST_CASE("LatencyHistogram: small counts, clamping and reset") {
+    LatencyHistogram h;
+    CHECK(h.quantile(0.99) == 0);                          // empty
+    CHECK(h.mean() == 0.0);
+
+    h.record(7);
+    CHECK(h.quantile(0.5) == 7);
+    CHECK(h.quantile(0.999) == 7);
+
+    h.record(-3);                                          // clock anomaly -> 0
+    CHECK(h.min() == 0);
+
+    h.record(LatencyHistogram::MAX_VALUE * 4);             // past the range: last bucket
+    CHECK(h.max() == LatencyHistogram::MAX_VALUE * 4);     // max stays exact
+    CHECK(h.quantile(1.0) == LatencyHistogram::MAX_VALUE * 4);
+    CHECK(h.count() == 3);
+
+    h.reset();
+    CHECK(h.count() == 0);
+    CHECK(h.max() == 0);
+    CHECK(h.quantile(0.5) == 0);
+}
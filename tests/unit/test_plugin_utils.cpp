@@ -7,7 +7,9 @@
 // compiler — no game engine, no Windows, no PluginData singleton. (The
 // formatting functions in plugin_utils.CPP reach into the PluginData singleton
 // and the full PluginConstants tables, which drag in the game API and can't
-// build here; those are covered by the Wine integration tests instead.)
+// build here; those are covered by the Wine integration tests instead. The
+// lap-time/gap kernels they delegate to live in core/time_format.h and ARE
+// pinned here, byte-for-byte against the printf formats they replaced.)
 //
 // Framework: doctest (single header, tests/integration/harness/doctest.h). This TU
 // defines the doctest main; add more unit TUs and link them together (see
@@ -17,7 +19,13 @@
 #include "doctest.h"
 
 #include "core/plugin_utils.h"
+#include "core/time_format.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 using PU = PluginUtils;
 
@@ -134,3 +142,152 @@ TEST_CASE("getRelativePositionColor: ahead / behind / lapped matrix") {
     CHECK(f(2, 5, 3, 3, NEUTRAL, WARNING, FALLBACK) == WARNING);   // behind, same lap
     CHECK(f(2, 5, 4, 3, NEUTRAL, WARNING, FALLBACK) == PU::darkenColor(WARNING, 0.7f));  // behind, lapped
 }
+
+// ---------------------------------------------------------------------------
+// time_format: the snprintf-free lap-time/gap kernels must reproduce the old
+// snprintf formats byte for byte — including snprintf's truncation into small
+// buffers. The references below are the pre-kernel implementations verbatim,
+// with the PluginData compact flag turned into a parameter.
+// ---------------------------------------------------------------------------
+namespace {
+
+void refLapTime(int lapTimeMs, bool compact, char* buffer, size_t bufferSize) {
+    if (lapTimeMs >= 0) {
+        int minutes = lapTimeMs / 60000;
+        int seconds = (lapTimeMs % 60000) / 1000;
+        int ms = lapTimeMs % 1000;
+        if (compact && minutes == 0) snprintf(buffer, bufferSize, "%d.%03d", seconds, ms);
+        else snprintf(buffer, bufferSize, "%d:%02d.%03d", minutes, seconds, ms);
+    } else if (bufferSize) {
+        buffer[0] = '\0';
+    }
+}
+
+void refTimeDiff(int diffMs, bool compact, char* buffer, size_t bufferSize) {
+    char sign = '+';
+    int absDiff = diffMs;
+    if (diffMs < 0) { sign = '-'; absDiff = (diffMs == INT_MIN) ? INT_MAX : -diffMs; }
+    int minutes = absDiff / 60000;
+    int seconds = (absDiff % 60000) / 1000;
+    int ms = absDiff % 1000;
+    if (compact && minutes == 0) snprintf(buffer, bufferSize, "%c%d.%03d", sign, seconds, ms);
+    else snprintf(buffer, bufferSize, "%c%d:%02d.%03d", sign, minutes, seconds, ms);
+}
+
+void refLapTimeTenths(int lapTimeMs, bool compact, char* buffer, size_t bufferSize) {
+    if (lapTimeMs >= 0) {
+        int minutes = lapTimeMs / 60000;
+        int seconds = (lapTimeMs % 60000) / 1000;
+        int tenths = (lapTimeMs % 1000) / 100;
+        if (compact && minutes == 0) snprintf(buffer, bufferSize, "%d.%d", seconds, tenths);
+        else snprintf(buffer, bufferSize, "%d:%02d.%d", minutes, seconds, tenths);
+    } else if (bufferSize) {
+        buffer[0] = '\0';
+    }
+}
+
+void refGapCompact(int diffMs, bool, char* buffer, size_t bufferSize) {
+    char sign = '+';
+    int absDiff = diffMs;
+    if (diffMs < 0) { sign = '-'; absDiff = (diffMs == INT_MIN) ? INT_MAX : -diffMs; }
+    int minutes = absDiff / 60000;
+    int seconds = (absDiff % 60000) / 1000;
+    int tenths = (absDiff % 1000) / 100;
+    if (minutes > 0) snprintf(buffer, bufferSize, "%c%d:%02d.%d", sign, minutes, seconds, tenths);
+    else snprintf(buffer, bufferSize, "%c%d.%d", sign, seconds, tenths);
+}
+
+using RefFn = void (*)(int, bool, char*, size_t);
+struct ModeRef { time_format::Mode mode; RefFn ref; const char* name; };
+const ModeRef kModes[] = {
+    { time_format::Mode::LAP,         refLapTime,       "LAP" },
+    { time_format::Mode::DIFF,        refTimeDiff,      "DIFF" },
+    { time_format::Mode::LAP_TENTHS,  refLapTimeTenths, "LAP_TENTHS" },
+    { time_format::Mode::GAP_COMPACT, refGapCompact,    "GAP_COMPACT" },
+};
+
+// Values: every boundary the formats care about, then random draws over the
+// realistic range (+/- 2 h), the first hour densely, and the whole int range.
+std::vector<int> timeFormatValues() {
+    std::vector<int> v = { 0, 1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 59999, 60000, 60001,
+                           599999, 600000, 3599999, 3600000, 35999999, 36000000,
+                           INT_MAX, INT_MAX - 1, INT_MIN, INT_MIN + 1 };
+    for (size_t i = 0, n = v.size(); i < n; ++i) if (v[i] != INT_MIN) v.push_back(-v[i]);
+    std::mt19937 rng(0x7157u);
+    std::uniform_int_distribution<int> race(-7200000, 7200000), lap(0, 3600000),
+                                       any(INT_MIN, INT_MAX);
+    for (int i = 0; i < 40000; ++i) v.push_back(race(rng));
+    for (int i = 0; i < 20000; ++i) v.push_back(lap(rng));
+    for (int i = 0; i < 20000; ++i) v.push_back(any(rng));
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("time_format kernels are byte-identical to the snprintf formats") {
+    const std::vector<int> values = timeFormatValues();
+    long long mismatches = 0;
+    for (const ModeRef& m : kModes) {
+        for (bool compact : { false, true }) {
+            for (int value : values) {
+                char want[32], got[32];
+                m.ref(value, compact, want, sizeof(want));
+                const size_t len = time_format::write(m.mode, value, compact, got);
+                if (len > time_format::MAX_LEN || std::string(want) != got || len != std::strlen(want)) {
+                    if (++mismatches <= 5)
+                        FAIL_CHECK(m.name << " compact=" << compact << " value=" << value
+                                   << " want '" << want << "' got '" << got << "'");
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("time_format::copyTruncated follows snprintf truncation for every buffer size") {
+    for (const ModeRef& m : kModes) {
+        for (int value : { 0, 59999, 61234, -61234, 600000, -754321, INT_MAX, INT_MIN }) {
+            for (bool compact : { false, true }) {
+                char text[time_format::MAX_LEN + 1];
+                const size_t len = time_format::write(m.mode, value, compact, text);
+                for (size_t size = 0; size <= time_format::MAX_LEN + 2; ++size) {
+                    char want[32], got[32];
+                    std::memset(want, '#', sizeof(want));
+                    std::memset(got, '#', sizeof(got));
+                    m.ref(value, compact, want, size);
+                    time_format::copyTruncated(text, len, got, size);
+                    CAPTURE(m.name); CAPTURE(value); CAPTURE(size);
+                    CHECK(std::memcmp(want, got, sizeof(want)) == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("time_format::Memo returns the kernel's text and keys on mode and compact") {
+    time_format::Memo memo;
+    char out[32], want[32];
+    std::mt19937 rng(42u);
+    std::uniform_int_distribution<int> gaps(-120000, 120000);
+    // A table-like workload: a handful of cells, revisited many times, with the
+    // compact flag flipping mid-way and every mode sharing the same memo.
+    std::vector<int> cells;
+    for (int i = 0; i < 24; ++i) cells.push_back(gaps(rng));
+    for (int pass = 0; pass < 50; ++pass) {
+        const bool compact = pass >= 25;
+        for (int value : cells) {
+            for (const ModeRef& m : kModes) {
+                memo.format(m.mode, value, compact, out, sizeof(out));
+                m.ref(value, compact, want, sizeof(want));
+                REQUIRE(std::string(out) == want);
+            }
+        }
+    }
+    CHECK(memo.hits() > memo.misses() * 5);   // unchanged cells are mostly copies
+
+    // Small destination buffers truncate the cached text exactly like snprintf.
+    memo.format(time_format::Mode::DIFF, -754321, false, out, 5);
+    CHECK(std::string(out) == "-12:");
+    memo.format(time_format::Mode::DIFF, -754321, false, out, sizeof(out));
+    CHECK(std::string(out) == "-12:34.321");
+}
@@ -10,13 +10,17 @@
 //   2. acquire() returns the most recently published frame, and re-returns the same
 //      one if nothing new was published (no stale-swap / no tearing).
 // It also runs a real 2-thread producer/consumer loop under ThreadSanitizer-style
-// scrutiny to catch a data race in the index bookkeeping.
+// scrutiny to catch a data race in the index bookkeeping, and the same buffer with
+// the CompanionWindow frame payload behind a deliberately slow consumer, to show
+// the producer's submit time stays bounded.
 // ============================================================================
 #include "doctest.h"
 
 #include "core/render_frame_buffer.h"
+#include "core/companion_window.h"
 
 #include <atomic>
+#include <chrono>
 #include <set>
 #include <thread>
 
@@ -131,3 +135,66 @@ TEST_CASE("RenderFrameBuffer: concurrent producer/consumer stays consistent") {
     // Final acquire sees the last frame the producer published.
     CHECK(buf.acquire().tag == kFrames);
 }
+
+TEST_CASE("RenderFrameBuffer: companion producer time stays bounded under a slow consumer") {
+    // The CompanionWindow handoff (core/companion_window.h): submit() copies a frame
+    // into the write slot and publishes; the window thread renders straight out of the
+    // acquired slot for as long as its present takes. The old design copied under a
+    // mutex the window thread also held, so a slow present stalled the game thread.
+    // Here the consumer holds every frame for kHoldMs (a stuck DwmFlush stand-in) and
+    // the producer's worst submit must stay far below that — it never waits on it.
+    using Frame = CompanionWindow::Frame;
+    std::vector<SPluginQuad_t> quads(4000);
+    CompactStringArena strings;
+    for (size_t i = 0; i < quads.size(); ++i) quads[i].m_iSprite = static_cast<int>(i);
+    for (int i = 0; i < 1500; ++i) strings.add("12.345", 0.5f, 0.5f, 0, i, 0xFFFFFFFFu, 0.02f);
+
+    RenderFrameBuffer<Frame> buf;
+    constexpr int kHoldMs = 25;
+    constexpr int kSubmits = 400;
+    std::atomic<bool> stop{ false };
+    std::atomic<int> framesRendered{ 0 };
+    bool torn = false;
+
+    std::thread consumer([&]() {
+        while (!stop.load()) {
+            if (!buf.everProduced()) { std::this_thread::yield(); continue; }
+            const Frame& f = buf.acquire();
+            // "Render" slowly while holding the display slot, then verify it wasn't
+            // scribbled on meanwhile (first/last primitives still match the payload).
+            std::this_thread::sleep_for(std::chrono::milliseconds(kHoldMs));
+            if (f.quads.size() != quads.size() || f.strings.size() != strings.size() ||
+                f.quads.back().m_iSprite != static_cast<int>(quads.size() - 1) ||
+                f.strings[f.strings.size() - 1].m_iFont != static_cast<int>(strings.size() - 1)) {
+                torn = true;
+            }
+            framesRendered.fetch_add(1);
+        }
+    });
+
+    // Warm all three slots first (their first fill allocates), as a running
+    // companion has long since done — we're measuring the steady state.
+    for (int i = 0; i < 3; ++i) { buf.writeSlot().assign(quads, strings); buf.publish(); }
+
+    long long worstUs = 0;
+    for (int i = 0; i < kSubmits; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        buf.writeSlot().assign(quads, strings);
+        buf.publish();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        if (us > worstUs) worstUs = us;
+        std::this_thread::sleep_for(std::chrono::microseconds(500));  // ~game frame pacing
+    }
+    stop.store(true);
+    consumer.join();
+
+    MESSAGE("companion submit: worst " << worstUs << " us over " << kSubmits
+            << " submits; consumer rendered " << framesRendered.load()
+            << " frames at " << kHoldMs << " ms each");
+    CHECK_FALSE(torn);
+    CHECK(framesRendered.load() > 0);
+    // Generous bound (CI/sanitizer noise), but still well under one consumer hold —
+    // under the old shared-mutex copy every submit that collided paid up to kHoldMs.
+    CHECK(worstUs < kHoldMs * 1000 / 2);
+}
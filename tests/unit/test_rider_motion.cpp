@@ -0,0 +1,200 @@
+// ============================================================================
+// tests/unit/test_rider_motion.cpp
+// Rider dead reckoning (core/rider_motion.h) on synthetic batches: a rider at
+// constant velocity is predicted exactly between samples; extrapolation stops
+// at MAX_EXTRAPOLATION_US; yaw and trackPos take the short way across their
+// wrap; a teleport, a long gap or a crash holds the rider at its sample, and
+// so does a rider standing still (isMoving() false); a back-to-back burst keeps
+// the velocity; and the rider set follows the latest batch regardless of order.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/rider_motion.h"
+
+#include <vector>
+
+namespace {
+
+Unified::TrackPositionData rider(int raceNum, float x, float z, float yaw, float trackPos, bool crashed = false) {
+    Unified::TrackPositionData p;
+    p.raceNum = raceNum;
+    p.posX = x;
+    p.posY = 10.0f;
+    p.posZ = z;
+    p.yaw = yaw;
+    p.trackPos = trackPos;
+    p.crashed = crashed ? 1 : 0;
+    return p;
+}
+
+Unified::TrackPositionData predicted(const RiderMotion& motion, int raceNum, long long nowUs) {
+    Unified::TrackPositionData p;
+    REQUIRE(motion.predictRider(raceNum, nowUs, p));
+    return p;
+}
+
+constexpr long long FRAME_US = 33333;   // the game's ~30 Hz batches
+
+}  // namespace
+
+TEST_CASE("RiderMotion: constant velocity is extrapolated between samples") {
+    RiderMotion motion;
+    const Unified::TrackPositionData a = rider(7, 100.0f, 200.0f, 30.0f, 0.25f);
+    const Unified::TrackPositionData b = rider(7, 101.0f, 199.0f, 31.0f, 0.2505f);
+    motion.update(&a, 1, 1000000);
+
+    // One sample: no velocity yet, held.
+    Unified::TrackPositionData p = predicted(motion, 7, 1020000);
+    CHECK(p.posX == 100.0f);
+    CHECK_FALSE(motion.isMoving(1020000));
+
+    motion.update(&b, 1, 1000000 + FRAME_US);
+    CHECK(motion.isMoving(1000000 + FRAME_US));
+    const long long half = 1000000 + FRAME_US + FRAME_US / 2;
+    p = predicted(motion, 7, half);
+    CHECK(p.posX == doctest::Approx(101.5f).epsilon(0.0001));
+    CHECK(p.posZ == doctest::Approx(198.5f).epsilon(0.0001));
+    CHECK(p.posY == doctest::Approx(10.0f));
+    CHECK(p.yaw == doctest::Approx(31.5f).epsilon(0.0001));
+    CHECK(p.trackPos == doctest::Approx(0.25075f).epsilon(0.0001));
+    CHECK(p.raceNum == 7);
+
+    // At the sample time the prediction is the sample; before it, too.
+    p = predicted(motion, 7, 1000000);
+    CHECK(p.posX == 101.0f);
+    CHECK_FALSE(motion.predictRider(8, half, p));
+}
+
+TEST_CASE("RiderMotion: extrapolation is clamped to the window, then holds") {
+    RiderMotion motion;
+    const Unified::TrackPositionData a = rider(3, 0.0f, 0.0f, 0.0f, 0.5f);
+    const Unified::TrackPositionData b = rider(3, 0.0f, 1.0f, 0.0f, 0.5f);   // 30 m/s north
+    motion.update(&a, 1, 0);
+    motion.update(&b, 1, FRAME_US);
+
+    const float perUs = 1.0f / FRAME_US;
+    const long long end = FRAME_US + RiderMotion::MAX_EXTRAPOLATION_US;
+    CHECK(predicted(motion, 3, end).posZ == doctest::Approx(1.0f + perUs * RiderMotion::MAX_EXTRAPOLATION_US));
+    CHECK(predicted(motion, 3, end + 500000).posZ == predicted(motion, 3, end).posZ);
+    CHECK(motion.isMoving(end - 1));
+    CHECK_FALSE(motion.isMoving(end));
+}
+
+TEST_CASE("RiderMotion: yaw and trackPos take the short way across the wrap") {
+    RiderMotion motion;
+    const Unified::TrackPositionData a = rider(1, 0.0f, 0.0f, 179.0f, 0.999f);
+    const Unified::TrackPositionData b = rider(1, 0.0f, 0.5f, -179.0f, 0.0005f);   // +2 deg, +0.0015
+    motion.update(&a, 1, 0);
+    motion.update(&b, 1, FRAME_US);
+
+    const Unified::TrackPositionData p = predicted(motion, 1, FRAME_US * 2);
+    CHECK(p.yaw == doctest::Approx(-177.0f).epsilon(0.0001));
+    CHECK(p.trackPos == doctest::Approx(0.002f).epsilon(0.001));
+
+    // Going backwards over S/F lands just below 1, not below 0.
+    RiderMotion back;
+    const Unified::TrackPositionData c = rider(1, 0.0f, 0.0f, 0.0f, 0.001f);
+    const Unified::TrackPositionData d = rider(1, 0.0f, -0.5f, 0.0f, 0.0f);
+    back.update(&c, 1, 0);
+    back.update(&d, 1, FRAME_US);
+    const float pos = predicted(back, 1, FRAME_US * 2).trackPos;
+    CHECK(pos == doctest::Approx(0.999f).epsilon(0.0001));
+    CHECK(pos < 1.0f);
+}
+
+TEST_CASE("RiderMotion: teleports, gaps and crashes hold at the sample") {
+    const long long dt = FRAME_US;
+    SUBCASE("teleport") {
+        RiderMotion motion;
+        const Unified::TrackPositionData a = rider(5, 0.0f, 0.0f, 0.0f, 0.1f);
+        const Unified::TrackPositionData b = rider(5, 400.0f, 0.0f, 0.0f, 0.6f);   // reset to the gate
+        motion.update(&a, 1, 0);
+        motion.update(&b, 1, dt);
+        CHECK(predicted(motion, 5, dt * 2).posX == 400.0f);
+        CHECK_FALSE(motion.isMoving(dt));
+    }
+    SUBCASE("gap") {
+        RiderMotion motion;
+        const Unified::TrackPositionData a = rider(5, 0.0f, 0.0f, 0.0f, 0.1f);
+        const Unified::TrackPositionData b = rider(5, 10.0f, 0.0f, 0.0f, 0.11f);
+        motion.update(&a, 1, 0);
+        motion.update(&b, 1, RiderMotion::MAX_SAMPLE_INTERVAL_US + 1);
+        CHECK(predicted(motion, 5, RiderMotion::MAX_SAMPLE_INTERVAL_US + dt).posX == 10.0f);
+    }
+    SUBCASE("crash") {
+        RiderMotion motion;
+        const Unified::TrackPositionData a = rider(5, 0.0f, 0.0f, 0.0f, 0.1f);
+        const Unified::TrackPositionData b = rider(5, 0.5f, 0.0f, 0.0f, 0.1001f, true);
+        motion.update(&a, 1, 0);
+        motion.update(&b, 1, dt);
+        CHECK(predicted(motion, 5, dt * 2).posX == 0.5f);
+    }
+}
+
+TEST_CASE("RiderMotion: a rider standing still is not moving") {
+    RiderMotion motion;
+    // Sample jitter of a parked bike: 2 mm and 0.03 degrees per batch.
+    const Unified::TrackPositionData a = rider(4, 50.0f, 60.0f, 90.0f, 0.4f);
+    const Unified::TrackPositionData b = rider(4, 50.002f, 60.0f, 90.03f, 0.4f);
+    motion.update(&a, 1, 0);
+    motion.update(&b, 1, FRAME_US);
+    CHECK_FALSE(motion.isMoving(FRAME_US));
+    CHECK(predicted(motion, 4, FRAME_US + FRAME_US / 2).posX == b.posX);
+
+    // Identical samples: a zero velocity is no velocity either.
+    motion.update(&b, 1, 2 * FRAME_US);
+    CHECK_FALSE(motion.isMoving(2 * FRAME_US));
+
+    // Walking pace, or turning on the spot, is motion.
+    const Unified::TrackPositionData walk = rider(4, 50.05f, 60.0f, 90.0f, 0.4f);   // 1.5 m/s
+    motion.update(&walk, 1, 3 * FRAME_US);
+    CHECK(motion.isMoving(3 * FRAME_US));
+    const Unified::TrackPositionData turn = rider(4, 50.05f, 60.0f, 91.0f, 0.4f);   // 30 deg/s
+    motion.update(&turn, 1, 4 * FRAME_US);
+    CHECK(motion.isMoving(4 * FRAME_US));
+}
+
+TEST_CASE("RiderMotion: a back-to-back burst keeps the velocity") {
+    RiderMotion motion;
+    const Unified::TrackPositionData a = rider(2, 0.0f, 0.0f, 0.0f, 0.2f);
+    const Unified::TrackPositionData b = rider(2, 1.0f, 0.0f, 0.0f, 0.2f);
+    const Unified::TrackPositionData c = rider(2, 2.0f, 0.0f, 0.0f, 0.2f);
+    motion.update(&a, 1, 0);
+    motion.update(&b, 1, FRAME_US);
+    // The next batch was queued behind it and handled 0.1 ms later.
+    motion.update(&c, 1, FRAME_US + 100);
+    const Unified::TrackPositionData p = predicted(motion, 2, FRAME_US + 100 + FRAME_US);
+    CHECK(p.posX == doctest::Approx(3.0f).epsilon(0.0001));
+}
+
+TEST_CASE("RiderMotion: the rider set follows the latest batch in any order") {
+    RiderMotion motion;
+    std::vector<Unified::TrackPositionData> first = { rider(1, 0.0f, 0.0f, 0.0f, 0.1f),
+                                                      rider(2, 50.0f, 0.0f, 0.0f, 0.2f),
+                                                      rider(3, 90.0f, 0.0f, 0.0f, 0.3f) };
+    // Rider 1 left the batch; 2 and 3 swapped slots and moved 1 m; 4 is new.
+    std::vector<Unified::TrackPositionData> second = { rider(3, 91.0f, 0.0f, 0.0f, 0.3f),
+                                                       rider(4, 10.0f, 0.0f, 0.0f, 0.4f),
+                                                       rider(2, 51.0f, 0.0f, 0.0f, 0.2f) };
+    motion.update(first.data(), 3, 0);
+    motion.update(second.data(), 3, FRAME_US);
+    CHECK(motion.riderCount() == 3);
+
+    std::vector<Unified::TrackPositionData> out;
+    motion.predict(FRAME_US * 2, out);
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].raceNum == 3);
+    CHECK(out[0].posX == doctest::Approx(92.0f));
+    CHECK(out[1].raceNum == 4);
+    CHECK(out[1].posX == 10.0f);   // first sample: held
+    CHECK(out[2].raceNum == 2);
+    CHECK(out[2].posX == doctest::Approx(52.0f));
+
+    Unified::TrackPositionData p;
+    CHECK_FALSE(motion.predictRider(1, FRAME_US * 2, p));
+
+    motion.update(nullptr, 0, FRAME_US * 2);
+    CHECK(motion.riderCount() == 0);
+    motion.predict(FRAME_US * 3, out);
+    CHECK(out.empty());
+}
@@ -2,7 +2,8 @@
 // tests/unit/test_session_charts_math.cpp
 // Unit tests for the pure race-progression chart derivations in
 // hud/session_charts_math.h — cumulative time, reference pace, trace value,
-// per-lap position, gap to leader, and the pace-chart outlier predicate.
+// per-lap position, gap to leader, the pace-chart outlier predicate, and the
+// incremental FieldSeries against the full recompute.
 //
 // The header is dependency-free (standard library only), so it compiles and
 // runs here with no game engine, no Windows, no PluginData. This TU does NOT
@@ -12,6 +13,8 @@
 
 #include "hud/session_charts_math.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -283,3 +286,142 @@ TEST_CASE("formatSecs: compact seconds labels, sign, and the minute carry") {
     CHECK(fmt(-59960, true)  == "-1:00.0");
     CHECK(fmt(-119960, true) == "-2:00.0");
 }
+
+// The HUD keeps the field incrementally (FieldSeries): laps arrive one at a time,
+// interleaved across riders, and each append re-ranks only its own lap column. At
+// every step the series must equal the full recompute over the same laps.
+namespace {
+
+struct FullField {
+    std::vector<std::vector<long long>> cumulative, rank, gaps;
+    std::vector<std::vector<int>> positions;
+    int leader = -1;
+};
+
+FullField recompute(const std::vector<std::vector<int>>& laps, const std::vector<std::vector<char>>& valid,
+                    const std::vector<int>& nums, bool isRace) {
+    FullField f;
+    for (size_t i = 0; i < laps.size(); ++i) {
+        f.cumulative.push_back(RC::cumulative(laps[i]));
+        f.rank.push_back(isRace ? f.cumulative.back() : RC::bestLapSoFar(laps[i], valid[i]));
+    }
+    f.positions = RC::positionsPerLap(f.rank, nums);
+    f.gaps = RC::gapToLeaderPerLap(f.rank);
+    f.leader = isRace ? RC::leaderIndex(f.cumulative, nums) : -1;
+    return f;
+}
+
+void checkIncrementalMatchesFull(bool isRace) {
+    // 12 riders (numbers not in slot order), ~30 laps each, arriving in a shuffled
+    // interleave. Lap times are drawn from a narrow set so cumulative and best-lap
+    // ties (broken by raceNum) actually occur; every 7th lap is invalid.
+    const std::vector<int> nums = { 44, 7, 12, 3, 91, 18, 5, 66, 21, 9, 30, 2 };
+    const size_t n = nums.size();
+    RC::FieldSeries series;
+    series.reset(isRace, 100);
+    for (int num : nums) series.addRider(num);
+
+    std::vector<std::vector<int>> laps(n);
+    std::vector<std::vector<char>> valid(n);
+    uint32_t seed = isRace ? 0x1234u : 0xbeefu;
+    auto next = [&](uint32_t mod) { seed = seed * 1664525u + 1013904223u; return (seed >> 8) % mod; };
+
+    for (int step = 0; step < 360; ++step) {
+        const size_t i = next(static_cast<uint32_t>(n));
+        const int lapMs = 60000 + static_cast<int>(next(4)) * 250;
+        const bool ok = (step % 7) != 3;
+        laps[i].push_back(lapMs);
+        valid[i].push_back(ok ? 1 : 0);
+        series.appendLap(static_cast<int>(i), lapMs, ok);
+
+        const FullField full = recompute(laps, valid, nums, isRace);
+        int maxLap = 0;
+        for (size_t r = 0; r < n; ++r) {
+            const RC::FieldSeries::Rider& s = series.rider(static_cast<int>(r));
+            REQUIRE(s.lapMs == laps[r]);
+            REQUIRE(s.cumulative == full.cumulative[r]);
+            REQUIRE(s.rank == full.rank[r]);
+            REQUIRE(s.positions == full.positions[r]);
+            REQUIRE(s.gaps == full.gaps[r]);
+            maxLap = std::max(maxLap, static_cast<int>(laps[r].size()));
+        }
+        REQUIRE(series.maxLap() == maxLap);
+        REQUIRE(series.leaderSlot() == full.leader);
+        if (isRace) {
+            const long long ref = RC::referencePaceMs(full.cumulative[full.leader].back(),
+                                                      static_cast<int>(full.cumulative[full.leader].size()));
+            REQUIRE(series.refPaceMs() == ref);
+        } else {
+            REQUIRE(series.refPaceMs() == 0);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("FieldSeries: incremental appends equal the full recompute (race)") {
+    checkIncrementalMatchesFull(true);
+}
+
+TEST_CASE("FieldSeries: incremental appends equal the full recompute (best-lap ranking)") {
+    checkIncrementalMatchesFull(false);
+}
+
+TEST_CASE("FieldSeries: slots, reset and empty field") {
+    RC::FieldSeries series;
+    series.reset(true, 8);
+    CHECK(series.maxLap() == 0);
+    CHECK(series.leaderSlot() == -1);
+    CHECK(series.refPaceMs() == 0);
+
+    const int a = series.addRider(10);
+    const int b = series.addRider(20);
+    CHECK(series.addRider(10) == a);   // existing slot
+    CHECK(series.slotOf(20) == b);
+    CHECK(series.slotOf(30) == -1);
+
+    series.appendLap(b, 61000, true);
+    series.appendLap(a, 60000, true);   // overtakes on lap 1: b re-numbered to P2
+    CHECK(series.rider(a).positions == std::vector<int>{1});
+    CHECK(series.rider(b).positions == std::vector<int>{2});
+    CHECK(series.rider(b).gaps == std::vector<long long>{1000});
+    CHECK(series.leaderSlot() == a);
+    CHECK(series.refPaceMs() == 60000);
+
+    series.reset(false, 8);
+    CHECK(series.riderCount() == 0);
+    CHECK(series.maxLap() == 0);
+    CHECK_FALSE(series.isRace());
+}
+
+TEST_CASE("decimateMinMax: first/min/max/last per pixel column, in order") {
+    std::vector<size_t> keep;
+    // One point per column (x in pixels, pxPerUnit 1): nothing to drop.
+    std::vector<float> xs = { 0.0f, 1.0f, 2.0f, 3.0f };
+    std::vector<float> ys = { 5.0f, 1.0f, 9.0f, 4.0f };
+    RC::decimateMinMax(xs.data(), ys.data(), xs.size(), 0.0f, 1.0f, keep);
+    CHECK(keep == std::vector<size_t>{ 0, 1, 2, 3 });
+
+    // Column 0 holds six points: first (0), max (2), min (4), last (5) survive,
+    // in index order; column 1's two points both stay.
+    xs = { 0.0f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 1.2f, 1.7f };
+    ys = { 3.0f, 4.0f, 8.0f, 2.5f, 0.5f, 2.0f, 6.0f, 7.0f };
+    RC::decimateMinMax(xs.data(), ys.data(), xs.size(), 0.0f, 1.0f, keep);
+    CHECK(keep == std::vector<size_t>{ 0, 2, 4, 5, 6, 7 });
+
+    // Scaling: normalized x with 100 px per unit, 1000 points over 0.5 units =
+    // 50 columns -> at most 200 points, always including both ends.
+    xs.clear(); ys.clear();
+    for (int i = 0; i < 1000; ++i) {
+        xs.push_back(0.2f + 0.5f * static_cast<float>(i) / 999.0f);
+        ys.push_back(static_cast<float>((i * 37) % 101));
+    }
+    RC::decimateMinMax(xs.data(), ys.data(), xs.size(), 0.2f, 100.0f, keep);
+    CHECK(keep.size() <= 51 * 4);
+    CHECK(keep.front() == 0);
+    CHECK(keep.back() == 999);
+    CHECK(std::is_sorted(keep.begin(), keep.end()));
+
+    RC::decimateMinMax(xs.data(), ys.data(), 0, 0.0f, 1.0f, keep);
+    CHECK(keep.empty());
+}
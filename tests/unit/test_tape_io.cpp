@@ -0,0 +1,321 @@
+// ============================================================================
+// tests/unit/test_tape_io.cpp
+// The MXBHREC tape container (core/tape_io.h) — what the recorder writes and
+// every replayer reads — pinned natively on tmpfile()s:
+//   1. v2 round trip: events written in handoff-sized runs with a checkpoint
+//      after each (as the recorder does) decode byte-for-byte, the index agrees
+//      with the blocks, and both the deflated and the stored (incompressible)
+//      block paths plus an event larger than BLOCK_BYTES are covered.
+//   2. A v2 tape cut short (no index, half a block) reads up to the last whole
+//      block; a v1 tape reads through the same Reader.
+//   3. seekBlock() resumes at any indexed block.
+//   4. The delta stage (BLOCK_DELTA) over the committed fixtures: re-packed as
+//      v2 with and without it, both decode to the original stream byte-for-byte,
+//      and the delta-coded tape is the smaller one.
+//   5. Blocks written past 4 GB (a sparse file) keep their 64-bit offsets
+//      through checkpoints, the index and seekBlock().
+// ============================================================================
+#include "doctest.h"
+
+#include "core/tape_io.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Event {
+    uint32_t type;
+    uint64_t timestampUs;
+    std::vector<uint8_t> payload;
+};
+
+// A session-like stream: mostly small, repetitive records (deflate-friendly),
+// a run of random-byte records (forces BLOCK_STORED), and one oversized event.
+std::vector<Event> makeEvents() {
+    std::mt19937 rng(1234);
+    std::vector<Event> ev;
+    uint64_t t = 0;
+    for (int i = 0; i < 6000; ++i) {
+        Event e;
+        e.type = 11 + static_cast<uint32_t>(i % 3) * 7;   // 11, 18, 25
+        e.timestampUs = (t += 1000 + rng() % 500);
+        e.payload.resize(40 + (i % 7) * 100);
+        for (size_t k = 0; k < e.payload.size(); ++k) e.payload[k] = static_cast<uint8_t>((k + i / 50) & 0x3F);
+        if (i >= 2000 && i < 3500) for (auto& b : e.payload) b = static_cast<uint8_t>(rng());
+        ev.push_back(std::move(e));
+    }
+    Event big;
+    big.type = 14;
+    big.timestampUs = (t += 1000);
+    big.payload.assign(tape_io::BLOCK_BYTES + 12345, 0x5A);
+    ev.insert(ev.begin() + 4000, std::move(big));
+    for (size_t i = 4001; i < ev.size(); ++i) ev[i].timestampUs += 1000;
+    return ev;
+}
+
+void frame(std::vector<uint8_t>& out, const Event& e) {
+    tape_io::EventFrame ef{ e.type, static_cast<uint32_t>(e.payload.size()), e.timestampUs };
+    const uint8_t* h = reinterpret_cast<const uint8_t*>(&ef);
+    out.insert(out.end(), h, h + sizeof(ef));
+    out.insert(out.end(), e.payload.begin(), e.payload.end());
+}
+
+void writeHeader(FILE* f, uint32_t version, uint32_t numEvents) {
+    uint8_t h[tape_io::FILE_HEADER_BYTES] = {};
+    std::memcpy(h, tape_io::FILE_MAGIC, sizeof(tape_io::FILE_MAGIC));
+    std::memcpy(h + tape_io::VERSION_OFFSET, &version, sizeof(version));
+    std::memcpy(h + tape_io::NUM_EVENTS_OFFSET, &numEvents, sizeof(numEvents));
+    std::fwrite(h, 1, sizeof(h), f);
+}
+
+// v2 tape of ev, handed over in runs of `run` events with a checkpoint after each.
+FILE* writeV2(const std::vector<Event>& ev, size_t run, tape_io::BlockWriter& w, bool finish = true) {
+    FILE* f = std::tmpfile();
+    REQUIRE(f);
+    writeHeader(f, tape_io::VERSION_BLOCKS, static_cast<uint32_t>(ev.size()));
+    w.begin(tape_io::FILE_HEADER_BYTES);
+    std::vector<uint8_t> chunk;
+    for (size_t i = 0; i < ev.size(); i += run) {
+        chunk.clear();
+        for (size_t k = i; k < i + run && k < ev.size(); ++k) frame(chunk, ev[k]);
+        REQUIRE(w.write(f, chunk.data(), chunk.size()));
+        REQUIRE(w.checkpoint(f));
+    }
+    if (finish) REQUIRE(w.finish(f));
+    std::rewind(f);
+    return f;
+}
+
+// Decode everything the reader yields and compare against ev[0..n).
+size_t readAndCompare(tape_io::Reader& r, const std::vector<Event>& ev, size_t first = 0) {
+    tape_io::EventFrame ef{};
+    const uint8_t* payload = nullptr;
+    size_t n = first, mismatches = 0;
+    while (r.next(ef, payload)) {
+        if (n >= ev.size()) { ++mismatches; break; }
+        const Event& e = ev[n++];
+        if (ef.eventType != e.type || ef.timestampUs != e.timestampUs ||
+            ef.dataSize != e.payload.size() ||
+            (ef.dataSize && std::memcmp(payload, e.payload.data(), ef.dataSize) != 0)) {
+            ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+    return n - first;
+}
+
+// A committed fixture (tests/integration/tests/fixtures/NAME, gzipped v1),
+// gunzipped. Empty if it can't be read.
+std::vector<uint8_t> loadFixture(const char* name) {
+    std::string path = __FILE__;
+    const size_t cut = path.find("/tests/unit/");
+    if (cut == std::string::npos) return {};
+    path = path.substr(0, cut) + "/tests/integration/tests/fixtures/" + name;
+    std::vector<uint8_t> gz;
+    if (FILE* f = std::fopen(path.c_str(), "rb")) {
+        uint8_t buf[65536];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) gz.insert(gz.end(), buf, buf + n);
+        std::fclose(f);
+    }
+    std::vector<uint8_t> out;
+    return tape_io::gunzip(gz.data(), gz.size(), out) ? out : std::vector<uint8_t>{};
+}
+
+// v1 tape bytes re-packed as v2 (handoffs of 40 events, checkpointed), read back
+// into a v1 image. Returns the v2 file size.
+size_t repackAndRead(const std::vector<uint8_t>& v1, bool delta, std::vector<uint8_t>& back) {
+    FILE* f = std::tmpfile();
+    REQUIRE(f);
+    writeHeader(f, tape_io::VERSION_BLOCKS, 0);
+    tape_io::BlockWriter w;
+    w.begin(tape_io::FILE_HEADER_BYTES);
+    w.setDelta(delta);
+    size_t pos = tape_io::FILE_HEADER_BYTES;
+    while (pos < v1.size()) {
+        size_t end = pos;
+        for (int k = 0; k < 40 && end < v1.size(); ++k) end += sizeof(tape_io::EventFrame) + tape_io::frameDataSize(&v1[end]);
+        REQUIRE(end <= v1.size());
+        REQUIRE(w.write(f, &v1[pos], end - pos));
+        REQUIRE(w.checkpoint(f));
+        pos = end;
+    }
+    REQUIRE(w.finish(f));
+    const size_t fileBytes = static_cast<size_t>(std::ftell(f));
+    std::rewind(f);
+
+    tape_io::Reader r;
+    REQUIRE(r.open(f));
+    back.assign(v1.begin(), v1.begin() + tape_io::FILE_HEADER_BYTES);
+    tape_io::EventFrame ef{};
+    const uint8_t* payload = nullptr;
+    while (r.next(ef, payload)) {
+        const uint8_t* h = reinterpret_cast<const uint8_t*>(&ef);
+        back.insert(back.end(), h, h + sizeof(ef));
+        back.insert(back.end(), payload, payload + ef.dataSize);
+    }
+    return fileBytes;
+}
+
+} // namespace
+
+TEST_CASE("tape_io: v2 round trip through checkpointed blocks") {
+    const std::vector<Event> ev = makeEvents();
+    tape_io::BlockWriter w;
+    FILE* f = writeV2(ev, 37, w);
+    CHECK(w.events() == ev.size());
+    CHECK(w.blocks() > 3);
+    std::vector<uint8_t> raw;
+    for (const Event& e : ev) frame(raw, e);
+    CHECK(w.rawBytes() == raw.size());
+    CHECK(w.fileBytes() * 2 < raw.size());   // the repetitive part really compressed
+
+    tape_io::Reader r;
+    REQUIRE(r.open(f));
+    CHECK(r.version() == tape_io::VERSION_BLOCKS);
+    CHECK(r.headerNumEvents() == ev.size());
+    CHECK(readAndCompare(r, ev) == ev.size());
+    CHECK(r.blocksRead() == w.blocks());
+
+    std::vector<tape_io::IndexEntry> index;
+    REQUIRE(r.readIndex(index));
+    REQUIRE(index.size() == w.blocks());
+    uint32_t next = 0;
+    for (const auto& e : index) {
+        CHECK(e.firstEvent == next);
+        CHECK(e.firstTimestampUs == ev[e.firstEvent].timestampUs);
+        next += e.eventCount;
+    }
+    CHECK(next == ev.size());
+}
+
+TEST_CASE("tape_io: crash-cut v2 tapes and v1 tapes read through the same Reader") {
+    const std::vector<Event> ev = makeEvents();
+    tape_io::BlockWriter w;
+
+    // Unfinished recording: no index, the open block as of the last checkpoint.
+    {
+        FILE* f = writeV2(ev, 50, w, /*finish=*/false);
+        tape_io::Reader r;
+        REQUIRE(r.open(f));
+        CHECK(readAndCompare(r, ev) == ev.size());
+        std::vector<tape_io::IndexEntry> index;
+        CHECK_FALSE(r.readIndex(index));
+    }
+
+    // Cut mid-block: everything before the torn block survives, nothing after.
+    {
+        FILE* full = writeV2(ev, 50, w);
+        tape_io::Reader r;
+        REQUIRE(r.open(full));
+        std::vector<tape_io::IndexEntry> index;
+        REQUIRE(r.readIndex(index));
+        REQUIRE(index.size() > 2);
+        const tape_io::IndexEntry cutBlock = index[index.size() / 2];
+        std::vector<uint8_t> bytes(static_cast<size_t>(cutBlock.fileOffset) + 100);
+        std::rewind(full);
+        REQUIRE(std::fread(bytes.data(), 1, bytes.size(), full) == bytes.size());
+
+        FILE* cut = std::tmpfile();
+        REQUIRE(cut);
+        std::fwrite(bytes.data(), 1, bytes.size(), cut);
+        std::rewind(cut);
+        tape_io::Reader rc;
+        REQUIRE(rc.open(cut));
+        CHECK(readAndCompare(rc, ev) == cutBlock.firstEvent);
+    }
+
+    // v1: the bare stream.
+    {
+        FILE* f = std::tmpfile();
+        REQUIRE(f);
+        writeHeader(f, tape_io::VERSION_RAW, static_cast<uint32_t>(ev.size()));
+        std::vector<uint8_t> raw;
+        for (const Event& e : ev) frame(raw, e);
+        std::fwrite(raw.data(), 1, raw.size(), f);
+        std::rewind(f);
+        tape_io::Reader r;
+        REQUIRE(r.open(f));
+        CHECK(r.version() == tape_io::VERSION_RAW);
+        CHECK(readAndCompare(r, ev) == ev.size());
+    }
+
+    // Unknown version / bad magic are refused.
+    {
+        FILE* f = std::tmpfile();
+        REQUIRE(f);
+        writeHeader(f, 3, 0);
+        std::rewind(f);
+        tape_io::Reader r;
+        CHECK_FALSE(r.open(f));
+    }
+}
+
+TEST_CASE("tape_io: seekBlock resumes at an indexed block") {
+    const std::vector<Event> ev = makeEvents();
+    tape_io::BlockWriter w;
+    FILE* f = writeV2(ev, 200, w);
+    tape_io::Reader r;
+    REQUIRE(r.open(f));
+    std::vector<tape_io::IndexEntry> index;
+    REQUIRE(r.readIndex(index));
+    for (size_t b : { size_t{ 0 }, index.size() / 2, index.size() - 1 }) {
+        REQUIRE(r.seekBlock(index[b]));
+        CHECK(readAndCompare(r, ev, index[b].firstEvent) == ev.size() - index[b].firstEvent);
+    }
+}
+
+TEST_CASE("tape_io: blocks and the index past 4 GB keep their offsets") {
+    // long is 32-bit on Win64: offsets must not go through fseek/ftell. The
+    // blocks start 5 GB in; everything before them is a hole, so the file stays
+    // small on disk.
+    const uint64_t kFar = 5ull << 30;
+    const std::vector<Event> ev = makeEvents();
+    FILE* f = std::tmpfile();
+    REQUIRE(f);
+    writeHeader(f, tape_io::VERSION_BLOCKS, static_cast<uint32_t>(ev.size()));
+    tape_io::BlockWriter w;
+    w.begin(kFar);
+    std::vector<uint8_t> chunk;
+    for (size_t i = 0; i < ev.size(); i += 100) {
+        chunk.clear();
+        for (size_t k = i; k < i + 100 && k < ev.size(); ++k) frame(chunk, ev[k]);
+        REQUIRE(w.write(f, chunk.data(), chunk.size()));
+        REQUIRE(w.checkpoint(f));
+    }
+    REQUIRE(w.finish(f));
+    CHECK(tape_io::tell64(f) == static_cast<int64_t>(w.fileBytes()));
+    CHECK(w.fileBytes() > kFar);
+    std::rewind(f);
+
+    tape_io::Reader r;
+    REQUIRE(r.open(f));
+    std::vector<tape_io::IndexEntry> index;
+    REQUIRE(r.readIndex(index));
+    REQUIRE(index.size() == w.blocks());
+    CHECK(index.front().fileOffset == kFar);
+    REQUIRE(r.seekBlock(index.front()));
+    CHECK(readAndCompare(r, ev) == ev.size());
+    REQUIRE(r.seekBlock(index.back()));
+    CHECK(readAndCompare(r, ev, index.back().firstEvent) == ev.size() - index.back().firstEvent);
+}
+
+TEST_CASE("tape_io: delta stage round-trips the committed fixtures") {
+    for (const char* name : { "race_farm14_24riders.tape.gz", "race2_mxbclub_1lap.tape.gz" }) {
+        const std::string fixture = name;
+        CAPTURE(fixture);
+        const std::vector<uint8_t> v1 = loadFixture(name);
+        REQUIRE(v1.size() > tape_io::FILE_HEADER_BYTES);
+
+        std::vector<uint8_t> plainBack, deltaBack;
+        const size_t plain = repackAndRead(v1, /*delta=*/false, plainBack);
+        const size_t delta = repackAndRead(v1, /*delta=*/true, deltaBack);
+        CHECK((plainBack == v1));   // not decomposed: no MB-sized failure message
+        CHECK((deltaBack == v1));
+        CHECK(delta < plain);
+        MESSAGE(fixture << ": v1 " << v1.size() << " B, blocks " << plain << " B, blocks + delta " << delta << " B");
+    }
+}
@@ -0,0 +1,323 @@
+// ============================================================================
+// tests/unit/test_tape_map.cpp
+// The random-access tape reader (core/tape_map.h) over the 24-rider Farm14
+// fixture, as committed (v1) and re-packed as v2 (indexed, and with the index cut
+// off as a crashed recording leaves it):
+//   1. Full iteration yields exactly what the sequential tape_io::Reader does.
+//   2. seekEvent(n) / seek(t) land on the same event in every form, the type
+//      filter yields exactly the events of that type, and both compose.
+//   3. open() maps a real file; missing files and non-tapes are refused.
+//   4. With StateKeyframe events spliced in, v2 blocks start at each keyframe and
+//      seekKeyframe(t) lands on the last keyframe at or before t in every form.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/tape_map.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Ev {
+    tape_io::EventFrame frame;
+    std::vector<uint8_t> payload;
+};
+
+std::string repoPath(const char* rel) {
+    std::string path = __FILE__;
+    const size_t cut = path.find("/tests/unit/");
+    return cut == std::string::npos ? std::string() : path.substr(0, cut) + "/" + rel;
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::vector<uint8_t> bytes;
+    if (FILE* f = std::fopen(path.c_str(), "rb")) {
+        uint8_t buf[65536];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+        std::fclose(f);
+    }
+    return bytes;
+}
+
+// The fixture as v1, v2 (with index) and v2 without its index, built once.
+struct Tapes {
+    std::vector<uint8_t> v1, v2, v2cut;
+};
+
+// v2 and v2cut of r.v1.
+void pack(Tapes& r) {
+    FILE* f = std::tmpfile();
+    REQUIRE(f);
+    std::vector<uint8_t> header(r.v1.begin(), r.v1.begin() + tape_io::FILE_HEADER_BYTES);
+    const uint32_t version = tape_io::VERSION_BLOCKS;
+    std::memcpy(header.data() + tape_io::VERSION_OFFSET, &version, sizeof(version));
+    std::fwrite(header.data(), 1, header.size(), f);
+    tape_io::BlockWriter w;
+    w.begin(tape_io::FILE_HEADER_BYTES);
+    REQUIRE(w.write(f, r.v1.data() + tape_io::FILE_HEADER_BYTES, r.v1.size() - tape_io::FILE_HEADER_BYTES));
+    REQUIRE(w.checkpoint(f));
+    const uint64_t blocksEnd = w.fileBytes();   // every block on disk, no index yet
+    REQUIRE(w.finish(f));
+    r.v2.resize(static_cast<size_t>(w.fileBytes()));
+    std::rewind(f);
+    REQUIRE(std::fread(r.v2.data(), 1, r.v2.size(), f) == r.v2.size());
+    std::fclose(f);
+    r.v2cut.assign(r.v2.begin(), r.v2.begin() + static_cast<std::ptrdiff_t>(blocksEnd));
+}
+
+std::vector<uint8_t> fixtureV1() {
+    std::vector<uint8_t> v1;
+    const std::vector<uint8_t> gz = readFile(repoPath("tests/integration/tests/fixtures/race_farm14_24riders.tape.gz"));
+    REQUIRE(tape_io::gunzip(gz.data(), gz.size(), v1));
+    REQUIRE(v1.size() > tape_io::FILE_HEADER_BYTES);
+    return v1;
+}
+
+const Tapes& tapes() {
+    static const Tapes t = [] {
+        Tapes r;
+        r.v1 = fixtureV1();
+        pack(r);
+        return r;
+    }();
+    return t;
+}
+
+// The fixture with a StateKeyframe (payload: its own ordinal, repeated) before the
+// first event at or after every minute; keyframeUs collects their timestamps.
+struct KeyframedTapes : Tapes {
+    std::vector<uint64_t> keyframeUs;
+};
+
+const KeyframedTapes& keyframed() {
+    static const KeyframedTapes t = [] {
+        KeyframedTapes r;
+        const std::vector<uint8_t> src = fixtureV1();
+        r.v1.assign(src.begin(), src.begin() + tape_io::FILE_HEADER_BYTES);
+        uint64_t nextUs = 60000000;
+        for (size_t off = tape_io::FILE_HEADER_BYTES; off + sizeof(tape_io::EventFrame) <= src.size();) {
+            tape_io::EventFrame ef;
+            std::memcpy(&ef, src.data() + off, sizeof(ef));
+            if (ef.timestampUs >= nextUs) {
+                const std::vector<uint8_t> payload(3000 + r.keyframeUs.size(), static_cast<uint8_t>(r.keyframeUs.size()));
+                const tape_io::EventFrame kf{ tape_io::KEYFRAME_EVENT, static_cast<uint32_t>(payload.size()), ef.timestampUs };
+                const uint8_t* h = reinterpret_cast<const uint8_t*>(&kf);
+                r.v1.insert(r.v1.end(), h, h + sizeof(kf));
+                r.v1.insert(r.v1.end(), payload.begin(), payload.end());
+                r.keyframeUs.push_back(ef.timestampUs);
+                while (nextUs <= ef.timestampUs) nextUs += 60000000;
+            }
+            const size_t bytes = sizeof(ef) + ef.dataSize;
+            r.v1.insert(r.v1.end(), src.begin() + static_cast<std::ptrdiff_t>(off),
+                        src.begin() + static_cast<std::ptrdiff_t>(off + bytes));
+            off += bytes;
+        }
+        pack(r);
+        return r;
+    }();
+    return t;
+}
+
+// Every event the sequential reader yields from a v1 image.
+const std::vector<Ev>& reference() {
+    static const std::vector<Ev> ev = [] {
+        std::vector<Ev> out;
+        FILE* f = std::tmpfile();
+        REQUIRE(f);
+        std::fwrite(tapes().v1.data(), 1, tapes().v1.size(), f);
+        std::rewind(f);
+        tape_io::Reader r;
+        REQUIRE(r.open(f));
+        tape_io::EventFrame frame{};
+        const uint8_t* payload = nullptr;
+        while (r.next(frame, payload)) out.push_back({ frame, std::vector<uint8_t>(payload, payload + frame.dataSize) });
+        return out;
+    }();
+    return ev;
+}
+
+bool same(const tape_io::EventFrame& frame, const uint8_t* payload, const Ev& e) {
+    return frame.eventType == e.frame.eventType && frame.dataSize == e.frame.dataSize &&
+           frame.timestampUs == e.frame.timestampUs &&
+           (frame.dataSize == 0 || std::memcmp(payload, e.payload.data(), frame.dataSize) == 0);
+}
+
+} // namespace
+
+TEST_CASE("tape_map: v1, v2 and index-less v2 iterate like the sequential Reader") {
+    const std::vector<Ev>& ref = reference();
+    REQUIRE(ref.size() > 10000);
+    const Tapes& t = tapes();
+    for (const std::vector<uint8_t>* bytes : { &t.v1, &t.v2, &t.v2cut }) {
+        tape_io::MappedTape m;
+        REQUIRE(m.openBuffer(bytes->data(), bytes->size()));
+        CHECK(m.eventCount() == ref.size());
+        if (bytes == &t.v2) CHECK(m.indexed());
+        if (bytes == &t.v2cut) { CHECK_FALSE(m.indexed()); CHECK(m.blockCount() > 50); }
+        tape_io::EventFrame frame{};
+        const uint8_t* payload = nullptr;
+        size_t n = 0, mismatches = 0;
+        while (m.next(frame, payload)) {
+            if (n >= ref.size() || !same(frame, payload, ref[n])) ++mismatches;
+            ++n;
+        }
+        CHECK(n == ref.size());
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("tape_map: seekEvent, seek by time and the type filter") {
+    const std::vector<Ev>& ref = reference();
+    const Tapes& t = tapes();
+    const uint64_t lastUs = ref.back().frame.timestampUs;
+    for (const std::vector<uint8_t>* bytes : { &t.v1, &t.v2, &t.v2cut }) {
+        tape_io::MappedTape m;
+        REQUIRE(m.openBuffer(bytes->data(), bytes->size()));
+        tape_io::EventFrame frame{};
+        const uint8_t* payload = nullptr;
+
+        for (size_t n : { size_t{ 0 }, size_t{ 1 }, ref.size() / 3, ref.size() / 2 + 7, ref.size() - 1 }) {
+            REQUIRE(m.seekEvent(n));
+            REQUIRE(m.next(frame, payload));
+            CHECK(same(frame, payload, ref[n]));
+        }
+        CHECK(m.seekEvent(ref.size()));
+        CHECK_FALSE(m.next(frame, payload));
+        CHECK_FALSE(m.seekEvent(ref.size() + 1));
+
+        // Times before, inside and past the recording; backwards after forwards.
+        for (uint64_t us : { uint64_t{ 0 }, lastUs / 2, lastUs / 4 + 1, lastUs, lastUs * 3 / 4, lastUs + 1 }) {
+            size_t expect = 0;
+            while (expect < ref.size() && ref[expect].frame.timestampUs < us) ++expect;
+            REQUIRE(m.seek(us));
+            CHECK(m.position() == expect);
+            if (expect < ref.size()) {
+                REQUIRE(m.next(frame, payload));
+                CHECK(same(frame, payload, ref[expect]));
+            } else {
+                CHECK_FALSE(m.next(frame, payload));
+            }
+        }
+
+        // Filter: RaceLap (21) only, from mid-race.
+        size_t from = ref.size() / 2, expectLaps = 0;
+        for (size_t k = from; k < ref.size(); ++k) expectLaps += ref[k].frame.eventType == 21;
+        m.setTypeFilter(tape_io::MappedTape::typeBit(21));
+        REQUIRE(m.seekEvent(from));
+        size_t laps = 0;
+        while (m.next(frame, payload)) {
+            CHECK(frame.eventType == 21u);
+            ++laps;
+        }
+        CHECK(laps == expectLaps);
+        CHECK(laps > 0);
+        m.setTypeFilter(tape_io::MappedTape::ALL_TYPES);
+    }
+}
+
+TEST_CASE("tape_map: open() maps a tape file") {
+    const std::string path = repoPath("tests/unit/build/tape_map_test.tape");
+    FILE* f = std::fopen(path.c_str(), "wb");
+    REQUIRE(f);
+    std::fwrite(tapes().v2.data(), 1, tapes().v2.size(), f);
+    std::fclose(f);
+
+    tape_io::MappedTape m;
+    REQUIRE(m.open(path.c_str()));
+    CHECK(m.version() == tape_io::VERSION_BLOCKS);
+    CHECK(m.indexed());
+    CHECK(m.eventCount() == reference().size());
+    REQUIRE(m.seekEvent(reference().size() - 1));
+    tape_io::EventFrame frame{};
+    const uint8_t* payload = nullptr;
+    REQUIRE(m.next(frame, payload));
+    CHECK(same(frame, payload, reference().back()));
+    m.close();
+    std::remove(path.c_str());
+
+    CHECK_FALSE(m.open(repoPath("tests/unit/build/no_such.tape").c_str()));
+    const std::string notTape = repoPath("tests/unit/run_tests.sh");
+    CHECK_FALSE(m.open(notTape.c_str()));
+    CHECK_FALSE(m.isOpen());
+}
+
+TEST_CASE("tape_map: seekKeyframe finds the last keyframe at or before a time") {
+    const KeyframedTapes& t = keyframed();
+    REQUIRE(t.keyframeUs.size() > 10);
+
+    // Every keyframe opens a v2 block, flagged; no other block is.
+    {
+        tape_io::MappedTape m;
+        REQUIRE(m.openBuffer(t.v2.data(), t.v2.size()));
+        CHECK(m.eventCount() == reference().size() + t.keyframeUs.size());
+        CHECK(m.blockCount() > t.keyframeUs.size());
+        FILE* f = std::tmpfile();
+        REQUIRE(f);
+        std::fwrite(t.v2.data(), 1, t.v2.size(), f);
+        std::rewind(f);
+        tape_io::Reader r;
+        REQUIRE(r.open(f));
+        std::vector<tape_io::IndexEntry> index;
+        REQUIRE(r.readIndex(index));
+        size_t flagged = 0;
+        for (const auto& e : index) {
+            tape_io::BlockHeader bh;
+            std::memcpy(&bh, t.v2.data() + e.fileOffset, sizeof(bh));
+            if (!(bh.flags & tape_io::BLOCK_KEYFRAME)) continue;
+            ++flagged;
+            tape_io::EventFrame frame{};
+            const uint8_t* payload = nullptr;
+            REQUIRE(m.seekEvent(e.firstEvent));
+            REQUIRE(m.next(frame, payload));
+            CHECK(frame.eventType == tape_io::KEYFRAME_EVENT);
+        }
+        CHECK(flagged == t.keyframeUs.size());
+    }
+
+    // Splitting blocks at keyframes changes nothing a reader sees.
+    {
+        tape_io::MappedTape a, b;
+        REQUIRE(a.openBuffer(t.v1.data(), t.v1.size()));
+        REQUIRE(b.openBuffer(t.v2.data(), t.v2.size()));
+        tape_io::EventFrame fa{}, fb{};
+        const uint8_t* pa = nullptr;
+        const uint8_t* pb = nullptr;
+        size_t n = 0, mismatches = 0;
+        while (a.next(fa, pa)) {
+            if (!b.next(fb, pb) || !same(fb, pb, Ev{ fa, std::vector<uint8_t>(pa, pa + fa.dataSize) })) ++mismatches;
+            ++n;
+        }
+        CHECK(n == reference().size() + t.keyframeUs.size());
+        CHECK_FALSE(b.next(fb, pb));
+        CHECK(mismatches == 0);
+    }
+
+    for (const std::vector<uint8_t>* bytes : { &t.v1, &t.v2, &t.v2cut }) {
+        tape_io::MappedTape m;
+        REQUIRE(m.openBuffer(bytes->data(), bytes->size()));
+        tape_io::EventFrame frame{};
+        const uint8_t* payload = nullptr;
+
+        CHECK_FALSE(m.seekKeyframe(t.keyframeUs.front() - 1));
+        for (size_t i = 0; i < t.keyframeUs.size(); i += 3) {
+            for (uint64_t us : { t.keyframeUs[i], t.keyframeUs[i] + 30000000 }) {
+                const size_t k = static_cast<size_t>(std::upper_bound(t.keyframeUs.begin(), t.keyframeUs.end(), us) -
+                                                     t.keyframeUs.begin()) - 1;
+                CAPTURE(k);
+                REQUIRE(m.seekKeyframe(us));
+                REQUIRE(m.next(frame, payload));
+                CHECK(frame.eventType == tape_io::KEYFRAME_EVENT);
+                CHECK(frame.timestampUs == t.keyframeUs[k]);
+                CHECK(frame.dataSize == 3000 + k);
+                CHECK(payload[0] == static_cast<uint8_t>(k));
+            }
+        }
+        REQUIRE(m.seekKeyframe(UINT64_MAX));
+        REQUIRE(m.next(frame, payload));
+        CHECK(frame.timestampUs == t.keyframeUs.back());
+    }
+}
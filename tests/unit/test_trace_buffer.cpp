@@ -0,0 +1,125 @@
+// ============================================================================
+// tests/unit/test_trace_buffer.cpp
+// Pure-logic tests for the timeline tracer's per-thread ring and its Chrome trace
+// serializer (diagnostics/trace_buffer.h):
+//   1. The ring keeps the newest events once it wraps, minus the READ_SLACK slots
+//      the owner may be overwriting while a reader snapshots it.
+//   2. formatChromeTrace emits a thread_name record per named buffer and one "X"
+//      event per retained event at/after the capture start, in microseconds
+//      relative to it, with names JSON-escaped.
+//   3. copyEvents() keeps a ring's thread id, name and the events at/after the
+//      capture start, and the copy doesn't change when the ring records on.
+// ============================================================================
+#include "doctest.h"
+
+#include "diagnostics/trace_buffer.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+size_t countOf(const std::string& hay, const std::string& needle) {
+    size_t n = 0;
+    for (size_t pos = hay.find(needle); pos != std::string::npos; pos = hay.find(needle, pos + 1)) ++n;
+    return n;
+}
+
+// What Tracer::stop() hands its writer thread: a copy of each ring.
+std::string formatRings(const std::vector<const Trace::TraceBuffer*>& buffers, int64_t fromTicks,
+                        int64_t ticksPerSecond, uint32_t pid) {
+    std::vector<Trace::ThreadEvents> threads(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) buffers[i]->copyEvents(fromTicks, threads[i]);
+    return Trace::formatChromeTrace(threads, fromTicks, ticksPerSecond, pid);
+}
+
+} // namespace
+
+TEST_CASE("TraceBuffer: events come back oldest-first before the ring wraps") {
+    Trace::TraceBuffer buf(7, 64);
+    for (int i = 0; i < 10; ++i) buf.push("e", i * 10, i * 10 + 3);
+
+    std::vector<int64_t> starts;
+    buf.forEach([&](const Trace::Event& e) {
+        starts.push_back(e.start);
+        CHECK(e.duration == 3);
+    });
+    REQUIRE(starts.size() == 10);
+    for (int i = 0; i < 10; ++i) CHECK(starts[i] == i * 10);
+    CHECK(buf.totalPushed() == 10);
+    CHECK(buf.threadId() == 7);
+}
+
+TEST_CASE("TraceBuffer: a wrapped ring keeps the newest events minus the read slack") {
+    const uint32_t cap = 64;
+    Trace::TraceBuffer buf(1, cap);
+    const int pushed = 1000;
+    for (int i = 0; i < pushed; ++i) buf.push("e", i, i + 1);
+
+    std::vector<int64_t> starts;
+    buf.forEach([&](const Trace::Event& e) { starts.push_back(e.start); });
+    REQUIRE(starts.size() == cap - Trace::TraceBuffer::READ_SLACK);
+    CHECK(starts.back() == pushed - 1);
+    for (size_t i = 1; i < starts.size(); ++i) CHECK(starts[i] == starts[i - 1] + 1);
+}
+
+TEST_CASE("formatChromeTrace: thread names, relative microseconds and the capture-start cutoff") {
+    Trace::TraceBuffer game(100, 16);
+    game.setThreadName("game");
+    Trace::TraceBuffer worker(200, 16);   // unnamed: no thread_name record
+
+    // 1 tick = 1 ns (ticksPerSecond = 1e9); capture starts at tick 5000.
+    game.push("before", 1000, 2000);      // starts before the capture: dropped
+    game.push("Draw", 6000, 8500);        // ts 1 us, dur 2.5 us
+    worker.push("RunTelemetry", 5000, 5250);
+
+    const std::string json = formatRings({ &game, &worker }, 5000, 1000000000, 42);
+
+    CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CHECK(json.find("\n]}") != std::string::npos);
+    CHECK(countOf(json, "\"ph\":\"M\"") == 1);
+    CHECK(json.find("\"tid\":100,\"args\":{\"name\":\"game\"}") != std::string::npos);
+    CHECK(countOf(json, "\"ph\":\"X\"") == 2);
+    CHECK(json.find("before") == std::string::npos);
+    CHECK(json.find("\"pid\":42,\"tid\":100,\"ts\":1.000,\"dur\":2.500,\"name\":\"Draw\"") != std::string::npos);
+    CHECK(json.find("\"pid\":42,\"tid\":200,\"ts\":0.000,\"dur\":0.250,\"name\":\"RunTelemetry\"") != std::string::npos);
+    // Records are comma-separated, with no trailing comma before the closing bracket.
+    CHECK(countOf(json, "},\n{") == 2);
+    CHECK(json.find(",\n]") == std::string::npos);
+}
+
+TEST_CASE("formatChromeTrace: names are JSON-escaped and an empty capture is valid") {
+    Trace::TraceBuffer buf(1, 16);
+    buf.push("Rebuild \"quoted\"\\path\n", 10, 20);
+    const std::string json = formatRings({ &buf }, 0, 1000000, 1);
+    CHECK(json.find("\"name\":\"Rebuild \\\"quoted\\\"\\\\path\\u000a\"") != std::string::npos);
+
+    Trace::TraceBuffer empty(2, 16);
+    CHECK(formatRings({ &empty }, 0, 1000000, 1) ==
+          "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+}
+
+TEST_CASE("TraceBuffer: copyEvents snapshots the capture for the writer thread") {
+    Trace::TraceBuffer buf(9, 16);
+    buf.setThreadName("game");
+    buf.push("before", 100, 150);
+    buf.push("a", 1000, 1100);
+    buf.push("b", 2000, 2300);
+
+    Trace::ThreadEvents copy;
+    copy.events.push_back({ "stale", 0, 0 });   // reused storage is cleared
+    buf.copyEvents(1000, copy);
+    CHECK(copy.threadId == 9);
+    CHECK(copy.threadName == "game");
+    REQUIRE(copy.events.size() == 2);
+    CHECK(std::string(copy.events[0].name) == "a");
+    CHECK(copy.events[1].duration == 300);
+
+    const std::string before = Trace::formatChromeTrace({ copy }, 1000, 1000000, 1);
+
+    // The ring records on (the next capture); the copy is unaffected.
+    buf.push("later", 3000, 3100);
+    CHECK(copy.events.size() == 2);
+    CHECK(Trace::formatChromeTrace({ copy }, 1000, 1000000, 1) == before);
+    CHECK(formatRings({ &buf }, 1000, 1000000, 1).find("later") != std::string::npos);
+}
@@ -0,0 +1,178 @@
+// ============================================================================
+// tests/unit/test_track_model.cpp
+// The shared track model (core/track_model.h) on synthetic tracks: the O(1)
+// uniform-table lookups agree with the exact arc walk (positionAt) to within
+// a centimeter on a straight, a circle and a stadium loop (heading to a tenth
+// of a degree, or one table step's turn at a straight/curve junction);
+// trackPos <-> meters honours the S/F offset and wraps; the nearest-point grid
+// recovers the trackPos of points beside the centerline; and the along-track
+// separation goes the short way round the lap.
+// ============================================================================
+#include "doctest.h"
+
+#include "core/track_model.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+
+Unified::TrackSegment segment(float length, float radius) {
+    Unified::TrackSegment s;
+    s.type = (radius == 0.0f) ? 0 : 1;
+    s.length = length;
+    s.radius = radius;
+    return s;
+}
+
+// Closed stadium: 200 m north, a 50 m right-hand half circle, 200 m south and
+// the other half circle back to the origin.
+std::vector<Unified::TrackSegment> stadium() {
+    return { segment(200.0f, 0.0f), segment(PI * 50.0f, 50.0f),
+             segment(200.0f, 0.0f), segment(PI * 50.0f, 50.0f) };
+}
+
+struct Built {
+    std::vector<Unified::TrackSegment> segments;
+    std::vector<TrackModel::ArcPoint> arc;
+    TrackModel model;
+};
+
+Built build(std::vector<Unified::TrackSegment> segments, float sfMeters) {
+    Built b;
+    b.segments = std::move(segments);
+    TrackModel::buildArcTable(b.segments, b.arc);
+    b.model.build(b.segments, b.arc, sfMeters);
+    return b;
+}
+
+float headingError(float a, float b) {
+    float d = std::fmod(std::abs(a - b), 360.0f);
+    return (d > 180.0f) ? 360.0f - d : d;
+}
+
+// worldAt / headingAt against the exact walk at `samples` points round the lap.
+// Heading is lerped, so inside the one table piece that straddles a straight
+// -> curve junction it can be off by up to that piece's turn (spacing / radius).
+void checkAgainstExact(const Built& b, int samples, float headingTolerance = 0.1f) {
+    for (int i = 0; i < samples; ++i) {
+        const float pos = static_cast<float>(i) / samples;
+        float ex, ey, eh;
+        REQUIRE(TrackModel::positionAt(b.arc, b.segments, b.model.distanceAt(pos), ex, ey, eh));
+        float x, y, h;
+        b.model.poseAt(pos, x, y, h);
+        CHECK(std::hypot(x - ex, y - ey) < 0.01f);
+        CHECK(headingError(h, eh) < headingTolerance);
+        CHECK(h >= 0.0f);
+        CHECK(h < 360.0f);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("TrackModel: a straight maps trackPos linearly") {
+    const Built b = build({ segment(500.0f, 0.0f) }, 0.0f);
+    REQUIRE(b.model.valid());
+    CHECK(b.model.length() == doctest::Approx(500.0f));
+    CHECK(b.model.tableSize() == 501);   // 1 m spacing, plus the closing sample
+
+    float x, y;
+    b.model.worldAt(0.25f, x, y);
+    CHECK(x == doctest::Approx(0.0f).epsilon(0.001));
+    CHECK(y == doctest::Approx(125.0f).epsilon(0.0001));
+    CHECK(b.model.headingAt(0.25f) == doctest::Approx(0.0f));
+    checkAgainstExact(b, 997);
+}
+
+TEST_CASE("TrackModel: a circle agrees with the exact arc walk") {
+    const float quarter = PI * 100.0f * 0.5f;
+    const Built b = build({ segment(quarter, 100.0f), segment(quarter, 100.0f),
+                            segment(quarter, 100.0f), segment(quarter, 100.0f) }, 0.0f);
+    REQUIRE(b.model.valid());
+    CHECK(b.model.length() == doctest::Approx(2.0f * PI * 100.0f));
+
+    // A quarter of the way round a right-hand circle from heading north.
+    float x, y;
+    b.model.worldAt(0.25f, x, y);
+    CHECK(x == doctest::Approx(100.0f).epsilon(0.0001));
+    CHECK(y == doctest::Approx(100.0f).epsilon(0.0001));
+    CHECK(b.model.headingAt(0.25f) == doctest::Approx(90.0f).epsilon(0.001));
+    checkAgainstExact(b, 1009);
+}
+
+TEST_CASE("TrackModel: the S/F offset shifts trackPos and both directions wrap") {
+    const Built b = build(stadium(), 123.0f);
+    REQUIRE(b.model.valid());
+    const float length = b.model.length();
+    CHECK(b.model.sfMeters() == doctest::Approx(123.0f));
+
+    CHECK(b.model.distanceAt(0.0f) == doctest::Approx(123.0f));
+    CHECK(b.model.distanceAt(1.0f) == doctest::Approx(123.0f));
+    CHECK(b.model.distanceAt(-0.1f) == doctest::Approx(123.0f - 0.1f * length));
+    CHECK(b.model.trackPosAt(123.0f) == doctest::Approx(0.0f));
+    CHECK(b.model.trackPosAt(100.0f) == doctest::Approx(1.0f - 23.0f / length));
+    for (int i = 0; i < 100; ++i) {
+        const float pos = i / 100.0f;
+        CHECK(b.model.trackPosAt(b.model.distanceAt(pos)) == doctest::Approx(pos).epsilon(0.0001));
+    }
+    checkAgainstExact(b, 1013, 180.0f / (PI * 50.0f));   // 1 m of a 50 m radius
+
+    // An S/F offset past the end (or unknown) still lands on the lap.
+    CHECK(build(stadium(), length + 10.0f).model.sfMeters() == doctest::Approx(10.0f).epsilon(0.001));
+    CHECK(build(stadium(), -1.0f).model.sfMeters() == 0.0f);
+}
+
+TEST_CASE("TrackModel: nearestTrackPos recovers points beside the centerline") {
+    const Built b = build(stadium(), 40.0f);
+    REQUIRE(b.model.valid());
+
+    for (int i = 0; i < 500; ++i) {
+        const float pos = (i + 0.37f) / 500.0f;
+        float x, y;
+        b.model.worldAt(pos, x, y);
+        const float h = b.model.headingAt(pos) * PI / 180.0f;
+        const float side = (i % 2) ? 3.0f : -3.0f;   // right / left of the direction of travel
+        float distance = -1.0f;
+        const float found = b.model.nearestTrackPos(x + std::cos(h) * side, y - std::sin(h) * side, &distance);
+        CHECK(b.model.separationMeters(found, pos) < 0.05f);
+        CHECK(distance == doctest::Approx(3.0f).epsilon(0.01));
+    }
+
+    // Far outside the grid: still the closest point (the end of the west straight).
+    float distance = 0.0f;
+    const float found = b.model.nearestTrackPos(-1000.0f, 100.0f, &distance);
+    CHECK(distance == doctest::Approx(1000.0f).epsilon(0.001));
+    float x, y;
+    b.model.worldAt(found, x, y);
+    CHECK(x == doctest::Approx(0.0f).epsilon(0.001));
+}
+
+TEST_CASE("TrackModel: separation goes the short way round the lap") {
+    const Built b = build(stadium(), 0.0f);
+    const float length = b.model.length();
+    CHECK(b.model.separationMeters(0.1f, 0.3f) == doctest::Approx(0.2f * length));
+    CHECK(b.model.separationMeters(0.05f, 0.95f) == doctest::Approx(0.1f * length));
+    CHECK(b.model.separationMeters(0.95f, 0.05f) == doctest::Approx(0.1f * length));
+    CHECK(b.model.separationMeters(0.4f, 0.4f) == 0.0f);
+}
+
+TEST_CASE("TrackModel: degenerate input leaves the model invalid") {
+    TrackModel empty;
+    CHECK_FALSE(empty.valid());
+    CHECK(empty.nearestTrackPos(0.0f, 0.0f) == -1.0f);
+
+    const Built none = build({}, 0.0f);
+    CHECK_FALSE(none.model.valid());
+    CHECK(none.arc.empty());
+
+    const Built zero = build({ segment(0.0f, 0.0f) }, 0.0f);
+    CHECK_FALSE(zero.model.valid());
+
+    // A short track still gets the minimum table.
+    const Built shortTrack = build({ segment(10.0f, 0.0f) }, 0.0f);
+    REQUIRE(shortTrack.model.valid());
+    CHECK(shortTrack.model.tableSize() == TrackModel::MIN_TABLE_SAMPLES + 1);
+    checkAgainstExact(shortTrack, 101);
+}
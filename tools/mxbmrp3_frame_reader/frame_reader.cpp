@@ -0,0 +1,85 @@
+// ============================================================================
+// tools/mxbmrp3_frame_reader/frame_reader.cpp
+// Minimal external consumer of the plugin's shared-memory frame export — the
+// reference for an OBS source or a timing-wall app. Opens the named mapping,
+// validates the header, and polls readLatest() (core/frame_export_abi.h), which
+// never blocks the plugin. Prints per-second frame/drop/lap counts; optionally
+// writes the newest RGBA frame as a binary PPM.
+//
+//   x86_64-w64-mingw32-g++ -std=c++17 -O2 -I ../../mxbmrp3 frame_reader.cpp -o frame_reader.exe
+//   frame_reader.exe [seconds=10] [snapshot.ppm]
+// ============================================================================
+#include "core/frame_export_abi.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const int seconds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10;
+    const char* snapshot = argc > 2 ? argv[2] : nullptr;
+
+    HANDLE h = OpenFileMappingA(FILE_MAP_READ, FALSE, frame_export::MAPPING_NAME);
+    if (!h) {
+        fprintf(stderr, "no frame export (%s): enable [Advanced] frameExport=1|2 and start the game\n",
+                frame_export::MAPPING_NAME);
+        return 1;
+    }
+    const void* view = MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION mbi{};
+    if (!view || !VirtualQuery(view, &mbi, sizeof(mbi))) { fprintf(stderr, "MapViewOfFile failed\n"); return 1; }
+    const auto* hdr = static_cast<const frame_export::ShmHeader*>(view);
+    if (!frame_export::headerValid(hdr, mbi.RegionSize)) { fprintf(stderr, "bad header / version\n"); return 1; }
+
+    printf("%s: %s, %u slots x %u bytes, writer pid %u",
+           frame_export::MAPPING_NAME, hdr->format == frame_export::FORMAT_RGBA ? "RGBA" : "primitives",
+           hdr->slotCount, hdr->slotBytes, hdr->writerPid);
+    if (hdr->format == frame_export::FORMAT_RGBA) printf(", %ux%u", hdr->width, hdr->height);
+    printf("\n");
+
+    std::vector<uint8_t> buf(hdr->slotBytes - sizeof(frame_export::SlotHeader));
+    frame_export::SlotHeader meta;
+    uint64_t last = 0, got = 0, skipped = 0, lapped = 0;
+    auto tick = std::chrono::steady_clock::now();
+    const auto end = tick + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        switch (frame_export::readLatest(hdr, last, meta, buf.data(), buf.size())) {
+        case frame_export::ReadResult::Ok:
+            if (last && meta.frame > last + 1) skipped += meta.frame - last - 1;
+            last = meta.frame;
+            ++got;
+            break;
+        case frame_export::ReadResult::Lapped: ++lapped; break;
+        case frame_export::ReadResult::NoNewFrame:
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            break;
+        }
+        if (std::chrono::steady_clock::now() - tick >= std::chrono::seconds(1)) {
+            printf("frame %llu  %llu fps  skipped %llu  lapped %llu  (%u quads, %u strings%s)\n",
+                   static_cast<unsigned long long>(last), static_cast<unsigned long long>(got),
+                   static_cast<unsigned long long>(skipped), static_cast<unsigned long long>(lapped),
+                   meta.quadCount, meta.stringCount,
+                   (meta.flags & frame_export::SLOT_TRUNCATED) ? ", truncated" : "");
+            got = skipped = lapped = 0;
+            tick = std::chrono::steady_clock::now();
+        }
+    }
+
+    if (snapshot && last && hdr->format == frame_export::FORMAT_RGBA) {
+        FILE* f = std::fopen(snapshot, "wb");
+        if (f) {
+            fprintf(f, "P6\n%u %u\n255\n", hdr->width, hdr->height);
+            for (size_t i = 0; i + 3 < meta.payloadBytes; i += 4) std::fwrite(&buf[i], 1, 3, f);
+            std::fclose(f);
+            printf("wrote frame %llu -> %s\n", static_cast<unsigned long long>(last), snapshot);
+        }
+    }
+    UnmapViewOfFile(view);
+    CloseHandle(h);
+    return 0;
+}
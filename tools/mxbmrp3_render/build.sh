@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+# ============================================================================
+# tools/mxbmrp3_render/build.sh — build the native headless HUD renderer.
+# Compiles the vendored miniz (C) and links it with mxbmrp3_render.cpp and the
+# plugin's portable software rasterizer (core/hud_sw_renderer.cpp), C++17.
+# Output: tools/mxbmrp3_render/mxbmrp3_render
+# ============================================================================
+set -euo pipefail
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${HERE}/../.." && pwd)"
+MINIZ="${ROOT}/mxbmrp3/vendor/miniz"
+OUT="${HERE}/mxbmrp3_render"
+CXX="${CXX:-g++}"
+CC="${CC:-gcc}"
+TMP="$(mktemp -d)"; trap 'rm -rf "${TMP}"' EXIT
+
+# miniz amalgamation must be compiled as C (it is not valid C++). tdef = PNG
+# encode, tinfl = the renderer's .fnt atlas decode.
+"${CC}" -O2 -c "${MINIZ}/miniz.c"       -o "${TMP}/miniz.o"
+"${CC}" -O2 -c "${MINIZ}/miniz_tdef.c"  -o "${TMP}/miniz_tdef.o"
+"${CC}" -O2 -c "${MINIZ}/miniz_tinfl.c" -o "${TMP}/miniz_tinfl.o"
+
+# -DGAME_MXBIKES / -D__declspec(x)=: same as tests/unit/run_tests.sh — pick the
+# MXB game_config.h and let the PiBoSo header parse outside MSVC/mingw.
+"${CXX}" -std=c++17 -O2 -Wall -Wno-unused-function -Wno-class-memaccess \
+    -DGAME_MXBIKES "-D__declspec(x)=" -I "${ROOT}/mxbmrp3" \
+    "${HERE}/mxbmrp3_render.cpp" "${ROOT}/mxbmrp3/core/hud_sw_renderer.cpp" \
+    "${TMP}/miniz.o" "${TMP}/miniz_tdef.o" "${TMP}/miniz_tinfl.o" \
+    -lm -o "${OUT}"
+echo "built ${OUT}"
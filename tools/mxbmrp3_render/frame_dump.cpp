@@ -0,0 +1,77 @@
+// ============================================================================
+// tools/mxbmrp3_render/frame_dump.cpp
+// Tape -> MXBHFRM frame stream. Loads the cross-compiled plugin DLL, runs the
+// game's lifecycle (Startup -> DrawInit), replays a recorded MXBHREC tape through
+// the real exports at its recorded cadence, and captures the quads/strings every
+// Draw() hands the game. The native mxbmrp3_render CLI rasterizes the result.
+// Run under Wine (the plugin is a Windows DLL); render_tape.sh drives both halves:
+//
+//   x86_64-w64-mingw32-g++ -std=c++17 -I ../../tests/integration/harness \
+//       frame_dump.cpp -o frame_dump.exe -lws2_32
+//   wine frame_dump.exe mxbmrp3_test.dlo race.tape race.frames [tickMs] [every]
+//
+// tickMs (default 33, ~30 fps) is the sim-time Draw cadence interleaved between
+// recorded events; every (default 1) keeps each N-th frame. Recorded Draw events
+// in the tape are captured too.
+// ============================================================================
+#include "plugin_host.h"
+#include "frame_stream.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// DrawInit's out-params: counts + one buffer of NUL-separated names.
+typedef int (*PFN_DrawInit)(int*, char**, int*, char**);
+
+static std::vector<std::string> splitNames(const char* p, int n) {
+    std::vector<std::string> v;
+    for (int i = 0; p && i < n; ++i) { v.emplace_back(p); p += v.back().size() + 1; }
+    return v;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: frame_dump.exe <plugin.dlo> <in.tape> <out.frames> [tickMs=33] [every=1]\n");
+        return 2;
+    }
+    const long long tickMs = argc > 4 ? std::atoll(argv[4]) : 33;
+    const int every = argc > 5 ? std::max(1, std::atoi(argv[5])) : 1;
+
+    PluginHost host(argv[1]);
+    if (!host.loaded()) { fprintf(stderr, "failed to load %s\n", argv[1]); return 1; }
+    host.startup("Z:\\tmp\\mxbmrp3-tests\\render\\");
+
+    // The sprite/font tables the game would register. Textures precede icons
+    // (AssetManager discovery order), so the first icon path marks firstIcon.
+    auto drawInit = host.sym<PFN_DrawInit>("DrawInit");
+    int nSprites = 0, nFonts = 0; char* sprites = nullptr; char* fonts = nullptr;
+    if (!drawInit || !drawInit(&nSprites, &sprites, &nFonts, &fonts)) {
+        fprintf(stderr, "DrawInit failed (are the plugin assets staged under plugins/mxbmrp3_data?)\n");
+        return 1;
+    }
+    const std::vector<std::string> spriteNames = splitNames(sprites, nSprites);
+    const std::vector<std::string> fontNames = splitNames(fonts, nFonts);
+    int firstIcon = 1 << 30;
+    for (size_t i = 0; i < spriteNames.size(); ++i) {
+        if (spriteNames[i].find("\\icons\\") != std::string::npos) { firstIcon = static_cast<int>(i) + 1; break; }
+    }
+
+    frames::Writer out;
+    if (!out.open(argv[3], fontNames, spriteNames, firstIcon)) { fprintf(stderr, "cannot write %s\n", argv[3]); return 1; }
+
+    long long seen = 0;
+    host.setDrawObserver([&](long long simMs, int nq, const void* q, int ns, const void* s) {
+        if (seen++ % every != 0) return;
+        out.frame(simMs * 1000, static_cast<const frames::WireQuad*>(q), nq,
+                  static_cast<const frames::WireString*>(s), ns);
+    });
+    const int applied = host.replayTapeTimed(argv[2], tickMs);
+    host.setDrawObserver({});
+    if (applied < 0) { fprintf(stderr, "cannot replay %s\n", argv[2]); return 1; }
+
+    printf("frame_dump: %d events, %lld draws, %u frames -> %s (%d sprites, %d fonts, firstIcon %d)\n",
+           applied, seen, out.frames(), argv[3], nSprites, nFonts, firstIcon);
+    out.close();
+    host.shutdown();
+    return 0;
+}
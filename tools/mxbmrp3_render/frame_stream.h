@@ -0,0 +1,191 @@
+// ============================================================================
+// tools/mxbmrp3_render/frame_stream.h
+// MXBHFRM — a recorded stream of the plugin's Draw() output, the hand-off between
+// frame_dump.exe (loads the DLL under Wine, replays a tape, captures every Draw)
+// and the native mxbmrp3_render CLI (rasterizes the frames with hudsw::Renderer).
+//
+// Layout (little-endian, no padding between records):
+//   FileHeader
+//   fontCount   x NUL-terminated font paths          (DrawInit order, 1-based)
+//   spriteCount x NUL-terminated sprite paths        (DrawInit order, 1-based)
+//   { FrameHeader, quadCount x WireQuad, stringCount x WireString } ...
+//
+// The wire structs are the PiBoSo SPluginQuad_t / SPluginString_t with the color
+// pinned to 32 bits: `unsigned long` is 32-bit on Win64 (LLP64) but 64-bit on
+// Linux (LP64), so the game structs can't be written on one side and read on the
+// other. On Windows the wire structs ARE the game layout (the static_asserts
+// below hold there), so the exporter copies Draw's arrays verbatim.
+// Header-only and dependency-free: it is compiled by both mingw and native g++.
+// ============================================================================
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace frames {
+
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    char     magic[8];        // "MXBHFRM\0"
+    uint32_t version;         // kVersion
+    int32_t  firstIcon;       // 1-based sprite index of the first icon (textures precede it)
+    uint32_t fontCount;
+    uint32_t spriteCount;
+    uint32_t numFrames;       // patched on close; 0 if the writer died mid-stream
+    uint32_t reserved[3];
+};
+
+struct FrameHeader {
+    int64_t  timestampUs;     // tape sim time of the Draw this frame came from
+    uint32_t quadCount;
+    uint32_t stringCount;
+};
+
+struct WireQuad {
+    float    pos[4][2];
+    int32_t  sprite;
+    uint32_t color;           // ABGR
+};
+
+struct WireString {
+    char     text[100];
+    float    pos[2];
+    int32_t  font;
+    float    size;
+    int32_t  justify;
+    uint32_t color;           // ABGR
+};
+
+static_assert(sizeof(FileHeader) == 40, "MXBHFRM header layout");
+static_assert(sizeof(FrameHeader) == 16, "MXBHFRM frame header layout");
+static_assert(sizeof(WireQuad) == 40, "WireQuad must match the Win64 SPluginQuad_t");
+static_assert(sizeof(WireString) == 124, "WireString must match the Win64 SPluginString_t");
+
+// Sequential writer. Frames are appended as they are captured; close() patches the
+// frame count into the header.
+class Writer {
+public:
+    bool open(const char* path, const std::vector<std::string>& fonts,
+              const std::vector<std::string>& sprites, int firstIcon) {
+        m_f = std::fopen(path, "wb");
+        if (!m_f) return false;
+        FileHeader h{};
+        std::memcpy(h.magic, "MXBHFRM", 8);
+        h.version = kVersion;
+        h.firstIcon = firstIcon;
+        h.fontCount = static_cast<uint32_t>(fonts.size());
+        h.spriteCount = static_cast<uint32_t>(sprites.size());
+        std::fwrite(&h, sizeof(h), 1, m_f);
+        for (const auto& n : fonts)   std::fwrite(n.c_str(), 1, n.size() + 1, m_f);
+        for (const auto& n : sprites) std::fwrite(n.c_str(), 1, n.size() + 1, m_f);
+        return true;
+    }
+    void frame(int64_t timestampUs, const WireQuad* q, int nq, const WireString* s, int ns) {
+        if (!m_f) return;
+        FrameHeader fh{ timestampUs, static_cast<uint32_t>(nq < 0 ? 0 : nq),
+                        static_cast<uint32_t>(ns < 0 ? 0 : ns) };
+        std::fwrite(&fh, sizeof(fh), 1, m_f);
+        if (fh.quadCount)   std::fwrite(q, sizeof(WireQuad), fh.quadCount, m_f);
+        if (fh.stringCount) std::fwrite(s, sizeof(WireString), fh.stringCount, m_f);
+        ++m_frames;
+    }
+    void close() {
+        if (!m_f) return;
+        std::fseek(m_f, static_cast<long>(offsetof(FileHeader, numFrames)), SEEK_SET);
+        std::fwrite(&m_frames, sizeof(m_frames), 1, m_f);
+        std::fclose(m_f);
+        m_f = nullptr;
+    }
+    uint32_t frames() const { return m_frames; }
+    ~Writer() { close(); }
+
+private:
+    FILE* m_f = nullptr;
+    uint32_t m_frames = 0;
+};
+
+struct Frame {
+    int64_t timestampUs = 0;
+    std::vector<WireQuad> quads;
+    std::vector<WireString> strings;
+};
+
+// Sequential reader. open() reads the header and name tables; next() then reads
+// one frame at a time into a caller-owned Frame (its vectors keep their capacity),
+// so a full-race stream is never held in memory. Tolerates a truncated tail (a
+// capture that was killed mid-write): every complete frame before it is read.
+class Reader {
+public:
+    bool open(const char* path, std::string* err = nullptr) {
+        close();
+        m_f = std::fopen(path, "rb");
+        if (!m_f) { if (err) *err = "cannot open"; return false; }
+        FileHeader h{};
+        if (std::fread(&h, sizeof(h), 1, m_f) != 1 || std::memcmp(h.magic, "MXBHFRM", 8) != 0) {
+            if (err) *err = "not an MXBHFRM frame stream";
+            close(); return false;
+        }
+        if (h.version != kVersion) {
+            if (err) *err = "unsupported MXBHFRM version " + std::to_string(h.version);
+            close(); return false;
+        }
+        m_firstIcon = h.firstIcon;
+        m_declaredFrames = h.numFrames;
+        m_fonts.resize(h.fontCount);
+        m_sprites.resize(h.spriteCount);
+        for (auto& n : m_fonts)   if (!readName(n)) { if (err) *err = "truncated name table"; close(); return false; }
+        for (auto& n : m_sprites) if (!readName(n)) { if (err) *err = "truncated name table"; close(); return false; }
+        if (std::fgetpos(m_f, &m_firstFrame) != 0) { if (err) *err = "cannot seek"; close(); return false; }
+        return true;
+    }
+    // The next frame, or false at the end of the stream (or its truncated tail).
+    bool next(Frame& out) {
+        FrameHeader fh{};
+        if (!m_f || std::fread(&fh, sizeof(fh), 1, m_f) != 1) return false;
+        out.timestampUs = fh.timestampUs;
+        out.quads.resize(fh.quadCount);
+        out.strings.resize(fh.stringCount);
+        if (fh.quadCount && std::fread(out.quads.data(), sizeof(WireQuad), fh.quadCount, m_f) != fh.quadCount) return false;
+        if (fh.stringCount && std::fread(out.strings.data(), sizeof(WireString), fh.stringCount, m_f) != fh.stringCount) return false;
+        return true;
+    }
+    // Step over the next frame without reading its primitives.
+    bool skip() {
+        FrameHeader fh{};
+        if (!m_f || std::fread(&fh, sizeof(fh), 1, m_f) != 1) return false;
+        const long bytes = static_cast<long>(fh.quadCount * sizeof(WireQuad) + fh.stringCount * sizeof(WireString));
+        return std::fseek(m_f, bytes, SEEK_CUR) == 0;
+    }
+    // Back to the first frame (the bench makes several passes).
+    bool rewind() { return m_f && std::fsetpos(m_f, &m_firstFrame) == 0; }
+    void close() {
+        if (m_f) std::fclose(m_f);
+        m_f = nullptr;
+    }
+    ~Reader() { close(); }
+
+    int firstIcon() const { return m_firstIcon; }
+    const std::vector<std::string>& fonts() const { return m_fonts; }
+    const std::vector<std::string>& sprites() const { return m_sprites; }
+    // The frame count patched in by Writer::close(); 0 if the writer died mid-stream.
+    uint32_t declaredFrames() const { return m_declaredFrames; }
+
+private:
+    bool readName(std::string& s) {
+        s.clear();
+        for (int c; (c = std::fgetc(m_f)) != EOF;) { if (c == 0) return true; s.push_back(static_cast<char>(c)); }
+        return false;
+    }
+
+    FILE* m_f = nullptr;
+    std::fpos_t m_firstFrame{};
+    int m_firstIcon = 1 << 30;
+    uint32_t m_declaredFrames = 0;
+    std::vector<std::string> m_fonts, m_sprites;
+};
+
+}  // namespace frames
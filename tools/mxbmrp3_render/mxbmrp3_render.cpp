@@ -0,0 +1,261 @@
+// ============================================================================
+// tools/mxbmrp3_render/mxbmrp3_render.cpp
+// Headless offline HUD renderer: rasterizes a recorded MXBHFRM frame stream (see
+// frame_stream.h / frame_dump.cpp) with the companion window's software renderer
+// (core/hud_sw_renderer) — no Windows, no GPU, no window. Writes PNGs or a raw
+// RGBA8 stream for ffmpeg, and reports per-frame render-time percentiles, so the
+// same binary is the renderer's reproducible throughput benchmark.
+//
+//   mxbmrp3_render race.frames --res 2560x1440 --every 2 --out frames/
+//   mxbmrp3_render race.frames --raw |
+//       ffmpeg -f rawvideo -pix_fmt rgba -s 1920x1080 -r 30 -i - race.mp4
+//   mxbmrp3_render race.frames --bench            # 1080p / 1440p / 4K sweep
+//
+// Frames are streamed: each is read, converted, rendered and written before the
+// next is read, so memory stays flat however long the race is.
+//
+// Only the render() call is timed (PNG encode / stdout writes are excluded). The
+// first frame at each resolution is rendered once untimed so lazy font/texture
+// loads don't land in the percentiles.
+// ============================================================================
+#include "frame_stream.h"
+#include "core/hud_sw_renderer.h"
+#include "vendor/miniz/miniz.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* input = nullptr;
+    int w = 1920, h = 1080;
+    int every = 1;
+    int limit = 0;            // 0 = all selected frames
+    int repeat = 1;           // --bench passes over the selection
+    std::string outDir;       // PNGs when set
+    bool raw = false;         // RGBA8 frames to stdout
+    bool bench = false;
+    std::string assets;
+    uint8_t bg[3] = { 12, 15, 20 };   // the companion window's backdrop
+};
+
+void usage() {
+    fprintf(stderr,
+        "usage: mxbmrp3_render <in.frames> [--res WxH] [--every N] [--limit N]\n"
+        "                      [--out DIR | --raw] [--bench [--repeat N]]\n"
+        "                      [--assets DIR] [--bg R,G,B]\n");
+}
+
+// "mxbmrp3_data\\fonts\\RobotoMono-Regular.fnt" -> "RobotoMono-Regular"
+// (same reduction CompanionWindow::setResources applies to the DrawInit tables).
+std::string baseName(const std::string& p) {
+    size_t s = p.find_last_of("\\/");
+    std::string b = (s == std::string::npos) ? p : p.substr(s + 1);
+    size_t dot = b.rfind('.');
+    return dot == std::string::npos ? b : b.substr(0, dot);
+}
+
+// The stream's fixed-width wire structs -> this platform's PiBoSo structs
+// (unsigned long is 64-bit here, so the arrays can't be reinterpreted in place).
+struct NativeFrame {
+    std::vector<SPluginQuad_t> quads;
+    std::vector<SPluginString_t> strings;
+};
+
+// Converts into `f` in place, so its vectors keep their capacity frame to frame.
+void toNative(const frames::Frame& in, NativeFrame& f) {
+    f.quads.resize(in.quads.size());
+    for (size_t i = 0; i < in.quads.size(); ++i) {
+        const frames::WireQuad& w = in.quads[i];
+        SPluginQuad_t& q = f.quads[i];
+        std::memcpy(q.m_aafPos, w.pos, sizeof(w.pos));
+        q.m_iSprite = w.sprite;
+        q.m_ulColor = w.color;
+    }
+    f.strings.resize(in.strings.size());
+    for (size_t i = 0; i < in.strings.size(); ++i) {
+        const frames::WireString& w = in.strings[i];
+        SPluginString_t& s = f.strings[i];
+        std::memcpy(s.m_szString, w.text, sizeof(w.text));
+        s.m_szString[sizeof(s.m_szString) - 1] = '\0';
+        s.m_afPos[0] = w.pos[0]; s.m_afPos[1] = w.pos[1];
+        s.m_iFont = w.font;
+        s.m_fSize = w.size;
+        s.m_iJustify = w.justify;
+        s.m_ulColor = w.color;
+    }
+}
+
+// HUD coords keep their 16:9 scale in a centered viewport, exactly as the companion
+// window maps them; the whole image is still drawn (off-[0,1] elements included).
+void sizeImage(hudsw::Image& img, int w, int h) {
+    img.resize(w, h);
+    int rw = w, rh = w * 9 / 16;
+    if (rh > h) { rh = h; rw = h * 16 / 9; }
+    img.setViewport(static_cast<float>((w - rw) / 2), static_cast<float>((h - rh) / 2),
+                    static_cast<float>(std::max(1, rw)), static_cast<float>(std::max(1, rh)));
+}
+
+struct Stats { double p50 = 0, p90 = 0, p99 = 0, max = 0, mean = 0; size_t n = 0; };
+
+Stats summarize(std::vector<double> ms) {
+    Stats s;
+    s.n = ms.size();
+    if (ms.empty()) return s;
+    std::sort(ms.begin(), ms.end());
+    auto pct = [&](double p) {   // nearest-rank
+        size_t i = static_cast<size_t>(p / 100.0 * static_cast<double>(ms.size()) + 0.5);
+        return ms[std::min(ms.size() - 1, i == 0 ? 0 : i - 1)];
+    };
+    s.p50 = pct(50); s.p90 = pct(90); s.p99 = pct(99); s.max = ms.back();
+    double sum = 0; for (double v : ms) sum += v;
+    s.mean = sum / static_cast<double>(ms.size());
+    return s;
+}
+
+void printStats(FILE* to, int w, int h, const Stats& s) {
+    fprintf(to, "%5dx%-5d  frames %6zu  p50 %7.3f  p90 %7.3f  p99 %7.3f  max %7.3f ms  (%.1f fps mean)\n",
+            w, h, s.n, s.p50, s.p90, s.p99, s.max, s.mean > 0 ? 1000.0 / s.mean : 0.0);
+}
+
+bool writePng(const std::string& path, const hudsw::Image& img) {
+    size_t len = 0;
+    void* png = tdefl_write_image_to_png_file_in_memory_ex(img.px.data(), img.w, img.h, 4, &len,
+                                                           MZ_DEFAULT_LEVEL, MZ_FALSE);
+    if (!png) return false;
+    FILE* f = std::fopen(path.c_str(), "wb");
+    bool ok = f && std::fwrite(png, 1, len, f) == len;
+    if (f) std::fclose(f);
+    mz_free(png);
+    return ok;
+}
+
+// Stream the selected frames (every o.every-th, at most o.limit) from `reader` and
+// render them at w x h, one at a time: only the current frame is held. `emit`
+// receives each finished image with its index in the selection. The reader is
+// rewound before each pass.
+template <class Emit>
+std::vector<double> renderStream(frames::Reader& reader, hudsw::Renderer& renderer, hudsw::Frame base,
+                                 int w, int h, const Options& o, int passes, Emit emit) {
+    hudsw::Image img;
+    sizeImage(img, w, h);
+    std::vector<double> ms;
+    frames::Frame wire;
+    NativeFrame nf;
+    bool warmed = false;
+    for (int pass = 0; pass < passes && reader.rewind(); ++pass) {
+        size_t selected = 0;
+        for (size_t i = 0;; ++i) {
+            if (o.limit && selected >= static_cast<size_t>(o.limit)) break;
+            if (i % static_cast<size_t>(o.every) != 0) {
+                if (!reader.skip()) break;
+                continue;
+            }
+            if (!reader.next(wire)) break;
+            toNative(wire, nf);
+            base.quads = nf.quads.data(); base.quadCount = static_cast<int>(nf.quads.size());
+            base.strings = nf.strings.data(); base.stringCount = static_cast<int>(nf.strings.size());
+            if (!warmed) { renderer.render(img, base, o.bg[0], o.bg[1], o.bg[2]); warmed = true; }
+            auto t0 = std::chrono::steady_clock::now();
+            renderer.render(img, base, o.bg[0], o.bg[1], o.bg[2]);
+            auto t1 = std::chrono::steady_clock::now();
+            ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            emit(selected++, img);
+        }
+    }
+    return ms;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    {
+        // Default asset root: the repo's mxbmrp3_data next to this tool's checkout.
+        std::string exe = argv[0];
+        size_t s = exe.find_last_of("/\\");
+        o.assets = (s == std::string::npos ? std::string(".") : exe.substr(0, s)) + "/../../mxbmrp3_data";
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* { if (i + 1 >= argc) { usage(); std::exit(2); } return argv[++i]; };
+        if (a == "--res") {
+            if (std::sscanf(next(), "%dx%d", &o.w, &o.h) != 2 || o.w <= 0 || o.h <= 0) { usage(); return 2; }
+        }
+        else if (a == "--every")  o.every = std::max(1, std::atoi(next()));
+        else if (a == "--limit")  o.limit = std::max(0, std::atoi(next()));
+        else if (a == "--repeat") o.repeat = std::max(1, std::atoi(next()));
+        else if (a == "--out")    o.outDir = next();
+        else if (a == "--raw")    o.raw = true;
+        else if (a == "--bench")  o.bench = true;
+        else if (a == "--assets") o.assets = next();
+        else if (a == "--bg") {
+            int r, g, b;
+            if (std::sscanf(next(), "%d,%d,%d", &r, &g, &b) != 3) { usage(); return 2; }
+            o.bg[0] = static_cast<uint8_t>(r); o.bg[1] = static_cast<uint8_t>(g); o.bg[2] = static_cast<uint8_t>(b);
+        }
+        else if (a[0] != '-' && !o.input) o.input = argv[i];
+        else { usage(); return 2; }
+    }
+    if (!o.input || (o.raw && !o.outDir.empty())) { usage(); return 2; }
+
+    frames::Reader reader;
+    std::string err;
+    if (!reader.open(o.input, &err)) { fprintf(stderr, "%s: %s\n", o.input, err.c_str()); return 1; }
+
+    std::vector<std::string> fontBases, spriteBases;
+    for (const auto& p : reader.fonts()) fontBases.push_back(baseName(p));
+    for (const auto& p : reader.sprites()) spriteBases.push_back(baseName(p));
+
+    // Raw frames own stdout; everything human-readable goes to stderr then.
+    FILE* log = o.raw ? stderr : stdout;
+    fprintf(log, "%s: %u frames, rendering every %d%s, %zu fonts, %zu sprites, assets %s\n",
+            o.input, reader.declaredFrames(), o.every, o.limit ? " (limited)" : "",
+            fontBases.size(), spriteBases.size(), o.assets.c_str());
+
+    hudsw::Frame base;
+    base.fontNames = &fontBases;
+    base.spriteNames = &spriteBases;
+    base.firstIcon = reader.firstIcon();
+    base.assetRoot = o.assets;
+    hudsw::Renderer renderer;
+
+    if (o.bench) {
+        static const int kRes[][2] = { { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+        for (const auto& r : kRes) {
+            auto ms = renderStream(reader, renderer, base, r[0], r[1], o, o.repeat, [](size_t, const hudsw::Image&) {});
+            printStats(log, r[0], r[1], summarize(std::move(ms)));
+        }
+        return 0;
+    }
+
+    if (!o.outDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(o.outDir, ec);
+        if (ec) { fprintf(stderr, "cannot create %s: %s\n", o.outDir.c_str(), ec.message().c_str()); return 1; }
+    }
+    size_t written = 0;
+    bool ioFailed = false;
+    auto ms = renderStream(reader, renderer, base, o.w, o.h, o, 1, [&](size_t i, const hudsw::Image& img) {
+        if (ioFailed) return;
+        if (o.raw) {
+            ioFailed = std::fwrite(img.px.data(), 1, img.px.size(), stdout) != img.px.size();
+        } else if (!o.outDir.empty()) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%06zu.png", i);
+            ioFailed = !writePng(o.outDir + name, img);
+        }
+        if (!ioFailed) ++written;
+    });
+    if (ioFailed) fprintf(stderr, "write failed after %zu frames\n", written);
+    if (o.raw || !o.outDir.empty()) fprintf(log, "wrote %zu frames\n", written);
+    printStats(log, o.w, o.h, summarize(std::move(ms)));
+    return ioFailed ? 1 : 0;
+}
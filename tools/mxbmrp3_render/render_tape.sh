@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# ============================================================================
+# tools/mxbmrp3_render/render_tape.sh
+# Tape -> rendered HUD frames, end to end. The plugin is a Windows DLL, so the
+# tape replay half runs under Wine: cross-compiles the test DLL and frame_dump.exe,
+# stages the plugin assets next to the DLL (DrawInit discovers them there), replays
+# the tape and captures every Draw into an MXBHFRM frame stream. The render half
+# is native: builds mxbmrp3_render and passes the remaining args through to it.
+#
+# Requires: mingw-w64 (posix) + wine64 for the capture; g++ for the render.
+#   tools/mxbmrp3_render/render_tape.sh race.tape[.gz] [mxbmrp3_render args...]
+#   tools/mxbmrp3_render/render_tape.sh race.tape --res 2560x1440 --out frames/
+#   tools/mxbmrp3_render/render_tape.sh race.tape --bench
+#
+# TICK_MS (default 33) is the sim-time Draw cadence of the capture; KEEP_FRAMES=1
+# leaves the .frames file next to the tape for re-rendering without Wine.
+# ============================================================================
+set -euo pipefail
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${HERE}/../.." && pwd)"
+BUILD="${ROOT}/tests/integration/build"
+TAPE="${1:?usage: render_tape.sh <tape[.gz]> [mxbmrp3_render args...]}"
+shift
+TICK_MS="${TICK_MS:-33}"
+
+export WINELOADER="${WINELOADER:-/usr/lib/wine/wine64}"
+export WINEARCH="${WINEARCH:-win64}"
+export WINEDEBUG="${WINEDEBUG:--all}"
+export WINEPREFIX="${WINEPREFIX:-$HOME/.wineprefix-mxbmrp3}"
+
+for t in x86_64-w64-mingw32-g++ wine; do
+    command -v "$t" >/dev/null || { echo "ERROR: '$t' not found"; exit 1; }
+done
+
+TMP="$(mktemp -d)"; trap 'rm -rf "${TMP}"' EXIT
+if [[ "${TAPE}" == *.gz ]]; then
+    gunzip -c "${TAPE}" > "${TMP}/in.tape"
+else
+    cp "${TAPE}" "${TMP}/in.tape"
+fi
+FRAMES="${TMP}/out.frames"
+if [[ "${KEEP_FRAMES:-0}" == "1" ]]; then
+    FRAMES="${TAPE%.gz}"; FRAMES="$(cd "$(dirname "${FRAMES}")" && pwd)/$(basename "${FRAMES%.tape}").frames"
+fi
+
+echo "==> building test DLL" >&2
+"${ROOT}/tests/integration/build.sh" >/dev/null
+
+echo "==> staging plugin assets (fonts/textures/icons)" >&2
+STAGE="${BUILD}/plugins/mxbmrp3_data"
+mkdir -p "${STAGE}"
+for d in fonts textures icons; do rm -rf "${STAGE:?}/${d}"; cp -r "${ROOT}/mxbmrp3_data/${d}" "${STAGE}/${d}"; done
+
+echo "==> compiling frame_dump.exe" >&2
+x86_64-w64-mingw32-g++ -std=c++17 -O1 -w -static -static-libgcc -static-libstdc++ \
+    -I "${ROOT}/tests/integration/harness" -I "${ROOT}/mxbmrp3" -I "${ROOT}/mxbmrp3/vendor" \
+    "${HERE}/frame_dump.cpp" "${BUILD}/obj/vendor/miniz/"*.o -o "${BUILD}/frame_dump.exe" -lws2_32
+
+echo "==> capturing Draw output under Wine (tick ${TICK_MS} ms)" >&2
+( cd "${BUILD}" && wine frame_dump.exe mxbmrp3_test.dlo "$(winepath -w "${TMP}/in.tape")" \
+    "$(winepath -w "${FRAMES}")" "${TICK_MS}" ) >&2
+
+echo "==> building + running the native renderer" >&2
+"${HERE}/build.sh" >/dev/null
+"${HERE}/mxbmrp3_render" "${FRAMES}" "$@"
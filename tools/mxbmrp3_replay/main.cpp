@@ -11,6 +11,8 @@
 #include <vector>
 #include <string>
 
+#include "core/tape_map.h"  // MXBHREC v1/v2 mapped reader (v2: deflated blocks, miniz)
+
 // Forward declarations of plugin API functions
 extern "C" {
     typedef int (*PFN_Startup)(char*);
@@ -149,7 +151,8 @@ uint64_t getCurrentTimeUs() {
            ((currentTime.QuadPart % g_performanceFrequency.QuadPart) * 1000000LL) / g_performanceFrequency.QuadPart;
 }
 
-// Recording file format structures
+// Recording file header (both versions; tape_io::MappedTape handles the container
+// and yields the events as tape_io::EventFrame + payload)
 struct RecordingHeader {
     char magic[8];
     uint32_t version;
@@ -160,12 +163,6 @@ struct RecordingHeader {
     char reserved[32];
 };
 
-struct EventHeader {
-    uint32_t eventType;
-    uint32_t dataSize;
-    uint64_t timestampUs;
-};
-
 enum class EventType : uint32_t {
     None = 0,
     Startup = 1,
@@ -469,6 +466,9 @@ int main(int argc, char* argv[]) {
         printf("               0 = maximum speed (no waiting)\n");
         printf("               1 = normal speed (real-time)\n");
         printf("               10 = 10x faster\n");
+        printf("  --from <S>   Start watching at S seconds into the recording: earlier events\n");
+        printf("               are fed at full speed (the plugin still needs them to build its\n");
+        printf("               state), then --speed pacing starts from there\n");
         printf("  --quiet      Suppress plugin debug logs (show only mxbmrp3_replay output)\n");
         printf("  --web        Serve the web overlay: cd to the game root (derived from the\n");
         printf("               plugin path) and enable webServer=1, so http://localhost:8080\n");
@@ -495,6 +495,7 @@ int main(int argc, char* argv[]) {
 
     // Parse optional parameters
     float speedMultiplier = 1.0f;  // Default: normal speed
+    double fromSec = 0.0;          // --from: pacing starts at this recording time
     bool quietMode = false;  // Default: show plugin logs
     bool webMode = false;    // Default: no web overlay
     bool windowMode = false; // Default: no companion window
@@ -508,6 +509,12 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
             i++;  // Skip the next argument (the speed value)
+        } else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            fromSec = atof(argv[++i]);
+            if (fromSec < 0.0) {
+                printf("ERROR: --from must be >= 0\n");
+                return 1;
+            }
         } else if (strcmp(argv[i], "--quiet") == 0) {
             quietMode = true;
         } else if (strcmp(argv[i], "--window") == 0) {
@@ -635,36 +642,24 @@ int main(int argc, char* argv[]) {
 
     // Load recording
     printf("\nLoading recording: %s\n", recordingPath);
-    FILE* file = fopen(recordingPath, "rb");
-    if (!file) {
-        printf("ERROR: Failed to open recording file\n");
+    tape_io::MappedTape file;
+    if (!file.open(recordingPath)) {
+        printf("ERROR: Failed to open recording file (missing, bad magic or unknown version)\n");
         plugin.Shutdown();
         plugin.unload();
         return 1;
     }
-
-    // Read header
     RecordingHeader header;
-    if (fread(&header, sizeof(header), 1, file) != 1) {
-        printf("ERROR: Failed to read header\n");
-        fclose(file);
-        plugin.Shutdown();
-        plugin.unload();
-        return 1;
-    }
-
-    // Verify magic
-    if (memcmp(header.magic, "MXBHREC\0", 8) != 0) {
-        printf("ERROR: Invalid recording file (bad magic)\n");
-        fclose(file);
-        plugin.Shutdown();
-        plugin.unload();
-        return 1;
-    }
+    static_assert(sizeof(header) == tape_io::FILE_HEADER_BYTES, "RecordingHeader layout");
+    memcpy(&header, file.headerBytes(), sizeof(header));
 
     printf("Recording info:\n");
-    printf("  Version: %u\n", header.version);
-    printf("  Events: %u\n", header.numEvents);
+    printf("  Version: %u%s\n", header.version,
+           header.version == tape_io::VERSION_BLOCKS ? " (deflated blocks)" : "");
+    printf("  Events: %llu\n", (unsigned long long)file.eventCount());
+    if (header.version == tape_io::VERSION_BLOCKS && !file.indexed()) {
+        printf("  (no block index - recording didn't finish; read up to its last whole block)\n");
+    }
     printf("  Duration: %.2f seconds\n", (header.endTimeUs - header.startTimeUs) / 1000000.0);
 
     // Replay events
@@ -677,49 +672,61 @@ int main(int argc, char* argv[]) {
         suppressPluginOutput();
     }
 
+    // --from: the first event at/after that time (the seek reads the block index,
+    // not the events); everything before it is dispatched without waiting.
+    const uint64_t eventCount = file.eventCount();
+    const uint64_t fromUs = static_cast<uint64_t>(fromSec * 1000000.0);
+    uint64_t pacedFrom = 0;
+    if (fromUs > 0) {
+        file.seek(fromUs);
+        pacedFrom = file.position();
+        file.seekEvent(0);
+        printf("[mxbmrp3_replay] fast-forwarding %llu events to %.2f s\n", (unsigned long long)pacedFrom, fromSec);
+    }
+
     uint64_t replayStartUs = getCurrentTimeUs();
+    uint64_t pacingStartUs = replayStartUs;   // restarted at pacedFrom
     uint32_t eventsProcessed = 0;
     uint64_t totalPluginTimeUs = 0;
 
     // Per-event-type statistics (28 event types: 0-27)
     EventStats eventTypeStats[28];
 
-    for (uint32_t i = 0; i < header.numEvents; ++i) {
+    for (uint64_t i = 0; i < eventCount; ++i) {
         // Cooperative cancel (Ctrl+C): stop replaying and fall through to the normal
         // Shutdown()/unload below, so teardown runs cleanly on this thread.
         if (g_stopRequested) {
-            printf("[mxbmrp3_replay] stopped at event %u/%u\n", i, header.numEvents);
+            printf("[mxbmrp3_replay] stopped at event %llu/%llu\n", (unsigned long long)i, (unsigned long long)eventCount);
             break;
         }
 
-        // Read event header
-        EventHeader eventHeader;
-        if (fread(&eventHeader, sizeof(eventHeader), 1, file) != 1) {
-            printf("ERROR: Failed to read event %u header\n", i);
+        // Read the next event (header + data)
+        tape_io::EventFrame eventHeader;
+        const uint8_t* payload = nullptr;
+        if (!file.next(eventHeader, payload)) {
+            printf("ERROR: Failed to read event %llu\n", (unsigned long long)i);
             break;
         }
 
-        // Read event data
+        // Copy the data out: the plugin callbacks take a mutable, aligned buffer
         std::vector<uint8_t> eventDataVec;
         uint8_t* eventData = nullptr;
         if (eventHeader.dataSize > 0) {
-            eventDataVec.resize(eventHeader.dataSize);
-            if (fread(eventDataVec.data(), eventHeader.dataSize, 1, file) != 1) {
-                printf("ERROR: Failed to read event %u data\n", i);
-                break;
-            }
+            eventDataVec.assign(payload, payload + eventHeader.dataSize);
             eventData = eventDataVec.data();
         }
 
         // Wait until it's time to dispatch this event (with speed adjustment)
-        if (speedMultiplier > 0.0f) {
+        if (i == pacedFrom) pacingStartUs = getCurrentTimeUs();
+        if (speedMultiplier > 0.0f && i >= pacedFrom) {
             // Calculate target time with speed multiplier
-            uint64_t targetTimeUs = (uint64_t)(eventHeader.timestampUs / speedMultiplier);
+            const uint64_t sinceFromUs = eventHeader.timestampUs > fromUs ? eventHeader.timestampUs - fromUs : 0;
+            uint64_t targetTimeUs = (uint64_t)(sinceFromUs / speedMultiplier);
 
             // Honor Ctrl+C during the wait (a long gap between events must not swallow
             // it) and Sleep(1) instead of busy-spinning on Sleep(0).
             while (!g_stopRequested) {
-                uint64_t elapsedUs = getCurrentTimeUs() - replayStartUs;
+                uint64_t elapsedUs = getCurrentTimeUs() - pacingStartUs;
                 if (elapsedUs >= targetTimeUs) break;
                 Sleep(1);
             }
@@ -911,7 +918,7 @@ int main(int argc, char* argv[]) {
         // Silent during replay - don't interleave progress messages with plugin output
     }
 
-    fclose(file);
+    file.close();
 
     uint64_t replayEndUs = getCurrentTimeUs();
     uint64_t totalReplayTimeUs = replayEndUs - replayStartUs;
@@ -927,7 +934,7 @@ int main(int argc, char* argv[]) {
     printf("                      REPLAY COMPLETE\n");
     printf("=================================================================\n");
     printf("=================================================================\n");
-    printf("Events processed: %u / %u\n", eventsProcessed, header.numEvents);
+    printf("Events processed: %u / %llu\n", eventsProcessed, (unsigned long long)eventCount);
     printf("Total replay time: %.2f seconds\n", totalReplayTimeUs / 1000000.0);
     printf("Total plugin time: %.2f seconds (%.1f%% of replay time)\n",
            totalPluginTimeUs / 1000000.0,
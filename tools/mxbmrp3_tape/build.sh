@@ -0,0 +1,27 @@
+#!/usr/bin/env bash
+# ============================================================================
+# tools/mxbmrp3_tape/build.sh — build the native tape inspector / reader bench.
+# Compiles the vendored miniz (C) and links it with mxbmrp3_tape.cpp, C++17.
+# core/tape_map.h and core/tape_io.h are header-only.
+# Output: tools/mxbmrp3_tape/mxbmrp3_tape
+# ============================================================================
+set -euo pipefail
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="$(cd "${HERE}/../.." && pwd)"
+MINIZ="${ROOT}/mxbmrp3/vendor/miniz"
+OUT="${HERE}/mxbmrp3_tape"
+CXX="${CXX:-g++}"
+CC="${CC:-gcc}"
+TMP="$(mktemp -d)"; trap 'rm -rf "${TMP}"' EXIT
+
+# tinfl = v2 block inflate + .gz fixtures; tdef (+ miniz.c for its adler32) is
+# referenced by tape_io.h's BlockWriter.
+"${CC}" -O2 -c "${MINIZ}/miniz.c"       -o "${TMP}/miniz.o"
+"${CC}" -O2 -c "${MINIZ}/miniz_tdef.c"  -o "${TMP}/miniz_tdef.o"
+"${CC}" -O2 -c "${MINIZ}/miniz_tinfl.c" -o "${TMP}/miniz_tinfl.o"
+
+"${CXX}" -std=c++17 -O2 -Wall -Wextra -I "${ROOT}/mxbmrp3" \
+    "${HERE}/mxbmrp3_tape.cpp" \
+    "${TMP}/miniz.o" "${TMP}/miniz_tdef.o" "${TMP}/miniz_tinfl.o" \
+    -o "${OUT}"
+echo "built ${OUT}"
@@ -0,0 +1,283 @@
+// ============================================================================
+// tools/mxbmrp3_tape/mxbmrp3_tape.cpp
+// Native tape inspector and reader benchmark over core/tape_map.h: what a tape
+// holds, its events from any point in time, and how fast the readers walk it.
+// Takes a recorder tape (v1 or v2) or a committed .tape.gz fixture (inflated into
+// memory, then read through the same MappedTape).
+//
+//   mxbmrp3_tape info  race.tape
+//   mxbmrp3_tape dump  race.tape --from 95.5 --types 21,24 --limit 20
+//   mxbmrp3_tape bench tests/integration/tests/fixtures/race_farm14_24riders.tape.gz
+//
+// bench: the offset table build (open), full passes through MappedTape and the
+// sequential tape_io::Reader, a type-filtered pass, and random seekEvent()/seek()
+// each followed by one next(). Best of --repeat passes.
+// ============================================================================
+#include "core/tape_map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+const char* const TYPE_NAMES[] = {
+    "None", "Startup", "Shutdown", "EventInit", "EventDeinit", "RunInit", "RunDeinit",
+    "RunStart", "RunStop", "RunLap", "RunSplit", "RunTelemetry", "DrawInit", "Draw",
+    "TrackCenterline", "RaceEvent", "RaceDeinit", "RaceSession", "RaceSessionState",
+    "RaceAddEntry", "RaceRemoveEntry", "RaceLap", "RaceSplit", "RaceHoleshot",
+    "RaceClassification", "RaceTrackPosition", "RaceCommunication", "RaceVehicleData",
+    "StateKeyframe",
+};
+constexpr uint32_t NUM_TYPES = sizeof(TYPE_NAMES) / sizeof(TYPE_NAMES[0]);
+
+const char* typeName(uint32_t t) { return t < NUM_TYPES ? TYPE_NAMES[t] : "Unknown"; }
+
+struct Options {
+    const char* command = nullptr;
+    const char* input = nullptr;
+    double fromSec = -1.0;            // dump: seek first
+    uint64_t types = tape_io::MappedTape::ALL_TYPES;
+    long limit = 0;                   // dump: 0 = all
+    int repeat = 3;                   // bench
+};
+
+void usage() {
+    fprintf(stderr,
+        "usage: mxbmrp3_tape info  <tape[.gz]>\n"
+        "       mxbmrp3_tape dump  <tape[.gz]> [--from SEC] [--types ID,ID..] [--limit N]\n"
+        "       mxbmrp3_tape bench <tape[.gz]> [--repeat N]\n");
+}
+
+double nowSec() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// The tape: mapped, or (.gz) inflated into `inflated` and viewed from there.
+bool openTape(const char* path, tape_io::MappedTape& tape, std::vector<uint8_t>& inflated) {
+    const size_t len = strlen(path);
+    if (len < 3 || strcmp(path + len - 3, ".gz") != 0) return tape.open(path);
+    std::vector<uint8_t> gz;
+    if (FILE* f = fopen(path, "rb")) {
+        uint8_t buf[65536];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) gz.insert(gz.end(), buf, buf + n);
+        fclose(f);
+    }
+    return tape_io::gunzip(gz.data(), gz.size(), inflated) && tape.openBuffer(inflated.data(), inflated.size());
+}
+
+int cmdInfo(tape_io::MappedTape& tape) {
+    uint64_t count[NUM_TYPES + 1] = {}, bytes[NUM_TYPES + 1] = {};
+    uint64_t firstUs = 0, lastUs = 0, n = 0;
+    tape_io::EventFrame ev;
+    const uint8_t* payload;
+    while (tape.next(ev, payload)) {
+        const uint32_t t = std::min(ev.eventType, NUM_TYPES);
+        ++count[t];
+        bytes[t] += sizeof(ev) + ev.dataSize;
+        if (n++ == 0) firstUs = ev.timestampUs;
+        lastUs = ev.timestampUs;
+    }
+    printf("version     %u%s\n", tape.version(), tape.version() == tape_io::VERSION_BLOCKS ? " (deflated blocks)" : "");
+    printf("events      %llu (header says %u)\n", (unsigned long long)tape.eventCount(), tape.headerNumEvents());
+    if (tape.version() == tape_io::VERSION_BLOCKS) {
+        printf("blocks      %zu (%s)\n", tape.blockCount(), tape.indexed() ? "indexed" : "no index: rebuilt from block headers");
+    }
+    printf("time        %.3f .. %.3f s\n", firstUs / 1e6, lastUs / 1e6);
+    printf("\n  %-20s %10s %14s\n", "type", "events", "bytes");
+    for (uint32_t t = 0; t <= NUM_TYPES; ++t) {
+        if (!count[t]) continue;
+        printf("  %-20s %10llu %14llu\n", t < NUM_TYPES ? typeName(t) : "(unknown)",
+               (unsigned long long)count[t], (unsigned long long)bytes[t]);
+    }
+    return 0;
+}
+
+int cmdDump(tape_io::MappedTape& tape, const Options& o) {
+    if (o.fromSec >= 0.0) tape.seek(static_cast<uint64_t>(o.fromSec * 1e6));
+    tape.setTypeFilter(o.types);
+    tape_io::EventFrame ev;
+    const uint8_t* payload;
+    long shown = 0;
+    while ((o.limit == 0 || shown < o.limit) && tape.next(ev, payload)) {
+        // position() is one past the event just returned (filtered ones skipped).
+        const uint64_t ordinal = tape.position() - 1;
+        printf("%8llu  %12.6f  %-20s %6u B\n", (unsigned long long)ordinal, ev.timestampUs / 1e6,
+               typeName(ev.eventType), ev.dataSize);
+        ++shown;
+    }
+    return 0;
+}
+
+// Best-of-`repeat` wall time of pass(), in seconds.
+template <typename F>
+double best(int repeat, F&& pass) {
+    double b = 1e30;
+    for (int r = 0; r < repeat; ++r) {
+        const double t0 = nowSec();
+        pass();
+        b = std::min(b, nowSec() - t0);
+    }
+    return b;
+}
+
+int cmdBench(const Options& o) {
+    tape_io::MappedTape tape;
+    std::vector<uint8_t> inflated;
+    const double t0 = nowSec();
+    if (!openTape(o.input, tape, inflated)) { fprintf(stderr, "cannot open %s as a tape\n", o.input); return 1; }
+    const double openSec = nowSec() - t0;
+    const uint64_t events = tape.eventCount();
+    if (events == 0) { fprintf(stderr, "%s: no events\n", o.input); return 1; }
+    volatile uint64_t sink = 0;
+
+    // Time a re-open separately: for a .gz the first open includes the inflate.
+    const double tableSec = best(o.repeat, [&] {
+        tape_io::MappedTape again;
+        if (inflated.empty()) again.open(o.input);
+        else again.openBuffer(inflated.data(), inflated.size());
+        sink = sink + again.eventCount();
+    });
+
+    uint64_t rawBytes = 0;
+    const double mappedSec = best(o.repeat, [&] {
+        tape.seekEvent(0);
+        tape_io::EventFrame ev;
+        const uint8_t* payload;
+        uint64_t acc = 0, b = 0;
+        while (tape.next(ev, payload)) {
+            acc += ev.dataSize ? payload[ev.dataSize - 1] : 0;
+            b += sizeof(ev) + ev.dataSize;
+        }
+        sink = sink + acc;
+        rawBytes = b;
+    });
+
+    // The sequential FILE* reader over the same bytes (for .gz, one tmpfile copy
+    // made up front; each pass reads it through its own dup'd descriptor).
+    FILE* copy = nullptr;
+    if (!inflated.empty() && (copy = tmpfile()) != nullptr) {
+        fwrite(inflated.data(), 1, inflated.size(), copy);
+        fflush(copy);
+    }
+    const double seqSec = best(o.repeat, [&] {
+        tape_io::Reader r;
+        FILE* f = nullptr;
+        if (!copy) {
+            f = fopen(o.input, "rb");
+        } else {
+            const int fd = dup(fileno(copy));
+            lseek(fd, 0, SEEK_SET);
+            f = fdopen(fd, "rb");
+        }
+        if (!f || !r.open(f)) return;
+        tape_io::EventFrame ev;
+        const uint8_t* payload;
+        uint64_t acc = 0;
+        while (r.next(ev, payload)) acc += ev.dataSize ? payload[ev.dataSize - 1] : 0;
+        sink = sink + acc;
+    });
+
+    if (copy) fclose(copy);
+
+    uint64_t laps = 0;
+    const double filteredSec = best(o.repeat, [&] {
+        tape.setTypeFilter(tape_io::MappedTape::typeBit(21));   // RaceLap
+        tape.seekEvent(0);
+        tape_io::EventFrame ev;
+        const uint8_t* payload;
+        uint64_t k = 0;
+        while (tape.next(ev, payload)) ++k;
+        tape.setTypeFilter(tape_io::MappedTape::ALL_TYPES);
+        laps = k;
+    });
+
+    // Random access: uniformly chosen events / times, one next() after each.
+    constexpr int SEEKS = 2000;
+    std::mt19937_64 rng(42);
+    tape.seekEvent(events - 1);
+    tape_io::EventFrame last;
+    const uint8_t* lastPayload;
+    tape.next(last, lastPayload);
+    const uint64_t endUs = last.timestampUs;
+    const double seekEventSec = best(o.repeat, [&] {
+        tape_io::EventFrame ev;
+        const uint8_t* payload;
+        for (int i = 0; i < SEEKS; ++i) {
+            tape.seekEvent(rng() % events);
+            if (tape.next(ev, payload)) sink = sink + ev.eventType;
+        }
+    });
+    const double seekTimeSec = best(o.repeat, [&] {
+        tape_io::EventFrame ev;
+        const uint8_t* payload;
+        for (int i = 0; i < SEEKS; ++i) {
+            tape.seek(rng() % (endUs + 1));
+            if (tape.next(ev, payload)) sink = sink + ev.eventType;
+        }
+    });
+
+    printf("%s: v%u, %llu events, %.1f MB of events%s\n", o.input, tape.version(),
+           (unsigned long long)events, rawBytes / 1e6,
+           tape.version() == tape_io::VERSION_BLOCKS ? (tape.indexed() ? ", indexed" : ", no index") : "");
+    printf("  open (first, incl. any gunzip)   %9.2f ms\n", openSec * 1e3);
+    printf("  offset table (re-open)           %9.2f ms\n", tableSec * 1e3);
+    printf("  full pass, MappedTape            %9.2f ms  %7.2f M events/s  %7.0f MB/s\n",
+           mappedSec * 1e3, events / mappedSec / 1e6, rawBytes / mappedSec / 1e6);
+    printf("  full pass, tape_io::Reader       %9.2f ms  %7.2f M events/s  %7.0f MB/s\n",
+           seqSec * 1e3, events / seqSec / 1e6, rawBytes / seqSec / 1e6);
+    printf("  RaceLap only (%llu), MappedTape   %9.2f ms  %7.2f M events/s scanned\n",
+           (unsigned long long)laps, filteredSec * 1e3, events / filteredSec / 1e6);
+    printf("  seekEvent + next                 %9.2f us each\n", seekEventSec / SEEKS * 1e6);
+    printf("  seek(time) + next                %9.2f us each\n", seekTimeSec / SEEKS * 1e6);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (argc < 3) { usage(); return 2; }
+    o.command = argv[1];
+    o.input = argv[2];
+    for (int i = 3; i < argc; ++i) {
+        const bool more = i + 1 < argc;
+        if (!strcmp(argv[i], "--from") && more) {
+            o.fromSec = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--types") && more) {
+            o.types = 0;
+            for (const char* p = argv[++i]; *p;) {
+                char* end;
+                const unsigned long id = strtoul(p, &end, 10);
+                if (end == p) { usage(); return 2; }
+                o.types |= tape_io::MappedTape::typeBit(static_cast<uint32_t>(id));
+                p = (*end == ',') ? end + 1 : end;
+            }
+        } else if (!strcmp(argv[i], "--limit") && more) {
+            o.limit = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--repeat") && more) {
+            o.repeat = std::max(1, atoi(argv[++i]));
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (!strcmp(o.command, "bench")) return cmdBench(o);
+    tape_io::MappedTape tape;
+    std::vector<uint8_t> inflated;
+    if (!openTape(o.input, tape, inflated)) { fprintf(stderr, "cannot open %s as a tape\n", o.input); return 1; }
+    if (!strcmp(o.command, "info")) return cmdInfo(tape);
+    if (!strcmp(o.command, "dump")) return cmdDump(tape, o);
+    usage();
+    return 2;
+}